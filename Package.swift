@@ -33,7 +33,11 @@ let package = Package(
                     .headerSearchPath("lib/inih"),
                     .headerSearchPath("Sources/soundpipe/lib/inih"),
                     .headerSearchPath("modules"),
-                    .headerSearchPath("external")
+                    .headerSearchPath("external"),
+                    .define("SOUNDPIPE_USE_VDSP", .when(platforms: [.iOS, .macOS, .tvOS]))
+                ],
+                linkerSettings: [
+                    .linkedFramework("Accelerate", .when(platforms: [.iOS, .macOS, .tvOS]))
                 ]),
         .target(
             name: "sporth",
@@ -10,7 +10,6 @@ open class AudioUnitBase: AUAudioUnit {
 
     private var inputBusArray: [AUAudioUnitBus] = []
     private var outputBusArray: [AUAudioUnitBus] = []
-    private var internalBuffers: [AVAudioPCMBuffer] = []
 
     /// Allocate the render resources
     override public func allocateRenderResources() throws {
@@ -21,14 +20,12 @@ open class AudioUnitBase: AUAudioUnit {
         try inputBusArray.forEach { if $0.format != format { try $0.setFormat(format) } }
         try outputBusArray.forEach { if $0.format != format { try $0.setFormat(format) } }
 
-        // we don't need to allocate a buffer if we can process in place
+        // we don't need scratch buffers if we can process in place
         if !canProcessInPlace || inputBusArray.count > 1 {
-            for i in inputBusArray.indices {
-                if let buffer = AVAudioPCMBuffer(pcmFormat: format, frameCapacity: maximumFramesToRender) {
-                    setBufferDSP(dsp, buffer.mutableAudioBufferList, i)
-                    internalBuffers.append(buffer)
-                }
-            }
+            // Input buses share buffers from a graph-wide pool, checked out
+            // only while this node renders, instead of holding one dedicated
+            // buffer per bus for the node's whole lifetime.
+            reserveScratchBuffersDSP(dsp, format.channelCount, maximumFramesToRender)
         }
 
         allocateRenderResourcesDSP(dsp, format.channelCount, format.sampleRate)
@@ -38,7 +35,6 @@ open class AudioUnitBase: AUAudioUnit {
     override public func deallocateRenderResources() {
         super.deallocateRenderResources()
         deallocateRenderResourcesDSP(dsp)
-        internalBuffers = []
     }
 
     /// Reset the DSP
@@ -195,6 +191,16 @@ open class AudioUnitBase: AUAudioUnit {
         triggerFrequencyDSP(dsp, frequency, amplitude)
     }
 
+    /// Submit a whole batch of timestamped triggers in one call. Each event
+    /// fires at its exact sample time inside the render loop, so rapid
+    /// patterns keep sub-buffer timing and the batch crosses the bridge once.
+    /// - Parameter events: Triggers with sample times on the render clock;
+    ///   a negative time fires as soon as possible, a frequency of zero fires
+    ///   the plain trigger.
+    public func triggerBatch(_ events: [AKTriggerEvent]) {
+        triggerBatchDSP(dsp, events, events.count)
+    }
+
     /// Create an array of values to use as waveforms or other things inside an audio unit
     /// - Parameters:
     ///   - wavetable: Array of float values
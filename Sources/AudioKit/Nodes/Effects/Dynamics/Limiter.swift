@@ -0,0 +1,125 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+import AVFoundation
+import CAudioKit
+
+/// Lookahead brickwall limiter for mastering. The signal is delayed by the
+/// lookahead window while the gain reduction is computed ahead of it, so
+/// peaks are caught without over-limiting. Optionally detects inter-sample
+/// (true) peaks on a 4x upsampled signal.
+public class Limiter: Node, AudioUnitContainer, Toggleable {
+
+    /// Unique four-letter identifier "lmtr"
+    public static let ComponentDescription = AudioComponentDescription(effect: "lmtr")
+
+    /// Internal type of audio unit for this node
+    public typealias AudioUnitType = InternalAU
+
+    /// Internal audio unit
+    public private(set) var internalAU: AudioUnitType?
+
+    // MARK: - Parameters
+
+    /// Specification details for threshold
+    public static let thresholdDef = NodeParameterDef(
+        identifier: "threshold",
+        name: "Threshold (dB)",
+        address: akGetParameterAddress("LimiterParameterThreshold"),
+        range: -60.0 ... 0.0,
+        unit: .decibels,
+        flags: .default)
+
+    /// Output ceiling, in decibels.
+    @Parameter public var threshold: AUValue
+
+    /// Specification details for lookaheadDuration
+    public static let lookaheadDurationDef = NodeParameterDef(
+        identifier: "lookaheadDuration",
+        name: "Lookahead (seconds)",
+        address: akGetParameterAddress("LimiterParameterLookaheadDuration"),
+        range: 0.0005 ... 0.02,
+        unit: .seconds,
+        flags: .default)
+
+    /// How far ahead of the output the gain reduction is computed. Also the
+    /// added latency of the node.
+    @Parameter public var lookaheadDuration: AUValue
+
+    /// Specification details for releaseDuration
+    public static let releaseDurationDef = NodeParameterDef(
+        identifier: "releaseDuration",
+        name: "Release (seconds)",
+        address: akGetParameterAddress("LimiterParameterReleaseDuration"),
+        range: 0.001 ... 1.0,
+        unit: .seconds,
+        flags: .default)
+
+    /// How quickly the gain recovers after a peak has passed.
+    @Parameter public var releaseDuration: AUValue
+
+    fileprivate var truePeak: Bool = false
+
+    // MARK: - Audio Unit
+
+    /// Internal Audio Unit for Limiter
+    public class InternalAU: AudioUnitBase {
+        /// Get an array of the parameter definitions
+        /// - Returns: Array of parameter definitions
+        public override func getParameterDefs() -> [NodeParameterDef] {
+            [Limiter.thresholdDef,
+             Limiter.lookaheadDurationDef,
+             Limiter.releaseDurationDef]
+        }
+
+        /// Create the DSP Refence for this node
+        /// - Returns: DSP Reference
+        public override func createDSP() -> DSPRef {
+            akCreateDSP("LimiterDSP")
+        }
+
+        /// Enable or disable inter-sample (true) peak detection
+        public func setTruePeak(_ enabled: Bool) {
+            akLimiterSetTruePeak(dsp, enabled)
+        }
+    }
+
+    // MARK: - Initialization
+
+    /// Initialize this limiter node
+    ///
+    /// - Parameters:
+    ///   - input: Input node to process
+    ///   - threshold: Output ceiling, in decibels.
+    ///   - lookaheadDuration: How far ahead of the output the gain reduction is computed.
+    ///   - releaseDuration: How quickly the gain recovers after a peak has passed.
+    ///   - truePeak: Detect inter-sample peaks on a 4x upsampled signal.
+    ///
+    public init(
+        _ input: Node,
+        threshold: AUValue = -0.3,
+        lookaheadDuration: AUValue = 0.005,
+        releaseDuration: AUValue = 0.05,
+        truePeak: Bool = false
+        ) {
+        self.truePeak = truePeak
+        super.init(avAudioNode: AVAudioNode())
+
+        instantiateAudioUnit { avAudioUnit in
+            self.avAudioUnit = avAudioUnit
+            self.avAudioNode = avAudioUnit
+
+            guard let audioUnit = avAudioUnit.auAudioUnit as? AudioUnitType else {
+                fatalError("Couldn't create audio unit")
+            }
+            self.internalAU = audioUnit
+
+            self.threshold = threshold
+            self.lookaheadDuration = lookaheadDuration
+            self.releaseDuration = releaseDuration
+            if truePeak {
+                self.internalAU?.setTruePeak(true)
+            }
+        }
+        connections.append(input)
+    }
+}
@@ -0,0 +1,92 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+import AVFoundation
+import CAudioKit
+
+/// A bank of parallel modal resonance filters computed in a single pass.
+/// Bell and percussion models that previously chained many ModalResonanceFilter
+/// nodes can run all of their modes in one node; each mode has its own
+/// frequency, quality factor and gain.
+///
+public class ModalBank: Node, AudioUnitContainer, Toggleable {
+
+    /// Unique four-letter identifier "mdbk"
+    public static let ComponentDescription = AudioComponentDescription(effect: "mdbk")
+
+    /// Internal type of audio unit for this node
+    public typealias AudioUnitType = InternalAU
+
+    /// Internal audio unit
+    public private(set) var internalAU: AudioUnitType?
+
+    // MARK: - Parameters
+
+    /// Resonant frequency of each mode, in Hz. The number of modes follows this array.
+    public var frequencies: [AUValue] {
+        didSet { internalAU?.setWavetable(frequencies, index: 0) }
+    }
+
+    /// Quality factor of each mode. Roughly equal to Q/frequency.
+    public var qualityFactors: [AUValue] {
+        didSet { internalAU?.setWavetable(qualityFactors, index: 1) }
+    }
+
+    /// Linear gain applied to each mode's output.
+    public var gains: [AUValue] {
+        didSet { internalAU?.setWavetable(gains, index: 2) }
+    }
+
+    // MARK: - Audio Unit
+
+    /// Internal Audio Unit for ModalBank
+    public class InternalAU: AudioUnitBase {
+        /// Get an array of the parameter definitions
+        /// - Returns: Array of parameter definitions
+        public override func getParameterDefs() -> [NodeParameterDef] {
+            []
+        }
+
+        /// Create the DSP Refence for this node
+        /// - Returns: DSP Reference
+        public override func createDSP() -> DSPRef {
+            akCreateDSP("ModalBankDSP")
+        }
+    }
+
+    // MARK: - Initialization
+
+    /// Initialize this filter node
+    ///
+    /// - Parameters:
+    ///   - input: Input node to process
+    ///   - frequencies: Resonant frequency of each mode, in Hz.
+    ///   - qualityFactors: Quality factor of each mode. Roughly equal to Q/frequency.
+    ///   - gains: Linear gain applied to each mode's output.
+    ///
+    public init(
+        _ input: Node,
+        frequencies: [AUValue],
+        qualityFactors: [AUValue],
+        gains: [AUValue] = []
+        ) {
+        self.frequencies = frequencies
+        self.qualityFactors = qualityFactors
+        self.gains = gains
+        super.init(avAudioNode: AVAudioNode())
+
+        instantiateAudioUnit { avAudioUnit in
+            self.avAudioUnit = avAudioUnit
+            self.avAudioNode = avAudioUnit
+
+            guard let audioUnit = avAudioUnit.auAudioUnit as? AudioUnitType else {
+                fatalError("Couldn't create audio unit")
+            }
+            self.internalAU = audioUnit
+
+            self.internalAU?.setWavetable(frequencies, index: 0)
+            self.internalAU?.setWavetable(qualityFactors, index: 1)
+            self.internalAU?.setWavetable(gains, index: 2)
+        }
+        connections.append(input)
+    }
+}
@@ -54,6 +54,16 @@ public class PitchShifter: Node, AudioUnitContainer, Toggleable {
     /// Crossfade (in samples)
     @Parameter public var crossfade: AUValue
 
+    /// Tap interpolation quality. Linear interpolation is the default;
+    /// nearest halves the per-sample delay reads, which lets polyphonic
+    /// material use larger windows for the same cost.
+    public enum Quality: Int32 {
+        case nearest = 0
+        case linear = 1
+    }
+
+    fileprivate var quality: Quality = .linear
+
     // MARK: - Audio Unit
 
     /// Internal Audio Unit for PitchShifter
@@ -71,6 +81,11 @@ public class PitchShifter: Node, AudioUnitContainer, Toggleable {
         public override func createDSP() -> DSPRef {
             akCreateDSP("PitchShifterDSP")
         }
+
+        /// Select the tap interpolation quality
+        public func setQuality(_ quality: Quality) {
+            akPitchShifterSetQuality(dsp, quality.rawValue)
+        }
     }
 
     // MARK: - Initialization
@@ -82,13 +97,17 @@ public class PitchShifter: Node, AudioUnitContainer, Toggleable {
     ///   - shift: Pitch shift (in semitones)
     ///   - windowSize: Window size (in samples)
     ///   - crossfade: Crossfade (in samples)
+    ///   - quality: Tap interpolation quality. Nearest halves the delay
+    ///     reads, allowing larger windows for polyphonic material.
     ///
     public init(
         _ input: Node,
         shift: AUValue = 0,
         windowSize: AUValue = 1_024,
-        crossfade: AUValue = 512
+        crossfade: AUValue = 512,
+        quality: Quality = .linear
         ) {
+        self.quality = quality
         super.init(avAudioNode: AVAudioNode())
 
         instantiateAudioUnit { avAudioUnit in
@@ -103,6 +122,9 @@ public class PitchShifter: Node, AudioUnitContainer, Toggleable {
             self.shift = shift
             self.windowSize = windowSize
             self.crossfade = crossfade
+            if quality != .linear {
+                self.internalAU?.setQuality(quality)
+            }
         }
         connections.append(input)
     }
@@ -21,6 +21,7 @@ public class Convolution: Node, AudioUnitContainer, Toggleable {
 
     fileprivate var impulseResponseFileURL: CFURL
     fileprivate var partitionLength: Int = 2_048
+    fileprivate var latencyTarget: Double = 0
 
     // MARK: - Audio Unit
 
@@ -39,6 +40,12 @@ public class Convolution: Node, AudioUnitContainer, Toggleable {
             akConvolutionSetPartitionLength(dsp, Int32(length))
         }
 
+        /// Set the target processing latency
+        /// - Parameter seconds: Desired latency in seconds
+        public func setLatencyTarget(_ seconds: Double) {
+            akConvolutionSetLatencyTarget(dsp, Float(seconds))
+        }
+
     }
 
     // MARK: - Initialization
@@ -48,13 +55,20 @@ public class Convolution: Node, AudioUnitContainer, Toggleable {
     /// - Parameters:
     ///   - partitionLength: Partition length (in samples). Must be a power of 2.
     ///     Lower values will add less latency, at the cost of requiring more CPU power.
+    ///   - latencyTarget: Desired processing latency in seconds. A positive
+    ///     target below the partition length enables the hybrid convolver: a
+    ///     short head partition meets the target (down to ~1.3 ms at 48 kHz)
+    ///     while long tail partitions keep CPU cost low on long impulse
+    ///     responses. Zero (the default) keeps uniform partitions.
     ///
     public init(_ input: Node,
                 impulseResponseFileURL: URL,
-                partitionLength: Int = 2_048
+                partitionLength: Int = 2_048,
+                latencyTarget: Double = 0
     ) {
         self.impulseResponseFileURL = impulseResponseFileURL as CFURL
         self.partitionLength = partitionLength
+        self.latencyTarget = latencyTarget
 
         super.init(avAudioNode: AVAudioNode())
 
@@ -65,6 +79,9 @@ public class Convolution: Node, AudioUnitContainer, Toggleable {
             self.internalAU = avAudioUnit.auAudioUnit as? AudioUnitType
 
             self.internalAU?.setPartitionLength(partitionLength)
+            if latencyTarget > 0 {
+                self.internalAU?.setLatencyTarget(latencyTarget)
+            }
             self.readAudioFile()
             self.internalAU?.start()
         }
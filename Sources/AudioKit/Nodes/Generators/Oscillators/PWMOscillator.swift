@@ -102,6 +102,11 @@ public class PWMOscillator: Node, AudioUnitContainer, Toggleable {
         public override func createDSP() -> DSPRef {
             akCreateDSP("PWMOscillatorDSP")
         }
+
+        /// Use the cheaper table-free polyBLEP engine instead of BLIT synthesis
+        public func setPolyBLEP(_ enabled: Bool) {
+            akPWMOscillatorSetPolyBLEP(dsp, enabled)
+        }
     }
 
     // MARK: - Initialization
@@ -114,13 +119,15 @@ public class PWMOscillator: Node, AudioUnitContainer, Toggleable {
     ///   - pulseWidth: Duty cycle width (range 0-1).
     ///   - detuningOffset: Frequency offset in Hz.
     ///   - detuningMultiplier: Frequency detuning multiplier
+    ///   - polyBLEP: Use the cheaper table-free polyBLEP engine instead of BLIT synthesis.
     ///
     public init(
         frequency: AUValue = 440,
         amplitude: AUValue = 1.0,
         pulseWidth: AUValue = 0.5,
         detuningOffset: AUValue = 0,
-        detuningMultiplier: AUValue = 1
+        detuningMultiplier: AUValue = 1,
+        polyBLEP: Bool = false
     ) {
         super.init(avAudioNode: AVAudioNode())
 
@@ -139,6 +146,9 @@ public class PWMOscillator: Node, AudioUnitContainer, Toggleable {
             self.pulseWidth = pulseWidth
             self.detuningOffset = detuningOffset
             self.detuningMultiplier = detuningMultiplier
+            if polyBLEP {
+                self.internalAU?.setPolyBLEP(true)
+            }
         }
     }
 }
@@ -104,6 +104,11 @@ public class PhaseDistortionOscillator: Node, AudioUnitContainer, Toggleable {
         public override func createDSP() -> DSPRef {
             akCreateDSP("PhaseDistortionOscillatorDSP")
         }
+
+        /// Use the table-free polyBLEP sawtooth with the same phase warp
+        public func setPolyBLEP(_ enabled: Bool) {
+            akPhaseDistortionOscillatorSetPolyBLEP(dsp, enabled)
+        }
     }
 
     // MARK: - Initialization
@@ -117,6 +122,7 @@ public class PhaseDistortionOscillator: Node, AudioUnitContainer, Toggleable {
     ///   - phaseDistortion: Amount of distortion, within the range [-1, 1]. 0 is no distortion.
     ///   - detuningOffset: Frequency offset in Hz.
     ///   - detuningMultiplier: Frequency detuning multiplier
+    ///   - polyBLEP: Render a table-free polyBLEP sawtooth with the same phase warp.
     ///
     public init(
         waveform: Table = Table(.sine),
@@ -124,7 +130,8 @@ public class PhaseDistortionOscillator: Node, AudioUnitContainer, Toggleable {
         amplitude: AUValue = 1,
         phaseDistortion: AUValue = 0,
         detuningOffset: AUValue = 0,
-        detuningMultiplier: AUValue = 1
+        detuningMultiplier: AUValue = 1,
+        polyBLEP: Bool = false
     ) {
         super.init(avAudioNode: AVAudioNode())
 
@@ -146,6 +153,9 @@ public class PhaseDistortionOscillator: Node, AudioUnitContainer, Toggleable {
             self.phaseDistortion = phaseDistortion
             self.detuningOffset = detuningOffset
             self.detuningMultiplier = detuningMultiplier
+            if polyBLEP {
+                self.internalAU?.setPolyBLEP(true)
+            }
         }
     }
 }
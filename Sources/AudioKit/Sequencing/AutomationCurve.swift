@@ -43,13 +43,19 @@ public struct AutomationCurve {
     /// Returns a new piecewise-linear automation curve which can be handed off to the audio thread
     /// for efficient processing.
     ///
+    /// Curved segments are subdivided adaptively: a span is split at its midpoint only while the
+    /// curve deviates from the chord by more than `tolerance`, so flat stretches of a taper
+    /// produce a single long ramp and segments concentrate where curvature is high.
+    ///
     /// - Parameters:
     ///   - initialValue: Starting point
-    ///   - resolution: Duration of each linear segment in seconds
+    ///   - resolution: Shortest linear segment duration in seconds (subdivision floor)
+    ///   - tolerance: Maximum deviation from the true curve per segment
     ///
     /// - Returns: A new array of piecewise linear automation points
     public func evaluate(initialValue: AUValue,
-                         resolution: Float) -> [AutomationEvent] {
+                         resolution: Float,
+                         tolerance: Float = 0.001) -> [AutomationEvent] {
 
         var result = [AutomationEvent]()
 
@@ -74,23 +80,34 @@ public struct AutomationCurve {
                 let endTime: Float = min(nextPointStart,
                                          point.startTime + point.rampDuration)
 
-                var t = point.startTime
+                let segmentEnd = point.startTime + point.rampDuration
                 let start = value
 
-                // March t along the segment
-                // this is effectively `while t <= endTime - resolution` without potentional for rounding errors
-                for _ in 0 ..< Int(round(endTime / resolution)) {
-
-                    value = AutomationCurve.evalRamp(start: start,
-                                                       segment: point,
-                                                       time: t + resolution,
-                                                       endTime: point.startTime + point.rampDuration)
-
-                    result.append(AutomationEvent(targetValue: value,
-                                                    startTime: t,
-                                                    rampDuration: resolution))
+                // Emit a linear ramp over [t0, t1], splitting at the midpoint
+                // while the chord misses the curve by more than the tolerance.
+                func subdivide(_ t0: Float, _ v0: Float, _ t1: Float, _ v1: Float) {
+                    let mid = 0.5 * (t0 + t1)
+                    let curveMid = AutomationCurve.evalRamp(start: start,
+                                                            segment: point,
+                                                            time: mid,
+                                                            endTime: segmentEnd)
+                    if t1 - t0 <= 2 * resolution || abs(curveMid - 0.5 * (v0 + v1)) <= tolerance {
+                        result.append(AutomationEvent(targetValue: v1,
+                                                        startTime: t0,
+                                                        rampDuration: t1 - t0))
+                    } else {
+                        subdivide(t0, v0, mid, curveMid)
+                        subdivide(mid, curveMid, t1, v1)
+                    }
+                }
 
-                    t += resolution
+                if endTime > point.startTime {
+                    let endValue = AutomationCurve.evalRamp(start: start,
+                                                            segment: point,
+                                                            time: endTime,
+                                                            endTime: segmentEnd)
+                    subdivide(point.startTime, start, endTime, endValue)
+                    value = endValue
                 }
             }
 
@@ -0,0 +1,134 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+#include "AnalysisTap.h"
+#include "PitchTracker.h"
+#include "../Internals/Utilities/TripleBuffer.h"
+
+#include <Accelerate/Accelerate.h>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+// One traversal per buffer: the loop that computes peak and sum-of-squares
+// also appends into the FFT accumulation window, and the same buffer is
+// handed to the pitch tracker without a ring-buffer hop. Completed FFT
+// windows produce magnitude spectra; everything is published together
+// through a wait-free triple buffer, so the three former taps (metering,
+// EZAudioFFT spectrum, PitchTracker) collapse into one pass and one
+// snapshot.
+
+struct AnalysisTapData {
+    double sampleRate = 44100.0;
+    uint32_t fftSize = 2048;
+    uint32_t binCount = 1024;
+    vDSP_Length log2n = 11;
+
+    FFTSetup fftSetup = nullptr;
+    std::vector<float> window;       // Hann coefficients
+    std::vector<float> accumulated;  // incoming samples, pre-window
+    uint32_t accumulatedCount = 0;
+    std::vector<float> windowed;
+    std::vector<float> realPart;
+    std::vector<float> imagPart;
+
+    PitchTrackerRef pitchTracker = nullptr;
+
+    TripleBuffer<AnalysisSnapshot> snapshots;
+    AnalysisSnapshot working = {};
+};
+
+AnalysisTapRef akAnalysisTapCreate(double sampleRate, uint32_t fftSize) {
+    if (fftSize < 2 || (fftSize & (fftSize - 1)) != 0 ||
+        fftSize > 2 * AK_ANALYSIS_MAX_BINS) {
+        return nullptr;
+    }
+
+    auto* tap = new AnalysisTapData;
+    tap->sampleRate = sampleRate;
+    tap->fftSize = fftSize;
+    tap->binCount = fftSize / 2;
+    tap->log2n = (vDSP_Length)lround(log2((double)fftSize));
+
+    tap->fftSetup = vDSP_create_fftsetup(tap->log2n, FFT_RADIX2);
+    tap->window.resize(fftSize);
+    vDSP_hann_window(tap->window.data(), fftSize, vDSP_HANN_NORM);
+    tap->accumulated.resize(fftSize);
+    tap->windowed.resize(fftSize);
+    tap->realPart.resize(tap->binCount);
+    tap->imagPart.resize(tap->binCount);
+
+    tap->pitchTracker = akPitchTrackerCreate((unsigned int)sampleRate, 4096, 20);
+    return tap;
+}
+
+void akAnalysisTapDestroy(AnalysisTapRef tap) {
+    if (tap == nullptr) return;
+    if (tap->fftSetup) vDSP_destroy_fftsetup(tap->fftSetup);
+    if (tap->pitchTracker) akPitchTrackerDestroy(tap->pitchTracker);
+    delete tap;
+}
+
+/// Runs the FFT over one full accumulation window into working.spectrum.
+static void computeSpectrum(AnalysisTapData* tap) {
+    vDSP_vmul(tap->accumulated.data(), 1, tap->window.data(), 1,
+              tap->windowed.data(), 1, tap->fftSize);
+
+    DSPSplitComplex split = {tap->realPart.data(), tap->imagPart.data()};
+    vDSP_ctoz((const DSPComplex*)tap->windowed.data(), 2, &split, 1, tap->binCount);
+    vDSP_fft_zrip(tap->fftSetup, &split, 1, tap->log2n, FFT_FORWARD);
+    vDSP_zvabs(&split, 1, tap->working.spectrum, 1, tap->binCount);
+
+    float scale = 1.0f / (float)tap->fftSize;
+    vDSP_vsmul(tap->working.spectrum, 1, &scale, tap->working.spectrum, 1, tap->binCount);
+    tap->working.spectrumBinCount = tap->binCount;
+}
+
+void akAnalysisTapProcess(AnalysisTapRef tap, const float* samples, uint32_t count) {
+    float peak = 0.0f;
+    float sumSquares = 0.0f;
+    uint32_t accumulated = tap->accumulatedCount;
+    float* fftInput = tap->accumulated.data();
+    const uint32_t fftSize = tap->fftSize;
+
+    // The single pass: reduction and FFT-window fill together. The loop has
+    // no branches beyond the window-full check and auto-vectorizes.
+    uint32_t i = 0;
+    while (i < count) {
+        uint32_t run = count - i;
+        if (run > fftSize - accumulated) run = fftSize - accumulated;
+
+        for (uint32_t k = 0; k < run; k++) {
+            float s = samples[i + k];
+            float mag = fabsf(s);
+            if (mag > peak) peak = mag;
+            sumSquares += s * s;
+            fftInput[accumulated + k] = s;
+        }
+        accumulated += run;
+        i += run;
+
+        if (accumulated == fftSize) {
+            computeSpectrum(tap);
+            accumulated = 0;
+        }
+    }
+    tap->accumulatedCount = accumulated;
+
+    // The tracker consumes the caller's buffer directly; it hops internally,
+    // so most calls cost a copy into its window and nothing more.
+    akPitchTrackerAnalyze(tap->pitchTracker, (float*)samples, count);
+    akPitchTrackerGetResults(tap->pitchTracker,
+                             &tap->working.pitchAmplitude,
+                             &tap->working.pitchFrequency);
+
+    tap->working.peak = peak;
+    tap->working.rms = count > 0 ? sqrtf(sumSquares / (float)count) : 0.0f;
+
+    AnalysisSnapshot& out = tap->snapshots.beginWrite();
+    out = tap->working;
+    tap->snapshots.endWrite();
+}
+
+void akAnalysisTapGetSnapshot(AnalysisTapRef tap, AnalysisSnapshot* snapshot) {
+    *snapshot = tap->snapshots.read();
+}
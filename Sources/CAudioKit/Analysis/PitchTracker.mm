@@ -3,13 +3,15 @@
 #include "PitchTracker.h"
 
 #include "soundpipe.h"
+#include <vector>
 
 struct PitchTracker {
 
     sp_data *sp = nullptr;
     sp_ptrack *ptrack = nullptr;
 
-    PitchTracker(size_t sampleRate, int hopSize, int peakCount) {
+    PitchTracker(size_t sampleRate, int hopSize, int peakCount)
+        : peakCount(peakCount) {
         sp_create(&sp);
         sp->sr = (int)sampleRate;
         sp->nchan = 1;
@@ -23,16 +25,72 @@ struct PitchTracker {
         sp_destroy(&sp);
     }
 
+    /// Reconfigures the analysis hop without recreating the tracker. Call
+    /// between analyze calls, not concurrently with one.
+    void setHopSize(int hopSize) {
+        sp_ptrack_destroy(&ptrack);
+        sp_ptrack_create(&ptrack);
+        sp_ptrack_init(sp, ptrack, hopSize, peakCount);
+    }
+
     void analyze(float* frames, size_t count) {
-        for(int i = 0; i < count; ++i) {
-            sp_ptrack_compute(sp, ptrack, frames + i, &trackedFrequency, &trackedAmplitude);
-        }
+        // Streams whole chunks into ptrack's hop buffer (vectorized scaling
+        // on Apple platforms); the FFT analysis runs only when a hop boundary
+        // passes and the result conversion once per call, not per sample.
+        sp_ptrack_compute_block(sp, ptrack, frames, (int)count,
+                                &trackedFrequency, &trackedAmplitude);
     }
 
+    int peakCount;
+
     float trackedAmplitude = 0.0;
     float trackedFrequency = 0.0;
 };
 
+/// Tracks pitch on several channels of the same stream in one pass. All
+/// channels share one sp_data and one FFT setup (twiddle tables), so N
+/// channels cost one setup's memory and avoid N-1 redundant plans.
+struct PitchTrackerEnsemble {
+
+    sp_data *sp = nullptr;
+    std::vector<sp_ptrack*> trackers;
+    std::vector<float> trackedFrequencies;
+    std::vector<float> trackedAmplitudes;
+
+    PitchTrackerEnsemble(size_t sampleRate, int hopSize, int peakCount, int channelCount) {
+        sp_create(&sp);
+        sp->sr = (int)sampleRate;
+        sp->nchan = 1;
+
+        trackers.resize(channelCount);
+        trackedFrequencies.assign(channelCount, 0.0f);
+        trackedAmplitudes.assign(channelCount, 0.0f);
+        for (int channel = 0; channel < channelCount; channel++) {
+            sp_ptrack_create(&trackers[channel]);
+            if (channel == 0) {
+                sp_ptrack_init(sp, trackers[channel], hopSize, peakCount);
+            } else {
+                sp_ptrack_init_shared_fft(sp, trackers[channel], hopSize, peakCount, trackers[0]);
+            }
+        }
+    }
+
+    ~PitchTrackerEnsemble() {
+        // trackers[0] owns the shared FFT setup; destroy it last.
+        for (size_t channel = trackers.size(); channel-- > 0;) {
+            sp_ptrack_destroy(&trackers[channel]);
+        }
+        sp_destroy(&sp);
+    }
+
+    void analyze(float** channelFrames, size_t count) {
+        for (size_t channel = 0; channel < trackers.size(); channel++) {
+            sp_ptrack_compute_block(sp, trackers[channel], channelFrames[channel], (int)count,
+                                    &trackedFrequencies[channel], &trackedAmplitudes[channel]);
+        }
+    }
+};
+
 AK_API PitchTrackerRef akPitchTrackerCreate(unsigned int sampleRate, int hopSize, int peakCount) {
     return new PitchTracker(sampleRate, hopSize, peakCount);
 }
@@ -41,6 +99,10 @@ AK_API void akPitchTrackerDestroy(PitchTrackerRef tracker) {
     delete tracker;
 }
 
+AK_API void akPitchTrackerSetHopSize(PitchTrackerRef tracker, int hopSize) {
+    tracker->setHopSize(hopSize);
+}
+
 AK_API void akPitchTrackerAnalyze(PitchTrackerRef tracker, float* frames, unsigned int count) {
     tracker->analyze(frames, count);
 }
@@ -49,3 +111,23 @@ AK_API void akPitchTrackerGetResults(PitchTrackerRef tracker, float* trackedAmpl
     *trackedAmplitude = tracker->trackedAmplitude;
     *trackedFrequency = tracker->trackedFrequency;
 }
+
+AK_API PitchTrackerEnsembleRef akPitchTrackerEnsembleCreate(unsigned int sampleRate, int hopSize,
+                                                            int peakCount, int channelCount) {
+    return new PitchTrackerEnsemble(sampleRate, hopSize, peakCount, channelCount);
+}
+
+AK_API void akPitchTrackerEnsembleDestroy(PitchTrackerEnsembleRef ensemble) {
+    delete ensemble;
+}
+
+AK_API void akPitchTrackerEnsembleAnalyze(PitchTrackerEnsembleRef ensemble, float** channelFrames,
+                                          unsigned int count) {
+    ensemble->analyze(channelFrames, count);
+}
+
+AK_API void akPitchTrackerEnsembleGetResults(PitchTrackerEnsembleRef ensemble, int channel,
+                                             float* trackedAmplitude, float* trackedFrequency) {
+    *trackedAmplitude = ensemble->trackedAmplitudes[channel];
+    *trackedFrequency = ensemble->trackedFrequencies[channel];
+}
@@ -0,0 +1,366 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+#include "WaveformOverview.h"
+
+#include <Accelerate/Accelerate.h>
+#include <AudioToolbox/AudioToolbox.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// The scan decodes the file once through ExtAudioFile into planar floats and
+// reduces 256-frame runs with vDSP min/max/mean-square; the coarser levels
+// (4096:1, 65536:1) are folded 16:1 from the level below, so the audio is
+// only ever traversed at full rate once. The sidecar stores all three levels
+// plus the partial accumulator for the unfinished tail bin, which is what
+// lets a growing recording resume mid-bin instead of rescanning.
+
+namespace {
+
+constexpr uint32_t kBaseDecimation = 256;
+constexpr uint32_t kLevelFold = 16;  // 256 -> 4096 -> 65536
+constexpr uint32_t kOverviewMagic = 'AKOV';
+constexpr uint32_t kOverviewVersion = 1;
+constexpr uint32_t kScanChunkFrames = 65536;
+
+struct OverviewFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t frameCount;
+    double sampleRate;
+    uint32_t channelCount;
+    uint32_t carryCount;
+    float carryMin;
+    float carryMax;
+    double carrySumSq;
+    uint64_t binCount;  // level-0 bins that follow
+};
+
+}  // namespace
+
+struct WaveformOverviewData {
+    std::string audioPath;
+    std::string overviewPath;
+
+    double sampleRate = 0;
+    uint32_t channelCount = 0;
+    uint64_t frameCount = 0;  // frames covered by the pyramid
+
+    std::vector<WaveformOverviewBin> levels[AK_OVERVIEW_LEVELS];
+
+    // in-progress level-0 bin (fewer than 256 frames scanned so far)
+    uint32_t carryCount = 0;
+    float carryMin = 0;
+    float carryMax = 0;
+    double carrySumSq = 0;
+
+    void reset() {
+        frameCount = 0;
+        carryCount = 0;
+        carryMin = 0;
+        carryMax = 0;
+        carrySumSq = 0;
+        for (auto& level : levels) level.clear();
+    }
+
+    void flushCarryBin() {
+        WaveformOverviewBin bin;
+        bin.minValue = carryMin;
+        bin.maxValue = carryMax;
+        bin.rms = (float)sqrt(carrySumSq / ((double)carryCount * channelCount));
+        levels[0].push_back(bin);
+        carryCount = 0;
+        carryMin = 0;
+        carryMax = 0;
+        carrySumSq = 0;
+    }
+
+    // Folds one level-0 run of `frames` planar samples into the pyramid.
+    // `planes[ch] + offset` is the first sample of the run.
+    void accumulate(const float* const* planes, uint32_t offset, uint32_t frames) {
+        uint32_t pos = 0;
+        while (pos < frames) {
+            uint32_t take = std::min(kBaseDecimation - carryCount, frames - pos);
+            for (uint32_t ch = 0; ch < channelCount; ++ch) {
+                const float* run = planes[ch] + offset + pos;
+                float lo, hi, meansq;
+                vDSP_minv(run, 1, &lo, take);
+                vDSP_maxv(run, 1, &hi, take);
+                vDSP_measqv(run, 1, &meansq, take);
+                if (carryCount == 0 && ch == 0) {
+                    carryMin = lo;
+                    carryMax = hi;
+                } else {
+                    carryMin = std::min(carryMin, lo);
+                    carryMax = std::max(carryMax, hi);
+                }
+                carrySumSq += (double)meansq * take;
+            }
+            carryCount += take;
+            pos += take;
+            frameCount += take;
+            if (carryCount == kBaseDecimation) flushCarryBin();
+        }
+    }
+
+    // Rebuilds levels 1..n from level 0. Cheap relative to the decode (an
+    // hour of audio is ~600k level-0 bins), so incremental updates just
+    // refold rather than carrying per-level state.
+    void foldUpperLevels() {
+        // frames inside complete level-0 bins; the carry isn't in any bin yet
+        uint64_t covered = (uint64_t)levels[0].size() * kBaseDecimation;
+        for (uint32_t level = 1; level < AK_OVERVIEW_LEVELS; ++level) {
+            const auto& below = levels[level - 1];
+            auto& bins = levels[level];
+            bins.clear();
+            uint64_t childFrames = (uint64_t)akWaveformOverviewDecimation(level - 1);
+            for (size_t i = 0; i < below.size(); i += kLevelFold) {
+                size_t last = std::min(below.size(), i + kLevelFold);
+                WaveformOverviewBin bin = below[i];
+                double sumsq = 0;
+                uint64_t total = 0;
+                for (size_t j = i; j < last; ++j) {
+                    bin.minValue = std::min(bin.minValue, below[j].minValue);
+                    bin.maxValue = std::max(bin.maxValue, below[j].maxValue);
+                    // the last child bin of a level may cover fewer frames
+                    uint64_t n = std::min(childFrames, covered - j * childFrames);
+                    sumsq += (double)below[j].rms * below[j].rms * n;
+                    total += n;
+                }
+                bin.rms = (float)sqrt(sumsq / total);
+                bins.push_back(bin);
+            }
+        }
+    }
+
+    bool loadSidecar() {
+        FILE* fp = fopen(overviewPath.c_str(), "rb");
+        if (fp == nullptr) return false;
+        OverviewFileHeader header;
+        if (fread(&header, sizeof(header), 1, fp) != 1 ||
+            header.magic != kOverviewMagic || header.version != kOverviewVersion ||
+            header.sampleRate != sampleRate || header.channelCount != channelCount) {
+            fclose(fp);
+            return false;
+        }
+        levels[0].resize(header.binCount);
+        if (header.binCount > 0 &&
+            fread(levels[0].data(), sizeof(WaveformOverviewBin),
+                  header.binCount, fp) != header.binCount) {
+            fclose(fp);
+            levels[0].clear();
+            return false;
+        }
+        fclose(fp);
+        frameCount = header.frameCount;
+        carryCount = header.carryCount;
+        carryMin = header.carryMin;
+        carryMax = header.carryMax;
+        carrySumSq = header.carrySumSq;
+        foldUpperLevels();
+        return true;
+    }
+
+    bool saveSidecar() {
+        std::string tmp = overviewPath + ".tmp";
+        FILE* fp = fopen(tmp.c_str(), "wb");
+        if (fp == nullptr) return false;
+        OverviewFileHeader header = {};
+        header.magic = kOverviewMagic;
+        header.version = kOverviewVersion;
+        header.frameCount = frameCount;
+        header.sampleRate = sampleRate;
+        header.channelCount = channelCount;
+        header.carryCount = carryCount;
+        header.carryMin = carryMin;
+        header.carryMax = carryMax;
+        header.carrySumSq = carrySumSq;
+        header.binCount = levels[0].size();
+        bool ok = fwrite(&header, sizeof(header), 1, fp) == 1;
+        if (ok && !levels[0].empty()) {
+            ok = fwrite(levels[0].data(), sizeof(WaveformOverviewBin),
+                        levels[0].size(), fp) == levels[0].size();
+        }
+        ok = (fclose(fp) == 0) && ok;
+        if (!ok || rename(tmp.c_str(), overviewPath.c_str()) != 0) {
+            remove(tmp.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    // Opens the audio, scans [frameCount, end) into the pyramid, and
+    // rewrites the sidecar. A no-op when the file hasn't grown.
+    bool scanTail() {
+        CFURLRef url = CFURLCreateFromFileSystemRepresentation(
+            nullptr, (const UInt8*)audioPath.c_str(), audioPath.size(), false);
+        if (url == nullptr) return false;
+        ExtAudioFileRef file = nullptr;
+        OSStatus status = ExtAudioFileOpenURL(url, &file);
+        CFRelease(url);
+        if (status != noErr) return false;
+
+        AudioStreamBasicDescription fileFormat = {};
+        UInt32 size = sizeof(fileFormat);
+        status = ExtAudioFileGetProperty(file, kExtAudioFileProperty_FileDataFormat,
+                                         &size, &fileFormat);
+        SInt64 totalFrames = 0;
+        size = sizeof(totalFrames);
+        if (status == noErr) {
+            status = ExtAudioFileGetProperty(file, kExtAudioFileProperty_FileLengthFrames,
+                                             &size, &totalFrames);
+        }
+        if (status != noErr || fileFormat.mChannelsPerFrame == 0) {
+            ExtAudioFileDispose(file);
+            return false;
+        }
+
+        if (sampleRate == 0) {
+            sampleRate = fileFormat.mSampleRate;
+            channelCount = fileFormat.mChannelsPerFrame;
+        } else if (sampleRate != fileFormat.mSampleRate ||
+                   channelCount != fileFormat.mChannelsPerFrame) {
+            // the file was replaced, not appended to
+            reset();
+            sampleRate = fileFormat.mSampleRate;
+            channelCount = fileFormat.mChannelsPerFrame;
+        }
+        if ((uint64_t)totalFrames < frameCount) reset();
+        if ((uint64_t)totalFrames == frameCount) {
+            ExtAudioFileDispose(file);
+            return true;
+        }
+
+        // decode planar float at the file's own rate; no SRC in the scan
+        AudioStreamBasicDescription clientFormat = {};
+        clientFormat.mSampleRate = fileFormat.mSampleRate;
+        clientFormat.mFormatID = kAudioFormatLinearPCM;
+        clientFormat.mFormatFlags = kAudioFormatFlagIsFloat | kAudioFormatFlagIsPacked |
+                                    kAudioFormatFlagIsNonInterleaved;
+        clientFormat.mBitsPerChannel = 32;
+        clientFormat.mChannelsPerFrame = channelCount;
+        clientFormat.mBytesPerFrame = sizeof(float);
+        clientFormat.mBytesPerPacket = sizeof(float);
+        clientFormat.mFramesPerPacket = 1;
+        status = ExtAudioFileSetProperty(file, kExtAudioFileProperty_ClientDataFormat,
+                                         sizeof(clientFormat), &clientFormat);
+        if (status == noErr && frameCount > 0) {
+            status = ExtAudioFileSeek(file, (SInt64)frameCount);
+        }
+        if (status != noErr) {
+            ExtAudioFileDispose(file);
+            return false;
+        }
+
+        std::vector<float> data((size_t)channelCount * kScanChunkFrames);
+        std::vector<const float*> planes(channelCount);
+        std::vector<uint8_t> listStorage(offsetof(AudioBufferList, mBuffers) +
+                                         channelCount * sizeof(AudioBuffer));
+        auto* list = (AudioBufferList*)listStorage.data();
+        list->mNumberBuffers = channelCount;
+        for (uint32_t ch = 0; ch < channelCount; ++ch) {
+            planes[ch] = data.data() + (size_t)ch * kScanChunkFrames;
+        }
+
+        bool ok = true;
+        while (frameCount < (uint64_t)totalFrames) {
+            UInt32 frames = kScanChunkFrames;
+            for (uint32_t ch = 0; ch < channelCount; ++ch) {
+                list->mBuffers[ch].mNumberChannels = 1;
+                list->mBuffers[ch].mDataByteSize = kScanChunkFrames * sizeof(float);
+                list->mBuffers[ch].mData = (void*)planes[ch];
+            }
+            if (ExtAudioFileRead(file, &frames, list) != noErr) {
+                ok = false;
+                break;
+            }
+            if (frames == 0) break;
+            accumulate(planes.data(), 0, frames);
+        }
+        ExtAudioFileDispose(file);
+        if (!ok) return false;
+
+        foldUpperLevels();
+        return saveSidecar();
+    }
+};
+
+uint32_t akWaveformOverviewDecimation(uint32_t level) {
+    uint32_t decimation = kBaseDecimation;
+    while (level-- > 0) decimation *= kLevelFold;
+    return decimation;
+}
+
+WaveformOverviewRef akWaveformOverviewOpen(const char* audioPath,
+                                           const char* overviewPath) {
+    if (audioPath == nullptr || overviewPath == nullptr) return nullptr;
+    auto* overview = new WaveformOverviewData;
+    overview->audioPath = audioPath;
+    overview->overviewPath = overviewPath;
+
+    // The sidecar can only be validated against the audio's format, so peek
+    // at the format first; loading failure just means a full scan.
+    CFURLRef url = CFURLCreateFromFileSystemRepresentation(
+        nullptr, (const UInt8*)audioPath, strlen(audioPath), false);
+    if (url != nullptr) {
+        ExtAudioFileRef file = nullptr;
+        if (ExtAudioFileOpenURL(url, &file) == noErr) {
+            AudioStreamBasicDescription fileFormat = {};
+            UInt32 size = sizeof(fileFormat);
+            if (ExtAudioFileGetProperty(file, kExtAudioFileProperty_FileDataFormat,
+                                        &size, &fileFormat) == noErr) {
+                overview->sampleRate = fileFormat.mSampleRate;
+                overview->channelCount = fileFormat.mChannelsPerFrame;
+                overview->loadSidecar();
+            }
+            ExtAudioFileDispose(file);
+        }
+        CFRelease(url);
+    }
+
+    if (!overview->scanTail()) {
+        delete overview;
+        return nullptr;
+    }
+    return overview;
+}
+
+void akWaveformOverviewClose(WaveformOverviewRef overview) {
+    delete overview;
+}
+
+bool akWaveformOverviewUpdate(WaveformOverviewRef overview) {
+    return overview->scanTail();
+}
+
+uint64_t akWaveformOverviewFrameCount(WaveformOverviewRef overview) {
+    return overview->frameCount;
+}
+
+double akWaveformOverviewSampleRate(WaveformOverviewRef overview) {
+    return overview->sampleRate;
+}
+
+uint32_t akWaveformOverviewChannelCount(WaveformOverviewRef overview) {
+    return overview->channelCount;
+}
+
+uint64_t akWaveformOverviewBinCount(WaveformOverviewRef overview, uint32_t level) {
+    if (level >= AK_OVERVIEW_LEVELS) return 0;
+    // the unfinished carry bin is not readable until it fills or the scan ends
+    return overview->levels[level].size();
+}
+
+uint64_t akWaveformOverviewRead(WaveformOverviewRef overview, uint32_t level,
+                                uint64_t firstBin, uint64_t binCount,
+                                WaveformOverviewBin* outBins) {
+    if (level >= AK_OVERVIEW_LEVELS || outBins == nullptr) return 0;
+    const auto& bins = overview->levels[level];
+    if (firstBin >= bins.size()) return 0;
+    uint64_t count = std::min(binCount, (uint64_t)bins.size() - firstBin);
+    memcpy(outBins, bins.data() + firstBin, (size_t)count * sizeof(WaveformOverviewBin));
+    return count;
+}
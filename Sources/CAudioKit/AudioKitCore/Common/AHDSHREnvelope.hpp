@@ -86,6 +86,13 @@ namespace AudioKitCore
             return sample;
         }
 
+        /// fill a block of consecutive envelope samples, branching only at
+        /// segment boundaries; matches repeated getSample() calls exactly
+        inline void getSamples(float *out, int sampleCount)
+        {
+            env.getSamples(out, sampleCount);
+        }
+
     protected:
         MultiSegmentEnvelopeGenerator env;
         MultiSegmentEnvelopeGenerator::Descriptor envDesc;
@@ -23,27 +23,62 @@ namespace AudioKitCore
         // per-phase variables
         static constexpr int phaseCount = 16;
 
+        // Per-phase state is accessed through these pointers. By default they
+        // point at the internal arrays below; a polyphonic synth can repoint
+        // them into a shared bank (see SynthVoiceStateBank) so all voices'
+        // phases are contiguous in memory.
+
         // WaveStack octave used by this phase
-        int octave[phaseCount];
+        int *octave;
 
         // Fraction of the way through waveform
-        float phase[phaseCount];
+        float *phase;
 
         // normalized frequency: cycles per sample
-        float phaseDelta[phaseCount];
+        float *phaseDelta;
+
+        // internal fallback storage for a standalone oscillator
+        int octaveInternal[phaseCount];
+        float phaseInternal[phaseCount];
+        float phaseDeltaInternal[phaseCount];
 
         // relative level of each phase (fraction)
         float *level;
         float safetyLevels[phaseCount];
 
+        // Optional combined-cycle stack: one cycle of the complete summed
+        // registration, built with buildCombinedCycle() whenever the drawbar
+        // levels settle. When set, getSample() reads this stack with a single
+        // phase instead of evaluating all 16 partials.
+        WaveStack *pCombinedStack;
+
         // performance variables
 
         // phaseDelta multiplier for pitchbend, vibrato
         float phaseDeltaMultiplier;
 
+        DrawbarsOscillator() { useInternalState(); }
+
+        // point per-phase state at the internal member arrays (the default)
+        void useInternalState();
+
+        // point per-phase state at caller-owned storage of phaseCount
+        // elements each; call before init()
+        void useExternalState(int *octaves, float *phases, float *phaseDeltas);
+
         void init(double sampleRate, WaveStack* pStack);
         void setFrequency(float frequency);
 
+        // switch to single-phase readout of a pre-built combined-cycle stack;
+        // pass null to return to per-partial evaluation
+        void useCombinedCycle(WaveStack *pStack);
+
+        // Render one cycle of the summed drawbar registration, band-limited
+        // partial by partial from the source stack, into pCycleOut
+        // (1 << WaveStack::maxBits samples); feed it to WaveStack::initStack()
+        static void buildCombinedCycle(WaveStack *pSourceStack, const float *levels,
+                                       float *pCycleOut);
+
         float getSample();
         void getSamples(float *pLeft, float *pRight, float gain);
 
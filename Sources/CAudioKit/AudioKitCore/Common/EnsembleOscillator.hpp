@@ -15,12 +15,29 @@ namespace AudioKitCore
     /// is a conventional, single-phase oscillator.
     struct EnsembleOscillator
     {
+        /// Waveform generation method. The default reads the shared WaveStack;
+        /// the polyBLEP modes compute a band-limited saw or square wave
+        /// directly from the phase, with no table fetch at all.
+        enum WaveformMode
+        {
+            waveStackTable,
+            polyBLEPSaw,
+            polyBLEPSquare
+        };
+
         /// current output sample rate
         double sampleRateHz;
 
         /// pointer to shared WaveStack
         WaveStack *pWaveStack;
 
+        /// how samples are generated (table fetch vs. algorithmic)
+        WaveformMode waveformMode;
+
+        /// output amplitude for the algorithmic modes (table mode amplitude
+        /// is baked into the WaveStack itself)
+        float waveformAmplitude;
+
         /// number of unison/ensemble phases
         int phaseCount;
         /// frequency difference between phases, cents
@@ -31,24 +48,46 @@ namespace AudioKitCore
         /// maximum number of phases
         static constexpr int maxPhases = 10;
 
+        // Per-phase state is accessed through these pointers. By default they
+        // point at the internal arrays below; a polyphonic synth can repoint
+        // them into a shared bank (see SynthVoiceStateBank) so all voices'
+        // phases are contiguous in memory.
+
         /// WaveStack octave used by this phase
-        int octave[maxPhases];
+        int *octave;
 
         /// Fraction of the way through waveform
-        float phase[maxPhases];
+        float *phase;
 
         /// normalized frequency: cycles per sample
-        float phaseDelta[maxPhases];
-        float leftGain[maxPhases];
-        float rightGain[maxPhases];
+        float *phaseDelta;
+        float *leftGain;
+        float *rightGain;
+
+        // internal fallback storage for a standalone oscillator
+        int octaveInternal[maxPhases];
+        float phaseInternal[maxPhases];
+        float phaseDeltaInternal[maxPhases];
+        float leftGainInternal[maxPhases];
+        float rightGainInternal[maxPhases];
 
         // performance variables
 
         /// phaseDelta multiplier for pitchbend, vibrato
         float phaseDeltaMultiplier;
 
-        EnsembleOscillator() : phaseCount(1), frequencySpread(0.0f) {}
+        EnsembleOscillator() : phaseCount(1), frequencySpread(0.0f) { useInternalState(); }
+
+        /// point per-phase state at the internal member arrays (the default)
+        void useInternalState();
+
+        /// point per-phase state at caller-owned storage of maxPhases
+        /// elements each; call before init()
+        void useExternalState(int *octaves, float *phases, float *phaseDeltas,
+                              float *leftGains, float *rightGains);
+
         void init(double sampleRate, WaveStack *pStack);
+        void setWaveformMode(WaveformMode mode, float amplitude);
         void setPhases(int nPhases);
         void setFreqSpread(float fSpread) { frequencySpread = fSpread; }
 
@@ -58,6 +97,9 @@ namespace AudioKitCore
 
         float getSample();
         void getSamples(float *pLeft, float *pRight, float gain);
+
+        /// band-limited saw/square sample computed directly from a phase
+        float algorithmicSample(float t, float dt);
     };
 
 }
@@ -1,11 +1,52 @@
 // Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
 
 #include "EnvelopeGeneratorBase.hpp"
+#include <atomic>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 
 namespace AudioKitCore
 {
 
+    // Shared memo for the per-segment coefficient exp()/log(). All voices
+    // of a sampler share one envelope descriptor, so at any segment
+    // transition 64 voices x 3 envelopes ask for the coefficient of the
+    // same (delta, tco, length) triple; only the first computes it. Slots
+    // are seqlock-style (tag checked before and after the read) because
+    // segment transitions can happen on the voice worker threads; a reader
+    // losing a collision race just computes the value itself.
+    static double segmentCoefficient(double delta, double tco, int segmentLengthSamples)
+    {
+        struct Slot
+        {
+            std::atomic<uint64_t> tag;
+            std::atomic<double> value;
+        };
+        static Slot slots[64];
+
+        uint64_t deltaBits, tcoBits;
+        memcpy(&deltaBits, &delta, sizeof(deltaBits));
+        memcpy(&tcoBits, &tco, sizeof(tcoBits));
+        uint64_t tag = (deltaBits * 0x9E3779B97F4A7C15ull) ^
+                       (tcoBits + 0x9E3779B97F4A7C15ull) ^
+                       ((uint64_t)segmentLengthSamples << 1);
+        if (tag == 0) tag = 1;
+        Slot &slot = slots[tag & 63];
+
+        if (slot.tag.load(std::memory_order_acquire) == tag)
+        {
+            double v = slot.value.load(std::memory_order_relaxed);
+            if (slot.tag.load(std::memory_order_acquire) == tag) return v;
+        }
+
+        double v = exp(-log((delta + tco) / tco) / segmentLengthSamples);
+        slot.tag.store(0, std::memory_order_relaxed);
+        slot.value.store(v, std::memory_order_relaxed);
+        slot.tag.store(tag, std::memory_order_release);
+        return v;
+    }
+
     void ExponentialSegmentGenerator::reset(double initialValue, double targetValue, double tco, int segmentLengthSamples)
     {
         output = segmentLengthSamples > 0 ? initialValue : targetValue;
@@ -38,7 +79,7 @@ namespace AudioKitCore
                 // Correction to Pirkle (who uses delta = 1.0 always)
                 // According to Redmon (who only discusses the delta = 1.0 case), delta should be defined thus
                 double delta = abs(targetValue - initialValue);
-                coefficient = exp(-log((delta + tco) / tco) / segmentLengthSamples);
+                coefficient = segmentCoefficient(delta, tco, segmentLengthSamples);
                 if (isRising)
                     offset = (target + tco) * (1.0 - coefficient);
                 else
@@ -47,6 +88,98 @@ namespace AudioKitCore
         }
     }
 
+    int ExponentialSegmentGenerator::getSampleRun(float *out, int sampleCount, bool &segmentEnded)
+    {
+        segmentEnded = false;
+
+        if (isHorizontal)
+        {
+            const float value = float(target);
+            if (segLength < 0)
+            {
+                // non-timed "sustain" segment: fill the whole run
+                for (int i = 0; i < sampleCount; i++) out[i] = value;
+                return sampleCount;
+            }
+
+            // timed "hold" segment: fill up to the segment boundary
+            int run = segLength - tcount;
+            if (run < 1) run = 1;
+            if (run > sampleCount) run = sampleCount;
+            for (int i = 0; i < run; i++) out[i] = value;
+            tcount += run;
+            segmentEnded = (tcount >= segLength);
+            return run;
+        }
+
+        // recurrence state in locals for the whole run
+        double o = output;
+        const double t = target;
+        const double off = offset;
+        const double c = coefficient;
+        const bool rising = isRising;
+
+        int i = 0;
+        if (isLinear)
+        {
+            while (i < sampleCount)
+            {
+                o += c;
+                if (rising ? (o >= t) : (o <= t))
+                {
+                    o = t;
+                    out[i++] = float(o);
+                    segmentEnded = true;
+                    break;
+                }
+                out[i++] = float(o);
+            }
+        }
+        else
+        {
+            while (i < sampleCount)
+            {
+                o = off + c * o;
+                if (rising ? (o >= t) : (o <= t))
+                {
+                    o = t;
+                    out[i++] = float(o);
+                    segmentEnded = true;
+                    break;
+                }
+                out[i++] = float(o);
+            }
+        }
+        output = o;
+        return i;
+    }
+
+    bool MultiSegmentEnvelopeGenerator::getSamples(float *out, int sampleCount)
+    {
+        bool wrapped = false;
+        while (sampleCount > 0)
+        {
+            bool segmentEnded = false;
+            int done = getSampleRun(out, sampleCount, segmentEnded);
+            out += done;
+            sampleCount -= done;
+
+            if (segmentEnded)
+            {
+                if (++curSegIndex >= int(segments->size()))
+                {
+                    reset(segments);
+                    wrapped = true;
+                }
+                else
+                {
+                    setupCurSeg();
+                }
+            }
+        }
+        return wrapped;
+    }
+
     void MultiSegmentEnvelopeGenerator::setupCurSeg()
     {
         SegmentDescriptor seg = (*segments)[curSegIndex];
@@ -46,6 +46,13 @@ namespace AudioKitCore
             }
         }
 
+        /// Write up to sampleCount consecutive samples of the current segment
+        /// to out, using the precomputed multiply/add recurrence with state
+        /// held in locals. Returns the number of samples written and sets
+        /// segmentEnded when the segment finished on the last one. Sample
+        /// values match repeated getSample() calls exactly.
+        int getSampleRun(float *out, int sampleCount, bool &segmentEnded);
+
     protected:
         double output, target, offset, coefficient;
         bool isRising;
@@ -87,6 +94,12 @@ namespace AudioKitCore
             return false;
         }
 
+        /// Fill out with sampleCount consecutive envelope samples, branching
+        /// only at segment boundaries instead of once per sample. Returns
+        /// true if the envelope wrapped past its last segment, like
+        /// getSample() does on its final sample.
+        bool getSamples(float *out, int sampleCount);
+
         int getCurrentSegmentIndex() { return curSegIndex; }
 
     protected:
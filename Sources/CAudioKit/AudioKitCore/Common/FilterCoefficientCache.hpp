@@ -0,0 +1,89 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+// FilterCoefficientCache shares ResonantLowPassFilter coefficient sets
+// across sampler voices within one render quantum. Parameters are quantized
+// into a key; voices whose effective cutoff/resonance land on the same key
+// (all voices when key tracking is off, and always both channels of one
+// voice) reuse one computed set instead of each redoing the table math.
+//
+// Lookups may run concurrently from the voice worker threads, so slots use
+// a seqlock-style tag: a reader that observes the tag intact before and
+// after copying the set takes the hit; otherwise it computes its own copy
+// and republishes. Racing writers for the same key write identical values.
+
+#pragma once
+
+#include "ResonantLowPassFilter.hpp"
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+
+namespace AudioKitCore
+{
+
+    struct FilterCoefficientCache
+    {
+        static constexpr int slotCount = 64;
+
+        struct Slot
+        {
+            std::atomic<uint64_t> tag { 0 };
+            std::atomic<double> a0 { 0.0 }, a1 { 0.0 }, a2 { 0.0 }, b1 { 0.0 }, b2 { 0.0 };
+        };
+
+        Slot slots[slotCount];
+        uint32_t generation = 0;
+
+        /// Call once per render quantum, before any voice looks up, to
+        /// invalidate the previous quantum's entries
+        void beginQuantum()
+        {
+            if (++generation == 0) generation = 1;
+        }
+
+        /// Returns the shared coefficient set for the quantized parameters,
+        /// computing and publishing it if this key hasn't been seen this
+        /// quantum. outCutoffHz/outResLinear receive the quantized values
+        /// the set was computed from, for the filters' change detection.
+        void lookup(double cutoffHz, double resLinear, double sampleRateHz,
+                    ResonantLowPassFilter::Coefficients &c,
+                    double &outCutoffHz, double &outResLinear)
+        {
+            // 1/16 Hz cutoff steps and 1/1024 resonance steps: far below
+            // audibility, but coarse enough that identically key-tracked
+            // voices collapse onto one key
+            int32_t cutoffQ = (int32_t)lround(cutoffHz * 16.0);
+            int32_t resQ = (int32_t)lround(resLinear * 1024.0);
+            outCutoffHz = cutoffQ / 16.0;
+            outResLinear = resQ / 1024.0;
+
+            uint32_t key = (uint32_t)cutoffQ * 31u + (uint32_t)resQ;
+            if (key == 0) key = 1;
+            uint64_t want = ((uint64_t)generation << 32) | key;
+            Slot &slot = slots[key % slotCount];
+
+            if (slot.tag.load(std::memory_order_acquire) == want)
+            {
+                c.a0 = slot.a0.load(std::memory_order_relaxed);
+                c.a1 = slot.a1.load(std::memory_order_relaxed);
+                c.a2 = slot.a2.load(std::memory_order_relaxed);
+                c.b1 = slot.b1.load(std::memory_order_relaxed);
+                c.b2 = slot.b2.load(std::memory_order_relaxed);
+                // a colliding writer may have raced the copy; the recheck
+                // catches it and falls through to computing locally
+                if (slot.tag.load(std::memory_order_acquire) == want) return;
+            }
+
+            ResonantLowPassFilter::computeCoefficients(outCutoffHz, outResLinear, sampleRateHz, c);
+
+            slot.tag.store(0, std::memory_order_relaxed);
+            slot.a0.store(c.a0, std::memory_order_relaxed);
+            slot.a1.store(c.a1, std::memory_order_relaxed);
+            slot.a2.store(c.a2, std::memory_order_relaxed);
+            slot.b1.store(c.b1, std::memory_order_relaxed);
+            slot.b2.store(c.b2, std::memory_order_relaxed);
+            slot.tag.store(want, std::memory_order_release);
+        }
+    };
+
+}
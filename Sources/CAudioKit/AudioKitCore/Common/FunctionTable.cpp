@@ -1,156 +1,419 @@
-// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
-
-#include "FunctionTable.hpp"
-#ifndef _USE_MATH_DEFINES
-  #define _USE_MATH_DEFINES
-#endif
-#include <math.h>
-
-namespace AudioKitCore
-{
-
-    void FunctionTable::init(int tableLength)
-    {
-        if (nTableSize == tableLength) return;
-        nTableSize = tableLength;
-        if (pWaveTable) delete[] pWaveTable;
-        pWaveTable = new float[tableLength];
-    }
-    
-    void FunctionTable::deinit()
-    {
-        if (pWaveTable) delete[] pWaveTable;
-        nTableSize = 0;
-        pWaveTable = 0;
-    }
-    
-    void FunctionTable::triangle(float amplitude)
-    {
-        // in case user forgot, init table to size 2
-        if (pWaveTable == 0) init(2);
-        
-        if (nTableSize == 2)   // default 2 elements suffice for a triangle wave
-        {
-            pWaveTable[0] = -amplitude;
-            pWaveTable[1] = amplitude;
-        }
-        else    // you would normally only do this if you plan to low-pass filter the result
-        {
-            for (int i=0; i < nTableSize; i++)
-                pWaveTable[i] = 2.0f * amplitude * (0.25f - fabsf((float(i)/nTableSize) - 0.5f));
-        }
-    }
-    
-    void FunctionTable::sawtooth(float amplitude)
-    {
-        // in case user forgot, init table to default size
-        if (pWaveTable == 0) init();
-        
-        for (int i=0; i < nTableSize; i++)
-            pWaveTable[i] = (float)(2.0 * amplitude * double(i)/nTableSize - amplitude);
-    }
-    
-    void FunctionTable::sinusoid(float amplitude)
-    {
-        // in case user forgot, init table to default size
-        if (pWaveTable == 0) init();
-        
-        for (int i=0; i < nTableSize; i++)
-            pWaveTable[i] = (float)(amplitude * sin(double(i)/nTableSize * 2.0 * M_PI));
-    }
-
-    // A variation of sinusoid() which adds a tiny bit of 2nd harmonic, producing a tone closer to
-    // that of a Hammond organ tonewheel generator.
-    void AudioKitCore::FunctionTable::hammond(float amplitude)
-    {
-        // in case user forgot, init table to default size
-        if (pWaveTable == 0) init();
-
-        for (int i = 0; i < nTableSize; i++)
-            pWaveTable[i] = (float)(amplitude *
-                (sin(double(i) / nTableSize * 2.0 * M_PI) + 0.015f * sin(double(i) / nTableSize * 4.0 * M_PI))
-                );
-    }
-
-    void FunctionTable::square(float amplitude, float dutyCycle)
-    {
-        // in case user forgot, init table to default size
-        if (pWaveTable == 0) init();
-
-        float dcOffset = amplitude * (2.0f * dutyCycle - 1.0f);
-        for (int i=0; i < nTableSize; i++)
-        {
-            float phase = (float)i / nTableSize;
-            pWaveTable[i] = (phase < dutyCycle ? amplitude : -amplitude) - dcOffset;
-        }
-    }
-
-    void FunctionTable::linearCurve(float gain)
-    {
-        // in case user forgot, init table to default size
-        if (pWaveTable == 0) init();
-
-        for (int i = 0; i < nTableSize; i++)
-            pWaveTable[i] = gain * i / float(nTableSize);
-    }
-    
-    // Initialize a FunctionTable to an exponential shape, scaled to fit in the unit square.
-    // The function itself is y = -exp(-x), where x ranges from 'left' to 'right'.
-    // The more negative 'left' is, the more vertical the start of the rise; -5.0 yields near-vertical.
-    // The more positive 'right' is, the more horizontal then end of the rise; +5.0 yields near-horizontal.
-    void FunctionTable::exponentialCurve(float left, float right)
-    {
-        // in case user forgot, init table to default size
-        if (pWaveTable == 0) init();
-        
-        float bottom = -expf(-left);
-        float top = -expf(-right);
-        float vscale = 1.0f / (top - bottom);
-        
-        float x = left;
-        float dx = (right - left) / (nTableSize - 1);
-        for (int i=0; i < nTableSize; i++, x += dx)
-            pWaveTable[i] = vscale * (-expf(-x) - bottom);
-    }
-
-    // Initialize a FunctionTable to a power-curve shape, defined in the unit square.
-    // The given exponent may be positive for a concave-up shape or negative for concave-down.
-    // Typical range of the exponent is plus or minus 4 or 5.
-    void FunctionTable::powerCurve(float exponent)
-    {
-        // in case user forgot, init table to default size
-        if (pWaveTable == 0) init();
-
-        float x = 0.0f;
-        float dx = 1.0f / (nTableSize - 1);
-        for (int i=0; i < nTableSize; i++, x += dx)
-            pWaveTable[i] = powf(x, exponent);
-    }
-
-    void FunctionTableOscillator::init(double sampleRate, float frequency, int tableLength)
-    {
-        waveTable.init(tableLength);
-        sampleRateHz = sampleRate;
-        phase = 0.0f;
-        phaseDelta = (float)(frequency / sampleRate);
-    }
-    
-    void FunctionTableOscillator::deinit()
-    {
-        waveTable.deinit();
-    }
-    
-    void FunctionTableOscillator::setFrequency(float frequency)
-    {
-        phaseDelta = (float)(frequency / sampleRateHz);
-    }
-
-    // Initialize WaveShaper's lookup table to an identity
-    void WaveShaper::init(int tableLength)
-    {
-        waveTable.init(tableLength);
-        for (int i = 0; i < tableLength; i++)
-            waveTable.pWaveTable[i] = i / float(tableLength);
-    }
-}
-
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+#include "FunctionTable.hpp"
+#ifndef _USE_MATH_DEFINES
+  #define _USE_MATH_DEFINES
+#endif
+#include <math.h>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace AudioKitCore
+{
+
+    // Unit-amplitude versions of the standard shapes, built once per
+    // (shape, size) pair and shared const across all FunctionTable instances.
+    // A synth full of LFOs no longer computes (or stores) its own identical
+    // sine tables; the tables live for the life of the process.
+    enum StandardShape { kShapeTriangle, kShapeSawtooth, kShapeSinusoid, kShapeHammond, kShapeSquare };
+
+    static const float *sharedShapeTable(int shape, int tableSize)
+    {
+        static std::mutex mutex;
+        static std::map<std::pair<int, int>, std::vector<float>> tables;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        auto key = std::make_pair(shape, tableSize);
+        auto found = tables.find(key);
+        if (found != tables.end()) return found->second.data();
+
+        std::vector<float> &table = tables[key];
+        table.resize(tableSize);
+        float *pTable = table.data();
+        for (int i=0; i < tableSize; i++)
+        {
+            double frac = double(i) / tableSize;
+            switch (shape)
+            {
+            case kShapeTriangle:
+                pTable[i] = 2.0f * (0.25f - fabsf(float(frac) - 0.5f));
+                break;
+            case kShapeSawtooth:
+                pTable[i] = (float)(2.0 * frac - 1.0);
+                break;
+            case kShapeSinusoid:
+                pTable[i] = (float)sin(frac * 2.0 * M_PI);
+                break;
+            case kShapeHammond:
+                pTable[i] = (float)(sin(frac * 2.0 * M_PI) + 0.015f * sin(frac * 4.0 * M_PI));
+                break;
+            case kShapeSquare:
+                pTable[i] = frac < 0.5 ? 1.0f : -1.0f;
+                break;
+            }
+        }
+        return pTable;
+    }
+
+    void FunctionTable::init(int tableLength)
+    {
+        if (nTableSize == tableLength && !tableIsShared) return;
+        nTableSize = tableLength;
+        if (pWaveTable && !tableIsShared) delete[] pWaveTable;
+        tableIsShared = false;
+        pWaveTable = new float[tableLength];
+    }
+
+    void FunctionTable::deinit()
+    {
+        if (pWaveTable && !tableIsShared) delete[] pWaveTable;
+        nTableSize = 0;
+        pWaveTable = 0;
+        tableIsShared = false;
+    }
+
+    void FunctionTable::adoptSharedTable(const float *pShared)
+    {
+        if (pWaveTable && !tableIsShared) delete[] pWaveTable;
+        // shared tables are read-only by convention; every function that
+        // writes through pWaveTable calls ensurePrivateTable() first
+        pWaveTable = const_cast<float *>(pShared);
+        tableIsShared = true;
+    }
+
+    void FunctionTable::ensurePrivateTable()
+    {
+        if (!tableIsShared) return;
+        tableIsShared = false;
+        pWaveTable = new float[nTableSize];
+    }
+
+    void FunctionTable::triangle(float amplitude)
+    {
+        // in case user forgot, init table to size 2
+        if (pWaveTable == 0) init(2);
+
+        if (nTableSize == 2)   // default 2 elements suffice for a triangle wave
+        {
+            ensurePrivateTable();
+            pWaveTable[0] = -amplitude;
+            pWaveTable[1] = amplitude;
+        }
+        else if (amplitude == 1.0f)
+        {
+            adoptSharedTable(sharedShapeTable(kShapeTriangle, nTableSize));
+        }
+        else    // you would normally only do this if you plan to low-pass filter the result
+        {
+            ensurePrivateTable();
+            for (int i=0; i < nTableSize; i++)
+                pWaveTable[i] = 2.0f * amplitude * (0.25f - fabsf((float(i)/nTableSize) - 0.5f));
+        }
+    }
+
+    void FunctionTable::sawtooth(float amplitude)
+    {
+        // in case user forgot, init table to default size
+        if (pWaveTable == 0) init();
+
+        if (amplitude == 1.0f)
+        {
+            adoptSharedTable(sharedShapeTable(kShapeSawtooth, nTableSize));
+            return;
+        }
+
+        ensurePrivateTable();
+        for (int i=0; i < nTableSize; i++)
+            pWaveTable[i] = (float)(2.0 * amplitude * double(i)/nTableSize - amplitude);
+    }
+
+    void FunctionTable::sinusoid(float amplitude)
+    {
+        // in case user forgot, init table to default size
+        if (pWaveTable == 0) init();
+
+        if (amplitude == 1.0f)
+        {
+            adoptSharedTable(sharedShapeTable(kShapeSinusoid, nTableSize));
+            return;
+        }
+
+        // non-unit amplitude: scale the shared table instead of calling sin()
+        const float *pUnit = sharedShapeTable(kShapeSinusoid, nTableSize);
+        ensurePrivateTable();
+        for (int i=0; i < nTableSize; i++)
+            pWaveTable[i] = amplitude * pUnit[i];
+    }
+
+    // A variation of sinusoid() which adds a tiny bit of 2nd harmonic, producing a tone closer to
+    // that of a Hammond organ tonewheel generator.
+    void AudioKitCore::FunctionTable::hammond(float amplitude)
+    {
+        // in case user forgot, init table to default size
+        if (pWaveTable == 0) init();
+
+        if (amplitude == 1.0f)
+        {
+            adoptSharedTable(sharedShapeTable(kShapeHammond, nTableSize));
+            return;
+        }
+
+        const float *pUnit = sharedShapeTable(kShapeHammond, nTableSize);
+        ensurePrivateTable();
+        for (int i = 0; i < nTableSize; i++)
+            pWaveTable[i] = amplitude * pUnit[i];
+    }
+
+    void FunctionTable::square(float amplitude, float dutyCycle)
+    {
+        // in case user forgot, init table to default size
+        if (pWaveTable == 0) init();
+
+        if (amplitude == 1.0f && dutyCycle == 0.5f)
+        {
+            adoptSharedTable(sharedShapeTable(kShapeSquare, nTableSize));
+            return;
+        }
+
+        ensurePrivateTable();
+        float dcOffset = amplitude * (2.0f * dutyCycle - 1.0f);
+        for (int i=0; i < nTableSize; i++)
+        {
+            float phase = (float)i / nTableSize;
+            pWaveTable[i] = (phase < dutyCycle ? amplitude : -amplitude) - dcOffset;
+        }
+    }
+
+    void FunctionTable::interp_cyclic_block(const float *pPhases, float *pOut, int sampleCount)
+    {
+        const float *pTable = pWaveTable;
+        const int tableSize = nTableSize;
+
+        for (int n=0; n < sampleCount; n++)
+        {
+            float phase = pPhases[n];
+            while (phase < 0) phase += 1.0;
+            while (phase >= 1.0) phase -= 1.0f;
+
+            float readIndex = phase * tableSize;
+            int ri = int(readIndex);
+            float f = readIndex - ri;
+            int rj = ri + 1; if (rj >= tableSize) rj -= tableSize;
+
+            float si = pTable[ri];
+            float sj = pTable[rj];
+            pOut[n] = (float)((1.0 - f) * si + f * sj);
+        }
+    }
+
+    void FunctionTable::interp_cyclic_cubic_block(const float *pPhases, float *pOut, int sampleCount)
+    {
+        const float *pTable = pWaveTable;
+        const int tableSize = nTableSize;
+
+        for (int n=0; n < sampleCount; n++)
+        {
+            float phase = pPhases[n];
+            while (phase < 0) phase += 1.0f;
+            while (phase >= 1.0f) phase -= 1.0f;
+
+            float readIndex = phase * tableSize;
+            int i1 = int(readIndex);
+            float f = readIndex - i1;
+            int i0 = i1 - 1; if (i0 < 0) i0 += tableSize;
+            int i2 = i1 + 1; if (i2 >= tableSize) i2 -= tableSize;
+            int i3 = i2 + 1; if (i3 >= tableSize) i3 -= tableSize;
+
+            float y0 = pTable[i0], y1 = pTable[i1];
+            float y2 = pTable[i2], y3 = pTable[i3];
+            float c1 = 0.5f * (y2 - y0);
+            float c2 = y0 - 2.5f * y1 + 2.0f * y2 - 0.5f * y3;
+            float c3 = 0.5f * (y3 - y0) + 1.5f * (y1 - y2);
+            pOut[n] = ((c3 * f + c2) * f + c1) * f + y1;
+        }
+    }
+
+    void FunctionTable::interp_bounded_block(const float *pPhases, float *pOut, int sampleCount)
+    {
+        const float *pTable = pWaveTable;
+        const int tableSize = nTableSize;
+        const float maxIndex = float(tableSize - 1);
+
+        for (int n=0; n < sampleCount; n++)
+        {
+            // Clamping the read index reproduces interp_bounded()'s boundary
+            // returns exactly: phase < 0 lands on index 0 with f == 0, and
+            // phase >= 1 lands on the last entry with rj clamped onto it.
+            float readIndex = pPhases[n] * maxIndex;
+            if (readIndex < 0.0f) readIndex = 0.0f;
+            if (readIndex > maxIndex) readIndex = maxIndex;
+
+            int ri = int(readIndex);
+            float f = readIndex - ri;
+            int rj = ri + 1; if (rj >= tableSize) rj = tableSize - 1;
+
+            float si = pTable[ri];
+            float sj = pTable[rj];
+            pOut[n] = (float)((1.0 - f) * si + f * sj);
+        }
+    }
+
+    void FunctionTable::linearCurve(float gain)
+    {
+        // in case user forgot, init table to default size
+        if (pWaveTable == 0) init();
+        ensurePrivateTable();
+
+        for (int i = 0; i < nTableSize; i++)
+            pWaveTable[i] = gain * i / float(nTableSize);
+    }
+    
+    // Initialize a FunctionTable to an exponential shape, scaled to fit in the unit square.
+    // The function itself is y = -exp(-x), where x ranges from 'left' to 'right'.
+    // The more negative 'left' is, the more vertical the start of the rise; -5.0 yields near-vertical.
+    // The more positive 'right' is, the more horizontal then end of the rise; +5.0 yields near-horizontal.
+    void FunctionTable::exponentialCurve(float left, float right)
+    {
+        // in case user forgot, init table to default size
+        if (pWaveTable == 0) init();
+        ensurePrivateTable();
+        
+        float bottom = -expf(-left);
+        float top = -expf(-right);
+        float vscale = 1.0f / (top - bottom);
+        
+        float x = left;
+        float dx = (right - left) / (nTableSize - 1);
+        for (int i=0; i < nTableSize; i++, x += dx)
+            pWaveTable[i] = vscale * (-expf(-x) - bottom);
+    }
+
+    // Initialize a FunctionTable to a power-curve shape, defined in the unit square.
+    // The given exponent may be positive for a concave-up shape or negative for concave-down.
+    // Typical range of the exponent is plus or minus 4 or 5.
+    void FunctionTable::powerCurve(float exponent)
+    {
+        // in case user forgot, init table to default size
+        if (pWaveTable == 0) init();
+        ensurePrivateTable();
+
+        float x = 0.0f;
+        float dx = 1.0f / (nTableSize - 1);
+        for (int i=0; i < nTableSize; i++, x += dx)
+            pWaveTable[i] = powf(x, exponent);
+    }
+
+    void FunctionTableOscillator::init(double sampleRate, float frequency, int tableLength)
+    {
+        waveTable.init(tableLength);
+        sampleRateHz = sampleRate;
+        phase = 0.0f;
+        phaseDelta = (float)(frequency / sampleRate);
+    }
+    
+    void FunctionTableOscillator::deinit()
+    {
+        waveTable.deinit();
+    }
+    
+    void FunctionTableOscillator::setFrequency(float frequency)
+    {
+        phaseDelta = (float)(frequency / sampleRateHz);
+    }
+
+    // Initialize WaveShaper's lookup table to an identity
+    void WaveShaper::init(int tableLength)
+    {
+        waveTable.init(tableLength);
+        for (int i = 0; i < tableLength; i++)
+            waveTable.pWaveTable[i] = i / float(tableLength);
+        invalidateComposedCurve();
+    }
+
+    // Fold the output transform into a private copy of the transfer curve:
+    // y = yScale * T(x) + yOffset commutes with linear interpolation, so
+    // baking it into the table entries drops a multiply-add per sample from
+    // the block loop without changing the shape (rounding differs by at most
+    // one lerp's worth of float error).
+    void WaveShaper::composeTransferCurve()
+    {
+        composedTable.init(waveTable.nTableSize);
+        for (int i = 0; i < waveTable.nTableSize; i++)
+            composedTable.pWaveTable[i] = yScale * waveTable.pWaveTable[i] + yOffset;
+        composedXScale = xScale;
+        composedXOffset = xOffset;
+        composedYScale = yScale;
+        composedYOffset = yOffset;
+        composedValid = true;
+    }
+
+    void WaveShaper::interpBlock(const float *pIn, float *pOut, int sampleCount)
+    {
+        if (!(composedValid &&
+              xScale == composedXScale && xOffset == composedXOffset &&
+              yScale == composedYScale && yOffset == composedYOffset))
+        {
+            bool settled = lastValid &&
+                xScale == lastXScale && xOffset == lastXOffset &&
+                yScale == lastYScale && yOffset == lastYOffset;
+            lastValid = true;
+            lastXScale = xScale;
+            lastXOffset = xOffset;
+            lastYScale = yScale;
+            lastYOffset = yOffset;
+
+            if (settled)
+            {
+                // unchanged since the previous block: bake once, then fall
+                // through to the composed loop below
+                composeTransferCurve();
+            }
+            else
+            {
+                // parameters still moving: apply the transforms live against
+                // the current curve rather than re-baking every block
+                const float *pTable = waveTable.pWaveTable;
+                const int tableSize = waveTable.nTableSize;
+                const float maxIndex = float(tableSize - 1);
+
+                for (int n=0; n < sampleCount; n++)
+                {
+                    float readIndex = (pIn[n] - xOffset) * xScale * maxIndex;
+                    if (readIndex < 0.0f) readIndex = 0.0f;
+                    if (readIndex > maxIndex) readIndex = maxIndex;
+
+                    int ri = int(readIndex);
+                    float f = readIndex - ri;
+                    int rj = ri + 1; if (rj >= tableSize) rj = tableSize - 1;
+
+                    float si = pTable[ri];
+                    float sj = pTable[rj];
+                    pOut[n] = yScale * (float)((1.0 - f) * si + f * sj) + yOffset;
+                }
+                return;
+            }
+        }
+
+        const float *pTable = composedTable.pWaveTable;
+        const int tableSize = composedTable.nTableSize;
+        const float maxIndex = float(tableSize - 1);
+
+        for (int n=0; n < sampleCount; n++)
+        {
+            float readIndex = (pIn[n] - xOffset) * xScale * maxIndex;
+            if (readIndex < 0.0f) readIndex = 0.0f;
+            if (readIndex > maxIndex) readIndex = maxIndex;
+
+            int ri = int(readIndex);
+            float f = readIndex - ri;
+            int rj = ri + 1; if (rj >= tableSize) rj = tableSize - 1;
+
+            float si = pTable[ri];
+            float sj = pTable[rj];
+            pOut[n] = (float)((1.0 - f) * si + f * sj);
+        }
+    }
+}
+
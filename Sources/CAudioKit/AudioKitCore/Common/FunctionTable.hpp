@@ -21,13 +21,19 @@ namespace AudioKitCore
     {
         float *pWaveTable;
         int nTableSize;
-        
-        FunctionTable() : pWaveTable(0), nTableSize(0) {}
+
+        // True when pWaveTable points at one of the shared standard-shape
+        // tables (built once per process and never freed) rather than
+        // per-instance storage. The standard shapes at unit amplitude adopt
+        // the shared tables, so e.g. every LFO's sine table is one allocation.
+        bool tableIsShared;
+
+        FunctionTable() : pWaveTable(0), nTableSize(0), tableIsShared(false) {}
         ~FunctionTable() { deinit(); }
-        
+
         void init(int tableLength=DEFAULT_WAVETABLE_SIZE);
         void deinit();
-        
+
         // functions for use by class FunctionTableOscillator
         void triangle(float amplitude=1.0f);
         void sawtooth(float amplitude=1.0f);
@@ -49,7 +55,40 @@ namespace AudioKitCore
             float sj = pWaveTable[rj];
             return (float)((1.0 - f) * si + f * sj);
         }
-        
+
+        /// 4-point cubic Hermite (Catmull-Rom) variant of interp_cyclic.
+        /// Costs two extra table reads but cuts interpolation noise enough
+        /// that a 1024-point table sounds like a 4096-point linear one.
+        inline float interp_cyclic_cubic(float phase)
+        {
+            while (phase < 0) phase += 1.0f;
+            while (phase >= 1.0f) phase -= 1.0f;
+
+            float readIndex = phase * nTableSize;
+            int i1 = int(readIndex);
+            float f = readIndex - i1;
+            int i0 = i1 - 1; if (i0 < 0) i0 += nTableSize;
+            int i2 = i1 + 1; if (i2 >= nTableSize) i2 -= nTableSize;
+            int i3 = i2 + 1; if (i3 >= nTableSize) i3 -= nTableSize;
+
+            float y0 = pWaveTable[i0], y1 = pWaveTable[i1];
+            float y2 = pWaveTable[i2], y3 = pWaveTable[i3];
+            float c1 = 0.5f * (y2 - y0);
+            float c2 = y0 - 2.5f * y1 + 2.0f * y2 - 0.5f * y3;
+            float c3 = 0.5f * (y3 - y0) + 1.5f * (y1 - y2);
+            return ((c3 * f + c2) * f + c1) * f + y1;
+        }
+
+        // Block variants: interpolate a whole quantum of phases in one call,
+        // with the table pointer and size hoisted out of the loop. The linear
+        // version matches repeated interp_cyclic() calls exactly.
+        void interp_cyclic_block(const float *pPhases, float *pOut, int sampleCount);
+        void interp_cyclic_cubic_block(const float *pPhases, float *pOut, int sampleCount);
+
+        // point at a shared (non-owned) table / switch back to private storage
+        void adoptSharedTable(const float *pShared);
+        void ensurePrivateTable();
+
         // functions for use by class WaveShaper (see comments in .cpp file)
         void linearCurve(float gain = 1.0f);
         void exponentialCurve(float left, float right);
@@ -69,6 +108,13 @@ namespace AudioKitCore
             float sj = pWaveTable[rj];
             return (float)((1.0 - f) * si + f * sj);
         }
+
+        // Block variant of interp_bounded: clamped index computation, table
+        // gather and lerp for a whole quantum, with the table pointer and
+        // size hoisted out of the loop. Matches repeated interp_bounded()
+        // calls exactly (the boundary returns are what the clamped lerp
+        // produces anyway, so the loop body carries no special cases).
+        void interp_bounded_block(const float *pPhases, float *pOut, int sampleCount);
     };
     
     /// FunctionTableOscillator implements a simple wavetable-based oscillator. Small table sizes (as small
@@ -108,6 +154,23 @@ namespace AudioKitCore
             phase += phaseDelta;
             if (phase >= 1.0f) phase -= 1.0f;
         }
+
+        // For block-rate modulation: returns in-phase/quadrature pairs at the
+        // current phase and at sampleCount steps ahead, then advances the phase
+        // by the whole span. Callers interpolate between the two pairs instead
+        // of hitting the table every sample.
+        inline void getSamplesSpanning(int sampleCount,
+                                       float *pInPhase0, float *pQuadrature0,
+                                       float *pInPhase1, float *pQuadrature1)
+        {
+            *pInPhase0 = waveTable.interp_cyclic(phase);
+            *pQuadrature0 = waveTable.interp_cyclic(phase + 0.25f);
+            float endPhase = phase + sampleCount * phaseDelta;
+            *pInPhase1 = waveTable.interp_cyclic(endPhase);
+            *pQuadrature1 = waveTable.interp_cyclic(endPhase + 0.25f);
+            phase = endPhase;
+            while (phase >= 1.0f) phase -= 1.0f;
+        }
     };
     
     /// WaveShaper wraps a FunctionTable and provides saved scale and offset parameters for both
@@ -117,17 +180,41 @@ namespace AudioKitCore
         FunctionTable waveTable;
         float xScale, xOffset;
         float yScale, yOffset;
-        
-        WaveShaper() : xScale(1.0f), xOffset(0.0f), yScale(1.0f), yOffset(0.0f) {}
+
+        // Composed transfer curve: once the scale/offset parameters have
+        // settled (unchanged across two consecutive interpBlock calls), the
+        // output transform is folded into a private copy of the table, so
+        // the block loop is just the input transform, a clamped gather and
+        // a lerp per sample.
+        FunctionTable composedTable;
+        bool composedValid;
+        float composedXScale, composedXOffset, composedYScale, composedYOffset;
+        bool lastValid;
+        float lastXScale, lastXOffset, lastYScale, lastYOffset;
+
+        WaveShaper() : xScale(1.0f), xOffset(0.0f), yScale(1.0f), yOffset(0.0f),
+                       composedValid(false), lastValid(false) {}
         ~WaveShaper() { deinit(); }
-        void deinit() { waveTable.deinit(); }
-        
+        void deinit() { waveTable.deinit(); composedTable.deinit(); }
+
         void init(int tableLength = DEFAULT_WAVETABLE_SIZE);
-        
+
         inline float interp(float x)
         {
             return yScale * waveTable.interp_bounded((x - xOffset) * xScale) + yOffset;
         }
+
+        // Shape a whole quantum through the transfer curve. While the
+        // parameters are moving, the x/y transforms are applied live against
+        // the shared curve; once they settle, the composed table takes over.
+        void interpBlock(const float *pIn, float *pOut, int sampleCount);
+
+        // Fold yScale/yOffset into the composed table for the current curve.
+        void composeTransferCurve();
+
+        // Call after rewriting waveTable (e.g. loading a new curve shape),
+        // so the next interpBlock re-composes against the new contents.
+        void invalidateComposedCurve() { composedValid = false; lastValid = false; }
     };
 
 }
@@ -0,0 +1,64 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+#pragma once
+
+#include "FunctionTable.hpp"
+
+namespace AudioKitCore
+{
+
+    /// Modulation matrix for a polyphonic synth. The global LFO sources are
+    /// evaluated just once per render chunk, at chunk rate, and their summed
+    /// contributions applied to every voice, so LFO cost does not grow with
+    /// polyphony. Note-indexed modulations (filter key tracking, velocity
+    /// sensitivity) are constant for a note's lifetime and folded in as one
+    /// scalar per voice.
+    struct ModMatrix
+    {
+        static constexpr int lfoCount = 2;
+
+        /// shared LFOs, running at chunk rate
+        FunctionTableOscillator lfo[lfoCount];
+
+        // routing amounts
+
+        /// LFO to oscillator pitch (vibrato), semitones at full LFO swing
+        float lfoPitchSemitones[lfoCount];
+
+        /// LFO to filter cutoff, in units of the cutoff multiple
+        float lfoCutoffAmount[lfoCount];
+
+        /// LFO to voice gain (tremolo), fraction of full gain
+        float lfoAmpFraction[lfoCount];
+
+        /// cutoff-multiple offset per octave of key distance from middle C
+        float keyTrackingAmount;
+
+        /// how far low velocity pulls the cutoff multiple down
+        float velocitySensitivity;
+
+        // chunk-rate outputs, refreshed by evaluate()
+
+        /// raw LFO outputs from the last evaluate(), for callers that apply
+        /// their own depth (e.g. the classic vibrato control)
+        float lastSample[lfoCount];
+
+        /// add to the synth's pitch offset, semitones
+        float pitchOffsetSemitones;
+
+        /// add to the cutoff multiple
+        float cutoffOffset;
+
+        /// multiply into the master volume
+        float ampModFactor;
+
+        void init(double chunkRateHz);
+
+        /// advance the shared LFOs one chunk and refresh the outputs
+        void evaluate();
+
+        /// block-constant cutoff-multiple offset for one voice
+        float voiceCutoffOffset(int noteNumber, float velocity) const;
+    };
+
+}
@@ -28,8 +28,15 @@ namespace AudioKitCore
         void setParameters(double newCutoffHz, double newResLinear);
         void setCutoff(double newCutoffHz);
         void setResonance(double newResLinear);
-        
+
+        /// like setParameters(), but block processing interpolates the
+        /// coefficients linearly over the next rampSamples samples
+        void setParametersRamped(double newCutoffHz, double newResLinear, int rampSamples);
+
         float process(float sample);
+
+        /// process a whole block through the stage cascade; in-place is fine
+        void process(const float *inBuffer, float *outBuffer, int sampleCount);
     };
 
 }
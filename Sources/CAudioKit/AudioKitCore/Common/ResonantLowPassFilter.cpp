@@ -33,51 +33,135 @@ namespace AudioKitCore
     {
         this->sampleRateHz = sampleRateHz;
         x1 = x2 = y1 = y2 = 0.0;
+        da0 = da1 = da2 = db1 = db2 = 0.0;
+        rampSamplesLeft = 0;
         mLastCutoffHz = mLastResLinear = -1.0;  // force recalc of coefficients
     }
     
-    void ResonantLowPassFilter::setParameters(double newCutoffHz, double newResLinear)
+    void ResonantLowPassFilter::computeCoefficients(double cutoffHz, double resLinear,
+                                                    double sampleRateHz, Coefficients &c)
     {
-        // only calculate the filter coefficients if the parameters have changed from last time
-        if (newCutoffHz == mLastCutoffHz && newResLinear == mLastResLinear) return;
-        
-        if (newCutoffHz < kMinCutoffHz) newCutoffHz = kMinCutoffHz;
-        if (newResLinear < kMinResLinear ) newResLinear = kMinResLinear;
-        if (newResLinear > kMaxResLinear ) newResLinear = kMaxResLinear;
-        
+        if (sineTable.pWaveTable == 0)  // build sine table only once
+        {
+            sineTable.init(2048);
+            sineTable.sinusoid();
+        }
+
+        if (cutoffHz < kMinCutoffHz) cutoffHz = kMinCutoffHz;
+        if (resLinear < kMinResLinear) resLinear = kMinResLinear;
+        if (resLinear > kMaxResLinear) resLinear = kMaxResLinear;
+
         // convert cutoff from Hz to 0->1 normalized frequency
-        double cutoff = 2.0 * newCutoffHz / sampleRateHz;
+        double cutoff = 2.0 * cutoffHz / sampleRateHz;
         if (cutoff > 0.99) cutoff = 0.99;   // clip
-        
-        mLastCutoffHz = newCutoffHz;
-        mLastResLinear = newResLinear;
 
-        double k = 0.5 * newResLinear * Sine(float(0.5 * cutoff));
+        double k = 0.5 * resLinear * Sine(float(0.5 * cutoff));
         double c1 = 0.5 * (1.0 - k) / (1.0 + k);
         double c2 = (0.5 + c1) * Cosine(float(0.5 * cutoff));
         double c3 = (0.5 + c1 - c2) * 0.25;
-        
-        a0 = 2.0 * c3;
-        a1 = 2.0 * 2.0 * c3;
-        a2 = 2.0 * c3;
-        b1 = 2.0 * -c2;
-        b2 = 2.0 * c1;
+
+        c.a0 = 2.0 * c3;
+        c.a1 = 2.0 * 2.0 * c3;
+        c.a2 = 2.0 * c3;
+        c.b1 = 2.0 * -c2;
+        c.b2 = 2.0 * c1;
     }
-    
+
+    void ResonantLowPassFilter::setParameters(double newCutoffHz, double newResLinear)
+    {
+        // only calculate the filter coefficients if the parameters have changed from last time
+        if (newCutoffHz == mLastCutoffHz && newResLinear == mLastResLinear) return;
+
+        Coefficients c;
+        computeCoefficients(newCutoffHz, newResLinear, sampleRateHz, c);
+        setCoefficients(c, newCutoffHz, newResLinear);
+    }
+
+    void ResonantLowPassFilter::setCoefficients(const Coefficients &c, double cutoffHz, double resLinear)
+    {
+        if (cutoffHz == mLastCutoffHz && resLinear == mLastResLinear) return;
+
+        mLastCutoffHz = cutoffHz;
+        mLastResLinear = resLinear;
+
+        a0 = c.a0;
+        a1 = c.a1;
+        a2 = c.a2;
+        b1 = c.b1;
+        b2 = c.b2;
+
+        // an immediate update cancels any ramp in progress
+        da0 = da1 = da2 = db1 = db2 = 0.0;
+        rampSamplesLeft = 0;
+    }
+
+    void ResonantLowPassFilter::setParametersRamped(double newCutoffHz, double newResLinear, int rampSamples)
+    {
+        if (rampSamples < 1)
+        {
+            setParameters(newCutoffHz, newResLinear);
+            return;
+        }
+        if (newCutoffHz == mLastCutoffHz && newResLinear == mLastResLinear) return;
+
+        // remember where we are, compute where we're going, then ramp
+        double ca0 = a0, ca1 = a1, ca2 = a2, cb1 = b1, cb2 = b2;
+        setParameters(newCutoffHz, newResLinear);
+        double scale = 1.0 / rampSamples;
+        da0 = (a0 - ca0) * scale;
+        da1 = (a1 - ca1) * scale;
+        da2 = (a2 - ca2) * scale;
+        db1 = (b1 - cb1) * scale;
+        db2 = (b2 - cb2) * scale;
+        a0 = ca0;
+        a1 = ca1;
+        a2 = ca2;
+        b1 = cb1;
+        b2 = cb2;
+        rampSamplesLeft = rampSamples;
+    }
+
     void ResonantLowPassFilter::process(const float *sourceP, float *destP, int inFramesToProcess)
     {
+        // coefficients and state in locals for the whole block
+        double ca0 = a0, ca1 = a1, ca2 = a2, cb1 = b1, cb2 = b2;
+        double cx1 = x1, cx2 = x2, cy1 = y1, cy2 = y2;
+
+        // ramping run first, then the steady run
+        int rampRun = rampSamplesLeft < inFramesToProcess ? rampSamplesLeft : inFramesToProcess;
+        rampSamplesLeft -= rampRun;
+        inFramesToProcess -= rampRun;
+
+        while (rampRun--)
+        {
+            ca0 += da0; ca1 += da1; ca2 += da2; cb1 += db1; cb2 += db2;
+
+            float inputSample = *sourceP++;
+            float outputSample = float(ca0*inputSample + ca1*cx1 + ca2*cx2 - cb1*cy1 - cb2*cy2);
+
+            cx2 = cx1;
+            cx1 = inputSample;
+            cy2 = cy1;
+            cy1 = outputSample;
+
+            *destP++ = outputSample;
+        }
+
         while (inFramesToProcess--)
         {
             float inputSample = *sourceP++;
-            float outputSample = float(a0*inputSample + a1*x1 + a2*x2 - b1*y1 - b2*y2);
+            float outputSample = float(ca0*inputSample + ca1*cx1 + ca2*cx2 - cb1*cy1 - cb2*cy2);
+
+            cx2 = cx1;
+            cx1 = inputSample;
+            cy2 = cy1;
+            cy1 = outputSample;
 
-            x2 = x1;
-            x1 = inputSample;
-            y2 = y1;
-            y1 = outputSample;
-            
             *destP++ = outputSample;
         }
+
+        a0 = ca0; a1 = ca1; a2 = ca2; b1 = cb1; b2 = cb2;
+        x1 = cx1; x2 = cx2; y1 = cy1; y2 = cy2;
     }
 
 }
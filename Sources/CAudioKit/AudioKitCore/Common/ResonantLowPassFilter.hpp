@@ -13,24 +13,51 @@ namespace AudioKitCore
 
     struct ResonantLowPassFilter
     {
+        /// One computed coefficient set, separable from filter state so
+        /// voices and channels with equal parameters can share it
+        struct Coefficients
+        {
+            double a0, a1, a2, b1, b2;
+        };
+
+        /// Computes (with clamping) the coefficient set for the given
+        /// parameters without touching any filter instance
+        static void computeCoefficients(double cutoffHz, double resLinear,
+                                        double sampleRateHz, Coefficients &c);
+
         // coefficients
         double a0, a1, a2, b1, b2;
-        
+
         // state
         double x1, x2, y1, y2;
-        
+
+        // coefficient ramp: per-sample deltas applied during block
+        // processing, so control-rate parameter updates interpolate
+        // linearly instead of stepping
+        double da0, da1, da2, db1, db2;
+        int rampSamplesLeft;
+
         // misc
         double sampleRateHz, mLastCutoffHz, mLastResLinear;
-        
+
         ResonantLowPassFilter();
-        
+
         void init(double sampleRateHz);
         void updateSampleRate(double sampleRate) { sampleRateHz = sampleRate; }
-        
+
         void setParameters(double newCutoffHz, double newResLinear);
+
+        /// Adopts a precomputed (shared) coefficient set; cutoffHz/resLinear
+        /// are the parameters it was computed from, kept for change detection
+        void setCoefficients(const Coefficients &c, double cutoffHz, double resLinear);
+
         void setCutoff(double newCutoffHz) { setParameters(newCutoffHz, mLastResLinear); }
         void setResonance(double newResLinear) { setParameters(mLastCutoffHz, newResLinear); }
-        
+
+        /// like setParameters(), but block processing interpolates the
+        /// coefficients linearly over the next rampSamples samples
+        void setParametersRamped(double newCutoffHz, double newResLinear, int rampSamples);
+
         void process(const float *inSourceP, float *inDestP, int inFramesToProcess);
 
         inline float process(float inputSample)
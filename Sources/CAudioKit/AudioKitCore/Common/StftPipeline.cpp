@@ -0,0 +1,204 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+#include "StftPipeline.hpp"
+#include "DSPVectorOps.h"
+#include "kiss_fftr.h"
+
+#include <cmath>
+#include <cstring>
+#include <mutex>
+
+namespace AudioKitCore
+{
+
+    // Forward/inverse kiss_fftr plans of one size, shared by every pipeline
+    // instance. A stereo effect or a dozen nodes at the same fftSize pay
+    // for one plan pair; entries persist for the process like the filter
+    // and ftable caches.
+    namespace
+    {
+        struct PlanPair
+        {
+            int fftSize = 0;
+            int refs = 0;
+            kiss_fftr_cfg forward = nullptr;
+            kiss_fftr_cfg inverse = nullptr;
+        };
+
+        constexpr int maxPlanPairs = 16;
+        PlanPair planCache[maxPlanPairs];
+        std::mutex planMutex;
+
+        PlanPair *acquirePlans(int fftSize)
+        {
+            std::lock_guard<std::mutex> lock(planMutex);
+            PlanPair *freeEntry = nullptr;
+            for (int i = 0; i < maxPlanPairs; i++)
+            {
+                if (planCache[i].refs > 0 && planCache[i].fftSize == fftSize)
+                {
+                    planCache[i].refs++;
+                    return &planCache[i];
+                }
+                if (planCache[i].refs == 0 && freeEntry == nullptr) freeEntry = &planCache[i];
+            }
+            if (freeEntry == nullptr) return nullptr;
+            if (freeEntry->forward) kiss_fftr_free(freeEntry->forward);
+            if (freeEntry->inverse) kiss_fftr_free(freeEntry->inverse);
+            freeEntry->fftSize = fftSize;
+            freeEntry->forward = kiss_fftr_alloc(fftSize, 0, nullptr, nullptr);
+            freeEntry->inverse = kiss_fftr_alloc(fftSize, 1, nullptr, nullptr);
+            freeEntry->refs = 1;
+            return freeEntry;
+        }
+
+        void releasePlans(PlanPair *pair)
+        {
+            // plans stay cached at zero refs until the slot is recycled
+            std::lock_guard<std::mutex> lock(planMutex);
+            if (pair->refs > 0) pair->refs--;
+        }
+    }
+
+    StftPipeline::StftPipeline()
+    {
+    }
+
+    StftPipeline::~StftPipeline()
+    {
+        deinit();
+    }
+
+    bool StftPipeline::init(int size, int hop)
+    {
+        if (size < 32 || (size & (size - 1)) != 0) return false;
+        if (hop < 1 || hop > size || size % hop != 0) return false;
+        deinit();
+
+        plans = acquirePlans(size);
+        if (plans == nullptr) return false;
+        fftSize = size;
+        hopSize = hop;
+        binCount = size / 2 + 1;
+
+        window.resize(fftSize);
+        for (int n = 0; n < fftSize; n++)
+        {
+            window[n] = 0.5f * (1.0f - cosf(2.0f * (float)M_PI * n / fftSize));
+        }
+
+        // per-hop-position overlap-add compensation, folded together with
+        // kiss_fftr's unnormalized inverse: divides out the window-square
+        // sum, so any hop that divides fftSize reconstructs exactly
+        olaNorm.resize(hopSize);
+        for (int j = 0; j < hopSize; j++)
+        {
+            float sum = 0.0f;
+            for (int n = j; n < fftSize; n += hopSize) sum += window[n] * window[n];
+            olaNorm[j] = sum > 1.0e-9f ? 1.0f / (sum * fftSize) : 0.0f;
+        }
+
+        inFrame.resize(fftSize);
+        windowed.resize(fftSize);
+        real.resize(binCount);
+        imag.resize(binCount);
+        spectrum.resize(2 * binCount);
+        synth.resize(fftSize);
+        outAccum.resize(fftSize);
+        // power-of-two ring; occupancy never exceeds fftSize + hopSize
+        outRing.resize(4 * (size_t)fftSize);
+
+        reset();
+        return true;
+    }
+
+    void StftPipeline::deinit()
+    {
+        if (plans) releasePlans((PlanPair *)plans);
+        plans = nullptr;
+        fftSize = 0;
+    }
+
+    void StftPipeline::reset()
+    {
+        if (fftSize == 0) return;
+        std::fill(inFrame.begin(), inFrame.end(), 0.0f);
+        std::fill(outAccum.begin(), outAccum.end(), 0.0f);
+        std::fill(outRing.begin(), outRing.end(), 0.0f);
+        inPending = 0;
+        outReadIndex = 0;
+        // a frame's first emission lands fftSize - hopSize samples after
+        // the sample it reconstructs; one hop of zero prefill tops the
+        // total delay up to exactly latencySamples()
+        outWriteIndex = (size_t)hopSize;
+    }
+
+    void StftPipeline::setCallback(SpectralCallback cb, void *context)
+    {
+        callback = cb;
+        callbackContext = context;
+    }
+
+    void StftPipeline::process(const float *input, float *output, int frameCount)
+    {
+        if (fftSize == 0)
+        {
+            memmove(output, input, frameCount * sizeof(float));
+            return;
+        }
+        const size_t mask = outRing.size() - 1;
+        float *tail = inFrame.data() + fftSize - hopSize;
+        for (int i = 0; i < frameCount; i++)
+        {
+            tail[inPending++] = input[i];
+            if (inPending == hopSize)
+            {
+                processFrame();
+                memmove(inFrame.data(), inFrame.data() + hopSize,
+                        (fftSize - hopSize) * sizeof(float));
+                inPending = 0;
+            }
+            output[i] = outReadIndex < outWriteIndex ? outRing[outReadIndex & mask] : 0.0f;
+            outReadIndex++;
+        }
+    }
+
+    void StftPipeline::processFrame()
+    {
+        PlanPair *pair = (PlanPair *)plans;
+        kiss_fft_cpx *cpx = (kiss_fft_cpx *)spectrum.data();
+
+        vMultiply(inFrame.data(), window.data(), windowed.data(), fftSize);
+        kiss_fftr(pair->forward, windowed.data(), cpx);
+
+        for (int k = 0; k < binCount; k++)
+        {
+            real[k] = cpx[k].r;
+            imag[k] = cpx[k].i;
+        }
+        if (callback) callback(callbackContext, real.data(), imag.data(), binCount);
+        for (int k = 0; k < binCount; k++)
+        {
+            cpx[k].r = real[k];
+            cpx[k].i = imag[k];
+        }
+
+        kiss_fftri(pair->inverse, cpx, synth.data());
+
+        // synthesis window, then overlap-add
+        vMultiply(synth.data(), window.data(), synth.data(), fftSize);
+        vAdd(synth.data(), outAccum.data(), fftSize);
+
+        // the first hop of the accumulator has every contribution it will
+        // ever get; normalize and emit it, then slide the accumulator
+        const size_t mask = outRing.size() - 1;
+        for (int j = 0; j < hopSize; j++)
+        {
+            outRing[outWriteIndex++ & mask] = outAccum[j] * olaNorm[j];
+        }
+        memmove(outAccum.data(), outAccum.data() + hopSize,
+                (fftSize - hopSize) * sizeof(float));
+        memset(outAccum.data() + fftSize - hopSize, 0, hopSize * sizeof(float));
+    }
+
+}
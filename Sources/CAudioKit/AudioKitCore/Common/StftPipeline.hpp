@@ -0,0 +1,76 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+// StftPipeline is the shared scaffolding every streaming spectral effect
+// needs: an input ring, Hann analysis/synthesis windowing, plan-cached
+// forward/inverse real FFTs, and an overlap-add accumulator. Effect code
+// plugs in as a per-frame callback that edits the spectrum in place, so a
+// new spectral node is the callback plus parameter glue instead of another
+// hand-rolled STFT engine.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace AudioKitCore
+{
+
+    struct StftPipeline
+    {
+        // Called once per analysis frame. real/imag hold binCount =
+        // fftSize/2 + 1 bins (DC .. Nyquist) and may be modified in place;
+        // what's left is resynthesized. Runs on the render thread: no
+        // locks, no allocation.
+        typedef void (*SpectralCallback)(void *context, float *real, float *imag, int binCount);
+
+        StftPipeline();
+        ~StftPipeline();
+
+        // fftSize must be a power of two and hopSize must divide it; the
+        // usual choices are fftSize/4 (best quality) or fftSize/2.
+        // Allocates FFT plans and buffers; call off the render thread.
+        bool init(int fftSize, int hopSize);
+        void deinit();
+
+        // Clears all rings and accumulators without touching the plans.
+        void reset();
+
+        void setCallback(SpectralCallback callback, void *context);
+
+        // Push frameCount input samples and pull frameCount output samples.
+        // The output trails the input by latencySamples(); until then it
+        // is the pipeline's zero prefill.
+        void process(const float *input, float *output, int frameCount);
+
+        int latencySamples() const { return fftSize; }
+        int size() const { return fftSize; }
+        int hop() const { return hopSize; }
+        int bins() const { return binCount; }
+
+    private:
+        void processFrame();
+
+        int fftSize = 0;
+        int hopSize = 0;
+        int binCount = 0;
+        SpectralCallback callback = nullptr;
+        void *callbackContext = nullptr;
+
+        // refcounted (forward, inverse) plan pair from the shared cache
+        void *plans = nullptr;
+
+        std::vector<float> window;        // Hann, fftSize
+        std::vector<float> olaNorm;       // per-hop-position window-square sum, hopSize
+        std::vector<float> inFrame;       // sliding analysis frame, fftSize
+        std::vector<float> windowed;      // windowed copy handed to the FFT
+        std::vector<float> real, imag;    // split spectrum for the callback
+        std::vector<float> spectrum;      // interleaved re/im handed to the FFT
+        std::vector<float> synth;         // inverse FFT result
+        std::vector<float> outAccum;      // overlap-add accumulator, fftSize
+        std::vector<float> outRing;       // finished samples awaiting pull
+        int inPending = 0;
+        size_t outReadIndex = 0;
+        size_t outWriteIndex = 0;
+    };
+
+}
@@ -2,6 +2,7 @@
 
 #pragma once
 #include <math.h>
+#include <vector>
 
 #include "EnsembleOscillator.hpp"
 #include "DrawbarsOscillator.hpp"
@@ -19,6 +20,10 @@ namespace AudioKitCore
         float panSpread;        // fraction 0 = no spread, 1 = max spread
         float pitchOffset;      // semitones, relative to MIDI note
         float mixLevel;         // fraction
+
+        // waveform generation: WaveStack table or algorithmic polyBLEP
+        EnsembleOscillator::WaveformMode waveform;
+        float waveformAmplitude;    // amplitude for the algorithmic modes
     };
 
     struct OrganParameters
@@ -35,6 +40,28 @@ namespace AudioKitCore
         int filterStages;
     };
 
+    struct SynthVoice;
+
+    /// Contiguous per-phase oscillator state for a whole bank of voices
+    /// (struct-of-arrays layout). Each field holds all voices' values back to
+    /// back, voice-major, so the render loop sweeps linearly through memory
+    /// instead of hopping between scattered voice objects. The amp/filter EGs
+    /// advance only once per render chunk, so their state stays in the voice.
+    struct SynthVoiceStateBank
+    {
+        std::vector<int> osc1Octave, osc2Octave, osc3Octave;
+        std::vector<float> osc1Phase, osc1PhaseDelta, osc1LeftGain, osc1RightGain;
+        std::vector<float> osc2Phase, osc2PhaseDelta, osc2LeftGain, osc2RightGain;
+        std::vector<float> osc3Phase, osc3PhaseDelta;
+
+        /// allocate storage for the given number of voices
+        void init(int voiceCount);
+
+        /// point the given voice's oscillators at this bank's storage;
+        /// call after init() and before SynthVoice::init()
+        void attach(SynthVoice &voice, int voiceIndex);
+    };
+
     struct SynthVoice
     {
         SynthVoiceParameters *pParameters;
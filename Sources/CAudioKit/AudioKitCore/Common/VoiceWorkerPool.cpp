@@ -0,0 +1,124 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+#include "VoiceWorkerPool.hpp"
+#include "DSPVectorOps.h"
+#include "../../Internals/Utilities/atomicops.h"
+
+#include <string.h>
+#include <thread>
+#include <vector>
+
+namespace AudioKitCore
+{
+
+    struct VoiceWorkerPool::Worker
+    {
+        std::thread thread;
+        moodycamel::spsc_sema::LightweightSemaphore workReady;
+        moodycamel::spsc_sema::LightweightSemaphore workDone;
+        bool shouldExit = false;
+
+        // job description, written by the audio thread before signaling
+        RenderSliceFunction fn = nullptr;
+        void *context = nullptr;
+        int firstSlot = 0, lastSlot = 0;
+        int frameCount = 0;
+
+        std::vector<float> leftMix, rightMix;
+
+        void run()
+        {
+            for (;;)
+            {
+                workReady.wait();
+                if (shouldExit) break;
+                memset(leftMix.data(), 0, frameCount * sizeof(float));
+                memset(rightMix.data(), 0, frameCount * sizeof(float));
+                fn(context, firstSlot, lastSlot, leftMix.data(), rightMix.data(), frameCount);
+                workDone.signal();
+            }
+        }
+    };
+
+    VoiceWorkerPool::VoiceWorkerPool()
+    : workers(nullptr)
+    , workerCount(0)
+    , maxFrames(0)
+    {
+    }
+
+    VoiceWorkerPool::~VoiceWorkerPool()
+    {
+        deinit();
+    }
+
+    void VoiceWorkerPool::init(int count, int frames)
+    {
+        deinit();
+        if (count <= 0) return;
+        workerCount = count;
+        maxFrames = frames;
+        workers = new Worker[count];
+        for (int i = 0; i < count; i++)
+        {
+            workers[i].leftMix.resize(frames);
+            workers[i].rightMix.resize(frames);
+            workers[i].thread = std::thread(&Worker::run, &workers[i]);
+        }
+    }
+
+    void VoiceWorkerPool::deinit()
+    {
+        if (workers == nullptr) return;
+        for (int i = 0; i < workerCount; i++)
+        {
+            workers[i].shouldExit = true;
+            workers[i].workReady.signal();
+        }
+        for (int i = 0; i < workerCount; i++)
+            workers[i].thread.join();
+        delete[] workers;
+        workers = nullptr;
+        workerCount = 0;
+    }
+
+    void VoiceWorkerPool::renderVoices(int voiceCount, RenderSliceFunction fn, void *context,
+                                       float *leftOutput, float *rightOutput, int frameCount)
+    {
+        if (workerCount == 0 || frameCount > maxFrames)
+        {
+            fn(context, 0, voiceCount, leftOutput, rightOutput, frameCount);
+            return;
+        }
+
+        // one slice per worker plus one for the audio thread itself
+        int sliceCount = workerCount + 1;
+        int perSlice = (voiceCount + sliceCount - 1) / sliceCount;
+
+        int used = 0;
+        int next = 0;
+        for (int i = 0; i < workerCount && next < voiceCount; i++, used++)
+        {
+            Worker& w = workers[i];
+            w.fn = fn;
+            w.context = context;
+            w.firstSlot = next;
+            w.lastSlot = next + perSlice < voiceCount ? next + perSlice : voiceCount;
+            w.frameCount = frameCount;
+            next = w.lastSlot;
+            w.workReady.signal();
+        }
+
+        // render our own slice straight into the output
+        if (next < voiceCount)
+            fn(context, next, voiceCount, leftOutput, rightOutput, frameCount);
+
+        for (int i = 0; i < used; i++)
+        {
+            workers[i].workDone.wait();
+            vAdd(workers[i].leftMix.data(), leftOutput, frameCount);
+            vAdd(workers[i].rightMix.data(), rightOutput, frameCount);
+        }
+    }
+
+}
@@ -0,0 +1,45 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+#pragma once
+
+namespace AudioKitCore
+{
+
+    // A small pool of render worker threads for voice-parallel synthesis.
+    // CoreSampler and CoreSynth can opt in to have their active voices
+    // partitioned across the pool: each worker accumulates its slice into a
+    // private stereo mix buffer, the audio thread renders its own slice
+    // directly into the output, and the private mixes are SIMD-summed at the
+    // end. The handoff uses lightweight semaphores that spin briefly before
+    // sleeping, so no lock is taken on the audio thread.
+    class VoiceWorkerPool
+    {
+    public:
+        // Renders voice slots [firstSlot, lastSlot) into the given stereo mix.
+        typedef void (*RenderSliceFunction)(void *context, int firstSlot, int lastSlot,
+                                            float *leftMix, float *rightMix, int frameCount);
+
+        VoiceWorkerPool();
+        ~VoiceWorkerPool();
+
+        // workerCount is the number of helper threads (0 disables the pool);
+        // maxFrames sizes the per-worker mix buffers
+        void init(int workerCount, int maxFrames);
+        void deinit();
+
+        bool isEnabled() const { return workerCount > 0; }
+
+        // Partition voiceCount slots across the workers and the calling
+        // thread, render them via fn, and sum the workers' mixes into the
+        // output. Blocks until every slice has finished.
+        void renderVoices(int voiceCount, RenderSliceFunction fn, void *context,
+                          float *leftOutput, float *rightOutput, int frameCount);
+
+    private:
+        struct Worker;
+        Worker *workers;
+        int workerCount;
+        int maxFrames;
+    };
+
+}
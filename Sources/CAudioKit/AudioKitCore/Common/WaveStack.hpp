@@ -1,6 +1,7 @@
 // Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
 
 #pragma once
+#include <math.h>
 
 namespace AudioKitCore
 {
@@ -9,8 +10,10 @@ namespace AudioKitCore
     // waveform. Client code supplies the initial waveform, at a resolution of 1024 samples,
     // equivalent to 43.6 Hz at 44.1K samples/sec (about 23.44 cents below F1, midi note 29),
     // and then calls initStack() to create the filtered higher-octave versions.
+    // Alternatively, a stack built earlier (e.g. offline) can be saved with saveToFile() and
+    // restored in one read with loadFromFile() or initStackFromData(), skipping the FFT work.
     // This provides a basis for anti-aliased oscillators; see class WaveStackOscillator.
-    
+
     struct WaveStack
     {
         // Highest-resolution rep uses 2^maxBits samples
@@ -19,16 +22,55 @@ namespace AudioKitCore
         // maxBits also defines the number of octave levels; highest level has just 2 samples
         float *pData[maxBits];
 
+        // total size of the sample block holding all octave levels
+        static constexpr int stackFloatCount = 2 * (1 << maxBits);
+
         WaveStack();
         ~WaveStack();
 
         // Fill pWaveData with 1024 samples, then call this
         void initStack(float *pWaveData, int maxHarmonic=512);
-        
+
+        // Copy a previously-serialized stack (stackFloatCount floats, as written by
+        // saveToFile), e.g. from a memory-mapped resource file
+        void initStackFromData(const float *pStackData);
+
+        // Save/restore a built stack; loadFromFile replaces all FFT work of initStack
+        // with a single read. Both return true on success.
+        bool saveToFile(const char *filePath);
+        bool loadFromFile(const char *filePath);
+
         void init();
         void deinit();
 
         float interp(int octave, float phase);
+
+        // Faster variant of interp for render-thread use: phase must already be
+        // non-negative, and wrap-around is done with power-of-two masking
+        float interpFast(int octave, float phase)
+        {
+            int shift = maxBits - octave;
+            int mask = (1 << shift) - 1;
+            float readIndex = phase * (1 << shift);
+            int ri = int(readIndex);
+            float f = readIndex - ri;
+            float *pWaveTable = pData[octave];
+            float si = pWaveTable[ri & mask];
+            float sj = pWaveTable[(ri + 1) & mask];
+            return si + f * (sj - si);
+        }
+
+        // Lowest octave able to render the given normalized frequency (cycles/sample)
+        // without aliasing; replaces the shift-and-compare loops formerly used at
+        // note-start time. Not clamped to maxBits-1; callers treat overflow as silence.
+        static int octaveForPhaseDelta(float phaseDelta)
+        {
+            if (phaseDelta <= 0.0f) return 0;
+            int exponent;
+            frexpf(phaseDelta, &exponent);
+            int octave = maxBits + exponent;
+            return octave < 0 ? 0 : octave;
+        }
     };
 
 }
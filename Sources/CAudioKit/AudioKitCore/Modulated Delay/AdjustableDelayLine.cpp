@@ -1,6 +1,7 @@
 // Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
 
 #include "AdjustableDelayLine.hpp"
+#include "MemoryTracker.h"
 
 namespace AudioKitCore
 {
@@ -10,12 +11,18 @@ namespace AudioKitCore
     
     void AdjustableDelayLine::init(double sampleRate, double maxDelayMilliseconds)
     {
+        deinit();
         sampleRateHz = sampleRate;
         maxDelayMs = maxDelayMilliseconds;
 
         capacity = int(maxDelayMs * sampleRateHz / 1000.0);
-        if (pBuffer) delete[] pBuffer;
+        // round up to a power of two so indices wrap with a mask
+        int pow2 = 1;
+        while (pow2 < capacity) pow2 <<= 1;
+        capacity = pow2;
+        indexMask = capacity - 1;
         pBuffer = new float[capacity];
+        akMemoryTrack(AKMemoryDelayLines, "AdjustableDelayLine", (int64_t)capacity * sizeof(float));
         clear();
         writeIndex = 0;
         readIndex = (float)(capacity - 1);
@@ -25,7 +32,11 @@ namespace AudioKitCore
     
     void AdjustableDelayLine::deinit()
     {
-        if (pBuffer) delete[] pBuffer;
+        if (pBuffer)
+        {
+            delete[] pBuffer;
+            akMemoryTrack(AKMemoryDelayLines, "AdjustableDelayLine", -(int64_t)capacity * sizeof(float));
+        }
         pBuffer = 0;
     }
     
@@ -53,18 +64,66 @@ namespace AudioKitCore
         
         int ri = int(readIndex);
         float f = readIndex - ri;
-        int rj = ri + 1; if (rj >= capacity) rj -= capacity;
+        int rj = (ri + 1) & indexMask;
         readIndex += 1.0f;
         if (readIndex >= capacity) readIndex -= capacity;
-        
+
         float si = pBuffer[ri];
         float sj = pBuffer[rj];
         float outSample = (1.0f - f) * si + f * sj;
-        
-        pBuffer[writeIndex++] = sample + fbFraction * outSample;
-        if (writeIndex >= capacity) writeIndex = 0;
-        
+
+        pBuffer[writeIndex] = sample + fbFraction * outSample;
+        writeIndex = (writeIndex + 1) & indexMask;
+
         return (output = outSample);
     }
-    
+
+    void AdjustableDelayLine::process(int sampleCount, const float *inBuffer, float *outBuffer)
+    {
+        if (!pBuffer)
+        {
+            for (int i = 0; i < sampleCount; i++) outBuffer[i] = inBuffer[i];
+            return;
+        }
+
+        int ri = int(readIndex);
+        float f = readIndex - ri;   // constant: the tap advances one sample per sample
+        int wi = writeIndex;
+        int i = 0;
+
+        while (i < sampleCount)
+        {
+            // longest run before the read or write index would wrap
+            int run = sampleCount - i;
+            if (run > capacity - 1 - ri) run = capacity - 1 - ri;
+            if (run > capacity - wi) run = capacity - wi;
+
+            if (run <= 0)
+            {
+                // wrap split: one masked sample, then back to straight runs
+                int rj = (ri + 1) & indexMask;
+                float outSample = (1.0f - f) * pBuffer[ri & indexMask] + f * pBuffer[rj];
+                pBuffer[wi & indexMask] = inBuffer[i] + fbFraction * outSample;
+                outBuffer[i] = outSample;
+                ri = rj;
+                wi = (wi + 1) & indexMask;
+                i++;
+                continue;
+            }
+
+            for (int k = 0; k < run; k++)
+            {
+                float outSample = (1.0f - f) * pBuffer[ri] + f * pBuffer[ri + 1];
+                pBuffer[wi] = inBuffer[i] + fbFraction * outSample;
+                outBuffer[i] = outSample;
+                ri++; wi++; i++;
+            }
+            wi &= indexMask;
+        }
+
+        readIndex = (float)ri + f;
+        writeIndex = wi;
+        output = sampleCount > 0 ? outBuffer[sampleCount - 1] : output;
+    }
+
 }
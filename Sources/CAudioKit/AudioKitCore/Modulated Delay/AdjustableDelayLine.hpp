@@ -9,27 +9,58 @@ namespace AudioKitCore
         double maxDelayMs;
         float fbFraction;
         float *pBuffer;
-        int capacity;
+        int capacity;       // rounded up to a power of two
+        int indexMask;      // capacity - 1, for branch-free index wrap
         int writeIndex;
         float readIndex;
         float output;
-        
+
     public:
         AdjustableDelayLine();
         ~AdjustableDelayLine() { deinit(); }
-        
+
         void init(double sampleRate, double maxDelayMilliseconds);
         void deinit();
-        
+
         void clear();
 
         double getMaxDelayMs() { return maxDelayMs; }
 
         void setDelayMs(double delayMs);
+
+        /// Set the tap as a read/write gap in samples. The caller clamps;
+        /// this skips setDelayMs's unit conversion and wrap loops, so it is
+        /// cheap enough for per-sample modulation.
+        inline void setDelaySamples(float gapSamples)
+        {
+            readIndex = (float)writeIndex - gapSamples;
+            if (readIndex < 0.0f) readIndex += capacity;
+        }
+
+        double getSampleRateHz() { return sampleRateHz; }
+
+        /// Interpolated read at a gap behind the write head, without moving
+        /// the main tap. Lets auxiliary taps share this buffer instead of
+        /// running their own delay lines.
+        inline float readTap(float gapSamples)
+        {
+            float pos = (float)writeIndex - gapSamples;
+            if (pos < 0.0f) pos += capacity;
+            int ri = int(pos);
+            float f = pos - ri;
+            int rj = (ri + 1) & indexMask;
+            return (1.0f - f) * pBuffer[ri & indexMask] + f * pBuffer[rj];
+        }
+
         void setFeedback(float feedback) { fbFraction = feedback; }
- 
+
         float push(float sample);
 
+        /// Push a whole render quantum at a fixed tap; equivalent to
+        /// calling push() per sample but the inner loop runs wrap-free
+        /// between buffer splits.
+        void process(int sampleCount, const float *inBuffer, float *outBuffer);
+
         float getOutput() { return output; }
     };
     
@@ -70,6 +70,13 @@ void ModulatedDelay::setRightFeedback(float feedback)
     data->rightDelayLine.setFeedback(feedback);
 }
 
+static inline float clampDelayMs(float delayMs, float maxDelayMs)
+{
+    if (delayMs < 0.0f) return 0.0f;
+    if (delayMs > maxDelayMs) return maxDelayMs;
+    return delayMs;
+}
+
 void ModulatedDelay::Render(unsigned channelCount, unsigned sampleCount,
                               float *inBuffers[], float *outBuffers[])
 {
@@ -77,35 +84,66 @@ void ModulatedDelay::Render(unsigned channelCount, unsigned sampleCount,
     float *pInRight  = inBuffers[1];
     float *pOutLeft  = outBuffers[0];
     float *pOutRight = outBuffers[1];
-    
-    for (int i=0; i < (int)sampleCount; i++)
+
+    // LFO control interval: the table is sampled once per chunk and the
+    // delay taps ramp linearly in between, so the per-sample work is just
+    // two tap updates and two pushes advancing side by side.
+    const int kModQuantum = 16;
+    const float samplesPerMs = float(data->modOscillator.sampleRateHz / 1000.0);
+    const float dryFraction = 1.0f - dryWetMix;
+
+    unsigned i = 0;
+    while (i < sampleCount)
     {
-        float modLeft, modRight;
-        data->modOscillator.getSamples(&modLeft, &modRight);
-        
-        float leftDelayMs = midDelayMs + delayRangeMs * modDepthFraction * modLeft;
-        float rightDelayMs = midDelayMs + delayRangeMs * modDepthFraction * modRight;
+        int chunk = (int)(sampleCount - i);
+        if (chunk > kModQuantum) chunk = kModQuantum;
+
+        float modLeft0, modRight0, modLeft1, modRight1;
+        data->modOscillator.getSamplesSpanning(chunk, &modLeft0, &modRight0,
+                                               &modLeft1, &modRight1);
+
+        float leftMs0 = midDelayMs + delayRangeMs * modDepthFraction * modLeft0;
+        float leftMs1 = midDelayMs + delayRangeMs * modDepthFraction * modLeft1;
+        float rightMs0 = midDelayMs + delayRangeMs * modDepthFraction * modRight0;
+        float rightMs1 = midDelayMs + delayRangeMs * modDepthFraction * modRight1;
         switch (effectType) {
             case kFlanger:
-                leftDelayMs = minDelayMs + delayRangeMs * modDepthFraction * (1.0f + modLeft);
-                rightDelayMs = minDelayMs + delayRangeMs * modDepthFraction * (1.0f + modRight);
+                leftMs0 = minDelayMs + delayRangeMs * modDepthFraction * (1.0f + modLeft0);
+                leftMs1 = minDelayMs + delayRangeMs * modDepthFraction * (1.0f + modLeft1);
+                rightMs0 = minDelayMs + delayRangeMs * modDepthFraction * (1.0f + modRight0);
+                rightMs1 = minDelayMs + delayRangeMs * modDepthFraction * (1.0f + modRight1);
                 break;
-                
+
             case kChorus:
             default:
                 break;
         }
-        data->leftDelayLine.setDelayMs(leftDelayMs);
-        data->rightDelayLine.setDelayMs(rightDelayMs);
-        
-        float dryFraction = 1.0f - dryWetMix;
-        *pOutLeft++ = dryFraction * (*pInLeft) + dryWetMix * data->leftDelayLine.push(*pInLeft);
-        pInLeft++;
-        if (channelCount > 1)
+
+        // clamp the endpoints; the linear ramp stays within range
+        leftMs0 = clampDelayMs(leftMs0, maxDelayMs);
+        leftMs1 = clampDelayMs(leftMs1, maxDelayMs);
+        rightMs0 = clampDelayMs(rightMs0, maxDelayMs);
+        rightMs1 = clampDelayMs(rightMs1, maxDelayMs);
+
+        float leftGap = leftMs0 * samplesPerMs;
+        float rightGap = rightMs0 * samplesPerMs;
+        float leftGapStep = (leftMs1 - leftMs0) * samplesPerMs / chunk;
+        float rightGapStep = (rightMs1 - rightMs0) * samplesPerMs / chunk;
+
+        for (int k = 0; k < chunk; k++)
         {
-            *pOutRight++ = dryFraction * (*pInRight) + dryWetMix * data->rightDelayLine.push(*pInRight);
-            pInRight++;
+            data->leftDelayLine.setDelaySamples(leftGap);
+            float inLeft = *pInLeft++;
+            *pOutLeft++ = dryFraction * inLeft + dryWetMix * data->leftDelayLine.push(inLeft);
+            leftGap += leftGapStep;
+            if (channelCount > 1)
+            {
+                data->rightDelayLine.setDelaySamples(rightGap);
+                float inRight = *pInRight++;
+                *pOutRight++ = dryFraction * inRight + dryWetMix * data->rightDelayLine.push(inRight);
+                rightGap += rightGapStep;
+            }
         }
+        i += chunk;
     }
-    
 }
@@ -6,6 +6,7 @@ namespace AudioKitCore
 {
     void StereoDelay::init(double sampleRate, double maxDelayMs)
     {
+        sampleRateHz = sampleRate;
         delayLine1.init(sampleRate, maxDelayMs);
         delayLine2.init(sampleRate, maxDelayMs);
     }
@@ -46,9 +47,53 @@ namespace AudioKitCore
         dryWetMixFraction = fraction;
     }
 
+    void StereoDelay::setTapCount(int count)
+    {
+        if (count < 0) count = 0;
+        if (count > kMaxTaps) count = kMaxTaps;
+        tapCount = count;
+    }
+
+    void StereoDelay::setTap(int index, double delayMs, float gain, float pan)
+    {
+        if (index < 0 || index >= kMaxTaps) return;
+        if (delayMs < 0.0) delayMs = 0.0;
+        if (delayMs > delayLine1.getMaxDelayMs()) delayMs = delayLine1.getMaxDelayMs();
+        if (pan < -1.0f) pan = -1.0f;
+        if (pan > 1.0f) pan = 1.0f;
+
+        tapGapSamples[index] = float(delayMs * sampleRateHz / 1000.0);
+        tapGainLeft[index] = gain * 0.5f * (1.0f - pan);
+        tapGainRight[index] = gain * 0.5f * (1.0f + pan);
+    }
+
     void StereoDelay::render(int sampleCount, const float *inBuffers[], float *outBuffers[])
     {
-        if (pingPongMode)
+        if (tapCount > 0)
+        {
+            // multi-tap: one write per channel per sample, then every tap
+            // reads the same two buffers — one node where a chain of
+            // single-tap delays would each keep its own copy of the input
+            for (int i = 0; i < sampleCount; i++)
+            {
+                // push keeps the primary tap running, so feedback still
+                // regenerates at the main delay time
+                delayLine1.push(inBuffers[0][i]);
+                delayLine2.push(inBuffers[1][i]);
+
+                float wetLeft = 0.0f;
+                float wetRight = 0.0f;
+                for (int t = 0; t < tapCount; t++)
+                {
+                    wetLeft += tapGainLeft[t] * delayLine1.readTap(tapGapSamples[t]);
+                    wetRight += tapGainRight[t] * delayLine2.readTap(tapGapSamples[t]);
+                }
+
+                outBuffers[0][i] = (1.0f - dryWetMixFraction) * wetLeft + dryWetMixFraction * inBuffers[0][i];
+                outBuffers[1][i] = (1.0f - dryWetMixFraction) * wetRight + dryWetMixFraction * inBuffers[1][i];
+            }
+        }
+        else if (pingPongMode)
         {
             for (int i = 0; i < sampleCount; i++)
             {
@@ -62,13 +107,21 @@ namespace AudioKitCore
         }
         else
         {
-            for (int i = 0; i < sampleCount; i++)
+            // fixed taps: run the delay lines a chunk at a time and mix
+            // afterward, keeping the delay-line inner loops wrap-free
+            const int chunkSize = 64;
+            float wet[2][chunkSize];
+            for (int i = 0; i < sampleCount; i += chunkSize)
             {
-                float leftSample = delayLine1.push(inBuffers[0][i]);
-                float rightSample = delayLine2.push(inBuffers[1][i]);
-
-                outBuffers[0][i] = (1.0f - dryWetMixFraction) * leftSample + dryWetMixFraction * inBuffers[0][i];
-                outBuffers[1][i] = (1.0f - dryWetMixFraction) * rightSample + dryWetMixFraction * inBuffers[1][i];
+                int chunk = sampleCount - i;
+                if (chunk > chunkSize) chunk = chunkSize;
+                delayLine1.process(chunk, &inBuffers[0][i], wet[0]);
+                delayLine2.process(chunk, &inBuffers[1][i], wet[1]);
+                for (int k = 0; k < chunk; k++)
+                {
+                    outBuffers[0][i + k] = (1.0f - dryWetMixFraction) * wet[0][k] + dryWetMixFraction * inBuffers[0][i + k];
+                    outBuffers[1][i + k] = (1.0f - dryWetMixFraction) * wet[1][k] + dryWetMixFraction * inBuffers[1][i + k];
+                }
             }
         }
     }
@@ -6,29 +6,51 @@
 namespace AudioKitCore
 {
     class StereoDelay {
+    public:
+        enum { kMaxTaps = 8 };
+
+    private:
         double sampleRateHz;
         float feedbackFraction;
         float dryWetMixFraction;
         bool pingPongMode;
 
+        // multi-tap mode: auxiliary taps share the two delay buffers
+        int tapCount;
+        float tapGapSamples[kMaxTaps];
+        float tapGainLeft[kMaxTaps];
+        float tapGainRight[kMaxTaps];
+
         AdjustableDelayLine delayLine1, delayLine2;
-        
+
     public:
-        StereoDelay() : feedbackFraction(0.0f), dryWetMixFraction(0.5f), pingPongMode(false) {}
+        StereoDelay() : feedbackFraction(0.0f), dryWetMixFraction(0.5f), pingPongMode(false), tapCount(0) {}
         ~StereoDelay() { deinit(); }
-        
+
         void init(double sampleRate, double maxDelayMs);
         void deinit();
-        
+
         void clear();
-        
+
         void setPingPongMode(bool pingPong);
         void setDelayMs(double delayMs);
         void setFeedback(float fraction);
         void setDryWetMix(float fraction);
-        
+
         bool getPingPongMode() { return pingPongMode; }
 
+        /// Multi-tap mode: with count > 0 the wet signal is the sum of the
+        /// taps instead of the primary tap, all read from the same pair of
+        /// delay buffers in one pass. 0 restores single-tap behavior.
+        void setTapCount(int count);
+
+        /// Configure one tap. pan runs -1 (left) to +1 (right); gain scales
+        /// the tap before panning. Delay times longer than the line's
+        /// maximum are clamped.
+        void setTap(int index, double delayMs, float gain, float pan);
+
+        int getTapCount() { return tapCount; }
+
         void render(int sampleCount, const float *inBuffers[], float *outBuffers[]);
     };
     
@@ -2,11 +2,17 @@
 
 #include "CoreSampler.h"
 #include "SamplerVoice.hpp"
+#include "StreamedSampleBuffer.hpp"
 #include "FunctionTable.hpp"
 #include "SustainPedalLogic.hpp"
+#include "VoiceWorkerPool.hpp"
+#include "Reaper.h"
 
 #include <math.h>
+#include <atomic>
 #include <list>
+#include <stdint.h>
+#include <vector>
 
 // number of voices
 #define MAX_POLYPHONY 64
@@ -17,12 +23,32 @@
 // Convert MIDI note to Hz, for 12-tone equal temperament
 #define NOTE_HZ(midiNoteNumber) ( 440.0f * pow(2.0f, ((midiNoteNumber) - 69.0f)/12.0f) )
 
+// largest render quantum the voice-parallel path supports
+#define CORESAMPLER_MAX_RENDER_FRAMES 4096
+
+// below this many active voices, fan-out overhead beats the gain
+#define CORESAMPLER_PARALLEL_THRESHOLD 8
+
 struct CoreSampler::InternalData {
     // list of (pointers to) all loaded samples
     std::list<AudioKitCore::KeyMappedSampleBuffer*> sampleBufferList;
     
     // maps MIDI note numbers to "closest" samples (all velocity layers)
     std::list<AudioKitCore::KeyMappedSampleBuffer*> keyMap[MIDI_NOTENUMBERS];
+
+    // Flat note x velocity lookup grid, rebuilt whenever keyMap[] is.
+    // Each cell references a run of gridEntries holding every buffer that
+    // matches that (note, velocity) pair, so note-on resolution is one
+    // indexed load instead of a list traversal; cells with several buffers
+    // (round-robin layers) cycle through them per trigger.
+    struct GridCell
+    {
+        uint32_t first;             // index into gridEntries
+        uint16_t count;             // number of matching buffers (0 = none)
+        uint16_t nextRoundRobin;    // rotates per trigger when count > 1
+    };
+    GridCell lookupGrid[MIDI_NOTENUMBERS][128] = {};
+    std::vector<AudioKitCore::KeyMappedSampleBuffer*> gridEntries;
     
     AudioKitCore::AHDSHREnvelopeParameters ampEnvelopeParameters;
     AudioKitCore::ADSREnvelopeParameters filterEnvelopeParameters;
@@ -35,9 +61,111 @@ struct CoreSampler::InternalData {
     AudioKitCore::FunctionTableOscillator vibratoLFO;
     
     AudioKitCore::SustainPedalLogic pedalLogic;
-    
+
     // tuning table
     float tuningTable[128];
+
+    // opt-in multicore voice rendering
+    AudioKitCore::VoiceWorkerPool workerPool;
+
+    // per-quantum filter coefficient sharing across voices
+    AudioKitCore::FilterCoefficientCache filterCoefficientCache;
+
+    // Voice allocator: a stack of free voice indices plus a compact list of
+    // active voice indices, so note-on is O(1) and render only touches
+    // voices that are actually sounding. All list mutation happens on the
+    // audio render thread; activeVoiceCount is atomic only so
+    // stopAllVoices() can poll it from another thread without tearing.
+    int freeVoiceIndex[MAX_POLYPHONY];
+    int activeVoiceIndex[MAX_POLYPHONY];
+    int activeSlotOfVoice[MAX_POLYPHONY];
+    int voiceOfNote[MIDI_NOTENUMBERS];
+    int freeVoiceCount;
+    std::atomic<int> activeVoiceCount{0};
+
+    void resetVoicePool()
+    {
+        for (int i=0; i < MAX_POLYPHONY; i++)
+        {
+            // voice 0 ends up on top of the stack, matching the old first-free scan order
+            freeVoiceIndex[i] = MAX_POLYPHONY - 1 - i;
+            activeSlotOfVoice[i] = -1;
+        }
+        freeVoiceCount = MAX_POLYPHONY;
+        activeVoiceCount.store(0, std::memory_order_relaxed);
+        for (int nn=0; nn < MIDI_NOTENUMBERS; nn++)
+            voiceOfNote[nn] = -1;
+    }
+
+    void pushActive(int vi, unsigned noteNumber)
+    {
+        int slot = activeVoiceCount.load(std::memory_order_relaxed);
+        activeVoiceIndex[slot] = vi;
+        activeSlotOfVoice[vi] = slot;
+        activeVoiceCount.store(slot + 1, std::memory_order_release);
+        voiceOfNote[noteNumber] = vi;
+    }
+
+    // O(1) pop of the next free voice; returns null when fully polyphonic
+    AudioKitCore::SamplerVoice *takeVoice(unsigned noteNumber)
+    {
+        if (freeVoiceCount == 0) return nullptr;
+        int vi = freeVoiceIndex[--freeVoiceCount];
+        pushActive(vi, noteNumber);
+        return &voice[vi];
+    }
+
+    // claim a particular voice (used by mono mode, which always plays voice 0)
+    AudioKitCore::SamplerVoice *takeSpecificVoice(int vi, unsigned noteNumber)
+    {
+        if (activeSlotOfVoice[vi] >= 0)
+        {
+            voiceOfNote[noteNumber] = vi;
+            return &voice[vi];
+        }
+        for (int i=0; i < freeVoiceCount; i++)
+        {
+            if (freeVoiceIndex[i] == vi)
+            {
+                freeVoiceIndex[i] = freeVoiceIndex[--freeVoiceCount];
+                break;
+            }
+        }
+        pushActive(vi, noteNumber);
+        return &voice[vi];
+    }
+
+    // swap-remove from the active list and push back onto the free stack
+    // (pass noteNumber < 0 to skip the note-map cleanup)
+    void freeVoice(int vi, int noteNumber)
+    {
+        int slot = activeSlotOfVoice[vi];
+        if (slot < 0) return;
+        int last = activeVoiceCount.load(std::memory_order_relaxed) - 1;
+        int movedVoice = activeVoiceIndex[last];
+        activeVoiceIndex[slot] = movedVoice;
+        activeSlotOfVoice[movedVoice] = slot;
+        activeVoiceCount.store(last, std::memory_order_release);
+        activeSlotOfVoice[vi] = -1;
+        freeVoiceIndex[freeVoiceCount++] = vi;
+        if (noteNumber >= 0 && voiceOfNote[noteNumber] == vi) voiceOfNote[noteNumber] = -1;
+    }
+
+    // true if any sounding voice is reading from the given buffer
+    bool bufferInUse(const AudioKitCore::SampleBuffer *pBuf)
+    {
+        int count = activeVoiceCount.load(std::memory_order_relaxed);
+        for (int i=0; i < count; i++)
+            if (voice[activeVoiceIndex[i]].sampleBuffer == pBuf) return true;
+        return false;
+    }
+
+    // keep the note -> voice map in sync when a sounding voice changes note
+    void remapVoiceNote(int vi, int oldNote, int newNote)
+    {
+        if (oldNote >= 0 && voiceOfNote[oldNote] == vi) voiceOfNote[oldNote] = -1;
+        if (newNote >= 0) voiceOfNote[newNote] = vi;
+    }
 };
 
 CoreSampler::CoreSampler()
@@ -62,6 +190,7 @@ CoreSampler::CoreSampler()
 , linearResonance(0.5f)
 , pitchADSRSemitones(0.0f)
 , loopThruRelease(false)
+, voiceSilenceThreshold(0.0f)
 , stoppingAllVoices(false)
 , data(new InternalData)
 {
@@ -77,6 +206,8 @@ CoreSampler::CoreSampler()
     
     for (int i=0; i < 128; i++)
         data->tuningTable[i] = NOTE_HZ(i);
+
+    data->resetVoicePool();
 }
 
 CoreSampler::~CoreSampler()
@@ -95,6 +226,7 @@ int CoreSampler::init(double sampleRate)
     
     for (int i=0; i<MAX_POLYPHONY; i++)
         data->voice[i].init(sampleRate);
+    data->resetVoicePool();
     return 0;   // no error
 }
 
@@ -105,11 +237,122 @@ void CoreSampler::deinit()
 void CoreSampler::unloadAllSamples()
 {
     isKeyMapValid = false;
+    // a big library is hundreds of megabytes across these buffers;
+    // hand each one to the reaper instead of freeing on this thread
     for (AudioKitCore::KeyMappedSampleBuffer *pBuf : data->sampleBufferList)
-        delete pBuf;
+        akReaperEnqueue([](void *p) { delete static_cast<AudioKitCore::KeyMappedSampleBuffer *>(p); }, pBuf);
     data->sampleBufferList.clear();
     for (int i=0; i < MIDI_NOTENUMBERS; i++)
         data->keyMap[i].clear();
+    rebuildLookupGrid();
+}
+
+void CoreSampler::prewarmSampleData(bool lockInMemory)
+{
+    for (AudioKitCore::KeyMappedSampleBuffer *pBuf : data->sampleBufferList)
+        pBuf->prewarm(lockInMemory);
+}
+
+// apply mapping and loop metadata shared by the copying and zero-copy loaders
+static void applySampleDescriptor(AudioKitCore::KeyMappedSampleBuffer *pBuf,
+                                  SampleDescriptor& sd, int sampleCount)
+{
+    pBuf->noteNumber = sd.noteNumber;
+    pBuf->noteFrequency = sd.noteFrequency;
+
+    // Handle rare case where loopEndPoint is 0 (due to being uninitialized)
+    if (sd.loopEndPoint == 0.0f)
+        sd.loopEndPoint = float(sampleCount - 1);
+
+    if (sd.startPoint > 0.0f) pBuf->startPoint = sd.startPoint;
+    if (sd.endPoint > 0.0f)   pBuf->endPoint = sd.endPoint;
+
+    pBuf->isLooping = sd.isLooping;
+    if (pBuf->isLooping)
+    {
+        // loopStartPoint, loopEndPoint are usually sample indices, but values 0.0-1.0
+        // are interpreted as fractions of the total sample length.
+        if (sd.loopStartPoint > 1.0f) pBuf->loopStartPoint = sd.loopStartPoint;
+        else pBuf->loopStartPoint = pBuf->endPoint * sd.loopStartPoint;
+        if (sd.loopEndPoint > 1.0f) pBuf->loopEndPoint = sd.loopEndPoint;
+        else pBuf->loopEndPoint = pBuf->endPoint * sd.loopEndPoint;
+
+        // Clamp loop endpoints to valid range
+        if (pBuf->loopStartPoint < pBuf->startPoint) pBuf->loopStartPoint = pBuf->startPoint;
+        if (pBuf->loopEndPoint > pBuf->endPoint) pBuf->loopEndPoint = pBuf->endPoint;
+    }
+}
+
+// Offline polyphase sample-rate conversion, applied once at load time so
+// that samples recorded at another rate play back at unit increment in the
+// session (see the unity fast path in SamplerVoice::getSamples).
+#define RESAMPLE_TAPS 32
+#define RESAMPLE_PHASES 512
+
+// Build a windowed-sinc filter bank: one row of RESAMPLE_TAPS coefficients
+// per fractional phase (plus one wrap row for interpolation between rows).
+// For downsampling the cutoff is scaled below the output Nyquist to reject
+// aliasing; each row is normalized to unity DC gain.
+static float *buildResampleFilter(double ratio)
+{
+    float *table = new float[(RESAMPLE_PHASES + 1) * RESAMPLE_TAPS];
+    double cutoff = 0.45 * (ratio < 1.0 ? ratio : 1.0);
+    int half = RESAMPLE_TAPS / 2;
+    for (int p = 0; p <= RESAMPLE_PHASES; p++)
+    {
+        float *row = table + p * RESAMPLE_TAPS;
+        double frac = double(p) / RESAMPLE_PHASES;
+        double sum = 0.0;
+        for (int t = 0; t < RESAMPLE_TAPS; t++)
+        {
+            double x = t - (half - 1) - frac;
+            double sinc = (x == 0.0) ? 2.0 * cutoff
+                                     : sin(2.0 * M_PI * cutoff * x) / (M_PI * x);
+            double window = (fabs(x) >= half) ? 0.0
+                                              : 0.5 + 0.5 * cos(M_PI * x / half);
+            row[t] = float(sinc * window);
+            sum += row[t];
+        }
+        for (int t = 0; t < RESAMPLE_TAPS; t++) row[t] = float(row[t] / sum);
+    }
+    return table;
+}
+
+// Convert one channel; in is read at stride inStride (handles interleaved
+// source data directly). The tap loop is branch-free away from the edges.
+static void resampleChannel(const float *in, int inCount, int inStride,
+                            float *out, int outCount, double ratio, const float *table)
+{
+    double step = 1.0 / ratio;
+    for (int j = 0; j < outCount; j++)
+    {
+        double pos = j * step;
+        int i0 = int(pos);
+        double ph = (pos - i0) * RESAMPLE_PHASES;
+        int p0 = int(ph);
+        float pf = float(ph - p0);
+        const float *row0 = table + p0 * RESAMPLE_TAPS;
+        const float *row1 = row0 + RESAMPLE_TAPS;
+        int base = i0 - (RESAMPLE_TAPS / 2 - 1);
+        float acc = 0.0f;
+        if (base >= 0 && base + RESAMPLE_TAPS <= inCount)
+        {
+            const float *src = in + base * inStride;
+            for (int t = 0; t < RESAMPLE_TAPS; t++, src += inStride)
+                acc += ((1.0f - pf) * row0[t] + pf * row1[t]) * *src;
+        }
+        else
+        {
+            for (int t = 0; t < RESAMPLE_TAPS; t++)
+            {
+                int idx = base + t;
+                if (idx < 0) idx = 0;
+                if (idx > inCount - 1) idx = inCount - 1;
+                acc += ((1.0f - pf) * row0[t] + pf * row1[t]) * in[idx * inStride];
+            }
+        }
+        out[j] = acc;
+    }
 }
 
 void CoreSampler::loadSampleData(SampleDataDescriptor& sdd)
@@ -120,7 +363,41 @@ void CoreSampler::loadSampleData(SampleDataDescriptor& sdd)
     pBuf->minimumVelocity = sdd.sampleDescriptor.minimumVelocity;
     pBuf->maximumVelocity = sdd.sampleDescriptor.maximumVelocity;
     data->sampleBufferList.push_back(pBuf);
-    
+
+    // Normalize to the session rate at load time, so playback at the
+    // sample's own pitch advances exactly one frame per output frame.
+    bool convert = currentSampleRate > 0.0f && sdd.sampleRate > 0.0f &&
+                   sdd.sampleRate != currentSampleRate;
+    if (convert)
+    {
+        double ratio = double(currentSampleRate) / sdd.sampleRate;
+        int outCount = int(sdd.sampleCount * ratio + 0.5);
+        pBuf->init(currentSampleRate, sdd.channelCount, outCount);
+        float *table = buildResampleFilter(ratio);
+        float *converted = new float[outCount];
+        for (int channel = 0; channel < sdd.channelCount; channel++)
+        {
+            const float *in = sdd.isInterleaved ? sdd.data + channel
+                                                : sdd.data + channel * sdd.sampleCount;
+            int inStride = sdd.isInterleaved ? sdd.channelCount : 1;
+            resampleChannel(in, sdd.sampleCount, inStride, converted, outCount, ratio, table);
+            for (int i = 0; i < outCount; i++)
+                pBuf->setData(channel * outCount + i, converted[i]);
+        }
+        delete[] converted;
+        delete[] table;
+
+        // mapping metadata is expressed in source frames; rescale anything
+        // frame-valued (loop fractions in 0..1 stay as they are)
+        SampleDescriptor sd = sdd.sampleDescriptor;
+        if (sd.startPoint > 0.0f) sd.startPoint *= float(ratio);
+        if (sd.endPoint > 0.0f) sd.endPoint *= float(ratio);
+        if (sd.loopStartPoint > 1.0f) sd.loopStartPoint *= float(ratio);
+        if (sd.loopEndPoint > 1.0f) sd.loopEndPoint *= float(ratio);
+        applySampleDescriptor(pBuf, sd, outCount);
+        return;
+    }
+
     pBuf->init(sdd.sampleRate, sdd.channelCount, sdd.sampleCount);
     float *pData = sdd.data;
     if (sdd.isInterleaved) for (int i=0; i < sdd.sampleCount; i++)
@@ -132,50 +409,96 @@ void CoreSampler::loadSampleData(SampleDataDescriptor& sdd)
     {
         pBuf->setData(i, *pData++);
     }
-    pBuf->noteNumber = sdd.sampleDescriptor.noteNumber;
-    pBuf->noteFrequency = sdd.sampleDescriptor.noteFrequency;
-    
-    // Handle rare case where loopEndPoint is 0 (due to being uninitialized)
-    if (sdd.sampleDescriptor.loopEndPoint == 0.0f)
-        sdd.sampleDescriptor.loopEndPoint = float(sdd.sampleCount - 1);
 
-    if (sdd.sampleDescriptor.startPoint > 0.0f) pBuf->startPoint = sdd.sampleDescriptor.startPoint;
-    if (sdd.sampleDescriptor.endPoint > 0.0f)   pBuf->endPoint = sdd.sampleDescriptor.endPoint;
-    
-    pBuf->isLooping = sdd.sampleDescriptor.isLooping;
-    if (pBuf->isLooping)
-    {
-        // loopStartPoint, loopEndPoint are usually sample indices, but values 0.0-1.0
-        // are interpreted as fractions of the total sample length.
-        if (sdd.sampleDescriptor.loopStartPoint > 1.0f) pBuf->loopStartPoint = sdd.sampleDescriptor.loopStartPoint;
-        else pBuf->loopStartPoint = pBuf->endPoint * sdd.sampleDescriptor.loopStartPoint;
-        if (sdd.sampleDescriptor.loopEndPoint > 1.0f) pBuf->loopEndPoint = sdd.sampleDescriptor.loopEndPoint;
-        else pBuf->loopEndPoint = pBuf->endPoint * sdd.sampleDescriptor.loopEndPoint;
+    applySampleDescriptor(pBuf, sdd.sampleDescriptor, sdd.sampleCount);
+}
 
-        // Clamp loop endpoints to valid range
-        if (pBuf->loopStartPoint < pBuf->startPoint) pBuf->loopStartPoint = pBuf->startPoint;
-        if (pBuf->loopEndPoint > pBuf->endPoint) pBuf->loopEndPoint = pBuf->endPoint;
+void CoreSampler::loadSampleDataReference(SampleDataReferenceDescriptor& sdrd)
+{
+    // Zero-copy load: the buffer references the caller's (typically mmap'd)
+    // non-interleaved float data, so load cost is O(metadata) and the OS
+    // pages samples in on demand.
+    AudioKitCore::KeyMappedSampleBuffer *pBuf = new AudioKitCore::KeyMappedSampleBuffer();
+    pBuf->minimumNoteNumber = sdrd.sampleDescriptor.minimumNoteNumber;
+    pBuf->maximumNoteNumber = sdrd.sampleDescriptor.maximumNoteNumber;
+    pBuf->minimumVelocity = sdrd.sampleDescriptor.minimumVelocity;
+    pBuf->maximumVelocity = sdrd.sampleDescriptor.maximumVelocity;
+    data->sampleBufferList.push_back(pBuf);
+
+    pBuf->initForReferencedData(sdrd.sampleRate, sdrd.channelCount, sdrd.sampleCount, sdrd.data);
+
+    applySampleDescriptor(pBuf, sdrd.sampleDescriptor, sdrd.sampleCount);
+}
+
+void CoreSampler::loadStreamedSampleFile(StreamedSampleFileDescriptor& ssfd)
+{
+    AudioKitCore::StreamedSampleBuffer *pBuf = new AudioKitCore::StreamedSampleBuffer();
+    pBuf->minimumNoteNumber = ssfd.sampleDescriptor.minimumNoteNumber;
+    pBuf->maximumNoteNumber = ssfd.sampleDescriptor.maximumNoteNumber;
+    pBuf->minimumVelocity = ssfd.sampleDescriptor.minimumVelocity;
+    pBuf->maximumVelocity = ssfd.sampleDescriptor.maximumVelocity;
+
+    if (!pBuf->initStreaming(ssfd.sampleRate, ssfd.channelCount, ssfd.sampleCount,
+                             ssfd.residentSampleCount, ssfd.path, (size_t)ssfd.dataOffset))
+    {
+        printf("CoreSampler: cannot stream %s\n", ssfd.path);
+        delete pBuf;
+        return;
     }
+    data->sampleBufferList.push_back(pBuf);
+
+    applySampleDescriptor(pBuf, ssfd.sampleDescriptor, ssfd.sampleCount);
 }
 
 AudioKitCore::KeyMappedSampleBuffer *CoreSampler::lookupSample(unsigned noteNumber, unsigned velocity)
 {
-    // common case: only one sample mapped to this note - return it immediately
-    if (data->keyMap[noteNumber].size() == 1)
-        return data->keyMap[noteNumber].front();
-    
-    // search samples mapped to this note for best choice based on velocity
-    for (AudioKitCore::KeyMappedSampleBuffer *pBuf : data->keyMap[noteNumber])
+    if (noteNumber >= MIDI_NOTENUMBERS || velocity > 127) return 0;
+
+    // one indexed load resolves the note/velocity pair; no list traversal
+    InternalData::GridCell &cell = data->lookupGrid[noteNumber][velocity];
+    if (cell.count == 0) return 0;
+
+    // multiple buffers in one cell are round-robin layers: cycle per trigger
+    uint32_t pick = cell.first;
+    if (cell.count > 1)
+        pick += cell.nextRoundRobin++ % cell.count;
+    AudioKitCore::KeyMappedSampleBuffer *pFound = data->gridEntries[pick];
+
+    // a looked-up sample is about to play: give streamed buffers a head
+    // start on prefetching their tail
+    pFound->noteStarted();
+    return pFound;
+}
+
+// Rebuild the note x velocity lookup grid from keyMap[]; called by both
+// keymap builders before they mark the map valid. Entry order within a cell
+// matches the old list-scan acceptance order, so the first trigger picks the
+// same buffer the traversal used to find.
+void CoreSampler::rebuildLookupGrid(void)
+{
+    data->gridEntries.clear();
+    for (int nn=0; nn < MIDI_NOTENUMBERS; nn++)
     {
-        // if sample does not have velocity range, accept it trivially
-        if (pBuf->minimumVelocity < 0 || pBuf->maximumVelocity < 0) return pBuf;
-        
-        // otherwise (common case), accept based on velocity
-        if ((int)velocity >= pBuf->minimumVelocity && (int)velocity <= pBuf->maximumVelocity) return pBuf;
+        for (int vel=0; vel < 128; vel++)
+        {
+            InternalData::GridCell &cell = data->lookupGrid[nn][vel];
+            cell.first = (uint32_t)data->gridEntries.size();
+            cell.nextRoundRobin = 0;
+
+            // a note with only one mapped sample takes it at any velocity
+            if (data->keyMap[nn].size() == 1)
+                data->gridEntries.push_back(data->keyMap[nn].front());
+
+            else for (AudioKitCore::KeyMappedSampleBuffer *pBuf : data->keyMap[nn])
+            {
+                // a sample without a velocity range matches trivially
+                if (pBuf->minimumVelocity < 0 || pBuf->maximumVelocity < 0 ||
+                    (vel >= pBuf->minimumVelocity && vel <= pBuf->maximumVelocity))
+                    data->gridEntries.push_back(pBuf);
+            }
+            cell.count = (uint16_t)(data->gridEntries.size() - cell.first);
+        }
     }
-    
-    // return nil if no samples mapped to note (or sample velocities are invalid)
-    return 0;
 }
 
 void CoreSampler::setNoteFrequency(int noteNumber, float noteFrequency)
@@ -217,6 +540,7 @@ void CoreSampler::buildSimpleKeyMap()
             }
         }
     }
+    rebuildLookupGrid();
     isKeyMapValid = true;
 }
 
@@ -238,17 +562,16 @@ void CoreSampler::buildKeyMap(void)
                 data->keyMap[nn].push_back(pBuf);
         }
     }
+    rebuildLookupGrid();
     isKeyMapValid = true;
 }
 
 AudioKitCore::SamplerVoice *CoreSampler::voicePlayingNote(unsigned noteNumber)
 {
-    for (int i=0; i < MAX_POLYPHONY; i++)
-    {
-        AudioKitCore::SamplerVoice *pVoice = &data->voice[i];
-        if (pVoice->noteNumber == noteNumber) return pVoice;
-    }
-    return 0;
+    int vi = data->voiceOfNote[noteNumber];
+    if (vi < 0) return 0;
+    AudioKitCore::SamplerVoice *pVoice = &data->voice[vi];
+    return pVoice->noteNumber == (int)noteNumber ? pVoice : 0;
 }
 
 void CoreSampler::playNote(unsigned noteNumber, unsigned velocity)
@@ -294,12 +617,15 @@ void CoreSampler::play(unsigned noteNumber, unsigned velocity, bool anotherKeyWa
             AudioKitCore::SamplerVoice *pVoice = &data->voice[0];
             if (pVoice->noteNumber >= 0)
             {
+                int oldNote = pVoice->noteNumber;
                 pVoice->restartNewNoteLegato(noteNumber, currentSampleRate, noteFrequency);
+                data->remapVoiceNote(0, oldNote, noteNumber);
             }
             else
             {
                 AudioKitCore::KeyMappedSampleBuffer *pBuf = lookupSample(noteNumber, velocity);
                 if (pBuf == 0) return;  // don't crash if someone forgets to build map
+                data->takeSpecificVoice(0, noteNumber);
                 pVoice->start(noteNumber, currentSampleRate, noteFrequency, velocity / 127.0f, pBuf);
             }
             lastPlayedNoteNumber = noteNumber;
@@ -311,8 +637,13 @@ void CoreSampler::play(unsigned noteNumber, unsigned velocity, bool anotherKeyWa
             AudioKitCore::SamplerVoice *pVoice = &data->voice[0];
             AudioKitCore::KeyMappedSampleBuffer *pBuf = lookupSample(noteNumber, velocity);
             if (pBuf == 0) return;  // don't crash if someone forgets to build map
-            if (pVoice->noteNumber >= 0)
+            int oldNote = pVoice->noteNumber;
+            data->takeSpecificVoice(0, noteNumber);
+            if (oldNote >= 0)
+            {
                 pVoice->restartNewNote(noteNumber, currentSampleRate, noteFrequency, velocity / 127.0f, pBuf);
+                data->remapVoiceNote(0, oldNote, noteNumber);
+            }
             else
                 pVoice->start(noteNumber, currentSampleRate, noteFrequency, velocity / 127.0f, pBuf);
             lastPlayedNoteNumber = noteNumber;
@@ -333,21 +664,43 @@ void CoreSampler::play(unsigned noteNumber, unsigned velocity, bool anotherKeyWa
             return;
         }
         
-        // find a free voice (with noteNumber < 0) to play the note
-        int polyphony = isMonophonic ? 1 : MAX_POLYPHONY;
-        for (int i = 0; i < polyphony; i++)
+        // pop a free voice from the pool to play the note
+        AudioKitCore::KeyMappedSampleBuffer *pBuf = lookupSample(noteNumber, velocity);
+        if (pBuf == 0) return;  // don't crash if someone forgets to build map
+        pVoice = data->takeVoice(noteNumber);
+        if (pVoice)
         {
-            AudioKitCore::SamplerVoice *pVoice = &data->voice[i];
-            if (pVoice->noteNumber < 0)
+            pVoice->start(noteNumber, currentSampleRate, noteFrequency, velocity / 127.0f, pBuf);
+            lastPlayedNoteNumber = noteNumber;
+            return;
+        }
+
+        // fully polyphonic: steal the quietest voice, preferring ones
+        // already in release
+        int quietestIndex = -1;
+        float quietestLevel = 0.0f;
+        int count = data->activeVoiceCount.load(std::memory_order_relaxed);
+        for (int slot = 0; slot < count; slot++)
+        {
+            int vi = data->activeVoiceIndex[slot];
+            AudioKitCore::SamplerVoice *pCandidate = &data->voice[vi];
+            float level = pCandidate->currentLevel();
+            // releasing voices always lose to held ones
+            if (!pCandidate->ampEnvelope.isReleasing()) level += 2.0f;
+            if (quietestIndex < 0 || level < quietestLevel)
             {
-                // found a free voice: assign it to play this note
-                AudioKitCore::KeyMappedSampleBuffer *pBuf = lookupSample(noteNumber, velocity);
-                if (pBuf == 0) return;  // don't crash if someone forgets to build map
-                pVoice->start(noteNumber, currentSampleRate, noteFrequency, velocity / 127.0f, pBuf);
-                lastPlayedNoteNumber = noteNumber;
-                return;
+                quietestIndex = vi;
+                quietestLevel = level;
             }
         }
+        if (quietestIndex >= 0)
+        {
+            pVoice = &data->voice[quietestIndex];
+            int oldNote = pVoice->noteNumber;
+            pVoice->restartNewNote(noteNumber, currentSampleRate, noteFrequency, velocity / 127.0f, pBuf);
+            data->remapVoiceNote(quietestIndex, oldNote, noteNumber);
+            lastPlayedNoteNumber = noteNumber;
+        }
     }
 }
 
@@ -356,15 +709,25 @@ void CoreSampler::stop(unsigned noteNumber, bool immediate)
     AudioKitCore::SamplerVoice *pVoice = voicePlayingNote(noteNumber);
     if (pVoice == 0) return;
 
+    int vi = int(pVoice - data->voice);
+
     if (immediate)
     {
+        AudioKitCore::SampleBuffer *pSampleBuf = pVoice->sampleBuffer;
         pVoice->stop();
+        data->freeVoice(vi, noteNumber);
+        // let a streamed sample drop its tail once nothing is playing it
+        if (pSampleBuf && !data->bufferInUse(pSampleBuf)) pSampleBuf->noteEnded();
     }
     else if (isMonophonic)
     {
         int key = data->pedalLogic.firstKeyDown();
         if (key < 0) pVoice->release(loopThruRelease);
-        else if (isLegato) pVoice->restartNewNoteLegato((unsigned)key, currentSampleRate, data->tuningTable[key]);
+        else if (isLegato)
+        {
+            pVoice->restartNewNoteLegato((unsigned)key, currentSampleRate, data->tuningTable[key]);
+            data->remapVoiceNote(vi, (int)noteNumber, key);
+        }
         else
         {
             unsigned velocity = 100;
@@ -374,6 +737,7 @@ void CoreSampler::stop(unsigned noteNumber, bool immediate)
                 pVoice->restartNewNote(key, currentSampleRate, data->tuningTable[key], velocity / 127.0f, pBuf);
             else
                 pVoice->start(key, currentSampleRate, data->tuningTable[key], velocity / 127.0f, pBuf);
+            data->remapVoiceNote(vi, (int)noteNumber, key);
         }
     }
     else
@@ -388,13 +752,8 @@ void CoreSampler::stopAllVoices()
     stoppingAllVoices = true;
     
     // Wait until Render() has killed all active notes
-    bool noteStillSounding = true;
-    while (noteStillSounding)
-    {
-        noteStillSounding = false;
-        for (int i=0; i < MAX_POLYPHONY; i++)
-            if (data->voice[i].noteNumber >= 0) noteStillSounding = true;
-    }
+    while (data->activeVoiceCount.load(std::memory_order_acquire) > 0)
+        ;
 }
 
 void CoreSampler::restartVoices()
@@ -403,6 +762,13 @@ void CoreSampler::restartVoices()
     stoppingAllVoices = false;
 }
 
+void CoreSampler::setVoiceWorkerCount(int workerCount)
+{
+    // call from a non-render thread; worker threads and their mix buffers
+    // are allocated here, never during render
+    data->workerPool.init(workerCount, CORESAMPLER_MAX_RENDER_FRAMES);
+}
+
 void CoreSampler::render(unsigned channelCount, unsigned sampleCount, float *outBuffers[])
 {
     float *pOutLeft = outBuffers[0];
@@ -413,22 +779,120 @@ void CoreSampler::render(unsigned channelCount, unsigned sampleCount, float *out
     
     bool allowSampleRunout = !(isMonophonic && isLegato);
 
-    AudioKitCore::SamplerVoice *pVoice = &data->voice[0];
-    for (int i=0; i < MAX_POLYPHONY; i++, pVoice++)
+    data->filterCoefficientCache.beginQuantum();
+
+    int activeCount = data->activeVoiceCount.load(std::memory_order_relaxed);
+    if (data->workerPool.isEnabled() &&
+        activeCount >= CORESAMPLER_PARALLEL_THRESHOLD &&
+        (int)sampleCount <= CORESAMPLER_MAX_RENDER_FRAMES)
     {
+        // Voice-parallel path: snapshot the active voices, render slices of
+        // them concurrently into private mixes, then stop finished notes
+        // serially once every slice has completed.
+        struct SliceContext
+        {
+            AudioKitCore::SamplerVoice *voices[MAX_POLYPHONY];
+            bool finished[MAX_POLYPHONY];
+            int sampleCount;
+            float masterVolume, pitchDev, cutoffMul, keyTracking, cutoffEnvelopeStrength;
+            float filterEnvelopeVelocityScaling, linearResonance, pitchADSRSemitones;
+            float voiceVibratoDepth, voiceVibratoFrequency, silenceThreshold;
+            bool stoppingAll, allowSampleRunout, restartVoiceLFO;
+            AudioKitCore::FilterCoefficientCache *coefficientCache;
+        } ctx;
+
+        for (int i=0; i < activeCount; i++)
+        {
+            ctx.voices[i] = &data->voice[data->activeVoiceIndex[i]];
+            ctx.finished[i] = false;
+        }
+        ctx.sampleCount = (int)sampleCount;
+        ctx.masterVolume = masterVolume;
+        ctx.pitchDev = pitchDev;
+        ctx.cutoffMul = cutoffMul;
+        ctx.keyTracking = keyTracking;
+        ctx.cutoffEnvelopeStrength = cutoffEnvelopeStrength;
+        ctx.filterEnvelopeVelocityScaling = filterEnvelopeVelocityScaling;
+        ctx.linearResonance = linearResonance;
+        ctx.pitchADSRSemitones = pitchADSRSemitones;
+        ctx.voiceVibratoDepth = voiceVibratoDepth;
+        ctx.voiceVibratoFrequency = voiceVibratoFrequency;
+        ctx.silenceThreshold = voiceSilenceThreshold;
+        ctx.stoppingAll = stoppingAllVoices;
+        ctx.allowSampleRunout = allowSampleRunout;
+        ctx.restartVoiceLFO = restartVoiceLFO;
+        ctx.coefficientCache = &data->filterCoefficientCache;
+
+        data->workerPool.renderVoices(activeCount,
+            [](void *p, int first, int last, float *leftMix, float *rightMix, int frameCount) {
+                SliceContext *ctx = (SliceContext *)p;
+                for (int s = first; s < last; s++)
+                {
+                    AudioKitCore::SamplerVoice *pVoice = ctx->voices[s];
+                    pVoice->restartVoiceLFO = ctx->restartVoiceLFO;
+                    pVoice->silenceThreshold = ctx->silenceThreshold;
+                    pVoice->coefficientCache = ctx->coefficientCache;
+                    if (pVoice->noteNumber < 0) continue;
+                    if (ctx->stoppingAll)
+                    {
+                        ctx->finished[s] = true;
+                        continue;
+                    }
+                    if (pVoice->prepToGetSamples(ctx->sampleCount, ctx->masterVolume, ctx->pitchDev,
+                                                 ctx->cutoffMul, ctx->keyTracking, ctx->cutoffEnvelopeStrength,
+                                                 ctx->filterEnvelopeVelocityScaling, ctx->linearResonance,
+                                                 ctx->pitchADSRSemitones, ctx->voiceVibratoDepth,
+                                                 ctx->voiceVibratoFrequency) ||
+                        (pVoice->getSamples(ctx->sampleCount, leftMix, rightMix) && ctx->allowSampleRunout))
+                    {
+                        ctx->finished[s] = true;
+                    }
+                }
+            },
+            &ctx, pOutLeft, pOutRight, (int)sampleCount);
+
+        for (int s=0; s < activeCount; s++)
+        {
+            if (!ctx.finished[s]) continue;
+            int nn = ctx.voices[s]->noteNumber;
+            if (nn >= 0) stopNote(nn, true);
+        }
+        return;
+    }
+
+    // Iterate only the active voices. When a voice finishes, stopNote()
+    // swap-removes it from the active list, so the same slot is re-examined
+    // instead of advancing.
+    int slot = 0;
+    while (slot < data->activeVoiceCount.load(std::memory_order_relaxed))
+    {
+        int vi = data->activeVoiceIndex[slot];
+        AudioKitCore::SamplerVoice *pVoice = &data->voice[vi];
         pVoice->restartVoiceLFO = restartVoiceLFO;
+        pVoice->silenceThreshold = voiceSilenceThreshold;
+        pVoice->coefficientCache = &data->filterCoefficientCache;
         int nn = pVoice->noteNumber;
-        if (nn >= 0)
+        if (nn < 0)
+        {
+            // stale entry; shouldn't happen, but don't leak the voice
+            data->freeVoice(vi, -1);
+            continue;
+        }
+        if (stoppingAllVoices ||
+            pVoice->prepToGetSamples(sampleCount, masterVolume, pitchDev, cutoffMul, keyTracking,
+                                     cutoffEnvelopeStrength, filterEnvelopeVelocityScaling, linearResonance,
+                                     pitchADSRSemitones, voiceVibratoDepth, voiceVibratoFrequency) ||
+            (pVoice->getSamples(sampleCount, pOutLeft, pOutRight) && allowSampleRunout))
         {
-            if (stoppingAllVoices ||
-                pVoice->prepToGetSamples(sampleCount, masterVolume, pitchDev, cutoffMul, keyTracking,
-                                         cutoffEnvelopeStrength, filterEnvelopeVelocityScaling, linearResonance,
-                                         pitchADSRSemitones, voiceVibratoDepth, voiceVibratoFrequency) ||
-                (pVoice->getSamples(sampleCount, pOutLeft, pOutRight) && allowSampleRunout))
+            stopNote(nn, true);
+            if (pVoice->noteNumber == nn)
             {
-                stopNote(nn, true);
+                // note map was stale; stop and free the voice directly
+                pVoice->stop();
+                data->freeVoice(vi, nn);
             }
         }
+        else ++slot;
     }
 }
 
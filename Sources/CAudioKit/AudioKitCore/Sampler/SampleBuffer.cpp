@@ -1,12 +1,20 @@
 // Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
 
 #include "SampleBuffer.hpp"
+#include "MemoryTracker.h"
+
+#include <string.h>
+#include <sys/mman.h>
 
 namespace AudioKitCore
 {
 
     SampleBuffer::SampleBuffer()
     : samples(0)
+    , ownsSamples(true)
+    , hasGuardFrames(false)
+    , planeStride(0)
+    , trackedBytes(0)
     , channelCount(0)
     , sampleCount(0)
     , startPoint(0.0f)
@@ -27,23 +35,73 @@ namespace AudioKitCore
         this->sampleRate = sampleRate;
         this->sampleCount = sampleCount;
         this->channelCount = channelCount;
-        if (samples) delete[] samples;
-        samples = new float[channelCount * sampleCount];
+        if (samples && ownsSamples) delete[] samples;
+        akMemoryTrack(AKMemorySampleData, "SampleBuffer", -(int64_t)trackedBytes);
+        // each channel plane carries zeroed guard frames at its end, so the
+        // interpolators never have to bounds-check reads near endPoint
+        planeStride = sampleCount + guardFrames;
+        samples = new float[channelCount * planeStride];
+        memset(samples, 0, channelCount * planeStride * sizeof(float));
+        trackedBytes = (size_t)channelCount * planeStride * sizeof(float);
+        akMemoryTrack(AKMemorySampleData, "SampleBuffer", (int64_t)trackedBytes);
+        ownsSamples = true;
+        hasGuardFrames = true;
         loopStartPoint = startPoint = 0.0f;
         loopEndPoint = endPoint = (float)(sampleCount - 1);
     }
-    
+
+    void SampleBuffer::initForReferencedData(float sampleRate, int channelCount, int sampleCount, const float *data)
+    {
+        this->sampleRate = sampleRate;
+        this->sampleCount = sampleCount;
+        this->channelCount = channelCount;
+        if (samples && ownsSamples) delete[] samples;
+        akMemoryTrack(AKMemorySampleData, "SampleBuffer", -(int64_t)trackedBytes);
+        trackedBytes = 0;
+        // referenced data is never written through this pointer (see setData)
+        samples = const_cast<float *>(data);
+        ownsSamples = false;
+        // externally-owned data has no guard frames; interpolation falls back
+        // to the bounds-checked path
+        hasGuardFrames = false;
+        planeStride = sampleCount;
+        loopStartPoint = startPoint = 0.0f;
+        loopEndPoint = endPoint = (float)(sampleCount - 1);
+    }
+
     void SampleBuffer::deinit()
     {
-        if (samples) delete[] samples;
+        if (samples && ownsSamples) delete[] samples;
+        akMemoryTrack(AKMemorySampleData, "SampleBuffer", -(int64_t)trackedBytes);
+        trackedBytes = 0;
         samples = 0;
+        ownsSamples = true;
     }
-    
+
+    void SampleBuffer::prewarm(bool lockInMemory)
+    {
+        if (samples == 0 || sampleCount == 0) return;
+        size_t floatCount = (size_t)planeStride * (channelCount - 1) + sampleCount;
+        if (hasGuardFrames) floatCount = (size_t)planeStride * channelCount;
+
+        // best effort: over the wired-memory limit mlock fails and the touch
+        // loop below still gets the pages resident
+        if (lockInMemory) mlock(samples, floatCount * sizeof(float));
+
+        // one read per page faults the data in; the stride stays well under
+        // any page size
+        volatile float sink = 0.0f;
+        for (size_t i = 0; i < floatCount; i += 1024) sink += samples[i];
+        (void)sink;
+    }
+
     void SampleBuffer::setData(unsigned index, float data)
     {
-        if ((int)index < channelCount * sampleCount)
+        // referenced data may live in read-only mapped pages; never write to it
+        if (ownsSamples && (int)index < channelCount * sampleCount)
         {
-            samples[index] = data;
+            // callers address samples as if planes were contiguous; skip the guards
+            samples[(index / sampleCount) * planeStride + index % sampleCount] = data;
         }
     }
     
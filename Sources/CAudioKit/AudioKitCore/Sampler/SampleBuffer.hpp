@@ -1,6 +1,9 @@
 // Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
 
 #pragma once
+
+#include <cstddef>
+
 namespace AudioKitCore
 {
 
@@ -9,7 +12,19 @@ namespace AudioKitCore
     
     struct SampleBuffer
     {
+        // guard frames allocated past the end of each channel's data, so the
+        // interpolators can read past endPoint without bounds checks
+        static const int guardFrames = 4;
+
         float *samples;
+        // false when samples points at externally-owned memory, e.g. an mmap'd file
+        bool ownsSamples;
+        // true when each channel plane carries zeroed guard frames at its end
+        bool hasGuardFrames;
+        // distance in floats between channel planes (sampleCount + guardFrames when owned)
+        int planeStride;
+        // bytes currently reported to the memory tracker (owned data only)
+        size_t trackedBytes;
         float sampleRate;
         int channelCount;
         int sampleCount;
@@ -19,27 +34,49 @@ namespace AudioKitCore
         float noteFrequency;
         
         SampleBuffer();
-        ~SampleBuffer();
+        virtual ~SampleBuffer();
+
+        // Hooks for disk-streamed buffers (see StreamedSampleBuffer);
+        // fully-resident samples don't care. Called on the render thread.
+        virtual void noteStarted() {}
+        virtual void noteEnded() {}
+
+        // Touch (and optionally wire with mlock) the sample pages so first
+        // playback doesn't fault them in on the render thread. Call from a
+        // loading thread, never from the render thread. Streamed buffers
+        // override this to warm only their resident attack portion.
+        virtual void prewarm(bool lockInMemory);
         
         void init(float sampleRate, int channelCount, int sampleCount);
+
+        // Zero-copy init: reference caller-owned, non-interleaved sample data
+        // (such as an mmap'd float file) instead of allocating and copying.
+        // The data must remain valid until deinit.
+        void initForReferencedData(float sampleRate, int channelCount, int sampleCount, const float *data);
+
         void deinit();
-        
+
         void setData(unsigned index, float data);
         
         // Use double for the real-valued index, because oscillators will need the extra precision.
         inline float interp(double fIndex, float gain)
         {
             if (samples == 0 || sampleCount == 0) return 0.0f;
-            
+
             int ri = int(fIndex);
-            double f = fIndex - ri;
+            float f = float(fIndex - ri);
             int rj = ri + 1;
-            
+
+            if (hasGuardFrames)
+            {
+                // guard frames past endPoint make these reads branch-free
+                return gain * ((1.0f - f) * samples[ri] + f * samples[rj]);
+            }
             float si = ri < sampleCount ? samples[ri] : 0.0f;
             float sj = rj < sampleCount ? samples[rj] : 0.0f;
-            return (float)(gain * ((1.0 - f) * si + f * sj));
+            return gain * ((1.0f - f) * si + f * sj);
         }
-        
+
         inline void interp(double fIndex, float *leftOutput, float *rightOutput, float gain)
         {
             if (samples == 0 || sampleCount == 0)
@@ -52,17 +89,77 @@ namespace AudioKitCore
                 *leftOutput = *rightOutput = interp(fIndex, gain);
                 return;
             }
-            
+
             int ri = int(fIndex);
-            double f = fIndex - ri;
+            float f = float(fIndex - ri);
             int rj = ri + 1;
-            
+
+            if (hasGuardFrames)
+            {
+                *leftOutput = gain * ((1.0f - f) * samples[ri] + f * samples[rj]);
+                *rightOutput = gain * ((1.0f - f) * samples[planeStride + ri] + f * samples[planeStride + rj]);
+                return;
+            }
             float si = ri < sampleCount ? samples[ri] : 0.0f;
             float sj = rj < sampleCount ? samples[rj] : 0.0f;
-            *leftOutput = (float)(gain * ((1.0 - f) * si + f * sj));
-            si = ri < sampleCount ? samples[sampleCount + ri] : 0.0f;
-            sj = rj < sampleCount ? samples[sampleCount + rj] : 0.0f;
-            *rightOutput = (float)(gain * ((1.0f - f) * si + f * sj));
+            *leftOutput = gain * ((1.0f - f) * si + f * sj);
+            si = ri < sampleCount ? samples[planeStride + ri] : 0.0f;
+            sj = rj < sampleCount ? samples[planeStride + rj] : 0.0f;
+            *rightOutput = gain * ((1.0f - f) * si + f * sj);
+        }
+
+        // 4-point Catmull-Rom interpolation; noticeably cleaner for large
+        // pitch shifts, still branch-free in the interior thanks to the
+        // guard frames (only index 0 needs a clamp at the head).
+        inline float interpCubic(const float *plane, int ri, float f) const
+        {
+            int r0 = ri > 0 ? ri - 1 : 0;
+            float s0 = plane[r0], s1 = plane[ri], s2 = plane[ri + 1], s3 = plane[ri + 2];
+            float a = (3.0f * (s1 - s2) - s0 + s3) * 0.5f;
+            float b = s2 + s2 + s0 - (5.0f * s1 + s3) * 0.5f;
+            float c = (s2 - s0) * 0.5f;
+            return ((a * f + b) * f + c) * f + s1;
+        }
+
+        // Interpolate a whole block of output at a constant increment with no
+        // per-sample bounds checks. The caller must segment at loop points and
+        // guarantee fIndex + (frameCount-1) * increment <= endPoint, as
+        // SampleOscillator already does per chunk. The inner loops carry no
+        // branches, so the compiler can vectorize them.
+        inline void interpBlock(double fIndex, double increment, int frameCount,
+                                float *leftOutput, float *rightOutput, float gain, bool cubic = false)
+        {
+            if (samples == 0 || sampleCount == 0 || !hasGuardFrames)
+            {
+                // rare fallback: per-sample checked path
+                for (int i = 0; i < frameCount; i++, fIndex += increment)
+                    interp(fIndex, leftOutput + i, rightOutput + i, gain);
+                return;
+            }
+
+            const float *left = samples;
+            const float *right = channelCount > 1 ? samples + planeStride : samples;
+
+            if (cubic)
+            {
+                for (int i = 0; i < frameCount; i++, fIndex += increment)
+                {
+                    int ri = int(fIndex);
+                    float f = float(fIndex - ri);
+                    leftOutput[i] = gain * interpCubic(left, ri, f);
+                    rightOutput[i] = gain * interpCubic(right, ri, f);
+                }
+            }
+            else
+            {
+                for (int i = 0; i < frameCount; i++, fIndex += increment)
+                {
+                    int ri = int(fIndex);
+                    float f = float(fIndex - ri);
+                    leftOutput[i] = gain * ((1.0f - f) * left[ri] + f * left[ri + 1]);
+                    rightOutput[i] = gain * ((1.0f - f) * right[ri] + f * right[ri + 1]);
+                }
+            }
         }
     };
     
@@ -32,6 +32,39 @@ namespace AudioKitCore
             return false;
         }
         
+        // Block variant of getSamplePair: writes sampleCount frames in
+        // segments that never cross a loop boundary, letting the buffer's
+        // branch-free interpolator handle each segment at once. Optional
+        // cubic interpolation for large pitch shifts.
+        // Returns true if we run out of samples (output may be partial).
+        inline bool getSamplePairsBlock(SampleBuffer *sampleBuffer, int sampleCount,
+                                        float *leftOutput, float *rightOutput, float gain, bool cubic = false)
+        {
+            if (sampleBuffer == NULL) return true;
+            double step = multiplier * increment;
+            int done = 0;
+            while (done < sampleCount)
+            {
+                if (indexPoint > sampleBuffer->endPoint) return true;
+                bool looping = sampleBuffer->isLooping && isLooping;
+                double limit = looping ? sampleBuffer->loopEndPoint : sampleBuffer->endPoint;
+                int n = sampleCount - done;
+                if (step > 0.0)
+                {
+                    // frames we can render before indexPoint passes the limit
+                    int nToLimit = int((limit - indexPoint) / step) + 1;
+                    if (nToLimit < 1) nToLimit = 1;
+                    if (nToLimit < n) n = nToLimit;
+                }
+                sampleBuffer->interpBlock(indexPoint, step, n, leftOutput + done, rightOutput + done, gain, cubic);
+                indexPoint += step * n;
+                if (looping && indexPoint > sampleBuffer->loopEndPoint)
+                    indexPoint = indexPoint - sampleBuffer->loopEndPoint + sampleBuffer->loopStartPoint;
+                done += n;
+            }
+            return false;
+        }
+
         // return true if we run out of samples
         inline bool getSamplePair(SampleBuffer *sampleBuffer, int sampleCount, float *leftOutput, float *rightOutput, float gain)
         {
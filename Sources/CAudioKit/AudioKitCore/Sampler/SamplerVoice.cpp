@@ -20,6 +20,7 @@ namespace AudioKitCore
         restartVoiceLFO = false;
         volumeRamper.init(0.0f);
         tempGain = 0.0f;
+        silenceThreshold = 0.0f;
     }
 
     void SamplerVoice::start(unsigned note, float sampleRate, float frequency, float volume, SampleBuffer *buffer)
@@ -162,6 +163,13 @@ namespace AudioKitCore
         {
             tempGain = masterVolume * noteVolume;
             volumeRamper.reinit(ampEnvelope.getSample(), sampleCount);
+
+            // Silence-floor fast path: a releasing voice that has decayed
+            // below the floor can only get quieter, so retire it instead of
+            // rendering the rest of its release inaudibly.
+            if (silenceThreshold > 0.0f && ampEnvelope.isReleasing() &&
+                tempGain * ampEnvelope.getValue() < silenceThreshold)
+                return true;
         }
 
         if (*glideSecPerOctave != 0.0f && glideSemitones != 0.0f)
@@ -202,8 +210,25 @@ namespace AudioKitCore
             float baseFrequency = MIDDLE_C_HZ + keyTracking * (noteHz - MIDDLE_C_HZ);
             float envStrength = ((1.0f - cutoffEnvelopeVelocityScaling) + cutoffEnvelopeVelocityScaling * noteVolume);
             double cutoffFrequency = baseFrequency * (1.0f + cutoffMultiple + cutoffEnvelopeStrength * envStrength * filterEnvelope.getSample());
-            leftFilter.setParameters(cutoffFrequency, resLinear);
-            rightFilter.setParameters(cutoffFrequency, resLinear);
+            if (coefficientCache)
+            {
+                // one coefficient set per quantized (cutoff, resonance) per
+                // quantum, shared across voices and across both channels
+                ResonantLowPassFilter::Coefficients coeffs;
+                double sharedCutoffHz, sharedResLinear;
+                coefficientCache->lookup(cutoffFrequency, resLinear, samplingRate,
+                                         coeffs, sharedCutoffHz, sharedResLinear);
+                leftFilter.setCoefficients(coeffs, sharedCutoffHz, sharedResLinear);
+                rightFilter.setCoefficients(coeffs, sharedCutoffHz, sharedResLinear);
+            }
+            else
+            {
+                // both channels still share one computed set
+                leftFilter.setParameters(cutoffFrequency, resLinear);
+                ResonantLowPassFilter::Coefficients coeffs =
+                    { leftFilter.a0, leftFilter.a1, leftFilter.a2, leftFilter.b1, leftFilter.b2 };
+                rightFilter.setCoefficients(coeffs, cutoffFrequency, resLinear);
+            }
         }
         
         return false;
@@ -211,6 +236,69 @@ namespace AudioKitCore
     
     bool SamplerVoice::getSamples(int sampleCount, float *leftOutput, float *rightOutput)
     {
+        // Unity-increment fast path: a sample at the session rate played at
+        // its own pitch (typical for drum content after load-time rate
+        // normalization in CoreSampler::loadSampleData) advances exactly one
+        // frame per output frame, so frames are read directly instead of
+        // interpolated. The gain ramp and filters still run per sample.
+        if (sampleBuffer != NULL && sampleBuffer->samples != NULL && sampleBuffer->sampleCount > 0 &&
+            oscillator.multiplier * oscillator.increment == 1.0 &&
+            oscillator.indexPoint == floor(oscillator.indexPoint))
+        {
+            SampleBuffer *buffer = sampleBuffer;
+            const float *left = buffer->samples;
+            const float *right = buffer->channelCount > 1 ? buffer->samples + buffer->planeStride
+                                                          : buffer->samples;
+            double indexPoint = oscillator.indexPoint;
+            int done = 0;
+            while (done < sampleCount)
+            {
+                if (indexPoint > buffer->endPoint)
+                {
+                    oscillator.indexPoint = indexPoint;
+                    return true;
+                }
+                bool looping = buffer->isLooping && oscillator.isLooping;
+                double limit = looping ? buffer->loopEndPoint : buffer->endPoint;
+                int n = sampleCount - done;
+                int nToLimit = int(limit - indexPoint) + 1;
+                if (nToLimit < 1) nToLimit = 1;
+                if (nToLimit < n) n = nToLimit;
+                const float *leftFrame = left + int(indexPoint);
+                const float *rightFrame = right + int(indexPoint);
+                for (int i = 0; i < n; i++)
+                {
+                    float gain = tempGain * volumeRamper.getNextValue();
+                    float leftSample = gain * leftFrame[i];
+                    float rightSample = gain * rightFrame[i];
+                    if (isFilterEnabled)
+                    {
+                        leftOutput[done + i] += leftFilter.process(leftSample);
+                        rightOutput[done + i] += rightFilter.process(rightSample);
+                    }
+                    else
+                    {
+                        leftOutput[done + i] += leftSample;
+                        rightOutput[done + i] += rightSample;
+                    }
+                }
+                indexPoint += n;
+                done += n;
+                if (looping && indexPoint > buffer->loopEndPoint)
+                {
+                    indexPoint = indexPoint - buffer->loopEndPoint + buffer->loopStartPoint;
+                    // a fractional loop span breaks frame alignment; hand the
+                    // rest of the chunk to the interpolating path below
+                    if (indexPoint != floor(indexPoint)) break;
+                }
+            }
+            oscillator.indexPoint = indexPoint;
+            if (done >= sampleCount) return false;
+            leftOutput += done;
+            rightOutput += done;
+            sampleCount -= done;
+        }
+
         for (int i=0; i < sampleCount; i++)
         {
             float gain = tempGain * volumeRamper.getNextValue();
@@ -9,6 +9,7 @@
 #include "AHDSHREnvelope.hpp"
 #include "FunctionTable.hpp"
 #include "ResonantLowPassFilter.hpp"
+#include "FilterCoefficientCache.hpp"
 #include "LinearRamper.hpp"
 
 // process samples in "chunks" this size
@@ -74,7 +75,17 @@ namespace AudioKitCore
 
         /// true if filter should be used
         bool isFilterEnabled;
-        
+
+        /// linear amplitude below which a releasing voice is retired early (0 disables)
+        float silenceThreshold;
+
+        /// per-quantum shared filter coefficient cache owned by the sampler
+        /// (null means compute per voice); both channels always share one set
+        FilterCoefficientCache *coefficientCache = nullptr;
+
+        /// current audibility estimate, for quietest-voice stealing
+        float currentLevel() { return noteVolume * ampEnvelope.getValue(); }
+
         SamplerVoice() : noteNumber(-1) {}
 
         void init(double sampleRate);
@@ -0,0 +1,225 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+#include "StreamedSampleBuffer.hpp"
+#include "../../Internals/Utilities/BlockingQueue.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <thread>
+#include <vector>
+
+// frames per read on the streaming thread
+#define STREAM_CHUNK_FRAMES 32768
+
+namespace AudioKitCore
+{
+
+    StreamedSampleBuffer::StreamedSampleBuffer()
+    : fileDataOffset(0)
+    , residentSampleCount(0)
+    , mappedBytes(0)
+    {
+        // the mapping is ours to unmap; the base class must never delete[] it
+        ownsSamples = false;
+    }
+
+    StreamedSampleBuffer::~StreamedSampleBuffer()
+    {
+        // make sure the streaming thread is done with us before unmapping
+        while (streamState.load(std::memory_order_acquire) == streamQueued ||
+               streamState.load(std::memory_order_acquire) == streamLoading)
+            std::this_thread::yield();
+        if (samples)
+        {
+            munmap(samples, mappedBytes);
+            samples = 0;
+        }
+    }
+
+    bool StreamedSampleBuffer::initStreaming(float sampleRate, int channelCount, int sampleCount,
+                                             int residentCount, const char *path, size_t dataOffset)
+    {
+        if (residentCount > sampleCount) residentCount = sampleCount;
+
+        this->sampleRate = sampleRate;
+        this->channelCount = channelCount;
+        this->sampleCount = sampleCount;
+        this->residentSampleCount = residentCount;
+        this->filePath = path;
+        this->fileDataOffset = dataOffset;
+        loopStartPoint = startPoint = 0.0f;
+        loopEndPoint = endPoint = (float)(sampleCount - 1);
+
+        // reserve zero-fill pages for the full planar buffer (including the
+        // interpolation guard frames, which zero-fill pages provide for
+        // free); only pages we actually write become resident
+        planeStride = sampleCount + guardFrames;
+        hasGuardFrames = true;
+        mappedBytes = (size_t)channelCount * planeStride * sizeof(float);
+        void *p = mmap(0, mappedBytes, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANON, -1, 0);
+        if (p == MAP_FAILED)
+        {
+            mappedBytes = 0;
+            return false;
+        }
+        samples = (float *)p;
+
+        // load the attack portion now
+        FILE *f = fopen(path, "rb");
+        if (f == 0)
+        {
+            munmap(samples, mappedBytes);
+            samples = 0;
+            mappedBytes = 0;
+            return false;
+        }
+        fseek(f, (long)dataOffset, SEEK_SET);
+        std::vector<float> frames((size_t)channelCount * residentCount);
+        size_t framesRead = fread(frames.data(), channelCount * sizeof(float), residentCount, f);
+        fclose(f);
+
+        const float *pIn = frames.data();
+        for (size_t i = 0; i < framesRead; i++)
+            for (int ch = 0; ch < channelCount; ch++)
+                samples[(size_t)ch * planeStride + i] = *pIn++;
+
+        loadedSampleCount.store((int)framesRead, std::memory_order_release);
+
+        // make sure the streaming thread exists before any render-thread enqueue
+        SampleStreamer::shared();
+        return true;
+    }
+
+    void StreamedSampleBuffer::noteStarted()
+    {
+        int expected = streamIdle;
+        if (streamState.compare_exchange_strong(expected, streamQueued,
+                                                std::memory_order_acq_rel))
+            SampleStreamer::shared().enqueue(this);
+    }
+
+    void StreamedSampleBuffer::noteEnded()
+    {
+        // only drop the tail once it is fully loaded; if the streamer is
+        // mid-load, the pages stay until the next time the sample goes idle
+        int expected = streamLoaded;
+        if (streamState.compare_exchange_strong(expected, streamIdle,
+                                                std::memory_order_acq_rel))
+            releaseTailPages();
+    }
+
+    void StreamedSampleBuffer::prewarm(bool lockInMemory)
+    {
+        if (samples == 0 || residentSampleCount == 0) return;
+        for (int ch = 0; ch < channelCount; ch++)
+        {
+            float *plane = samples + (size_t)ch * planeStride;
+            if (lockInMemory) mlock(plane, (size_t)residentSampleCount * sizeof(float));
+            volatile float sink = 0.0f;
+            for (int i = 0; i < residentSampleCount; i += 1024) sink += plane[i];
+            (void)sink;
+        }
+    }
+
+    void StreamedSampleBuffer::loadTail()
+    {
+        int expected = streamQueued;
+        if (!streamState.compare_exchange_strong(expected, streamLoading,
+                                                 std::memory_order_acq_rel))
+            return;
+
+        int start = loadedSampleCount.load(std::memory_order_relaxed);
+        if (start < residentSampleCount) start = residentSampleCount;
+
+        FILE *f = fopen(filePath.c_str(), "rb");
+        if (f)
+        {
+            fseek(f, (long)(fileDataOffset + (size_t)start * channelCount * sizeof(float)), SEEK_SET);
+            std::vector<float> chunk((size_t)STREAM_CHUNK_FRAMES * channelCount);
+            while (start < sampleCount)
+            {
+                int want = sampleCount - start;
+                if (want > STREAM_CHUNK_FRAMES) want = STREAM_CHUNK_FRAMES;
+                size_t got = fread(chunk.data(), channelCount * sizeof(float), want, f);
+                if (got == 0) break;
+
+                const float *pIn = chunk.data();
+                for (size_t i = 0; i < got; i++)
+                    for (int ch = 0; ch < channelCount; ch++)
+                        samples[(size_t)ch * planeStride + start + i] = *pIn++;
+
+                start += (int)got;
+                loadedSampleCount.store(start, std::memory_order_release);
+            }
+            fclose(f);
+        }
+
+        streamState.store(streamLoaded, std::memory_order_release);
+    }
+
+    void StreamedSampleBuffer::releaseTailPages()
+    {
+        long pageSize = sysconf(_SC_PAGESIZE);
+        for (int ch = 0; ch < channelCount; ch++)
+        {
+            char *planeStart = (char *)(samples + (size_t)ch * planeStride);
+            char *tail = planeStart + (size_t)residentSampleCount * sizeof(float);
+            char *planeEnd = planeStart + (size_t)sampleCount * sizeof(float);
+
+            // only whole pages beyond the resident attack may be dropped
+            char *alignedTail = (char *)(((uintptr_t)tail + pageSize - 1) & ~(uintptr_t)(pageSize - 1));
+            if (alignedTail < planeEnd)
+                madvise(alignedTail, planeEnd - alignedTail, MADV_FREE);
+        }
+        loadedSampleCount.store(residentSampleCount, std::memory_order_release);
+    }
+
+    struct SampleStreamer::Impl
+    {
+        BlockingQueue<StreamedSampleBuffer *> queue;
+        std::thread worker;
+        std::atomic<bool> running{true};
+
+        Impl() : queue(64)
+        {
+            worker = std::thread([this] {
+                while (running.load(std::memory_order_acquire))
+                {
+                    StreamedSampleBuffer *buffer = 0;
+                    queue.wait_dequeue(buffer);
+                    if (buffer) buffer->loadTail();
+                }
+            });
+        }
+
+        ~Impl()
+        {
+            running.store(false, std::memory_order_release);
+            queue.enqueue(0);   // wake the worker so it can exit
+            worker.join();
+        }
+    };
+
+    SampleStreamer& SampleStreamer::shared()
+    {
+        // created on first use at load time; lives for the process
+        static SampleStreamer instance;
+        return instance;
+    }
+
+    SampleStreamer::SampleStreamer() : impl(new Impl) {}
+
+    SampleStreamer::~SampleStreamer() { delete impl; }
+
+    void SampleStreamer::enqueue(StreamedSampleBuffer *buffer)
+    {
+        // try_enqueue never allocates; if the queue is momentarily full the
+        // buffer simply plays its resident attack and retries on the next note
+        if (!impl->queue.try_enqueue(buffer))
+            buffer->streamState.store(StreamedSampleBuffer::streamIdle, std::memory_order_release);
+    }
+
+}
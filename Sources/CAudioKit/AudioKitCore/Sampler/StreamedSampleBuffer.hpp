@@ -0,0 +1,78 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+#pragma once
+#include "SampleBuffer.hpp"
+
+#include <atomic>
+#include <string>
+
+namespace AudioKitCore
+{
+
+    // KeyMappedSampleBuffer whose tail lives on disk. Only the attack portion
+    // of the sample is loaded up front; the rest of the address range is
+    // reserved as zero-fill pages, and a shared background thread fills it in
+    // when a note starts. Reads that outrun the disk land on mapped zero
+    // pages, so a slow disk can only ever produce brief silence, never a
+    // fault. When the sample falls out of use the tail pages are returned to
+    // the OS, so resident memory stays close to the attack portions alone.
+    //
+    // The file region must contain raw float32 frames, interleaved when
+    // channelCount > 1.
+    struct StreamedSampleBuffer : public KeyMappedSampleBuffer
+    {
+        enum StreamState { streamIdle, streamQueued, streamLoading, streamLoaded };
+
+        std::string filePath;
+        size_t fileDataOffset;      // byte offset of the first sample frame in the file
+        int residentSampleCount;    // attack frames kept permanently in RAM
+
+        // high-water mark of frames available to the render thread
+        std::atomic<int> loadedSampleCount{0};
+        std::atomic<int> streamState{streamIdle};
+
+        StreamedSampleBuffer();
+        ~StreamedSampleBuffer();
+
+        // Reserves pages for the whole sample, loads the attack portion, and
+        // registers with the shared streaming thread. Returns false if the
+        // file cannot be opened or memory cannot be reserved.
+        bool initStreaming(float sampleRate, int channelCount, int sampleCount,
+                           int residentCount, const char *path, size_t dataOffset);
+
+        // SampleBuffer hooks, called by CoreSampler on the render thread
+        void noteStarted() override;
+        void noteEnded() override;
+
+        // Warm only the resident attack portion: faulting in the reserved
+        // tail pages would commit the memory the streaming design exists to
+        // avoid.
+        void prewarm(bool lockInMemory) override;
+
+        // worker-thread entry: sequentially read and deinterleave the tail
+        void loadTail();
+
+    private:
+        size_t mappedBytes;
+        void releaseTailPages();
+    };
+
+    // One background thread shared by all streamed buffers. The render thread
+    // hands it work through a wait-free single-producer queue; it never
+    // blocks note-on.
+    class SampleStreamer
+    {
+    public:
+        static SampleStreamer& shared();
+
+        // wait-free; safe to call from the render thread
+        void enqueue(StreamedSampleBuffer *buffer);
+
+    private:
+        SampleStreamer();
+        ~SampleStreamer();
+        struct Impl;
+        Impl *impl;
+    };
+
+}
@@ -5,6 +5,9 @@
 #include "SynthVoice.hpp"
 #include "WaveStack.hpp"
 #include "SustainPedalLogic.hpp"
+#include "VoiceWorkerPool.hpp"
+#include "ModMatrix.hpp"
+#include "../../Internals/Utilities/readerwriterqueue.h"
 
 #include <math.h>
 #include <list>
@@ -12,13 +15,23 @@
 #define MAX_VOICE_COUNT 32      // number of voices
 #define MIDI_NOTENUMBERS 128    // MIDI offers 128 distinct note numbers
 
+// largest render quantum the voice-parallel path supports
+#define CORESYNTH_MAX_RENDER_FRAMES 4096
+
+// below this many active voices, fan-out overhead beats the gain
+#define CORESYNTH_PARALLEL_THRESHOLD 8
+
 struct CoreSynth::InternalData
 {
     /// array of voice resources
     AudioKitCore::SynthVoice voice[MAX_VOICE_COUNT];
-    
+
+    /// contiguous oscillator state shared by all voices (struct-of-arrays)
+    AudioKitCore::SynthVoiceStateBank voiceStateBank;
+
     AudioKitCore::WaveStack waveform1, waveform2, waveform3;      // WaveStacks are shared by all voice oscillators
-    AudioKitCore::FunctionTableOscillator vibratoLFO;             // one vibrato LFO shared by all voices
+    AudioKitCore::WaveStack organStack;                           // one cycle of the complete drawbar registration
+    AudioKitCore::ModMatrix modMatrix;                            // shared LFOs + per-voice scalars; LFO 0 is the vibrato LFO
     AudioKitCore::SustainPedalLogic pedalLogic;
     
     // simple parameters
@@ -28,6 +41,23 @@ struct CoreSynth::InternalData
     
     AudioKitCore::EnvelopeSegmentParameters segParameters[8];
     AudioKitCore::EnvelopeParameters envParameters;
+
+    // opt-in multicore voice rendering
+    AudioKitCore::VoiceWorkerPool workerPool;
+
+    // Note events from the MIDI thread, applied at the start of render().
+    // Only the fields needed to describe the event cross threads; all voice
+    // setup happens render-side.
+    struct NoteEvent
+    {
+        enum Type : uint8_t { kNotePlay, kNoteStop, kPedal };
+        uint8_t type;
+        uint8_t noteNumber;
+        uint8_t velocity;
+        bool flag;          // kNoteStop: immediate, kPedal: down
+        float frequency;
+    };
+    moodycamel::ReaderWriterQueue<NoteEvent> noteEventQueue{256};
 };
 
 CoreSynth::CoreSynth()
@@ -40,8 +70,10 @@ CoreSynth::CoreSynth()
 , linearResonance(1.0f)
 , data(new InternalData)
 {
+    data->voiceStateBank.init(MAX_VOICE_COUNT);
     for (int i=0; i < MAX_VOICE_COUNT; i++)
     {
+        data->voiceStateBank.attach(data->voice[i], i);
         data->voice[i].event = 0;
         data->voice[i].noteNumber = -1;
         data->voice[i].ampEG.pParameters = &data->ampEGParameters;
@@ -68,20 +100,23 @@ int CoreSynth::init(double sampleRate)
     data->ampEGParameters.updateSampleRate((float)(sampleRate/SYNTH_CHUNKSIZE));
     data->filterEGParameters.updateSampleRate((float)(sampleRate/SYNTH_CHUNKSIZE));
     
-    data->vibratoLFO.waveTable.sinusoid();
-    data->vibratoLFO.init(sampleRate/SYNTH_CHUNKSIZE, 5.0f);
+    data->modMatrix.init(sampleRate/SYNTH_CHUNKSIZE);
     
     data->voiceParameters.osc1.phases = 4;
     data->voiceParameters.osc1.frequencySpread = 25.0f;
     data->voiceParameters.osc1.panSpread = 0.95f;
     data->voiceParameters.osc1.pitchOffset = 0.0f;
     data->voiceParameters.osc1.mixLevel = 0.7f;
-    
+    data->voiceParameters.osc1.waveform = AudioKitCore::EnsembleOscillator::waveStackTable;
+    data->voiceParameters.osc1.waveformAmplitude = 0.2f;
+
     data->voiceParameters.osc2.phases = 2;
     data->voiceParameters.osc2.frequencySpread = 15.0f;
     data->voiceParameters.osc2.panSpread = 1.0f;
     data->voiceParameters.osc2.pitchOffset = -12.0f;
     data->voiceParameters.osc2.mixLevel = 0.6f;
+    data->voiceParameters.osc2.waveform = AudioKitCore::EnsembleOscillator::waveStackTable;
+    data->voiceParameters.osc2.waveformAmplitude = 0.4f;
     
     data->voiceParameters.osc3.drawbars[0] = 0.6f;
     data->voiceParameters.osc3.drawbars[1] = 1.0f;
@@ -128,39 +163,90 @@ int CoreSynth::init(double sampleRate)
     {
         data->voice[i].init(sampleRate, &data->waveform1, &data->waveform2, &data->waveform3, &data->voiceParameters, &data->envParameters);
     }
-    
+
+    // collapse the 16-partial drawbar registration into one cached cycle,
+    // so each voice's organ oscillator is a single WaveStack readout
+    rebuildOrganRegistration();
+    for (int i=0; i < MAX_VOICE_COUNT; i++)
+        data->voice[i].osc3.useCombinedCycle(&data->organStack);
+
     return 0;   // no error
 }
 
+void CoreSynth::rebuildOrganRegistration()
+{
+    float cycle[1 << AudioKitCore::WaveStack::maxBits];
+    AudioKitCore::DrawbarsOscillator::buildCombinedCycle(&data->waveform3,
+                                                         data->voiceParameters.osc3.drawbars,
+                                                         cycle);
+    data->organStack.initStack(cycle);
+}
+
+void CoreSynth::setDrawbarLevel(int drawbar, float level)
+{
+    if (drawbar < 0 || drawbar > 8) return;
+    data->voiceParameters.osc3.drawbars[AudioKitCore::DrawbarsOscillator::drawBarMap[drawbar]] = level;
+    rebuildOrganRegistration();
+}
+
 void CoreSynth::deinit()
 {
 }
 
+// The public note-event calls just enqueue: voice setup (envelope resets,
+// oscillator and filter state) happens at the start of the next render(),
+// where the voice state is already hot in cache and no other thread can
+// touch it mid-update.
+
 void CoreSynth::playNote(unsigned noteNumber, unsigned velocity, float noteFrequency)
 {
-    eventCounter++;
-    data->pedalLogic.keyDownAction(noteNumber);
-    play(noteNumber, velocity, noteFrequency);
+    data->noteEventQueue.try_enqueue({ InternalData::NoteEvent::kNotePlay,
+                                       uint8_t(noteNumber), uint8_t(velocity),
+                                       false, noteFrequency });
 }
 
 void CoreSynth::stopNote(unsigned noteNumber, bool immediate)
 {
-    eventCounter++;
-    if (immediate || data->pedalLogic.keyUpAction(noteNumber))
-        stop(noteNumber, immediate);
+    data->noteEventQueue.try_enqueue({ InternalData::NoteEvent::kNoteStop,
+                                       uint8_t(noteNumber), 0, immediate, 0.0f });
 }
 
 void CoreSynth::sustainPedal(bool down)
 {
-    eventCounter++;
-    if (down) data->pedalLogic.pedalDown();
-    else {
-        for (int nn=0; nn < MIDI_NOTENUMBERS; nn++)
+    data->noteEventQueue.try_enqueue({ InternalData::NoteEvent::kPedal,
+                                       0, 0, down, 0.0f });
+}
+
+void CoreSynth::processNoteEvents()
+{
+    InternalData::NoteEvent event;
+    while (data->noteEventQueue.try_dequeue(event))
+    {
+        eventCounter++;
+        switch (event.type)
         {
-            if (data->pedalLogic.isNoteSustaining(nn))
-                stop(nn, false);
+        case InternalData::NoteEvent::kNotePlay:
+            data->pedalLogic.keyDownAction(event.noteNumber);
+            play(event.noteNumber, event.velocity, event.frequency);
+            break;
+
+        case InternalData::NoteEvent::kNoteStop:
+            if (event.flag || data->pedalLogic.keyUpAction(event.noteNumber))
+                stop(event.noteNumber, event.flag);
+            break;
+
+        case InternalData::NoteEvent::kPedal:
+            if (event.flag) data->pedalLogic.pedalDown();
+            else {
+                for (int nn=0; nn < MIDI_NOTENUMBERS; nn++)
+                {
+                    if (data->pedalLogic.isNoteSustaining(nn))
+                        stop(nn, false);
+                }
+                data->pedalLogic.pedalUp();
+            }
+            break;
         }
-        data->pedalLogic.pedalUp();
     }
 }
 
@@ -248,21 +334,153 @@ void CoreSynth::stop(unsigned noteNumber, bool immediate)
     }
 }
 
+void CoreSynth::setLFOFrequencyHz(int lfoIndex, float hz)
+{
+    if (lfoIndex < 0 || lfoIndex >= AudioKitCore::ModMatrix::lfoCount) return;
+    data->modMatrix.lfo[lfoIndex].setFrequency(hz);
+}
+
+void CoreSynth::setLFOPitchModSemitones(int lfoIndex, float semitones)
+{
+    if (lfoIndex < 0 || lfoIndex >= AudioKitCore::ModMatrix::lfoCount) return;
+    data->modMatrix.lfoPitchSemitones[lfoIndex] = semitones;
+}
+
+void CoreSynth::setLFOCutoffModAmount(int lfoIndex, float amount)
+{
+    if (lfoIndex < 0 || lfoIndex >= AudioKitCore::ModMatrix::lfoCount) return;
+    data->modMatrix.lfoCutoffAmount[lfoIndex] = amount;
+}
+
+void CoreSynth::setLFOAmpModFraction(int lfoIndex, float fraction)
+{
+    if (lfoIndex < 0 || lfoIndex >= AudioKitCore::ModMatrix::lfoCount) return;
+    data->modMatrix.lfoAmpFraction[lfoIndex] = fraction;
+}
+
+void CoreSynth::setFilterKeyTrackingAmount(float amount)
+{
+    data->modMatrix.keyTrackingAmount = amount;
+}
+
+void CoreSynth::setFilterVelocitySensitivity(float amount)
+{
+    data->modMatrix.velocitySensitivity = amount;
+}
+
+void CoreSynth::setOscillatorWaveform(int oscIndex, int waveform)
+{
+    if (oscIndex < 1 || oscIndex > 2) return;
+    if (waveform < 0 || waveform > 2) return;
+
+    AudioKitCore::SynthOscParameters &params =
+        oscIndex == 1 ? data->voiceParameters.osc1 : data->voiceParameters.osc2;
+    params.waveform = AudioKitCore::EnsembleOscillator::WaveformMode(waveform);
+    // match the amplitudes baked into the shared wavetables in init()
+    params.waveformAmplitude =
+        params.waveform == AudioKitCore::EnsembleOscillator::polyBLEPSquare ? 0.4f : 0.2f;
+
+    for (int i=0; i < MAX_VOICE_COUNT; i++)
+    {
+        AudioKitCore::SynthVoice &voice = data->voice[i];
+        AudioKitCore::EnsembleOscillator &osc = oscIndex == 1 ? voice.osc1 : voice.osc2;
+        osc.setWaveformMode(params.waveform, params.waveformAmplitude);
+    }
+}
+
+void CoreSynth::setVoiceWorkerCount(int workerCount)
+{
+    // call from a non-render thread; worker threads and their mix buffers
+    // are allocated here, never during render
+    data->workerPool.init(workerCount, CORESYNTH_MAX_RENDER_FRAMES);
+}
+
 void CoreSynth::render(unsigned channelCount, unsigned sampleCount, float *outBuffers[])
 {
     float *pOutLeft = outBuffers[0];
     float *pOutRight = outBuffers[1];
-    
-    float pitchDev = pitchOffset + vibratoDepth * data->vibratoLFO.getSample();
+
+    // apply note events enqueued since the last render
+    processNoteEvents();
+
+    // evaluate the shared modulation sources once for all voices;
+    // LFO 0 doubles as the classic vibrato LFO
+    AudioKitCore::ModMatrix &mod = data->modMatrix;
+    mod.evaluate();
+    float pitchDev = pitchOffset + mod.pitchOffsetSemitones + vibratoDepth * mod.lastSample[0];
     float phaseDeltaMultiplier = pow(2.0f, pitchDev / 12.0);
-    
+    float volume = masterVolume * mod.ampModFactor;
+    float cutoffBase = cutoffMultiple + mod.cutoffOffset;
+
+    if (data->workerPool.isEnabled() && (int)sampleCount <= CORESYNTH_MAX_RENDER_FRAMES)
+    {
+        // Voice-parallel path: snapshot the sounding voices, render slices
+        // of them concurrently into private mixes, and stop finished notes
+        // serially once every slice has completed.
+        struct SliceContext
+        {
+            AudioKitCore::SynthVoice *voices[MAX_VOICE_COUNT];
+            bool finished[MAX_VOICE_COUNT];
+            float voiceCutoff[MAX_VOICE_COUNT];
+            int sampleCount;
+            float masterVolume, phaseDeltaMultiplier;
+            float cutoffEnvelopeStrength, linearResonance;
+        } ctx;
+
+        int activeCount = 0;
+        for (int i=0; i < MAX_VOICE_COUNT; i++)
+        {
+            if (data->voice[i].noteNumber < 0) continue;
+            ctx.voices[activeCount] = &data->voice[i];
+            ctx.finished[activeCount] = false;
+            ctx.voiceCutoff[activeCount] = cutoffBase +
+                mod.voiceCutoffOffset(data->voice[i].noteNumber, data->voice[i].noteVolume);
+            activeCount++;
+        }
+
+        if (activeCount >= CORESYNTH_PARALLEL_THRESHOLD)
+        {
+            ctx.sampleCount = (int)sampleCount;
+            ctx.masterVolume = volume;
+            ctx.phaseDeltaMultiplier = phaseDeltaMultiplier;
+            ctx.cutoffEnvelopeStrength = cutoffEnvelopeStrength;
+            ctx.linearResonance = linearResonance;
+
+            data->workerPool.renderVoices(activeCount,
+                [](void *p, int first, int last, float *leftMix, float *rightMix, int frameCount) {
+                    SliceContext *ctx = (SliceContext *)p;
+                    for (int s = first; s < last; s++)
+                    {
+                        AudioKitCore::SynthVoice *pVoice = ctx->voices[s];
+                        if (pVoice->prepToGetSamples(ctx->masterVolume, ctx->phaseDeltaMultiplier,
+                                                     ctx->voiceCutoff[s], ctx->cutoffEnvelopeStrength,
+                                                     ctx->linearResonance) ||
+                            pVoice->getSamples(ctx->sampleCount, leftMix, rightMix))
+                        {
+                            ctx->finished[s] = true;
+                        }
+                    }
+                },
+                &ctx, pOutLeft, pOutRight, (int)sampleCount);
+
+            for (int s=0; s < activeCount; s++)
+            {
+                if (!ctx.finished[s]) continue;
+                int nn = ctx.voices[s]->noteNumber;
+                if (nn >= 0) stopNote(nn, true);
+            }
+            return;
+        }
+    }
+
     AudioKitCore::SynthVoice *pVoice = &data->voice[0];
     for (int i=0; i < MAX_VOICE_COUNT; i++, pVoice++)
     {
         int nn = pVoice->noteNumber;
         if (nn >= 0)
         {
-            if (pVoice->prepToGetSamples(masterVolume, phaseDeltaMultiplier, cutoffMultiple, cutoffEnvelopeStrength, linearResonance) ||
+            float voiceCutoff = cutoffBase + mod.voiceCutoffOffset(nn, pVoice->noteVolume);
+            if (pVoice->prepToGetSamples(volume, phaseDeltaMultiplier, voiceCutoff, cutoffEnvelopeStrength, linearResonance) ||
                 pVoice->getSamples(sampleCount, pOutLeft, pOutRight))
             {
                 stopNote(nn, true);
@@ -10,6 +10,20 @@ namespace AudioKitCore
     // 9 Hammond drawbars mapped to harmonic numbers, minus 1 for a 0-based array
     const int DrawbarsOscillator::drawBarMap[9] = { 0, 2, 1, 3, 5, 7, 9, 11, 15 };
 
+    void DrawbarsOscillator::useInternalState()
+    {
+        octave = octaveInternal;
+        phase = phaseInternal;
+        phaseDelta = phaseDeltaInternal;
+    }
+
+    void DrawbarsOscillator::useExternalState(int *octaves, float *phases, float *phaseDeltas)
+    {
+        octave = octaves;
+        phase = phases;
+        phaseDelta = phaseDeltas;
+    }
+
     void DrawbarsOscillator::init(double sampleRate, WaveStack *pStack)
     {
         sampleRateHz = sampleRate;
@@ -21,6 +35,45 @@ namespace AudioKitCore
             safetyLevels[i] = 0.0f;
         }
         level = safetyLevels;
+        pCombinedStack = 0;
+    }
+
+    void DrawbarsOscillator::useCombinedCycle(WaveStack *pStack)
+    {
+        pCombinedStack = pStack;
+    }
+
+    void DrawbarsOscillator::buildCombinedCycle(WaveStack *pSourceStack, const float *levels,
+                                                float *pCycleOut)
+    {
+        const int length = 1 << WaveStack::maxBits;
+        for (int j=0; j < length; j++) pCycleOut[j] = 0.0f;
+
+        for (int i=0; i < phaseCount; i++)
+        {
+            if (levels[i] == 0.0f) continue;
+
+            // read partial i at the octave it would use when the fundamental
+            // occupies the full cycle, so each partial stays band-limited
+            float delta = float(i + 1) / length;
+            int oct = WaveStack::octaveForPhaseDelta(delta);
+            if (oct >= WaveStack::maxBits) continue;
+
+            float ph = 0.0f;
+            for (int j=0; j < length; j++)
+            {
+                pCycleOut[j] += levels[i] * pSourceStack->interpFast(oct, ph);
+                ph += delta;
+                if (ph >= 1.0f) ph -= 1.0f;
+            }
+        }
+
+        // initStack() reproduces octave 0 at input amplitude but renders
+        // octaves 1+ at twice that (a factor the per-partial readout above has
+        // already picked up once from the source stack). Playback virtually
+        // always reads octaves 1+, so pre-halve the cycle to keep the rebuilt
+        // stack's upper octaves at per-partial loudness.
+        for (int j=0; j < length; j++) pCycleOut[j] *= 0.5f;
     }
 
     void DrawbarsOscillator::setFrequency(float frequency)
@@ -31,14 +84,8 @@ namespace AudioKitCore
         // set each phase's normalized frequency
         for (int i=0; i < phaseCount; i++)
         {
-            octave[i] = 0;
             phaseDelta[i] = (i + 1) * (float)normalizedFrequency;
-            int length = 1 << WaveStack::maxBits;
-            while (phaseDelta[i] * length >= 1.0f)
-            {
-                octave[i]++;
-                length >>= 1;
-            }
+            octave[i] = WaveStack::octaveForPhaseDelta(phaseDelta[i]);
 
             // frequency components beyond octave 9 must be suppressed
             if (octave[i] >= WaveStack::maxBits)
@@ -51,11 +98,20 @@ namespace AudioKitCore
 
     float DrawbarsOscillator::getSample()
     {
+        if (pCombinedStack)
+        {
+            // whole registration in one readout: phase 0 is the fundamental
+            float sample = pCombinedStack->interpFast(octave[0], phase[0]);
+            phase[0] += phaseDeltaMultiplier * phaseDelta[0];
+            if (phase[0] >= 1.0f) phase[0] -= 1.0f;
+            return sample;
+        }
+
         float sample = 0.0f;
         for (int i=0; i < phaseCount; i++)
         {
             if (level[i] == 0.0f) continue;
-            sample += level[i] * pWaveStack->interp(octave[i], phase[i]);
+            sample += level[i] * pWaveStack->interpFast(octave[i], phase[i]);
             phase[i] += phaseDeltaMultiplier * phaseDelta[i];
             if (phase[i] >= 1.0f) phase[i] -= 1.0f;
         }
@@ -12,6 +12,43 @@ namespace AudioKitCore
     static std::mt19937 gen(rd());
     std::uniform_real_distribution<float> dis(0.0f, 1.0f);
     
+    void EnsembleOscillator::useInternalState()
+    {
+        octave = octaveInternal;
+        phase = phaseInternal;
+        phaseDelta = phaseDeltaInternal;
+        leftGain = leftGainInternal;
+        rightGain = rightGainInternal;
+    }
+
+    void EnsembleOscillator::useExternalState(int *octaves, float *phases, float *phaseDeltas,
+                                              float *leftGains, float *rightGains)
+    {
+        octave = octaves;
+        phase = phases;
+        phaseDelta = phaseDeltas;
+        leftGain = leftGains;
+        rightGain = rightGains;
+    }
+
+    // Two-sample polynomial correction for a downward unit step at t = 0,
+    // where t is the phase fraction and dt the per-sample phase increment.
+    // Zero away from the discontinuity, so it costs only two compares there.
+    static inline float polyBLEP(float t, float dt)
+    {
+        if (t < dt)
+        {
+            t /= dt;
+            return t + t - t * t - 1.0f;
+        }
+        if (t > 1.0f - dt)
+        {
+            t = (t - 1.0f) / dt;
+            return t * t + t + t + 1.0f;
+        }
+        return 0.0f;
+    }
+
     void EnsembleOscillator::init(double sampleRate, WaveStack *pStack)
     {
         sampleRateHz = sampleRate;
@@ -19,6 +56,8 @@ namespace AudioKitCore
         phaseCount = 1;
         frequencySpread = 0.0f;
         phaseDeltaMultiplier = 1.0f;
+        waveformMode = waveStackTable;
+        waveformAmplitude = 1.0f;
         for (int i=0; i < maxPhases; i++)
         {
             phase[i] = dis(gen);
@@ -27,6 +66,12 @@ namespace AudioKitCore
         }
     }
 
+    void EnsembleOscillator::setWaveformMode(WaveformMode mode, float amplitude)
+    {
+        waveformMode = mode;
+        waveformAmplitude = amplitude;
+    }
+
     void EnsembleOscillator::setPhases(int nPhases)
     {
         if (nPhases < 0) nPhases = 0;
@@ -71,14 +116,8 @@ namespace AudioKitCore
         if (phaseCount == 1)
         {
             // single phase case: just set normalized center frequency
-            octave[0] = 0;
             phaseDelta[0] = (float)normalizedFrequency;
-            int length = 1 << WaveStack::maxBits;
-            while (phaseDelta[0] * length >= 1.0f)
-            {
-                octave[0]++;
-                length >>= 1;
-            }
+            octave[0] = WaveStack::octaveForPhaseDelta(phaseDelta[0]);
             return;
         }
 
@@ -93,18 +132,30 @@ namespace AudioKitCore
         // set each phase's normalized frequency, stepping up by full steps
         for (int i=0; i < phaseCount; i++)
         {
-            octave[i] = 0;
             phaseDelta[i] = (float)normalizedFrequency;
+            octave[i] = WaveStack::octaveForPhaseDelta(phaseDelta[i]);
             normalizedFrequency *= deltaMultiplier;
-            int length = 1 << WaveStack::maxBits;
-            while (phaseDelta[i] * length >= 1.0f)
-            {
-                octave[i]++;
-                length >>= 1;
-            }
         }
     }
 
+    // Compute one band-limited sample algorithmically from the given phase.
+    // Pure arithmetic, no memory fetch, so the compiler can vectorize the
+    // per-strand loops in getSample()/getSamples().
+    inline float EnsembleOscillator::algorithmicSample(float t, float dt)
+    {
+        if (waveformMode == polyBLEPSquare)
+        {
+            float sample = t < 0.5f ? 1.0f : -1.0f;
+            sample += polyBLEP(t, dt);
+            float tShifted = t + 0.5f;
+            if (tShifted >= 1.0f) tShifted -= 1.0f;
+            sample -= polyBLEP(tShifted, dt);
+            return waveformAmplitude * sample;
+        }
+        // polyBLEPSaw
+        return waveformAmplitude * (2.0f * t - 1.0f - polyBLEP(t, dt));
+    }
+
     // Mono output: no panning
     float EnsembleOscillator::getSample()
     {
@@ -113,11 +164,24 @@ namespace AudioKitCore
         float gain = 1.0f / phaseCount;
         float sample = 0.0f;
 
-        for (int i=0; i < phaseCount; i++)
+        if (waveformMode == waveStackTable)
+        {
+            for (int i=0; i < phaseCount; i++)
+            {
+                sample += gain * pWaveStack->interpFast(octave[i], phase[i]);
+                phase[i] += phaseDeltaMultiplier * phaseDelta[i];
+                if (phase[i] >= 1.0f) phase[i] -= 1.0f;
+            }
+        }
+        else
         {
-            sample += gain * pWaveStack->interp(octave[i], phase[i]);
-            phase[i] += phaseDeltaMultiplier * phaseDelta[i];
-            if (phase[i] >= 1.0f) phase[i] -= 1.0f;
+            for (int i=0; i < phaseCount; i++)
+            {
+                float dt = phaseDeltaMultiplier * phaseDelta[i];
+                sample += gain * algorithmicSample(phase[i], dt);
+                phase[i] += dt;
+                if (phase[i] >= 1.0f) phase[i] -= 1.0f;
+            }
         }
         return sample;
     }
@@ -128,14 +192,30 @@ namespace AudioKitCore
         float leftSample = 0.0f;
         float rightSample = 0.0f;
 
-        for (int i=0; i < phaseCount; i++)
+        if (waveformMode == waveStackTable)
+        {
+            for (int i=0; i < phaseCount; i++)
+            {
+                float sample = pWaveStack->interpFast(octave[i], phase[i]);
+                phase[i] += phaseDeltaMultiplier * phaseDelta[i];
+                if (phase[i] >= 1.0f) phase[i] -= 1.0f;
+
+                leftSample += gain * leftGain[i] * sample;
+                rightSample += gain * rightGain[i] * sample;
+            }
+        }
+        else
         {
-            float sample = pWaveStack->interp(octave[i], phase[i]);
-            phase[i] += phaseDeltaMultiplier * phaseDelta[i];
-            if (phase[i] >= 1.0f) phase[i] -= 1.0f;
+            for (int i=0; i < phaseCount; i++)
+            {
+                float dt = phaseDeltaMultiplier * phaseDelta[i];
+                float sample = algorithmicSample(phase[i], dt);
+                phase[i] += dt;
+                if (phase[i] >= 1.0f) phase[i] -= 1.0f;
 
-            leftSample += gain * leftGain[i] * sample;
-            rightSample += gain * rightGain[i] * sample;
+                leftSample += gain * leftGain[i] * sample;
+                rightSample += gain * rightGain[i] * sample;
+            }
         }
         *pLeft += leftSample;
         *pRight += rightSample;
@@ -0,0 +1,58 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+#include "ModMatrix.hpp"
+
+namespace AudioKitCore
+{
+
+    void ModMatrix::init(double chunkRateHz)
+    {
+        for (int i = 0; i < lfoCount; i++)
+        {
+            lfo[i].waveTable.sinusoid();
+            lfo[i].init(chunkRateHz, 5.0f);
+            lfoPitchSemitones[i] = 0.0f;
+            lfoCutoffAmount[i] = 0.0f;
+            lfoAmpFraction[i] = 0.0f;
+            lastSample[i] = 0.0f;
+        }
+        keyTrackingAmount = 0.0f;
+        velocitySensitivity = 0.0f;
+        pitchOffsetSemitones = 0.0f;
+        cutoffOffset = 0.0f;
+        ampModFactor = 1.0f;
+    }
+
+    void ModMatrix::evaluate()
+    {
+        float pitch = 0.0f;
+        float cutoff = 0.0f;
+        float amp = 0.0f;
+        for (int i = 0; i < lfoCount; i++)
+        {
+            float sample = lfo[i].getSample();
+            lastSample[i] = sample;
+            pitch += lfoPitchSemitones[i] * sample;
+            cutoff += lfoCutoffAmount[i] * sample;
+            amp += lfoAmpFraction[i] * sample;
+        }
+        pitchOffsetSemitones = pitch;
+        cutoffOffset = cutoff;
+
+        // tremolo swings the gain around unity; never let it go negative
+        ampModFactor = 1.0f + amp;
+        if (ampModFactor < 0.0f) ampModFactor = 0.0f;
+    }
+
+    float ModMatrix::voiceCutoffOffset(int noteNumber, float velocity) const
+    {
+        // key tracking: open the filter above middle C, close it below
+        float keyScale = keyTrackingAmount * (noteNumber - 60) * (1.0f / 12.0f);
+
+        // velocity: soft notes (velocity < 1) pull the cutoff down
+        float velScale = velocitySensitivity * (velocity - 1.0f);
+
+        return keyScale + velScale;
+    }
+
+}
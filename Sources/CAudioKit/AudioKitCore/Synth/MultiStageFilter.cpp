@@ -35,6 +35,11 @@ namespace AudioKitCore
         for (int i=0; i < stages; i++) stage[i].setParameters(newCutoffHz, newResLinear);
     }
     
+    void MultiStageFilter::setParametersRamped(double newCutoffHz, double newResLinear, int rampSamples)
+    {
+        for (int i=0; i < stages; i++) stage[i].setParametersRamped(newCutoffHz, newResLinear, rampSamples);
+    }
+
     float MultiStageFilter::process(float sample)
     {
         for (int i=0; i < stages; i++)
@@ -42,4 +47,21 @@ namespace AudioKitCore
         return sample;
     }
 
+    void MultiStageFilter::process(const float *inBuffer, float *outBuffer, int sampleCount)
+    {
+        if (stages == 0)
+        {
+            if (outBuffer != inBuffer)
+                for (int i=0; i < sampleCount; i++) outBuffer[i] = inBuffer[i];
+            return;
+        }
+
+        // each stage sweeps the whole block with its coefficients and state
+        // in registers; a biquad is a serial recurrence, so stages run one
+        // after another rather than sample by sample
+        stage[0].process(inBuffer, outBuffer, sampleCount);
+        for (int i=1; i < stages; i++)
+            stage[i].process(outBuffer, outBuffer, sampleCount);
+    }
+
 }
@@ -6,6 +6,40 @@
 namespace AudioKitCore
 {
 
+    void SynthVoiceStateBank::init(int voiceCount)
+    {
+        const int ensembleSize = voiceCount * EnsembleOscillator::maxPhases;
+        const int drawbarsSize = voiceCount * DrawbarsOscillator::phaseCount;
+
+        osc1Octave.assign(ensembleSize, 0);
+        osc1Phase.assign(ensembleSize, 0.0f);
+        osc1PhaseDelta.assign(ensembleSize, 0.0f);
+        osc1LeftGain.assign(ensembleSize, 0.0f);
+        osc1RightGain.assign(ensembleSize, 0.0f);
+
+        osc2Octave.assign(ensembleSize, 0);
+        osc2Phase.assign(ensembleSize, 0.0f);
+        osc2PhaseDelta.assign(ensembleSize, 0.0f);
+        osc2LeftGain.assign(ensembleSize, 0.0f);
+        osc2RightGain.assign(ensembleSize, 0.0f);
+
+        osc3Octave.assign(drawbarsSize, 0);
+        osc3Phase.assign(drawbarsSize, 0.0f);
+        osc3PhaseDelta.assign(drawbarsSize, 0.0f);
+    }
+
+    void SynthVoiceStateBank::attach(SynthVoice &voice, int voiceIndex)
+    {
+        const int e = voiceIndex * EnsembleOscillator::maxPhases;
+        const int d = voiceIndex * DrawbarsOscillator::phaseCount;
+
+        voice.osc1.useExternalState(&osc1Octave[e], &osc1Phase[e], &osc1PhaseDelta[e],
+                                    &osc1LeftGain[e], &osc1RightGain[e]);
+        voice.osc2.useExternalState(&osc2Octave[e], &osc2Phase[e], &osc2PhaseDelta[e],
+                                    &osc2LeftGain[e], &osc2RightGain[e]);
+        voice.osc3.useExternalState(&osc3Octave[d], &osc3Phase[d], &osc3PhaseDelta[d]);
+    }
+
     void SynthVoice::init(double sampleRate,
                           WaveStack *pOsc1Stack,
                           WaveStack *pOsc2Stack,
@@ -18,11 +52,13 @@ namespace AudioKitCore
         noteNumber = -1;
 
         osc1.init(sampleRate, pOsc1Stack);
+        osc1.setWaveformMode(pParameters->osc1.waveform, pParameters->osc1.waveformAmplitude);
         osc1.setPhases(pParameters->osc1.phases);
         osc1.setFreqSpread(pParameters->osc1.frequencySpread);
         osc1.setPanSpread(pParameters->osc1.panSpread);
 
         osc2.init(sampleRate, pOsc2Stack);
+        osc2.setWaveformMode(pParameters->osc2.waveform, pParameters->osc2.waveformAmplitude);
         osc2.setPhases(pParameters->osc2.phases);
         osc2.setFreqSpread(pParameters->osc2.frequencySpread);
         osc2.setPanSpread(pParameters->osc2.panSpread);
@@ -144,24 +180,36 @@ namespace AudioKitCore
     
     bool SynthVoice::getSamples(int sampleCount, float *leftOutput, float *rightOutput)
     {
-        for (int i=0; i < sampleCount; i++)
+        while (sampleCount > 0)
         {
-            float leftSample = 0.0f;
-            float rightSample = 0.0f;
-            osc1.getSamples(&leftSample, &rightSample, pParameters->osc1.mixLevel);
-            osc2.getSamples(&leftSample, &rightSample, pParameters->osc2.mixLevel);
-            osc3.getSamples(&leftSample, &rightSample, pParameters->osc3.mixLevel);
+            const int maxChunk = 64;
+            float leftBuf[maxChunk], rightBuf[maxChunk];
+            int chunk = sampleCount < maxChunk ? sampleCount : maxChunk;
 
-            if (pParameters->filterStages == 0)
+            for (int i=0; i < chunk; i++)
             {
-                *leftOutput++ += tempGain * leftSample;
-                *rightOutput++ += tempGain * rightSample;
+                float leftSample = 0.0f;
+                float rightSample = 0.0f;
+                osc1.getSamples(&leftSample, &rightSample, pParameters->osc1.mixLevel);
+                osc2.getSamples(&leftSample, &rightSample, pParameters->osc2.mixLevel);
+                osc3.getSamples(&leftSample, &rightSample, pParameters->osc3.mixLevel);
+                leftBuf[i] = tempGain * leftSample;
+                rightBuf[i] = tempGain * rightSample;
             }
-            else
+
+            // filter the whole chunk at once, one block pass per stage
+            if (pParameters->filterStages > 0)
+            {
+                leftFilter.process(leftBuf, leftBuf, chunk);
+                rightFilter.process(rightBuf, rightBuf, chunk);
+            }
+
+            for (int i=0; i < chunk; i++)
             {
-                *leftOutput++ += leftFilter.process(tempGain * leftSample);
-                *rightOutput++ += rightFilter.process(tempGain * rightSample);
+                *leftOutput++ += leftBuf[i];
+                *rightOutput++ += rightBuf[i];
             }
+            sampleCount -= chunk;
         }
         return false;
     }
@@ -2,6 +2,9 @@
 
 #include "WaveStack.hpp"
 #include "kiss_fftr.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
 
 namespace AudioKitCore
 {
@@ -65,6 +68,43 @@ namespace AudioKitCore
         delete[] buf;
     }
 
+    void WaveStack::initStackFromData(const float *pStackData)
+    {
+        memcpy(pData[0], pStackData, stackFloatCount * sizeof(float));
+    }
+
+    // Serialized-stack files are a small header followed by the complete sample
+    // block for all octave levels, exactly as laid out in memory.
+    struct WaveStackFileHeader
+    {
+        char magic[4];      // "WStk"
+        uint32_t maxBits;   // must match WaveStack::maxBits
+    };
+
+    bool WaveStack::saveToFile(const char *filePath)
+    {
+        FILE *pFile = fopen(filePath, "wb");
+        if (pFile == 0) return false;
+        WaveStackFileHeader header = { { 'W', 'S', 't', 'k' }, uint32_t(maxBits) };
+        bool success = fwrite(&header, sizeof(header), 1, pFile) == 1 &&
+            fwrite(pData[0], sizeof(float), stackFloatCount, pFile) == size_t(stackFloatCount);
+        fclose(pFile);
+        return success;
+    }
+
+    bool WaveStack::loadFromFile(const char *filePath)
+    {
+        FILE *pFile = fopen(filePath, "rb");
+        if (pFile == 0) return false;
+        WaveStackFileHeader header;
+        bool success = fread(&header, sizeof(header), 1, pFile) == 1 &&
+            memcmp(header.magic, "WStk", 4) == 0 &&
+            header.maxBits == uint32_t(maxBits) &&
+            fread(pData[0], sizeof(float), stackFloatCount, pFile) == size_t(stackFloatCount);
+        fclose(pFile);
+        return success;
+    }
+
     void WaveStack::init()
     {
     }
@@ -1,7 +1,11 @@
 // Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
 
 #import "DSPBase.h"
+#import "DebugDSP.h"
 #import "ParameterRamper.h"
+#import "Reaper.h"
+#import <cmath>
+#import <cstring>
 #import <map>
 #import <string>
 
@@ -30,14 +34,22 @@ void setBufferDSP(DSPRef pDSP, AudioBufferList* buffer, size_t busIndex)
     pDSP->setBuffer(buffer, busIndex);
 }
 
+void reserveScratchBuffersDSP(DSPRef pDSP, uint32_t channelCount, uint32_t maxFrames)
+{
+    pDSP->reserveScratchBuffers(channelCount, maxFrames);
+}
+
 void allocateRenderResourcesDSP(DSPRef pDSP, uint32_t channelCount, double sampleRate)
 {
+    // a deferred deinit for this DSP may still be queued; jobs run in
+    // order, so draining first keeps deinit before init
+    akReaperDrain();
     pDSP->init(channelCount, sampleRate);
 }
 
 void deallocateRenderResourcesDSP(DSPRef pDSP)
 {
-    pDSP->deinit();
+    akReaperEnqueue([](void *p) { static_cast<DSPBase *>(p)->deinit(); }, pDSP);
 }
 
 void resetDSP(DSPRef pDSP)
@@ -55,6 +67,29 @@ AUValue getParameterValueDSP(DSPRef pDSP, AUParameterAddress address)
     return pDSP->getParameter(address);
 }
 
+void setParameterRampTaperDSP(DSPRef pDSP, AUParameterAddress address, int taper)
+{
+    pDSP->setParameterTaper(address, taper);
+}
+
+void getParameterValuesDSP(DSPRef pDSP, const AUParameterAddress* addresses,
+                           AUValue* values, size_t count)
+{
+    for (size_t i = 0; i < count; ++i) {
+        values[i] = pDSP->getParameter(addresses[i]);
+    }
+}
+
+void setMeteringEnabledDSP(DSPRef pDSP, bool enabled)
+{
+    pDSP->setMeteringEnabled(enabled);
+}
+
+uint32_t getMeterLevelsDSP(DSPRef pDSP, float* peaks, float* rms, uint32_t maxChannels)
+{
+    return pDSP->readMeterLevels(peaks, rms, maxChannels);
+}
+
 void startDSP(DSPRef pDSP)
 {
     pDSP->start();
@@ -75,6 +110,11 @@ void triggerFrequencyDSP(DSPRef pDSP, AUValue frequency, AUValue amplitude)
     pDSP->triggerFrequencyAmplitude(frequency, amplitude);
 }
 
+void triggerBatchDSP(DSPRef pDSP, const AKTriggerEvent* events, size_t count)
+{
+    pDSP->enqueueTriggerEvents(events, count);
+}
+
 void setWavetableDSP(DSPRef pDSP, const float* table, size_t length, int index)
 {
     pDSP->setWavetable(table, length, index);
@@ -82,7 +122,9 @@ void setWavetableDSP(DSPRef pDSP, const float* table, size_t length, int index)
 
 void deleteDSP(DSPRef pDSP)
 {
-    delete pDSP;
+    // queued after any pending deinit for the same DSP, so destruction
+    // stays ordered; the caller must not use the pointer again
+    akReaperEnqueue([](void *p) { delete static_cast<DSPBase *>(p); }, pDSP);
 }
 
 DSPBase::DSPBase(int inputBusCount)
@@ -101,8 +143,22 @@ void DSPBase::setBuffer(AudioBufferList* buffer, size_t busIndex)
     internalBufferLists[busIndex] = buffer;
 }
 
+void DSPBase::reserveScratchBuffers(uint32_t channelCount, uint32_t maxFrames)
+{
+    scratchChannelCount = channelCount;
+    scratchFrameCapacity = maxFrames;
+    scratchSlots.assign(inputBufferLists.size(), nullptr);
+    for (size_t i = 0; i < inputBufferLists.size(); i++) {
+        ScratchBufferPool::shared().reserve(channelCount, maxFrames);
+    }
+}
+
 AUInternalRenderBlock DSPBase::internalRenderBlock()
 {
+    // sized here (off the render thread) in case a subclass constructor
+    // changed the bus count after DSPBase's member init
+    inputBusSilent.assign(inputBufferLists.size(), 0);
+
     return ^AUAudioUnitStatus(
         AudioUnitRenderActionFlags *actionFlags,
         const AudioTimeStamp       *timestamp,
@@ -114,36 +170,97 @@ AUInternalRenderBlock DSPBase::internalRenderBlock()
     {
 
         assert( (outputBusNumber == 0) && "We don't yet support multiple output busses" );
+
+        // True while every pulled input flags itself silent this quantum.
+        bool inputsSilent = pullInputBlock != nullptr && !inputBufferLists.empty();
+
         if (pullInputBlock) {
             if (bCanProcessInPlace && inputBufferLists.size() == 1) {
                 // pull input directly to output buffer
                 inputBufferLists[0] = outputData;
                 AudioUnitRenderActionFlags inputFlags = 0;
                 pullInputBlock(&inputFlags, timestamp, frameCount, 0, inputBufferLists[0]);
+                bool busSilent = (inputFlags & kAudioUnitRenderAction_OutputIsSilence) != 0;
+                inputBusSilent[0] = busSilent;
+                if (!busSilent) inputsSilent = false;
             }
             else {
-                // pull input to internal buffer
+                // pull input to scratch buffers
                 for (size_t i = 0; i < inputBufferLists.size(); i++) {
-                    inputBufferLists[i] = internalBufferLists[i];
-                    
+                    AudioBufferList* scratch = nullptr;
+                    if (i < internalBufferLists.size() && internalBufferLists[i]) {
+                        // a dedicated buffer was installed with setBuffer
+                        scratch = internalBufferLists[i];
+                    }
+                    else if (scratchFrameCapacity != 0) {
+                        // check a buffer out of the shared pool for this render
+                        scratchSlots[i] = ScratchBufferPool::shared().acquire(scratchChannelCount, frameCount);
+                        if (scratchSlots[i]) scratch = scratchSlots[i]->bufferList;
+                    }
+                    if (scratch == nullptr) {
+                        // not pulled this quantum; don't let a stale flag
+                        // skip the bus
+                        inputBusSilent[i] = 0;
+                        continue;
+                    }
+
+                    inputBufferLists[i] = scratch;
+
                     UInt32 byteSize = frameCount * sizeof(float);
-                    inputBufferLists[i]->mNumberBuffers = internalBufferLists[i]->mNumberBuffers;
-                    for (UInt32 ch = 0; ch < inputBufferLists[i]->mNumberBuffers; ch++) {
-                        inputBufferLists[i]->mBuffers[ch].mDataByteSize = byteSize;
-                        inputBufferLists[i]->mBuffers[ch].mNumberChannels = internalBufferLists[i]->mBuffers[ch].mNumberChannels;
-                        inputBufferLists[i]->mBuffers[ch].mData = internalBufferLists[i]->mBuffers[ch].mData;
+                    for (UInt32 ch = 0; ch < scratch->mNumberBuffers; ch++) {
+                        scratch->mBuffers[ch].mDataByteSize = byteSize;
                     }
-                    
+
                     AudioUnitRenderActionFlags inputFlags = 0;
                     pullInputBlock(&inputFlags, timestamp, frameCount, i, inputBufferLists[i]);
+                    bool busSilent = (inputFlags & kAudioUnitRenderAction_OutputIsSilence) != 0;
+                    inputBusSilent[i] = busSilent;
+                    if (!busSilent) inputsSilent = false;
                 }
             }
         }
-        
+
+        // A stopped generator produces silence outright; an effect earns the
+        // bypass only once its tail has died out under silent input (a
+        // stopped effect passes silence through, so it bypasses at once).
+        if (inputBufferLists.empty()) inputsSilent = !isStarted;
+
+        uint64_t priorSilentRun = silentFrameRun;
+        silentFrameRun = inputsSilent ? silentFrameRun + frameCount : 0;
+
+        float const tailSeconds = tailTimeSeconds();
+        silenceBypass = inputsSilent &&
+            (!isStarted || (tailSeconds >= 0.0f &&
+                            priorSilentRun >= uint64_t(tailSeconds * sampleRate)));
+
         outputBufferList = outputData;
-        
+
+        // Stamp the whole render (events included) into this node type's
+        // profile histogram: two timestamps and a few relaxed atomics.
+        uint64_t renderStart = profileToken >= 0 ? DSPProfilerTimestamp() : 0;
+
         processWithEvents(timestamp, frameCount, realtimeEventListHead);
-        
+
+        if (profileToken >= 0) {
+            DSPProfilerRecord(profileToken, renderStart, DSPProfilerTimestamp());
+        }
+
+        if (silenceBypass && actionFlags) {
+            *actionFlags |= kAudioUnitRenderAction_OutputIsSilence;
+        }
+
+        if (meteringEnabled.load(std::memory_order_relaxed)) {
+            updateMeters(outputData, frameCount);
+        }
+
+        // return scratch buffers to the pool
+        for (size_t i = 0; i < scratchSlots.size(); i++) {
+            if (scratchSlots[i]) {
+                ScratchBufferPool::shared().release(scratchSlots[i]);
+                scratchSlots[i] = nullptr;
+            }
+        }
+
         return noErr;
     };
 }
@@ -152,12 +269,29 @@ void DSPBase::setParameter(AUParameterAddress address, float value, bool immedia
 {
     assert(address < maxParameters);
     if(auto parameter = parameters[address]) {
-        if (immediate || !isInitialized) {
+        if (!isInitialized) {
             parameter->startRamp(value, 0);
+            return;
         }
-        else {
-            parameter->setUIValue(value);
+        // Keep getParameter readback fresh, then hand the change to the render
+        // thread. enqueue may allocate when the queue grows, which is fine on
+        // the UI thread; the render thread only ever dequeues.
+        parameter->updateUIValue(value);
+        parameterUpdateQueue.enqueue({address, value, immediate, false});
+    }
+}
+
+void DSPBase::setParameterTaper(AUParameterAddress address, int taper)
+{
+    assert(address < maxParameters);
+    if(auto parameter = parameters[address]) {
+        if (!isInitialized) {
+            parameter->setTaper(taper);
+            return;
         }
+        // Shape changes ride the same queue as value changes so they land on
+        // the render thread, ordered against the values around them.
+        parameterUpdateQueue.enqueue({address, float(taper), false, true});
     }
 }
 
@@ -170,6 +304,129 @@ float DSPBase::getParameter(AUParameterAddress address)
     return 0.0f;
 }
 
+void DSPBase::zeroFillOutput(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset)
+{
+    if (outputBufferList == nullptr) return;
+    for (UInt32 ch = 0; ch < outputBufferList->mNumberBuffers; ++ch) {
+        float* data = static_cast<float*>(outputBufferList->mBuffers[ch].mData);
+        if (data) memset(data + bufferOffset, 0, frameCount * sizeof(float));
+    }
+}
+
+void DSPBase::updateMeters(const AudioBufferList* buffers, AUAudioFrameCount frameCount)
+{
+    if (buffers == nullptr || frameCount == 0) return;
+
+    MeterLevels& levels = meterBuffer.beginWrite();
+    uint32_t channels = buffers->mNumberBuffers;
+    if (channels > maxMeterChannels) channels = maxMeterChannels;
+    levels.channelCount = channels;
+
+    for (uint32_t ch = 0; ch < channels; ++ch) {
+        const float* samples = static_cast<const float*>(buffers->mBuffers[ch].mData);
+        if (samples == nullptr) {
+            levels.peak[ch] = 0.0f;
+            levels.rms[ch] = 0.0f;
+            continue;
+        }
+        // Straight-line reduction; the samples are still in cache from the
+        // render and the loop auto-vectorizes.
+        float peak = 0.0f;
+        float sumSquares = 0.0f;
+        for (AUAudioFrameCount i = 0; i < frameCount; ++i) {
+            float s = samples[i];
+            float mag = fabsf(s);
+            if (mag > peak) peak = mag;
+            sumSquares += s * s;
+        }
+        levels.peak[ch] = peak;
+        levels.rms[ch] = sqrtf(sumSquares / float(frameCount));
+    }
+
+    meterBuffer.endWrite();
+}
+
+uint32_t DSPBase::readMeterLevels(float* peaks, float* rms, uint32_t maxChannels)
+{
+    if (!meteringEnabled.load(std::memory_order_relaxed)) return 0;
+
+    const MeterLevels& levels = meterBuffer.read();
+    uint32_t channels = levels.channelCount;
+    if (channels > maxChannels) channels = maxChannels;
+    for (uint32_t ch = 0; ch < channels; ++ch) {
+        if (peaks) peaks[ch] = levels.peak[ch];
+        if (rms) rms[ch] = levels.rms[ch];
+    }
+    return channels;
+}
+
+// Per-node state blob: a fixed header followed by one float target per
+// parameter, addresses 0..paramCount-1 (the parameter table is contiguous
+// from zero by convention). memcpy-friendly and versioned so subclasses can
+// append kernel-private state later.
+struct StateBlobHeader {
+    uint32_t magic;      // 'AKSB'
+    uint32_t version;
+    uint32_t paramCount;
+    uint32_t byteSize;   // total blob size including this header
+};
+
+static constexpr uint32_t stateBlobMagic = 0x414B5342; // 'AKSB'
+static constexpr uint32_t stateBlobVersion = 1;
+
+static int countParameters(ParameterRamper* const* parameters, int maxParameters) {
+    int count = 0;
+    while (count < maxParameters && parameters[count]) ++count;
+    return count;
+}
+
+size_t DSPBase::stateBlobSize() const
+{
+    int count = countParameters(parameters, maxParameters);
+    return sizeof(StateBlobHeader) + size_t(count) * sizeof(float);
+}
+
+size_t DSPBase::saveStateBlob(void* blob, size_t capacity) const
+{
+    size_t needed = stateBlobSize();
+    if (capacity < needed) return 0;
+
+    StateBlobHeader header;
+    header.magic = stateBlobMagic;
+    header.version = stateBlobVersion;
+    header.paramCount = uint32_t(countParameters(parameters, maxParameters));
+    header.byteSize = uint32_t(needed);
+    memcpy(blob, &header, sizeof(header));
+
+    float* values = reinterpret_cast<float*>(static_cast<char*>(blob) + sizeof(header));
+    for (uint32_t i = 0; i < header.paramCount; ++i) {
+        values[i] = parameters[i]->getUIValue();
+    }
+    return needed;
+}
+
+bool DSPBase::restoreStateBlob(const void* blob, size_t size)
+{
+    if (size < sizeof(StateBlobHeader)) return false;
+
+    StateBlobHeader header;
+    memcpy(&header, blob, sizeof(header));
+    if (header.magic != stateBlobMagic) return false;
+    if (header.version != stateBlobVersion) return false;
+    if (header.byteSize > size) return false;
+    if (header.byteSize != sizeof(header) + header.paramCount * sizeof(float)) return false;
+    if (int(header.paramCount) != countParameters(parameters, maxParameters)) return false;
+
+    const float* values = reinterpret_cast<const float*>(
+        static_cast<const char*>(blob) + sizeof(header));
+    // Immediate sets: all of them drain as one coherent update at the top of
+    // the next render cycle, with no ramps to click through.
+    for (uint32_t i = 0; i < header.paramCount; ++i) {
+        setParameter(AUParameterAddress(i), values[i], true);
+    }
+    return true;
+}
+
 void DSPBase::init(int channelCount, double sampleRate)
 {
     this->channelCount = channelCount;
@@ -183,15 +440,71 @@ void DSPBase::deinit()
 }
 DSPBase::~DSPBase() {}
 
+/**
+ Events scheduled with AUEventSampleTimeImmediate carry their intra-buffer
+ offset in the low bits of the sample time. Rebase them onto the current
+ buffer so sequenced MIDI renders sample-accurately instead of collapsing
+ to the buffer start.
+ */
+static AUEventSampleTime resolveEventTime(AUEventSampleTime eventTime, AUEventSampleTime bufferStart)
+{
+    if (eventTime < 0) {
+        return bufferStart + (eventTime - AUEventSampleTimeImmediate);
+    }
+    return eventTime;
+}
+
 void DSPBase::processWithEvents(AudioTimeStamp const *timestamp, AUAudioFrameCount frameCount,
                                   AURenderEvent const *events)
 {
     now = timestamp->mSampleTime;
+    AUEventSampleTime const bufferStart = now;
+
+    // Apply parameter changes queued by setParameter. Draining once per render
+    // cycle batches an entire UI frame's worth of changes into a single
+    // coherent update.
+    // Offline bounces snap parameters instead of dezippering: there is no
+    // listener mid-render, and ramping would force the scalar fallback paths
+    // for 20 ms worth of the large offline quanta.
+    AUAudioFrameCount const dezipperFrames =
+        isOffline ? 0 : AUAudioFrameCount(sampleRate * 0.02f);
+
+    ParameterUpdate update;
+    while (parameterUpdateQueue.try_dequeue(update)) {
+        if (auto ramper = parameters[update.address]) {
+            if (update.taperChange) {
+                ramper->setTaper(int(update.value));
+            } else {
+                ramper->startRamp(update.value, update.immediate ? 0 : dezipperFrames);
+            }
+        }
+    }
+
+    // Merge triggers queued by triggerBatchDSP into the pending list, kept
+    // sorted by sample time. Immediate (< 0) and already-late times fire at
+    // the buffer start; should the list somehow fill up, the overflow fires
+    // now rather than being dropped.
+    AKTriggerEvent queuedTrigger;
+    while (triggerQueue.try_dequeue(queuedTrigger)) {
+        if (queuedTrigger.sampleTime < bufferStart) {
+            queuedTrigger.sampleTime = bufferStart;
+        }
+        if (pendingTriggerCount == maxPendingTriggers) {
+            fireTrigger(queuedTrigger);
+            continue;
+        }
+        int pos = pendingTriggerCount++;
+        while (pos > 0 && pendingTriggers[pos - 1].sampleTime > queuedTrigger.sampleTime) {
+            pendingTriggers[pos] = pendingTriggers[pos - 1];
+            --pos;
+        }
+        pendingTriggers[pos] = queuedTrigger;
+    }
 
     // Chceck for parameter updates from the UI.
     for(int index = 0; index < maxParameters; ++index) {
         if(parameters[index]) {
-            parameters[index]->dezipperCheck(sampleRate * 0.02f);
+            parameters[index]->dezipperCheck(dezipperFrames);
         } else {
             break;
         }
@@ -201,41 +514,91 @@ void DSPBase::processWithEvents(AudioTimeStamp const *timestamp, AUAudioFrameCou
     AURenderEvent const *event = events;
 
     while (framesRemaining > 0) {
-        // If there are no more events, we can process the entire remaining segment and exit.
-        if (event == nullptr) {
+        // The next segment boundary is the earlier of the next hosted event
+        // and the next pending trigger; either may be absent.
+        bool haveBoundary = false;
+        AUEventSampleTime boundary = 0;
+        if (event != nullptr) {
+            boundary = resolveEventTime(event->head.eventSampleTime, bufferStart);
+            haveBoundary = true;
+        }
+        if (pendingTriggerCount > 0 &&
+            (!haveBoundary || pendingTriggers[0].sampleTime < boundary)) {
+            boundary = pendingTriggers[0].sampleTime;
+            haveBoundary = true;
+        }
+
+        // With no boundary left, we can process the entire remaining segment and exit.
+        if (!haveBoundary) {
             AUAudioFrameCount const bufferOffset = frameCount - framesRemaining;
-            process(framesRemaining, bufferOffset);
+            if (silenceBypass) zeroFillOutput(framesRemaining, bufferOffset);
+            else processBlock(framesRemaining, bufferOffset);
+            now += framesRemaining;
             break;
         }
 
         // start late events late.
         auto timeZero = AUEventSampleTime(0);
-        auto headEventTime = event->head.eventSampleTime;
-        AUAudioFrameCount const framesThisSegment = AUAudioFrameCount(std::max(timeZero, headEventTime - now));
+        AUAudioFrameCount framesThisSegment = AUAudioFrameCount(std::max(timeZero, boundary - now));
+        if (framesThisSegment > framesRemaining) {
+            framesThisSegment = framesRemaining;
+        }
 
-        // Compute everything before the next event.
+        // Compute everything before the next boundary.
         if (framesThisSegment > 0) {
             AUAudioFrameCount const bufferOffset = frameCount - framesRemaining;
-            process(framesThisSegment, bufferOffset);
+            if (silenceBypass) zeroFillOutput(framesThisSegment, bufferOffset);
+            else processBlock(framesThisSegment, bufferOffset);
 
             // Advance frames.
             framesRemaining -= framesThisSegment;
             // Advance time.
             now += framesThisSegment;
+
+            // A boundary past this quantum: pending triggers wait for the
+            // next cycle.
+            if (framesRemaining == 0) break;
+        }
+        if (event != nullptr &&
+            resolveEventTime(event->head.eventSampleTime, bufferStart) <= now) {
+            performAllSimultaneousEvents(now, event, bufferStart);
+        }
+        while (pendingTriggerCount > 0 && pendingTriggers[0].sampleTime <= now) {
+            fireTrigger(pendingTriggers[0]);
+            --pendingTriggerCount;
+            for (int i = 0; i < pendingTriggerCount; ++i) {
+                pendingTriggers[i] = pendingTriggers[i + 1];
+            }
         }
-        performAllSimultaneousEvents(now, event);
+    }
+}
+
+void DSPBase::enqueueTriggerEvents(const AKTriggerEvent* events, size_t count)
+{
+    for (size_t i = 0; i < count; ++i) {
+        triggerQueue.enqueue(events[i]);
+    }
+}
+
+void DSPBase::fireTrigger(const AKTriggerEvent& event)
+{
+    if (event.frequency > 0) {
+        triggerFrequencyAmplitude(event.frequency, event.amplitude);
+    } else {
+        trigger();
     }
 }
 
 /** From Apple Example code */
-void DSPBase::performAllSimultaneousEvents(AUEventSampleTime now, AURenderEvent const *&event)
+void DSPBase::performAllSimultaneousEvents(AUEventSampleTime now, AURenderEvent const *&event,
+                                           AUEventSampleTime bufferStart)
 {
     do {
         handleOneEvent(event);
         event = event->head.next;
 
         // While event is not null and is simultaneous (or late).
-    } while (event && event->head.eventSampleTime <= now);
+    } while (event && resolveEventTime(event->head.eventSampleTime, bufferStart) <= now);
 }
 
 /** From Apple Example code */
@@ -264,21 +627,64 @@ void DSPBase::startRamp(const AUParameterEvent& event)
     ramper->startRamp(event.value, event.rampDurationSampleFrames);
 }
 
-using DSPFactoryMap = std::map<std::string, DSPBase::CreateFunction>;
+// The registry hands out a dense integer type ID per node name at
+// registration; creation functions live in a flat array indexed by that
+// ID. The string map is only consulted to resolve a name to its ID, so
+// graph builds can resolve each name once and then instantiate through
+// array indexing.
+using DSPFactoryMap = std::map<std::string, int>;
 
 // A registry of creation functions.
 //
-// Note that this is a pointer because we can't guarantee the
+// Note that these are pointers because we can't guarantee the
 // order of initialization code. So we lazily init.
 static DSPFactoryMap* factoryMap = nullptr;
+static std::vector<DSPBase::CreateFunction>* factoryList = nullptr;
+static std::vector<std::string>* factoryNames = nullptr;
 
 void DSPBase::addCreateFunction(const char* name, CreateFunction func) {
 
     if(factoryMap == nullptr) {
         factoryMap = new DSPFactoryMap;
+        factoryList = new std::vector<CreateFunction>;
+        factoryNames = new std::vector<std::string>;
+    }
+
+    auto iter = factoryMap->find(name);
+    if(iter != factoryMap->end()) {
+        (*factoryList)[iter->second] = func;
+        return;
     }
 
-    (*factoryMap)[std::string(name)] = func;
+    (*factoryMap)[std::string(name)] = int(factoryList->size());
+    factoryList->push_back(func);
+    factoryNames->push_back(std::string(name));
+}
+
+int DSPBase::typeID(const char* name) {
+
+    assert(factoryMap && "Fatal error: node factory not initialized.");
+
+    auto iter = factoryMap->find(name);
+
+    if(iter == factoryMap->end()) {
+        return -1;
+    }
+
+    return iter->second;
+}
+
+DSPRef DSPBase::createByID(int typeID) {
+
+    if(factoryList == nullptr || typeID < 0 || typeID >= int(factoryList->size())) {
+        return nullptr;
+    }
+
+    DSPRef dsp = (*factoryList)[size_t(typeID)]();
+    if(dsp) {
+        dsp->profileToken = DSPProfilerRegisterNode((*factoryNames)[size_t(typeID)].c_str());
+    }
+    return dsp;
 }
 
 DSPRef DSPBase::create(const char* name) {
@@ -292,7 +698,11 @@ DSPRef DSPBase::create(const char* name) {
         return nullptr;
     }
 
-    return iter->second();
+    DSPRef dsp = (*factoryList)[iter->second]();
+    if(dsp) {
+        dsp->profileToken = DSPProfilerRegisterNode(name);
+    }
+    return dsp;
 
 }
 
@@ -300,6 +710,83 @@ DSPRef akCreateDSP(const char* name) {
     return DSPBase::create(name);
 }
 
+int akGetDSPTypeID(const char* name) {
+    return DSPBase::typeID(name);
+}
+
+DSPRef akCreateDSPByID(int typeID) {
+    return DSPBase::createByID(typeID);
+}
+
+size_t akCreateDSPBatch(const int* typeIDs, size_t count, DSPRef* dsps) {
+    size_t created = 0;
+    for (size_t i = 0; i < count; ++i) {
+        dsps[i] = DSPBase::createByID(typeIDs[i]);
+        if (dsps[i] != nullptr) ++created;
+    }
+    return created;
+}
+
+// Graph snapshot: a header followed by each node's blob back to back. Node
+// blobs carry their own sizes, so restore can walk the concatenation.
+struct GraphStateHeader {
+    uint32_t magic;      // 'AKGS'
+    uint32_t version;
+    uint32_t nodeCount;
+    uint32_t reserved;
+};
+
+static constexpr uint32_t graphStateMagic = 0x414B4753; // 'AKGS'
+static constexpr uint32_t graphStateVersion = 1;
+
+size_t akGraphStateSize(DSPRef const* dsps, size_t count) {
+    size_t size = sizeof(GraphStateHeader);
+    for (size_t i = 0; i < count; ++i) {
+        size += dsps[i]->stateBlobSize();
+    }
+    return size;
+}
+
+size_t akSaveGraphState(DSPRef const* dsps, size_t count, void* blob, size_t capacity) {
+    if (capacity < sizeof(GraphStateHeader)) return 0;
+
+    GraphStateHeader header = {graphStateMagic, graphStateVersion, uint32_t(count), 0};
+    memcpy(blob, &header, sizeof(header));
+
+    char* cursor = static_cast<char*>(blob) + sizeof(header);
+    size_t remaining = capacity - sizeof(header);
+    for (size_t i = 0; i < count; ++i) {
+        size_t written = dsps[i]->saveStateBlob(cursor, remaining);
+        if (written == 0) return 0;
+        cursor += written;
+        remaining -= written;
+    }
+    return size_t(cursor - static_cast<char*>(blob));
+}
+
+bool akRestoreGraphState(DSPRef const* dsps, size_t count, const void* blob, size_t size) {
+    if (size < sizeof(GraphStateHeader)) return false;
+
+    GraphStateHeader header;
+    memcpy(&header, blob, sizeof(header));
+    if (header.magic != graphStateMagic) return false;
+    if (header.version != graphStateVersion) return false;
+    if (header.nodeCount != count) return false;
+
+    const char* cursor = static_cast<const char*>(blob) + sizeof(header);
+    size_t remaining = size - sizeof(header);
+    for (size_t i = 0; i < count; ++i) {
+        if (remaining < sizeof(StateBlobHeader)) return false;
+        StateBlobHeader nodeHeader;
+        memcpy(&nodeHeader, cursor, sizeof(nodeHeader));
+        if (nodeHeader.byteSize > remaining) return false;
+        if (!dsps[i]->restoreStateBlob(cursor, nodeHeader.byteSize)) return false;
+        cursor += nodeHeader.byteSize;
+        remaining -= nodeHeader.byteSize;
+    }
+    return true;
+}
+
 using DSPParameterMap = std::map< std::string, AUParameterAddress >;
 
 static DSPParameterMap* paramMap = nullptr;
@@ -0,0 +1,150 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+#include "MemoryTracker.h"
+
+#include <atomic>
+#include <cstring>
+#include <mutex>
+
+extern "C" {
+// soundpipe's optional accounting hook (see soundpipe.h); installed below
+// so ftable and arena allocations land in AKMemorySoundpipe.
+extern void (*sp_alloc_report)(const char *tag, long bytes);
+}
+
+namespace {
+
+struct Counter {
+    std::atomic<int64_t> bytes{0};
+    std::atomic<int64_t> highWater{0};
+};
+
+struct NodeEntry {
+    char name[48];
+    Counter counter;
+};
+
+Counter categories[AKMemoryCategoryCount];
+Counter total;
+
+NodeEntry nodes[AK_MEMORY_MAX_NODES];
+std::atomic<int> nodeCount{0};
+std::mutex nodeMutex;
+
+const char *categoryNames[AKMemoryCategoryCount] = {
+    "Sample data",
+    "Delay lines",
+    "Bus buffers",
+    "Scratch buffers",
+    "Soundpipe",
+};
+
+void bump(Counter &c, int64_t delta)
+{
+    int64_t now = c.bytes.fetch_add(delta, std::memory_order_relaxed) + delta;
+    int64_t prev = c.highWater.load(std::memory_order_relaxed);
+    while (now > prev &&
+           !c.highWater.compare_exchange_weak(prev, now, std::memory_order_relaxed)) {}
+}
+
+Counter *nodeCounter(const char *name)
+{
+    // registration is rare (load time); lookups scan the published prefix
+    int count = nodeCount.load(std::memory_order_acquire);
+    for (int i = 0; i < count; i++) {
+        if (strcmp(nodes[i].name, name) == 0) return &nodes[i].counter;
+    }
+    std::lock_guard<std::mutex> lock(nodeMutex);
+    count = nodeCount.load(std::memory_order_relaxed);
+    for (int i = 0; i < count; i++) {
+        if (strcmp(nodes[i].name, name) == 0) return &nodes[i].counter;
+    }
+    if (count >= AK_MEMORY_MAX_NODES) return nullptr;
+    strncpy(nodes[count].name, name, sizeof(nodes[count].name) - 1);
+    nodes[count].name[sizeof(nodes[count].name) - 1] = '\0';
+    nodeCount.store(count + 1, std::memory_order_release);
+    return &nodes[count].counter;
+}
+
+void soundpipeReport(const char *tag, long bytes)
+{
+    akMemoryTrack(AKMemorySoundpipe, tag, bytes);
+}
+
+struct HookInstaller {
+    HookInstaller() { sp_alloc_report = soundpipeReport; }
+};
+HookInstaller installer;
+
+}  // namespace
+
+void akMemoryTrack(int category, const char *node, int64_t bytes)
+{
+    if (category < 0 || category >= AKMemoryCategoryCount) return;
+    bump(categories[category], bytes);
+    bump(total, bytes);
+    if (node != nullptr) {
+        Counter *c = nodeCounter(node);
+        if (c != nullptr) bump(*c, bytes);
+    }
+}
+
+int64_t akMemoryCategoryBytes(int category)
+{
+    if (category < 0 || category >= AKMemoryCategoryCount) return 0;
+    return categories[category].bytes.load(std::memory_order_relaxed);
+}
+
+int64_t akMemoryCategoryHighWater(int category)
+{
+    if (category < 0 || category >= AKMemoryCategoryCount) return 0;
+    return categories[category].highWater.load(std::memory_order_relaxed);
+}
+
+const char *akMemoryCategoryName(int category)
+{
+    if (category < 0 || category >= AKMemoryCategoryCount) return "";
+    return categoryNames[category];
+}
+
+int64_t akMemoryTotalBytes(void)
+{
+    return total.bytes.load(std::memory_order_relaxed);
+}
+
+int64_t akMemoryTotalHighWater(void)
+{
+    return total.highWater.load(std::memory_order_relaxed);
+}
+
+int akMemoryNodeCount(void)
+{
+    return nodeCount.load(std::memory_order_acquire);
+}
+
+bool akMemoryNodeInfo(int index, const char **name, int64_t *bytes, int64_t *highWater)
+{
+    if (index < 0 || index >= nodeCount.load(std::memory_order_acquire)) return false;
+    if (name != nullptr) *name = nodes[index].name;
+    if (bytes != nullptr) *bytes = nodes[index].counter.bytes.load(std::memory_order_relaxed);
+    if (highWater != nullptr) {
+        *highWater = nodes[index].counter.highWater.load(std::memory_order_relaxed);
+    }
+    return true;
+}
+
+void akMemoryResetHighWaterMarks(void)
+{
+    for (int i = 0; i < AKMemoryCategoryCount; i++) {
+        categories[i].highWater.store(categories[i].bytes.load(std::memory_order_relaxed),
+                                      std::memory_order_relaxed);
+    }
+    total.highWater.store(total.bytes.load(std::memory_order_relaxed),
+                          std::memory_order_relaxed);
+    int count = nodeCount.load(std::memory_order_acquire);
+    for (int i = 0; i < count; i++) {
+        nodes[i].counter.highWater.store(
+            nodes[i].counter.bytes.load(std::memory_order_relaxed),
+            std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,222 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+#include "ModulationClock.h"
+
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+// Lazily clocked: nothing drives the service between quanta. The first
+// shape-buffer read carrying a new sample time takes the render spinlock,
+// folds in any pending transport change, advances the beat cursor by one
+// quantum, and renders every active slot; readers arriving after that (other
+// nodes, other worker threads) see the matching sample time and return the
+// shared buffer without touching the math. Subscription management allocates
+// and therefore stays off the render thread, like ScratchBufferPool::reserve.
+
+namespace {
+
+constexpr int kMaxSlots = 64;
+constexpr uint32_t kMaxModulationFrames = 4096;
+
+struct ModulationSlot {
+    std::atomic<int> refs{0};
+    int shape = ModulationShapeSine;
+    double beatsPerCycle = 1.0;
+    std::vector<float> buffer;
+};
+
+float shapeValue(int shape, double phase) {
+    switch (shape) {
+        case ModulationShapeTriangle:
+            return phase < 0.5 ? float(4.0 * phase - 1.0) : float(3.0 - 4.0 * phase);
+        case ModulationShapeSawUp:
+            return float(2.0 * phase - 1.0);
+        case ModulationShapeSawDown:
+            return float(1.0 - 2.0 * phase);
+        case ModulationShapeSquare:
+            return phase < 0.5 ? 1.0f : -1.0f;
+        case ModulationShapeSine:
+        default:
+            return sinf(float(2.0 * M_PI * phase));
+    }
+}
+
+class ModulationClock {
+public:
+    static ModulationClock &shared() {
+        static ModulationClock instance;
+        return instance;
+    }
+
+    void setTempo(double bpm) {
+        if (bpm > 0) pendingTempo.store(bpm, std::memory_order_relaxed);
+    }
+
+    double tempo() { return pendingTempo.load(std::memory_order_relaxed); }
+
+    void setPlaying(bool playing) {
+        pendingPlaying.store(playing, std::memory_order_relaxed);
+    }
+
+    void seekBeats(double beats) {
+        pendingSeek.store(beats, std::memory_order_relaxed);
+        seekRequested.store(true, std::memory_order_release);
+    }
+
+    int subscribe(int shape, double beatsPerCycle) {
+        if (beatsPerCycle <= 0) return -1;
+        std::lock_guard<std::mutex> lock(subscriptionMutex);
+        int free = -1;
+        for (int i = 0; i < kMaxSlots; ++i) {
+            int refs = slots[i].refs.load(std::memory_order_relaxed);
+            if (refs > 0 && slots[i].shape == shape &&
+                slots[i].beatsPerCycle == beatsPerCycle) {
+                slots[i].refs.fetch_add(1, std::memory_order_relaxed);
+                return i;
+            }
+            if (refs == 0 && free < 0) free = i;
+        }
+        if (free < 0) return -1;
+        ModulationSlot &slot = slots[free];
+        slot.shape = shape;
+        slot.beatsPerCycle = beatsPerCycle;
+        slot.buffer.assign(kMaxModulationFrames, 0.0f);
+        slot.refs.store(1, std::memory_order_release);
+        return free;
+    }
+
+    void unsubscribe(int slot) {
+        if (slot < 0 || slot >= kMaxSlots) return;
+        std::lock_guard<std::mutex> lock(subscriptionMutex);
+        if (slots[slot].refs.load(std::memory_order_relaxed) > 0) {
+            slots[slot].refs.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    const float *shapeBuffer(int slot, int64_t sampleTime, uint32_t frameCount,
+                             double sampleRate) {
+        if (slot < 0 || slot >= kMaxSlots ||
+            slots[slot].refs.load(std::memory_order_acquire) == 0) {
+            return nullptr;
+        }
+        advanceTo(sampleTime, frameCount, sampleRate);
+        return slots[slot].buffer.data();
+    }
+
+    double beatPosition(int64_t sampleTime, double sampleRate) {
+        (void)sampleRate;
+        while (renderLock.test_and_set(std::memory_order_acquire)) {}
+        double beat = (sampleTime == quantumSampleTime) ? quantumBeat : beatCursor;
+        renderLock.clear(std::memory_order_release);
+        return beat;
+    }
+
+private:
+    void advanceTo(int64_t sampleTime, uint32_t frameCount, double sampleRate) {
+        if (frameCount > kMaxModulationFrames) frameCount = kMaxModulationFrames;
+        while (renderLock.test_and_set(std::memory_order_acquire)) {}
+
+        if (sampleTime == quantumSampleTime) {
+            // Same quantum. A node rendering in event-split segments may ask
+            // for more frames than the first caller did; extend in place.
+            if (frameCount > quantumFrames) {
+                double beatsPerSample = currentBeatsPerSample(sampleRate);
+                renderSlots(quantumFrames, frameCount, beatsPerSample);
+                beatCursor = quantumBeat + beatsPerSample * frameCount;
+                quantumFrames = frameCount;
+            }
+            renderLock.clear(std::memory_order_release);
+            return;
+        }
+
+        // quantum boundary: apply pending transport, then render all slots
+        activeTempo = pendingTempo.load(std::memory_order_relaxed);
+        activePlaying = pendingPlaying.load(std::memory_order_relaxed);
+        if (seekRequested.exchange(false, std::memory_order_acq_rel)) {
+            beatCursor = pendingSeek.load(std::memory_order_relaxed);
+        }
+
+        double beatsPerSample = currentBeatsPerSample(sampleRate);
+        quantumSampleTime = sampleTime;
+        quantumBeat = beatCursor;
+        quantumFrames = frameCount;
+        renderSlots(0, frameCount, beatsPerSample);
+        beatCursor = quantumBeat + beatsPerSample * frameCount;
+        renderLock.clear(std::memory_order_release);
+    }
+
+    double currentBeatsPerSample(double sampleRate) const {
+        return activePlaying && sampleRate > 0 ? activeTempo / (60.0 * sampleRate) : 0.0;
+    }
+
+    void renderSlots(uint32_t from, uint32_t to, double beatsPerSample) {
+        for (int i = 0; i < kMaxSlots; ++i) {
+            ModulationSlot &s = slots[i];
+            if (s.refs.load(std::memory_order_relaxed) == 0) continue;
+            double phase = (quantumBeat + from * beatsPerSample) / s.beatsPerCycle;
+            phase -= floor(phase);
+            double dphase = beatsPerSample / s.beatsPerCycle;
+            float *out = s.buffer.data();
+            for (uint32_t n = from; n < to; ++n) {
+                out[n] = shapeValue(s.shape, phase);
+                phase += dphase;
+                if (phase >= 1.0) phase -= 1.0;
+            }
+        }
+    }
+
+    ModulationSlot slots[kMaxSlots];
+    std::mutex subscriptionMutex;
+
+    std::atomic<double> pendingTempo{120.0};
+    std::atomic<bool> pendingPlaying{true};
+    std::atomic<double> pendingSeek{0.0};
+    std::atomic<bool> seekRequested{false};
+
+    // render-side state, guarded by renderLock
+    std::atomic_flag renderLock = ATOMIC_FLAG_INIT;
+    double activeTempo = 120.0;
+    bool activePlaying = true;
+    double beatCursor = 0.0;
+    int64_t quantumSampleTime = -1;
+    double quantumBeat = 0.0;
+    uint32_t quantumFrames = 0;
+};
+
+}  // namespace
+
+void akModulationClockSetTempo(double bpm) {
+    ModulationClock::shared().setTempo(bpm);
+}
+
+double akModulationClockTempo(void) {
+    return ModulationClock::shared().tempo();
+}
+
+void akModulationClockSetPlaying(bool playing) {
+    ModulationClock::shared().setPlaying(playing);
+}
+
+void akModulationClockSeekBeats(double beats) {
+    ModulationClock::shared().seekBeats(beats);
+}
+
+int akModulationClockSubscribe(int shape, double beatsPerCycle) {
+    return ModulationClock::shared().subscribe(shape, beatsPerCycle);
+}
+
+void akModulationClockUnsubscribe(int slot) {
+    ModulationClock::shared().unsubscribe(slot);
+}
+
+const float *akModulationClockShapeBuffer(int slot, int64_t sampleTime,
+                                          uint32_t frameCount, double sampleRate) {
+    return ModulationClock::shared().shapeBuffer(slot, sampleTime, frameCount, sampleRate);
+}
+
+double akModulationClockBeatPosition(int64_t sampleTime, double sampleRate) {
+    return ModulationClock::shared().beatPosition(sampleTime, sampleRate);
+}
@@ -0,0 +1,166 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+#include "OverloadGovernor.h"
+#include "DebugDSP.h"
+#include <atomic>
+#include <mach/mach_time.h>
+
+// Overload governor: a render observer on the output node measures how much
+// of each quantum the graph pull consumed. Sustained overload engages
+// registered degradation hooks one at a time (cheapest quality loss first);
+// sustained headroom restores them in the reverse order. Controlled quality
+// loss instead of OS-level dropouts.
+
+namespace {
+
+struct Hook {
+    int priority;
+    OverloadDegradationHook fn;
+    void* context;
+    std::atomic<bool> active{false};
+    std::atomic<bool> engaged{false};
+};
+
+constexpr int maxHooks = 64;
+
+Hook hooks[maxHooks];
+std::atomic<int> hookCount{0};
+
+std::atomic<double> budgetFraction{0.8};
+std::atomic<int> overloadQuantaThreshold{3};
+std::atomic<int> recoveryQuantaThreshold{500};
+
+double ticksToNs() {
+    static double factor = [] {
+        mach_timebase_info_data_t info;
+        mach_timebase_info(&info);
+        return (double)info.numer / (double)info.denom;
+    }();
+    return factor;
+}
+
+// Engage the lowest-priority hook not yet degraded. Runs on the render
+// thread but only on threshold crossings, so the linear scan is off the
+// steady-state path.
+void engageNextHook() {
+    int count = hookCount.load(std::memory_order_acquire);
+    Hook* next = nullptr;
+    for (int i = 0; i < count; ++i) {
+        Hook& h = hooks[i];
+        if (!h.active.load(std::memory_order_relaxed)) continue;
+        if (h.engaged.load(std::memory_order_relaxed)) continue;
+        if (next == nullptr || h.priority < next->priority) next = &h;
+    }
+    if (next) {
+        next->engaged.store(true, std::memory_order_relaxed);
+        next->fn(next->context, true);
+    }
+}
+
+// Restore the highest-priority hook currently degraded (reverse of the
+// engagement order).
+void restoreLastHook() {
+    int count = hookCount.load(std::memory_order_acquire);
+    Hook* last = nullptr;
+    for (int i = 0; i < count; ++i) {
+        Hook& h = hooks[i];
+        if (!h.active.load(std::memory_order_relaxed)) continue;
+        if (!h.engaged.load(std::memory_order_relaxed)) continue;
+        if (last == nullptr || h.priority > last->priority) last = &h;
+    }
+    if (last) {
+        last->engaged.store(false, std::memory_order_relaxed);
+        last->fn(last->context, false);
+    }
+}
+
+} // namespace
+
+int OverloadGovernorAddHook(int priority, OverloadDegradationHook hook, void* context) {
+    int count = hookCount.load(std::memory_order_relaxed);
+
+    // Reclaim a removed slot before growing the table.
+    int slot = -1;
+    for (int i = 0; i < count; ++i) {
+        if (!hooks[i].active.load(std::memory_order_relaxed)) { slot = i; break; }
+    }
+    if (slot < 0) {
+        if (count >= maxHooks) return -1;
+        slot = count;
+    }
+
+    hooks[slot].priority = priority;
+    hooks[slot].fn = hook;
+    hooks[slot].context = context;
+    hooks[slot].engaged.store(false, std::memory_order_relaxed);
+    hooks[slot].active.store(true, std::memory_order_release);
+    if (slot == count) hookCount.store(count + 1, std::memory_order_release);
+    return slot;
+}
+
+void OverloadGovernorRemoveHook(int token) {
+    if (token < 0 || token >= hookCount.load(std::memory_order_relaxed)) return;
+    hooks[token].active.store(false, std::memory_order_relaxed);
+    hooks[token].engaged.store(false, std::memory_order_relaxed);
+}
+
+int OverloadGovernorEngagedCount(void) {
+    int count = hookCount.load(std::memory_order_relaxed);
+    int engaged = 0;
+    for (int i = 0; i < count; ++i) {
+        if (hooks[i].active.load(std::memory_order_relaxed) &&
+            hooks[i].engaged.load(std::memory_order_relaxed)) ++engaged;
+    }
+    return engaged;
+}
+
+void OverloadGovernorConfigure(double budget, int overloadQuanta, int recoveryQuanta) {
+    if (budget > 0.0 && budget <= 1.0) budgetFraction.store(budget, std::memory_order_relaxed);
+    if (overloadQuanta > 0) overloadQuantaThreshold.store(overloadQuanta, std::memory_order_relaxed);
+    if (recoveryQuanta > 0) recoveryQuantaThreshold.store(recoveryQuanta, std::memory_order_relaxed);
+}
+
+AURenderObserver OverloadGovernorGetRenderObserver(double sampleRate) {
+
+    __block uint64_t quantumStart = 0;
+    __block int overBudgetRun = 0;
+    __block int healthyRun = 0;
+
+    return ^void(AudioUnitRenderActionFlags actionFlags,
+                 const AudioTimeStamp *timestamp,
+                 AUAudioFrameCount frameCount,
+                 NSInteger outputBusNumber)
+    {
+        if (actionFlags == kAudioUnitRenderAction_PreRender) {
+            quantumStart = mach_absolute_time();
+            return;
+        }
+        if (actionFlags != kAudioUnitRenderAction_PostRender || quantumStart == 0) return;
+
+        double elapsedNs = (double)(mach_absolute_time() - quantumStart) * ticksToNs();
+        double quantumNs = (double)frameCount / sampleRate * 1.0e9;
+        double load = elapsedNs / quantumNs;
+
+        // Feed the energy telemetry and derate the budget by the current
+        // thermal state, so hooks engage earlier as the device heats up and
+        // the graph sheds load before the SoC throttles it into dropouts.
+        DSPEnergyRecordQuantum(load);
+        double budget = budgetFraction.load(std::memory_order_relaxed) * DSPEnergyBudgetScale();
+
+        if (load > budget) {
+            healthyRun = 0;
+            if (++overBudgetRun >= overloadQuantaThreshold.load(std::memory_order_relaxed)) {
+                engageNextHook();
+                // Restart the count so each further hook needs its own run of
+                // overloaded quanta, giving the last change time to bite.
+                overBudgetRun = 0;
+            }
+        } else {
+            overBudgetRun = 0;
+            if (++healthyRun >= recoveryQuantaThreshold.load(std::memory_order_relaxed)) {
+                restoreLastHook();
+                healthyRun = 0;
+            }
+        }
+    };
+}
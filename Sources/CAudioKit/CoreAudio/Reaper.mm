@@ -0,0 +1,120 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+#include "Reaper.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+
+#include <pthread.h>
+
+namespace {
+
+struct Job
+{
+    void (*destroy)(void *payload);
+    void *payload;
+    Job *next;
+};
+
+// producers push with an atomic swap; the reaper takes the whole list
+std::atomic<Job *> incoming{nullptr};
+std::atomic<int> pendingCount{0};
+
+// reaper sleep/wake and drain signalling; leaked on purpose so the
+// detached reaper thread can never outlive them at process exit
+std::mutex &reaperMutex = *new std::mutex;
+std::condition_variable &reaperCV = *new std::condition_variable;
+std::once_flag threadStarted;
+
+// how many jobs run between yields, so a 1 GB unload never pins the
+// reaper to a core at the expense of everything else at its priority
+constexpr int batchSize = 32;
+
+void reaperLoop()
+{
+#ifdef __APPLE__
+    pthread_set_qos_class_self_np(QOS_CLASS_BACKGROUND, 0);
+#endif
+    for (;;)
+    {
+        Job *list = incoming.exchange(nullptr, std::memory_order_acquire);
+        if (list == nullptr)
+        {
+            std::unique_lock<std::mutex> lock(reaperMutex);
+            // timed wait: a notify racing the queue check just delays a
+            // job by one period instead of losing it
+            reaperCV.wait_for(lock, std::chrono::milliseconds(100),
+                              [] { return incoming.load(std::memory_order_relaxed) != nullptr; });
+            continue;
+        }
+
+        // pushes are LIFO; reverse so jobs run in enqueue order
+        Job *fifo = nullptr;
+        while (list != nullptr)
+        {
+            Job *next = list->next;
+            list->next = fifo;
+            fifo = list;
+            list = next;
+        }
+
+        int ranInBatch = 0;
+        while (fifo != nullptr)
+        {
+            Job *job = fifo;
+            fifo = fifo->next;
+            job->destroy(job->payload);
+            delete job;
+            pendingCount.fetch_sub(1, std::memory_order_release);
+            if (++ranInBatch == batchSize)
+            {
+                ranInBatch = 0;
+                std::this_thread::yield();
+            }
+        }
+        reaperCV.notify_all(); // wake any drainer
+    }
+}
+
+} // namespace
+
+void akReaperEnqueue(void (*destroy)(void *payload), void *payload)
+{
+    std::call_once(threadStarted, [] { std::thread(reaperLoop).detach(); });
+
+    Job *job = new Job{destroy, payload, nullptr};
+    pendingCount.fetch_add(1, std::memory_order_relaxed);
+    Job *head = incoming.load(std::memory_order_relaxed);
+    do
+    {
+        job->next = head;
+    } while (!incoming.compare_exchange_weak(head, job, std::memory_order_release,
+                                             std::memory_order_relaxed));
+    reaperCV.notify_all();
+}
+
+void akReaperFree(void *ptr)
+{
+    if (ptr == nullptr) return;
+    akReaperEnqueue([](void *p) { free(p); }, ptr);
+}
+
+void akReaperDrain(void)
+{
+    std::unique_lock<std::mutex> lock(reaperMutex);
+    // timed wait for the same reason as the reaper: the count is atomic
+    // and not guarded by the mutex, so a notify can race the check
+    while (pendingCount.load(std::memory_order_acquire) != 0)
+    {
+        reaperCV.wait_for(lock, std::chrono::milliseconds(10));
+    }
+}
+
+int akReaperPending(void)
+{
+    return pendingCount.load(std::memory_order_acquire);
+}
@@ -0,0 +1,474 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+#include "RenderGraph.h"
+#include "DSPBase.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Graph compiler and scheduler. Compilation happens off the render thread:
+// nodes are grouped into passes (a fused chain of kernels sharing one
+// buffer) and passes into topological levels (passes in a level have no
+// dependencies on each other). Rendering walks the levels in order, farming
+// a level's passes out to the worker pool when there is more than one.
+
+namespace {
+
+/// Counting semaphore on mutex/condvar; used only at level boundaries, not
+/// per sample.
+class Semaphore {
+public:
+    void signal() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++count;
+        }
+        condition.notify_one();
+    }
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [this] { return count > 0; });
+        --count;
+    }
+private:
+    std::mutex mutex;
+    std::condition_variable condition;
+    int count = 0;
+};
+
+} // namespace
+
+struct RenderGraphData {
+
+    struct Node {
+        DSPBase* dsp;
+        std::vector<int> inputs;
+    };
+
+    /// A fused chain of kernels sweeping one buffer: the first kernel reads
+    /// its input passes' buffers and writes the pass buffer, every later
+    /// kernel processes the pass buffer in place.
+    struct Pass {
+        std::vector<DSPBase*> kernels;
+        std::vector<int> inputPasses;
+        int level = 0;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<Pass> passes;
+    std::vector<std::vector<int>> levels;
+
+    uint32_t channelCount = 0;
+    uint32_t maxFrames = 0;
+
+    /// One buffer per pass: an AudioBufferList and its channel data.
+    std::vector<AudioBufferList*> passBuffers;
+    std::vector<float*> passData;
+
+    // Worker pool. Workers sleep between levels; the render thread
+    // participates, so workerCount == 0 degrades to a plain serial walk.
+    std::vector<std::thread> workers;
+    std::atomic<bool> shutdown{false};
+    Semaphore workAvailable;
+    Semaphore levelDone;
+
+    // Level in flight, shared with workers. A worker whose wake arrives late
+    // (its level already drained) sees either a null level or an exhausted
+    // nextPass and goes straight back to sleep.
+    std::atomic<const std::vector<int>*> activePasses{nullptr};
+    std::atomic<int> nextPass{0};
+    std::atomic<int> passesRemaining{0};
+    const AudioTimeStamp* activeTimestamp = nullptr;
+    uint32_t activeFrameCount = 0;
+
+    ~RenderGraphData() {
+        shutdown.store(true);
+        for (size_t i = 0; i < workers.size(); ++i) workAvailable.signal();
+        for (auto& worker : workers) worker.join();
+        freeBuffers();
+    }
+
+    void freeBuffers() {
+        for (auto* list : passBuffers) free(list);
+        for (auto* data : passData) free(data);
+        passBuffers.clear();
+        passData.clear();
+    }
+
+    int addNode(DSPBase* dsp, const int* inputNodes, size_t inputCount) {
+        for (size_t i = 0; i < inputCount; ++i) {
+            if (inputNodes[i] < 0 || inputNodes[i] >= int(nodes.size())) return -1;
+        }
+        Node node;
+        node.dsp = dsp;
+        node.inputs.assign(inputNodes, inputNodes + inputCount);
+        nodes.push_back(node);
+        return int(nodes.size()) - 1;
+    }
+
+    bool compile(uint32_t channels, uint32_t frames, int workerCount) {
+        if (nodes.empty()) return false;
+
+        channelCount = channels;
+        maxFrames = frames;
+        passes.clear();
+        levels.clear();
+        freeBuffers();
+
+        std::vector<int> consumerCount(nodes.size(), 0);
+        for (auto& node : nodes) {
+            for (int input : node.inputs) ++consumerCount[input];
+        }
+
+        // Fuse: a node joins its input's pass when it is that pass's sole
+        // consumer, hangs off the pass's last kernel, and can process in
+        // place; otherwise it opens a new pass. AddNode order is already
+        // topological, so one forward walk suffices.
+        std::vector<int> passOfNode(nodes.size());
+        for (int n = 0; n < int(nodes.size()); ++n) {
+            Node& node = nodes[n];
+            if (node.inputs.size() == 1 && node.dsp->canProcessInPlace() &&
+                consumerCount[node.inputs[0]] == 1) {
+                int candidate = passOfNode[node.inputs[0]];
+                if (passes[candidate].kernels.back() == nodes[node.inputs[0]].dsp) {
+                    passes[candidate].kernels.push_back(node.dsp);
+                    passOfNode[n] = candidate;
+                    continue;
+                }
+            }
+            Pass pass;
+            pass.kernels.push_back(node.dsp);
+            for (int input : node.inputs) pass.inputPasses.push_back(passOfNode[input]);
+            passOfNode[n] = int(passes.size());
+            passes.push_back(pass);
+        }
+
+        // Topological levels: a pass runs one level after its deepest input.
+        int maxLevel = 0;
+        for (auto& pass : passes) {
+            for (int input : pass.inputPasses) {
+                if (passes[input].level + 1 > pass.level) pass.level = passes[input].level + 1;
+            }
+            if (pass.level > maxLevel) maxLevel = pass.level;
+        }
+        levels.assign(maxLevel + 1, {});
+        for (int p = 0; p < int(passes.size()); ++p) {
+            levels[passes[p].level].push_back(p);
+        }
+
+        // One non-interleaved buffer per pass.
+        for (size_t p = 0; p < passes.size(); ++p) {
+            size_t listBytes = offsetof(AudioBufferList, mBuffers) +
+                               channelCount * sizeof(AudioBuffer);
+            auto* list = (AudioBufferList*)malloc(listBytes);
+            auto* data = (float*)calloc(size_t(channelCount) * maxFrames, sizeof(float));
+            if (list == nullptr || data == nullptr) {
+                free(list);
+                free(data);
+                freeBuffers();
+                return false;
+            }
+            list->mNumberBuffers = channelCount;
+            for (uint32_t ch = 0; ch < channelCount; ++ch) {
+                list->mBuffers[ch].mNumberChannels = 1;
+                list->mBuffers[ch].mDataByteSize = maxFrames * sizeof(float);
+                list->mBuffers[ch].mData = data + size_t(ch) * maxFrames;
+            }
+            passBuffers.push_back(list);
+            passData.push_back(data);
+        }
+
+        if (workerCount > 0 && workers.empty()) {
+            for (int i = 0; i < workerCount; ++i) {
+                workers.emplace_back([this] { workerLoop(); });
+            }
+        }
+        return true;
+    }
+
+    void runPass(int passIndex, const AudioTimeStamp* timestamp, uint32_t frameCount) {
+        Pass& pass = passes[passIndex];
+        AudioBufferList* buffer = passBuffers[passIndex];
+        for (uint32_t ch = 0; ch < buffer->mNumberBuffers; ++ch) {
+            buffer->mBuffers[ch].mDataByteSize = frameCount * sizeof(float);
+        }
+
+        DSPBase* first = pass.kernels.front();
+        size_t busCount = first->inputBufferLists.size();
+        for (size_t i = 0; i < pass.inputPasses.size() && i < busCount; ++i) {
+            first->inputBufferLists[i] = passBuffers[pass.inputPasses[i]];
+        }
+        first->outputBufferList = buffer;
+        first->processWithEvents(timestamp, frameCount, nullptr);
+
+        // The rest of the chain sweeps the same buffer in place.
+        for (size_t k = 1; k < pass.kernels.size(); ++k) {
+            DSPBase* kernel = pass.kernels[k];
+            if (!kernel->inputBufferLists.empty()) kernel->inputBufferLists[0] = buffer;
+            kernel->outputBufferList = buffer;
+            kernel->processWithEvents(timestamp, frameCount, nullptr);
+        }
+    }
+
+    /// Claims and runs passes from the active level until none remain.
+    void helpWithLevel() {
+        const std::vector<int>* level = activePasses.load(std::memory_order_acquire);
+        if (level == nullptr) return;
+        int i;
+        while ((i = nextPass.fetch_add(1)) < int(level->size())) {
+            runPass((*level)[i], activeTimestamp, activeFrameCount);
+            if (passesRemaining.fetch_sub(1) == 1) {
+                levelDone.signal();
+            }
+        }
+    }
+
+    void workerLoop() {
+        while (true) {
+            workAvailable.wait();
+            if (shutdown.load()) return;
+            helpWithLevel();
+        }
+    }
+
+    void render(const AudioTimeStamp* timestamp, uint32_t frameCount, AudioBufferList* output) {
+        if (passes.empty()) return;
+        if (frameCount > maxFrames) frameCount = maxFrames;
+
+        for (auto& level : levels) {
+            if (workers.empty() || level.size() < 2) {
+                for (int passIndex : level) runPass(passIndex, timestamp, frameCount);
+                continue;
+            }
+
+            activeTimestamp = timestamp;
+            activeFrameCount = frameCount;
+            nextPass.store(0);
+            passesRemaining.store(int(level.size()));
+            activePasses.store(&level, std::memory_order_release);
+
+            size_t helpers = workers.size();
+            if (helpers > level.size() - 1) helpers = level.size() - 1;
+            for (size_t i = 0; i < helpers; ++i) workAvailable.signal();
+
+            helpWithLevel();
+            levelDone.wait();
+            activePasses.store(nullptr, std::memory_order_release);
+        }
+
+        // The last pass added is the graph's sink; copy it out once.
+        AudioBufferList* sink = passBuffers.back();
+        uint32_t channels = output->mNumberBuffers;
+        if (channels > sink->mNumberBuffers) channels = sink->mNumberBuffers;
+        for (uint32_t ch = 0; ch < channels; ++ch) {
+            if (output->mBuffers[ch].mData == nullptr) {
+                output->mBuffers[ch].mData = sink->mBuffers[ch].mData;
+                output->mBuffers[ch].mDataByteSize = frameCount * sizeof(float);
+            } else {
+                memcpy(output->mBuffers[ch].mData, sink->mBuffers[ch].mData,
+                       frameCount * sizeof(float));
+            }
+        }
+    }
+
+    // See akRenderGraphPrewarm: silent quanta through every pass, output
+    // thrown away, so first-render lazy work (pass-buffer and node-state
+    // page faults, cold caches and branch predictors) happens behind the
+    // loading screen instead of on the first audible quantum.
+    void prewarm(uint32_t quanta) {
+        if (passes.empty() || channelCount == 0 || maxFrames == 0) return;
+
+        size_t listBytes = offsetof(AudioBufferList, mBuffers) +
+                           channelCount * sizeof(AudioBuffer);
+        std::vector<float> sinkData(size_t(channelCount) * maxFrames, 0.0f);
+        std::vector<uint8_t> listStorage(listBytes, 0);
+        auto* list = (AudioBufferList*)listStorage.data();
+        list->mNumberBuffers = channelCount;
+        for (uint32_t ch = 0; ch < channelCount; ++ch) {
+            list->mBuffers[ch].mNumberChannels = 1;
+            list->mBuffers[ch].mDataByteSize = maxFrames * sizeof(float);
+            list->mBuffers[ch].mData = sinkData.data() + size_t(ch) * maxFrames;
+        }
+
+        for (auto& node : nodes) node.dsp->setOfflineMode(true);
+
+        AudioTimeStamp timestamp = {};
+        timestamp.mFlags = kAudioTimeStampSampleTimeValid;
+        for (uint32_t q = 0; q < quanta; ++q) {
+            timestamp.mSampleTime = double(q) * maxFrames;
+            render(&timestamp, maxFrames, list);
+        }
+
+        for (auto& node : nodes) {
+            node.dsp->setOfflineMode(false);
+            // silent input leaves delay lines and reverb tails near zero,
+            // but reset anyway so warmup provably leaves no audible residue
+            node.dsp->reset();
+        }
+    }
+
+    bool bounce(const char* path, double sampleRate, uint64_t totalFrames,
+                void (*progress)(double, void*), void* context) {
+        if (passes.empty() || channelCount == 0 || path == nullptr) return false;
+
+        // 32-bit float WAV; the client format stays planar so quanta go to
+        // the converter straight from the slot planes, no interleave pass.
+        AudioStreamBasicDescription fileFormat = {};
+        fileFormat.mSampleRate = sampleRate;
+        fileFormat.mFormatID = kAudioFormatLinearPCM;
+        fileFormat.mFormatFlags = kAudioFormatFlagIsFloat | kAudioFormatFlagIsPacked;
+        fileFormat.mBitsPerChannel = 32;
+        fileFormat.mChannelsPerFrame = channelCount;
+        fileFormat.mBytesPerFrame = channelCount * sizeof(float);
+        fileFormat.mFramesPerPacket = 1;
+        fileFormat.mBytesPerPacket = fileFormat.mBytesPerFrame;
+
+        AudioStreamBasicDescription clientFormat = fileFormat;
+        clientFormat.mFormatFlags |= kAudioFormatFlagIsNonInterleaved;
+        clientFormat.mBytesPerFrame = sizeof(float);
+        clientFormat.mBytesPerPacket = sizeof(float);
+
+        CFURLRef url = CFURLCreateFromFileSystemRepresentation(
+            nullptr, (const UInt8*)path, strlen(path), false);
+        if (url == nullptr) return false;
+        ExtAudioFileRef file = nullptr;
+        OSStatus status = ExtAudioFileCreateWithURL(url, kAudioFileWAVEType, &fileFormat,
+                                                    nullptr, kAudioFileFlags_EraseFile, &file);
+        CFRelease(url);
+        if (status != noErr) return false;
+        status = ExtAudioFileSetProperty(file, kExtAudioFileProperty_ClientDataFormat,
+                                         sizeof(clientFormat), &clientFormat);
+        if (status != noErr) {
+            ExtAudioFileDispose(file);
+            return false;
+        }
+
+        // Two staging slots: the graph renders quantum q while the writer
+        // thread flushes quantum q-1. Ownership of a slot alternates through
+        // the semaphore pair, so neither thread touches a slot in flight.
+        struct WriteSlot {
+            std::vector<float> data;
+            std::vector<uint8_t> listStorage;
+            uint32_t frames = 0;
+        };
+        WriteSlot slots[2];
+        size_t listBytes = offsetof(AudioBufferList, mBuffers) +
+                           channelCount * sizeof(AudioBuffer);
+        for (auto& slot : slots) {
+            slot.data.assign(size_t(channelCount) * maxFrames, 0.0f);
+            slot.listStorage.assign(listBytes, 0);
+            auto* list = (AudioBufferList*)slot.listStorage.data();
+            list->mNumberBuffers = channelCount;
+            for (uint32_t ch = 0; ch < channelCount; ++ch) {
+                list->mBuffers[ch].mNumberChannels = 1;
+                list->mBuffers[ch].mData = slot.data.data() + size_t(ch) * maxFrames;
+            }
+        }
+
+        std::atomic<bool> writerFailed{false};
+        std::atomic<bool> writerStop{false};
+        Semaphore slotReady;
+        Semaphore slotFree;
+        slotFree.signal();
+        slotFree.signal();
+
+        std::thread writer([&] {
+            uint64_t q = 0;
+            while (true) {
+                slotReady.wait();
+                if (writerStop.load()) return;
+                WriteSlot& slot = slots[q++ % 2];
+                if (!writerFailed.load() &&
+                    ExtAudioFileWrite(file, slot.frames,
+                                      (AudioBufferList*)slot.listStorage.data()) != noErr) {
+                    writerFailed.store(true);
+                }
+                slotFree.signal();
+            }
+        });
+
+        // Offline mode for the duration: parameter updates snap instead of
+        // dezippering, so nodes keep their block fast paths across the large
+        // quanta.
+        for (auto& node : nodes) node.dsp->setOfflineMode(true);
+
+        AudioTimeStamp timestamp = {};
+        timestamp.mFlags = kAudioTimeStampSampleTimeValid;
+
+        uint64_t rendered = 0;
+        uint64_t quantum = 0;
+        while (rendered < totalFrames && !writerFailed.load()) {
+            uint32_t frames = maxFrames;
+            if (totalFrames - rendered < frames) frames = uint32_t(totalFrames - rendered);
+
+            slotFree.wait();
+            WriteSlot& slot = slots[quantum % 2];
+            auto* list = (AudioBufferList*)slot.listStorage.data();
+            for (uint32_t ch = 0; ch < channelCount; ++ch) {
+                list->mBuffers[ch].mDataByteSize = frames * sizeof(float);
+            }
+
+            timestamp.mSampleTime = double(rendered);
+            render(&timestamp, frames, list);
+            slot.frames = frames;
+            slotReady.signal();
+
+            rendered += frames;
+            ++quantum;
+            if (progress) progress(double(rendered) / double(totalFrames), context);
+        }
+
+        // Both slots free again means every queued write has landed.
+        slotFree.wait();
+        slotFree.wait();
+        writerStop.store(true);
+        slotReady.signal();
+        writer.join();
+
+        for (auto& node : nodes) node.dsp->setOfflineMode(false);
+        bool closed = ExtAudioFileDispose(file) == noErr;
+        return closed && !writerFailed.load();
+    }
+};
+
+RenderGraphRef akRenderGraphCreate(void) {
+    return new RenderGraphData;
+}
+
+void akRenderGraphDestroy(RenderGraphRef graph) {
+    delete graph;
+}
+
+int akRenderGraphAddNode(RenderGraphRef graph, DSPRef dsp,
+                         const int* inputNodes, size_t inputCount) {
+    return graph->addNode(dsp, inputNodes, inputCount);
+}
+
+bool akRenderGraphCompile(RenderGraphRef graph, uint32_t channelCount,
+                          uint32_t maxFrames, int workerCount) {
+    return graph->compile(channelCount, maxFrames, workerCount);
+}
+
+size_t akRenderGraphPassCount(RenderGraphRef graph) {
+    return graph->passes.size();
+}
+
+void akRenderGraphRender(RenderGraphRef graph, const AudioTimeStamp* timestamp,
+                         uint32_t frameCount, AudioBufferList* output) {
+    graph->render(timestamp, frameCount, output);
+}
+
+void akRenderGraphPrewarm(RenderGraphRef graph, uint32_t quanta) {
+    graph->prewarm(quanta);
+}
+
+bool akRenderGraphBounce(RenderGraphRef graph, const char* path,
+                         double sampleRate, uint64_t frameCount,
+                         void (*progress)(double, void*), void* context) {
+    return graph->bounce(path, sampleRate, frameCount, progress, context);
+}
@@ -0,0 +1,60 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+#pragma once
+
+#ifdef __cplusplus
+
+// N.B. This is C++.
+
+#import <AudioToolbox/AudioToolbox.h>
+
+#import <atomic>
+#import <mutex>
+
+/**
+ Process-wide pool of render scratch buffers, keyed by (channelCount,
+ frameCapacity). In the pull-model render only the nodes along the active
+ pull path hold a scratch buffer at any instant, so a small shared pool
+ replaces one dedicated buffer per node and keeps the render working set
+ in cache.
+ */
+class ScratchBufferPool {
+public:
+
+    struct Slot {
+        AudioBufferList *bufferList;
+        float *data;
+        uint32_t channelCount;
+        uint32_t capacityFrames;
+        std::atomic_flag inUse = ATOMIC_FLAG_INIT;
+    };
+
+    static ScratchBufferPool &shared();
+
+    /// Notes one more potential user of (channelCount, maxFrames) buffers and
+    /// grows the pool toward the expected concurrent demand. Call from
+    /// allocateRenderResources, not from the render thread.
+    void reserve(uint32_t channelCount, uint32_t maxFrames);
+
+    /// Render-thread checkout: claims a free slot matching the key, growing
+    /// the pool if the pull path is nested more deeply than reserve
+    /// anticipated. Returns nullptr only when the pool is full.
+    Slot *acquire(uint32_t channelCount, uint32_t frameCount);
+
+    /// Returns a slot claimed by acquire. Render-thread safe.
+    void release(Slot *slot);
+
+private:
+
+    Slot *addSlot(uint32_t channelCount, uint32_t capacityFrames);
+
+    /// Slots preallocated per key; covers the typical simultaneous pull depth.
+    static constexpr int initialSlotsPerKey = 8;
+
+    static constexpr int maxSlots = 256;
+    Slot *slots[maxSlots] = {nullptr};
+    std::atomic<int> slotCount{0};
+    std::mutex growthMutex;
+};
+
+#endif
@@ -0,0 +1,85 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+#import "ScratchBufferPool.h"
+#import "MemoryTracker.h"
+
+#import <cstdlib>
+
+ScratchBufferPool &ScratchBufferPool::shared()
+{
+    // Leaked intentionally: render threads can outlive static destruction.
+    static ScratchBufferPool *pool = new ScratchBufferPool;
+    return *pool;
+}
+
+ScratchBufferPool::Slot *ScratchBufferPool::addSlot(uint32_t channelCount, uint32_t capacityFrames)
+{
+    // Called with growthMutex held. Slots are only ever appended, and the
+    // count is published with release semantics, so render threads can scan
+    // the array without locking.
+    int index = slotCount.load(std::memory_order_relaxed);
+    if (index >= maxSlots || channelCount == 0) return nullptr;
+
+    auto slot = new Slot;
+    slot->channelCount = channelCount;
+    slot->capacityFrames = capacityFrames;
+    slot->data = (float *)calloc((size_t)channelCount * capacityFrames, sizeof(float));
+    slot->bufferList = (AudioBufferList *)malloc(sizeof(AudioBufferList)
+                                                 + (channelCount - 1) * sizeof(AudioBuffer));
+    slot->bufferList->mNumberBuffers = channelCount;
+    for (uint32_t ch = 0; ch < channelCount; ch++) {
+        slot->bufferList->mBuffers[ch].mNumberChannels = 1;
+        slot->bufferList->mBuffers[ch].mData = slot->data + (size_t)ch * capacityFrames;
+        slot->bufferList->mBuffers[ch].mDataByteSize = capacityFrames * sizeof(float);
+    }
+
+    // slots live for the process, so there is no matching negative report
+    akMemoryTrack(AKMemoryScratchBuffers, "ScratchBufferPool",
+                  (int64_t)channelCount * capacityFrames * sizeof(float)
+                  + (int64_t)(sizeof(AudioBufferList) + (channelCount - 1) * sizeof(AudioBuffer)));
+
+    slots[index] = slot;
+    slotCount.store(index + 1, std::memory_order_release);
+    return slot;
+}
+
+void ScratchBufferPool::reserve(uint32_t channelCount, uint32_t maxFrames)
+{
+    std::lock_guard<std::mutex> lock(growthMutex);
+
+    int matching = 0;
+    int count = slotCount.load(std::memory_order_acquire);
+    for (int i = 0; i < count; i++) {
+        if (slots[i]->channelCount == channelCount && slots[i]->capacityFrames >= maxFrames) {
+            matching++;
+        }
+    }
+    if (matching < initialSlotsPerKey) {
+        addSlot(channelCount, maxFrames);
+    }
+}
+
+ScratchBufferPool::Slot *ScratchBufferPool::acquire(uint32_t channelCount, uint32_t frameCount)
+{
+    int count = slotCount.load(std::memory_order_acquire);
+    for (int i = 0; i < count; i++) {
+        Slot *slot = slots[i];
+        if (slot->channelCount == channelCount && slot->capacityFrames >= frameCount &&
+            !slot->inUse.test_and_set(std::memory_order_acquire)) {
+            return slot;
+        }
+    }
+
+    // The pull path is nested more deeply than reserve anticipated; grow once.
+    // This allocates on the render thread (not ideal), but only the first time
+    // the depth is reached; later renders reuse the new slot.
+    std::lock_guard<std::mutex> lock(growthMutex);
+    Slot *slot = addSlot(channelCount, frameCount);
+    if (slot) slot->inUse.test_and_set(std::memory_order_acquire);
+    return slot;
+}
+
+void ScratchBufferPool::release(Slot *slot)
+{
+    slot->inUse.clear(std::memory_order_release);
+}
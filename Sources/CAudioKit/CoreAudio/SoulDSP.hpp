@@ -5,6 +5,8 @@
 
 #import "DSPBase.h"
 
+#include <cstring>
+
 template<typename SoulPatchType>
 class SoulDSP : public DSPBase {
 
@@ -81,9 +83,93 @@ public:
         patch.render(context);
         
         midiMessages.clear();
-        
+
     }
-    
+
+};
+
+/// Stereo render path for mono stream-only SOUL patches (like the diode
+/// clipper). SoulDSP renders a single patch instance into channel 0 and
+/// leaves the other channels silent; this runs one instance per channel and
+/// moves stream frames between our AudioBufferList and the generated state's
+/// frame arrays with memcpy, skipping render()'s per-sample interleave
+/// helpers and MIDI staging. The patch's own oversampling stays inside the
+/// generated run() untouched.
+template<typename SoulPatchType>
+class StereoSoulDSP : public DSPBase {
+
+public:
+    SoulPatchType patches[2];
+
+    using ParameterList = typename SoulPatchType::ParameterList;
+
+    ParameterList paramLists[2];
+
+    StereoSoulDSP() {
+        for (int i = 0; i < 2; ++i) {
+            paramLists[i] = patches[i].createParameterList();
+        }
+    }
+
+    void setParameter(AUParameterAddress address, float value, bool immediate) override {
+        for (int i = 0; i < 2; ++i) {
+            if (address < paramLists[i].size()) {
+                paramLists[i][address].setValue(value);
+            }
+        }
+    }
+
+    void init(int channelCount, double sampleRate) override {
+        for (int i = 0; i < 2; ++i) {
+            patches[i].init(sampleRate, /*sessionID*/ 0);
+
+            // init will clear the properties, so set them back to their value
+            for (auto& param : paramLists[i]) {
+                param.setValue(param.getValue());
+            }
+        }
+    }
+
+    void reset() override {
+        for (int i = 0; i < 2; ++i) {
+            patches[i].reset();
+        }
+    }
+
+    void startRamp(const AUParameterEvent &event) override {
+        setParameter(event.parameterAddress, event.value, true);
+    }
+
+    void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        int renderChannels = channelCount < 2 ? channelCount : 2;
+
+        for (int channel = renderChannels; channel < channelCount; ++channel) {
+            float *outputChannel = ((float *)outputBufferList->mBuffers[channel].mData) + bufferOffset;
+            std::fill(outputChannel, outputChannel + frameCount, 0.0f);
+        }
+
+        for (int channel = 0; channel < renderChannels; ++channel) {
+            auto& patch = patches[channel];
+            const float *in = ((const float *)inputBufferLists[0]->mBuffers[channel].mData) + bufferOffset;
+            float *out = ((float *)outputBufferList->mBuffers[channel].mData) + bufferOffset;
+
+            uint32_t startFrame = 0;
+            while (startFrame < frameCount) {
+                auto framesRemaining = frameCount - startFrame;
+                auto numFramesToDo = framesRemaining < SoulPatchType::maxBlockSize ? framesRemaining : SoulPatchType::maxBlockSize;
+
+                patch.prepare(numFramesToDo);
+                memcpy(patch._getInputFrameArrayRef_audioIn(patch.state).elements,
+                       in + startFrame, numFramesToDo * sizeof(float));
+                patch.advance();
+                memcpy(out + startFrame,
+                       patch._getOutputFrameArrayRef_audioOut(patch.state).elements,
+                       numFramesToDo * sizeof(float));
+                startFrame += numFramesToDo;
+            }
+        }
+    }
+
 };
 
 #endif /* SoulDSP_hpp */
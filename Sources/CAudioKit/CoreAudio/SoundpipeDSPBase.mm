@@ -1,6 +1,7 @@
 // Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
 
 #import "SoundpipeDSPBase.h"
+#import "DSPVectorOps.h"
 
 #include "soundpipe.h"
 #include "vocwrapper.h"
@@ -21,6 +22,50 @@ void SoundpipeDSPBase::processSample(int channel, float *in, float *out) {
     *out = *in;
 }
 
+// compatibility shim: subclasses that only implement processSample get the
+// same per-sample behavior when rendered through the block path
+void SoundpipeDSPBase::processChannel(int channel, float *in, float *out, AUAudioFrameCount frameCount) {
+    for (AUAudioFrameCount frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+        processSample(channel, in + frameIndex, out + frameIndex);
+    }
+}
+
+void SoundpipeDSPBase::processStereoBlock(float *inLeft, float *inRight, float *outLeft,
+                                          float *outRight, AUAudioFrameCount frameCount) {
+    processChannel(0, inLeft, outLeft, frameCount);
+    processChannel(1, inRight, outRight, frameCount);
+}
+
+void SoundpipeDSPBase::processBlock(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) {
+    if (!bUsesChannelBlocks && !bUsesStereoBlocks) {
+        DSPBase::processBlock(frameCount, bufferOffset);
+        return;
+    }
+    if (bUsesStereoBlocks && channelCount == 2) {
+        float *inLeft   = (float *)inputBufferLists[0]->mBuffers[0].mData + bufferOffset;
+        float *inRight  = (float *)inputBufferLists[0]->mBuffers[1].mData + bufferOffset;
+        float *outLeft  = (float *)outputBufferList->mBuffers[0].mData + bufferOffset;
+        float *outRight = (float *)outputBufferList->mBuffers[1].mData + bufferOffset;
+        if (isStarted) {
+            processStereoBlock(inLeft, inRight, outLeft, outRight, frameCount);
+        } else {
+            if (inLeft != outLeft) AudioKitCore::vCopy(inLeft, outLeft, frameCount);
+            if (inRight != outRight) AudioKitCore::vCopy(inRight, outRight, frameCount);
+        }
+        return;
+    }
+    for (int channel = 0; channel < channelCount; ++channel) {
+        float *in  = (float *)inputBufferLists[0]->mBuffers[channel].mData  + bufferOffset;
+        float *out = (float *)outputBufferList->mBuffers[channel].mData + bufferOffset;
+
+        if (isStarted) {
+            processChannel(channel, in, out, frameCount);
+        } else if (in != out) {
+            AudioKitCore::vCopy(in, out, frameCount);
+        }
+    }
+}
+
 void SoundpipeDSPBase::process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) {
     for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
         int frameOffset = int(frameIndex + bufferOffset);
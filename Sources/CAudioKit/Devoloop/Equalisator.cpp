@@ -32,6 +32,30 @@ float Equalisator::filter(float in0) {
     return yn;
 }
 
+void Equalisator::filter_block(const float *pInput, float *pOutput,
+                               int nFrames) {
+    // same recurrence as filter(), with coeffs and history held in locals
+    // for the whole block; in-place filtering is fine
+    float const b0 = b0a0, b1 = b1a0, b2 = b2a0;
+    float const a1 = a1a0, a2 = a2a0;
+    float x1 = in1, x2 = in2, y1 = ou1, y2 = ou2;
+
+    for (int i = 0; i < nFrames; i++) {
+        float const x0 = pInput[i];
+        float const yn = b0 * x0 + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;
+        x2 = x1;
+        x1 = x0;
+        y2 = y1;
+        y1 = yn;
+        pOutput[i] = yn;
+    }
+
+    in1 = x1;
+    in2 = x2;
+    ou1 = y1;
+    ou2 = y2;
+}
+
 void Equalisator::calc_filter_coeffs(int const type, double const frequency,
                                      double const sample_rate, double const q,
                                      double const db_gain,
@@ -34,3 +34,27 @@ float RageProcessor::doRage(float fCurrentSample, float fKhorne,
     }
     return filterToneZ.filter(f_xn);
 }
+
+void RageProcessor::doRageBlock(const float *pInput, float *pOutput,
+                                int nFrames, float fKhorne, float fNurgle) {
+    // the atan normalisation terms depend only on the drive knobs, so they
+    // move out of the sample loop
+    float const fKhorneInv = 1.0f / atanf(fKhorne);
+    float const fNurgleInv = 1.0f / atanf(fNurgle);
+
+    for (int i = 0; i < nFrames; i++) {
+        float f_xn = pInput[i];
+
+        for (int s = 0; s < iNumStages; s++) {
+            if (f_xn >= 0)
+                f_xn = fKhorneInv * atanf(fKhorne * f_xn);
+            else
+                f_xn = fNurgleInv * atanf(fNurgle * f_xn);
+
+            // Invert every other stage
+            if (s % 2 == 0)
+                f_xn *= -1.0f;
+        }
+        pOutput[i] = filterToneZ.filter(f_xn);
+    }
+}
@@ -15,6 +15,7 @@ public:
                             double const sample_rate, double const q,
                             double const db_gain, bool q_is_bandwidth);
     float filter(float in0);
+    void filter_block(const float *pInput, float *pOutput, int nFrames);
 
 private:
     // filter coeffs
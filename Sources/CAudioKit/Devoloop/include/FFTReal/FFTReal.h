@@ -24,6 +24,7 @@ http://sam.zoy.org/wtfpl/COPYING for more details.
 
 
 #include "DynArray.h"
+#include "FFTRealSharedTables.h"
 #include "OscSinCos.h"
 #include "def.h"
 
@@ -51,13 +52,10 @@ private:
 
   typedef OscSinCos<DataType> OscType;
 
-  void init_br_lut();
-  void init_trigo_lut();
   void init_trigo_osc();
 
   ffft_FORCEINLINE const long *get_br_ptr() const;
   ffft_FORCEINLINE const DataType *get_trigo_ptr(int level) const;
-  ffft_FORCEINLINE long get_trigo_level_index(int level) const;
 
   inline void compute_fft_general(DataType f[], const DataType x[]) const;
   inline void compute_direct_pass_1_2(DataType df[], const DataType x[]) const;
@@ -81,8 +79,9 @@ private:
 
   const long _length;
   const int _nbr_bits;
-  DynArray<long> _br_lut;
-  DynArray<DataType> _trigo_lut;
+  // Bit-reversal and trig tables, shared with every other FFTReal of the
+  // same length
+  typename FFTRealSharedTables<DataType>::SPtr _tables;
   mutable DynArray<DataType> _buffer;
   mutable DynArray<OscType> _trigo_osc;
 
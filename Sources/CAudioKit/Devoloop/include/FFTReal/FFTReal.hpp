@@ -67,13 +67,12 @@ of 2 only, > 0. Throws: std::bad_alloc
 
 template <class DT>
 FFTReal<DT>::FFTReal(long length)
-    : _length(length), _nbr_bits(FFTReal_get_next_pow2(length)), _br_lut(),
-      _trigo_lut(), _buffer(length), _trigo_osc() {
+    : _length(length), _nbr_bits(FFTReal_get_next_pow2(length)),
+      _tables(FFTRealSharedTables<DT>::use(FFTReal_get_next_pow2(length))),
+      _buffer(length), _trigo_osc() {
   assert(FFTReal_is_pow2(length));
   assert(_nbr_bits <= MAX_BIT_DEPTH);
 
-  init_br_lut();
-  init_trigo_lut();
   init_trigo_osc();
 }
 
@@ -255,42 +254,6 @@ typename FFTReal<DT>::DataType *FFTReal<DT>::use_buffer() const {
 
 
 
-template <class DT> void FFTReal<DT>::init_br_lut() {
-  const long length = 1L << _nbr_bits;
-  _br_lut.resize(length);
-
-  _br_lut[0] = 0;
-  long br_index = 0;
-  for (long cnt = 1; cnt < length; ++cnt) {
-    // ++br_index (bit reversed)
-    long bit = length >> 1;
-    while (((br_index ^= bit) & bit) == 0) {
-      bit >>= 1;
-    }
-
-    _br_lut[cnt] = br_index;
-  }
-}
-
-template <class DT> void FFTReal<DT>::init_trigo_lut() {
-  using namespace std;
-
-  if (_nbr_bits > 3) {
-    const long total_len = (1L << (_nbr_bits - 1)) - 4;
-    _trigo_lut.resize(total_len);
-
-    for (int level = 3; level < _nbr_bits; ++level) {
-      const long level_len = 1L << (level - 1);
-      DataType *const level_ptr = &_trigo_lut[get_trigo_level_index(level)];
-      const double mul = PI / (level_len << 1);
-
-      for (long i = 0; i < level_len; ++i) {
-        level_ptr[i] = static_cast<DataType>(cos(i * mul));
-      }
-    }
-  }
-}
-
 template <class DT> void FFTReal<DT>::init_trigo_osc() {
   const int nbr_osc = _nbr_bits - TRIGO_BD_LIMIT;
   if (nbr_osc > 0) {
@@ -307,21 +270,13 @@ template <class DT> void FFTReal<DT>::init_trigo_osc() {
 }
 
 template <class DT> const long *FFTReal<DT>::get_br_ptr() const {
-  return (&_br_lut[0]);
+  return (_tables->get_br_ptr());
 }
 
 template <class DT>
 const typename FFTReal<DT>::DataType *
 FFTReal<DT>::get_trigo_ptr(int level) const {
-  assert(level >= 3);
-
-  return (&_trigo_lut[get_trigo_level_index(level)]);
-}
-
-template <class DT> long FFTReal<DT>::get_trigo_level_index(int level) const {
-  assert(level >= 3);
-
-  return ((1L << (level - 1)) - 4);
+  return (_tables->get_trigo_ptr(level));
 }
 
 // Transform in several passes
@@ -64,13 +64,17 @@ private:
   enum { NBR_TRIGO_OSC = FFT_LEN_L2 - TRIGO_BD };
   enum { TRIGO_OSC_ARR_SIZE = (NBR_TRIGO_OSC > 0) ? NBR_TRIGO_OSC : 1 };
 
-  void build_br_lut();
-  void build_trigo_lut();
+  // Tables are immutable once built, so every instance of a given length
+  // shares one copy (function-local statics)
+  static const long *use_br_lut();
+  static const DataType *use_trigo_lut();
+  static void build_br_lut(DynArray<long> &br_data);
+  static void build_trigo_lut(DynArray<DataType> &trigo_data);
   void build_trigo_osc();
 
   DynArray<DataType> _buffer;
-  DynArray<long> _br_data;
-  DynArray<DataType> _trigo_data;
+  const long *const _br_data;
+  const DataType *const _trigo_data;
   Array<OscType, TRIGO_OSC_ARR_SIZE> _trigo_osc;
 
 
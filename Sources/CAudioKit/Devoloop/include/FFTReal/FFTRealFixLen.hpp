@@ -37,10 +37,8 @@ namespace ffft {
 
 template <int LL2>
 FFTRealFixLen<LL2>::FFTRealFixLen()
-    : _buffer(FFT_LEN), _br_data(BR_ARR_SIZE),
-      _trigo_data(TRIGO_TABLE_ARR_SIZE), _trigo_osc() {
-  build_br_lut();
-  build_trigo_lut();
+    : _buffer(FFT_LEN), _br_data(use_br_lut()),
+      _trigo_data(use_trigo_lut()), _trigo_osc() {
   build_trigo_osc();
 }
 
@@ -57,8 +55,8 @@ void FFTRealFixLen<LL2>::do_fft(DataType f[], const DataType x[]) {
   assert(FFT_LEN_L2 >= 3);
 
   // Do the transform in several passes
-  const DataType *cos_ptr = &_trigo_data[0];
-  const long *br_ptr = &_br_data[0];
+  const DataType *cos_ptr = _trigo_data;
+  const long *br_ptr = _br_data;
 
   FFTRealPassDirect<FFT_LEN_L2 - 1>::process(FFT_LEN, f, &_buffer[0], x,
                                              cos_ptr, TRIGO_TABLE_ARR_SIZE,
@@ -113,8 +111,8 @@ void FFTRealFixLen<LL2>::do_ifft(const DataType f[], DataType x[]) {
   // Do the transform in several passes
   DataType *s_ptr = FFTRealSelect<FFT_LEN_L2 & 1>::sel_bin(&_buffer[0], x);
   DataType *d_ptr = FFTRealSelect<FFT_LEN_L2 & 1>::sel_bin(x, &_buffer[0]);
-  const DataType *cos_ptr = &_trigo_data[0];
-  const long *br_ptr = &_br_data[0];
+  const DataType *cos_ptr = _trigo_data;
+  const long *br_ptr = _br_data;
 
   FFTRealPassInverse<FFT_LEN_L2 - 1>::process(FFT_LEN, d_ptr, s_ptr, f, cos_ptr,
                                               TRIGO_TABLE_ARR_SIZE, br_ptr,
@@ -190,8 +188,31 @@ template <int LL2> void FFTRealFixLen<LL2>::rescale(DataType x[]) const {
 
 
 
-template <int LL2> void FFTRealFixLen<LL2>::build_br_lut() {
-  _br_data[0] = 0;
+template <int LL2> const long *FFTRealFixLen<LL2>::use_br_lut() {
+  struct Holder {
+    Holder() : _arr(BR_ARR_SIZE) { build_br_lut(_arr); }
+    DynArray<long> _arr;
+  };
+  static const Holder holder;
+
+  return (&holder._arr[0]);
+}
+
+template <int LL2>
+const typename FFTRealFixLen<LL2>::DataType *
+FFTRealFixLen<LL2>::use_trigo_lut() {
+  struct Holder {
+    Holder() : _arr(TRIGO_TABLE_ARR_SIZE) { build_trigo_lut(_arr); }
+    DynArray<DataType> _arr;
+  };
+  static const Holder holder;
+
+  return (&holder._arr[0]);
+}
+
+template <int LL2>
+void FFTRealFixLen<LL2>::build_br_lut(DynArray<long> &br_data) {
+  br_data[0] = 0;
   for (long cnt = 1; cnt < BR_ARR_SIZE; ++cnt) {
     long index = cnt << 2;
     long br_index = 0;
@@ -205,16 +226,17 @@ template <int LL2> void FFTRealFixLen<LL2>::build_br_lut() {
       --bit_cnt;
     } while (bit_cnt > 0);
 
-    _br_data[cnt] = br_index;
+    br_data[cnt] = br_index;
   }
 }
 
-template <int LL2> void FFTRealFixLen<LL2>::build_trigo_lut() {
+template <int LL2>
+void FFTRealFixLen<LL2>::build_trigo_lut(DynArray<DataType> &trigo_data) {
   const double mul = (0.5 * PI) / TRIGO_TABLE_ARR_SIZE;
   for (long i = 0; i < TRIGO_TABLE_ARR_SIZE; ++i) {
     using namespace std;
 
-    _trigo_data[i] = DataType(cos(i * mul));
+    trigo_data[i] = DataType(cos(i * mul));
   }
 }
 
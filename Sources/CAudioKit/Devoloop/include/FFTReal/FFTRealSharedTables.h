@@ -0,0 +1,74 @@
+/*****************************************************************************
+
+        FFTRealSharedTables.h
+
+Immutable bit-reversal and trigonometric tables for FFTReal, shared between
+every FFTReal instance of the same length. Tables are built on first use of
+a length and released when the last FFT object using them goes away.
+
+--- Legal stuff ---
+
+This program is free software. It comes without any warranty, to
+the extent permitted by applicable law. You can redistribute it
+and/or modify it under the terms of the Do What The Fuck You Want
+To Public License, Version 2, as published by Sam Hocevar. See
+http://sam.zoy.org/wtfpl/COPYING for more details.
+
+*Tab=3***********************************************************************/
+
+#if !defined(ffft_FFTRealSharedTables_HEADER_INCLUDED)
+#define ffft_FFTRealSharedTables_HEADER_INCLUDED
+
+#if defined(_MSC_VER)
+#pragma once
+#pragma warning(4 : 4250) // "Inherits via dominance."
+#endif
+
+
+
+#include "DynArray.h"
+#include "def.h"
+
+#include <memory>
+
+namespace ffft {
+
+template <class DT> class FFTRealSharedTables {
+
+public:
+  typedef DT DataType;
+  typedef std::shared_ptr<const FFTRealSharedTables<DT> > SPtr;
+
+  // Returns the table set for the given FFT size (2 ^ nbr_bits), building
+  // it if no living FFT object uses that size yet.
+  static SPtr use(int nbr_bits);
+
+  ffft_FORCEINLINE const long *get_br_ptr() const;
+  ffft_FORCEINLINE const DataType *get_trigo_ptr(int level) const;
+  ffft_FORCEINLINE static long get_trigo_level_index(int level);
+
+private:
+  explicit FFTRealSharedTables(int nbr_bits);
+
+  void init_br_lut();
+  void init_trigo_lut();
+
+  const int _nbr_bits;
+  DynArray<long> _br_lut;
+  DynArray<DataType> _trigo_lut;
+
+  FFTRealSharedTables();
+  FFTRealSharedTables(const FFTRealSharedTables &other);
+  FFTRealSharedTables &operator=(const FFTRealSharedTables &other);
+  bool operator==(const FFTRealSharedTables &other);
+  bool operator!=(const FFTRealSharedTables &other);
+
+};
+
+}
+
+#include "FFTRealSharedTables.hpp"
+
+#endif
+
+
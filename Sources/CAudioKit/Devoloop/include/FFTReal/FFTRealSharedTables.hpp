@@ -0,0 +1,132 @@
+/*****************************************************************************
+
+        FFTRealSharedTables.hpp
+
+--- Legal stuff ---
+
+This program is free software. It comes without any warranty, to
+the extent permitted by applicable law. You can redistribute it
+and/or modify it under the terms of the Do What The Fuck You Want
+To Public License, Version 2, as published by Sam Hocevar. See
+http://sam.zoy.org/wtfpl/COPYING for more details.
+
+*Tab=3***********************************************************************/
+
+#if defined(ffft_FFTRealSharedTables_CURRENT_CODEHEADER)
+#error Recursive inclusion of FFTRealSharedTables code header.
+#endif
+#define ffft_FFTRealSharedTables_CURRENT_CODEHEADER
+
+#if !defined(ffft_FFTRealSharedTables_CODEHEADER_INCLUDED)
+#define ffft_FFTRealSharedTables_CODEHEADER_INCLUDED
+
+
+
+#include <cassert>
+#include <cmath>
+#include <map>
+#include <mutex>
+
+namespace ffft {
+
+/*
+==============================================================================
+Name: use
+Description:
+        Returns the shared table set for the requested FFT size. The cache
+        holds weak references only, so a table set lives exactly as long as
+        the FFT objects using it. Construction happens under a lock; this is
+        an init-time path, do_fft()/do_ifft() never touch it.
+Input parameters:
+        - nbr_bits: log2 of the FFT length. Range: > 0.
+Throws: std::bad_alloc
+==============================================================================
+*/
+
+template <class DT>
+typename FFTRealSharedTables<DT>::SPtr FFTRealSharedTables<DT>::use(int nbr_bits) {
+  static std::mutex cache_mutex;
+  static std::map<int, std::weak_ptr<const FFTRealSharedTables<DT> > > cache;
+
+  assert(nbr_bits > 0);
+
+  std::lock_guard<std::mutex> lock(cache_mutex);
+
+  SPtr sptr = cache[nbr_bits].lock();
+  if (!sptr) {
+    sptr = SPtr(new FFTRealSharedTables<DT>(nbr_bits));
+    cache[nbr_bits] = sptr;
+  }
+
+  return (sptr);
+}
+
+template <class DT>
+FFTRealSharedTables<DT>::FFTRealSharedTables(int nbr_bits)
+    : _nbr_bits(nbr_bits), _br_lut(), _trigo_lut() {
+  init_br_lut();
+  init_trigo_lut();
+}
+
+template <class DT> void FFTRealSharedTables<DT>::init_br_lut() {
+  const long length = 1L << _nbr_bits;
+  _br_lut.resize(length);
+
+  _br_lut[0] = 0;
+  long br_index = 0;
+  for (long cnt = 1; cnt < length; ++cnt) {
+    // ++br_index (bit reversed)
+    long bit = length >> 1;
+    while (((br_index ^= bit) & bit) == 0) {
+      bit >>= 1;
+    }
+
+    _br_lut[cnt] = br_index;
+  }
+}
+
+template <class DT> void FFTRealSharedTables<DT>::init_trigo_lut() {
+  using namespace std;
+
+  if (_nbr_bits > 3) {
+    const long total_len = (1L << (_nbr_bits - 1)) - 4;
+    _trigo_lut.resize(total_len);
+
+    for (int level = 3; level < _nbr_bits; ++level) {
+      const long level_len = 1L << (level - 1);
+      DataType *const level_ptr = &_trigo_lut[get_trigo_level_index(level)];
+      const double mul = PI / (level_len << 1);
+
+      for (long i = 0; i < level_len; ++i) {
+        level_ptr[i] = static_cast<DataType>(cos(i * mul));
+      }
+    }
+  }
+}
+
+template <class DT> const long *FFTRealSharedTables<DT>::get_br_ptr() const {
+  return (&_br_lut[0]);
+}
+
+template <class DT>
+const typename FFTRealSharedTables<DT>::DataType *
+FFTRealSharedTables<DT>::get_trigo_ptr(int level) const {
+  assert(level >= 3);
+
+  return (&_trigo_lut[get_trigo_level_index(level)]);
+}
+
+template <class DT>
+long FFTRealSharedTables<DT>::get_trigo_level_index(int level) {
+  assert(level >= 3);
+
+  return ((1L << (level - 1)) - 4);
+}
+
+}
+
+#endif
+
+#undef ffft_FFTRealSharedTables_CURRENT_CODEHEADER
+
+
@@ -12,6 +12,8 @@ class RageProcessor {
 public:
     RageProcessor(int iSampleRate);
     float doRage(float fCurrentSample, float fKhorne, float fNurgle);
+    void doRageBlock(const float *pInput, float *pOutput, int nFrames,
+                     float fKhorne, float fNurgle);
     MikeFilter filterToneZ;
     void setNumStages(int theStages);
     
@@ -33,11 +33,110 @@ typedef struct EZAudioFFTInfo
     float         *outFFTData;
     vDSP_Length    outFFTDataLength;
     float         *inversedFFTData;
+    BOOL           inversedFFTDataNeedsUpdate;
+    vDSP_Length    lastLog2n;
+    float         *displayData;
+    vDSP_Length    displayDataLength;
     vDSP_Length    maxFrequencyIndex;
     float          maxFrequencyMangitude;
     float          maxFrequency;
 } EZAudioFFTInfo;
 
+//------------------------------------------------------------------------------
+#pragma mark - Shared FFT Setup Cache
+//------------------------------------------------------------------------------
+
+//
+// vDSP FFT weights are read-only once created and identical for every
+// transform of the same length, so all EZAudioFFT instances share one
+// FFTSetup per log2n instead of each paying the creation cost and memory.
+// Entries are refcounted and destroyed when the last instance goes away.
+//
+
+typedef struct EZAudioFFTSetupCacheEntry
+{
+    vDSP_Length log2n;
+    FFTSetup    setup;
+    NSUInteger  retainCount;
+} EZAudioFFTSetupCacheEntry;
+
+static const size_t EZAudioFFTSetupCacheCapacity = 16;
+static EZAudioFFTSetupCacheEntry EZAudioFFTSetupCache[EZAudioFFTSetupCacheCapacity];
+static NSLock *EZAudioFFTSetupCacheLock;
+
+static FFTSetup EZAudioFFTRetainSharedSetup(vDSP_Length log2n)
+{
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        EZAudioFFTSetupCacheLock = [[NSLock alloc] init];
+    });
+
+    [EZAudioFFTSetupCacheLock lock];
+    FFTSetup setup = NULL;
+    for (size_t i = 0; i < EZAudioFFTSetupCacheCapacity; i++)
+    {
+        EZAudioFFTSetupCacheEntry *entry = &EZAudioFFTSetupCache[i];
+        if (entry->setup != NULL && entry->log2n == log2n)
+        {
+            entry->retainCount++;
+            setup = entry->setup;
+            break;
+        }
+    }
+    if (setup == NULL)
+    {
+        for (size_t i = 0; i < EZAudioFFTSetupCacheCapacity; i++)
+        {
+            EZAudioFFTSetupCacheEntry *entry = &EZAudioFFTSetupCache[i];
+            if (entry->setup == NULL)
+            {
+                entry->log2n = log2n;
+                entry->setup = vDSP_create_fftsetup(log2n, FFT_RADIX2);
+                entry->retainCount = 1;
+                setup = entry->setup;
+                break;
+            }
+        }
+    }
+    [EZAudioFFTSetupCacheLock unlock];
+
+    //
+    // The cache being full is effectively impossible (16 distinct FFT
+    // lengths live at once), but fall back to a private setup rather
+    // than fail.
+    //
+    return setup != NULL ? setup : vDSP_create_fftsetup(log2n, FFT_RADIX2);
+}
+
+static void EZAudioFFTReleaseSharedSetup(FFTSetup setup)
+{
+    if (setup == NULL)
+    {
+        return;
+    }
+    [EZAudioFFTSetupCacheLock lock];
+    BOOL cached = NO;
+    for (size_t i = 0; i < EZAudioFFTSetupCacheCapacity; i++)
+    {
+        EZAudioFFTSetupCacheEntry *entry = &EZAudioFFTSetupCache[i];
+        if (entry->setup == setup)
+        {
+            cached = YES;
+            if (--entry->retainCount == 0)
+            {
+                vDSP_destroy_fftsetup(entry->setup);
+                entry->setup = NULL;
+            }
+            break;
+        }
+    }
+    [EZAudioFFTSetupCacheLock unlock];
+    if (!cached)
+    {
+        vDSP_destroy_fftsetup(setup);
+    }
+}
+
 //------------------------------------------------------------------------------
 #pragma mark - EZAudioFFT (Interface Extension)
 //------------------------------------------------------------------------------
@@ -59,11 +158,12 @@ typedef struct EZAudioFFTInfo
 
 - (void)dealloc
 {
-    vDSP_destroy_fftsetup(self.info->fftSetup);
+    EZAudioFFTReleaseSharedSetup(self.info->fftSetup);
     free(self.info->complexA.realp);
     free(self.info->complexA.imagp);
     free(self.info->outFFTData);
     free(self.info->inversedFFTData);
+    free(self.info->displayData);
 }
 
 //------------------------------------------------------------------------------
@@ -131,7 +231,7 @@ typedef struct EZAudioFFTInfo
     float maximumBufferSizeBytes = self.maximumBufferSize * sizeof(float);
     self.info = (EZAudioFFTInfo *)calloc(1, sizeof(EZAudioFFTInfo));
     vDSP_Length log2n = log2f(self.maximumBufferSize);
-    self.info->fftSetup = vDSP_create_fftsetup(log2n, FFT_RADIX2);
+    self.info->fftSetup = EZAudioFFTRetainSharedSetup(log2n);
     long nOver2 = maximumBufferSizeBytes / 2;
     size_t maximumSizePerComponentBytes = nOver2 * sizeof(float);
     self.info->complexA.realp = (float *)malloc(maximumSizePerComponentBytes);
@@ -163,10 +263,16 @@ typedef struct EZAudioFFTInfo
     vDSP_vsmul(self.info->complexA.realp, 1, &mFFTNormFactor, self.info->complexA.realp, 1, nOver2);
     vDSP_vsmul(self.info->complexA.imagp, 1, &mFFTNormFactor, self.info->complexA.imagp, 1, nOver2);
     vDSP_zvmags(&(self.info->complexA), 1, self.info->outFFTData, 1, nOver2);
-    vDSP_fft_zrip(self.info->fftSetup, &(self.info->complexA), 1, log2n, FFT_INVERSE);
-    vDSP_ztoc(&(self.info->complexA), 1, (COMPLEX *) self.info->inversedFFTData , 2, nOver2);
     self.info->outFFTDataLength = nOver2;
 
+    //
+    // Defer the inverse FFT until someone actually reads inversedFFTData;
+    // spectrum views never do, so they no longer pay for a second full
+    // transform every frame.
+    //
+    self.info->inversedFFTDataNeedsUpdate = YES;
+    self.info->lastLog2n = log2n;
+
     //
     // Calculate max freq
     //
@@ -194,6 +300,46 @@ typedef struct EZAudioFFTInfo
 
 //------------------------------------------------------------------------------
 
+- (float *)computeFFTWithBuffer:(float *)buffer
+                 withBufferSize:(UInt32)bufferSize
+                displayBinCount:(vDSP_Length)displayBinCount
+{
+    float *fftData = [self computeFFTWithBuffer:buffer withBufferSize:bufferSize];
+    if (fftData == NULL || displayBinCount == 0)
+    {
+        return NULL;
+    }
+
+    //
+    // Lazily size the display buffer to the requested bin count
+    //
+    if (self.info->displayData == NULL || self.info->displayDataLength != displayBinCount)
+    {
+        free(self.info->displayData);
+        self.info->displayData = (float *)malloc(displayBinCount * sizeof(float));
+        self.info->displayDataLength = displayBinCount;
+    }
+
+    //
+    // Reduce the full magnitude spectrum down to the display resolution,
+    // keeping the peak of each bucket so narrow spectral lines stay visible
+    //
+    vDSP_Length fullBinCount = self.info->outFFTDataLength;
+    for (vDSP_Length bin = 0; bin < displayBinCount; bin++)
+    {
+        vDSP_Length start = bin * fullBinCount / displayBinCount;
+        vDSP_Length end = (bin + 1) * fullBinCount / displayBinCount;
+        if (end <= start)
+        {
+            end = MIN(start + 1, fullBinCount);
+        }
+        vDSP_maxv(fftData + start, 1, &self.info->displayData[bin], end - start);
+    }
+    return self.info->displayData;
+}
+
+//------------------------------------------------------------------------------
+
 - (float)frequencyAtIndex:(vDSP_Length)index
 {
     if (!(self.info->outFFTData == NULL || self.sampleRate == 0.0f))
@@ -242,6 +388,18 @@ typedef struct EZAudioFFTInfo
 
 - (float *)inversedFFTData
 {
+    //
+    // The spectrum from the last computeFFTWithBuffer:withBufferSize: is
+    // still sitting in complexA, so the inverse transform can run here on
+    // demand instead of unconditionally on every compute.
+    //
+    if (self.info->inversedFFTDataNeedsUpdate)
+    {
+        vDSP_Length nOver2 = self.info->outFFTDataLength;
+        vDSP_fft_zrip(self.info->fftSetup, &(self.info->complexA), 1, self.info->lastLog2n, FFT_INVERSE);
+        vDSP_ztoc(&(self.info->complexA), 1, (COMPLEX *)self.info->inversedFFTData, 2, nOver2);
+        self.info->inversedFFTDataNeedsUpdate = NO;
+    }
     return self.info->inversedFFTData;
 }
 
@@ -415,9 +573,10 @@ typedef struct EZAudioFFTInfo
                      toHistoryInfo:self.historyInfo];
 
     //
-    // Call super to calculate the FFT of the window
+    // Call super to calculate the FFT of the window; the FFT needs the
+    // window contiguous, so linearize it out of the history ring here
     //
-    return [super computeFFTWithBuffer:self.historyInfo->buffer
+    return [super computeFFTWithBuffer:[EZAudioUtilities windowForHistoryInfo:self.historyInfo]
                         withBufferSize:self.historyInfo->bufferSize];
 }
 
@@ -434,7 +593,7 @@ typedef struct EZAudioFFTInfo
 
 - (float *)timeDomainData
 {
-    return self.historyInfo->buffer;
+    return [EZAudioUtilities windowForHistoryInfo:self.historyInfo];
 }
 
 @end
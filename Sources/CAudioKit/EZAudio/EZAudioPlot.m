@@ -31,11 +31,29 @@ UInt32 const kEZAudioPlotDefaultHistoryBufferLength = 512;
 UInt32 const EZAudioPlotDefaultHistoryBufferLength = 512;
 UInt32 const EZAudioPlotDefaultMaxHistoryBufferLength = 8192;
 
+//
+// Bytes reserved for staging audio-thread updates between display-link
+// ticks; 64 kB holds roughly a third of a second of mono floats, ample
+// slack for a momentarily stalled main thread
+//
+static int const EZAudioPlotStagingBufferLength = 1 << 16;
+
 //------------------------------------------------------------------------------
 #pragma mark - EZAudioPlot (Implementation)
 //------------------------------------------------------------------------------
 
 @implementation EZAudioPlot
+{
+    //
+    // Wait-free single-producer single-consumer staging ring. The audio
+    // thread produces [UInt32 length][float samples...] records and the
+    // display-link tick consumes every staged record at most once per
+    // frame, so one cross-thread hand-off serves any number of audio
+    // callbacks
+    //
+    TPCircularBuffer stagingBuffer;
+    BOOL stagingBufferInitialized;
+}
 
 //------------------------------------------------------------------------------
 #pragma mark - Dealloc
@@ -45,6 +63,12 @@ UInt32 const EZAudioPlotDefaultMaxHistoryBufferLength = 8192;
 {
     [EZAudioUtilities freeHistoryInfo:self.historyInfo];
     free(self.points);
+    free(self.rollingMinimums);
+    free(self.rollingMaximums);
+    if (stagingBufferInitialized)
+    {
+        [EZAudioUtilities freeCircularBuffer:&stagingBuffer];
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -144,6 +168,8 @@ UInt32 const EZAudioPlotDefaultMaxHistoryBufferLength = 8192;
     [self setupPlot];
 
     self.points = calloc(EZAudioPlotDefaultMaxHistoryBufferLength, sizeof(CGPoint));
+    self.rollingMinimums = calloc(EZAudioPlotDefaultMaxHistoryBufferLength, sizeof(float));
+    self.rollingMaximums = calloc(EZAudioPlotDefaultMaxHistoryBufferLength, sizeof(float));
     self.pointCount = [self initialPointCount];
     [self redraw];
 }
@@ -214,6 +240,15 @@ UInt32 const EZAudioPlotDefaultMaxHistoryBufferLength = 8192;
     _shouldOptimizeForRealtimePlot = shouldOptimizeForRealtimePlot;
     if (shouldOptimizeForRealtimePlot && !self.displayLink)
     {
+        //
+        // The staging ring must exist before the display link can tick
+        //
+        if (!stagingBufferInitialized)
+        {
+            [EZAudioUtilities circularBuffer:&stagingBuffer
+                                    withSize:EZAudioPlotStagingBufferLength];
+            stagingBufferInitialized = YES;
+        }
         self.displayLink = [EZAudioDisplayLink displayLinkWithDelegate:self];
         [self.displayLink start];
     }
@@ -252,6 +287,10 @@ UInt32 const EZAudioPlotDefaultMaxHistoryBufferLength = 8192;
 
 - (void)redraw
 {
+    if (self.plotType == EZPlotTypeRolling)
+    {
+        [self updateRollingPoints];
+    }
     EZRect frame = [self.waveformLayer frame];
     CGPathRef path = [self createPathWithPoints:self.points
                                      pointCount:self.pointCount
@@ -339,7 +378,30 @@ UInt32 const EZAudioPlotDefaultMaxHistoryBufferLength = 8192;
 
 - (void)updateBuffer:(float *)buffer withBufferSize:(UInt32)bufferSize
 {
-    // append the buffer to the history
+    //
+    // With a display link driving the drawing, stage the samples and return.
+    // The audio thread does one bounded copy per callback and the next
+    // display-link tick drains everything staged since the last one, so the
+    // per-second UI cost depends on the display rate, not the audio callback
+    // rate. A full ring (stalled main thread) drops the record instead of
+    // blocking the audio thread.
+    //
+    if (self.shouldOptimizeForRealtimePlot && stagingBufferInitialized)
+    {
+        int32_t space;
+        void *head = TPCircularBufferHead(&stagingBuffer, &space);
+        int32_t recordBytes = (int32_t)(sizeof(UInt32) + bufferSize * sizeof(float));
+        if (head != NULL && space >= recordBytes)
+        {
+            memcpy(head, &bufferSize, sizeof(UInt32));
+            memcpy((char *)head + sizeof(UInt32), buffer, bufferSize * sizeof(float));
+            TPCircularBufferProduce(&stagingBuffer, recordBytes);
+        }
+        return;
+    }
+
+    // append the buffer to the history; O(frames appended), the rolling
+    // display reads the history's decimation pyramid at redraw time
     [EZAudioUtilities appendBufferRMS:buffer
                        withBufferSize:bufferSize
                         toHistoryInfo:self.historyInfo];
@@ -352,9 +414,7 @@ UInt32 const EZAudioPlotDefaultMaxHistoryBufferLength = 8192;
                          length:bufferSize];
             break;
         case EZPlotTypeRolling:
-
-            [self setSampleData:self.historyInfo->buffer
-                         length:self.historyInfo->bufferSize];
+            // points are rebuilt from the history pyramid in redraw
             break;
         default:
             break;
@@ -369,6 +429,91 @@ UInt32 const EZAudioPlotDefaultMaxHistoryBufferLength = 8192;
 
 //------------------------------------------------------------------------------
 
+- (void)drainStagedBuffers
+{
+    if (!stagingBufferInitialized)
+    {
+        return;
+    }
+
+    int32_t availableBytes;
+    char *tail = TPCircularBufferTail(&stagingBuffer, &availableBytes);
+    int32_t consumed = 0;
+    float *latestChunk = NULL;
+    UInt32 latestChunkSize = 0;
+    while (availableBytes - consumed >= (int32_t)sizeof(UInt32))
+    {
+        UInt32 chunkSize;
+        memcpy(&chunkSize, tail + consumed, sizeof(UInt32));
+        int32_t recordBytes = (int32_t)(sizeof(UInt32) + chunkSize * sizeof(float));
+        if (availableBytes - consumed < recordBytes)
+        {
+            break;
+        }
+        float *chunk = (float *)(tail + consumed + sizeof(UInt32));
+        [EZAudioUtilities appendBufferRMS:chunk
+                           withBufferSize:chunkSize
+                            toHistoryInfo:self.historyInfo];
+        latestChunk = chunk;
+        latestChunkSize = chunkSize;
+        consumed += recordBytes;
+    }
+
+    //
+    // The buffer plot shows whichever buffer arrived last; the rolling plot
+    // rebuilds its points from the history pyramid in redraw
+    //
+    if (self.plotType == EZPlotTypeBuffer && latestChunk != NULL)
+    {
+        [self setSampleData:latestChunk length:latestChunkSize];
+    }
+
+    //
+    // Consume only after the reads above: the producer may not reuse the
+    // space until the tail has moved past it
+    //
+    if (consumed > 0)
+    {
+        TPCircularBufferConsume(&stagingBuffer, consumed);
+    }
+}
+
+//------------------------------------------------------------------------------
+
+- (void)updateRollingPoints
+{
+    if (!self.historyInfo || self.rollingMinimums == NULL)
+    {
+        return;
+    }
+
+    //
+    // One point per horizontal pixel is all the path can show, so read the
+    // history's min/max pyramid at that resolution instead of walking every
+    // sample in the window
+    //
+    int pointCount = MIN(self.historyInfo->bufferSize,
+                         MAX(1, (int)self.waveformLayer.frame.size.width));
+    [EZAudioUtilities readHistoryInfo:self.historyInfo
+                             minimums:self.rollingMinimums
+                             maximums:self.rollingMaximums
+                           pointCount:pointCount];
+
+    //
+    // Keep whichever extreme has the larger magnitude so peaks survive the
+    // downsampling
+    //
+    for (int i = 0; i < pointCount; i++)
+    {
+        float minimum = self.rollingMinimums[i];
+        float maximum = self.rollingMaximums[i];
+        self.rollingMaximums[i] = fabsf(minimum) > fabsf(maximum) ? minimum : maximum;
+    }
+    [self setSampleData:self.rollingMaximums length:pointCount];
+}
+
+//------------------------------------------------------------------------------
+
 - (void)setSampleData:(float *)data length:(int)length
 {
     CGPoint *points = self.points;
@@ -441,6 +586,7 @@ UInt32 const EZAudioPlotDefaultMaxHistoryBufferLength = 8192;
 
 - (void)displayLinkNeedsDisplay:(EZAudioDisplayLink *)displayLink
 {
+    [self drainStagedBuffers];
     [self redraw];
 }
 
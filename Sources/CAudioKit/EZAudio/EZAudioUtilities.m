@@ -18,6 +18,7 @@
 //  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 //  THE SOFTWARE.
 #import <Accelerate/Accelerate.h>
+#import <float.h>
 #import "EZAudioUtilities.h"
 #import "EZPlotHistoryInfo.h"
 
@@ -484,11 +485,107 @@ BOOL __shouldExitOnCheckResultFail = YES;
 
 //------------------------------------------------------------------------------
 
++ (float)RMSFromBufferList:(AudioBufferList *)bufferList
+        withNumberOfFrames:(UInt32)frames
+{
+    //
+    // Sum the squares of every buffer, then take a single mean and root so
+    // the result matches an RMS over the concatenated channels
+    //
+    float sumOfSquares = 0.0f;
+    UInt32 totalSamples = 0;
+    for (UInt32 i = 0; i < bufferList->mNumberBuffers; i++)
+    {
+        float *data = (float *)bufferList->mBuffers[i].mData;
+        UInt32 samples = frames * bufferList->mBuffers[i].mNumberChannels;
+        if (!data || samples == 0)
+        {
+            continue;
+        }
+        float bufferSum = 0.0f;
+        vDSP_svesq(data, 1, &bufferSum, (vDSP_Length)samples);
+        sumOfSquares += bufferSum;
+        totalSamples += samples;
+    }
+    return totalSamples == 0 ? 0.0f : sqrtf(sumOfSquares / totalSamples);
+}
+
+//------------------------------------------------------------------------------
+
 + (float)SGN:(float)value
 {
     return value < 0 ? -1.0f : ( value > 0 ? 1.0f : 0.0f);
 }
 
+//------------------------------------------------------------------------------
+#pragma mark - Float Conversion Utility
+//------------------------------------------------------------------------------
+
++ (void)convertSInt16:(SInt16 *)source
+              toFloat:(float *)destination
+               length:(UInt32)length
+{
+    float scale = (float)INT16_MAX + 1.0f;
+    vDSP_vflt16(source, 1, destination, 1, (vDSP_Length)length);
+    vDSP_vsdiv(destination, 1, &scale, destination, 1, (vDSP_Length)length);
+}
+
+//------------------------------------------------------------------------------
+
++ (void)convertBufferList:(AudioBufferList *)bufferList
+       withNumberOfFrames:(UInt32)frames
+           toFloatBuffers:(float **)buffers
+         numberOfChannels:(UInt32)channels
+                   format:(AudioStreamBasicDescription)asbd
+{
+    BOOL isFloat = [self isFloatFormat:asbd];
+    BOOL interleaved = [self isInterleaved:asbd];
+    float scale = (float)INT16_MAX + 1.0f;
+    float zero = 0.0f;
+    for (UInt32 channel = 0; channel < channels; channel++)
+    {
+        if (interleaved)
+        {
+            void *data = bufferList->mBuffers[0].mData;
+            if (isFloat)
+            {
+                //
+                // A strided add of zero pulls one channel out of the
+                // interleaved frames in a single vector pass
+                //
+                vDSP_vsadd((float *)data + channel, channels,
+                           &zero,
+                           buffers[channel], 1,
+                           (vDSP_Length)frames);
+            }
+            else
+            {
+                vDSP_vflt16((SInt16 *)data + channel, channels,
+                            buffers[channel], 1,
+                            (vDSP_Length)frames);
+                vDSP_vsdiv(buffers[channel], 1,
+                           &scale,
+                           buffers[channel], 1,
+                           (vDSP_Length)frames);
+            }
+        }
+        else
+        {
+            void *data = bufferList->mBuffers[channel].mData;
+            if (isFloat)
+            {
+                memcpy(buffers[channel], data, frames * sizeof(float));
+            }
+            else
+            {
+                [self convertSInt16:(SInt16 *)data
+                            toFloat:buffers[channel]
+                             length:frames];
+            }
+        }
+    }
+}
+
 //------------------------------------------------------------------------------
 #pragma mark - Music Utilities
 //------------------------------------------------------------------------------
@@ -671,6 +768,104 @@ BOOL __shouldExitOnCheckResultFail = YES;
 
 //------------------------------------------------------------------------------
 
++ (void)appendBufferListRMS:(AudioBufferList *)bufferList
+         withNumberOfFrames:(UInt32)frames
+              toHistoryInfo:(EZPlotHistoryInfo *)historyInfo
+{
+    //
+    // Calculate a single RMS across all channels and append to buffer
+    //
+    float rms = [EZAudioUtilities RMSFromBufferList:bufferList
+                                 withNumberOfFrames:frames];
+    float src[1];
+    src[0] = isnan(rms) ? 0.0 : rms;
+    [self appendBuffer:src withBufferSize:1 toHistoryInfo:historyInfo];
+}
+
+//------------------------------------------------------------------------------
+
+//
+// Recomputes the pyramid entries covering ring positions [start, start + count).
+// Level 0 entries each cover 2 ring samples and every higher level combines two
+// children, so the total work is O(count) regardless of the history length.
+//
+static void EZPlotHistoryInfoUpdatePyramid(EZPlotHistoryInfo *historyInfo,
+                                           int64_t start,
+                                           int count)
+{
+    int64_t firstBlock = start >> 1;
+    int64_t lastBlock = (start + count - 1) >> 1;
+    int entries = historyInfo->ringCapacity >> 1;
+    float *source = historyInfo->ringBuffer;
+    for (int level = 0; level < historyInfo->pyramidLevelCount; level++)
+    {
+        float *minLevel = historyInfo->pyramidMin[level];
+        float *maxLevel = historyInfo->pyramidMax[level];
+        float *childMin = level == 0 ? source : historyInfo->pyramidMin[level - 1];
+        float *childMax = level == 0 ? source : historyInfo->pyramidMax[level - 1];
+        for (int64_t block = firstBlock; block <= lastBlock; block++)
+        {
+            int i = (int)(block & (entries - 1));
+            float left = childMin[2 * i];
+            float right = childMin[2 * i + 1];
+            minLevel[i] = MIN(left, right);
+            left = childMax[2 * i];
+            right = childMax[2 * i + 1];
+            maxLevel[i] = MAX(left, right);
+        }
+        firstBlock >>= 1;
+        lastBlock >>= 1;
+        entries >>= 1;
+    }
+}
+
+//------------------------------------------------------------------------------
+
+//
+// Combines the pyramid blocks covering absolute sample positions [start, end)
+// into a single min/max pair. Greedily takes the largest aligned block that
+// fits, so a range of any length costs O(log(range)) reads.
+//
+static void EZPlotHistoryInfoReduceRange(EZPlotHistoryInfo *historyInfo,
+                                         int64_t start,
+                                         int64_t end,
+                                         float *minimum,
+                                         float *maximum)
+{
+    float rangeMin = FLT_MAX;
+    float rangeMax = -FLT_MAX;
+    int ringMask = historyInfo->ringCapacity - 1;
+    while (start < end)
+    {
+        int level = 0;
+        while (level < historyInfo->pyramidLevelCount
+               && (start & ((2LL << level) - 1)) == 0
+               && start + (2LL << level) <= end)
+        {
+            level++;
+        }
+        if (level == 0)
+        {
+            float sample = historyInfo->ringBuffer[start & ringMask];
+            rangeMin = MIN(rangeMin, sample);
+            rangeMax = MAX(rangeMax, sample);
+            start += 1;
+        }
+        else
+        {
+            int entries = historyInfo->ringCapacity >> level;
+            int i = (int)((start >> level) & (entries - 1));
+            rangeMin = MIN(rangeMin, historyInfo->pyramidMin[level - 1][i]);
+            rangeMax = MAX(rangeMax, historyInfo->pyramidMax[level - 1][i]);
+            start += 1LL << level;
+        }
+    }
+    *minimum = rangeMin == FLT_MAX ? 0.0f : rangeMin;
+    *maximum = rangeMax == -FLT_MAX ? 0.0f : rangeMax;
+}
+
+//------------------------------------------------------------------------------
+
 + (void)appendBuffer:(float *)buffer
       withBufferSize:(UInt32)bufferSize
        toHistoryInfo:(EZPlotHistoryInfo *)historyInfo
@@ -684,17 +879,73 @@ BOOL __shouldExitOnCheckResultFail = YES;
     }
 
     //
-    // Update the scroll history datasource
+    // If the chunk is longer than the ring only the newest samples survive
+    //
+    int capacity = historyInfo->ringCapacity;
+    if ((int)bufferSize > capacity)
+    {
+        buffer += bufferSize - capacity;
+        bufferSize = capacity;
+    }
+
+    //
+    // Write into the ring in at most two contiguous segments and refresh the
+    // pyramid entries the write touched; no full-history shift or copy.
+    //
+    int start = (int)(historyInfo->ringHead & (capacity - 1));
+    int firstSegment = MIN((int)bufferSize, capacity - start);
+    memcpy(&historyInfo->ringBuffer[start], buffer, firstSegment * sizeof(float));
+    int remaining = bufferSize - firstSegment;
+    if (remaining > 0)
+    {
+        memcpy(historyInfo->ringBuffer, &buffer[firstSegment], remaining * sizeof(float));
+    }
+    EZPlotHistoryInfoUpdatePyramid(historyInfo, historyInfo->ringHead, bufferSize);
+    historyInfo->ringHead += bufferSize;
+}
+
+//------------------------------------------------------------------------------
+
++ (float *)windowForHistoryInfo:(EZPlotHistoryInfo *)historyInfo
+{
+    //
+    // Linearize the most recent bufferSize samples into the window buffer
     //
-    TPCircularBufferProduceBytes(&historyInfo->circularBuffer, buffer, bufferSize * sizeof(float));
-    int32_t targetBytes = historyInfo->bufferSize * sizeof(float);
-    int32_t availableBytes = 0;
-    float *historyBuffer = TPCircularBufferTail(&historyInfo->circularBuffer, &availableBytes);
-    int32_t bytes = MIN(targetBytes, availableBytes);
-    memmove(historyInfo->buffer, historyBuffer, bytes);
-    if (targetBytes <= availableBytes)
+    int capacity = historyInfo->ringCapacity;
+    int windowSize = historyInfo->bufferSize;
+    int start = (int)((historyInfo->ringHead - windowSize) & (capacity - 1));
+    int firstSegment = MIN(windowSize, capacity - start);
+    memcpy(historyInfo->buffer, &historyInfo->ringBuffer[start], firstSegment * sizeof(float));
+    int remaining = windowSize - firstSegment;
+    if (remaining > 0)
+    {
+        memcpy(&historyInfo->buffer[firstSegment], historyInfo->ringBuffer, remaining * sizeof(float));
+    }
+    return historyInfo->buffer;
+}
+
+//------------------------------------------------------------------------------
+
++ (void)readHistoryInfo:(EZPlotHistoryInfo *)historyInfo
+               minimums:(float *)minimums
+               maximums:(float *)maximums
+             pointCount:(int)pointCount
+{
+    if (pointCount <= 0)
     {
-        TPCircularBufferConsume(&historyInfo->circularBuffer, availableBytes - targetBytes);
+        return;
+    }
+    int64_t windowStart = historyInfo->ringHead - historyInfo->bufferSize;
+    int64_t windowSize = historyInfo->bufferSize;
+    for (int point = 0; point < pointCount; point++)
+    {
+        int64_t start = windowStart + point * windowSize / pointCount;
+        int64_t end = windowStart + (point + 1) * windowSize / pointCount;
+        if (end <= start)
+        {
+            end = start + 1;
+        }
+        EZPlotHistoryInfoReduceRange(historyInfo, start, end, &minimums[point], &maximums[point]);
     }
 }
 
@@ -703,22 +954,28 @@ BOOL __shouldExitOnCheckResultFail = YES;
 + (void)clearHistoryInfo:(EZPlotHistoryInfo *)historyInfo
 {
     memset(historyInfo->buffer, 0, historyInfo->bufferSize * sizeof(float));
-    TPCircularBufferClear(&historyInfo->circularBuffer);
+    memset(historyInfo->ringBuffer, 0, historyInfo->ringCapacity * sizeof(float));
+    for (int level = 0; level < historyInfo->pyramidLevelCount; level++)
+    {
+        int entries = historyInfo->ringCapacity >> (level + 1);
+        memset(historyInfo->pyramidMin[level], 0, entries * sizeof(float));
+        memset(historyInfo->pyramidMax[level], 0, entries * sizeof(float));
+    }
 }
 
 //------------------------------------------------------------------------------
 
 + (void)freeHistoryInfo:(EZPlotHistoryInfo *)historyInfo
 {
-    // This seems to be in the wrong order. It is causing memory errors in sporadic ways.
-    //    free(historyInfo->buffer);
-    //    free(historyInfo);
-    //    TPCircularBufferCleanup(&historyInfo->circularBuffer);
-
-    // I believe the order should be:
-
+    for (int level = 0; level < historyInfo->pyramidLevelCount; level++)
+    {
+        free(historyInfo->pyramidMin[level]);
+        free(historyInfo->pyramidMax[level]);
+    }
+    free(historyInfo->pyramidMin);
+    free(historyInfo->pyramidMax);
+    free(historyInfo->ringBuffer);
     free(historyInfo->buffer);
-    TPCircularBufferCleanup(&historyInfo->circularBuffer);
     free(historyInfo);
 }
 
@@ -733,16 +990,34 @@ BOOL __shouldExitOnCheckResultFail = YES;
     EZPlotHistoryInfo *historyInfo = (EZPlotHistoryInfo *)malloc(sizeof(EZPlotHistoryInfo));
     historyInfo->bufferSize = defaultLength;
     historyInfo->buffer = calloc(maximumLength, sizeof(float));
-    TPCircularBufferInit(&historyInfo->circularBuffer, maximumLength);
 
     //
-    // Zero out circular buffer
+    // The ring is rounded up to a power of two so pyramid blocks stay aligned
+    // when the write position wraps
     //
-    float emptyBuffer[maximumLength];
-    memset(emptyBuffer, 0, sizeof(emptyBuffer));
-    TPCircularBufferProduceBytes(&historyInfo->circularBuffer,
-                                 emptyBuffer,
-                                 (int32_t)sizeof(emptyBuffer));
+    int capacity = 2;
+    while (capacity < maximumLength)
+    {
+        capacity <<= 1;
+    }
+    historyInfo->ringCapacity = capacity;
+    historyInfo->ringBuffer = calloc(capacity, sizeof(float));
+    historyInfo->ringHead = 0;
+
+    int levelCount = 0;
+    for (int entries = capacity >> 1; entries >= 1; entries >>= 1)
+    {
+        levelCount++;
+    }
+    historyInfo->pyramidLevelCount = levelCount;
+    historyInfo->pyramidMin = calloc(levelCount, sizeof(float *));
+    historyInfo->pyramidMax = calloc(levelCount, sizeof(float *));
+    for (int level = 0; level < levelCount; level++)
+    {
+        int entries = capacity >> (level + 1);
+        historyInfo->pyramidMin[level] = calloc(entries, sizeof(float));
+        historyInfo->pyramidMax[level] = calloc(entries, sizeof(float));
+    }
 
     return historyInfo;
 }
@@ -21,13 +21,28 @@
 #ifndef EZPlotHistoryInfo_h
 #define EZPlotHistoryInfo_h
 
-#import <TPCircularBuffer.h>
+#import <stdint.h>
 
+//
+// The history is a power-of-two ring buffer of the most recent audio samples
+// plus a min/max decimation pyramid over the ring. Level 0 holds the min/max
+// of every 2 samples, level 1 of every 4, and so on up to one entry covering
+// the whole ring. Appending N samples touches O(N) pyramid entries and any
+// zoom level can be drawn with O(pixels) pyramid reads, so neither side ever
+// shifts or rescans the whole history. `buffer` holds a contiguous copy of
+// the most recent `bufferSize` samples, filled on demand for consumers that
+// need a linear window (see EZAudioUtilities windowForHistoryInfo:).
+//
 struct _EZPlotHistoryInfo
 {
     float            *buffer;
     int               bufferSize;
-    TPCircularBuffer  circularBuffer;
+    float            *ringBuffer;
+    int               ringCapacity;
+    int64_t           ringHead;
+    int               pyramidLevelCount;
+    float           **pyramidMin;
+    float           **pyramidMax;
 };
 
 #endif /* EZPlotHistoryInfo_h */
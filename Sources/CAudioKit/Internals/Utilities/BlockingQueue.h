@@ -0,0 +1,33 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+#pragma once
+
+#ifdef __cplusplus
+
+#include "readerwriterqueue.h"
+
+namespace AudioKitCore
+{
+
+    /// Waitable single-producer, single-consumer channel for handing work
+    /// between the render thread and a background I/O thread (sample
+    /// streaming, disk recording). The consumer sleeps on a semaphore in
+    /// wait_dequeue / wait_dequeue_timed instead of polling, and is woken
+    /// the moment the producer enqueues.
+    ///
+    /// Render-thread rules are the same as for LockFreeQueue: try_enqueue
+    /// and try_dequeue never allocate or block and are safe on the audio
+    /// thread; enqueue may allocate and wait_dequeue may sleep, so both
+    /// belong on background threads only.
+    template <typename T>
+    using BlockingQueue = moodycamel::BlockingReaderWriterQueue<T>;
+
+    /// Non-waitable variant for queues polled from the render thread
+    /// (parameter updates, MIDI hand-off), where the consumer is driven by
+    /// the audio callback and must never sleep.
+    template <typename T>
+    using LockFreeQueue = moodycamel::ReaderWriterQueue<T>;
+
+}
+
+#endif
@@ -5,8 +5,10 @@
 #include "md5.h"
 #include <stddef.h>
 #include <assert.h>
+#include <stdatomic.h>
 #include <stdio.h>
 #include <string.h>
+#include <mach/mach_time.h>
 
 #define MAX_SLOTS 16
 
@@ -46,3 +48,235 @@ bool DebugDSPCheck(int slot, const char* expected) {
     }
     return true;
 }
+
+#pragma mark - Render profiler
+
+#define PROFILER_MAX_NODES 64
+#define PROFILER_MAX_NAME 48
+
+// Render times land in log2(mach ticks) buckets. 64 buckets cover any
+// uint64_t elapsed time; percentiles are reported as a bucket's upper bound,
+// so they are conservative by at most a factor of two.
+#define PROFILER_BUCKETS 64
+
+typedef struct {
+    char name[PROFILER_MAX_NAME];
+    _Atomic uint64_t renderCount;
+    _Atomic uint64_t totalTicks;
+    _Atomic uint64_t worstTicks;
+    _Atomic uint64_t buckets[PROFILER_BUCKETS];
+} ProfilerNode;
+
+static ProfilerNode profilerNodes[PROFILER_MAX_NODES];
+static int profilerNodeCount = 0;
+static double profilerTicksToNs = 0.0;
+
+int DSPProfilerRegisterNode(const char* name) {
+    if (profilerTicksToNs == 0.0) {
+        struct mach_timebase_info info;
+        mach_timebase_info(&info);
+        profilerTicksToNs = (double)info.numer / (double)info.denom;
+    }
+
+    // Instances of the same node type share a slot, so the table stays
+    // bounded no matter how many nodes come and go.
+    for (int i = 0; i < profilerNodeCount; ++i) {
+        if (strcmp(profilerNodes[i].name, name) == 0) return i;
+    }
+
+    if (profilerNodeCount >= PROFILER_MAX_NODES) return -1;
+
+    int node = profilerNodeCount;
+    strncpy(profilerNodes[node].name, name, PROFILER_MAX_NAME - 1);
+    profilerNodeCount = node + 1;
+    return node;
+}
+
+uint64_t DSPProfilerTimestamp(void) {
+    return mach_absolute_time();
+}
+
+void DSPProfilerRecord(int node, uint64_t startTime, uint64_t endTime) {
+    if (node < 0 || node >= profilerNodeCount) return;
+
+    ProfilerNode* p = profilerNodes + node;
+    uint64_t ticks = endTime - startTime;
+
+    atomic_fetch_add_explicit(&p->renderCount, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&p->totalTicks, ticks, memory_order_relaxed);
+
+    uint64_t worst = atomic_load_explicit(&p->worstTicks, memory_order_relaxed);
+    while (ticks > worst &&
+           !atomic_compare_exchange_weak_explicit(&p->worstTicks, &worst, ticks,
+                                                  memory_order_relaxed,
+                                                  memory_order_relaxed)) { }
+
+    int bucket = 64 - __builtin_clzll(ticks | 1);
+    if (bucket >= PROFILER_BUCKETS) bucket = PROFILER_BUCKETS - 1;
+    atomic_fetch_add_explicit(&p->buckets[bucket], 1, memory_order_relaxed);
+}
+
+size_t DSPProfilerSnapshot(DSPProfileStat* stats, size_t maxStats) {
+    size_t written = 0;
+
+    for (int i = 0; i < profilerNodeCount && written < maxStats; ++i) {
+        ProfilerNode* p = profilerNodes + i;
+
+        uint64_t count = atomic_load_explicit(&p->renderCount, memory_order_relaxed);
+        uint64_t total = atomic_load_explicit(&p->totalTicks, memory_order_relaxed);
+        uint64_t worst = atomic_load_explicit(&p->worstTicks, memory_order_relaxed);
+
+        DSPProfileStat* s = stats + written;
+        s->name = p->name;
+        s->renderCount = count;
+        s->averageNs = count ? (double)total / (double)count * profilerTicksToNs : 0.0;
+        s->worstNs = (double)worst * profilerTicksToNs;
+
+        // Walk the histogram until 99% of renders are accounted for and
+        // report that bucket's upper bound.
+        s->p99Ns = 0.0;
+        uint64_t seen = 0;
+        for (int b = 0; b < PROFILER_BUCKETS; ++b) {
+            seen += atomic_load_explicit(&p->buckets[b], memory_order_relaxed);
+            if (count > 0 && (double)seen >= 0.99 * (double)count) {
+                s->p99Ns = (double)(1ULL << b) * profilerTicksToNs;
+                break;
+            }
+        }
+
+        ++written;
+    }
+
+    return written;
+}
+
+void DSPProfilerReset(void) {
+    for (int i = 0; i < profilerNodeCount; ++i) {
+        ProfilerNode* p = profilerNodes + i;
+        atomic_store_explicit(&p->renderCount, 0, memory_order_relaxed);
+        atomic_store_explicit(&p->totalTicks, 0, memory_order_relaxed);
+        atomic_store_explicit(&p->worstTicks, 0, memory_order_relaxed);
+        for (int b = 0; b < PROFILER_BUCKETS; ++b) {
+            atomic_store_explicit(&p->buckets[b], 0, memory_order_relaxed);
+        }
+    }
+}
+
+#pragma mark - Energy telemetry
+
+// Load fractions are carried as parts-per-million in uint64 atomics, the same
+// integer-atomics approach the profiler takes with ticks: fetch_add works,
+// and a million steps is far finer than the measurement noise.
+#define ENERGY_PPM 1000000.0
+#define ENERGY_TRANSITION_RING 16
+
+// Smoothing shift for the load EMA: new = old + (sample - old) / 64, so the
+// estimate settles over roughly 64 quanta (under a second at typical buffer
+// sizes) - fast enough to catch a ramp, slow enough to ignore one bad quantum.
+#define ENERGY_SMOOTHING_SHIFT 6
+
+static _Atomic int energyThermalState = DSPThermalNominal;
+static _Atomic uint64_t energySmoothedLoadPPM = 0;
+static _Atomic uint64_t energyQuantaInState[DSP_THERMAL_STATES];
+static _Atomic uint64_t energyTotalLoadPPMInState[DSP_THERMAL_STATES];
+
+static _Atomic uint64_t energyDeratePPM[DSP_THERMAL_STATES] = {
+    1000000, 900000, 750000, 600000
+};
+
+// Transition log: single writer (the app's notification observer), readers
+// copy entries without locking. An entry being overwritten mid-copy can tear,
+// which is acceptable for debug telemetry; the count is published with
+// release so settled entries are always consistent.
+static DSPEnergyTransition energyTransitions[ENERGY_TRANSITION_RING];
+static _Atomic uint64_t energyTransitionCount = 0;
+
+void DSPEnergySetThermalState(int state) {
+    if (state < 0 || state >= DSP_THERMAL_STATES) return;
+
+    int previous = atomic_exchange_explicit(&energyThermalState, state, memory_order_relaxed);
+    if (previous == state) return;
+
+    uint64_t count = atomic_load_explicit(&energyTransitionCount, memory_order_relaxed);
+    DSPEnergyTransition* t = energyTransitions + (count % ENERGY_TRANSITION_RING);
+    t->hostTime = mach_absolute_time();
+    t->fromState = previous;
+    t->toState = state;
+    t->smoothedLoad = (double)atomic_load_explicit(&energySmoothedLoadPPM, memory_order_relaxed) / ENERGY_PPM;
+    atomic_store_explicit(&energyTransitionCount, count + 1, memory_order_release);
+}
+
+int DSPEnergyGetThermalState(void) {
+    return atomic_load_explicit(&energyThermalState, memory_order_relaxed);
+}
+
+void DSPEnergyRecordQuantum(double loadFraction) {
+    if (loadFraction < 0.0) loadFraction = 0.0;
+    uint64_t loadPPM = (uint64_t)(loadFraction * ENERGY_PPM);
+
+    // The render thread is the only writer, so the EMA is a plain
+    // read-modify-write published with relaxed stores.
+    int64_t smoothed = (int64_t)atomic_load_explicit(&energySmoothedLoadPPM, memory_order_relaxed);
+    smoothed += ((int64_t)loadPPM - smoothed) >> ENERGY_SMOOTHING_SHIFT;
+    atomic_store_explicit(&energySmoothedLoadPPM, (uint64_t)smoothed, memory_order_relaxed);
+
+    int state = atomic_load_explicit(&energyThermalState, memory_order_relaxed);
+    atomic_fetch_add_explicit(&energyQuantaInState[state], 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&energyTotalLoadPPMInState[state], loadPPM, memory_order_relaxed);
+}
+
+double DSPEnergyBudgetScale(void) {
+    int state = atomic_load_explicit(&energyThermalState, memory_order_relaxed);
+    return (double)atomic_load_explicit(&energyDeratePPM[state], memory_order_relaxed) / ENERGY_PPM;
+}
+
+void DSPEnergyConfigureDerate(double nominal, double fair, double serious, double critical) {
+    double scales[DSP_THERMAL_STATES] = { nominal, fair, serious, critical };
+    for (int i = 0; i < DSP_THERMAL_STATES; ++i) {
+        if (scales[i] > 0.0 && scales[i] <= 1.0) {
+            atomic_store_explicit(&energyDeratePPM[i], (uint64_t)(scales[i] * ENERGY_PPM),
+                                  memory_order_relaxed);
+        }
+    }
+}
+
+double DSPEnergyHeadroom(void) {
+    double load = (double)atomic_load_explicit(&energySmoothedLoadPPM, memory_order_relaxed) / ENERGY_PPM;
+    return DSPEnergyBudgetScale() - load;
+}
+
+void DSPEnergySnapshot(DSPEnergyStat* stat) {
+    stat->thermalState = atomic_load_explicit(&energyThermalState, memory_order_relaxed);
+    stat->smoothedLoad = (double)atomic_load_explicit(&energySmoothedLoadPPM, memory_order_relaxed) / ENERGY_PPM;
+    stat->budgetScale = DSPEnergyBudgetScale();
+    stat->headroom = stat->budgetScale - stat->smoothedLoad;
+
+    for (int i = 0; i < DSP_THERMAL_STATES; ++i) {
+        uint64_t quanta = atomic_load_explicit(&energyQuantaInState[i], memory_order_relaxed);
+        uint64_t total = atomic_load_explicit(&energyTotalLoadPPMInState[i], memory_order_relaxed);
+        stat->quantaInState[i] = quanta;
+        stat->averageLoadInState[i] = quanta ? (double)total / (double)quanta / ENERGY_PPM : 0.0;
+    }
+}
+
+size_t DSPEnergyTransitions(DSPEnergyTransition* transitions, size_t maxTransitions) {
+    uint64_t count = atomic_load_explicit(&energyTransitionCount, memory_order_acquire);
+    uint64_t available = count < ENERGY_TRANSITION_RING ? count : ENERGY_TRANSITION_RING;
+    if (available > maxTransitions) available = maxTransitions;
+
+    // Copy oldest-first so the newest transition lands last.
+    size_t written = 0;
+    for (uint64_t i = count - available; i < count; ++i) {
+        transitions[written++] = energyTransitions[i % ENERGY_TRANSITION_RING];
+    }
+    return written;
+}
+
+void DSPEnergyReset(void) {
+    atomic_store_explicit(&energySmoothedLoadPPM, 0, memory_order_relaxed);
+    for (int i = 0; i < DSP_THERMAL_STATES; ++i) {
+        atomic_store_explicit(&energyQuantaInState[i], 0, memory_order_relaxed);
+        atomic_store_explicit(&energyTotalLoadPPMInState[i], 0, memory_order_relaxed);
+    }
+    atomic_store_explicit(&energyTransitionCount, 0, memory_order_relaxed);
+}
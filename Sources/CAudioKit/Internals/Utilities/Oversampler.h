@@ -0,0 +1,136 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+// Polyphase IIR halfband resampler for oversampled processing.
+//
+// One instance handles one channel. A stage is the classic pair of
+// third-order polyphase allpass chains (the same sections, with the same
+// coefficients, as the SOUL-generated SampleRateConverter embedded in
+// DiodeClipper.hpp — lifted here so oversampling is infrastructure instead
+// of something every nonlinear node reimplements). Factor 2 uses one stage,
+// factor 4 cascades two. Up and down directions keep separate filter state,
+// so one instance serves both ends of an oversampled section.
+
+#pragma once
+
+#ifdef __cplusplus
+
+#include <cstddef>
+
+namespace AudioKitCore {
+
+class Oversampler {
+public:
+    /// factor must be 1, 2, or 4; anything else falls back to 1 (bypass).
+    void init(int oversamplingFactor)
+    {
+        factor = (oversamplingFactor == 2 || oversamplingFactor == 4)
+                 ? oversamplingFactor : 1;
+        reset();
+    }
+
+    int oversamplingFactor() const { return factor; }
+
+    void reset()
+    {
+        for (auto& stage : upStages) stage.clear();
+        for (auto& stage : downStages) stage.clear();
+    }
+
+    /// Reads frames samples from in, writes frames * factor samples to out.
+    void upsample(const float* in, float* out, size_t frames)
+    {
+        switch (factor) {
+            case 2:
+                for (size_t i = 0; i < frames; ++i) {
+                    upStages[0].up(in[i], out + 2 * i);
+                }
+                break;
+            case 4:
+                for (size_t i = 0; i < frames; ++i) {
+                    float half[2];
+                    upStages[0].up(in[i], half);
+                    upStages[1].up(half[0], out + 4 * i);
+                    upStages[1].up(half[1], out + 4 * i + 2);
+                }
+                break;
+            default:
+                for (size_t i = 0; i < frames; ++i) out[i] = in[i];
+        }
+    }
+
+    /// Reads frames * factor samples from in, writes frames samples to out.
+    void downsample(const float* in, float* out, size_t frames)
+    {
+        switch (factor) {
+            case 2:
+                for (size_t i = 0; i < frames; ++i) {
+                    out[i] = downStages[0].down(in[2 * i], in[2 * i + 1]);
+                }
+                break;
+            case 4:
+                for (size_t i = 0; i < frames; ++i) {
+                    float first = downStages[1].down(in[4 * i], in[4 * i + 1]);
+                    float second = downStages[1].down(in[4 * i + 2], in[4 * i + 3]);
+                    out[i] = downStages[0].down(first, second);
+                }
+                break;
+            default:
+                for (size_t i = 0; i < frames; ++i) out[i] = in[i];
+        }
+    }
+
+private:
+    /// Three cascaded first-order allpass sections in the polyphase form
+    /// y[n] = y3[n-1] + k * (x[n] - y3[n]) applied section by section.
+    struct AllpassChain {
+        float k0, k1, k2;
+        float x1 = 0;
+        float y1 = 0, y2 = 0, y3 = 0;
+
+        float process(float x)
+        {
+            float a = x1 + (x - y1) * k0;
+            float b = y1 + (a - y2) * k1;
+            float c = y2 + (b - y3) * k2;
+            x1 = x;
+            y1 = a;
+            y2 = b;
+            y3 = c;
+            return c;
+        }
+
+        void clear() { x1 = y1 = y2 = y3 = 0; }
+    };
+
+    /// One halfband: branch A carries the even polyphase component, branch B
+    /// the odd one.
+    struct Stage {
+        AllpassChain a { 0.039151598f, 0.30264685f, 0.6746159f };
+        AllpassChain b { 0.14737712f, 0.48246855f, 0.883005f };
+
+        void up(float x, float* pair)
+        {
+            pair[0] = a.process(x);
+            pair[1] = b.process(x);
+        }
+
+        float down(float x0, float x1)
+        {
+            return 0.5f * (a.process(x1) + b.process(x0));
+        }
+
+        void clear()
+        {
+            a.clear();
+            b.clear();
+        }
+    };
+
+    Stage upStages[2];
+    Stage downStages[2];
+    int factor = 1;
+};
+
+}
+
+#endif
@@ -0,0 +1,46 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+#pragma once
+
+#ifdef __cplusplus
+
+#include <atomic>
+
+/// Wait-free single-producer single-consumer triple buffer.
+///
+/// The producer fills its private back slot and publishes it by swapping it
+/// with the shared middle slot; the consumer swaps the middle slot with its
+/// private front slot whenever fresh data is flagged. Both sides complete in
+/// one atomic exchange — no waiting, no torn reads — and the consumer can
+/// poll at any rate, always seeing the most recently published value.
+template <typename T>
+class TripleBuffer {
+public:
+    /// Producer side: the slot to fill in.
+    T& beginWrite() { return slots[back]; }
+
+    /// Producer side: publishes the slot from beginWrite.
+    void endWrite() {
+        back = middle.exchange(back | freshBit, std::memory_order_acq_rel) & indexMask;
+    }
+
+    /// Consumer side: latest published value (or the previous one when the
+    /// producer hasn't published since the last read).
+    const T& read() {
+        if (middle.load(std::memory_order_acquire) & freshBit) {
+            front = middle.exchange(front, std::memory_order_acq_rel) & indexMask;
+        }
+        return slots[front];
+    }
+
+private:
+    static constexpr int freshBit = 4;
+    static constexpr int indexMask = 3;
+
+    T slots[3] = {};
+    int back = 0;
+    int front = 1;
+    std::atomic<int> middle{2};
+};
+
+#endif
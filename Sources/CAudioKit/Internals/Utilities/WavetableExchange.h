@@ -0,0 +1,104 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+#pragma once
+
+#ifdef __cplusplus
+
+#include "soundpipe.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace AudioKitCore
+{
+
+    /// Lock-free hand-off of wavetables from a control thread to the render
+    /// thread. The sender fills a fresh table off the render thread and
+    /// publishes it with a single atomic pointer store; the render thread
+    /// picks the pointer up once per quantum and crossfades from the
+    /// outgoing table to the incoming one. Retired tables are reclaimed on
+    /// the sender thread the next time it publishes, so the render thread
+    /// never allocates, copies, or frees.
+    ///
+    /// Threading: publish() on one sender thread only; pickup(), current(),
+    /// outgoing(), and finishCrossfade() on the render thread only.
+    class WavetableExchange
+    {
+    public:
+        /// Sender side. Allocates a table and copies into it on the calling
+        /// thread, publishes it with one atomic store, then reclaims any
+        /// tables the render thread can no longer reach.
+        void publish(sp_data *sp, const float *table, size_t length)
+        {
+            auto entry = std::make_unique<Entry>();
+            sp_ftbl_create(sp, &entry->table, length);
+            std::copy(table, table + length, entry->table->tbl);
+            next.store(entry.get(), std::memory_order_release);
+            retired.push_back(std::move(entry));
+            collect();
+        }
+
+        /// Render side: call once per quantum. Returns true when a new table
+        /// was picked up while another was already playing, i.e. when a
+        /// crossfade from outgoing() to current() should start.
+        bool pickup()
+        {
+            Entry *latest = next.load(std::memory_order_acquire);
+            if (latest == incoming) return false;
+            if (outgoingEntry) outgoingEntry->done.store(true, std::memory_order_release);
+            outgoingEntry = incoming;
+            incoming = latest;
+            return outgoingEntry != nullptr;
+        }
+
+        /// Render side: the table being faded in (and the steady-state table
+        /// once the fade is over). Null until the first publish is picked up.
+        sp_ftbl *current() const { return incoming ? incoming->table : nullptr; }
+
+        /// Render side: the table being faded out, or null when no crossfade
+        /// is in flight.
+        sp_ftbl *outgoing() const { return outgoingEntry ? outgoingEntry->table : nullptr; }
+
+        /// Render side: call when the crossfade has finished so the outgoing
+        /// table becomes reclaimable without waiting for the next swap.
+        void finishCrossfade()
+        {
+            if (outgoingEntry) {
+                outgoingEntry->done.store(true, std::memory_order_release);
+                outgoingEntry = nullptr;
+            }
+        }
+
+    private:
+        struct Entry {
+            sp_ftbl *table = nullptr;
+            /// set on the render thread once it can never touch this table again
+            std::atomic<bool> done{false};
+            ~Entry() { if (table) sp_ftbl_destroy(&table); }
+        };
+
+        /// Entries are retired in publish order, so everything at or below
+        /// the newest finished entry is unreachable and can be freed.
+        void collect()
+        {
+            int i;
+            for (i = (int)retired.size() - 1; i >= 0; --i) {
+                if (retired[i]->done.load(std::memory_order_acquire)) break;
+            }
+            retired.erase(retired.begin(), retired.begin() + i + 1);
+        }
+
+        std::atomic<Entry *> next{nullptr};
+
+        /// render side
+        Entry *incoming = nullptr;
+        Entry *outgoingEntry = nullptr;
+
+        /// sender side; owns every entry until collect() frees it
+        std::vector<std::unique_ptr<Entry>> retired;
+    };
+
+}
+
+#endif
@@ -1,20 +1,31 @@
 // Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
 
 #include "DSPBase.h"
-#import "../../Internals/Utilities/readerwriterqueue.h"
-
-using moodycamel::ReaderWriterQueue;
+#include "TPCircularBuffer.h"
 
 typedef void (^CMIDICallback)(uint8_t, uint8_t, uint8_t);
 
+/// One MIDI message as it crosses from the render thread to the timer,
+/// stamped with the sample time it was rendered at.
+struct CallbackMIDIRecord {
+    int64_t sampleTime;
+    uint8_t status;
+    uint8_t data1;
+    uint8_t data2;
+};
+
 class CallbackInstrumentDSP : public DSPBase {
 public:
     // MARK: Member Functions
 
-    ReaderWriterQueue<AUMIDIEvent> midiBuffer;
+    TPCircularBuffer midiBuffer;
     NSTimer* timer;
 
     CallbackInstrumentDSP() {
+        // Room for several thousand records; produce is wait-free and simply
+        // drops on overflow rather than blocking the render thread.
+        TPCircularBufferInit(&midiBuffer, 4096 * sizeof(CallbackMIDIRecord));
+
         // Hopefully this polling interval is ok.
         timer = [NSTimer scheduledTimerWithTimeInterval:0.01
                                                 repeats:true
@@ -25,8 +36,9 @@ public:
 
     ~CallbackInstrumentDSP() {
         [timer invalidate];
+        TPCircularBufferCleanup(&midiBuffer);
     }
-    
+
     void start() override {
         started = true;
     }
@@ -54,31 +66,33 @@ public:
 
     void handleMIDIEvent(AUMIDIEvent const& midiEvent) override {
         if (midiEvent.length != 3) return;
-        midiBuffer.enqueue(midiEvent);
+        CallbackMIDIRecord record = { midiEvent.eventSampleTime,
+                                      midiEvent.data[0],
+                                      midiEvent.data[1],
+                                      midiEvent.data[2] };
+        TPCircularBufferProduceBytes(&midiBuffer, &record, sizeof(record));
     }
 
     void consumer() {
+        // Drain everything queued since the last tick in one pass, so dense
+        // sequences cost one buffer walk instead of one tick per event.
         int32_t availableBytes;
-        AUMIDIEvent event = AUMIDIEvent();
-        midiBuffer.try_dequeue(event);
-        if(event.length > 0) {
-            int32_t messageCount = sizeof(event.data) / 3;
-
-            if(callback) {
-                for(int messageIndex=0; messageIndex < messageCount; ++messageIndex) {
-                    uint8_t status = event.data[3*messageIndex];
-                    uint8_t data1 = event.data[3*messageIndex+1];
-                    uint8_t data2 = event.data[3*messageIndex+2];
-                    callback(status, data1, data2);
-                }
+        auto* record = (CallbackMIDIRecord*)TPCircularBufferTail(&midiBuffer, &availableBytes);
+        int32_t recordCount = availableBytes / (int32_t)sizeof(CallbackMIDIRecord);
+        if (record == nullptr || recordCount == 0) return;
+
+        if (callback) {
+            for (int32_t i = 0; i < recordCount; ++i) {
+                callback(record[i].status, record[i].data1, record[i].data2);
             }
         }
+        TPCircularBufferConsume(&midiBuffer, recordCount * (int32_t)sizeof(CallbackMIDIRecord));
     }
-    
+
     void setCallback(CMIDICallback func) {
         callback = func;
     }
-    
+
 private:
     int count = 0;
     int lastFrameCount = 0;
@@ -3,6 +3,7 @@
 #include "SoundpipeDSPBase.h"
 #include "ParameterRamper.h"
 #include "soundpipe.h"
+#include <math.h>
 
 enum BitCrusherParameter : AUParameterAddress {
     BitCrusherParameterBitDepth,
@@ -43,6 +44,43 @@ public:
         sp_bitcrush_init(sp, bitcrush1);
     }
 
+    void processBlock(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        if (!isStarted || channelCount > 2) {
+            DSPBase::processBlock(frameCount, bufferOffset);
+            return;
+        }
+        // no oversampling here — the crusher's aliasing is the effect; the
+        // win is hoisting pow/floor parameter math out of the sample loop
+        // and running the sample-hold fold inline over the block
+        bitDepthRamp.stepBy(frameCount);
+        sampleRateRamp.stepBy(frameCount);
+        float bits = powf(2.0f, floorf(bitDepthRamp.get()));
+        float gain = bits / 65536.0f;
+        float igain = 65536.0f / bits;
+        float foldamt = float(sampleRate) / sampleRateRamp.get();
+        for (int channel = 0; channel < channelCount; ++channel) {
+            sp_fold *fold = (channel == 0 ? bitcrush0 : bitcrush1)->fold;
+            fold->incr = foldamt;
+            SPFLOAT index = fold->index;
+            int32_t sampleIndex = fold->sample_index;
+            SPFLOAT value = fold->value;
+            const float *in = (const float *)inputBufferLists[0]->mBuffers[channel].mData + bufferOffset;
+            float *out = (float *)outputBufferList->mBuffers[channel].mData + bufferOffset;
+            for (int i = 0; i < int(frameCount); ++i) {
+                float crushed = floorf((in[i] * 65536.0f + 32768.0f) * gain) * igain - 32768.0f;
+                if (index < (SPFLOAT)sampleIndex) {
+                    index += foldamt;
+                    value = crushed;
+                }
+                sampleIndex++;
+                out[i] = value / 65536.0f;
+            }
+            fold->index = index;
+            fold->sample_index = sampleIndex;
+            fold->value = value;
+        }
+    }
+
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
         for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
             int frameOffset = int(frameIndex + bufferOffset);
@@ -3,6 +3,7 @@
 #include "SoundpipeDSPBase.h"
 #include "ParameterRamper.h"
 #include "soundpipe.h"
+#include "WaveShaperEngine.h"
 
 enum ClipperParameter : AUParameterAddress {
     ClipperParameterLimit,
@@ -13,6 +14,7 @@ private:
     sp_clip *clip0;
     sp_clip *clip1;
     ParameterRamper limitRamp;
+    AudioKitCore::Oversampler oversampler[2];
 
 public:
     ClipperDSP() {
@@ -25,6 +27,7 @@ public:
         sp_clip_init(sp, clip0);
         sp_clip_create(&clip1);
         sp_clip_init(sp, clip1);
+        for (int i = 0; i < 2; ++i) oversampler[i].init(2);
     }
 
     void deinit() override {
@@ -38,6 +41,28 @@ public:
         if (!isInitialized) return;
         sp_clip_init(sp, clip0);
         sp_clip_init(sp, clip1);
+        for (int i = 0; i < 2; ++i) oversampler[i].reset();
+    }
+
+    void processBlock(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        if (!isStarted || channelCount > 2) {
+            DSPBase::processBlock(frameCount, bufferOffset);
+            return;
+        }
+        const int chunkSize = 64;
+        for (AUAudioFrameCount start = 0; start < frameCount; start += chunkSize) {
+            int chunk = int(frameCount - start);
+            if (chunk > chunkSize) chunk = chunkSize;
+            limitRamp.stepBy(chunk);
+            float limit = limitRamp.get();
+            for (int channel = 0; channel < channelCount; ++channel) {
+                const float *in = (const float *)inputBufferLists[0]->mBuffers[channel].mData + bufferOffset + start;
+                float *out = (float *)outputBufferList->mBuffers[channel].mData + bufferOffset + start;
+                oversampler[channel].process(in, out, chunk, [=](const float *x, float *y, int n) {
+                    AudioKitCore::sineClipShape(x, y, n, limit);
+                });
+            }
+        }
     }
 
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
@@ -15,7 +15,7 @@ enum DiodeClipperParameter {
     DiodeClipperParameterGaindB
 };
 
-using DiodeClipperDSP = SoulDSP<Diode>;
+using DiodeClipperDSP = StereoSoulDSP<Diode>;
 AK_REGISTER_DSP(DiodeClipperDSP)
 AK_REGISTER_PARAMETER(DiodeClipperParameterCutoff)
 AK_REGISTER_PARAMETER(DiodeClipperParameterGaindB)
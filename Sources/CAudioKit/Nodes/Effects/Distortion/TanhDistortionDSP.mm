@@ -3,6 +3,7 @@
 #include "SoundpipeDSPBase.h"
 #include "ParameterRamper.h"
 #include "soundpipe.h"
+#include "WaveShaperEngine.h"
 
 enum TanhDistortionParameter : AUParameterAddress {
     TanhDistortionParameterPregain,
@@ -19,6 +20,7 @@ private:
     ParameterRamper postgainRamp;
     ParameterRamper positiveShapeParameterRamp;
     ParameterRamper negativeShapeParameterRamp;
+    AudioKitCore::Oversampler oversampler[2];
 
 public:
     TanhDistortionDSP() {
@@ -34,6 +36,7 @@ public:
         sp_dist_init(sp, dist0);
         sp_dist_create(&dist1);
         sp_dist_init(sp, dist1);
+        for (int i = 0; i < 2; ++i) oversampler[i].init(2);
     }
 
     void deinit() override {
@@ -47,6 +50,36 @@ public:
         if (!isInitialized) return;
         sp_dist_init(sp, dist0);
         sp_dist_init(sp, dist1);
+        for (int i = 0; i < 2; ++i) oversampler[i].reset();
+    }
+
+    void processBlock(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        if (!isStarted || channelCount > 2) {
+            DSPBase::processBlock(frameCount, bufferOffset);
+            return;
+        }
+        // the Csound scaling constants from sp_dist_compute fold into the
+        // shaper arguments once per chunk instead of once per sample
+        const int chunkSize = 64;
+        for (AUAudioFrameCount start = 0; start < frameCount; start += chunkSize) {
+            int chunk = int(frameCount - start);
+            if (chunk > chunkSize) chunk = chunkSize;
+            pregainRamp.stepBy(chunk);
+            postgainRamp.stepBy(chunk);
+            positiveShapeParameterRamp.stepBy(chunk);
+            negativeShapeParameterRamp.stepBy(chunk);
+            float pregain = pregainRamp.get() * 6.5536f;
+            float postgain = postgainRamp.get() * 0.61035156f * 0.5f;
+            float shape1 = positiveShapeParameterRamp.get() * 4.096f + pregain;
+            float shape2 = negativeShapeParameterRamp.get() * 4.096f - pregain;
+            for (int channel = 0; channel < channelCount; ++channel) {
+                const float *in = (const float *)inputBufferLists[0]->mBuffers[channel].mData + bufferOffset + start;
+                float *out = (float *)outputBufferList->mBuffers[channel].mData + bufferOffset + start;
+                oversampler[channel].process(in, out, chunk, [=](const float *x, float *y, int n) {
+                    AudioKitCore::tanhDistShape(x, y, n, shape1, shape2, pregain, postgain);
+                });
+            }
+        }
     }
 
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
@@ -3,12 +3,17 @@
 #include "SoundpipeDSPBase.h"
 #include "ParameterRamper.h"
 #include "soundpipe.h"
+#include "CompressorEngine.h"
+
+#include <algorithm>
+#include <cmath>
 
 enum DynamicRangeCompressorParameter : AUParameterAddress {
     DynamicRangeCompressorParameterRatio,
     DynamicRangeCompressorParameterThreshold,
     DynamicRangeCompressorParameterAttackDuration,
     DynamicRangeCompressorParameterReleaseDuration,
+    DynamicRangeCompressorParameterChannelLink,
 };
 
 class DynamicRangeCompressorDSP : public SoundpipeDSPBase {
@@ -19,6 +24,10 @@ private:
     ParameterRamper thresholdRamp;
     ParameterRamper attackDurationRamp;
     ParameterRamper releaseDurationRamp;
+    AudioKitCore::BlockCompressor blockCompressor[2];
+    // linked mode: one envelope follows max(|L|,|R|) and its gain feeds
+    // both channels, so the image can't drift between two detectors
+    bool channelsLinked = false;
 
 public:
     DynamicRangeCompressorDSP() {
@@ -34,6 +43,7 @@ public:
         sp_compressor_init(sp, compressor0);
         sp_compressor_create(&compressor1);
         sp_compressor_init(sp, compressor1);
+        for (int i = 0; i < 2; ++i) blockCompressor[i].init(sampleRate);
     }
 
     void deinit() override {
@@ -47,6 +57,69 @@ public:
         if (!isInitialized) return;
         sp_compressor_init(sp, compressor0);
         sp_compressor_init(sp, compressor1);
+        for (int i = 0; i < 2; ++i) blockCompressor[i].reset();
+    }
+
+    void setParameter(AUParameterAddress address, float value, bool immediate) override {
+        if (address == DynamicRangeCompressorParameterChannelLink) {
+            channelsLinked = value > 0.5f;
+        }
+        else {
+            DSPBase::setParameter(address, value, immediate);
+        }
+    }
+
+    float getParameter(AUParameterAddress address) override {
+        if (address == DynamicRangeCompressorParameterChannelLink) {
+            return channelsLinked ? 1.f : 0.f;
+        }
+        else {
+            return DSPBase::getParameter(address);
+        }
+    }
+
+    void processBlock(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        if (!isStarted || channelCount > 2) {
+            DSPBase::processBlock(frameCount, bufferOffset);
+            return;
+        }
+        ratioRamp.stepBy(frameCount);
+        thresholdRamp.stepBy(frameCount);
+        attackDurationRamp.stepBy(frameCount);
+        releaseDurationRamp.stepBy(frameCount);
+        float ratio = ratioRamp.get();
+        float threshold = thresholdRamp.get();
+        float attackDuration = attackDurationRamp.get();
+        float releaseDuration = releaseDurationRamp.get();
+        if (channelsLinked && channelCount == 2) {
+            const float *inL = (const float *)inputBufferLists[0]->mBuffers[0].mData + bufferOffset;
+            const float *inR = (const float *)inputBufferLists[0]->mBuffers[1].mData + bufferOffset;
+            float *outL = (float *)outputBufferList->mBuffers[0].mData + bufferOffset;
+            float *outR = (float *)outputBufferList->mBuffers[1].mData + bufferOffset;
+            const int chunkSize = 64;
+            float det[chunkSize];
+            float gains[chunkSize];
+            for (int start = 0; start < int(frameCount); start += chunkSize) {
+                int chunk = int(frameCount) - start;
+                if (chunk > chunkSize) chunk = chunkSize;
+                for (int i = 0; i < chunk; ++i) {
+                    det[i] = std::max(fabsf(inL[start + i]), fabsf(inR[start + i]));
+                }
+                blockCompressor[0].computeGains(det, gains, chunk,
+                                                ratio, threshold, attackDuration, releaseDuration);
+                for (int i = 0; i < chunk; ++i) {
+                    outL[start + i] = gains[i] * inL[start + i];
+                    outR[start + i] = gains[i] * inR[start + i];
+                }
+            }
+            return;
+        }
+        for (int channel = 0; channel < channelCount; ++channel) {
+            const float *in = (const float *)inputBufferLists[0]->mBuffers[channel].mData + bufferOffset;
+            float *out = (float *)outputBufferList->mBuffers[channel].mData + bufferOffset;
+            blockCompressor[channel].process(in, out, int(frameCount),
+                                             ratio, threshold, attackDuration, releaseDuration);
+        }
     }
 
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
@@ -69,6 +142,21 @@ public:
             *compressor0->rel = releaseDuration;
             *compressor1->rel = releaseDuration;
 
+            if (channelsLinked && channelCount == 2 && isStarted) {
+                float *inL = (float *)inputBufferLists[0]->mBuffers[0].mData + frameOffset;
+                float *inR = (float *)inputBufferLists[0]->mBuffers[1].mData + frameOffset;
+                float *outL = (float *)outputBufferList->mBuffers[0].mData + frameOffset;
+                float *outR = (float *)outputBufferList->mBuffers[1].mData + frameOffset;
+                // unity input makes the sidechain compute yield the bare gain
+                float det = std::max(fabsf(*inL), fabsf(*inR));
+                float unity = 1.0f;
+                float gain = 1.0f;
+                sp_compressor_compute_det(sp, compressor0, &unity, &det, &gain);
+                *outL = gain * *inL;
+                *outR = gain * *inR;
+                continue;
+            }
+
             float *tmpin[2];
             float *tmpout[2];
             for (int channel = 0; channel < channelCount; ++channel) {
@@ -98,3 +186,4 @@ AK_REGISTER_PARAMETER(DynamicRangeCompressorParameterRatio)
 AK_REGISTER_PARAMETER(DynamicRangeCompressorParameterThreshold)
 AK_REGISTER_PARAMETER(DynamicRangeCompressorParameterAttackDuration)
 AK_REGISTER_PARAMETER(DynamicRangeCompressorParameterReleaseDuration)
+AK_REGISTER_PARAMETER(DynamicRangeCompressorParameterChannelLink)
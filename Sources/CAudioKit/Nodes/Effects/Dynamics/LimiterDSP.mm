@@ -0,0 +1,203 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+#include "DSPBase.h"
+#include "ParameterRamper.h"
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+enum LimiterParameter : AUParameterAddress {
+    LimiterParameterThreshold,
+    LimiterParameterLookaheadDuration,
+    LimiterParameterReleaseDuration,
+};
+
+/// Lookahead brickwall limiter. The signal is delayed by the lookahead
+/// window while the required gain is scanned with a sliding-window minimum
+/// (monotonic wedge, O(1) per sample), so the gain is already down when a
+/// peak reaches the output instead of over-limiting to stay safe. Gains are
+/// computed per chunk and applied to each channel as one block multiply.
+/// Optionally peaks are detected on a 4x polyphase-upsampled signal to catch
+/// inter-sample (true) peaks.
+class LimiterDSP : public DSPBase {
+private:
+    static constexpr int chunkSize = 32;
+    static constexpr int truePeakTaps = 8;
+    static constexpr int truePeakPhases = 4;
+
+    ParameterRamper thresholdRamp;
+    ParameterRamper lookaheadDurationRamp;
+    ParameterRamper releaseDurationRamp;
+
+    std::vector<float> delayLine[2];
+    std::vector<float> wedgeGain;
+    std::vector<int64_t> wedgeIndex;
+    int capacity = 0;
+    int writeIndex = 0;
+    int64_t wedgeHead = 0, wedgeTail = 0;
+    int64_t frameCounter = 0;
+    float smoothedGain = 1.0f;
+
+    bool truePeakEnabled = false;
+    float truePeakKernel[truePeakPhases][truePeakTaps] = {};
+    float truePeakHistory[2][truePeakTaps] = {};
+    int truePeakWrite = 0;
+
+public:
+    LimiterDSP() {
+        parameters[LimiterParameterThreshold] = &thresholdRamp;
+        parameters[LimiterParameterLookaheadDuration] = &lookaheadDurationRamp;
+        parameters[LimiterParameterReleaseDuration] = &releaseDurationRamp;
+
+        bCanProcessInPlace = true;
+    }
+
+    void setTruePeak(bool enabled) {
+        truePeakEnabled = enabled;
+    }
+
+    void init(int channelCount, double sampleRate) override {
+        DSPBase::init(channelCount, sampleRate);
+        // enough room for a 20 ms lookahead window
+        capacity = int(sampleRate * 0.02) + 1;
+        delayLine[0].assign(capacity, 0.0f);
+        delayLine[1].assign(capacity, 0.0f);
+        wedgeGain.assign(capacity + 1, 1.0f);
+        wedgeIndex.assign(capacity + 1, 0);
+
+        // windowed-sinc interpolation kernel for the 4x true-peak scan;
+        // phase 0 is the input sample itself and needs no kernel
+        for (int phase = 1; phase < truePeakPhases; ++phase) {
+            for (int tap = 0; tap < truePeakTaps; ++tap) {
+                double t = (tap - (truePeakTaps / 2 - 1)) - double(phase) / truePeakPhases;
+                double sinc = (t == 0.0) ? 1.0 : sin(M_PI * t) / (M_PI * t);
+                double window = 0.5 + 0.5 * cos(M_PI * t / (truePeakTaps / 2));
+                truePeakKernel[phase][tap] = float(sinc * window);
+            }
+        }
+        reset();
+    }
+
+    void reset() override {
+        DSPBase::reset();
+        std::fill(delayLine[0].begin(), delayLine[0].end(), 0.0f);
+        std::fill(delayLine[1].begin(), delayLine[1].end(), 0.0f);
+        memset(truePeakHistory, 0, sizeof(truePeakHistory));
+        writeIndex = 0;
+        wedgeHead = wedgeTail = 0;
+        frameCounter = 0;
+        truePeakWrite = 0;
+        smoothedGain = 1.0f;
+    }
+
+    void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        const float *inBuffers[2];
+        float *outBuffers[2];
+        int stereo = channelCount > 1;
+        inBuffers[0]  = (const float *)inputBufferLists[0]->mBuffers[0].mData + bufferOffset;
+        inBuffers[1]  = (const float *)inputBufferLists[0]->mBuffers[stereo].mData + bufferOffset;
+        outBuffers[0] = (float *)outputBufferList->mBuffers[0].mData + bufferOffset;
+        outBuffers[1] = (float *)outputBufferList->mBuffers[stereo].mData + bufferOffset;
+
+        if (!isStarted) {
+            for (int channel = 0; channel <= stereo; ++channel) {
+                memcpy(outBuffers[channel], inBuffers[channel], frameCount * sizeof(float));
+            }
+            return;
+        }
+
+        for (int frameIndex = 0; frameIndex < int(frameCount); frameIndex += chunkSize) {
+            int frames = int(frameCount) - frameIndex;
+            if (frames > chunkSize) frames = chunkSize;
+
+            thresholdRamp.stepBy(frames);
+            lookaheadDurationRamp.stepBy(frames);
+            releaseDurationRamp.stepBy(frames);
+            float threshold = exp2f(thresholdRamp.get() / 6.0206f);
+            int lookahead = int(lookaheadDurationRamp.get() * sampleRate);
+            if (lookahead < 1) lookahead = 1;
+            if (lookahead > capacity - 1) lookahead = capacity - 1;
+            // gain must settle within the lookahead window
+            float attackCoeff = 1.0f - expf(-6.0f / lookahead);
+            float releaseCoeff = 1.0f - expf(-1.0f / (releaseDurationRamp.get() * sampleRate + 1.0f));
+
+            float gains[chunkSize];
+
+            for (int i = 0; i < frames; ++i) {
+                float x0 = inBuffers[0][frameIndex + i];
+                float x1 = inBuffers[1][frameIndex + i];
+                float peak = peakOf(x0, x1, stereo);
+
+                // required gain for this input, then sliding minimum over
+                // the lookahead window so the reduction leads the peak
+                float required = (peak > threshold) ? threshold / peak : 1.0f;
+                int slots = capacity + 1;
+                while (wedgeTail > wedgeHead && wedgeGain[(wedgeTail - 1) % slots] >= required) {
+                    wedgeTail--;
+                }
+                wedgeGain[wedgeTail % slots] = required;
+                wedgeIndex[wedgeTail % slots] = frameCounter;
+                wedgeTail++;
+                while (wedgeIndex[wedgeHead % slots] < frameCounter - lookahead) {
+                    wedgeHead++;
+                }
+                float target = wedgeGain[wedgeHead % slots];
+
+                if (target < smoothedGain) {
+                    smoothedGain += attackCoeff * (target - smoothedGain);
+                } else {
+                    smoothedGain += releaseCoeff * (target - smoothedGain);
+                }
+                gains[i] = smoothedGain;
+
+                // swap the delayed samples into the output buffers
+                int readIndex = writeIndex - lookahead;
+                if (readIndex < 0) readIndex += capacity;
+                outBuffers[0][frameIndex + i] = delayLine[0][readIndex];
+                outBuffers[1][frameIndex + i] = delayLine[1][readIndex];
+                delayLine[0][writeIndex] = x0;
+                delayLine[1][writeIndex] = x1;
+                if (++writeIndex == capacity) writeIndex = 0;
+                frameCounter++;
+            }
+
+            for (int channel = 0; channel <= stereo; ++channel) {
+                float *out = outBuffers[channel] + frameIndex;
+                for (int i = 0; i < frames; ++i) out[i] *= gains[i];
+            }
+        }
+    }
+
+private:
+    float peakOf(float x0, float x1, int stereo) {
+        float peak = fabsf(x0);
+        if (stereo) peak = fmaxf(peak, fabsf(x1));
+        if (!truePeakEnabled) return peak;
+
+        truePeakHistory[0][truePeakWrite] = x0;
+        truePeakHistory[1][truePeakWrite] = x1;
+        if (++truePeakWrite == truePeakTaps) truePeakWrite = 0;
+        for (int channel = 0; channel <= stereo; ++channel) {
+            for (int phase = 1; phase < truePeakPhases; ++phase) {
+                float y = 0.0f;
+                for (int tap = 0; tap < truePeakTaps; ++tap) {
+                    int index = truePeakWrite + tap;
+                    if (index >= truePeakTaps) index -= truePeakTaps;
+                    y += truePeakKernel[phase][tap] * truePeakHistory[channel][index];
+                }
+                peak = fmaxf(peak, fabsf(y));
+            }
+        }
+        return peak;
+    }
+};
+
+AK_API void akLimiterSetTruePeak(DSPRef dsp, bool enabled) {
+    ((LimiterDSP*)dsp)->setTruePeak(enabled);
+}
+
+AK_REGISTER_DSP(LimiterDSP)
+AK_REGISTER_PARAMETER(LimiterParameterThreshold)
+AK_REGISTER_PARAMETER(LimiterParameterLookaheadDuration)
+AK_REGISTER_PARAMETER(LimiterParameterReleaseDuration)
@@ -0,0 +1,185 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+#include "DSPBase.h"
+#include "ParameterRamper.h"
+#include "CrossoverEngine.h"
+#include "CompressorEngine.h"
+
+#include <cstring>
+
+enum MultibandDynamicsParameter : AUParameterAddress {
+    MultibandDynamicsParameterCrossover1,
+    MultibandDynamicsParameterCrossover2,
+    MultibandDynamicsParameterCrossover3,
+    MultibandDynamicsParameterThreshold1,
+    MultibandDynamicsParameterThreshold2,
+    MultibandDynamicsParameterThreshold3,
+    MultibandDynamicsParameterThreshold4,
+    MultibandDynamicsParameterRatio1,
+    MultibandDynamicsParameterRatio2,
+    MultibandDynamicsParameterRatio3,
+    MultibandDynamicsParameterRatio4,
+    MultibandDynamicsParameterAttackDuration,
+    MultibandDynamicsParameterReleaseDuration,
+};
+
+/// Four-band compressor in a single node: a tree of three Linkwitz-Riley
+/// splits feeds one BlockCompressor per band per channel, all processed in
+/// one block pass over a shared set of chunk-sized scratch buffers. This
+/// replaces the 8-filter-plus-4-compressor graph we used to assemble for the
+/// same topology.
+class MultibandDynamicsDSP : public DSPBase {
+private:
+    static constexpr int numBands = 4;
+
+    AudioKitCore::LinkwitzRileySplitter splitters[numBands - 1];
+    AudioKitCore::BlockCompressor compressors[numBands][2];
+    ParameterRamper crossoverRamps[numBands - 1];
+    ParameterRamper thresholdRamps[numBands];
+    ParameterRamper ratioRamps[numBands];
+    ParameterRamper attackDurationRamp;
+    ParameterRamper releaseDurationRamp;
+
+public:
+    MultibandDynamicsDSP() {
+        parameters[MultibandDynamicsParameterCrossover1] = &crossoverRamps[0];
+        parameters[MultibandDynamicsParameterCrossover2] = &crossoverRamps[1];
+        parameters[MultibandDynamicsParameterCrossover3] = &crossoverRamps[2];
+        parameters[MultibandDynamicsParameterThreshold1] = &thresholdRamps[0];
+        parameters[MultibandDynamicsParameterThreshold2] = &thresholdRamps[1];
+        parameters[MultibandDynamicsParameterThreshold3] = &thresholdRamps[2];
+        parameters[MultibandDynamicsParameterThreshold4] = &thresholdRamps[3];
+        parameters[MultibandDynamicsParameterRatio1] = &ratioRamps[0];
+        parameters[MultibandDynamicsParameterRatio2] = &ratioRamps[1];
+        parameters[MultibandDynamicsParameterRatio3] = &ratioRamps[2];
+        parameters[MultibandDynamicsParameterRatio4] = &ratioRamps[3];
+        parameters[MultibandDynamicsParameterAttackDuration] = &attackDurationRamp;
+        parameters[MultibandDynamicsParameterReleaseDuration] = &releaseDurationRamp;
+
+        bCanProcessInPlace = true;
+    }
+
+    void init(int channelCount, double sampleRate) override {
+        DSPBase::init(channelCount, sampleRate);
+        for (int band = 0; band < numBands; ++band) {
+            compressors[band][0].init(sampleRate);
+            compressors[band][1].init(sampleRate);
+        }
+    }
+
+    void reset() override {
+        DSPBase::reset();
+        for (int i = 0; i < numBands - 1; ++i) {
+            splitters[i].reset();
+        }
+        for (int band = 0; band < numBands; ++band) {
+            compressors[band][0].reset();
+            compressors[band][1].reset();
+        }
+    }
+
+#define CHUNKSIZE 32    // defines ramp and crossover redesign interval
+
+    void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        const float *inBuffers[2];
+        float *outBuffers[2];
+        int stereo = channelCount > 1;
+        inBuffers[0]  = (const float *)inputBufferLists[0]->mBuffers[0].mData + bufferOffset;
+        inBuffers[1]  = (const float *)inputBufferLists[0]->mBuffers[stereo].mData + bufferOffset;
+        outBuffers[0] = (float *)outputBufferList->mBuffers[0].mData + bufferOffset;
+        outBuffers[1] = (float *)outputBufferList->mBuffers[stereo].mData + bufferOffset;
+
+        if (!isStarted)
+        {
+            for (int channel = 0; channel <= stereo; ++channel) {
+                memcpy(outBuffers[channel], inBuffers[channel], frameCount * sizeof(float));
+            }
+            return;
+        }
+
+        for (int frameIndex = 0; frameIndex < int(frameCount); frameIndex += CHUNKSIZE)
+        {
+            int chunkSize = frameCount - frameIndex;
+            if (chunkSize > CHUNKSIZE) chunkSize = CHUNKSIZE;
+
+            float crossovers[numBands - 1];
+            float thresholds[numBands];
+            float ratios[numBands];
+            for (int i = 0; i < numBands - 1; ++i) {
+                crossoverRamps[i].stepBy(chunkSize);
+                crossovers[i] = crossoverRamps[i].get();
+                // keep the split tree ordered if the ramps cross over briefly
+                if (i > 0 && crossovers[i] < crossovers[i - 1]) crossovers[i] = crossovers[i - 1];
+            }
+            for (int band = 0; band < numBands; ++band) {
+                thresholdRamps[band].stepBy(chunkSize);
+                ratioRamps[band].stepBy(chunkSize);
+                thresholds[band] = thresholdRamps[band].get();
+                ratios[band] = ratioRamps[band].get();
+            }
+            attackDurationRamp.stepBy(chunkSize);
+            releaseDurationRamp.stepBy(chunkSize);
+            float attack = attackDurationRamp.get();
+            float release = releaseDurationRamp.get();
+
+            // band split: each stage peels the lowest remaining band off the
+            // rest of the spectrum, so every band shares one set of buffers
+            float band[2][CHUNKSIZE];
+            float restA[2][CHUNKSIZE];
+            float restB[2][CHUNKSIZE];
+            float sum[2][CHUNKSIZE];
+
+            splitters[0].process(sampleRate, crossovers[0],
+                                 inBuffers[0] + frameIndex, inBuffers[1] + frameIndex,
+                                 band[0], band[1], restA[0], restA[1], chunkSize);
+            compressBand(0, band, sum, /*accumulate*/ false, chunkSize, thresholds, ratios, attack, release);
+
+            splitters[1].process(sampleRate, crossovers[1],
+                                 restA[0], restA[1],
+                                 band[0], band[1], restB[0], restB[1], chunkSize);
+            compressBand(1, band, sum, true, chunkSize, thresholds, ratios, attack, release);
+
+            splitters[2].process(sampleRate, crossovers[2],
+                                 restB[0], restB[1],
+                                 band[0], band[1], restA[0], restA[1], chunkSize);
+            compressBand(2, band, sum, true, chunkSize, thresholds, ratios, attack, release);
+            compressBand(3, restA, sum, true, chunkSize, thresholds, ratios, attack, release);
+
+            for (int channel = 0; channel <= stereo; ++channel) {
+                memcpy(outBuffers[channel] + frameIndex, sum[channel], chunkSize * sizeof(float));
+            }
+        }
+    }
+
+private:
+    void compressBand(int bandIndex, float (&band)[2][CHUNKSIZE], float (&sum)[2][CHUNKSIZE],
+                      bool accumulate, int chunkSize,
+                      const float *thresholds, const float *ratios, float attack, float release)
+    {
+        for (int channel = 0; channel < 2; ++channel) {
+            compressors[bandIndex][channel].process(band[channel], band[channel], chunkSize,
+                                                    ratios[bandIndex], thresholds[bandIndex],
+                                                    attack, release);
+            if (accumulate) {
+                for (int i = 0; i < chunkSize; ++i) sum[channel][i] += band[channel][i];
+            } else {
+                for (int i = 0; i < chunkSize; ++i) sum[channel][i] = band[channel][i];
+            }
+        }
+    }
+};
+
+AK_REGISTER_DSP(MultibandDynamicsDSP)
+AK_REGISTER_PARAMETER(MultibandDynamicsParameterCrossover1)
+AK_REGISTER_PARAMETER(MultibandDynamicsParameterCrossover2)
+AK_REGISTER_PARAMETER(MultibandDynamicsParameterCrossover3)
+AK_REGISTER_PARAMETER(MultibandDynamicsParameterThreshold1)
+AK_REGISTER_PARAMETER(MultibandDynamicsParameterThreshold2)
+AK_REGISTER_PARAMETER(MultibandDynamicsParameterThreshold3)
+AK_REGISTER_PARAMETER(MultibandDynamicsParameterThreshold4)
+AK_REGISTER_PARAMETER(MultibandDynamicsParameterRatio1)
+AK_REGISTER_PARAMETER(MultibandDynamicsParameterRatio2)
+AK_REGISTER_PARAMETER(MultibandDynamicsParameterRatio3)
+AK_REGISTER_PARAMETER(MultibandDynamicsParameterRatio4)
+AK_REGISTER_PARAMETER(MultibandDynamicsParameterAttackDuration)
+AK_REGISTER_PARAMETER(MultibandDynamicsParameterReleaseDuration)
@@ -0,0 +1,136 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+#include "SoundpipeDSPBase.h"
+#include "ParameterRamper.h"
+#include "soundpipe.h"
+#include "CompressorEngine.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Compressor whose detector is a second input bus (the classic kick-ducks-
+// bass patch). One envelope follows the loudest detector channel and its
+// gain feeds every audio channel, so an N-channel bus costs one detector
+// computation instead of N drifting ones.
+
+enum SidechainCompressorParameter : AUParameterAddress {
+    SidechainCompressorParameterRatio,
+    SidechainCompressorParameterThreshold,
+    SidechainCompressorParameterAttackDuration,
+    SidechainCompressorParameterReleaseDuration,
+};
+
+class SidechainCompressorDSP : public SoundpipeDSPBase {
+private:
+    sp_compressor *compressor0;
+    ParameterRamper ratioRamp;
+    ParameterRamper thresholdRamp;
+    ParameterRamper attackDurationRamp;
+    ParameterRamper releaseDurationRamp;
+    AudioKitCore::BlockCompressor blockCompressor;
+
+public:
+    SidechainCompressorDSP() {
+        inputBufferLists.resize(2);
+        parameters[SidechainCompressorParameterRatio] = &ratioRamp;
+        parameters[SidechainCompressorParameterThreshold] = &thresholdRamp;
+        parameters[SidechainCompressorParameterAttackDuration] = &attackDurationRamp;
+        parameters[SidechainCompressorParameterReleaseDuration] = &releaseDurationRamp;
+    }
+
+    void init(int channelCount, double sampleRate) override {
+        SoundpipeDSPBase::init(channelCount, sampleRate);
+        sp_compressor_create(&compressor0);
+        sp_compressor_init(sp, compressor0);
+        blockCompressor.init(sampleRate);
+    }
+
+    void deinit() override {
+        SoundpipeDSPBase::deinit();
+        sp_compressor_destroy(&compressor0);
+    }
+
+    void reset() override {
+        SoundpipeDSPBase::reset();
+        if (!isInitialized) return;
+        sp_compressor_init(sp, compressor0);
+        blockCompressor.reset();
+    }
+
+    void processBlock(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        if (!isStarted) {
+            DSPBase::processBlock(frameCount, bufferOffset);
+            return;
+        }
+        ratioRamp.stepBy(frameCount);
+        thresholdRamp.stepBy(frameCount);
+        attackDurationRamp.stepBy(frameCount);
+        releaseDurationRamp.stepBy(frameCount);
+        float ratio = ratioRamp.get();
+        float threshold = thresholdRamp.get();
+        float attackDuration = attackDurationRamp.get();
+        float releaseDuration = releaseDurationRamp.get();
+
+        uint32_t detChannels = inputBufferLists[1]->mNumberBuffers;
+        const int chunkSize = 64;
+        float det[chunkSize];
+        float gains[chunkSize];
+        for (int start = 0; start < int(frameCount); start += chunkSize) {
+            int chunk = int(frameCount) - start;
+            if (chunk > chunkSize) chunk = chunkSize;
+            const float *det0 = (const float *)inputBufferLists[1]->mBuffers[0].mData
+                                + bufferOffset + start;
+            for (int i = 0; i < chunk; ++i) det[i] = fabsf(det0[i]);
+            for (uint32_t ch = 1; ch < detChannels; ++ch) {
+                const float *d = (const float *)inputBufferLists[1]->mBuffers[ch].mData
+                                 + bufferOffset + start;
+                for (int i = 0; i < chunk; ++i) det[i] = std::max(det[i], fabsf(d[i]));
+            }
+            blockCompressor.computeGains(det, gains, chunk,
+                                         ratio, threshold, attackDuration, releaseDuration);
+            for (int channel = 0; channel < channelCount; ++channel) {
+                const float *in = (const float *)inputBufferLists[0]->mBuffers[channel].mData
+                                  + bufferOffset + start;
+                float *out = (float *)outputBufferList->mBuffers[channel].mData
+                             + bufferOffset + start;
+                for (int i = 0; i < chunk; ++i) out[i] = gains[i] * in[i];
+            }
+        }
+    }
+
+    void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        uint32_t detChannels = inputBufferLists[1]->mNumberBuffers;
+        for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+            int frameOffset = int(frameIndex + bufferOffset);
+
+            *compressor0->ratio = ratioRamp.getAndStep();
+            *compressor0->thresh = thresholdRamp.getAndStep();
+            *compressor0->atk = attackDurationRamp.getAndStep();
+            *compressor0->rel = releaseDurationRamp.getAndStep();
+
+            float det = 0.0f;
+            for (uint32_t ch = 0; ch < detChannels; ++ch) {
+                float *d = (float *)inputBufferLists[1]->mBuffers[ch].mData + frameOffset;
+                det = std::max(det, fabsf(*d));
+            }
+            // unity input makes the sidechain compute yield the bare gain
+            float unity = 1.0f;
+            float gain = 1.0f;
+            if (isStarted) {
+                sp_compressor_compute_det(sp, compressor0, &unity, &det, &gain);
+            }
+
+            for (int channel = 0; channel < channelCount; ++channel) {
+                float *in = (float *)inputBufferLists[0]->mBuffers[channel].mData + frameOffset;
+                float *out = (float *)outputBufferList->mBuffers[channel].mData + frameOffset;
+                *out = isStarted ? gain * *in : *in;
+            }
+        }
+    }
+};
+
+AK_REGISTER_DSP(SidechainCompressorDSP)
+AK_REGISTER_PARAMETER(SidechainCompressorParameterRatio)
+AK_REGISTER_PARAMETER(SidechainCompressorParameterThreshold)
+AK_REGISTER_PARAMETER(SidechainCompressorParameterAttackDuration)
+AK_REGISTER_PARAMETER(SidechainCompressorParameterReleaseDuration)
@@ -1,9 +1,13 @@
 // Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
 
 #include "DSPBase.h"
+#include "DSPVectorOps.h"
 #include "ParameterRamper.h"
 #include "AudioKitCore/Modulated Delay/StereoDelay.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 /*
  The objects marked Cyclone were derived from the Max/MSP Cyclone library source code.
  The license for this code can be found below:
@@ -262,16 +266,16 @@ enum TransientShaperParameter : AUParameterAddress {
 
 class TransientShaperDSP : public DSPBase {
 private:
-    rmsaverage *leftRMSAverage1;
-    rmsaverage *rightRMSAverage1;
-    rmsaverage *leftRMSAverage2;
-    rmsaverage *rightRMSAverage2;
-    slide *leftAttackSlideUp;
-    slide *rightAttackSlideUp;
-    slide *leftAttackSlideDown;
-    slide *rightAttackSlideDown;
-    slide *leftReleaseSlideDown;
-    slide *rightReleaseSlideDown;
+    rmsaverage *leftRMSAverage1 = nullptr;
+    rmsaverage *rightRMSAverage1 = nullptr;
+    rmsaverage *leftRMSAverage2 = nullptr;
+    rmsaverage *rightRMSAverage2 = nullptr;
+    // the detector signal is the L/R RMS mix and therefore mono, so one
+    // slide chain serves both channels; the old per-channel twins always
+    // computed identical values on identical input
+    slide *attackSlideUp = nullptr;
+    slide *attackSlideDown = nullptr;
+    slide *releaseSlideDown = nullptr;
 
     AudioKitCore::StereoDelay delay1;
 
@@ -308,18 +312,12 @@ public:
         rmsaverage_init(leftRMSAverage2, 882);
         rmsaverage_create(&rightRMSAverage2);
         rmsaverage_init(rightRMSAverage2, 882);
-        slide_create(&leftAttackSlideUp);
-        slide_init(leftAttackSlideUp, 882, 0);
-        slide_create(&rightAttackSlideUp);
-        slide_init(rightAttackSlideUp, 882, 0);
-        slide_create(&leftAttackSlideDown);
-        slide_init(leftAttackSlideDown, 0, 882);
-        slide_create(&rightAttackSlideDown);
-        slide_init(rightAttackSlideDown, 0, 882);
-        slide_create(&leftReleaseSlideDown);
-        slide_init(leftReleaseSlideDown, 0, 44100);
-        slide_create(&rightReleaseSlideDown);
-        slide_init(rightReleaseSlideDown, 0, 44100);
+        slide_create(&attackSlideUp);
+        slide_init(attackSlideUp, 882, 0);
+        slide_create(&attackSlideDown);
+        slide_init(attackSlideDown, 0, 882);
+        slide_create(&releaseSlideDown);
+        slide_init(releaseSlideDown, 0, 44100);
 
         delay1.init(sampleRate, 10);
     }
@@ -331,39 +329,26 @@ public:
         rmsaverage_destroy(&rightRMSAverage1);
         rmsaverage_destroy(&leftRMSAverage2);
         rmsaverage_destroy(&rightRMSAverage2);
-        slide_destroy(&leftAttackSlideUp);
-        slide_destroy(&rightAttackSlideUp);
-        slide_destroy(&leftAttackSlideDown);
-        slide_destroy(&rightAttackSlideDown);
-        slide_destroy(&leftReleaseSlideDown);
-        slide_destroy(&rightReleaseSlideDown);
+        slide_destroy(&attackSlideUp);
+        slide_destroy(&attackSlideDown);
+        slide_destroy(&releaseSlideDown);
 
         delay1.deinit();
     }
 
     void reset() override {
         DSPBase::reset();
+        if (leftRMSAverage1 == nullptr) return;
 
-        rmsaverage_create(&leftRMSAverage1);
+        // re-initialize the existing units in place; the old code
+        // recreated them all and leaked the previous set
         rmsaverage_init(leftRMSAverage1, 441);
-        rmsaverage_create(&rightRMSAverage1);
         rmsaverage_init(rightRMSAverage1, 441);
-        rmsaverage_create(&leftRMSAverage2);
         rmsaverage_init(leftRMSAverage2, 882);
-        rmsaverage_create(&rightRMSAverage2);
         rmsaverage_init(rightRMSAverage2, 882);
-        slide_create(&leftAttackSlideUp);
-        slide_init(leftAttackSlideUp, 882, 0);
-        slide_create(&rightAttackSlideUp);
-        slide_init(rightAttackSlideUp, 882, 0);
-        slide_create(&leftAttackSlideDown);
-        slide_init(leftAttackSlideDown, 0, 882);
-        slide_create(&rightAttackSlideDown);
-        slide_init(rightAttackSlideDown, 0, 882);
-        slide_create(&leftReleaseSlideDown);
-        slide_init(leftReleaseSlideDown, 0, 44100);
-        slide_create(&rightReleaseSlideDown);
-        slide_init(rightReleaseSlideDown, 0, 44100);
+        slide_init(attackSlideUp, 882, 0);
+        slide_init(attackSlideDown, 0, 882);
+        slide_init(releaseSlideDown, 0, 44100);
 
         delay1.init(sampleRate, 10);
 
@@ -382,292 +367,99 @@ public:
         return 1.0 / (2 * M_PI * fSeconds);
     }
 
-    int compute_attackLR(float *inChannels[2],
-                         float *outChannels[2],
-                         rmsaverage *leftAverage,
-                         rmsaverage *rightAverage,
-                         slide *leftSlideUp,
-                         slide *rightSlideUp,
-                         slide *leftSlideDown,
-                         slide *rightSlideDown,
-                         const int frameOffset)
-    {
-        for (int channel = 0; channel < channelCount; ++channel) {
-            float *in  = (float *)inputBufferLists[0]->mBuffers[channel].mData + frameOffset;
-            float *out = (float *)outChannels[channel];
-            float *basicout = (float *)outputBufferList->mBuffers[channel].mData + frameOffset;
-            if (channel < 2) {
-                inChannels[channel] = in;
-                outChannels[channel] = out;
-            }
-            if (!isStarted) {
-                *basicout = *in;
-                continue;
-            }
-        }
-
-        float *tmpRMSOut[2];
-        float *leftRMSOut;
-        float leftRMS;
-        leftRMSOut = &leftRMS;
-        float *rightRMSOut;
-        float rightRMS;
-        rightRMSOut = &rightRMS;
-        tmpRMSOut[0] = leftRMSOut;
-        tmpRMSOut[1] = rightRMSOut;
-
-        rmsaverage_compute(leftAverage, inChannels[0], tmpRMSOut[0]);
-        rmsaverage_compute(rightAverage, inChannels[1], tmpRMSOut[1]);
-
-        float *tmpMixOut[2];
-        float *leftMixOut;
-        float leftMix;
-        leftMixOut = &leftMix;
-        float *rightMixOut;
-        float rightMix;
-        rightMixOut = &rightMix;
-        tmpMixOut[0] = leftMixOut;
-        tmpMixOut[1] = rightMixOut;
-
-        // Mix Left and Right Channel (on left channel) and half them
-        *tmpMixOut[0] = (*tmpRMSOut[0] + *tmpRMSOut[1]) * 0.5;
-
-        // Set the channels equal
-        *tmpMixOut[1] = *tmpMixOut[0];
-
-        // Copy this signal for later comparison
-        float attackMixCopy = *tmpMixOut[0];
-
-        float *tmpSlideOut[2];
-        float *leftSlideOut;
-        float leftSlide;
-        leftSlideOut = &leftSlide;
-        float *rightSlideOut;
-        float rightSlide;
-        rightSlideOut = &rightSlide;
-        tmpSlideOut[0] = leftSlideOut;
-        tmpSlideOut[1] = rightSlideOut;
-
-        slide_compute(leftSlideUp, tmpMixOut[0], tmpSlideOut[0]);
-        slide_compute(rightSlideUp, tmpMixOut[1], tmpSlideOut[1]);
-
-        // Make channels equivalent again
-        if (*tmpSlideOut[0] != *tmpSlideOut[1])
-            *tmpSlideOut[0] = *tmpSlideOut[1];
-        float slideMixCopy = *tmpSlideOut[0];
-
-        // MARK: BEGIN Logic
-
-        float slideToCompare = slideMixCopy + 0.0; // FIXME: later replace this with attack sensitivity
-        
-        float comparator1 = 0.0;
-
-        if (attackMixCopy >= slideToCompare)
-            comparator1 = 1.0;
-        else
-            comparator1 = 0.0;
-
-        float subtractedMix1 = attackMixCopy - slideMixCopy;
-
-        *outChannels[0] = comparator1 * subtractedMix1;
-        *outChannels[1] = comparator1 * subtractedMix1;
+    // One detector sample: per-channel RMS, mono mix, fast slide-up
+    // envelope, rectified attack differential smoothed by slide-down.
+    inline float attackDetect(float inL, float inR) {
+        float rmsL, rmsR, slid;
+        rmsaverage_compute(leftRMSAverage1, &inL, &rmsL);
+        rmsaverage_compute(rightRMSAverage1, &inR, &rmsR);
+        float mix = (rmsL + rmsR) * 0.5f;
+        slide_compute(attackSlideUp, &mix, &slid);
+        float diff = mix >= slid ? mix - slid : 0.0f;
+        slide_compute(attackSlideDown, &diff, &diff);
+        return diff;
+    }
 
-        // MARK: END Logic
-        slide_compute(leftSlideDown, outChannels[0], outChannels[0]);
-        slide_compute(rightSlideDown, outChannels[1], outChannels[1]);
-        return 1;
+    // Slow-follower counterpart: positive while the mixed RMS falls below
+    // its slide-down envelope, i.e. during the sustain/release phase.
+    inline float releaseDetect(float inL, float inR) {
+        float rmsL, rmsR, slid;
+        rmsaverage_compute(leftRMSAverage2, &inL, &rmsL);
+        rmsaverage_compute(rightRMSAverage2, &inR, &rmsR);
+        float mix = (rmsL + rmsR) * 0.5f;
+        slide_compute(releaseSlideDown, &mix, &slid);
+        return mix <= slid ? slid - mix : 0.0f;
     }
 
-    int compute_releaseLR(float *inChannels[2],
-                         float *outChannels[2],
-                         rmsaverage *leftAverage,
-                         rmsaverage *rightAverage,
-                         slide *leftSlideDown,
-                         slide *rightSlideDown,
-                         const int frameOffset)
-    {
-        for (int channel = 0; channel < channelCount; ++channel) {
-            float *in  = (float *)inputBufferLists[0]->mBuffers[channel].mData + frameOffset;
-            float *out = (float *)outChannels[channel];
-            float *basicout = (float *)outputBufferList->mBuffers[channel].mData + frameOffset;
-            if (channel < 2) {
-                inChannels[channel] = in;
-                outChannels[channel] = out;
-            }
-            if (!isStarted) {
-                *basicout = *in;
-                continue;
+    void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        // delay settings are constants; once per quantum is plenty
+        delay1.setDelayMs(10.0);
+        delay1.setFeedback(0.0);
+        delay1.setDryWetMix(0.0);
+
+        if (!isStarted) {
+            // bypass copy; like before, the shaped signal still overwrites
+            // the first two channels below so detector state keeps tracking
+            for (int channel = 0; channel < channelCount; ++channel) {
+                const float *in = (const float *)inputBufferLists[0]->mBuffers[channel].mData + bufferOffset;
+                float *out = (float *)outputBufferList->mBuffers[channel].mData + bufferOffset;
+                AudioKitCore::vCopy(in, out, frameCount);
             }
         }
 
-        float *tmpRMSOut[2];
-        float *leftRMSOut;
-        float leftRMS;
-        leftRMSOut = &leftRMS;
-        float *rightRMSOut;
-        float rightRMS;
-        rightRMSOut = &rightRMS;
-        tmpRMSOut[0] = leftRMSOut;
-        tmpRMSOut[1] = rightRMSOut;
-
-        rmsaverage_compute(leftAverage, inChannels[0], tmpRMSOut[0]);
-        rmsaverage_compute(rightAverage, inChannels[1], tmpRMSOut[1]);
-
-        float *tmpMixOut[2];
-        float *leftMixOut;
-        float leftMix;
-        leftMixOut = &leftMix;
-        float *rightMixOut;
-        float rightMix;
-        rightMixOut = &rightMix;
-        tmpMixOut[0] = leftMixOut;
-        tmpMixOut[1] = rightMixOut;
-
-        // Mix Left and Right Channel (on left channel) and half them
-        *tmpMixOut[0] = (*tmpRMSOut[0] + *tmpRMSOut[1]) * 0.5;
-
-        // Set the channels equal
-        *tmpMixOut[1] = *tmpMixOut[0];
-        
-        // Copy this signal for later comparison
-        float releaseMixCopy = *tmpMixOut[0];
-
-        float *tmpSlideOut[2];
-        float *leftSlideOut;
-        float leftSlide;
-        leftSlideOut = &leftSlide;
-        float *rightSlideOut;
-        float rightSlide;
-        rightSlideOut = &rightSlide;
-        tmpSlideOut[0] = leftSlideOut;
-        tmpSlideOut[1] = rightSlideOut;
-
-        slide_compute(leftSlideDown, tmpMixOut[0], tmpSlideOut[0]);
-        slide_compute(rightSlideDown, tmpMixOut[1], tmpSlideOut[1]);
-
-        // Make channels equivalent again
-        if (*tmpSlideOut[0] != *tmpSlideOut[1])
-            *tmpSlideOut[0] = *tmpSlideOut[1];
-        float slideMixCopy = *tmpSlideOut[0];
-
-        // MARK: BEGIN Logic
-
-        float slideToCompare = slideMixCopy + 0.0; // FIXME: later replace this with release sensitivity
-        
-        float comparator1 = 0.0;
-
-        if (releaseMixCopy <= slideToCompare)
-            comparator1 = 1.0;
-        else
-            comparator1 = 0.0;
+        const float *inL = (const float *)inputBufferLists[0]->mBuffers[0].mData + bufferOffset;
+        const float *inR = (const float *)inputBufferLists[0]->mBuffers[1].mData + bufferOffset;
+        float *outL = (float *)outputBufferList->mBuffers[0].mData + bufferOffset;
+        float *outR = (float *)outputBufferList->mBuffers[1].mData + bufferOffset;
+
+        // dB-to-amplitude conversions are the expensive part of this loop;
+        // the ramps hold still between gestures, so convert only on change
+        float lastTrimDb = 1.0e30f;
+        float trimGain = 1.0f;
+
+        constexpr int chunkSize = 64;
+        float att[chunkSize], rel[chunkSize], gain[chunkSize];
+        float delayL[chunkSize], delayR[chunkSize];
+
+        for (AUAudioFrameCount offset = 0; offset < frameCount; offset += chunkSize) {
+            const int n = std::min((int)(frameCount - offset), chunkSize);
+
+            // input trim; when processing in place this also feeds the
+            // detectors and the delay, exactly like the per-sample version
+            for (int i = 0; i < n; ++i) {
+                float db = inputAmountRamp.getAndStep();
+                if (db != lastTrimDb) {
+                    lastTrimDb = db;
+                    trimGain = powf(10.0f, db * 0.05f);
+                }
+                outL[offset + i] = inL[offset + i] * trimGain;
+                outR[offset + i] = inR[offset + i] * trimGain;
+            }
 
-        float subtractedMix1 = slideMixCopy - releaseMixCopy;
+            // both followers batched across the chunk
+            for (int i = 0; i < n; ++i) {
+                att[i] = attackDetect(inL[offset + i], inR[offset + i]);
+                rel[i] = releaseDetect(inL[offset + i], inR[offset + i]);
+            }
 
-        *outChannels[0] = comparator1 * subtractedMix1;
-        *outChannels[1] = comparator1 * subtractedMix1;
+            // differential gain curve in one pass: attack, release, and
+            // output trim sum in dB, so one conversion per sample replaces
+            // the former four
+            for (int i = 0; i < n; ++i) {
+                float db = att[i] * (attackAmountRamp.getAndStep() * 2.5f)
+                         + rel[i] * (releaseAmountRamp.getAndStep() * 2.5f)
+                         + outputAmountRamp.getAndStep();
+                gain[i] = powf(10.0f, db * 0.05f);
+            }
 
-        // MARK: END Logic
-        return 1;
-    }
+            const float *delayIn[2] = { inL + offset, inR + offset };
+            float *delayOut[2] = { delayL, delayR };
+            delay1.render(n, delayIn, delayOut);
 
-    void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
-        const float *inBuffers[2];
-        float *outBuffers[2];
-        inBuffers[0]  = (const float *)inputBufferLists[0]->mBuffers[0].mData  + bufferOffset;
-        inBuffers[1]  = (const float *)inputBufferLists[0]->mBuffers[1].mData  + bufferOffset;
-        outBuffers[0] = (float *)outputBufferList->mBuffers[0].mData + bufferOffset;
-        outBuffers[1] = (float *)outputBufferList->mBuffers[1].mData + bufferOffset;
-        for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
-            const int frameOffset = int(frameIndex + bufferOffset);
-
-            delay1.setDelayMs(10.0);
-            delay1.setFeedback(0.0);
-            delay1.setDryWetMix(0.0);
-
-            float *tmpAttackIn[2];
-            float *tmpAttackOut[2];
-            float *tmpReleaseIn[2];
-            float *tmpReleaseOut[2];
-            float *tmpLeftMixOut;
-            float tmpLeftMixOutVal;
-            tmpLeftMixOut = &tmpLeftMixOutVal;
-            float *tmpRightMixOut;
-            float tmpRightMixOutVal;
-            tmpRightMixOut = &tmpRightMixOutVal;
-
-            // get input volume
-            float inputAmount = inputAmountRamp.getAndStep();
-
-            // convert decibels to amplitude
-            *outBuffers[0] = *outBuffers[0] * pow(10., inputAmount / 20.0);
-            *outBuffers[1]= *outBuffers[1] * pow(10., inputAmount / 20.0);
-
-            float attackA = attackAmountRamp.getAndStep() * 2.5;
-            float releaseA = releaseAmountRamp.getAndStep() * 2.5;
-
-            float *leftAttackOut;
-            float leftAttackOutVal;
-            leftAttackOut = &leftAttackOutVal;
-            float *rightAttackOut;
-            float rightAttackOutVal;
-            rightAttackOut = &rightAttackOutVal;
-
-            float *leftReleaseOut;
-            float leftReleaseOutVal;
-            leftReleaseOut = &leftReleaseOutVal;
-            float *rightReleaseOut;
-            float rightReleaseOutVal;
-            rightReleaseOut = &rightReleaseOutVal;
-
-            tmpAttackOut[0] = leftAttackOut;
-            tmpAttackOut[1] = rightAttackOut;
-            tmpReleaseOut[0] = leftReleaseOut;
-            tmpReleaseOut[1] = rightReleaseOut;
-
-            compute_attackLR(tmpAttackIn, tmpAttackOut, leftRMSAverage1, rightRMSAverage1, leftAttackSlideUp, rightAttackSlideUp, leftAttackSlideDown, rightAttackSlideDown, frameOffset);
-
-            compute_releaseLR(tmpReleaseIn, tmpReleaseOut, leftRMSAverage2, rightRMSAverage2, leftReleaseSlideDown, rightReleaseSlideDown, frameOffset);
-
-            *tmpAttackOut[0] = *leftAttackOut * attackA;
-            *tmpAttackOut[1] = *rightAttackOut * attackA;
-            *tmpReleaseOut[0] = *leftReleaseOut * releaseA;
-            *tmpReleaseOut[1] = *rightReleaseOut * releaseA;
-
-            // mix release and attack
-            *tmpRightMixOut = *tmpAttackOut[0] + *tmpReleaseOut[0];
-            *tmpLeftMixOut = *tmpAttackOut[1] + *tmpReleaseOut[1];
-
-            // convert decibels to amplitude
-            *tmpLeftMixOut = pow(10., *tmpLeftMixOut / 20.0);
-            *tmpRightMixOut = pow(10., *tmpRightMixOut / 20.0);
-
-            // reduce/increase output decibels
-
-            float output = outputAmountRamp.getAndStep();
-
-            *tmpLeftMixOut = *tmpLeftMixOut * pow(10., output / 20.0);
-            *tmpRightMixOut = *tmpRightMixOut * pow(10., output / 20.0);
-
-            float *tmpDelayOut[2];
-            float *leftDelayOut;
-            float leftDelayOutVal;
-            leftDelayOut = &leftDelayOutVal;
-            float *rightDelayOut;
-            float rightDelayOutVal;
-            rightDelayOut = &rightDelayOutVal;
-            tmpDelayOut[0] = leftDelayOut;
-            tmpDelayOut[1] = rightDelayOut;
-
-            delay1.render(1, inBuffers, tmpDelayOut);
-
-            // multiply delay buffers by the mix
-            *outBuffers[0] = *tmpDelayOut[0] * *tmpLeftMixOut;
-            *outBuffers[1] = *tmpDelayOut[1] * *tmpRightMixOut;
-
-            inBuffers[0]++;
-            inBuffers[1]++;
-            outBuffers[0]++;
-            outBuffers[1]++;
+            AudioKitCore::vMultiply(delayL, gain, delayL, n);
+            AudioKitCore::vMultiply(delayR, gain, delayR, n);
+            AudioKitCore::vCopy(delayL, outL + offset, n);
+            AudioKitCore::vCopy(delayR, outR + offset, n);
         }
     }
 };
@@ -2,7 +2,9 @@
 
 #include "SoundpipeDSPBase.h"
 #include "ParameterRamper.h"
+#include "DSPVectorOps.h"
 #include "soundpipe.h"
+#include <vector>
 
 enum AmplitudeEnvelopeParameter : AUParameterAddress {
     AmplitudeEnvelopeParameterAttackDuration,
@@ -22,6 +24,8 @@ private:
     ParameterRamper decayDurationRamp;
     ParameterRamper sustainLevelRamp;
     ParameterRamper releaseDurationRamp;
+    std::vector<float> gateFrames;
+    std::vector<float> envFrames;
 
 public:
     AmplitudeEnvelopeDSP() {
@@ -63,6 +67,39 @@ public:
         gateProcessedOnce = false;
     }
 
+    void processBlock(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        // the gate is constant for long runs and the envelope can be
+        // rendered in batches by sp_adsr_compute_block
+        if (attackDurationRamp.isRamping() || decayDurationRamp.isRamping() ||
+            sustainLevelRamp.isRamping() || releaseDurationRamp.isRamping()) {
+            DSPBase::processBlock(frameCount, bufferOffset);
+            return;
+        }
+        adsr->atk = attackDurationRamp.get();
+        adsr->dec = decayDurationRamp.get();
+        adsr->sus = sustainLevelRamp.get();
+        adsr->rel = releaseDurationRamp.get();
+
+        // the single-sample path lets the gate flip to the pending value after
+        // the first computed frame, so only frame 0 sees the stale gate
+        gateFrames.assign(frameCount, internalGate);
+        if (gateProcessedOnce == false) {
+            internalGate = pendingGate;
+            gateProcessedOnce = true;
+            for (int i = 1; i < int(frameCount); ++i) gateFrames[i] = internalGate;
+        }
+
+        envFrames.resize(frameCount);
+        sp_adsr_compute_block(sp, adsr, gateFrames.data(), envFrames.data(), frameCount);
+        amp = envFrames[frameCount - 1];
+
+        for (int channel = 0; channel < channelCount; ++channel) {
+            const float *in  = (const float *)inputBufferLists[0]->mBuffers[channel].mData  + bufferOffset;
+            float *out = (float *)outputBufferList->mBuffers[channel].mData + bufferOffset;
+            AudioKitCore::vMultiply(in, envFrames.data(), out, frameCount);
+        }
+    }
+
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
         for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
             int frameOffset = int(frameIndex + bufferOffset);
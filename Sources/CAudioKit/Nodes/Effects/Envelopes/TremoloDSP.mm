@@ -1,13 +1,17 @@
 // Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
 
 #include "SoundpipeDSPBase.h"
+#include "DSPVectorOps.h"
+#include "ModulationClock.h"
 #include "ParameterRamper.h"
 #include "soundpipe.h"
+#include <algorithm>
 #include <vector>
 
 enum TremoloParameter : AUParameterAddress {
     TremoloParameterFrequency,
     TremoloParameterDepth,
+    TremoloParameterSyncDivision,
 };
 
 class TremoloDSP : public SoundpipeDSPBase {
@@ -17,6 +21,10 @@ private:
     std::vector<float> wavetable;
     ParameterRamper frequencyRamp;
     ParameterRamper depthRamp;
+    // beats per modulation cycle; > 0 replaces the private oscillator with
+    // the shared tempo-synced clock, phase-locked to every other subscriber
+    double syncDivision = 0.0;
+    int syncSlot = -1;
 
 public:
     TremoloDSP() {
@@ -24,10 +32,28 @@ public:
         parameters[TremoloParameterDepth] = &depthRamp;
     }
 
+    void setParameter(AUParameterAddress address, float value, bool immediate) override {
+        if (address == TremoloParameterSyncDivision) {
+            // resubscribing allocates, so this parameter is main-thread only
+            if (syncSlot >= 0) akModulationClockUnsubscribe(syncSlot);
+            syncDivision = value;
+            syncSlot = value > 0 ? akModulationClockSubscribe(ModulationShapeSine, value) : -1;
+        }
+        else {
+            DSPBase::setParameter(address, value, immediate);
+        }
+    }
+
+    float getParameter(AUParameterAddress address) override {
+        if (address == TremoloParameterSyncDivision) {
+            return float(syncDivision);
+        }
+        return DSPBase::getParameter(address);
+    }
+
     void init(int channelCount, double sampleRate) override {
         SoundpipeDSPBase::init(channelCount, sampleRate);
-        sp_ftbl_create(sp, &ftbl, wavetable.size());
-        std::copy(wavetable.cbegin(), wavetable.cend(), ftbl->tbl);
+        sp_ftbl_cache_get_data(sp, &ftbl, wavetable.data(), wavetable.size());
         sp_osc_create(&trem);
         sp_osc_init(sp, trem, ftbl, 0);
     }
@@ -41,6 +67,10 @@ public:
         SoundpipeDSPBase::deinit();
         sp_osc_destroy(&trem);
         sp_ftbl_destroy(&ftbl);
+        if (syncSlot >= 0) {
+            akModulationClockUnsubscribe(syncSlot);
+            syncSlot = -1;
+        }
     }
 
     void reset() override {
@@ -49,7 +79,50 @@ public:
         sp_osc_init(sp, trem, ftbl, 0);
     }
 
+    void processBlock(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        // per-frame parameter updates are only needed while a ramp is
+        // moving; otherwise render the LFO into a small buffer and apply
+        // the tremolo gain as a vector multiply
+        if (!isStarted || frequencyRamp.isRamping() || depthRamp.isRamping()) {
+            DSPBase::processBlock(frameCount, bufferOffset);
+            return;
+        }
+        const float *lfo = syncSlot >= 0
+            ? akModulationClockShapeBuffer(syncSlot, now, bufferOffset + frameCount, sampleRate)
+            : nullptr;
+        const float depth = depthRamp.get();
+        trem->freq = frequencyRamp.get() * 0.5;
+        trem->amp = depth;
+
+        constexpr int chunkSize = 64;
+        float gain[chunkSize];
+        for (AUAudioFrameCount offset = 0; offset < frameCount; offset += chunkSize) {
+            const int n = std::min((int)(frameCount - offset), chunkSize);
+            if (lfo != nullptr) {
+                for (int i = 0; i < n; ++i) {
+                    gain[i] = 1.0f - depth * lfo[bufferOffset + offset + i];
+                }
+            } else {
+                sp_osc_compute_block(sp, trem, NULL, gain, n);
+                for (int i = 0; i < n; ++i) {
+                    gain[i] = 1.0f - gain[i];
+                }
+            }
+            for (int channel = 0; channel < channelCount; ++channel) {
+                float *in  = (float *)inputBufferLists[0]->mBuffers[channel].mData + bufferOffset + offset;
+                float *out = (float *)outputBufferList->mBuffers[channel].mData + bufferOffset + offset;
+                AudioKitCore::vMultiply(in, gain, out, n);
+            }
+        }
+    }
+
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        // the buffer covers the quantum from sample 0, so frameOffset
+        // indexes it directly
+        const float *lfo = syncSlot >= 0
+            ? akModulationClockShapeBuffer(syncSlot, now, bufferOffset + frameCount, sampleRate)
+            : nullptr;
+
         for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
             int frameOffset = int(frameIndex + bufferOffset);
 
@@ -62,7 +135,12 @@ public:
                 float *out = (float *)outputBufferList->mBuffers[channel].mData + frameOffset;
 
                 if (isStarted) {
-                    sp_osc_compute(sp, trem, NULL, &temp);
+                    if (lfo != NULL) {
+                        // same depth scaling as the free-running oscillator
+                        temp = trem->amp * lfo[frameOffset];
+                    } else {
+                        sp_osc_compute(sp, trem, NULL, &temp);
+                    }
                     *out = *in * (1.0 - temp);
                 } else {
                     *out = *in;
@@ -75,3 +153,4 @@ public:
 AK_REGISTER_DSP(TremoloDSP)
 AK_REGISTER_PARAMETER(TremoloParameterFrequency)
 AK_REGISTER_PARAMETER(TremoloParameterDepth)
+AK_REGISTER_PARAMETER(TremoloParameterSyncDivision)
@@ -3,6 +3,7 @@
 #include "SoundpipeDSPBase.h"
 #include "ParameterRamper.h"
 #include "soundpipe.h"
+#include "BiquadEngine.h"
 
 enum BandPassButterworthFilterParameter : AUParameterAddress {
     BandPassButterworthFilterParameterCenterFrequency,
@@ -15,6 +16,7 @@ private:
     sp_butbp *butbp1;
     ParameterRamper centerFrequencyRamp;
     ParameterRamper bandwidthRamp;
+    AudioKitCore::StereoBiquad biquad;
 
 public:
     BandPassButterworthFilterDSP() {
@@ -41,6 +43,28 @@ public:
         if (!isInitialized) return;
         sp_butbp_init(sp, butbp0);
         sp_butbp_init(sp, butbp1);
+        biquad.reset();
+    }
+
+    void processBlock(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        if (!isStarted || channelCount > 2) {
+            DSPBase::processBlock(frameCount, bufferOffset);
+            return;
+        }
+        // one coefficient design per block; the engine interpolates from
+        // the previous set so parameter ramps stay click-free
+        centerFrequencyRamp.stepBy(frameCount);
+        bandwidthRamp.stepBy(frameCount);
+        AudioKitCore::BiquadCoefficients target = AudioKitCore::biquadButterBandPass(sampleRate, centerFrequencyRamp.get(), bandwidthRamp.get());
+        const float *inL = (const float *)inputBufferLists[0]->mBuffers[0].mData + bufferOffset;
+        float *outL = (float *)outputBufferList->mBuffers[0].mData + bufferOffset;
+        if (channelCount > 1) {
+            const float *inR = (const float *)inputBufferLists[0]->mBuffers[1].mData + bufferOffset;
+            float *outR = (float *)outputBufferList->mBuffers[1].mData + bufferOffset;
+            biquad.process(target, inL, inR, outL, outR, int(frameCount));
+        } else {
+            biquad.process(target, inL, outL, int(frameCount));
+        }
     }
 
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
@@ -3,6 +3,7 @@
 #include "SoundpipeDSPBase.h"
 #include "ParameterRamper.h"
 #include "soundpipe.h"
+#include "BiquadEngine.h"
 
 enum BandRejectButterworthFilterParameter : AUParameterAddress {
     BandRejectButterworthFilterParameterCenterFrequency,
@@ -15,6 +16,7 @@ private:
     sp_butbr *butbr1;
     ParameterRamper centerFrequencyRamp;
     ParameterRamper bandwidthRamp;
+    AudioKitCore::StereoBiquad biquad;
 
 public:
     BandRejectButterworthFilterDSP() {
@@ -41,6 +43,28 @@ public:
         if (!isInitialized) return;
         sp_butbr_init(sp, butbr0);
         sp_butbr_init(sp, butbr1);
+        biquad.reset();
+    }
+
+    void processBlock(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        if (!isStarted || channelCount > 2) {
+            DSPBase::processBlock(frameCount, bufferOffset);
+            return;
+        }
+        // one coefficient design per block; the engine interpolates from
+        // the previous set so parameter ramps stay click-free
+        centerFrequencyRamp.stepBy(frameCount);
+        bandwidthRamp.stepBy(frameCount);
+        AudioKitCore::BiquadCoefficients target = AudioKitCore::biquadButterBandReject(sampleRate, centerFrequencyRamp.get(), bandwidthRamp.get());
+        const float *inL = (const float *)inputBufferLists[0]->mBuffers[0].mData + bufferOffset;
+        float *outL = (float *)outputBufferList->mBuffers[0].mData + bufferOffset;
+        if (channelCount > 1) {
+            const float *inR = (const float *)inputBufferLists[0]->mBuffers[1].mData + bufferOffset;
+            float *outR = (float *)outputBufferList->mBuffers[1].mData + bufferOffset;
+            biquad.process(target, inL, inR, outL, outR, int(frameCount));
+        } else {
+            biquad.process(target, inL, outL, int(frameCount));
+        }
     }
 
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
@@ -0,0 +1,154 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+#include "SoundpipeDSPBase.h"
+#include "ParameterRamper.h"
+#include "soundpipe.h"
+
+enum EqualizerParameter : AUParameterAddress {
+    EqualizerParameterLowShelfFrequency,
+    EqualizerParameterLowShelfGain,
+    EqualizerParameterPeak1Frequency,
+    EqualizerParameterPeak1Gain,
+    EqualizerParameterPeak1Q,
+    EqualizerParameterPeak2Frequency,
+    EqualizerParameterPeak2Gain,
+    EqualizerParameterPeak2Q,
+    EqualizerParameterHighShelfFrequency,
+    EqualizerParameterHighShelfGain,
+};
+
+/// Four-band channel-strip EQ (low shelf, two peaks, high shelf) as a
+/// single node: sp_eq4 runs all bands in one fused pass per block, so the
+/// four-node pareq chain's separate buffer traversals collapse into one.
+class EqualizerDSP : public SoundpipeDSPBase {
+private:
+    sp_eq4 *eq0;
+    sp_eq4 *eq1;
+    ParameterRamper lowShelfFrequencyRamp;
+    ParameterRamper lowShelfGainRamp;
+    ParameterRamper peak1FrequencyRamp;
+    ParameterRamper peak1GainRamp;
+    ParameterRamper peak1QRamp;
+    ParameterRamper peak2FrequencyRamp;
+    ParameterRamper peak2GainRamp;
+    ParameterRamper peak2QRamp;
+    ParameterRamper highShelfFrequencyRamp;
+    ParameterRamper highShelfGainRamp;
+
+public:
+    EqualizerDSP() {
+        parameters[EqualizerParameterLowShelfFrequency] = &lowShelfFrequencyRamp;
+        parameters[EqualizerParameterLowShelfGain] = &lowShelfGainRamp;
+        parameters[EqualizerParameterPeak1Frequency] = &peak1FrequencyRamp;
+        parameters[EqualizerParameterPeak1Gain] = &peak1GainRamp;
+        parameters[EqualizerParameterPeak1Q] = &peak1QRamp;
+        parameters[EqualizerParameterPeak2Frequency] = &peak2FrequencyRamp;
+        parameters[EqualizerParameterPeak2Gain] = &peak2GainRamp;
+        parameters[EqualizerParameterPeak2Q] = &peak2QRamp;
+        parameters[EqualizerParameterHighShelfFrequency] = &highShelfFrequencyRamp;
+        parameters[EqualizerParameterHighShelfGain] = &highShelfGainRamp;
+    }
+
+    void init(int channelCount, double sampleRate) override {
+        SoundpipeDSPBase::init(channelCount, sampleRate);
+        sp_eq4_create(&eq0);
+        sp_eq4_init(sp, eq0);
+        sp_eq4_create(&eq1);
+        sp_eq4_init(sp, eq1);
+    }
+
+    void deinit() override {
+        SoundpipeDSPBase::deinit();
+        sp_eq4_destroy(&eq0);
+        sp_eq4_destroy(&eq1);
+    }
+
+    void reset() override {
+        SoundpipeDSPBase::reset();
+        if (!isInitialized) return;
+        sp_eq4_init(sp, eq0);
+        sp_eq4_init(sp, eq1);
+    }
+
+    void applyParameters(bool ramped) {
+        float lowFreq = ramped ? lowShelfFrequencyRamp.getAndStep() : lowShelfFrequencyRamp.get();
+        float lowGain = ramped ? lowShelfGainRamp.getAndStep() : lowShelfGainRamp.get();
+        float p1Freq = ramped ? peak1FrequencyRamp.getAndStep() : peak1FrequencyRamp.get();
+        float p1Gain = ramped ? peak1GainRamp.getAndStep() : peak1GainRamp.get();
+        float p1Q = ramped ? peak1QRamp.getAndStep() : peak1QRamp.get();
+        float p2Freq = ramped ? peak2FrequencyRamp.getAndStep() : peak2FrequencyRamp.get();
+        float p2Gain = ramped ? peak2GainRamp.getAndStep() : peak2GainRamp.get();
+        float p2Q = ramped ? peak2QRamp.getAndStep() : peak2QRamp.get();
+        float highFreq = ramped ? highShelfFrequencyRamp.getAndStep() : highShelfFrequencyRamp.get();
+        float highGain = ramped ? highShelfGainRamp.getAndStep() : highShelfGainRamp.get();
+
+        sp_eq4 *eqs[2] = {eq0, eq1};
+        for (sp_eq4 *eq : eqs) {
+            eq->band[0].fc = lowFreq;
+            eq->band[0].v = lowGain;
+            eq->band[1].fc = p1Freq;
+            eq->band[1].v = p1Gain;
+            eq->band[1].q = p1Q;
+            eq->band[2].fc = p2Freq;
+            eq->band[2].v = p2Gain;
+            eq->band[2].q = p2Q;
+            eq->band[3].fc = highFreq;
+            eq->band[3].v = highGain;
+        }
+    }
+
+    bool anyRampActive() {
+        return lowShelfFrequencyRamp.isRamping() || lowShelfGainRamp.isRamping() ||
+               peak1FrequencyRamp.isRamping() || peak1GainRamp.isRamping() ||
+               peak1QRamp.isRamping() ||
+               peak2FrequencyRamp.isRamping() || peak2GainRamp.isRamping() ||
+               peak2QRamp.isRamping() ||
+               highShelfFrequencyRamp.isRamping() || highShelfGainRamp.isRamping();
+    }
+
+    void processBlock(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        // feed whole channel buffers to soundpipe
+        if (!isStarted || anyRampActive() || channelCount > 2) {
+            DSPBase::processBlock(frameCount, bufferOffset);
+            return;
+        }
+        applyParameters(false);
+
+        for (int channel = 0; channel < channelCount; ++channel) {
+            float *in  = (float *)inputBufferLists[0]->mBuffers[channel].mData  + bufferOffset;
+            float *out = (float *)outputBufferList->mBuffers[channel].mData + bufferOffset;
+            sp_eq4_compute_block(sp, channel == 0 ? eq0 : eq1, in, out, int(frameCount));
+        }
+    }
+
+    void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+            int frameOffset = int(frameIndex + bufferOffset);
+
+            applyParameters(true);
+
+            for (int channel = 0; channel < channelCount; ++channel) {
+                float *in  = (float *)inputBufferLists[0]->mBuffers[channel].mData  + frameOffset;
+                float *out = (float *)outputBufferList->mBuffers[channel].mData + frameOffset;
+                if (!isStarted) {
+                    *out = *in;
+                    continue;
+                }
+
+                sp_eq4_compute(sp, channel == 0 ? eq0 : eq1, in, out);
+            }
+        }
+    }
+};
+
+AK_REGISTER_DSP(EqualizerDSP)
+AK_REGISTER_PARAMETER(EqualizerParameterLowShelfFrequency)
+AK_REGISTER_PARAMETER(EqualizerParameterLowShelfGain)
+AK_REGISTER_PARAMETER(EqualizerParameterPeak1Frequency)
+AK_REGISTER_PARAMETER(EqualizerParameterPeak1Gain)
+AK_REGISTER_PARAMETER(EqualizerParameterPeak1Q)
+AK_REGISTER_PARAMETER(EqualizerParameterPeak2Frequency)
+AK_REGISTER_PARAMETER(EqualizerParameterPeak2Gain)
+AK_REGISTER_PARAMETER(EqualizerParameterPeak2Q)
+AK_REGISTER_PARAMETER(EqualizerParameterHighShelfFrequency)
+AK_REGISTER_PARAMETER(EqualizerParameterHighShelfGain)
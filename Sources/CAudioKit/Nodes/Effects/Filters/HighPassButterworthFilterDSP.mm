@@ -3,6 +3,7 @@
 #include "SoundpipeDSPBase.h"
 #include "ParameterRamper.h"
 #include "soundpipe.h"
+#include "BiquadEngine.h"
 
 enum HighPassButterworthFilterParameter : AUParameterAddress {
     HighPassButterworthFilterParameterCutoffFrequency,
@@ -13,6 +14,7 @@ private:
     sp_buthp *buthp0;
     sp_buthp *buthp1;
     ParameterRamper cutoffFrequencyRamp;
+    AudioKitCore::StereoBiquad biquad;
 
 public:
     HighPassButterworthFilterDSP() {
@@ -38,6 +40,27 @@ public:
         if (!isInitialized) return;
         sp_buthp_init(sp, buthp0);
         sp_buthp_init(sp, buthp1);
+        biquad.reset();
+    }
+
+    void processBlock(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        if (!isStarted || channelCount > 2) {
+            DSPBase::processBlock(frameCount, bufferOffset);
+            return;
+        }
+        // one coefficient design per block; the engine interpolates from
+        // the previous set so parameter ramps stay click-free
+        cutoffFrequencyRamp.stepBy(frameCount);
+        AudioKitCore::BiquadCoefficients target = AudioKitCore::biquadButterHighPass(sampleRate, cutoffFrequencyRamp.get());
+        const float *inL = (const float *)inputBufferLists[0]->mBuffers[0].mData + bufferOffset;
+        float *outL = (float *)outputBufferList->mBuffers[0].mData + bufferOffset;
+        if (channelCount > 1) {
+            const float *inR = (const float *)inputBufferLists[0]->mBuffers[1].mData + bufferOffset;
+            float *outR = (float *)outputBufferList->mBuffers[1].mData + bufferOffset;
+            biquad.process(target, inL, inR, outL, outR, int(frameCount));
+        } else {
+            biquad.process(target, inL, outL, int(frameCount));
+        }
     }
 
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
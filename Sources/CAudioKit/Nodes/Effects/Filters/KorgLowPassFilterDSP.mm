@@ -46,6 +46,32 @@ public:
         sp_wpkorg35_init(sp, wpkorg351);
     }
 
+    void processBlock(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        // the tan() coefficient update runs once per block
+        if (!isStarted || cutoffFrequencyRamp.isRamping() || resonanceRamp.isRamping() ||
+            saturationRamp.isRamping() || channelCount > 2) {
+            DSPBase::processBlock(frameCount, bufferOffset);
+            return;
+        }
+        float cutoffFrequency = cutoffFrequencyRamp.get() - 0.0001f;
+        wpkorg350->cutoff = cutoffFrequency;
+        wpkorg351->cutoff = cutoffFrequency;
+
+        float resonance = resonanceRamp.get();
+        wpkorg350->res = resonance;
+        wpkorg351->res = resonance;
+
+        float saturation = saturationRamp.get();
+        wpkorg350->saturation = saturation;
+        wpkorg351->saturation = saturation;
+
+        for (int channel = 0; channel < channelCount; ++channel) {
+            float *in  = (float *)inputBufferLists[0]->mBuffers[channel].mData  + bufferOffset;
+            float *out = (float *)outputBufferList->mBuffers[channel].mData + bufferOffset;
+            sp_wpkorg35_compute_block(sp, channel == 0 ? wpkorg350 : wpkorg351, in, out, int(frameCount));
+        }
+    }
+
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
         for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
             int frameOffset = int(frameIndex + bufferOffset);
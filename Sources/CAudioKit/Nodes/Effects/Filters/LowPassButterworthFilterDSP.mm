@@ -3,6 +3,7 @@
 #include "SoundpipeDSPBase.h"
 #include "ParameterRamper.h"
 #include "soundpipe.h"
+#include "BiquadEngine.h"
 
 enum LowPassButterworthFilterParameter : AUParameterAddress {
     LowPassButterworthFilterParameterCutoffFrequency,
@@ -13,6 +14,7 @@ private:
     sp_butlp *butlp0;
     sp_butlp *butlp1;
     ParameterRamper cutoffFrequencyRamp;
+    AudioKitCore::StereoBiquad biquad;
 
 public:
     LowPassButterworthFilterDSP() {
@@ -38,6 +40,27 @@ public:
         if (!isInitialized) return;
         sp_butlp_init(sp, butlp0);
         sp_butlp_init(sp, butlp1);
+        biquad.reset();
+    }
+
+    void processBlock(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        if (!isStarted || channelCount > 2) {
+            DSPBase::processBlock(frameCount, bufferOffset);
+            return;
+        }
+        // one coefficient design per block; the engine interpolates from
+        // the previous set so parameter ramps stay click-free
+        cutoffFrequencyRamp.stepBy(frameCount);
+        AudioKitCore::BiquadCoefficients target = AudioKitCore::biquadButterLowPass(sampleRate, cutoffFrequencyRamp.get());
+        const float *inL = (const float *)inputBufferLists[0]->mBuffers[0].mData + bufferOffset;
+        float *outL = (float *)outputBufferList->mBuffers[0].mData + bufferOffset;
+        if (channelCount > 1) {
+            const float *inR = (const float *)inputBufferLists[0]->mBuffers[1].mData + bufferOffset;
+            float *outR = (float *)outputBufferList->mBuffers[1].mData + bufferOffset;
+            biquad.process(target, inL, inR, outL, outR, int(frameCount));
+        } else {
+            biquad.process(target, inL, outL, int(frameCount));
+        }
     }
 
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
@@ -3,6 +3,7 @@
 #include "SoundpipeDSPBase.h"
 #include "ParameterRamper.h"
 #include "soundpipe.h"
+#include "BiquadEngine.h"
 
 enum LowShelfParametricEqualizerFilterParameter : AUParameterAddress {
     LowShelfParametricEqualizerFilterParameterCornerFrequency,
@@ -17,6 +18,7 @@ private:
     ParameterRamper cornerFrequencyRamp;
     ParameterRamper gainRamp;
     ParameterRamper qRamp;
+    AudioKitCore::StereoBiquad biquad;
 
 public:
     LowShelfParametricEqualizerFilterDSP() {
@@ -48,6 +50,29 @@ public:
         sp_pareq_init(sp, pareq1);
         pareq0->mode = 1;
         pareq1->mode = 1;
+        biquad.reset();
+    }
+
+    void processBlock(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        if (!isStarted || channelCount > 2) {
+            DSPBase::processBlock(frameCount, bufferOffset);
+            return;
+        }
+        // one coefficient design per block; the engine interpolates from
+        // the previous set so parameter ramps stay click-free
+        cornerFrequencyRamp.stepBy(frameCount);
+        gainRamp.stepBy(frameCount);
+        qRamp.stepBy(frameCount);
+        AudioKitCore::BiquadCoefficients target = AudioKitCore::biquadParametricEq(sampleRate, cornerFrequencyRamp.get(), gainRamp.get(), qRamp.get(), 1);
+        const float *inL = (const float *)inputBufferLists[0]->mBuffers[0].mData + bufferOffset;
+        float *outL = (float *)outputBufferList->mBuffers[0].mData + bufferOffset;
+        if (channelCount > 1) {
+            const float *inR = (const float *)inputBufferLists[0]->mBuffers[1].mData + bufferOffset;
+            float *outR = (float *)outputBufferList->mBuffers[1].mData + bufferOffset;
+            biquad.process(target, inL, inR, outL, outR, int(frameCount));
+        } else {
+            biquad.process(target, inL, outL, int(frameCount));
+        }
     }
 
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
@@ -0,0 +1,109 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+#include "SoundpipeDSPBase.h"
+#include "ParameterRamper.h"
+#include "soundpipe.h"
+#include <vector>
+
+// Bank of parallel modal resonators processed in one pass. Per-mode
+// frequency/quality/gain arrays arrive through the wavetable channel
+// (index 0 = frequencies, 1 = quality factors, 2 = gains); the mode
+// count follows the frequency array.
+class ModalBankDSP : public SoundpipeDSPBase {
+private:
+    sp_modebank *bank0 = nullptr;
+    sp_modebank *bank1 = nullptr;
+    std::vector<float> frequencies;
+    std::vector<float> qualityFactors;
+    std::vector<float> gains;
+
+public:
+    void setWavetable(const float* table, size_t length, int index) override {
+        switch (index) {
+            case 0: frequencies = std::vector<float>(table, table + length); break;
+            case 1: qualityFactors = std::vector<float>(table, table + length); break;
+            case 2: gains = std::vector<float>(table, table + length); break;
+            default: return;
+        }
+        if (isInitialized) rebuildBanks();
+    }
+
+    void init(int channelCount, double sampleRate) override {
+        SoundpipeDSPBase::init(channelCount, sampleRate);
+        rebuildBanks();
+    }
+
+    void deinit() override {
+        SoundpipeDSPBase::deinit();
+        if (bank0) sp_modebank_destroy(&bank0);
+        if (bank1) sp_modebank_destroy(&bank1);
+        bank0 = bank1 = nullptr;
+    }
+
+    void reset() override {
+        SoundpipeDSPBase::reset();
+        if (!isInitialized) return;
+        rebuildBanks();
+    }
+
+    void rebuildBanks() {
+        // sp_modebank_init sizes its arrays, so changing the mode count
+        // means destroy and recreate rather than re-init in place
+        if (bank0) sp_modebank_destroy(&bank0);
+        if (bank1) sp_modebank_destroy(&bank1);
+        int nmodes = int(frequencies.size());
+        sp_modebank_create(&bank0);
+        sp_modebank_init(sp, bank0, nmodes);
+        sp_modebank_create(&bank1);
+        sp_modebank_init(sp, bank1, nmodes);
+        for (int m = 0; m < bank0->nmodes; ++m) {
+            if (m < int(frequencies.size())) {
+                bank0->freq[m] = frequencies[m];
+                bank1->freq[m] = frequencies[m];
+            }
+            if (m < int(qualityFactors.size())) {
+                bank0->q[m] = qualityFactors[m];
+                bank1->q[m] = qualityFactors[m];
+            }
+            if (m < int(gains.size())) {
+                bank0->gain[m] = gains[m];
+                bank1->gain[m] = gains[m];
+            }
+        }
+    }
+
+    void processBlock(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        if (!isStarted || channelCount > 2) {
+            DSPBase::processBlock(frameCount, bufferOffset);
+            return;
+        }
+        for (int channel = 0; channel < channelCount; ++channel) {
+            float *in  = (float *)inputBufferLists[0]->mBuffers[channel].mData  + bufferOffset;
+            float *out = (float *)outputBufferList->mBuffers[channel].mData + bufferOffset;
+            sp_modebank_compute_block(sp, channel == 0 ? bank0 : bank1, in, out, int(frameCount));
+        }
+    }
+
+    void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+            int frameOffset = int(frameIndex + bufferOffset);
+
+            for (int channel = 0; channel < channelCount; ++channel) {
+                float *in  = (float *)inputBufferLists[0]->mBuffers[channel].mData  + frameOffset;
+                float *out = (float *)outputBufferList->mBuffers[channel].mData + frameOffset;
+                if (!isStarted) {
+                    *out = *in;
+                    continue;
+                }
+
+                if (channel == 0) {
+                    sp_modebank_compute(sp, bank0, in, out);
+                } else {
+                    sp_modebank_compute(sp, bank1, in, out);
+                }
+            }
+        }
+    }
+};
+
+AK_REGISTER_DSP(ModalBankDSP)
@@ -43,6 +43,38 @@ public:
         sp_moogladder_init(sp, moogladder1);
     }
 
+    void processBlock(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        // feed whole channel buffers to soundpipe
+        if (!isStarted || cutoffFrequencyRamp.isRamping() || resonanceRamp.isRamping() || channelCount > 2) {
+            DSPBase::processBlock(frameCount, bufferOffset);
+            return;
+        }
+        float cutoffFrequency = cutoffFrequencyRamp.get();
+        moogladder0->freq = cutoffFrequency;
+        moogladder1->freq = cutoffFrequency;
+
+        float resonance = resonanceRamp.get();
+        moogladder0->res = resonance;
+        moogladder1->res = resonance;
+
+        if (channelCount == 2) {
+            // both channels share one coefficient update and advance together
+            float *inLeft   = (float *)inputBufferLists[0]->mBuffers[0].mData + bufferOffset;
+            float *inRight  = (float *)inputBufferLists[0]->mBuffers[1].mData + bufferOffset;
+            float *outLeft  = (float *)outputBufferList->mBuffers[0].mData + bufferOffset;
+            float *outRight = (float *)outputBufferList->mBuffers[1].mData + bufferOffset;
+            sp_moogladder_compute_block_stereo(sp, moogladder0, moogladder1,
+                                               inLeft, inRight, outLeft, outRight, int(frameCount));
+            return;
+        }
+
+        for (int channel = 0; channel < channelCount; ++channel) {
+            float *in  = (float *)inputBufferLists[0]->mBuffers[channel].mData  + bufferOffset;
+            float *out = (float *)outputBufferList->mBuffers[channel].mData + bufferOffset;
+            sp_moogladder_compute_block(sp, channel == 0 ? moogladder0 : moogladder1, in, out, int(frameCount));
+        }
+    }
+
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
         for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
             int frameOffset = int(frameIndex + bufferOffset);
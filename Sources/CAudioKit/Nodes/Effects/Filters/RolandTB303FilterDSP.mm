@@ -49,6 +49,37 @@ public:
         sp_tbvcf_init(sp, tbvcf1);
     }
 
+    void processBlock(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        // the sqrt/pow coefficient derivation runs once per block
+        if (!isStarted || cutoffFrequencyRamp.isRamping() || resonanceRamp.isRamping() ||
+            distortionRamp.isRamping() || resonanceAsymmetryRamp.isRamping() ||
+            channelCount > 2) {
+            DSPBase::processBlock(frameCount, bufferOffset);
+            return;
+        }
+        float cutoffFrequency = cutoffFrequencyRamp.get();
+        tbvcf0->fco = cutoffFrequency;
+        tbvcf1->fco = cutoffFrequency;
+
+        float resonance = resonanceRamp.get();
+        tbvcf0->res = resonance;
+        tbvcf1->res = resonance;
+
+        float distortion = distortionRamp.get();
+        tbvcf0->dist = distortion;
+        tbvcf1->dist = distortion;
+
+        float resonanceAsymmetry = resonanceAsymmetryRamp.get();
+        tbvcf0->asym = resonanceAsymmetry;
+        tbvcf1->asym = resonanceAsymmetry;
+
+        for (int channel = 0; channel < channelCount; ++channel) {
+            float *in  = (float *)inputBufferLists[0]->mBuffers[channel].mData  + bufferOffset;
+            float *out = (float *)outputBufferList->mBuffers[channel].mData + bufferOffset;
+            sp_tbvcf_compute_block(sp, channel == 0 ? tbvcf0 : tbvcf1, in, out, int(frameCount));
+        }
+    }
+
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
         for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
             int frameOffset = int(frameIndex + bufferOffset);
@@ -43,6 +43,29 @@ public:
         sp_streson_init(sp, streson1);
     }
 
+    void processBlock(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        // the waveguide runs a whole block with the delay-line
+        // wrap checks amortized
+        if (!isStarted || fundamentalFrequencyRamp.isRamping() ||
+            feedbackRamp.isRamping() || channelCount > 2) {
+            DSPBase::processBlock(frameCount, bufferOffset);
+            return;
+        }
+        float fundamentalFrequency = fundamentalFrequencyRamp.get();
+        streson0->freq = fundamentalFrequency;
+        streson1->freq = fundamentalFrequency;
+
+        float feedback = feedbackRamp.get();
+        streson0->fdbgain = feedback;
+        streson1->fdbgain = feedback;
+
+        for (int channel = 0; channel < channelCount; ++channel) {
+            float *in  = (float *)inputBufferLists[0]->mBuffers[channel].mData  + bufferOffset;
+            float *out = (float *)outputBufferList->mBuffers[channel].mData + bufferOffset;
+            sp_streson_compute_block(sp, channel == 0 ? streson0 : streson1, in, out, int(frameCount));
+        }
+    }
+
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
         for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
             int frameOffset = int(frameIndex + bufferOffset);
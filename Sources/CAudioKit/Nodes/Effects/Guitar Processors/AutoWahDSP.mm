@@ -46,6 +46,32 @@ public:
         sp_autowah_init(sp, autowah1);
     }
 
+    void processBlock(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        // feed whole channel buffers to soundpipe
+        if (!isStarted || wahRamp.isRamping() || mixRamp.isRamping() ||
+            amplitudeRamp.isRamping() || channelCount > 2) {
+            DSPBase::processBlock(frameCount, bufferOffset);
+            return;
+        }
+        float wah = wahRamp.get();
+        *autowah0->wah = wah;
+        *autowah1->wah = wah;
+
+        float mix = mixRamp.get() * 100.f;
+        *autowah0->mix = mix;
+        *autowah1->mix = mix;
+
+        float amplitude = amplitudeRamp.get();
+        *autowah0->level = amplitude;
+        *autowah1->level = amplitude;
+
+        for (int channel = 0; channel < channelCount; ++channel) {
+            float *in  = (float *)inputBufferLists[0]->mBuffers[channel].mData  + bufferOffset;
+            float *out = (float *)outputBufferList->mBuffers[channel].mData + bufferOffset;
+            sp_autowah_compute_block(sp, channel == 0 ? autowah0 : autowah1, in, out, int(frameCount));
+        }
+    }
+
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
         for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
             int frameOffset = int(frameIndex + bufferOffset);
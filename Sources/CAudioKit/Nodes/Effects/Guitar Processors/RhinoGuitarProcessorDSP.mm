@@ -7,6 +7,7 @@
 #include "ParameterRamper.h"
 #include <math.h>
 #include <memory>
+#include <string.h>
 
 enum RhinoGuitarProcessorParameter : AUParameterAddress {
     RhinoGuitarProcessorParameterPreGain,
@@ -39,6 +40,12 @@ private:
     ParameterRamper highGainRamper;
     ParameterRamper distortionRamper;
 
+    // tone-stack gains the EQ coefficients were last designed for; the
+    // designs only rerun when a knob actually moves
+    float lastLowGain = NAN;
+    float lastMidGain = NAN;
+    float lastHighGain = NAN;
+
 public:
     RhinoGuitarProcessorDSP() {
         parameters[RhinoGuitarProcessorParameterPreGain] = &preGainRamper;
@@ -57,6 +64,8 @@ public:
 
         mikeFilterL.calc_filter_coeffs(2500.f, sampleRate);
         mikeFilterR.calc_filter_coeffs(2500.f, sampleRate);
+
+        lastLowGain = lastMidGain = lastHighGain = NAN;
     }
 
     void deinit() override {
@@ -66,46 +75,70 @@ public:
         rightRageProcessor = nullptr;
     }
 
-    void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
-
-        for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
-            int frameOffset = int(frameIndex + bufferOffset);
+#define CHUNKSIZE 32    // defines ramp and EQ redesign interval
 
-            float preGain = preGainRamper.getAndStep();
-            float postGain = postGainRamper.getAndStep();
-            float lowGain = lowGainRamper.getAndStep();
-            float midGain = midGainRamper.getAndStep();
-            float highGain = highGainRamper.getAndStep();
-            float distortion = distortionRamper.getAndStep();
-
-            leftEqLo.calc_filter_coeffs(7, 120, sampleRate, 0.75, -2 * -lowGain, false);
-            rightEqLo.calc_filter_coeffs(7, 120, sampleRate, 0.75, -2 * -lowGain, false);
-
-            leftEqMi.calc_filter_coeffs(6, 2450, sampleRate, 1.7, 2.5 * midGain, true);
-            rightEqMi.calc_filter_coeffs(6, 2450, sampleRate, 1.7, 2.5 * midGain, true);
+    void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
 
-            leftEqHi.calc_filter_coeffs(8, 6100, sampleRate, 1.6, -15 * -highGain, false);
-            rightEqHi.calc_filter_coeffs(8, 6100, sampleRate, 1.6, -15 * -highGain, false);
+        for (int frameIndex = 0; frameIndex < int(frameCount); frameIndex += CHUNKSIZE) {
+            int chunkSize = frameCount - frameIndex;
+            if (chunkSize > CHUNKSIZE) chunkSize = CHUNKSIZE;
+
+            preGainRamper.stepBy(chunkSize);
+            postGainRamper.stepBy(chunkSize);
+            lowGainRamper.stepBy(chunkSize);
+            midGainRamper.stepBy(chunkSize);
+            highGainRamper.stepBy(chunkSize);
+            distortionRamper.stepBy(chunkSize);
+
+            float preGain = preGainRamper.get();
+            float postGain = postGainRamper.get();
+            float lowGain = lowGainRamper.get();
+            float midGain = midGainRamper.get();
+            float highGain = highGainRamper.get();
+            float distortion = distortionRamper.get();
+
+            if (lowGain != lastLowGain) {
+                leftEqLo.calc_filter_coeffs(7, 120, sampleRate, 0.75, -2 * -lowGain, false);
+                rightEqLo.calc_filter_coeffs(7, 120, sampleRate, 0.75, -2 * -lowGain, false);
+                lastLowGain = lowGain;
+            }
+            if (midGain != lastMidGain) {
+                leftEqMi.calc_filter_coeffs(6, 2450, sampleRate, 1.7, 2.5 * midGain, true);
+                rightEqMi.calc_filter_coeffs(6, 2450, sampleRate, 1.7, 2.5 * midGain, true);
+                lastMidGain = midGain;
+            }
+            if (highGain != lastHighGain) {
+                leftEqHi.calc_filter_coeffs(8, 6100, sampleRate, 1.6, -15 * -highGain, false);
+                rightEqHi.calc_filter_coeffs(8, 6100, sampleRate, 1.6, -15 * -highGain, false);
+                lastHighGain = highGain;
+            }
 
-            float *tmpin[2];
-            float *tmpout[2];
             for (int channel = 0; channel < 2; ++channel) {
-                float *in  = (float *)inputBufferLists[0]->mBuffers[channel].mData  + frameOffset;
-                float *out = (float *)outputBufferList->mBuffers[channel].mData + frameOffset;
-                if (channel < 2) {
-                    tmpin[channel] = in;
-                    tmpout[channel] = out;
-                }
+                const float *in = (const float *)inputBufferLists[0]->mBuffers[channel].mData + bufferOffset + frameIndex;
+                float *out = (float *)outputBufferList->mBuffers[channel].mData + bufferOffset + frameIndex;
+
                 if (!isStarted) {
-                    *out = *in;
+                    memcpy(out, in, chunkSize * sizeof(float));
                     continue;
                 }
 
-                *in = *in * preGain;
-                const float r_Sig = leftRageProcessor->doRage(*in, distortion * 2, distortion * 2);
-                const float e_Sig = leftEqLo.filter(leftEqMi.filter(leftEqHi.filter(r_Sig))) *
-                (1 / (distortion*0.8));
-                *out = e_Sig * postGain;
+                RageProcessor *rage = channel == 0 ? leftRageProcessor.get() : rightRageProcessor.get();
+                Equalisator &eqLo = channel == 0 ? leftEqLo : rightEqLo;
+                Equalisator &eqMi = channel == 0 ? leftEqMi : rightEqMi;
+                Equalisator &eqHi = channel == 0 ? leftEqHi : rightEqHi;
+
+                // whole chain over one scratch buffer: pregain, tube stages
+                // with tone filter, tone-stack EQs, postgain
+                float buf[CHUNKSIZE];
+                for (int i = 0; i < chunkSize; ++i) buf[i] = in[i] * preGain;
+
+                rage->doRageBlock(buf, buf, chunkSize, distortion * 2, distortion * 2);
+                eqHi.filter_block(buf, buf, chunkSize);
+                eqMi.filter_block(buf, buf, chunkSize);
+                eqLo.filter_block(buf, buf, chunkSize);
+
+                float scale = (1.0f / (distortion * 0.8f)) * postGain;
+                for (int i = 0; i < chunkSize; ++i) out[i] = buf[i] * scale;
             }
         }
     }
@@ -59,6 +59,35 @@ public:
         sp_phaser_init(sp, phaser);
     }
 
+    void processBlock(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        // the block kernel derives the slow-rate values once and
+        // interpolates the LFO-driven allpass coefficients
+        if (!isStarted || channelCount != 2 ||
+            notchMinimumFrequencyRamp.isRamping() || notchMaximumFrequencyRamp.isRamping() ||
+            notchWidthRamp.isRamping() || notchFrequencyRamp.isRamping() ||
+            vibratoModeRamp.isRamping() || depthRamp.isRamping() ||
+            feedbackRamp.isRamping() || invertedRamp.isRamping() ||
+            lfoBPMRamp.isRamping()) {
+            DSPBase::processBlock(frameCount, bufferOffset);
+            return;
+        }
+        *phaser->MinNotch1Freq = notchMinimumFrequencyRamp.get();
+        *phaser->MaxNotch1Freq = notchMaximumFrequencyRamp.get();
+        *phaser->Notch_width = notchWidthRamp.get();
+        *phaser->NotchFreq = notchFrequencyRamp.get();
+        *phaser->VibratoMode = vibratoModeRamp.get();
+        *phaser->depth = depthRamp.get();
+        *phaser->feedback_gain = feedbackRamp.get();
+        *phaser->invert = invertedRamp.get();
+        *phaser->lfobpm = lfoBPMRamp.get();
+
+        float *in0  = (float *)inputBufferLists[0]->mBuffers[0].mData  + bufferOffset;
+        float *in1  = (float *)inputBufferLists[0]->mBuffers[1].mData  + bufferOffset;
+        float *out0 = (float *)outputBufferList->mBuffers[0].mData + bufferOffset;
+        float *out1 = (float *)outputBufferList->mBuffers[1].mData + bufferOffset;
+        sp_phaser_compute_block(sp, phaser, in0, in1, out0, out1, int(frameCount));
+    }
+
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
         for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
             int frameOffset = int(frameIndex + bufferOffset);
@@ -0,0 +1,129 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+#include "DSPBase.h"
+#include "DSPVectorOps.h"
+#include "../../Internals/Utilities/Oversampler.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// Container that runs an inner chain of DSP kernels at 2x or 4x the session
+/// rate with one pair of polyphase halfband resamplers at the boundary.
+/// Stacking several nonlinear kernels inside pays one resampling cost for the
+/// whole chain instead of one per node (or none, and the aliasing).
+///
+/// The inner kernels are created separately (akCreateDSP) and attached with
+/// akOversampledChainAddDSP before render resources are allocated; they are
+/// initialized at the oversampled rate and rendered back to back over one
+/// shared oversampled buffer, the same way RenderGraph sweeps a fused pass.
+/// The container does not take ownership: whoever created an inner kernel
+/// deletes it, after deleting the container.
+class OversampledChainDSP : public DSPBase {
+private:
+    std::vector<DSPBase*> chain;
+    std::vector<AudioKitCore::Oversampler> resamplers;
+    int factor = 2;
+
+    /// One planar oversampled buffer shared by the whole inner chain.
+    std::vector<float> osData;
+    std::vector<uint8_t> osListStorage;
+    uint32_t osFrameCapacity = 0;
+
+    void reserveOversampled(uint32_t osFrames) {
+        if (osFrames <= osFrameCapacity && !osListStorage.empty()) return;
+        osFrameCapacity = osFrames;
+        osData.assign(size_t(channelCount) * osFrames, 0.0f);
+        osListStorage.assign(offsetof(AudioBufferList, mBuffers) +
+                             channelCount * sizeof(AudioBuffer), 0);
+        auto* list = (AudioBufferList*)osListStorage.data();
+        list->mNumberBuffers = channelCount;
+        for (int ch = 0; ch < channelCount; ++ch) {
+            list->mBuffers[ch].mNumberChannels = 1;
+            list->mBuffers[ch].mData = osData.data() + size_t(ch) * osFrames;
+        }
+    }
+
+public:
+    OversampledChainDSP() : DSPBase(1) {
+        bCanProcessInPlace = true;
+    }
+
+    void setFactor(int newFactor) {
+        factor = (newFactor == 4) ? 4 : 2;
+        if (!isInitialized) return;
+        for (auto& resampler : resamplers) resampler.init(factor);
+        for (auto* dsp : chain) dsp->init(channelCount, sampleRate * factor);
+        reserveOversampled(4096 * uint32_t(factor));
+    }
+
+    void addInner(DSPBase* dsp) {
+        if (dsp == nullptr) return;
+        chain.push_back(dsp);
+        if (isInitialized) dsp->init(channelCount, sampleRate * factor);
+    }
+
+    void init(int channelCount, double sampleRate) override {
+        DSPBase::init(channelCount, sampleRate);
+        resamplers.assign(channelCount, AudioKitCore::Oversampler());
+        for (auto& resampler : resamplers) resampler.init(factor);
+        for (auto* dsp : chain) dsp->init(channelCount, sampleRate * factor);
+        reserveOversampled(4096 * uint32_t(factor));
+    }
+
+    void deinit() override {
+        DSPBase::deinit();
+        for (auto* dsp : chain) dsp->deinit();
+    }
+
+    void reset() override {
+        DSPBase::reset();
+        for (auto& resampler : resamplers) resampler.reset();
+        for (auto* dsp : chain) dsp->reset();
+    }
+
+    void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        if (!isStarted || chain.empty()) {
+            for (int channel = 0; channel < channelCount; ++channel) {
+                const float *in = (const float *)inputBufferLists[0]->mBuffers[channel].mData + bufferOffset;
+                float *out = (float *)outputBufferList->mBuffers[channel].mData + bufferOffset;
+                AudioKitCore::vCopy(in, out, frameCount);
+            }
+            return;
+        }
+
+        uint32_t osFrames = frameCount * uint32_t(factor);
+        reserveOversampled(osFrames);
+        auto* osList = (AudioBufferList*)osListStorage.data();
+        for (int channel = 0; channel < channelCount; ++channel) {
+            osList->mBuffers[channel].mDataByteSize = osFrames * sizeof(float);
+            const float *in = (const float *)inputBufferLists[0]->mBuffers[channel].mData + bufferOffset;
+            resamplers[channel].upsample(in, (float *)osList->mBuffers[channel].mData, frameCount);
+        }
+
+        // The chain sweeps the oversampled buffer in place, on the
+        // oversampled timeline.
+        AudioTimeStamp osTime = {};
+        osTime.mFlags = kAudioTimeStampSampleTimeValid;
+        osTime.mSampleTime = double(now) * factor;
+        for (auto* dsp : chain) {
+            if (!dsp->inputBufferLists.empty()) dsp->inputBufferLists[0] = osList;
+            dsp->outputBufferList = osList;
+            dsp->processWithEvents(&osTime, osFrames, nullptr);
+        }
+
+        for (int channel = 0; channel < channelCount; ++channel) {
+            float *out = (float *)outputBufferList->mBuffers[channel].mData + bufferOffset;
+            resamplers[channel].downsample((const float *)osList->mBuffers[channel].mData, out, frameCount);
+        }
+    }
+};
+
+AK_API void akOversampledChainSetFactor(DSPRef dsp, int factor) {
+    ((OversampledChainDSP*)dsp)->setFactor(factor);
+}
+
+AK_API void akOversampledChainAddDSP(DSPRef dsp, DSPRef inner) {
+    ((OversampledChainDSP*)dsp)->addInner((DSPBase*)inner);
+}
+
+AK_REGISTER_DSP(OversampledChainDSP)
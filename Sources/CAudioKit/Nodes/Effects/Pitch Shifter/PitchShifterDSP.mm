@@ -46,6 +46,38 @@ public:
         sp_pshift_init(sp, pshift1);
     }
 
+    void setQuality(int quality) {
+        pshift0->quality = quality;
+        pshift1->quality = quality;
+    }
+
+    void processBlock(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        // the block kernel derives the shift ratio once and runs
+        // the dual-tap crossfade without per-sample fmodf
+        if (!isStarted || shiftRamp.isRamping() || windowSizeRamp.isRamping() ||
+            crossfadeRamp.isRamping() || channelCount > 2) {
+            DSPBase::processBlock(frameCount, bufferOffset);
+            return;
+        }
+        float shift = shiftRamp.get();
+        *pshift0->shift = shift;
+        *pshift1->shift = shift;
+
+        float windowSize = windowSizeRamp.get();
+        *pshift0->window = windowSize;
+        *pshift1->window = windowSize;
+
+        float crossfade = crossfadeRamp.get();
+        *pshift0->xfade = crossfade;
+        *pshift1->xfade = crossfade;
+
+        for (int channel = 0; channel < channelCount; ++channel) {
+            float *in  = (float *)inputBufferLists[0]->mBuffers[channel].mData  + bufferOffset;
+            float *out = (float *)outputBufferList->mBuffers[channel].mData + bufferOffset;
+            sp_pshift_compute_block(sp, channel == 0 ? pshift0 : pshift1, in, out, int(frameCount));
+        }
+    }
+
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
         for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
             int frameOffset = int(frameIndex + bufferOffset);
@@ -85,6 +117,10 @@ public:
     }
 };
 
+AK_API void akPitchShifterSetQuality(DSPRef dsp, int quality) {
+    ((PitchShifterDSP*)dsp)->setQuality(quality);
+}
+
 AK_REGISTER_DSP(PitchShifterDSP)
 AK_REGISTER_PARAMETER(PitchShifterParameterShift)
 AK_REGISTER_PARAMETER(PitchShifterParameterWindowSize)
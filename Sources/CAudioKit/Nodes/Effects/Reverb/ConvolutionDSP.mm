@@ -10,11 +10,59 @@ enum ConvolutionParameter : AUParameterAddress {
 
 class ConvolutionDSP : public SoundpipeDSPBase {
 private:
-    sp_conv *conv0;
-    sp_conv *conv1;
+    sp_conv *conv0 = nullptr;
+    sp_conv *conv1 = nullptr;
+    sp_nconv *nconv0 = nullptr;
+    sp_nconv *nconv1 = nullptr;
+    sp_conv_ir *ir = nullptr;
     sp_ftbl *ftbl;
     std::vector<float> wavetable;
     int partitionLength = 2048;
+    float latencyTargetSeconds = 0;
+
+    // the preprocessed IR only depends on the table and partition length,
+    // so re-inits after sample-rate or buffer changes just re-borrow it
+    void rebuildIRIfNeeded() {
+        if (ir == nullptr || ir->partSize != partitionLength) {
+            if (ir) sp_conv_ir_destroy(&ir);
+            sp_conv_ir_create(&ir);
+            sp_conv_ir_init(sp, ir, ftbl, (float)partitionLength);
+        }
+    }
+
+    /// The largest power-of-two head partition that keeps latency at or
+    /// under the target, floored at sp_nconv's minimum of 64 samples.
+    /// With no target (or one the tail partition already meets) the node
+    /// stays uniform.
+    int headPartitionLength() const {
+        if (latencyTargetSeconds <= 0 || sampleRate <= 0) return partitionLength;
+        int targetFrames = int(latencyTargetSeconds * sampleRate);
+        int head = 64;
+        while (head * 2 <= targetFrames && head * 2 < partitionLength) head *= 2;
+        return head < partitionLength ? head : partitionLength;
+    }
+
+    // sp_nconv has no borrow-style re-init, so mode or latency changes
+    // tear the hybrid convolvers down and rebuild them
+    void rebuildConvolvers() {
+        if (nconv0) sp_nconv_destroy(&nconv0);
+        if (nconv1) sp_nconv_destroy(&nconv1);
+        nconv0 = nconv1 = nullptr;
+
+        int headLength = headPartitionLength();
+        if (headLength < partitionLength) {
+            sp_nconv_create(&nconv0);
+            sp_nconv_init(sp, nconv0, ftbl, (float)headLength, (float)partitionLength);
+            sp_nconv_create(&nconv1);
+            sp_nconv_init(sp, nconv1, ftbl, (float)headLength, (float)partitionLength);
+        } else {
+            rebuildIRIfNeeded();
+            if (conv0 == nullptr) sp_conv_create(&conv0);
+            if (conv1 == nullptr) sp_conv_create(&conv1);
+            sp_conv_init_ir(sp, conv0, ir);
+            sp_conv_init_ir(sp, conv1, ir);
+        }
+    }
 
 public:
     ConvolutionDSP() {}
@@ -25,6 +73,10 @@ public:
         sp_ftbl_destroy(&ftbl);
         sp_ftbl_create(sp, &ftbl, wavetable.size());
         std::copy(wavetable.cbegin(), wavetable.cend(), ftbl->tbl);
+        if (ir) {
+            sp_conv_ir_destroy(&ir);
+            ir = nullptr;
+        }
         reset();
     }
 
@@ -32,10 +84,7 @@ public:
         SoundpipeDSPBase::init(channelCount, sampleRate);
         sp_ftbl_create(sp, &ftbl, wavetable.size());
         std::copy(wavetable.cbegin(), wavetable.cend(), ftbl->tbl);
-        sp_conv_create(&conv0);
-        sp_conv_init(sp, conv0, ftbl, (float)partitionLength);
-        sp_conv_create(&conv1);
-        sp_conv_init(sp, conv1, ftbl, (float)partitionLength);
+        rebuildConvolvers();
     }
 
     void setPartitionLength(int partLength) {
@@ -43,17 +92,37 @@ public:
         reset();
     }
 
+    /// Target processing latency in seconds. A positive target below the
+    /// partition length switches to the two-stage hybrid convolver: a short
+    /// head partition sets the latency while the long tail partitions keep
+    /// long-IR CPU cost down. Zero keeps uniform partitions.
+    void setLatencyTarget(float seconds) {
+        latencyTargetSeconds = seconds;
+        reset();
+    }
+
+    /// The convolution rings for exactly the impulse response length after
+    /// its input goes silent.
+    float tailTimeSeconds() const override {
+        return sampleRate > 0 ? float(wavetable.size()) / float(sampleRate) : 1.0f;
+    }
+
     void deinit() override {
         SoundpipeDSPBase::deinit();
-        sp_conv_destroy(&conv0);
-        sp_conv_destroy(&conv1);
+        if (conv0) { sp_conv_destroy(&conv0); conv0 = nullptr; }
+        if (conv1) { sp_conv_destroy(&conv1); conv1 = nullptr; }
+        if (nconv0) { sp_nconv_destroy(&nconv0); nconv0 = nullptr; }
+        if (nconv1) { sp_nconv_destroy(&nconv1); nconv1 = nullptr; }
+        if (ir) {
+            sp_conv_ir_destroy(&ir);
+            ir = nullptr;
+        }
     }
 
     void reset() override {
         SoundpipeDSPBase::reset();
         if (!isInitialized) return;
-        sp_conv_init(sp, conv0, ftbl, (float)partitionLength);
-        sp_conv_init(sp, conv1, ftbl, (float)partitionLength);
+        rebuildConvolvers();
     }
 
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
@@ -74,10 +143,18 @@ public:
                     continue;
                 }
 
-                if (channel == 0) {
-                    sp_conv_compute(sp, conv0, in, out);
+                if (nconv0) {
+                    if (channel == 0) {
+                        sp_nconv_compute(sp, nconv0, in, out);
+                    } else {
+                        sp_nconv_compute(sp, nconv1, in, out);
+                    }
                 } else {
-                    sp_conv_compute(sp, conv1, in, out);
+                    if (channel == 0) {
+                        sp_conv_compute(sp, conv0, in, out);
+                    } else {
+                        sp_conv_compute(sp, conv1, in, out);
+                    }
                 }
                 *out = *out * 0.05; // Hack
             }
@@ -89,4 +166,8 @@ AK_API void akConvolutionSetPartitionLength(DSPRef dsp, int length) {
     ((ConvolutionDSP*)dsp)->setPartitionLength(length);
 }
 
+AK_API void akConvolutionSetLatencyTarget(DSPRef dsp, float seconds) {
+    ((ConvolutionDSP*)dsp)->setLatencyTarget(seconds);
+}
+
 AK_REGISTER_DSP(ConvolutionDSP)
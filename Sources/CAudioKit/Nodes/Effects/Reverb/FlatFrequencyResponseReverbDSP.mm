@@ -46,6 +46,24 @@ public:
         sp_allpass_init(sp, allpass1, loopDuration);
     }
 
+    void processBlock(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        // the delay line runs in contiguous spans with one wrap
+        // check per span
+        if (!isStarted || reverbDurationRamp.isRamping() || channelCount > 2) {
+            DSPBase::processBlock(frameCount, bufferOffset);
+            return;
+        }
+        float reverbDuration = reverbDurationRamp.get();
+        allpass0->revtime = reverbDuration;
+        allpass1->revtime = reverbDuration;
+
+        for (int channel = 0; channel < channelCount; ++channel) {
+            float *in  = (float *)inputBufferLists[0]->mBuffers[channel].mData  + bufferOffset;
+            float *out = (float *)outputBufferList->mBuffers[channel].mData + bufferOffset;
+            sp_allpass_compute_block(sp, channel == 0 ? allpass0 : allpass1, in, out, int(frameCount));
+        }
+    }
+
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
         for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
             int frameOffset = int(frameIndex + bufferOffset);
@@ -1,8 +1,10 @@
 // Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
 
 #include "SoundpipeDSPBase.h"
+#include "DSPVectorOps.h"
 #include "ParameterRamper.h"
 #include "soundpipe.h"
+#include <string.h>
 
 enum WhiteNoiseParameter : AUParameterAddress {
     WhiteNoiseParameterAmplitude,
@@ -36,6 +38,30 @@ public:
         sp_noise_init(sp, noise);
     }
 
+    void processBlock(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        // per-frame amplitude updates are only needed while the ramp is
+        // moving; otherwise generate a whole block and fan out to channels
+        if (amplitudeRamp.isRamping()) {
+            DSPBase::processBlock(frameCount, bufferOffset);
+            return;
+        }
+        if (!isStarted) {
+            for (int channel = 0; channel < channelCount; ++channel) {
+                float *out = (float *)outputBufferList->mBuffers[channel].mData + bufferOffset;
+                memset(out, 0, frameCount * sizeof(float));
+            }
+            return;
+        }
+        noise->amp = amplitudeRamp.get();
+
+        float *first = (float *)outputBufferList->mBuffers[0].mData + bufferOffset;
+        sp_noise_compute_block(sp, noise, nil, first, int(frameCount));
+        for (int channel = 1; channel < channelCount; ++channel) {
+            float *out = (float *)outputBufferList->mBuffers[channel].mData + bufferOffset;
+            AudioKitCore::vCopy(first, out, frameCount);
+        }
+    }
+
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
         for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
             int frameOffset = int(frameIndex + bufferOffset);
@@ -3,6 +3,7 @@
 #include "SoundpipeDSPBase.h"
 #include "ParameterRamper.h"
 #include "soundpipe.h"
+#include "../../../Internals/Utilities/WavetableExchange.h"
 #include <vector>
 
 enum DynamicOscillatorParameter : AUParameterAddress {
@@ -12,34 +13,19 @@ enum DynamicOscillatorParameter : AUParameterAddress {
     DynamicOscillatorParameterDetuningMultiplier,
 };
 
-struct WavetableInfo {
-    sp_ftbl* table;
-
-    ~WavetableInfo() {
-        sp_ftbl_destroy(&table);
-    }
-
-    /// Is the audio thread done with the wavetable?
-    std::atomic<bool> done{false};
-};
-
 class DynamicOscillatorDSP : public SoundpipeDSPBase {
 private:
     sp_dynamicosc *osc = nullptr;
     std::vector<float> initialWavetable;
-    WavetableInfo *oldTable = nullptr;
-    WavetableInfo *newTable = nullptr;
+    AudioKitCore::WavetableExchange tables;
     double crossfade = 1.0;
-    
+
     ParameterRamper frequencyRamp;
     ParameterRamper tremoloFrequencyRamp;
     ParameterRamper amplitudeRamp;
     ParameterRamper detuningOffsetRamp;
     ParameterRamper detuningMultiplierRamp;
 
-    std::atomic<WavetableInfo*> nextWavetable;
-    std::vector<std::unique_ptr<WavetableInfo>> oldTables;
-
 public:
     DynamicOscillatorDSP() : SoundpipeDSPBase(/*inputBusCount*/0) {
         parameters[DynamicOscillatorParameterFrequency] = &frequencyRamp;
@@ -49,52 +35,23 @@ public:
         isStarted = false;
     }
 
-    void collectTables() {
-
-        // Once we find a finished table, all older tables can be released.
-        int i;
-        for(i=(int)oldTables.size()-1; i>=0; --i) {
-            if(oldTables[i]->done)
-                break;
-        }
-
-        oldTables.erase(oldTables.begin(), oldTables.begin()+i+1);
-    }
-
     void setWavetable(const float* table, size_t length, int index) override {
 
         if(sp) {
-            sendWavetable(table, length);
+            tables.publish(sp, table, length);
         } else {
             initialWavetable = std::vector<float>(table, table + length);
         }
 
     }
 
-    void sendWavetable(const float* table, size_t length) {
-
-        auto info = new WavetableInfo;
-
-        sp_ftbl_create(sp, &info->table, length);
-        std::copy(table, table+length, info->table->tbl);
-
-        nextWavetable = info;
-
-        // Store the table for collection later.
-        oldTables.push_back(std::unique_ptr<WavetableInfo>(info));
-
-        // Clean up any tables that are done.
-        collectTables();
-
-    }
-
     void init(int channelCount, double sampleRate) override {
         SoundpipeDSPBase::init(channelCount, sampleRate);
 
         sp_dynamicosc_create(&osc);
         sp_dynamicosc_init(sp, osc, 0);
 
-        sendWavetable(initialWavetable.data(), initialWavetable.size());
+        tables.publish(sp, initialWavetable.data(), initialWavetable.size());
     }
 
     void deinit() override {
@@ -108,23 +65,13 @@ public:
         sp_dynamicosc_init(sp, osc, 0);
     }
 
-    void updateTables() {
-
-        // Check for new waveforms.
-        int32_t bytes;
-
-        auto next = nextWavetable.load();
-        if(next != newTable) {
-            if(oldTable) { oldTable->done = true; }
-            oldTable = newTable;
-            if(oldTable) { crossfade = 0; }
-            newTable = next;
-        }
-    }
-
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
 
-        updateTables();
+        // Pick up a published table once per quantum; a pickup that
+        // displaces a playing table starts a short crossfade.
+        if(tables.pickup()) { crossfade = 0; }
+        sp_ftbl *oldTable = tables.outgoing();
+        sp_ftbl *newTable = tables.current();
 
         for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
             int frameOffset = int(frameIndex + bufferOffset);
@@ -142,11 +89,11 @@ public:
                 float temp2 = 0;
 
                 if(oldTable) {
-                    sp_dynamicosc_compute(sp, osc, oldTable->table, nil, &temp1, false); // does not move phase
+                    sp_dynamicosc_compute(sp, osc, oldTable, nil, &temp1, false); // does not move phase
                 }
 
                 if(newTable) {
-                    sp_dynamicosc_compute(sp, osc, newTable->table, nil, &temp2, true); // does move phase
+                    sp_dynamicosc_compute(sp, osc, newTable, nil, &temp2, true); // does move phase
                 }
 
                 for (int channel = 0; channel < channelCount; ++channel) {
@@ -160,8 +107,12 @@ public:
                 }
             }
         }
+
+        // Once the fade is over the outgoing table can be reclaimed by the
+        // sender thread without waiting for the next swap.
+        if(crossfade >= 1) { tables.finishCrossfade(); }
     }
-    
+
 };
 
 AK_REGISTER_DSP(DynamicOscillatorDSP)
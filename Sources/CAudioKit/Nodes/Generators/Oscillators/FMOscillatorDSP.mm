@@ -1,8 +1,10 @@
 // Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
 
 #include "SoundpipeDSPBase.h"
+#include "DSPVectorOps.h"
 #include "ParameterRamper.h"
 #include "soundpipe.h"
+#include <string.h>
 #include <vector>
 
 enum FMOscillatorParameter : AUParameterAddress {
@@ -41,8 +43,7 @@ public:
 
     void init(int channelCount, double sampleRate) override {
         SoundpipeDSPBase::init(channelCount, sampleRate);
-        sp_ftbl_create(sp, &ftbl, waveform.size());
-        std::copy(waveform.cbegin(), waveform.cend(), ftbl->tbl);
+        sp_ftbl_cache_get_data(sp, &ftbl, waveform.data(), waveform.size());
         sp_fosc_create(&fosc);
         sp_fosc_init(sp, fosc, ftbl);
     }
@@ -59,6 +60,36 @@ public:
         sp_fosc_init(sp, fosc, ftbl);
     }
 
+    void processBlock(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        // both FM operators run a whole block with their phase
+        // accumulators held in registers, then fan out to channels
+        if (baseFrequencyRamp.isRamping() || carrierMultiplierRamp.isRamping() ||
+            modulatingMultiplierRamp.isRamping() || modulationIndexRamp.isRamping() ||
+            amplitudeRamp.isRamping()) {
+            DSPBase::processBlock(frameCount, bufferOffset);
+            return;
+        }
+        if (!isStarted) {
+            for (int channel = 0; channel < channelCount; ++channel) {
+                float *out = (float *)outputBufferList->mBuffers[channel].mData + bufferOffset;
+                memset(out, 0, frameCount * sizeof(float));
+            }
+            return;
+        }
+        fosc->freq = baseFrequencyRamp.get();
+        fosc->car = carrierMultiplierRamp.get();
+        fosc->mod = modulatingMultiplierRamp.get();
+        fosc->indx = modulationIndexRamp.get();
+        fosc->amp = amplitudeRamp.get();
+
+        float *first = (float *)outputBufferList->mBuffers[0].mData + bufferOffset;
+        sp_fosc_compute_block(sp, fosc, nil, first, int(frameCount));
+        for (int channel = 1; channel < channelCount; ++channel) {
+            float *out = (float *)outputBufferList->mBuffers[channel].mData + bufferOffset;
+            AudioKitCore::vCopy(first, out, frameCount);
+        }
+    }
+
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
         for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
             int frameOffset = int(frameIndex + bufferOffset);
@@ -1,8 +1,10 @@
 // Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
 
 #include "SoundpipeDSPBase.h"
+#include "DSPVectorOps.h"
 #include "ParameterRamper.h"
 #include "soundpipe.h"
+#include <string.h>
 #include <vector>
 
 enum MorphingOscillatorParameter : AUParameterAddress {
@@ -43,8 +45,7 @@ public:
     void init(int channelCount, double sampleRate) override {
         SoundpipeDSPBase::init(channelCount, sampleRate);
         for (uint32_t i = 0; i < 4; i++) {
-            sp_ftbl_create(sp, &ft_array[i], waveforms[i].size());
-            std::copy(waveforms[i].cbegin(), waveforms[i].cend(), ft_array[i]->tbl);
+            sp_ftbl_cache_get_data(sp, &ft_array[i], waveforms[i].data(), waveforms[i].size());
         }
         sp_oscmorph_create(&oscmorph);
         sp_oscmorph_init(sp, oscmorph, ft_array, 4, 0);
@@ -64,6 +65,35 @@ public:
         sp_oscmorph_init(sp, oscmorph, ft_array, 4, 0);
     }
 
+    void processBlock(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        // while any ramp is moving, fall back to the per-sample 4-read morph;
+        // once the morph index settles, sp_oscmorph_compute_block blends the
+        // cycle into its cached table and runs single-table lookups
+        if (frequencyRamp.isRamping() || amplitudeRamp.isRamping() ||
+            indexRamp.isRamping() || detuningOffsetRamp.isRamping() ||
+            detuningMultiplierRamp.isRamping()) {
+            DSPBase::processBlock(frameCount, bufferOffset);
+            return;
+        }
+        if (!isStarted) {
+            for (int channel = 0; channel < channelCount; ++channel) {
+                float *out = (float *)outputBufferList->mBuffers[channel].mData + bufferOffset;
+                memset(out, 0, frameCount * sizeof(float));
+            }
+            return;
+        }
+        oscmorph->freq = frequencyRamp.get() * detuningMultiplierRamp.get() + detuningOffsetRamp.get();
+        oscmorph->amp = amplitudeRamp.get();
+        oscmorph->wtpos = indexRamp.get() / 3.f;
+
+        float *first = (float *)outputBufferList->mBuffers[0].mData + bufferOffset;
+        sp_oscmorph_compute_block(sp, oscmorph, nil, first, int(frameCount));
+        for (int channel = 1; channel < channelCount; ++channel) {
+            float *out = (float *)outputBufferList->mBuffers[channel].mData + bufferOffset;
+            AudioKitCore::vCopy(first, out, frameCount);
+        }
+    }
+
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
         for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
             int frameOffset = int(frameIndex + bufferOffset);
@@ -1,8 +1,10 @@
 // Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
 
 #include "SoundpipeDSPBase.h"
+#include "DSPVectorOps.h"
 #include "ParameterRamper.h"
 #include "soundpipe.h"
+#include <string.h>
 #include <vector>
 
 enum OscillatorParameter : AUParameterAddress {
@@ -38,8 +40,7 @@ public:
 
     void init(int channelCount, double sampleRate) override {
         SoundpipeDSPBase::init(channelCount, sampleRate);
-        sp_ftbl_create(sp, &ftbl, waveform.size());
-        std::copy(waveform.cbegin(), waveform.cend(), ftbl->tbl);
+        sp_ftbl_cache_get_data(sp, &ftbl, waveform.data(), waveform.size());
         sp_osc_create(&osc);
         sp_osc_init(sp, osc, ftbl, 0);
     }
@@ -56,6 +57,32 @@ public:
         sp_osc_init(sp, osc, ftbl, 0);
     }
 
+    void processBlock(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        // per-frame frequency/amplitude updates are only needed while a ramp
+        // is moving; otherwise compute a whole block and fan out to channels
+        if (frequencyRamp.isRamping() || amplitudeRamp.isRamping() ||
+            detuningOffsetRamp.isRamping() || detuningMultiplierRamp.isRamping()) {
+            DSPBase::processBlock(frameCount, bufferOffset);
+            return;
+        }
+        if (!isStarted) {
+            for (int channel = 0; channel < channelCount; ++channel) {
+                float *out = (float *)outputBufferList->mBuffers[channel].mData + bufferOffset;
+                memset(out, 0, frameCount * sizeof(float));
+            }
+            return;
+        }
+        osc->freq = frequencyRamp.get() * detuningMultiplierRamp.get() + detuningOffsetRamp.get();
+        osc->amp = amplitudeRamp.get();
+
+        float *first = (float *)outputBufferList->mBuffers[0].mData + bufferOffset;
+        sp_osc_compute_block(sp, osc, nil, first, int(frameCount));
+        for (int channel = 1; channel < channelCount; ++channel) {
+            float *out = (float *)outputBufferList->mBuffers[channel].mData + bufferOffset;
+            AudioKitCore::vCopy(first, out, frameCount);
+        }
+    }
+
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
         for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
             int frameOffset = int(frameIndex + bufferOffset);
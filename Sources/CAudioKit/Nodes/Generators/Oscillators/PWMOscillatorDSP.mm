@@ -1,8 +1,10 @@
 // Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
 
 #include "SoundpipeDSPBase.h"
+#include "DSPVectorOps.h"
 #include "ParameterRamper.h"
 #include "soundpipe.h"
+#include <string.h>
 
 enum PWMOscillatorParameter : AUParameterAddress {
     PWMOscillatorParameterFrequency,
@@ -15,6 +17,8 @@ enum PWMOscillatorParameter : AUParameterAddress {
 class PWMOscillatorDSP : public SoundpipeDSPBase {
 private:
     sp_blsquare *blsquare;
+    sp_polyblep *polyblep;
+    bool usePolyBLEP = false;
     ParameterRamper frequencyRamp;
     ParameterRamper amplitudeRamp;
     ParameterRamper pulseWidthRamp;
@@ -37,11 +41,14 @@ public:
         isStarted = false;
         sp_blsquare_create(&blsquare);
         sp_blsquare_init(sp, blsquare);
+        sp_polyblep_create(&polyblep);
+        sp_polyblep_init(sp, polyblep);
     }
 
     void deinit() override {
         SoundpipeDSPBase::deinit();
         sp_blsquare_destroy(&blsquare);
+        sp_polyblep_destroy(&polyblep);
     }
 
     void reset() override {
@@ -49,6 +56,40 @@ public:
         if (!isInitialized) return;
         isStarted = false;
         sp_blsquare_init(sp, blsquare);
+        sp_polyblep_init(sp, polyblep);
+    }
+
+    /// Trade the BLIT synthesis for the cheaper table-free polyBLEP engine.
+    void setPolyBLEP(bool enabled) {
+        usePolyBLEP = enabled;
+    }
+
+    void processBlock(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        // the polyBLEP engine renders whole blocks; the BLIT path and
+        // moving ramps still go through the per-sample loop
+        if (!usePolyBLEP || frequencyRamp.isRamping() || amplitudeRamp.isRamping() ||
+            pulseWidthRamp.isRamping() || detuningOffsetRamp.isRamping() ||
+            detuningMultiplierRamp.isRamping()) {
+            DSPBase::processBlock(frameCount, bufferOffset);
+            return;
+        }
+        if (!isStarted) {
+            for (int channel = 0; channel < channelCount; ++channel) {
+                float *out = (float *)outputBufferList->mBuffers[channel].mData + bufferOffset;
+                memset(out, 0, frameCount * sizeof(float));
+            }
+            return;
+        }
+        polyblep->freq = frequencyRamp.get() * detuningMultiplierRamp.get() + detuningOffsetRamp.get();
+        polyblep->amp = amplitudeRamp.get();
+        polyblep->width = pulseWidthRamp.get();
+
+        float *first = (float *)outputBufferList->mBuffers[0].mData + bufferOffset;
+        sp_polyblep_compute_block(sp, polyblep, first, int(frameCount));
+        for (int channel = 1; channel < channelCount; ++channel) {
+            float *out = (float *)outputBufferList->mBuffers[channel].mData + bufferOffset;
+            AudioKitCore::vCopy(first, out, frameCount);
+        }
     }
 
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
@@ -61,9 +102,15 @@ public:
             float detuningOffset = detuningOffsetRamp.getAndStep();
             float detuningMultiplier = detuningMultiplierRamp.getAndStep();
 
-            *blsquare->freq = frequency * detuningMultiplier + detuningOffset;
-            *blsquare->amp = amplitude;
-            *blsquare->width = pulseWidth;
+            if (usePolyBLEP) {
+                polyblep->freq = frequency * detuningMultiplier + detuningOffset;
+                polyblep->amp = amplitude;
+                polyblep->width = pulseWidth;
+            } else {
+                *blsquare->freq = frequency * detuningMultiplier + detuningOffset;
+                *blsquare->amp = amplitude;
+                *blsquare->width = pulseWidth;
+            }
 
             float temp = 0;
             for (int channel = 0; channel < channelCount; ++channel) {
@@ -71,7 +118,11 @@ public:
 
                 if (isStarted) {
                     if (channel == 0) {
-                        sp_blsquare_compute(sp, blsquare, nil, &temp);
+                        if (usePolyBLEP) {
+                            sp_polyblep_compute(sp, polyblep, nil, &temp);
+                        } else {
+                            sp_blsquare_compute(sp, blsquare, nil, &temp);
+                        }
                     }
                     *out = temp;
                 } else {
@@ -82,6 +133,10 @@ public:
     }
 };
 
+AK_API void akPWMOscillatorSetPolyBLEP(DSPRef dsp, bool enabled) {
+    ((PWMOscillatorDSP*)dsp)->setPolyBLEP(enabled);
+}
+
 AK_REGISTER_DSP(PWMOscillatorDSP)
 AK_REGISTER_PARAMETER(PWMOscillatorParameterFrequency)
 AK_REGISTER_PARAMETER(PWMOscillatorParameterAmplitude)
@@ -1,8 +1,10 @@
 // Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
 
 #include "SoundpipeDSPBase.h"
+#include "DSPVectorOps.h"
 #include "ParameterRamper.h"
 #include "soundpipe.h"
+#include <string.h>
 #include <vector>
 
 enum PhaseDistortionOscillatorParameter : AUParameterAddress {
@@ -19,6 +21,8 @@ private:
     sp_tabread *tabread;
     sp_phasor *phasor;
     sp_ftbl *ftbl;
+    sp_polyblep *polyblep;
+    bool usePolyBLEP = false;
     std::vector<float> waveform;
     ParameterRamper frequencyRamp;
     ParameterRamper amplitudeRamp;
@@ -44,14 +48,16 @@ public:
 
     void init(int channelCount, double sampleRate) override {
         SoundpipeDSPBase::init(channelCount, sampleRate);
-        sp_ftbl_create(sp, &ftbl, waveform.size());
-        std::copy(waveform.cbegin(), waveform.cend(), ftbl->tbl);
+        sp_ftbl_cache_get_data(sp, &ftbl, waveform.data(), waveform.size());
         sp_pdhalf_create(&pdhalf);
         sp_pdhalf_init(sp, pdhalf);
         sp_tabread_create(&tabread);
         sp_tabread_init(sp, tabread, ftbl, 1);
         sp_phasor_create(&phasor);
         sp_phasor_init(sp, phasor, 0);
+        sp_polyblep_create(&polyblep);
+        sp_polyblep_init(sp, polyblep);
+        polyblep->type = SP_POLYBLEP_SAW;
     }
 
     void deinit() override {
@@ -60,12 +66,49 @@ public:
         sp_pdhalf_destroy(&pdhalf);
         sp_tabread_destroy(&tabread);
         sp_ftbl_destroy(&ftbl);
+        sp_polyblep_destroy(&polyblep);
     }
 
     void reset() override {
         SoundpipeDSPBase::reset();
         if (!isInitialized) return;
         sp_pdhalf_init(sp, pdhalf);
+        sp_polyblep_init(sp, polyblep);
+        polyblep->type = SP_POLYBLEP_SAW;
+    }
+
+    /// Trade the table lookup for the table-free polyBLEP sawtooth with the
+    /// same pdhalf-style phase warp.
+    void setPolyBLEP(bool enabled) {
+        usePolyBLEP = enabled;
+    }
+
+    void processBlock(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        // the polyBLEP engine renders whole blocks; the wavetable path and
+        // moving ramps still go through the per-sample loop
+        if (!usePolyBLEP || frequencyRamp.isRamping() || amplitudeRamp.isRamping() ||
+            phaseDistortionRamp.isRamping() || detuningOffsetRamp.isRamping() ||
+            detuningMultiplierRamp.isRamping()) {
+            DSPBase::processBlock(frameCount, bufferOffset);
+            return;
+        }
+        if (!isStarted) {
+            for (int channel = 0; channel < channelCount; ++channel) {
+                float *out = (float *)outputBufferList->mBuffers[channel].mData + bufferOffset;
+                memset(out, 0, frameCount * sizeof(float));
+            }
+            return;
+        }
+        polyblep->freq = frequencyRamp.get() * detuningMultiplierRamp.get() + detuningOffsetRamp.get();
+        polyblep->amp = amplitudeRamp.get();
+        polyblep->pd = phaseDistortionRamp.get();
+
+        float *first = (float *)outputBufferList->mBuffers[0].mData + bufferOffset;
+        sp_polyblep_compute_block(sp, polyblep, first, int(frameCount));
+        for (int channel = 1; channel < channelCount; ++channel) {
+            float *out = (float *)outputBufferList->mBuffers[channel].mData + bufferOffset;
+            AudioKitCore::vCopy(first, out, frameCount);
+        }
     }
 
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
@@ -89,12 +132,18 @@ public:
 
                 if (isStarted) {
                     if (channel == 0) {
-                        sp_phasor_compute(sp, phasor, NULL, &ph);
-//                        AKDebugDSP(PhaseDistortionOscillatorDebugPhase, ph);
-                        sp_pdhalf_compute(sp, pdhalf, &ph, &pd);
-                        tabread->index = pd;
-                        sp_tabread_compute(sp, tabread, NULL, &temp);
-                        
+                        if (usePolyBLEP) {
+                            polyblep->freq = phasor->freq;
+                            polyblep->pd = phaseDistortion;
+                            polyblep->amp = 1; // amplitude is applied below
+                            sp_polyblep_compute(sp, polyblep, NULL, &temp);
+                        } else {
+                            sp_phasor_compute(sp, phasor, NULL, &ph);
+//                            AKDebugDSP(PhaseDistortionOscillatorDebugPhase, ph);
+                            sp_pdhalf_compute(sp, pdhalf, &ph, &pd);
+                            tabread->index = pd;
+                            sp_tabread_compute(sp, tabread, NULL, &temp);
+                        }
                     }
                     *out = temp * amplitude;
                 } else {
@@ -105,6 +154,10 @@ public:
     }
 };
 
+AK_API void akPhaseDistortionOscillatorSetPolyBLEP(DSPRef dsp, bool enabled) {
+    ((PhaseDistortionOscillatorDSP*)dsp)->setPolyBLEP(enabled);
+}
+
 AK_REGISTER_DSP(PhaseDistortionOscillatorDSP)
 AK_REGISTER_PARAMETER(PhaseDistortionOscillatorParameterFrequency)
 AK_REGISTER_PARAMETER(PhaseDistortionOscillatorParameterAmplitude)
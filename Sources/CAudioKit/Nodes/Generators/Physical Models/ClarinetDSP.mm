@@ -23,6 +23,10 @@ public:
         return clarinet;
     }
 
+    void tickFrames(float* output, AUAudioFrameCount frameCount) override {
+        tickInstrumentFrames(clarinet, output, frameCount);
+    }
+
     void deinit() override {
         DSPBase::deinit();
         delete clarinet;
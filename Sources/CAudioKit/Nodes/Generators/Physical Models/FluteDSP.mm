@@ -23,6 +23,10 @@ public:
         return flute;
     }
 
+    void tickFrames(float* output, AUAudioFrameCount frameCount) override {
+        tickInstrumentFrames(flute, output, frameCount);
+    }
+
     void deinit() override {
         DSPBase::deinit();
         delete flute;
@@ -53,6 +53,10 @@ public:
         return mandolin;
     }
 
+    void tickFrames(float* output, AUAudioFrameCount frameCount) override {
+        tickInstrumentFrames(mandolin, output, frameCount);
+    }
+
     void deinit() override {
         DSPBase::deinit();
         delete mandolin;
@@ -1,8 +1,11 @@
 // Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
 
 #include "SoundpipeDSPBase.h"
+#include "DSPVectorOps.h"
 #include "ParameterRamper.h"
 #include "soundpipe.h"
+#include <string.h>
+#include <vector>
 
 enum MetalBarParameter : AUParameterAddress {
     MetalBarParameterLeftBoundaryCondition,
@@ -18,6 +21,7 @@ class MetalBarDSP : public SoundpipeDSPBase {
 private:
     sp_bar *bar;
     float internalTrigger = 0;
+    std::vector<float> triggerFrames;
     ParameterRamper leftBoundaryConditionRamp;
     ParameterRamper rightBoundaryConditionRamp;
     ParameterRamper decayDurationRamp;
@@ -58,6 +62,43 @@ public:
         internalTrigger = 1;
     }
 
+    void processBlock(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        // advance the whole scheme in one block with the grid resident in
+        // cache and fan out to channels
+        if (leftBoundaryConditionRamp.isRamping() || rightBoundaryConditionRamp.isRamping() ||
+            decayDurationRamp.isRamping() || scanSpeedRamp.isRamping() ||
+            positionRamp.isRamping() || strikeVelocityRamp.isRamping() ||
+            strikeWidthRamp.isRamping()) {
+            DSPBase::processBlock(frameCount, bufferOffset);
+            return;
+        }
+        if (!isStarted) {
+            for (int channel = 0; channel < channelCount; ++channel) {
+                float *out = (float *)outputBufferList->mBuffers[channel].mData + bufferOffset;
+                memset(out, 0, frameCount * sizeof(float));
+            }
+            return;
+        }
+        bar->bcL = leftBoundaryConditionRamp.get();
+        bar->bcR = rightBoundaryConditionRamp.get();
+        bar->T30 = decayDurationRamp.get();
+        bar->scan = scanSpeedRamp.get();
+        bar->pos = positionRamp.get();
+        bar->vel = strikeVelocityRamp.get();
+        bar->wid = strikeWidthRamp.get();
+
+        // the single-sample path sees internalTrigger on every frame, so
+        // the block path feeds it to every frame as well
+        triggerFrames.assign(frameCount, internalTrigger);
+
+        float *first = (float *)outputBufferList->mBuffers[0].mData + bufferOffset;
+        sp_bar_compute_block(sp, bar, triggerFrames.data(), first, int(frameCount));
+        for (int channel = 1; channel < channelCount; ++channel) {
+            float *out = (float *)outputBufferList->mBuffers[channel].mData + bufferOffset;
+            AudioKitCore::vCopy(first, out, frameCount);
+        }
+    }
+
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
         for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
             int frameOffset = int(frameIndex + bufferOffset);
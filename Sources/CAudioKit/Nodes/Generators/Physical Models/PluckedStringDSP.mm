@@ -1,8 +1,11 @@
 // Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
 
 #include "SoundpipeDSPBase.h"
+#include "DSPVectorOps.h"
 #include "ParameterRamper.h"
 #include "soundpipe.h"
+#include <string.h>
+#include <vector>
 
 enum PluckedStringParameter : AUParameterAddress {
     PluckedStringParameterFrequency,
@@ -13,6 +16,7 @@ class PluckedStringDSP : public SoundpipeDSPBase {
 private:
     sp_pluck *pluck;
     float internalTrigger = 0;
+    std::vector<float> triggerFrames;
     ParameterRamper frequencyRamp;
     ParameterRamper amplitudeRamp;
 
@@ -44,9 +48,44 @@ public:
     }
 
     void triggerFrequencyAmplitude(float frequency, float amplitude) override {
+        // batched triggers carry their own pitch and level; land them
+        // immediately so the pluck excites at the requested frequency
+        frequencyRamp.startRamp(frequency, 0);
+        amplitudeRamp.startRamp(amplitude, 0);
         internalTrigger = 1;
     }
 
+    void processBlock(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        // the string renders in spans between averager passes
+        if (frequencyRamp.isRamping() || amplitudeRamp.isRamping()) {
+            DSPBase::processBlock(frameCount, bufferOffset);
+            return;
+        }
+        if (!isStarted) {
+            for (int channel = 0; channel < channelCount; ++channel) {
+                float *out = (float *)outputBufferList->mBuffers[channel].mData + bufferOffset;
+                memset(out, 0, frameCount * sizeof(float));
+            }
+            return;
+        }
+        pluck->freq = frequencyRamp.get();
+        pluck->amp = amplitudeRamp.get();
+
+        // the single-sample path sees internalTrigger on every frame, so
+        // the block path feeds it to every frame as well
+        triggerFrames.assign(frameCount, internalTrigger);
+
+        float *first = (float *)outputBufferList->mBuffers[0].mData + bufferOffset;
+        sp_pluck_compute_block(sp, pluck, triggerFrames.data(), first, int(frameCount));
+        for (int channel = 1; channel < channelCount; ++channel) {
+            float *out = (float *)outputBufferList->mBuffers[channel].mData + bufferOffset;
+            AudioKitCore::vCopy(first, out, frameCount);
+        }
+        if (internalTrigger == 1) {
+            internalTrigger = 0;
+        }
+    }
+
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
         for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
             int frameOffset = int(frameIndex + bufferOffset);
@@ -42,6 +42,10 @@ public:
         return rhodesPiano;
     }
 
+    void tickFrames(float* output, AUAudioFrameCount frameCount) override {
+        tickInstrumentFrames(rhodesPiano, output, frameCount);
+    }
+
     void deinit() override {
         DSPBase::deinit();
         delete rhodesPiano;
@@ -18,6 +18,31 @@ public:
 
     void handleMIDIEvent(AUMIDIEvent const& midiEvent) override;
 
+    /// Trigger entry points used by triggerDSP and batched triggers; both
+    /// note the instrument on (trigger() at 440 Hz, full amplitude).
+    void trigger() override;
+
+    void triggerFrequencyAmplitude(AUValue frequency, AUValue amplitude) override;
+
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override;
 
+    /// Renders frameCount mono samples into a contiguous buffer with one
+    /// virtual call per block. The default implementation falls back to one
+    /// virtual Instrmnt::tick() per sample; subclasses override it with
+    /// tickInstrumentFrames so the per-sample tick devirtualizes.
+    virtual void tickFrames(float* output, AUAudioFrameCount frameCount);
+
+protected:
+
+    /// Block-render helper for subclasses: calling tick() through the
+    /// concrete instrument type resolves it statically, so STK's inline
+    /// per-sample tick inlines into this loop.
+    template <typename InstrumentType>
+    void tickInstrumentFrames(InstrumentType* instrument, float* output,
+                              AUAudioFrameCount frameCount) {
+        for (AUAudioFrameCount i = 0; i < frameCount; ++i) {
+            output[i] = instrument->tick();
+        }
+    }
+
 };
@@ -2,6 +2,8 @@
 
 #include "STKInstrumentDSP.hpp"
 
+#include <cstring>
+
 STKInstrumentDSP::STKInstrumentDSP() : DSPBase(/*inputBusCount*/0) {
     isStarted = false;
 }
@@ -43,22 +45,39 @@ void STKInstrumentDSP::handleMIDIEvent(AUMIDIEvent const& midiEvent) {
 
 }
 
-void STKInstrumentDSP::process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) {
+void STKInstrumentDSP::trigger() {
+    triggerFrequencyAmplitude(440.0, 1.0);
+}
+
+void STKInstrumentDSP::triggerFrequencyAmplitude(AUValue frequency, AUValue amplitude) {
+    isStarted = true;
+    if (auto instr = getInstrument()) {
+        instr->noteOn(frequency, amplitude);
+    }
+}
 
+void STKInstrumentDSP::tickFrames(float* output, AUAudioFrameCount frameCount) {
     auto instr = getInstrument();
+    for (AUAudioFrameCount i = 0; i < frameCount; ++i) {
+        output[i] = instr->tick();
+    }
+}
 
-    for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
-        int frameOffset = int(frameIndex + bufferOffset);
+void STKInstrumentDSP::process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) {
 
-        float outputSample = 0.0;
-        if(isStarted && instr) {
-            outputSample = instr->tick();
-        }
+    // Render the mono block straight into channel 0, then fan out: one
+    // virtual call per block instead of one per sample.
+    float *out0 = (float *)outputBufferList->mBuffers[0].mData + bufferOffset;
 
-        for (int channel = 0; channel < channelCount; ++channel) {
-            float *out = (float *)outputBufferList->mBuffers[channel].mData + frameOffset;
-            *out = outputSample;
-        }
+    if (isStarted && getInstrument()) {
+        tickFrames(out0, frameCount);
+    } else {
+        memset(out0, 0, frameCount * sizeof(float));
+    }
+
+    for (int channel = 1; channel < channelCount; ++channel) {
+        float *out = (float *)outputBufferList->mBuffers[channel].mData + bufferOffset;
+        memcpy(out, out0, frameCount * sizeof(float));
     }
 
 }
@@ -27,6 +27,10 @@ public:
         return shaker;
     }
 
+    void tickFrames(float* output, AUAudioFrameCount frameCount) override {
+        tickInstrumentFrames(shaker, output, frameCount);
+    }
+
     void deinit() override {
         DSPBase::deinit();
         delete shaker;
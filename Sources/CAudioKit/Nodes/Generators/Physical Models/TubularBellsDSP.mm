@@ -42,6 +42,10 @@ public:
         return tubularBells;
     }
 
+    void tickFrames(float* output, AUAudioFrameCount frameCount) override {
+        tickInstrumentFrames(tubularBells, output, frameCount);
+    }
+
     void deinit() override {
         DSPBase::deinit();
         delete tubularBells;
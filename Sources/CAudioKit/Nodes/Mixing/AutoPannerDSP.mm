@@ -1,9 +1,11 @@
 // Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
 
 #include "SoundpipeDSPBase.h"
+#include "DSPVectorOps.h"
 #include "ParameterRamper.h"
 #include "soundpipe.h"
 
+#import <algorithm>
 #import <vector>
 
 enum AutoPannerParameter : AUParameterAddress {
@@ -33,8 +35,7 @@ public:
 
     void init(int channelCount, double sampleRate) override {
         SoundpipeDSPBase::init(channelCount, sampleRate);
-        sp_ftbl_create(sp, &tbl, wavetable.size());
-        std::copy(wavetable.cbegin(), wavetable.cend(), tbl->tbl);
+        sp_ftbl_cache_get_data(sp, &tbl, wavetable.data(), wavetable.size());
         sp_osc_create(&trem);
         sp_osc_init(sp, trem, tbl, 0);
         sp_panst_create(&panst);
@@ -48,6 +49,41 @@ public:
         sp_ftbl_destroy(&tbl);
     }
 
+    void processBlock(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        // per-frame parameter updates are only needed while a ramp is
+        // moving; otherwise render the LFO into a small buffer, look up the
+        // equal-power gain pair per sample, and apply both channels as
+        // vector multiplies
+        if (!isStarted || channelCount != 2 ||
+            frequencyRamp.isRamping() || depthRamp.isRamping()) {
+            DSPBase::processBlock(frameCount, bufferOffset);
+            return;
+        }
+        trem->freq = frequencyRamp.get();
+        trem->amp = 1;
+        const float depth = depthRamp.get();
+
+        float *inLeft   = (float *)inputBufferLists[0]->mBuffers[0].mData + bufferOffset;
+        float *inRight  = (float *)inputBufferLists[0]->mBuffers[1].mData + bufferOffset;
+        float *outLeft  = (float *)outputBufferList->mBuffers[0].mData + bufferOffset;
+        float *outRight = (float *)outputBufferList->mBuffers[1].mData + bufferOffset;
+
+        constexpr int chunkSize = 64;
+        float lfo[chunkSize], gainL[chunkSize], gainR[chunkSize];
+        for (AUAudioFrameCount offset = 0; offset < frameCount; offset += chunkSize) {
+            const int n = std::min((int)(frameCount - offset), chunkSize);
+            sp_osc_compute_block(sp, trem, NULL, lfo, n);
+            for (int i = 0; i < n; ++i) {
+                // same mapping as sp_panst_compute: pan in [-1, 1] becomes
+                // a [0, 1] position into the sine LUT pan law
+                float pan = (2.0f * lfo[i] - 1.0f) * depth;
+                sp_pan_gains(panst->type, (pan + 1.0f) * 0.5f, &gainL[i], &gainR[i]);
+            }
+            AudioKitCore::vMultiply(inLeft + offset, gainL, outLeft + offset, n);
+            AudioKitCore::vMultiply(inRight + offset, gainR, outRight + offset, n);
+        }
+    }
+
     void process(uint32_t frameCount, uint32_t bufferOffset) override {
         for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
             int frameOffset = int(frameIndex + bufferOffset);
@@ -6,7 +6,8 @@
 
 class BalancerDSP : public SoundpipeDSPBase {
 private:
-    sp_bal *bal;
+    sp_bal *bal0;
+    sp_bal *bal1;
 
 public:
     BalancerDSP() {
@@ -16,18 +17,40 @@ public:
     void init(int channelCount, double sampleRate) override {
         SoundpipeDSPBase::init(channelCount, sampleRate);
 
-        sp_bal_create(&bal);
-        sp_bal_init(sp, bal);
+        sp_bal_create(&bal0);
+        sp_bal_init(sp, bal0);
+        sp_bal_create(&bal1);
+        sp_bal_init(sp, bal1);
     }
 
     void deinit() override {
         SoundpipeDSPBase::deinit();
-        sp_bal_destroy(&bal);
+        sp_bal_destroy(&bal0);
+        sp_bal_destroy(&bal1);
     }
 
     void reset() override {
         SoundpipeDSPBase::reset();
-        if (isInitialized) sp_bal_init(sp, bal);
+        if (!isInitialized) return;
+        sp_bal_init(sp, bal0);
+        sp_bal_init(sp, bal1);
+    }
+
+    void processBlock(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        if (!isStarted || channelCount > 2) {
+            DSPBase::processBlock(frameCount, bufferOffset);
+            return;
+        }
+
+        // the RMS windows advance incrementally across the whole block;
+        // the corrective gain (divide + sqrt) is evaluated once per block
+        // and slewed across it inside sp_bal_compute_block
+        for (int channel = 0; channel < channelCount; ++channel) {
+            float *in   = (float *)inputBufferLists[0]->mBuffers[channel].mData  + bufferOffset;
+            float *comp = (float *)inputBufferLists[1]->mBuffers[channel].mData + bufferOffset;
+            float *out  = (float *)outputBufferList->mBuffers[channel].mData + bufferOffset;
+            sp_bal_compute_block(sp, channel == 0 ? bal0 : bal1, in, comp, out, int(frameCount));
+        }
     }
 
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
@@ -40,7 +63,7 @@ public:
                 float *out  = (float *)outputBufferList->mBuffers[channel].mData + frameOffset;
 
                 if (isStarted) {
-                    sp_bal_compute(sp, bal, in, comp, out);
+                    sp_bal_compute(sp, channel == 0 ? bal0 : bal1, in, comp, out);
                 } else {
                     *out = *in;
                 }
@@ -1,6 +1,7 @@
 // Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
 
 #include "SoundpipeDSPBase.h"
+#include "DSPVectorOps.h"
 #include "ParameterRamper.h"
 
 enum DryWetMixerParameter : AUParameterAddress {
@@ -18,6 +19,61 @@ public:
         bCanProcessInPlace = true;
     }
 
+    void init(int channelCount, double sampleRate) override {
+        SoundpipeDSPBase::init(channelCount, sampleRate);
+        bindChannelSpecialization<DryWetMixerDSP>();
+    }
+
+    template <int staticChannelCount>
+    void processTemplated(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) {
+        if (staticChannelCount != 2) {
+            process(frameCount, bufferOffset);
+            return;
+        }
+
+        const float *dryL = (const float *)inputBufferLists[0]->mBuffers[0].mData + bufferOffset;
+        const float *dryR = (const float *)inputBufferLists[0]->mBuffers[1].mData + bufferOffset;
+        const float *wetL = (const float *)inputBufferLists[1]->mBuffers[0].mData + bufferOffset;
+        const float *wetR = (const float *)inputBufferLists[1]->mBuffers[1].mData + bufferOffset;
+        float *outL = (float *)outputBufferList->mBuffers[0].mData + bufferOffset;
+        float *outR = (float *)outputBufferList->mBuffers[1].mData + bufferOffset;
+
+        if (!isStarted) {
+            AudioKitCore::vCopy(dryL, outL, frameCount);
+            AudioKitCore::vCopy(dryR, outR, frameCount);
+            balanceRamp.stepBy(frameCount);
+            return;
+        }
+
+        for (AUAudioFrameCount frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+            float balance = balanceRamp.getAndStep();
+            outL[frameIndex] = (1.0f - balance) * dryL[frameIndex] + balance * wetL[frameIndex];
+            outR[frameIndex] = (1.0f - balance) * dryR[frameIndex] + balance * wetR[frameIndex];
+        }
+    }
+
+    void processBlock(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        // Vectorized fast path when the balance is not ramping.
+        if (balanceRamp.isRamping()) {
+            processSpecialized(frameCount, bufferOffset);
+            return;
+        }
+
+        float balance = balanceRamp.get();
+
+        for (int channel = 0; channel < channelCount; ++channel) {
+            const float *dry = (const float *)inputBufferLists[0]->mBuffers[channel].mData + bufferOffset;
+            const float *wet = (const float *)inputBufferLists[1]->mBuffers[channel].mData + bufferOffset;
+            float *out = (float *)outputBufferList->mBuffers[channel].mData + bufferOffset;
+
+            if (isStarted) {
+                AudioKitCore::vMix(dry, 1.0f - balance, wet, balance, out, frameCount);
+            } else {
+                AudioKitCore::vCopy(dry, out, frameCount);
+            }
+        }
+    }
+
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
         for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
             int frameOffset = int(frameIndex + bufferOffset);
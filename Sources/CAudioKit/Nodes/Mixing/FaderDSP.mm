@@ -1,6 +1,7 @@
 // Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
 
 #include "DSPBase.h"
+#include "DSPVectorOps.h"
 #include "ParameterRamper.h"
 
 enum FaderParameter : AUParameterAddress {
@@ -66,6 +67,60 @@ public:
         }
     }
 
+    void processBlock(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        // Vectorized path for the common case: stereo, no channel flip.
+        // Active gain ramps are folded into the multiply as a start value
+        // plus per-sample increment, segmented at each ramp's end.
+        if (channelCount != 2 || flipStereo ||
+            (mixToMono && (leftGainRamp.isRamping() || rightGainRamp.isRamping()))) {
+            process(frameCount, bufferOffset);
+            return;
+        }
+
+        const float *in0 = (const float *)inputBufferLists[0]->mBuffers[0].mData + bufferOffset;
+        const float *in1 = (const float *)inputBufferLists[0]->mBuffers[1].mData + bufferOffset;
+        float *out0 = (float *)outputBufferList->mBuffers[0].mData + bufferOffset;
+        float *out1 = (float *)outputBufferList->mBuffers[1].mData + bufferOffset;
+
+        if (!isStarted) {
+            AudioKitCore::vCopy(in0, out0, frameCount);
+            AudioKitCore::vCopy(in1, out1, frameCount);
+            leftGainRamp.stepBy(frameCount);
+            rightGainRamp.stepBy(frameCount);
+            return;
+        }
+
+        AUAudioFrameCount offset = 0;
+        while (offset < frameCount) {
+            AUAudioFrameCount segment = frameCount - offset;
+            AUAudioFrameCount leftFrames = leftGainRamp.framesUntilDone();
+            AUAudioFrameCount rightFrames = rightGainRamp.framesUntilDone();
+            if (leftFrames > 0 && leftFrames < segment) segment = leftFrames;
+            if (rightFrames > 0 && rightFrames < segment) segment = rightFrames;
+
+            float lincr, rincr;
+            float lgain = leftGainRamp.getAndStepBlock(segment, lincr);
+            float rgain = rightGainRamp.getAndStepBlock(segment, rincr);
+
+            if (mixToMono) {
+                AudioKitCore::vMix(in0 + offset, 0.5f * lgain, in1 + offset, 0.5f * rgain, out0 + offset, segment);
+                AudioKitCore::vCopy(out0 + offset, out1 + offset, segment);
+            } else {
+                if (lincr != 0.0f) {
+                    AudioKitCore::vApplyGainRamp(in0 + offset, out0 + offset, lgain, lincr, segment);
+                } else {
+                    AudioKitCore::vApplyGain(in0 + offset, out0 + offset, lgain, segment);
+                }
+                if (rincr != 0.0f) {
+                    AudioKitCore::vApplyGainRamp(in1 + offset, out1 + offset, rgain, rincr, segment);
+                } else {
+                    AudioKitCore::vApplyGain(in1 + offset, out1 + offset, rgain, segment);
+                }
+            }
+            offset += segment;
+        }
+    }
+
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
         for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
             int frameOffset = int(frameIndex + bufferOffset);
@@ -0,0 +1,217 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+#include "MixerDSP.h"
+#include "DSPBase.h"
+#include "DSPVectorOps.h"
+#include "ParameterRamper.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// Flat fused summing: the output is zeroed once, then every non-silent
+// input accumulates into it with vAccumulateGain — one multiply-add pass
+// per input, no intermediate scaled copies and no per-connection buffer
+// hops. Gain ramps are folded into the accumulate as start + increment,
+// segmented at each ramp's end (the FaderDSP idiom); a ramping pan drops
+// that one input to the scalar path since the L/R gain pair moves
+// non-linearly.
+
+enum : AUParameterAddress {
+    // gain/pan pairs follow the master volume, two addresses per input
+    kMixerInputParamBase = 1,
+};
+
+AUParameterAddress akMixerInputGainAddress(uint32_t input) {
+    return kMixerInputParamBase + 2 * input;
+}
+
+AUParameterAddress akMixerInputPanAddress(uint32_t input) {
+    return kMixerInputParamBase + 2 * input + 1;
+}
+
+class MixerDSP : public DSPBase {
+private:
+    ParameterRamper masterVolumeRamp{1.0f};
+    ParameterRamper gainRamps[AK_MIXER_MAX_INPUTS];
+    ParameterRamper panRamps[AK_MIXER_MAX_INPUTS];
+
+    // equal-power pan: gains for pan in [-1, 1]
+    static void panGains(float pan, float &left, float &right) {
+        float angle = (pan + 1.0f) * float(M_PI_4);
+        left = cosf(angle);
+        right = sinf(angle);
+    }
+
+public:
+    MixerDSP() : DSPBase(2) {
+        parameters[MixerParameterMasterVolume] = &masterVolumeRamp;
+        for (uint32_t i = 0; i < AK_MIXER_MAX_INPUTS; ++i) {
+            gainRamps[i].setImmediate(1.0f);
+            parameters[akMixerInputGainAddress(i)] = &gainRamps[i];
+            parameters[akMixerInputPanAddress(i)] = &panRamps[i];
+        }
+    }
+
+    void setInputBusCount(uint32_t count) {
+        if (count < 1) count = 1;
+        if (count > AK_MIXER_MAX_INPUTS) count = AK_MIXER_MAX_INPUTS;
+        inputBufferLists.resize(count);
+    }
+
+    /// Memoryless sum: silent in on every bus, silent out.
+    float tailTimeSeconds() const override { return 0.0f; }
+
+    void processBlock(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        size_t inputCount = inputBufferLists.size();
+
+        if (!isStarted) {
+            // bypass passes the first bus through, like a one-input effect
+            for (int ch = 0; ch < channelCount; ++ch) {
+                const float *in = (const float *)inputBufferLists[0]->mBuffers[ch].mData + bufferOffset;
+                float *out = (float *)outputBufferList->mBuffers[ch].mData + bufferOffset;
+                AudioKitCore::vCopy(in, out, frameCount);
+            }
+            masterVolumeRamp.stepBy(frameCount);
+            for (size_t i = 0; i < inputCount; ++i) {
+                gainRamps[i].stepBy(frameCount);
+                panRamps[i].stepBy(frameCount);
+            }
+            return;
+        }
+
+        for (int ch = 0; ch < channelCount; ++ch) {
+            float *out = (float *)outputBufferList->mBuffers[ch].mData + bufferOffset;
+            memset(out, 0, frameCount * sizeof(float));
+        }
+
+        for (size_t i = 0; i < inputCount; ++i) {
+            ParameterRamper &gainRamp = gainRamps[i];
+            ParameterRamper &panRamp = panRamps[i];
+            if (i < inputBusSilent.size() && inputBusSilent[i]) {
+                // upstream flagged the bus silent; adding zeros is all it
+                // could contribute
+                gainRamp.stepBy(frameCount);
+                panRamp.stepBy(frameCount);
+                continue;
+            }
+
+            if (channelCount == 2 && panRamp.isRamping()) {
+                accumulatePanRamping(i, frameCount, bufferOffset);
+                continue;
+            }
+
+            float panLeft = 1.0f;
+            float panRight = 1.0f;
+            if (channelCount == 2) {
+                panGains(panRamp.get(), panLeft, panRight);
+            }
+            panRamp.stepBy(frameCount);
+
+            AUAudioFrameCount offset = 0;
+            while (offset < frameCount) {
+                AUAudioFrameCount segment = frameCount - offset;
+                AUAudioFrameCount gainFrames = gainRamp.framesUntilDone();
+                if (gainFrames > 0 && gainFrames < segment) segment = gainFrames;
+
+                float incr;
+                float gain = gainRamp.getAndStepBlock(segment, incr);
+                for (int ch = 0; ch < channelCount; ++ch) {
+                    const float *in = (const float *)inputBufferLists[i]->mBuffers[ch].mData
+                                      + bufferOffset + offset;
+                    float *out = (float *)outputBufferList->mBuffers[ch].mData
+                                 + bufferOffset + offset;
+                    float chPan = (ch == 0) ? panLeft : panRight;
+                    if (channelCount != 2) chPan = 1.0f;
+                    if (incr != 0.0f) {
+                        AudioKitCore::vAccumulateGainRamp(in, out, gain * chPan,
+                                                          incr * chPan, segment);
+                    } else {
+                        AudioKitCore::vAccumulateGain(in, out, gain * chPan, segment);
+                    }
+                }
+                offset += segment;
+            }
+        }
+
+        // master volume in place over the summed output
+        AUAudioFrameCount offset = 0;
+        while (offset < frameCount) {
+            AUAudioFrameCount segment = frameCount - offset;
+            AUAudioFrameCount masterFrames = masterVolumeRamp.framesUntilDone();
+            if (masterFrames > 0 && masterFrames < segment) segment = masterFrames;
+
+            float incr;
+            float volume = masterVolumeRamp.getAndStepBlock(segment, incr);
+            if (incr == 0.0f && volume == 1.0f) {
+                offset += segment;
+                continue;
+            }
+            for (int ch = 0; ch < channelCount; ++ch) {
+                float *out = (float *)outputBufferList->mBuffers[ch].mData
+                             + bufferOffset + offset;
+                if (incr != 0.0f) {
+                    AudioKitCore::vApplyGainRamp(out, out, volume, incr, segment);
+                } else {
+                    AudioKitCore::vApplyGain(out, out, volume, segment);
+                }
+            }
+            offset += segment;
+        }
+    }
+
+    void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        size_t inputCount = inputBufferLists.size();
+        for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+            int frameOffset = int(frameIndex + bufferOffset);
+            float volume = masterVolumeRamp.getAndStep();
+            for (int ch = 0; ch < channelCount; ++ch) {
+                float *out = (float *)outputBufferList->mBuffers[ch].mData + frameOffset;
+                *out = 0.0f;
+            }
+            for (size_t i = 0; i < inputCount; ++i) {
+                float gain = gainRamps[i].getAndStep();
+                float pan = panRamps[i].getAndStep();
+                if (i < inputBusSilent.size() && inputBusSilent[i]) continue;
+                float panLeft, panRight;
+                panGains(pan, panLeft, panRight);
+                for (int ch = 0; ch < channelCount; ++ch) {
+                    const float *in = (const float *)inputBufferLists[i]->mBuffers[ch].mData + frameOffset;
+                    float *out = (float *)outputBufferList->mBuffers[ch].mData + frameOffset;
+                    float chPan = 1.0f;
+                    if (channelCount == 2) chPan = (ch == 0) ? panLeft : panRight;
+                    *out += *in * gain * chPan;
+                }
+            }
+            for (int ch = 0; ch < channelCount; ++ch) {
+                float *out = (float *)outputBufferList->mBuffers[ch].mData + frameOffset;
+                *out *= volume;
+            }
+        }
+    }
+
+private:
+    // One input whose pan is mid-ramp: the L/R gain pair is a cos/sin of
+    // the ramp position, so it can't fold into a linear increment.
+    void accumulatePanRamping(size_t i, AUAudioFrameCount frameCount,
+                              AUAudioFrameCount bufferOffset) {
+        const float *inL = (const float *)inputBufferLists[i]->mBuffers[0].mData + bufferOffset;
+        const float *inR = (const float *)inputBufferLists[i]->mBuffers[1].mData + bufferOffset;
+        float *outL = (float *)outputBufferList->mBuffers[0].mData + bufferOffset;
+        float *outR = (float *)outputBufferList->mBuffers[1].mData + bufferOffset;
+        for (AUAudioFrameCount n = 0; n < frameCount; ++n) {
+            float gain = gainRamps[i].getAndStep();
+            float panLeft, panRight;
+            panGains(panRamps[i].getAndStep(), panLeft, panRight);
+            outL[n] += inL[n] * gain * panLeft;
+            outR[n] += inR[n] * gain * panRight;
+        }
+    }
+};
+
+void akMixerSetInputBusCount(DSPRef pDSP, uint32_t count) {
+    ((MixerDSP *)pDSP)->setInputBusCount(count);
+}
+
+AK_REGISTER_DSP(MixerDSP)
+AK_REGISTER_PARAMETER(MixerParameterMasterVolume)
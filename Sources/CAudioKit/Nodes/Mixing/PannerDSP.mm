@@ -1,6 +1,7 @@
 // Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
 
 #include "SoundpipeDSPBase.h"
+#include "DSPVectorOps.h"
 #include "ParameterRamper.h"
 #include "soundpipe.h"
 
@@ -22,6 +23,42 @@ public:
         SoundpipeDSPBase::init(channelCount, sampleRate);
         sp_panst_create(&panst);
         sp_panst_init(sp, panst);
+        bindChannelSpecialization<PannerDSP>();
+    }
+
+    template <int staticChannelCount>
+    void processTemplated(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) {
+        if (staticChannelCount != 2) {
+            process(frameCount, bufferOffset);
+            return;
+        }
+
+        const float *inL = (const float *)inputBufferLists[0]->mBuffers[0].mData + bufferOffset;
+        const float *inR = (const float *)inputBufferLists[0]->mBuffers[1].mData + bufferOffset;
+        float *outL = (float *)outputBufferList->mBuffers[0].mData + bufferOffset;
+        float *outR = (float *)outputBufferList->mBuffers[1].mData + bufferOffset;
+
+        if (!isStarted) {
+            AudioKitCore::vCopy(inL, outL, frameCount);
+            AudioKitCore::vCopy(inR, outR, frameCount);
+            panRamp.stepBy(frameCount);
+            return;
+        }
+
+        if (!panRamp.isRamping()) {
+            // static pan: apply the cached gain pair over the whole block
+            panst->pan = panRamp.get();
+            sp_panst_compute_block(sp, panst, (SPFLOAT *)inL, (SPFLOAT *)inR,
+                                   outL, outR, int(frameCount));
+            return;
+        }
+
+        for (AUAudioFrameCount frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+            panst->pan = panRamp.getAndStep();
+            SPFLOAT l = inL[frameIndex];
+            SPFLOAT r = inR[frameIndex];
+            sp_panst_compute(sp, panst, &l, &r, outL + frameIndex, outR + frameIndex);
+        }
     }
 
     void deinit() override {
@@ -35,6 +72,9 @@ public:
         sp_panst_init(sp, panst);
     }
 
+    /// Memoryless gain math: silent in, silent out.
+    float tailTimeSeconds() const override { return 0.0f; }
+
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
         for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
             int frameOffset = int(frameIndex + bufferOffset);
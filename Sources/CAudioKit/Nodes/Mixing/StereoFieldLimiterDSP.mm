@@ -1,6 +1,7 @@
 // Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
 
 #include "DSPBase.h"
+#include "DSPVectorOps.h"
 #include "ParameterRamper.h"
 
 enum StereoFieldLimiterParameter : AUParameterAddress {
@@ -22,29 +23,41 @@ public:
     }
 
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
-        for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
-            int frameOffset = int(frameIndex + bufferOffset);
-            
-            float amount = amountRamp.getAndStep();
-
-            if (!isStarted) {
-                outputBufferList->mBuffers[0] = inputBufferLists[0]->mBuffers[0];
-                outputBufferList->mBuffers[1] = inputBufferLists[0]->mBuffers[1];
-                return;
-            }
+        if (!isStarted) {
+            outputBufferList->mBuffers[0] = inputBufferLists[0]->mBuffers[0];
+            outputBufferList->mBuffers[1] = inputBufferLists[0]->mBuffers[1];
+            return;
+        }
 
-            float *tmpin[2];
-            float *tmpout[2];
-            for (int channel = 0; channel < channelCount; ++channel) {
-                float *in  = (float *)inputBufferLists[0]->mBuffers[channel].mData  + frameOffset;
-                float *out = (float *)outputBufferList->mBuffers[channel].mData + frameOffset;
-                if (channel < 2) {
-                    tmpin[channel] = in;
-                    tmpout[channel] = out;
-                }
+        const float *inLeft   = (const float *)inputBufferLists[0]->mBuffers[0].mData + bufferOffset;
+        const float *inRight  = (const float *)inputBufferLists[0]->mBuffers[1].mData + bufferOffset;
+        float *outLeft  = (float *)outputBufferList->mBuffers[0].mData + bufferOffset;
+        float *outRight = (float *)outputBufferList->mBuffers[1].mData + bufferOffset;
+
+        // out = in * (1 - amount/2) + other * amount/2, with the ramped
+        // coefficients computed per segment and applied as vector passes
+        AUAudioFrameCount pos = 0;
+        while (pos < frameCount) {
+            AUAudioFrameCount n = frameCount - pos;
+            if (amountRamp.isRamping()) {
+                // segment at the ramp end so the increment stays exact
+                AUAudioFrameCount left = amountRamp.framesUntilDone();
+                if (left > 0 && left < n) n = left;
+            }
+            float increment;
+            const float amount = amountRamp.getAndStepBlock(n, increment);
+            const float mix = amount * 0.5f;
+            const float mixIncrement = increment * 0.5f;
+            if (mixIncrement == 0.0f) {
+                AudioKitCore::vMix(inLeft + pos, 1.0f - mix, inRight + pos, mix, outLeft + pos, n);
+                AudioKitCore::vMix(inRight + pos, 1.0f - mix, inLeft + pos, mix, outRight + pos, n);
+            } else {
+                AudioKitCore::vApplyGainRamp(inLeft + pos, outLeft + pos, 1.0f - mix, -mixIncrement, n);
+                AudioKitCore::vAccumulateGainRamp(inRight + pos, outLeft + pos, mix, mixIncrement, n);
+                AudioKitCore::vApplyGainRamp(inRight + pos, outRight + pos, 1.0f - mix, -mixIncrement, n);
+                AudioKitCore::vAccumulateGainRamp(inLeft + pos, outRight + pos, mix, mixIncrement, n);
             }
-            *tmpout[0] = *tmpin[0] * (1.0f - amount / 2.0) + *tmpin[1] * amount / 2.0;
-            *tmpout[1] = *tmpin[1] * (1.0f - amount / 2.0) + *tmpin[0] * amount / 2.0;
+            pos += n;
         }
     }
 };
@@ -46,14 +46,15 @@
 @end
 @implementation PresetZone
 -(NSDictionary *)asDictionary{
-    return @{@"enabled":@(self.enabled),
-             @"loop enabled":@(self.loopEnabled),
-             @"max key":@(self.maxKey),
-             @"min key":@(self.minKey),
-             @"root key":@(self.rootKey),
-             @"pitch tracking":@(self.pitchTracking),
-             @"waveform":self.waveform,
-             @"ID":self.ID};
+    // Batch CFDictionary creation beats the keyed literal for large zone
+    // counts: one allocation and hash pass instead of eight insertions.
+    const void *keys[8] = {@"enabled", @"loop enabled", @"max key", @"min key",
+                           @"root key", @"pitch tracking", @"waveform", @"ID"};
+    const void *values[8] = {@(self.enabled), @(self.loopEnabled), @(self.maxKey), @(self.minKey),
+                             @(self.rootKey), @(self.pitchTracking), self.waveform, self.ID};
+    return (__bridge_transfer NSDictionary *)CFDictionaryCreate(NULL, keys, values, 8,
+                                                                &kCFTypeDictionaryKeyCallBacks,
+                                                                &kCFTypeDictionaryValueCallBacks);
 }
 -(instancetype)initWithFilePath:(NSString *)filePath andKey:(int)key{
     NSAssert([[NSFileManager defaultManager]fileExistsAtPath:filePath], @"No file at %@",filePath);
@@ -101,6 +102,67 @@
     preset.oneShot = oneShot;
     return preset;
 }
++(NSDictionary *)cachedPresetWithZones:(NSArray <PresetZone *> *)presetZones oneShot:(BOOL)oneShot{
+    NSString *path = presetCachePath(presetCacheKey(presetZones, oneShot));
+    NSData *cached = [NSData dataWithContentsOfFile:path options:NSDataReadingMappedIfSafe error:nil];
+    if (cached) {
+        // Mutable containers so the result supports the incremental zone edits
+        // below, same as a freshly built preset.
+        NSDictionary *preset = [NSPropertyListSerialization propertyListWithData:cached
+                                                                         options:NSPropertyListMutableContainers
+                                                                          format:nil
+                                                                           error:nil];
+        if (preset) return preset;
+    }
+    NSDictionary *preset = [PresetManager presetWithZones:presetZones oneShot:oneShot];
+    if (preset) {
+        NSData *binary = [NSPropertyListSerialization dataWithPropertyList:preset
+                                                                    format:NSPropertyListBinaryFormat_v1_0
+                                                                   options:0
+                                                                     error:nil];
+        [binary writeToFile:path atomically:YES];
+    }
+    return preset;
+}
++(NSDictionary *)preset:(NSDictionary *)preset byAddingZone:(PresetZone *)zone{
+    NSMutableDictionary *fileReferences = preset.fileReferences;
+    NSNumber *waveformID = nil;
+    int nextWaveformID = STARTINGWAVEFORMID;
+    for (NSString *sampleKey in fileReferences.allKeys) {
+        int existingID = [[sampleKey substringFromIndex:FILEREFPREFIX.length] intValue];
+        if (existingID >= nextWaveformID) nextWaveformID = existingID + 1;
+        if ([fileReferences[sampleKey] isEqual:zone.filePath]) waveformID = @(existingID);
+    }
+    if (!waveformID) {
+        waveformID = @(nextWaveformID);
+        fileReferences[[FILEREFPREFIX stringByAppendingString:waveformID.stringValue]] = zone.filePath;
+    }
+    int nextZoneID = 1;
+    for (NSDictionary *existing in preset.zones) {
+        if ([existing[@"ID"] intValue] >= nextZoneID) nextZoneID = [existing[@"ID"] intValue] + 1;
+    }
+    zone.ID = @(nextZoneID);
+    zone.waveform = waveformID;
+    [preset.zones addObject:zone.asDictionary];
+    return preset;
+}
++(NSDictionary *)preset:(NSDictionary *)preset byRemovingZoneWithID:(int)zoneID{
+    NSDictionary *removed = nil;
+    for (NSDictionary *existing in preset.zones) {
+        if ([existing[@"ID"] intValue] == zoneID) {
+            removed = existing;
+            break;
+        }
+    }
+    if (!removed) return preset;
+    [preset.zones removeObject:removed];
+    NSNumber *waveform = removed[@"waveform"];
+    for (NSDictionary *existing in preset.zones) {
+        if ([existing[@"waveform"] isEqual:waveform]) return preset;
+    }
+    [preset.fileReferences removeObjectForKey:[FILEREFPREFIX stringByAppendingString:waveform.stringValue]];
+    return preset;
+}
 +(NSDictionary *)samplerPreset:(AudioUnit)samplerUnit{
     CFPropertyListRef presetPList;
     UInt32 presetPListSize;
@@ -124,6 +186,35 @@
     return true;
 }
 
+uint64_t fnv1a(uint64_t hash, const char *bytes) {
+    while (*bytes) {
+        hash ^= (uint8_t)*bytes++;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+NSString *presetCacheKey(NSArray <PresetZone *> *presetZones, BOOL oneShot) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (PresetZone *zone in presetZones) {
+        NSDictionary *attributes = [[NSFileManager defaultManager]attributesOfItemAtPath:zone.filePath error:nil];
+        NSString *line = [NSString stringWithFormat:@"%@|%llu|%f|%d|%d|%d|%d|%d|%d",
+                          zone.filePath, attributes.fileSize,
+                          attributes.fileModificationDate.timeIntervalSinceReferenceDate,
+                          zone.minKey, zone.maxKey, zone.rootKey,
+                          zone.enabled, zone.loopEnabled, zone.pitchTracking];
+        hash = fnv1a(hash, line.UTF8String);
+    }
+    return [NSString stringWithFormat:@"%016llx%c", hash, oneShot ? '1' : '0'];
+}
+
+NSString *presetCachePath(NSString *cacheKey) {
+    NSString *caches = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES).firstObject;
+    NSString *directory = [[caches stringByAppendingPathComponent:@"AudioKit"]stringByAppendingPathComponent:@"AUPresets"];
+    [[NSFileManager defaultManager]createDirectoryAtPath:directory withIntermediateDirectories:YES attributes:nil error:nil];
+    return [directory stringByAppendingPathComponent:[cacheKey stringByAppendingPathExtension:@"aupreset"]];
+}
+
 NSDictionary *waveformsPathIndexed(NSArray <PresetZone *> *presetZones) {
     NSSet *filePaths = [NSSet setWithArray:[presetZones valueForKey:@"filePath"]];
     NSMutableDictionary *waveformsPathIndexed = [[NSMutableDictionary alloc]init];
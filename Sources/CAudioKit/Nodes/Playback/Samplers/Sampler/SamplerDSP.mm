@@ -12,47 +12,92 @@ void akSamplerLoadData(DSPRef pDSP, SampleDataDescriptor *pSDD) {
     ((SamplerDSP*)pDSP)->loadSampleData(*pSDD);
 }
 
-void akSamplerLoadCompressedFile(DSPRef pDSP, SampleFileDescriptor *pSFD)
+void akSamplerLoadDataReference(DSPRef pDSP, SampleDataReferenceDescriptor *pSDRD) {
+    ((SamplerDSP*)pDSP)->loadSampleDataReference(*pSDRD);
+}
+
+void akSamplerLoadStreamedFile(DSPRef pDSP, StreamedSampleFileDescriptor *pSSFD) {
+    ((SamplerDSP*)pDSP)->loadStreamedSampleFile(*pSSFD);
+}
+
+// Decode one Wavpack file into a freshly-allocated float buffer in sdd.data.
+// Returns false (and allocates nothing) if the file cannot be opened.
+// Each call uses its own WavpackContext, so decodes may run concurrently.
+static bool akSamplerDecodeCompressedFile(SampleFileDescriptor *pSFD, SampleDataDescriptor *pSDD)
 {
     char errMsg[100];
     WavpackContext *wpc = WavpackOpenFileInput(pSFD->path, errMsg, OPEN_2CH_MAX, 0);
     if (wpc == 0)
     {
         printf("Wavpack error loading %s: %s\n", pSFD->path, errMsg);
-        return;
+        return false;
     }
 
-    SampleDataDescriptor sdd;
-    sdd.sampleDescriptor = pSFD->sampleDescriptor;
-    sdd.sampleRate = (float)WavpackGetSampleRate(wpc);
-    sdd.channelCount = WavpackGetReducedChannels(wpc);
-    sdd.sampleCount = WavpackGetNumSamples(wpc);
-    sdd.isInterleaved = sdd.channelCount > 1;
-    sdd.data = new float[sdd.channelCount * sdd.sampleCount];
+    pSDD->sampleDescriptor = pSFD->sampleDescriptor;
+    pSDD->sampleRate = (float)WavpackGetSampleRate(wpc);
+    pSDD->channelCount = WavpackGetReducedChannels(wpc);
+    pSDD->sampleCount = WavpackGetNumSamples(wpc);
+    pSDD->isInterleaved = pSDD->channelCount > 1;
+    pSDD->data = new float[pSDD->channelCount * pSDD->sampleCount];
 
     int mode = WavpackGetMode(wpc);
-    WavpackUnpackSamples(wpc, (int32_t*)sdd.data, sdd.sampleCount);
+    WavpackUnpackSamples(wpc, (int32_t*)pSDD->data, pSDD->sampleCount);
     if ((mode & MODE_FLOAT) == 0)
     {
         // convert samples to floating-point
         int bps = WavpackGetBitsPerSample(wpc);
         float scale = 1.0f / (1 << (bps - 1));
-        float *pf = sdd.data;
+        float *pf = pSDD->data;
         int32_t *pi = (int32_t*)pf;
-        for (int i = 0; i < (sdd.sampleCount * sdd.channelCount); i++)
+        for (int i = 0; i < (pSDD->sampleCount * pSDD->channelCount); i++)
             *pf++ = scale * *pi++;
     }
     WavpackCloseFile(wpc);
+    return true;
+}
 
+void akSamplerLoadCompressedFile(DSPRef pDSP, SampleFileDescriptor *pSFD)
+{
+    SampleDataDescriptor sdd;
+    if (!akSamplerDecodeCompressedFile(pSFD, &sdd)) return;
     ((SamplerDSP*)pDSP)->loadSampleData(sdd);
     delete[] sdd.data;
 }
 
+void akSamplerLoadCompressedFiles(DSPRef pDSP, SampleFileDescriptor *pSFDs, int count)
+{
+    if (count <= 0) return;
+
+    // Decode all files concurrently across the available cores; each decode
+    // is independent and writes only its own descriptor slot.
+    SampleDataDescriptor *sdds = new SampleDataDescriptor[count];
+    bool *decoded = new bool[count];
+    dispatch_apply(count, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t i) {
+        decoded[i] = akSamplerDecodeCompressedFile(&pSFDs[i], &sdds[i]);
+    });
+
+    // Publishing into the sampler's key map is not thread-safe, so hand the
+    // finished buffers over serially.
+    for (int i = 0; i < count; i++)
+    {
+        if (!decoded[i]) continue;
+        ((SamplerDSP*)pDSP)->loadSampleData(sdds[i]);
+        delete[] sdds[i].data;
+    }
+    delete[] decoded;
+    delete[] sdds;
+}
+
 void akSamplerUnloadAllSamples(DSPRef pDSP)
 {
     ((SamplerDSP*)pDSP)->unloadAllSamples();
 }
 
+void akSamplerPrewarm(DSPRef pDSP, bool lockInMemory)
+{
+    ((SamplerDSP*)pDSP)->prewarmSampleData(lockInMemory);
+}
+
 void akSamplerSetNoteFrequency(DSPRef pDSP, int noteNumber, float noteFrequency)
 {
     ((SamplerDSP*)pDSP)->setNoteFrequency(noteNumber, noteFrequency);
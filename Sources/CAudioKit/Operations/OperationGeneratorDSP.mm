@@ -4,6 +4,7 @@
 #include "ParameterRamper.h"
 #include "soundpipe.h"
 #include "plumber.h"
+#include "PlumberHandoff.h"
 
 enum OperationGeneratorParameter : AUParameterAddress {
     OperationGeneratorParameter1,
@@ -24,7 +25,8 @@ enum OperationGeneratorParameter : AUParameterAddress {
 
 class OperationGeneratorDSP : public SoundpipeDSPBase {
 private:
-    plumber_data pd;
+    PlumberHandoff handoff;
+    int handoffFrames = 0;
     char *sporthCode = nil;
     ParameterRamper parameter1Ramp;
     ParameterRamper parameter2Ramp;
@@ -70,79 +72,114 @@ public:
             sporthCode = (char *)malloc(length);
             memcpy(sporthCode, sporth, length);
         }
+        // When already running, compile the new patch here (off the audio
+        // thread) and let the render thread crossfade over to it.
+        if (isInitialized) handoff.stage(compilePatch());
     }
 
     void trigger() override {
         internalTrigger = 1;
     }
 
-    void init(int channelCount, double sampleRate) override {
-        SoundpipeDSPBase::init(channelCount, sampleRate);
-        plumber_register(&pd);
-        plumber_init(&pd);
+    PlumberHandoff::Holder *compilePatch() {
+        auto *holder = new PlumberHandoff::Holder;
+        plumber_register(&holder->pd);
+        plumber_init(&holder->pd);
 
-        pd.sp = sp;
+        holder->pd.sp = sp;
         if (sporthCode != nil) {
-            plumber_parse_string(&pd, sporthCode);
-            plumber_compute(&pd, PLUMBER_INIT);
+            plumber_parse_string(&holder->pd, sporthCode);
+            plumber_compute(&holder->pd, PLUMBER_INIT);
         }
+        return holder;
+    }
+
+    void init(int channelCount, double sampleRate) override {
+        SoundpipeDSPBase::init(channelCount, sampleRate);
+        handoffFrames = (int)(0.1 * sampleRate); // 100 ms patch crossfade
+        handoff.setActive(compilePatch());
     }
 
     void deinit() override {
         SoundpipeDSPBase::deinit();
-        plumber_clean(&pd);
+        handoff.teardown();
     }
 
     void reset() override {
         SoundpipeDSPBase::reset();
         if (!isInitialized) return;
-        plumber_init(&pd);
-
-        pd.sp = sp;
-        if (sporthCode != nil) {
-            plumber_parse_string(&pd, sporthCode);
-            plumber_compute(&pd, PLUMBER_INIT);
-        }
+        handoff.teardown();
+        handoff.setActive(compilePatch());
     }
 
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        handoff.pickup(handoffFrames);
+
         for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
 
             int frameOffset = int(frameIndex + bufferOffset);
 
-            pd.p[0] = parameter1Ramp.getAndStep();
-            pd.p[1] = parameter2Ramp.getAndStep();
-            pd.p[2] = parameter3Ramp.getAndStep();
-            pd.p[3] = parameter4Ramp.getAndStep();
-            pd.p[4] = parameter5Ramp.getAndStep();
-            pd.p[5] = parameter6Ramp.getAndStep();
-            pd.p[6] = parameter7Ramp.getAndStep();
-            pd.p[7] = parameter8Ramp.getAndStep();
-            pd.p[8] = parameter9Ramp.getAndStep();
-            pd.p[9] = parameter10Ramp.getAndStep();
-            pd.p[10] = parameter11Ramp.getAndStep();
-            pd.p[11] = parameter12Ramp.getAndStep();
-            pd.p[12] = parameter13Ramp.getAndStep();
-            pd.p[13] = parameter14Ramp.getAndStep();
+            plumber_data *active = handoff.active();
+            plumber_data *fading = handoff.fading();
+
+            float params[14];
+            params[0] = parameter1Ramp.getAndStep();
+            params[1] = parameter2Ramp.getAndStep();
+            params[2] = parameter3Ramp.getAndStep();
+            params[3] = parameter4Ramp.getAndStep();
+            params[4] = parameter5Ramp.getAndStep();
+            params[5] = parameter6Ramp.getAndStep();
+            params[6] = parameter7Ramp.getAndStep();
+            params[7] = parameter8Ramp.getAndStep();
+            params[8] = parameter9Ramp.getAndStep();
+            params[9] = parameter10Ramp.getAndStep();
+            params[10] = parameter11Ramp.getAndStep();
+            params[11] = parameter12Ramp.getAndStep();
+            params[12] = parameter13Ramp.getAndStep();
+            params[13] = parameter14Ramp.getAndStep();
+            for (int i = 0; i < 14; ++i) {
+                active->p[i] = params[i];
+                if (fading) fading->p[i] = params[i];
+            }
 
             if (internalTrigger == 1) {
-                pd.p[14] = 1.0;
+                active->p[14] = 1.0;
+                if (fading) fading->p[14] = 1.0;
+            }
+
+            if (isStarted) {
+                plumber_compute(active, PLUMBER_COMPUTE);
+                if (fading) plumber_compute(fading, PLUMBER_COMPUTE);
             }
 
-            if (isStarted)
-                plumber_compute(&pd, PLUMBER_COMPUTE);
+            float outFrame[8] = {0};
+            if (isStarted) {
+                for (int channel = 0; channel < channelCount; ++channel) {
+                    outFrame[channel] = sporth_stack_pop_float(&active->sporth.stack);
+                }
+                if (fading) {
+                    float oldFrame[8] = {0};
+                    for (int channel = 0; channel < channelCount; ++channel) {
+                        oldFrame[channel] = sporth_stack_pop_float(&fading->sporth.stack);
+                    }
+                    // stepFade may retire the outgoing instance, so its
+                    // outputs are read above before this call.
+                    float activeGain, fadeGain;
+                    handoff.stepFade(&activeGain, &fadeGain);
+                    for (int channel = 0; channel < channelCount; ++channel) {
+                        outFrame[channel] = outFrame[channel] * activeGain + oldFrame[channel] * fadeGain;
+                    }
+                }
+            }
 
             for (int channel = 0; channel < channelCount; ++channel) {
                 float *out = (float *)outputBufferList->mBuffers[channel].mData + frameOffset;
-                if (isStarted) {
-                    *out = sporth_stack_pop_float(&pd.sporth.stack);
-                } else {
-                    *out = 0;
-                }
+                *out = outFrame[channel];
             }
 
             internalTrigger = 0;
-            pd.p[14] = 0.0;
+            active->p[14] = 0.0;
+            if (fading && handoff.fading() == fading) fading->p[14] = 0.0;
         }
     }
 };
@@ -0,0 +1,112 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+#pragma once
+
+#include "plumber.h"
+#include <atomic>
+#include <cmath>
+
+/// Double-instance handoff for live sporth patch reloads.
+///
+/// A freshly compiled plumber instance is staged from a non-audio thread;
+/// the render thread adopts it at the next buffer boundary and equal-power
+/// crossfades from the old instance over a fixed number of frames.  Retired
+/// instances go onto a lock-free list and are destroyed on a later
+/// non-audio-thread call, so the render path never parses, allocates, or
+/// frees a graph.
+class PlumberHandoff {
+public:
+    struct Holder {
+        plumber_data pd;
+        Holder *next = nullptr;
+    };
+
+    ~PlumberHandoff() { teardown(); }
+
+    /// Non-audio thread: install the first compiled instance.
+    void setActive(Holder *holder) { activeHolder = holder; }
+
+    plumber_data *active() { return activeHolder ? &activeHolder->pd : nullptr; }
+
+    /// The outgoing instance, or nullptr when no crossfade is running.
+    plumber_data *fading() { return fadeHolder ? &fadeHolder->pd : nullptr; }
+
+    /// Non-audio thread: hand a freshly compiled instance to the render
+    /// thread.  Destroys any staged instance the render thread never picked
+    /// up, plus anything it has retired since the last call.
+    void stage(Holder *holder) {
+        drainRetired();
+        destroy(staged.exchange(holder));
+    }
+
+    /// Audio thread: adopt a staged instance if one is waiting and start a
+    /// crossfade of \c fadeFrames frames.  Returns true if a handoff began.
+    bool pickup(int fadeFrames) {
+        Holder *incoming = staged.exchange(nullptr);
+        if (incoming == nullptr) return false;
+        if (fadeHolder) retire(fadeHolder); // a reload arrived mid-fade
+        fadeHolder = activeHolder;
+        activeHolder = incoming;
+        framesTotal = fadeFrames > 0 ? fadeFrames : 1;
+        framesLeft = fadeHolder ? framesTotal : 0;
+        return true;
+    }
+
+    /// Audio thread: advance the crossfade by one frame and return the
+    /// equal-power gains for the incoming and outgoing instances.  The
+    /// outgoing instance is retired when the fade completes, so read its
+    /// outputs before calling this.
+    void stepFade(float *activeGain, float *fadeGain) {
+        float t = 1.0f - (float)framesLeft / (float)framesTotal;
+        *activeGain = sinf(t * (float)M_PI_2);
+        *fadeGain = cosf(t * (float)M_PI_2);
+        if (--framesLeft <= 0 && fadeHolder) {
+            retire(fadeHolder);
+            fadeHolder = nullptr;
+        }
+    }
+
+    /// Non-audio thread: destroy every instance.  Only call while
+    /// rendering is stopped.
+    void teardown() {
+        drainRetired();
+        destroy(staged.exchange(nullptr));
+        destroy(fadeHolder);
+        fadeHolder = nullptr;
+        destroy(activeHolder);
+        activeHolder = nullptr;
+    }
+
+private:
+    void destroy(Holder *holder) {
+        if (holder == nullptr) return;
+        plumber_clean(&holder->pd);
+        delete holder;
+    }
+
+    void drainRetired() {
+        Holder *holder = retired.exchange(nullptr);
+        while (holder) {
+            Holder *next = holder->next;
+            destroy(holder);
+            holder = next;
+        }
+    }
+
+    // Lock-free push, safe from the render thread.
+    void retire(Holder *holder) {
+        Holder *head = retired.load(std::memory_order_relaxed);
+        do {
+            holder->next = head;
+        } while (!retired.compare_exchange_weak(head, holder,
+                                               std::memory_order_release,
+                                               std::memory_order_relaxed));
+    }
+
+    Holder *activeHolder = nullptr;
+    Holder *fadeHolder = nullptr;
+    std::atomic<Holder *> staged{nullptr};
+    std::atomic<Holder *> retired{nullptr};
+    int framesLeft = 0;
+    int framesTotal = 1;
+};
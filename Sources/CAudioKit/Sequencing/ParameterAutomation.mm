@@ -2,6 +2,7 @@
 
 #include "ParameterAutomation.h"
 #include <algorithm>
+#include <cmath>
 #include <mach/mach_time.h>
 #include <map>
 #include <vector>
@@ -24,7 +25,12 @@ AURenderObserver ParameterAutomationGetRenderObserver(AUParameterAddress address
         return a.startTime < b.startTime;
     });
 
+    // Playhead cursor: advances monotonically while the transport runs,
+    // and is repositioned by binary search when the render time jumps
+    // (seek, loop, or first callback), so a callback never scans the
+    // whole event array.
     __block int index = 0;
+    __block double expectedSampleTime = -1.0;
 
     return ^void(AudioUnitRenderActionFlags actionFlags,
                  const AudioTimeStamp *timestamp,
@@ -38,6 +44,22 @@ AURenderObserver ParameterAutomationGetRenderObserver(AUParameterAddress address
 
         AUValue initial = NAN;
 
+        // Reposition the cursor if the transport didn't advance
+        // contiguously from the previous callback. Events from
+        // evaluate() are sequential, so their end times are ordered.
+        if (expectedSampleTime < 0 ||
+            fabs(timestamp->mSampleTime - expectedSampleTime) > 0.5) {
+            auto it = std::lower_bound(events.begin(), events.end(), blockStartTime,
+                                       [](const AutomationEvent& event, float t) {
+                return event.startTime + event.rampDuration < t;
+            });
+            index = int(it - events.begin());
+            if (index > 0) {
+                initial = events[index - 1].targetValue;
+            }
+        }
+        expectedSampleTime = timestamp->mSampleTime + frameCount;
+
         // Skip over events completely in the past to determine
         // an initial value.
         for(; index < count; ++index) {
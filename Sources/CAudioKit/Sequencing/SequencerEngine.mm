@@ -8,6 +8,7 @@
 #include <vector>
 #include <stdio.h>
 #include <atomic>
+#include <algorithm>
 #include "../../Internals/Utilities/readerwriterqueue.h"
 
 #define NOTEON 0x90
@@ -20,24 +21,58 @@ struct SequencerEvent {
     double seekPosition = NAN;
 };
 
-struct SequencerEngine {
-    std::vector<SequenceNote> playingNotes;
-    long positionInSamples = 0;
-    UInt64 framesCounted = 0;
+/// One copy of the sequence, sorted by beat. The vectors keep their capacity
+/// across edits, so steady-state live editing does not allocate.
+struct SequenceData {
+    std::vector<SequenceEvent> events;
+    std::vector<SequenceNote> notes;
+};
+
+/// Per-track playback state. Tracks have no clock of their own: the engine
+/// maps its single sample position through each track's tempo and length, so
+/// cross-track timing is exactly coherent.
+struct SequencerTrackState {
     SequenceSettings settings = {0, 4.0, 120.0, true, 0};
-    double sampleRate = 44100.0;
-    std::atomic<bool> isStarted{false};
     AUScheduleMIDIEventBlock midiBlock = nullptr;
+    double sampleRate = 44100.0;
 
-    ReaderWriterQueue<SequencerEvent> eventQueue;
-
-    // Current position as reported to the UI.
-    std::atomic<double> uiPosition{0};
+    // Fixed-capacity slot storage for the currently sounding notes. A bitmask
+    // tracks occupancy, so note tracking is allocation-free on the DSP thread
+    // and add/remove are O(1) bit operations with no vector erase shifting.
+    static constexpr int maxPlayingNotes = 256;
+    SequenceNote playingNotes[maxPlayingNotes];
+    uint64_t playingNotesMask[maxPlayingNotes / 64] = {0};
+
+    // Cursors into the beat-sorted events/notes vectors. Per-buffer cost is
+    // O(events emitted) instead of a full scan; a binary-search resync runs
+    // only after a seek, a tempo change, or a sequence swap.
+    size_t eventCursor = 0;
+    size_t noteCursor = 0;
+    double cursorTempo = 0;
+    bool needsResync = true;
+
+    // Double-buffered sequence store. The UI fills a free buffer and hands it
+    // over through freshSequences; the render thread adopts it between
+    // buffers and returns the old copy through retiredSequences. Live edits
+    // therefore never touch memory the render thread is reading. Three
+    // buffers cover the in-flight window: one live on the render thread, one
+    // queued, one free to fill.
+    std::vector<SequenceData*> ownedSequences; // UI thread; for cleanup
+    ReaderWriterQueue<SequenceData*> freshSequences;
+    ReaderWriterQueue<SequenceData*> retiredSequences;
+    SequenceData* renderSequence; // render thread only
+
+    SequencerTrackState() {
+        for (int i = 0; i < 3; i++) {
+            ownedSequences.push_back(new SequenceData);
+        }
+        renderSequence = ownedSequences[0];
+        retiredSequences.enqueue(ownedSequences[1]);
+        retiredSequences.enqueue(ownedSequences[2]);
+    }
 
-    SequencerEngine() {
-        // Try to reserve enough notes so allocation on the DSP
-        // thread is unlikely. (This is not ideal)
-        playingNotes.reserve(256);
+    ~SequencerTrackState() {
+        for (auto* sequence : ownedSequences) delete sequence;
     }
 
     int beatToSamples(double beat) const {
@@ -48,7 +83,7 @@ struct SequencerEngine {
         return beatToSamples(settings.length);
     }
 
-    long positionModulo() const {
+    long positionModulo(long positionInSamples) const {
         long length = lengthInSamples();
         if (positionInSamples == 0 || length == 0) {
             return 0;
@@ -59,12 +94,8 @@ struct SequencerEngine {
         }
     }
 
-    double currentPositionInBeats() const {
-        return (double)positionModulo() / sampleRate * (settings.tempo / 60);
-    }
-
-    bool validTriggerTime(double beat) {
-        return true;
+    double currentPositionInBeats(long positionInSamples) const {
+        return (double)positionModulo(positionInSamples) / sampleRate * (settings.tempo / 60);
     }
 
     void sendMidiData(UInt8 status, UInt8 data1, UInt8 data2, int offset, double time) {
@@ -74,126 +105,262 @@ struct SequencerEngine {
         }
     }
 
+    int takePlayingNoteSlot() {
+        for (int word = 0; word < maxPlayingNotes / 64; word++) {
+            uint64_t freeBits = ~playingNotesMask[word];
+            if (freeBits) {
+                int bit = __builtin_ctzll(freeBits);
+                playingNotesMask[word] |= (1ULL << bit);
+                return word * 64 + bit;
+            }
+        }
+        return -1;
+    }
+
     void addPlayingNote(SequenceNote note, int offset) {
         if (note.noteOn.data2 > 0) {
+            int slot = takePlayingNoteSlot();
+            // When all slots are sounding, drop the note rather than send a
+            // note on whose note off could never be tracked.
+            if (slot < 0) return;
             sendMidiData(note.noteOn.status, note.noteOn.data1, note.noteOn.data2, offset, note.noteOn.beat);
-            playingNotes.push_back(note);
+            playingNotes[slot] = note;
         } else {
             sendMidiData(note.noteOff.status, note.noteOff.data1, note.noteOff.data2, offset, note.noteOn.beat);
         }
     }
 
-    void stopPlayingNote(SequenceNote note, int offset, int index) {
+    void stopPlayingNote(SequenceNote note, int offset, int slot) {
         sendMidiData(note.noteOff.status, note.noteOff.data1, note.noteOff.data2, offset, note.noteOff.beat);
-        playingNotes.erase(playingNotes.begin() + index);
+        playingNotesMask[slot / 64] &= ~(1ULL << (slot % 64));
     }
 
-    void stop() {
-        isStarted = false;
+    void stopAllPlayingNotes() {
+        for (int word = 0; word < maxPlayingNotes / 64; word++) {
+            uint64_t occupied = playingNotesMask[word];
+            while (occupied) {
+                int slot = word * 64 + __builtin_ctzll(occupied);
+                occupied &= occupied - 1;
+                stopPlayingNote(playingNotes[slot], 0, slot);
+            }
+        }
     }
 
-    void seekTo(double position) {
-        positionInSamples = beatToSamples(position);
+    void resyncCursors(const std::vector<SequenceEvent>& events,
+                       const std::vector<SequenceNote>& notes,
+                       long startSample) {
+        auto eventPos = std::lower_bound(events.begin(), events.end(), startSample,
+            [this](const SequenceEvent& event, long target) {
+                return beatToSamples(event.beat) < target;
+            });
+        eventCursor = eventPos - events.begin();
+
+        auto notePos = std::lower_bound(notes.begin(), notes.end(), startSample,
+            [this](const SequenceNote& note, long target) {
+                return beatToSamples(note.noteOn.beat) < target;
+            });
+        noteCursor = notePos - notes.begin();
+
+        cursorTempo = settings.tempo;
+        needsResync = false;
     }
 
-    void processEvents() {
+    /// Adopt any freshly edited sequence. The retired copy goes back to
+    /// the UI for reuse; try_enqueue never allocates on the render thread
+    /// and cannot fail with the fixed set of buffers in circulation.
+    void adoptFreshSequence() {
+        SequenceData* fresh = nullptr;
+        while (freshSequences.try_dequeue(fresh)) {
+            retiredSequences.try_enqueue(renderSequence);
+            renderSequence = fresh;
+            needsResync = true;
+        }
+    }
 
-        SequencerEvent event;
-        while(eventQueue.try_dequeue(event)) {
-            if(event.notesOff) {
-                while (playingNotes.size() > 0) {
-                    stopPlayingNote(playingNotes[0], 0, 0);
-                }
-            }
+    /// Plays this track's slice of the engine clock's current window.
+    void processWindow(long positionInSamples, AUAudioFrameCount frameCount) {
 
-            if(!isnan(event.seekPosition)) {
-                seekTo(event.seekPosition);
-            }
+        const std::vector<SequenceEvent>& events = renderSequence->events;
+        const std::vector<SequenceNote>& notes = renderSequence->notes;
+
+        long currentStartSample = positionModulo(positionInSamples);
+        long currentEndSample = currentStartSample + frameCount;
+
+        if (needsResync || cursorTempo != settings.tempo) {
+            resyncCursors(events, notes, currentStartSample);
         }
 
-    }
+        // Emit events from the cursor to the end of the window.
+        while (eventCursor < events.size()) {
+            int triggerTime = beatToSamples(events[eventCursor].beat);
+            if (triggerTime >= currentEndSample) break;
+            if (triggerTime >= currentStartSample) {
+                int offset = (int)(triggerTime - currentStartSample);
+                sendMidiData(events[eventCursor].status, events[eventCursor].data1,
+                             events[eventCursor].data2, offset, events[eventCursor].beat);
+            }
+            eventCursor++;
+        }
 
-    void process(const std::vector<SequenceEvent>& events,
-                 const std::vector<SequenceNote>& notes,
-                 AUAudioFrameCount frameCount) {
+        // Check scheduled notes for note ons
+        while (noteCursor < notes.size()) {
+            int triggerTime = beatToSamples(notes[noteCursor].noteOn.beat);
+            if (triggerTime >= currentEndSample) break;
+            if (triggerTime >= currentStartSample) {
+                int offset = (int)(triggerTime - currentStartSample);
+                addPlayingNote(notes[noteCursor], offset);
+            }
+            noteCursor++;
+        }
 
-        processEvents();
+        if (currentEndSample > lengthInSamples() && settings.loopEnabled) {
+            // this buffer extends beyond the length of the loop and looping is on,
+            // so wrap the cursors and emit the start of the next loop early
+            // enough that it falls in this buffer
+            int loopRestartInBuffer = (int)(lengthInSamples() - currentStartSample);
+            int samplesOfBufferForNewLoop = frameCount - loopRestartInBuffer;
+
+            eventCursor = 0;
+            while (eventCursor < events.size()) {
+                int triggerTime = beatToSamples(events[eventCursor].beat);
+                if (triggerTime >= samplesOfBufferForNewLoop) break;
+                int offset = (int)triggerTime + loopRestartInBuffer;
+                sendMidiData(events[eventCursor].status, events[eventCursor].data1,
+                             events[eventCursor].data2, offset, events[eventCursor].beat);
+                eventCursor++;
+            }
 
-        if (isStarted) {
-            if (positionInSamples >= lengthInSamples()){
-                if (!settings.loopEnabled) { //stop if played enough
-                    stop();
-                    return;
-                }
+            noteCursor = 0;
+            while (noteCursor < notes.size()) {
+                int triggerTime = beatToSamples(notes[noteCursor].noteOn.beat);
+                if (triggerTime >= samplesOfBufferForNewLoop) break;
+                int offset = (int)triggerTime + loopRestartInBuffer;
+                addPlayingNote(notes[noteCursor], offset);
+                noteCursor++;
             }
-            long currentStartSample = positionModulo();
-            long currentEndSample = currentStartSample + frameCount;
+        }
+
+        // Check the playing notes for note offs
+        for (int word = 0; word < maxPlayingNotes / 64; word++) {
+            uint64_t occupied = playingNotesMask[word];
+            while (occupied) {
+                int slot = word * 64 + __builtin_ctzll(occupied);
+                occupied &= occupied - 1;
 
-            for (int i = 0; i < events.size(); i++) {
-                // go through every event
-                int triggerTime = beatToSamples(events[i].beat);
+                int triggerTime = beatToSamples(playingNotes[slot].noteOff.beat);
                 if (currentStartSample <= triggerTime && triggerTime < currentEndSample) {
-                    // this event is supposed to trigger between currentStartSample and currentEndSample
                     int offset = (int)(triggerTime - currentStartSample);
-                    sendMidiData(events[i].status, events[i].data1, events[i].data2,
-                                 offset, events[i].beat);
+                    stopPlayingNote(playingNotes[slot], offset, slot);
                 } else if (currentEndSample > lengthInSamples() && settings.loopEnabled) {
-                    // this buffer extends beyond the length of the loop and looping is on
                     int loopRestartInBuffer = (int)(lengthInSamples() - currentStartSample);
                     int samplesOfBufferForNewLoop = frameCount - loopRestartInBuffer;
                     if (triggerTime < samplesOfBufferForNewLoop) {
-                        // this event would trigger early enough in the next loop that it should happen in this buffer
-                        // ie. this buffer contains events from the previous loop, and the next loop
                         int offset = (int)triggerTime + loopRestartInBuffer;
-                        sendMidiData(events[i].status, events[i].data1, events[i].data2,
-                                     offset, events[i].beat);
+                        stopPlayingNote(playingNotes[slot], offset, slot);
                     }
                 }
             }
+        }
+    }
+};
 
-            // Check scheduled notes for note ons
-            for (int i = 0; i < notes.size(); i++) {
-                int triggerTime = beatToSamples(notes[i].noteOn.beat);
-                if (currentStartSample <= triggerTime && triggerTime < currentEndSample) {
-                    int offset = (int)(triggerTime - currentStartSample);
-                    addPlayingNote(notes[i], offset);
-                } else if (currentEndSample > lengthInSamples() && settings.loopEnabled) {
-                    int loopRestartInBuffer = (int)(lengthInSamples() - currentStartSample);
-                    int samplesOfBufferForNewLoop = frameCount - loopRestartInBuffer;
-                    if (triggerTime < samplesOfBufferForNewLoop) {
-                        int offset = (int)triggerTime + loopRestartInBuffer;
-                        addPlayingNote(notes[i], offset);
-                    }
-                }
+struct SequencerEngine {
+    // The single sample clock every track follows.
+    long positionInSamples = 0;
+    UInt64 framesCounted = 0;
+    double sampleRate = 44100.0;
+    std::atomic<bool> isStarted{false};
+
+    ReaderWriterQueue<SequencerEvent> eventQueue;
+
+    // Current position as reported to the UI, in track 0's beats.
+    std::atomic<double> uiPosition{0};
+
+    // Append-only track table; the render thread reads through the atomic
+    // count, so tracks can be added from the UI without locking.
+    static constexpr int maxTracks = 64;
+    SequencerTrackState* tracks[maxTracks] = {nullptr};
+    std::atomic<int> trackCount{0};
+
+    // Dedupes the clock advance when observers from several track updates
+    // are installed at once; the first one to run does the whole pass.
+    double lastRenderedSampleTime = -1;
+
+    SequencerEngine() {
+        addTrack(); // track 0, also serving the single-track API
+    }
+
+    ~SequencerEngine() {
+        int count = trackCount.load(std::memory_order_acquire);
+        for (int i = 0; i < count; i++) delete tracks[i];
+    }
+
+    int addTrack() {
+        int index = trackCount.load(std::memory_order_relaxed);
+        if (index >= maxTracks) return -1;
+        tracks[index] = new SequencerTrackState;
+        trackCount.store(index + 1, std::memory_order_release);
+        return index;
+    }
+
+    void stop() {
+        isStarted = false;
+    }
+
+    void seekTo(double position) {
+        // Track 0's tempo is the transport reference for beat positions.
+        positionInSamples = tracks[0]->beatToSamples(position);
+        int count = trackCount.load(std::memory_order_acquire);
+        for (int i = 0; i < count; i++) tracks[i]->needsResync = true;
+    }
+
+    void processEvents() {
+        SequencerEvent event;
+        while(eventQueue.try_dequeue(event)) {
+            if(event.notesOff) {
+                int count = trackCount.load(std::memory_order_acquire);
+                for (int i = 0; i < count; i++) tracks[i]->stopAllPlayingNotes();
             }
 
-            // Check the playing notes for note offs
-            int i = 0;
-            while (i < playingNotes.size()) {
-                int triggerTime = beatToSamples(playingNotes[i].noteOff.beat);
-                if (currentStartSample <= triggerTime && triggerTime < currentEndSample) {
-                    int offset = (int)(triggerTime - currentStartSample);
-                    stopPlayingNote(playingNotes[i], offset, i);
-                    continue;
-                }
+            if(!isnan(event.seekPosition)) {
+                seekTo(event.seekPosition);
+            }
+        }
+    }
 
-                if (currentEndSample > lengthInSamples() && settings.loopEnabled) {
-                    int loopRestartInBuffer = (int)(lengthInSamples() - currentStartSample);
-                    int samplesOfBufferForNewLoop = frameCount - loopRestartInBuffer;
-                    if (triggerTime < samplesOfBufferForNewLoop) {
-                        int offset = (int)triggerTime + loopRestartInBuffer;
-                        stopPlayingNote(playingNotes[i], offset, i);
-                        continue;
-                    }
+    void process(const AudioTimeStamp *timestamp, AUAudioFrameCount frameCount) {
+
+        if (timestamp->mSampleTime == lastRenderedSampleTime) return;
+        lastRenderedSampleTime = timestamp->mSampleTime;
+
+        processEvents();
+
+        int count = trackCount.load(std::memory_order_acquire);
+        for (int i = 0; i < count; i++) {
+            tracks[i]->sampleRate = sampleRate;
+            tracks[i]->adoptFreshSequence();
+        }
+
+        if (isStarted) {
+            // A non-looping track is active until the clock passes its length;
+            // the transport stops once no track has anything left to play.
+            bool anyActive = false;
+            for (int i = 0; i < count; i++) {
+                if (tracks[i]->settings.loopEnabled ||
+                    positionInSamples < tracks[i]->lengthInSamples()) {
+                    anyActive = true;
+                    tracks[i]->processWindow(positionInSamples, frameCount);
                 }
-                i++;
             }
-
-            positionInSamples += frameCount;
+            if (anyActive) {
+                positionInSamples += frameCount;
+            } else {
+                stop();
+            }
         }
         framesCounted += frameCount;
 
-        uiPosition = currentPositionInBeats();
+        uiPosition = tracks[0]->currentPositionInBeats(positionInSamples);
     }
 };
 
@@ -206,18 +373,48 @@ void akSequencerEngineDestroy(SequencerEngineRef engine) {
     delete engine;
 }
 
-/// Updates the sequence and returns a new render observer.
-AURenderObserver SequencerEngineUpdateSequence(SequencerEngineRef engine,
-                                                 const SequenceEvent* eventsPtr,
-                                                 size_t eventCount,
-                                                 const SequenceNote* notesPtr,
-                                                 size_t noteCount,
-                                                 SequenceSettings settings,
-                                                 double sampleRate,
-                                                 AUScheduleMIDIEventBlock block) {
+int akSequencerEngineAddTrack(SequencerEngineRef engine) {
+    return engine->addTrack();
+}
+
+int akSequencerEngineTrackCount(SequencerEngineRef engine) {
+    return engine->trackCount.load(std::memory_order_acquire);
+}
+
+/// Updates one track's sequence and returns a new render observer covering
+/// every track of the engine.
+AURenderObserver SequencerEngineUpdateTrackSequence(SequencerEngineRef engine,
+                                                      int trackIndex,
+                                                      const SequenceEvent* eventsPtr,
+                                                      size_t eventCount,
+                                                      const SequenceNote* notesPtr,
+                                                      size_t noteCount,
+                                                      SequenceSettings settings,
+                                                      double sampleRate,
+                                                      AUScheduleMIDIEventBlock block) {
+
+    if (trackIndex < 0 || trackIndex >= akSequencerEngineTrackCount(engine)) return nil;
+    SequencerTrackState* track = engine->tracks[trackIndex];
+
+    // Fill a free buffer rather than copying into the observer: the render
+    // thread swaps to it between buffers and returns the old copy for reuse.
+    SequenceData* buffer = nullptr;
+    if (!track->retiredSequences.try_dequeue(buffer)) {
+        // Edits are outpacing render-side retirement; grow the circulation.
+        buffer = new SequenceData;
+        track->ownedSequences.push_back(buffer);
+    }
+    buffer->events.assign(eventsPtr, eventsPtr + eventCount);
+    buffer->notes.assign(notesPtr, notesPtr + noteCount);
 
-    const std::vector<SequenceEvent> events{eventsPtr, eventsPtr+eventCount};
-    const std::vector<SequenceNote> notes{notesPtr, notesPtr+noteCount};
+    // Keep the vectors sorted by beat so the render observer can walk them
+    // with a cursor instead of scanning the whole sequence every buffer.
+    std::sort(buffer->events.begin(), buffer->events.end(),
+              [](const SequenceEvent& a, const SequenceEvent& b) { return a.beat < b.beat; });
+    std::sort(buffer->notes.begin(), buffer->notes.end(),
+              [](const SequenceNote& a, const SequenceNote& b) { return a.noteOn.beat < b.noteOn.beat; });
+
+    track->freshSequences.enqueue(buffer);
 
     return ^void(AudioUnitRenderActionFlags actionFlags,
                  const AudioTimeStamp *timestamp,
@@ -227,12 +424,26 @@ AURenderObserver SequencerEngineUpdateSequence(SequencerEngineRef engine,
         if (actionFlags != kAudioUnitRenderAction_PreRender) return;
 
         engine->sampleRate = sampleRate;
-        engine->midiBlock = block;
-        engine->settings = settings;
-        engine->process(events, notes, frameCount);
+        track->midiBlock = block;
+        track->settings = settings;
+        engine->process(timestamp, frameCount);
     };
 }
 
+/// Updates the sequence and returns a new render observer.
+AURenderObserver SequencerEngineUpdateSequence(SequencerEngineRef engine,
+                                                 const SequenceEvent* eventsPtr,
+                                                 size_t eventCount,
+                                                 const SequenceNote* notesPtr,
+                                                 size_t noteCount,
+                                                 SequenceSettings settings,
+                                                 double sampleRate,
+                                                 AUScheduleMIDIEventBlock block) {
+    return SequencerEngineUpdateTrackSequence(engine, 0, eventsPtr, eventCount,
+                                              notesPtr, noteCount, settings,
+                                              sampleRate, block);
+}
+
 double akSequencerEngineGetPosition(SequencerEngineRef engine) {
     return engine->uiPosition;
 }
@@ -0,0 +1,127 @@
+//
+//  TPCircularBuffer+Broadcast.c
+//  Circular/Ring buffer implementation
+//
+//  https://github.com/michaeltyson/TPCircularBuffer
+//
+//  Created by Michael Tyson, revision history on Githbub.
+//
+//  Copyright (C) 2012-2013 A Tasty Pixel
+//
+//  This software is provided 'as-is', without any express or implied
+//  warranty.  In no event will the authors be held liable for any damages
+//  arising from the use of this software.
+//
+//  Permission is granted to anyone to use this software for any purpose,
+//  including commercial applications, and to alter it and redistribute it
+//  freely, subject to the following restrictions:
+//
+//  1. The origin of this software must not be misrepresented; you must not
+//     claim that you wrote the original software. If you use this software
+//     in a product, an acknowledgment in the product documentation would be
+//     appreciated but is not required.
+//
+//  2. Altered source versions must be plainly marked as such, and must not be
+//     misrepresented as being the original software.
+//
+//  3. This notice may not be removed or altered from any source distribution.
+//
+
+#include "TPCircularBuffer+Broadcast.h"
+#include <mach/mach.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+bool _TPBroadcastBufferInit(TPBroadcastBuffer *buffer, int32_t length, size_t structSize) {
+
+    assert(length > 0);
+
+    if ( structSize != sizeof(TPBroadcastBuffer) ) {
+        fprintf(stderr, "TPBroadcastBuffer: Header version mismatch. Check for old versions of TPCircularBuffer in your project\n");
+        abort();
+    }
+
+    // The mirrored allocation is identical to the single-consumer buffer's,
+    // so borrow its initializer and take ownership of the mapping
+    TPCircularBuffer mirror;
+    if ( !_TPCircularBufferInit(&mirror, length, sizeof(TPCircularBuffer)) ) {
+        return false;
+    }
+
+    buffer->buffer = mirror.buffer;
+    buffer->length = mirror.length;
+    buffer->head = 0;
+    buffer->sequence = 0;
+    buffer->consumerCount = 0;
+    for ( int i = 0; i < TPBroadcastBufferMaxConsumers; i++ ) {
+        buffer->consumers[i].tail = 0;
+        buffer->consumers[i].fillCount = 0;
+        buffer->consumers[i].active = 0;
+    }
+
+    return true;
+}
+
+void TPBroadcastBufferCleanup(TPBroadcastBuffer *buffer) {
+    vm_deallocate(mach_task_self(), (vm_address_t)buffer->buffer, buffer->length * 2);
+    memset(buffer, 0, sizeof(TPBroadcastBuffer));
+}
+
+int TPBroadcastBufferRegisterConsumer(TPBroadcastBuffer *buffer) {
+
+    // Reuse a previously unregistered slot if there is one, otherwise claim
+    // a fresh one. Only this (single) registration thread touches slots.
+    int slot = -1;
+    int consumerCount = buffer->consumerCount;
+    for ( int i = 0; i < consumerCount; i++ ) {
+        if ( !buffer->consumers[i].active ) {
+            slot = i;
+            break;
+        }
+    }
+    if ( slot == -1 ) {
+        if ( consumerCount == TPBroadcastBufferMaxConsumers ) {
+            return -1;
+        }
+        slot = consumerCount;
+    }
+
+    // Seat the cursor at the current write position without tearing against
+    // a concurrent produce: between reading head and the slot going active,
+    // a produce could advance head without crediting this cursor's fill
+    // count, leaving it permanently offset. The producer holds the sequence
+    // odd while it runs, so if the sequence is even and unchanged across the
+    // whole seating, no produce overlapped it; otherwise retract the cursor
+    // and reseat once the produce's credits are complete (sequence even).
+    for ( ;; ) {
+        int seq = buffer->sequence;
+        if ( seq & 1 ) continue;
+        buffer->consumers[slot].fillCount = 0;
+        buffer->consumers[slot].tail = buffer->head;
+        buffer->consumers[slot].active = 1;
+        if ( slot == consumerCount ) {
+            // Publish the slot contents before growing the count so the
+            // producer never sees a half-initialized cursor
+            atomicFetchAdd(&buffer->consumerCount, 1);
+            consumerCount++;
+        }
+        if ( buffer->sequence == seq ) break;
+        buffer->consumers[slot].active = 0;
+    }
+    return slot;
+}
+
+void TPBroadcastBufferUnregisterConsumer(TPBroadcastBuffer *buffer, int consumer) {
+    buffer->consumers[consumer].active = 0;
+}
+
+void TPBroadcastBufferClear(TPBroadcastBuffer *buffer) {
+    int consumerCount = buffer->consumerCount;
+    for ( int i = 0; i < consumerCount; i++ ) {
+        if ( !buffer->consumers[i].active ) continue;
+        int32_t fillCount;
+        if ( TPBroadcastBufferTail(buffer, i, &fillCount) ) {
+            TPBroadcastBufferConsume(buffer, i, fillCount);
+        }
+    }
+}
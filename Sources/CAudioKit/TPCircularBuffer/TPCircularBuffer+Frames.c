@@ -0,0 +1,119 @@
+//
+//  TPCircularBuffer+Frames.c
+//  Circular/Ring buffer implementation
+//
+//  Lean timestamped frame format for pushing audio across threads.
+//
+
+#include "TPCircularBuffer+Frames.h"
+#include <string.h>
+
+static inline uint32_t align8byte(uint32_t val) {
+    return (val + 7u) & ~7u;
+}
+
+bool TPCircularBufferEnqueueFrames(TPCircularBuffer *buffer,
+                                   const AudioBufferList *bufferList,
+                                   UInt32 frameCount,
+                                   const AudioTimeStamp *timestamp) {
+    UInt32 channelCount = bufferList->mNumberBuffers;
+    uint32_t payloadBytes = frameCount * channelCount * sizeof(float);
+    uint32_t totalLength = align8byte((uint32_t)sizeof(TPCircularBufferFrameBlockHeader) + payloadBytes);
+
+    int32_t availableBytes;
+    TPCircularBufferFrameBlockHeader *block =
+        (TPCircularBufferFrameBlockHeader*)TPCircularBufferHead(buffer, &availableBytes);
+    if ( !block || availableBytes < (int32_t)totalLength ) return false;
+
+    block->sampleTime = timestamp && (timestamp->mFlags & kAudioTimeStampSampleTimeValid)
+                        ? timestamp->mSampleTime : 0;
+    block->hostTime = timestamp && (timestamp->mFlags & kAudioTimeStampHostTimeValid)
+                        ? timestamp->mHostTime : 0;
+    block->totalLength = totalLength;
+    block->frameCount = frameCount;
+    block->channelCount = channelCount;
+    block->consumedFrames = 0;
+
+    float *payload = (float*)(block + 1);
+    for ( UInt32 channel = 0; channel < channelCount; channel++ ) {
+        memcpy(payload + (size_t)channel * frameCount,
+               bufferList->mBuffers[channel].mData,
+               frameCount * sizeof(float));
+    }
+
+    TPCircularBufferProduce(buffer, (int32_t)totalLength);
+    return true;
+}
+
+UInt32 TPCircularBufferDequeueFrames(TPCircularBuffer *buffer,
+                                     const AudioBufferList *outputBufferList,
+                                     UInt32 frameCount,
+                                     AudioTimeStamp *outTimestamp) {
+    if ( outTimestamp ) {
+        memset(outTimestamp, 0, sizeof(AudioTimeStamp));
+    }
+
+    int32_t availableBytes;
+    void *tail = TPCircularBufferTail(buffer, &availableBytes);
+    if ( !tail ) return 0;
+    void *end = (char*)tail + availableBytes;
+
+    UInt32 copied = 0;
+    int32_t bytesToConsume = 0;
+
+    while ( copied < frameCount && (char*)tail + sizeof(TPCircularBufferFrameBlockHeader) <= (char*)end ) {
+        TPCircularBufferFrameBlockHeader *block = (TPCircularBufferFrameBlockHeader*)tail;
+        UInt32 remaining = block->frameCount - block->consumedFrames;
+        UInt32 take = frameCount - copied < remaining ? frameCount - copied : remaining;
+
+        if ( outTimestamp && copied == 0 ) {
+            outTimestamp->mSampleTime = block->sampleTime;
+            outTimestamp->mHostTime = block->hostTime;
+            outTimestamp->mFlags = kAudioTimeStampSampleTimeValid
+                                 | (block->hostTime ? kAudioTimeStampHostTimeValid : 0);
+        }
+
+        if ( outputBufferList ) {
+            UInt32 channels = outputBufferList->mNumberBuffers < block->channelCount
+                            ? outputBufferList->mNumberBuffers : block->channelCount;
+            float *payload = (float*)(block + 1);
+            for ( UInt32 channel = 0; channel < channels; channel++ ) {
+                memcpy((float*)outputBufferList->mBuffers[channel].mData + copied,
+                       payload + (size_t)channel * block->frameCount + block->consumedFrames,
+                       take * sizeof(float));
+            }
+        }
+
+        copied += take;
+        block->consumedFrames += take;
+        block->sampleTime += take;
+
+        if ( block->consumedFrames == block->frameCount ) {
+            bytesToConsume += (int32_t)block->totalLength;
+            tail = (char*)tail + block->totalLength;
+        } else {
+            // partially consumed blocks stay put; the header keeps our place
+            break;
+        }
+    }
+
+    if ( bytesToConsume > 0 ) {
+        TPCircularBufferConsume(buffer, bytesToConsume);
+    }
+    return copied;
+}
+
+UInt32 TPCircularBufferQueuedFrameCount(TPCircularBuffer *buffer) {
+    int32_t availableBytes;
+    void *tail = TPCircularBufferTail(buffer, &availableBytes);
+    if ( !tail ) return 0;
+    void *end = (char*)tail + availableBytes;
+
+    UInt32 frames = 0;
+    while ( (char*)tail + sizeof(TPCircularBufferFrameBlockHeader) <= (char*)end ) {
+        TPCircularBufferFrameBlockHeader *block = (TPCircularBufferFrameBlockHeader*)tail;
+        frames += block->frameCount - block->consumedFrames;
+        tail = (char*)tail + block->totalLength;
+    }
+    return frames;
+}
@@ -0,0 +1,38 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+#pragma once
+
+#include <stdint.h>
+#include "Interop.h"
+
+/// Composite analysis tap: peak, RMS, spectrum, and tracked pitch from one
+/// traversal of the signal. Attach one tap where metering, spectrum, and
+/// tuning consumers each used to install their own tap, and read the latest
+/// coherent results from any thread at any rate.
+
+#define AK_ANALYSIS_MAX_BINS 1024
+
+/// One coherent set of analysis results. The spectrum covers the most
+/// recently completed FFT window; peak/RMS cover the most recent buffer.
+typedef struct AnalysisSnapshot {
+    float peak;
+    float rms;
+    float pitchFrequency;
+    float pitchAmplitude;
+    uint32_t spectrumBinCount;
+    float spectrum[AK_ANALYSIS_MAX_BINS];
+} AnalysisSnapshot;
+
+typedef struct AnalysisTapData* AnalysisTapRef;
+
+/// fftSize must be a power of two, at most 2 * AK_ANALYSIS_MAX_BINS.
+AK_API AnalysisTapRef akAnalysisTapCreate(double sampleRate, uint32_t fftSize);
+AK_API void akAnalysisTapDestroy(AnalysisTapRef tap);
+
+/// Feeds one buffer through every analysis in a single pass. Call from the
+/// render thread (or any single producer thread).
+AK_API void akAnalysisTapProcess(AnalysisTapRef tap, const float* samples, uint32_t count);
+
+/// Copies the latest published results into `snapshot`. Wait-free; call from
+/// the UI thread at any rate.
+AK_API void akAnalysisTapGetSnapshot(AnalysisTapRef tap, AnalysisSnapshot* snapshot);
@@ -0,0 +1,264 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+// Shared biquad engine for the Butterworth and parametric EQ filter DSPs.
+//
+// The soundpipe modules these wrappers sit on recompute trigonometric
+// coefficients inside their per-sample compute whenever a parameter moved.
+// Here the wrapper designs one target coefficient set per render block and
+// the engine interpolates linearly from the previous set across the block,
+// so tan/cos/sqrt run at block rate while parameter ramps stay click-free.
+//
+// The core is a transposed-direct-form-II biquad with left and right state
+// advancing together; on ARM the two channels share one 2-lane NEON pass.
+// The design formulas below are copied from the soundpipe modules
+// (butlp/buthp/butbp/butbr and pareq, themselves from Csound) so the engine
+// is a drop-in for their steady-state output.
+
+#pragma once
+
+#ifdef __cplusplus
+
+#include <cmath>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define AK_BIQUAD_NEON 1
+#endif
+
+namespace AudioKitCore {
+
+struct BiquadCoefficients {
+    float b0, b1, b2, a1, a2;
+};
+
+inline BiquadCoefficients biquadButterLowPass(float sampleRate, float freq)
+{
+    const float root2 = 1.4142135623730950488f;
+    BiquadCoefficients r;
+    if (freq <= 0.0f) {
+        r.b0 = r.b1 = r.b2 = r.a1 = r.a2 = 0.0f;
+        return r;
+    }
+    float c = 1.0f / tanf(float(M_PI) * freq / sampleRate);
+    r.b0 = 1.0f / (1.0f + root2 * c + c * c);
+    r.b1 = r.b0 + r.b0;
+    r.b2 = r.b0;
+    r.a1 = 2.0f * (1.0f - c * c) * r.b0;
+    r.a2 = (1.0f - root2 * c + c * c) * r.b0;
+    return r;
+}
+
+inline BiquadCoefficients biquadButterHighPass(float sampleRate, float freq)
+{
+    const float root2 = 1.4142135623730950488f;
+    BiquadCoefficients r;
+    float c = tanf(float(M_PI) * freq / sampleRate);
+    r.b0 = 1.0f / (1.0f + root2 * c + c * c);
+    r.b1 = -(r.b0 + r.b0);
+    r.b2 = r.b0;
+    r.a1 = 2.0f * (c * c - 1.0f) * r.b0;
+    r.a2 = (1.0f - root2 * c + c * c) * r.b0;
+    return r;
+}
+
+inline BiquadCoefficients biquadButterBandPass(float sampleRate, float freq, float bw)
+{
+    BiquadCoefficients r;
+    float c = 1.0f / tanf(float(M_PI) * bw / sampleRate);
+    float d = 2.0f * cosf(2.0f * float(M_PI) * freq / sampleRate);
+    r.b0 = 1.0f / (1.0f + c);
+    r.b1 = 0.0f;
+    r.b2 = -r.b0;
+    r.a1 = -c * d * r.b0;
+    r.a2 = (c - 1.0f) * r.b0;
+    return r;
+}
+
+inline BiquadCoefficients biquadButterBandReject(float sampleRate, float freq, float bw)
+{
+    BiquadCoefficients r;
+    float c = tanf(float(M_PI) * bw / sampleRate);
+    float d = 2.0f * cosf(2.0f * float(M_PI) * freq / sampleRate);
+    r.b0 = 1.0f / (1.0f + c);
+    r.b1 = -d * r.b0;
+    r.b2 = r.b0;
+    r.a1 = r.b1;
+    r.a2 = (1.0f - c) * r.b0;
+    return r;
+}
+
+/// mode matches sp_pareq: 0 = peaking, 1 = low shelf, 2 = high shelf
+inline BiquadCoefficients biquadParametricEq(float sampleRate, float fc, float v, float q, int mode)
+{
+    BiquadCoefficients r;
+    float omega = 2.0f * float(M_PI) * fc / sampleRate;
+    float k, kk, vkk, vkdq, sq, a0;
+
+    switch (mode) {
+        case 1: /* low shelf */
+            sq = sqrtf(2.0f * v);
+            k = tanf(omega * 0.5f);
+            kk = k * k;
+            vkk = v * kk;
+            r.b0 = 1.0f + sq * k + vkk;
+            r.b1 = 2.0f * (vkk - 1.0f);
+            r.b2 = 1.0f - sq * k + vkk;
+            a0 = 1.0f + k / q + kk;
+            r.a1 = 2.0f * (kk - 1.0f);
+            r.a2 = 1.0f - k / q + kk;
+            break;
+
+        case 2: /* high shelf */
+            sq = sqrtf(2.0f * v);
+            k = tanf((float(M_PI) - omega) * 0.5f);
+            kk = k * k;
+            vkk = v * kk;
+            r.b0 = 1.0f + sq * k + vkk;
+            r.b1 = -2.0f * (vkk - 1.0f);
+            r.b2 = 1.0f - sq * k + vkk;
+            a0 = 1.0f + k / q + kk;
+            r.a1 = -2.0f * (kk - 1.0f);
+            r.a2 = 1.0f - k / q + kk;
+            break;
+
+        default: /* peaking */
+            k = tanf(omega * 0.5f);
+            kk = k * k;
+            vkdq = v * k / q;
+            r.b0 = 1.0f + vkdq + kk;
+            r.b1 = 2.0f * (kk - 1.0f);
+            r.b2 = 1.0f - vkdq + kk;
+            a0 = 1.0f + k / q + kk;
+            r.a1 = 2.0f * (kk - 1.0f);
+            r.a2 = 1.0f - k / q + kk;
+            break;
+    }
+    a0 = 1.0f / a0;
+    r.b0 *= a0; r.b1 *= a0; r.b2 *= a0;
+    r.a1 *= a0; r.a2 *= a0;
+    return r;
+}
+
+/// Transposed-direct-form-II biquad holding left/right state side by side.
+/// Each process call takes the block's target coefficients and interpolates
+/// from the set it last ran with, so per-block redesign stays click-free.
+class StereoBiquad {
+    BiquadCoefficients current;
+    float s1[2], s2[2];
+    bool primed;
+
+public:
+    StereoBiquad() { reset(); }
+
+    void reset()
+    {
+        s1[0] = s1[1] = 0.0f;
+        s2[0] = s2[1] = 0.0f;
+        primed = false;
+    }
+
+    void process(const BiquadCoefficients &target,
+                 const float *inL, const float *inR,
+                 float *outL, float *outR, int count)
+    {
+        if (count <= 0) return;
+        if (!primed) {
+            current = target;
+            primed = true;
+        }
+        float inv = 1.0f / count;
+        float db0 = (target.b0 - current.b0) * inv;
+        float db1 = (target.b1 - current.b1) * inv;
+        float db2 = (target.b2 - current.b2) * inv;
+        float da1 = (target.a1 - current.a1) * inv;
+        float da2 = (target.a2 - current.a2) * inv;
+
+#if AK_BIQUAD_NEON
+        float32x2_t vs1 = vld1_f32(s1);
+        float32x2_t vs2 = vld1_f32(s2);
+        float32x2_t vb0 = vdup_n_f32(current.b0);
+        float32x2_t vb1 = vdup_n_f32(current.b1);
+        float32x2_t vb2 = vdup_n_f32(current.b2);
+        float32x2_t va1 = vdup_n_f32(current.a1);
+        float32x2_t va2 = vdup_n_f32(current.a2);
+        float32x2_t vdb0 = vdup_n_f32(db0);
+        float32x2_t vdb1 = vdup_n_f32(db1);
+        float32x2_t vdb2 = vdup_n_f32(db2);
+        float32x2_t vda1 = vdup_n_f32(da1);
+        float32x2_t vda2 = vdup_n_f32(da2);
+        for (int i = 0; i < count; ++i) {
+            float32x2_t x = vset_lane_f32(inR[i], vdup_n_f32(inL[i]), 1);
+            float32x2_t y = vmla_f32(vs1, vb0, x);
+            vs1 = vmls_f32(vmla_f32(vs2, vb1, x), va1, y);
+            vs2 = vmls_f32(vmul_f32(vb2, x), va2, y);
+            outL[i] = vget_lane_f32(y, 0);
+            outR[i] = vget_lane_f32(y, 1);
+            vb0 = vadd_f32(vb0, vdb0);
+            vb1 = vadd_f32(vb1, vdb1);
+            vb2 = vadd_f32(vb2, vdb2);
+            va1 = vadd_f32(va1, vda1);
+            va2 = vadd_f32(va2, vda2);
+        }
+        vst1_f32(s1, vs1);
+        vst1_f32(s2, vs2);
+#else
+        float b0 = current.b0, b1 = current.b1, b2 = current.b2;
+        float a1 = current.a1, a2 = current.a2;
+        float s1L = s1[0], s1R = s1[1];
+        float s2L = s2[0], s2R = s2[1];
+        for (int i = 0; i < count; ++i) {
+            float xL = inL[i], xR = inR[i];
+            float yL = b0 * xL + s1L;
+            float yR = b0 * xR + s1R;
+            s1L = b1 * xL - a1 * yL + s2L;
+            s1R = b1 * xR - a1 * yR + s2R;
+            s2L = b2 * xL - a2 * yL;
+            s2R = b2 * xR - a2 * yR;
+            outL[i] = yL;
+            outR[i] = yR;
+            b0 += db0; b1 += db1; b2 += db2;
+            a1 += da1; a2 += da2;
+        }
+        s1[0] = s1L; s1[1] = s1R;
+        s2[0] = s2L; s2[1] = s2R;
+#endif
+        current = target;
+    }
+
+    /// Mono variant running only the left lane.
+    void process(const BiquadCoefficients &target,
+                 const float *in, float *out, int count)
+    {
+        if (count <= 0) return;
+        if (!primed) {
+            current = target;
+            primed = true;
+        }
+        float inv = 1.0f / count;
+        float db0 = (target.b0 - current.b0) * inv;
+        float db1 = (target.b1 - current.b1) * inv;
+        float db2 = (target.b2 - current.b2) * inv;
+        float da1 = (target.a1 - current.a1) * inv;
+        float da2 = (target.a2 - current.a2) * inv;
+
+        float b0 = current.b0, b1 = current.b1, b2 = current.b2;
+        float a1 = current.a1, a2 = current.a2;
+        float s1L = s1[0], s2L = s2[0];
+        for (int i = 0; i < count; ++i) {
+            float x = in[i];
+            float y = b0 * x + s1L;
+            s1L = b1 * x - a1 * y + s2L;
+            s2L = b2 * x - a2 * y;
+            out[i] = y;
+            b0 += db0; b1 += db1; b2 += db2;
+            a1 += da1; a2 += da2;
+        }
+        s1[0] = s1L;
+        s2[0] = s2L;
+        current = target;
+    }
+};
+
+}
+
+#endif
@@ -12,6 +12,7 @@
 #import <AudioToolbox/AudioToolbox.h>
 #import <AudioUnit/AudioUnit.h>
 #import <AVFoundation/AVFoundation.h>
+#import "MemoryTracker.h"
 
 #pragma mark BufferedAudioBus Utility Class
 // Utility classes to manage audio formats and buffers for an audio unit implementation's input and output audio busses.
@@ -26,6 +27,9 @@ struct BufferedAudioBus {
     AudioBufferList const *originalAudioBufferList = nullptr;
     AudioBufferList *mutableAudioBufferList = nullptr;
 
+    // bytes currently reported to the memory tracker for pcmBuffer
+    int64_t trackedBytes = 0;
+
     void init(AVAudioFormat *defaultFormat, AVAudioChannelCount maxChannels) {
         maxFrames = 0;
         pcmBuffer = nullptr;
@@ -44,9 +48,14 @@ struct BufferedAudioBus {
 
         originalAudioBufferList = pcmBuffer.audioBufferList;
         mutableAudioBufferList = pcmBuffer.mutableAudioBufferList;
+
+        trackedBytes = (int64_t)maxFrames * bus.format.channelCount * sizeof(float);
+        akMemoryTrack(AKMemoryBusBuffers, nullptr, trackedBytes);
     }
 
     void deallocateRenderResources() {
+        akMemoryTrack(AKMemoryBusBuffers, nullptr, -trackedBytes);
+        trackedBytes = 0;
         pcmBuffer = nullptr;
         originalAudioBufferList = nullptr;
         mutableAudioBufferList = nullptr;
@@ -87,6 +96,15 @@ struct BufferedOutputBus: BufferedAudioBus {
     pull its input data.
  */
 struct BufferedInputBus : BufferedAudioBus {
+    // When true, pullInput hands the upstream node null data pointers and lets
+    // it fill in pointers to its own buffers (the AudioUnit zero-copy pull
+    // convention), so no samples are copied into pcmBuffer on this hop.
+    // Enable it only when the formats match and the reader consumes the input
+    // strictly sequentially (canProcessInPlaceDSP already tracks this for the
+    // DSP kernels). If the upstream declines the null-pointer pull, the flag
+    // clears itself and every later pull takes the buffered path.
+    bool zeroCopy = false;
+
     /*
      Gets input data for this input by preparing the input buffer list and pulling
      the pullInputBlock.
@@ -100,26 +118,44 @@ struct BufferedInputBus : BufferedAudioBus {
             return kAudioUnitErr_NoConnection;
         }
 
-        prepareInputBufferList();
+        if (zeroCopy) {
+            prepareInputBufferList(true);
+
+            AUAudioUnitStatus status = pullInputBlock(actionFlags, timestamp, frameCount,
+                                                      inputBusNumber, mutableAudioBufferList);
+
+            // Did the upstream node hand back its own buffers?
+            if (status == noErr && mutableAudioBufferList->mBuffers[0].mData != nullptr) {
+                return status;
+            }
+
+            // It needs a real destination; stop probing and fall through to
+            // the buffered pull below.
+            zeroCopy = false;
+        }
+
+        prepareInputBufferList(false);
 
         return pullInputBlock(actionFlags, timestamp, frameCount, inputBusNumber, mutableAudioBufferList);
     }
 
     /*
      prepareInputBufferList populates the mutableAudioBufferList with the data
-     pointers from the originalAudioBufferList.
+     pointers from the originalAudioBufferList, or with null pointers when the
+     upstream node is expected to substitute its own (zero-copy pull).
 
      The upstream audio unit may overwrite these with its own pointers, so each
      render cycle this function needs to be called to reset them.
      */
-    void prepareInputBufferList() {
+    void prepareInputBufferList(bool nullData = false) {
         UInt32 byteSize = maxFrames * sizeof(float);
 
         mutableAudioBufferList->mNumberBuffers = originalAudioBufferList->mNumberBuffers;
 
         for (UInt32 i = 0; i < originalAudioBufferList->mNumberBuffers; ++i) {
             mutableAudioBufferList->mBuffers[i].mNumberChannels = originalAudioBufferList->mBuffers[i].mNumberChannels;
-            mutableAudioBufferList->mBuffers[i].mData = originalAudioBufferList->mBuffers[i].mData;
+            mutableAudioBufferList->mBuffers[i].mData = nullData ? nullptr
+                : originalAudioBufferList->mBuffers[i].mData;
             mutableAudioBufferList->mBuffers[i].mDataByteSize = byteSize;
         }
     }
@@ -24,8 +24,15 @@ FOUNDATION_EXPORT const unsigned char AudioKitVersionString[];
 // Testing
 #import "DebugDSP.h"
 
+// Overload protection
+#import "OverloadGovernor.h"
+
+// Compiled render scheduling
+#import "RenderGraph.h"
+
 // Analysis
 #import "PitchTracker.h"
+#import "AnalysisTap.h"
 
 // Effects / Modulation
 #import "ModulatedDelay_Typedefs.h"
@@ -49,6 +56,7 @@ FOUNDATION_EXPORT const unsigned char AudioKitVersionString[];
 #import "ParameterRamper.h"
 #import "ParameterAutomation.h"
 #import "LinearParameterRamp.h"
+#import "CurvedParameterRamp.h"
 
 // Swift/ObjC/C/C++ Inter-operability
 #import "Interop.h"
@@ -56,11 +64,18 @@ FOUNDATION_EXPORT const unsigned char AudioKitVersionString[];
 // Custom interop
 AK_API void akCombFilterReverbSetLoopDuration(DSPRef dsp, float duration);
 AK_API void akConvolutionSetPartitionLength(DSPRef dsp, int length);
+AK_API void akConvolutionSetLatencyTarget(DSPRef dsp, float seconds);
+AK_API void akPitchShifterSetQuality(DSPRef dsp, int quality);
+AK_API void akLimiterSetTruePeak(DSPRef dsp, bool enabled);
+AK_API void akPWMOscillatorSetPolyBLEP(DSPRef dsp, bool enabled);
+AK_API void akPhaseDistortionOscillatorSetPolyBLEP(DSPRef dsp, bool enabled);
 AK_API void akFlatFrequencyResponseSetLoopDuration(DSPRef dsp, float duration);
 AK_API void akOperationEffectSetSporth(DSPRef dspRef, const char *sporth, int length);
 AK_API void akOperationGeneratorSetSporth(DSPRef dspRef, const char *sporth, int length);
 AK_API float* akOperationGeneratorTrigger(DSPRef dspRef);
 AK_API void akVariableDelaySetMaximumTime(DSPRef dsp, float maximumTime);
+AK_API void akOversampledChainSetFactor(DSPRef dsp, int factor);
+AK_API void akOversampledChainAddDSP(DSPRef dsp, DSPRef inner);
 
 typedef void (^CMIDICallback)(uint8_t, uint8_t, uint8_t);
 AK_API void akCallbackInstrumentSetCallback(DSPRef dsp, CMIDICallback callback);
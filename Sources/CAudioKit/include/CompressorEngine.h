@@ -0,0 +1,191 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+// Block pipeline for the FAUST compressor behind DynamicRangeCompressorDSP.
+//
+// sp_compressor's gain computer calls log10 and pow(10, x) once per sample
+// per channel. This engine keeps the same envelope and smoothing recurrences
+// (they are one compare and two multiplies each) but moves the level/gain
+// conversions into log2 domain, where both directions reduce to exponent-bit
+// arithmetic plus an interpolated 256-entry mantissa table. Gains land in a
+// scratch buffer so the final gain-apply is a plain vectorizable multiply.
+//
+// The attack/release/ratio coefficients are the FAUST fSlow values, computed
+// once per block instead of once per compute call.
+//
+// The detector is separable from the gain stage: computeGains runs the
+// envelope over any signal (an external sidechain, or a linked-channel
+// maximum) and emits a gain buffer that one or many channels multiply by.
+
+#pragma once
+
+#ifdef __cplusplus
+
+#include <cmath>
+#include <cstdint>
+
+namespace AudioKitCore {
+
+enum { kCompressorLutSize = 256 };
+
+struct CompressorTables {
+    float log2Table[kCompressorLutSize + 1];
+    float exp2Table[kCompressorLutSize + 1];
+
+    CompressorTables()
+    {
+        for (int i = 0; i <= kCompressorLutSize; ++i) {
+            log2Table[i] = log2f(1.0f + (float)i / kCompressorLutSize);
+            exp2Table[i] = exp2f((float)i / kCompressorLutSize);
+        }
+    }
+};
+
+inline const CompressorTables &compressorTables()
+{
+    static const CompressorTables tables;
+    return tables;
+}
+
+/// log2(v) for v > 0: exponent from the float bits, mantissa via LUT+lerp.
+inline float compressorLog2f(float v)
+{
+    const CompressorTables &t = compressorTables();
+    union { float f; uint32_t i; } u;
+    u.f = v;
+    int e = (int)(u.i >> 23) - 127;
+    u.i = (u.i & 0x007FFFFFu) | 0x3F800000u;
+    float idx = (u.f - 1.0f) * kCompressorLutSize;
+    int i0 = (int)idx;
+    float fr = idx - i0;
+    return (float)e + t.log2Table[i0] + fr * (t.log2Table[i0 + 1] - t.log2Table[i0]);
+}
+
+/// exp2(x), exponent assembled from bits, fraction via LUT+lerp.
+inline float compressorExp2f(float x)
+{
+    const CompressorTables &t = compressorTables();
+    if (x < -126.0f) x = -126.0f;
+    if (x > 126.0f) x = 126.0f;
+    float xf = floorf(x);
+    float idx = (x - xf) * kCompressorLutSize;
+    int i0 = (int)idx;
+    float fr = idx - i0;
+    float m = t.exp2Table[i0] + fr * (t.exp2Table[i0 + 1] - t.exp2Table[i0]);
+    union { float f; uint32_t i; } u;
+    u.i = (uint32_t)((int)xf + 127) << 23;
+    return u.f * m;
+}
+
+/// One channel of the FAUST compressor recurrence with LUT log/exp.
+/// State mirrors fRec2/fRec1/fRec0 from computecompressor.
+class BlockCompressor {
+    float env;      // fRec2: smoothed rectified level
+    float envHeld;  // fRec1: level as seen by the attack/release branch
+    float gainDb;   // fRec0: smoothed gain reduction, <= 0 dB
+    float sampleRateHz;
+
+public:
+    BlockCompressor() : env(0.0f), envHeld(0.0f), gainDb(0.0f), sampleRateHz(44100.0f) {}
+
+    void init(float sampleRate)
+    {
+        sampleRateHz = sampleRate;
+        reset();
+    }
+
+    void reset()
+    {
+        env = 0.0f;
+        envHeld = 0.0f;
+        gainDb = 0.0f;
+    }
+
+    /// Advances the envelope over `det` and writes the resulting linear
+    /// gains. The detector is the only signal read, so one call can feed
+    /// any number of gain stages (linked stereo, a drum bus) that multiply
+    /// their own channel by the shared gain buffer.
+    void computeGains(const float *det, float *gains, int count,
+                      float ratio, float threshDb, float attack, float release)
+    {
+        // the FAUST fSlow constants, once per block
+        float fConst1 = 2.0f / sampleRateHz;
+        float fConst2 = 1.0f / sampleRateHz;
+        float smooth = expf(-(fConst1 / attack));
+        float slope = (1.0f - smooth) * (1.0f / ratio - 1.0f);
+        float atkCoef = expf(-(fConst2 / attack));
+        float relCoef = expf(-(fConst2 / release));
+        gainsWithCoefs(det, gains, count, smooth, slope, atkCoef, relCoef, threshDb);
+    }
+
+    void process(const float *in, float *out, int count,
+                 float ratio, float threshDb, float attack, float release)
+    {
+        float fConst1 = 2.0f / sampleRateHz;
+        float fConst2 = 1.0f / sampleRateHz;
+        float smooth = expf(-(fConst1 / attack));
+        float slope = (1.0f - smooth) * (1.0f / ratio - 1.0f);
+        float atkCoef = expf(-(fConst2 / attack));
+        float relCoef = expf(-(fConst2 / release));
+
+        const int chunkSize = 64;
+        float gains[chunkSize];
+        for (int start = 0; start < count; start += chunkSize) {
+            int chunk = count - start;
+            if (chunk > chunkSize) chunk = chunkSize;
+            gainsWithCoefs(in + start, gains, chunk,
+                           smooth, slope, atkCoef, relCoef, threshDb);
+            for (int i = 0; i < chunk; ++i)
+                out[start + i] = gains[i] * in[start + i];
+        }
+    }
+
+    /// `process` with the envelope driven by a separate detector signal
+    /// (an external sidechain input).
+    void processSidechain(const float *in, const float *det, float *out, int count,
+                          float ratio, float threshDb, float attack, float release)
+    {
+        float fConst1 = 2.0f / sampleRateHz;
+        float fConst2 = 1.0f / sampleRateHz;
+        float smooth = expf(-(fConst1 / attack));
+        float slope = (1.0f - smooth) * (1.0f / ratio - 1.0f);
+        float atkCoef = expf(-(fConst2 / attack));
+        float relCoef = expf(-(fConst2 / release));
+
+        const int chunkSize = 64;
+        float gains[chunkSize];
+        for (int start = 0; start < count; start += chunkSize) {
+            int chunk = count - start;
+            if (chunk > chunkSize) chunk = chunkSize;
+            gainsWithCoefs(det + start, gains, chunk,
+                           smooth, slope, atkCoef, relCoef, threshDb);
+            for (int i = 0; i < chunk; ++i)
+                out[start + i] = gains[i] * in[start + i];
+        }
+    }
+
+private:
+    void gainsWithCoefs(const float *det, float *gains, int count,
+                        float smooth, float slope, float atkCoef, float relCoef,
+                        float threshDb)
+    {
+        const float log2Of10Over20 = 0.16609640474f;  // log2(10)/20
+        const float dbPerLog2 = 6.02059991328f;       // 20*log10(2)
+
+        for (int i = 0; i < count; ++i) {
+            float level = fabsf(det[i]);
+            float coef = (envHeld > level) ? relCoef : atkCoef;
+            env = env * coef + (1.0f - coef) * level;
+            envHeld = env;
+            float over = 0.0f;
+            if (env > 1.0e-30f)
+                over = dbPerLog2 * compressorLog2f(env) - threshDb;
+            if (over < 0.0f) over = 0.0f;
+            gainDb = smooth * gainDb + slope * over;
+            gains[i] = compressorExp2f(gainDb * log2Of10Over20);
+        }
+    }
+};
+
+}
+
+#endif
@@ -37,8 +37,21 @@ public:
     /// call to load samples
     void loadSampleData(SampleDataDescriptor& sdd);
 
+    /// call to reference caller-owned (e.g. mmap'd) sample data without copying;
+    /// the data must remain valid until the samples are unloaded
+    void loadSampleDataReference(SampleDataReferenceDescriptor& sdrd);
+
+    /// call to stream a sample from disk, keeping only its attack portion resident
+    void loadStreamedSampleFile(StreamedSampleFileDescriptor& ssfd);
+
     /// call to unload samples, freeing memory
     void unloadAllSamples();
+
+    /// call after loading to touch (and optionally mlock) every sample's pages,
+    /// so first playback doesn't fault them in on the render thread. Buffers
+    /// are warmed in load order, so load the most critical samples first.
+    /// Call from a loading thread, never from the render thread.
+    void prewarmSampleData(bool lockInMemory);
     
     // after loading samples, call one of these to build the key map
     
@@ -53,7 +66,15 @@ public:
     
     /// optionally call this to make samples continue looping after note-release
     void setLoopThruRelease(bool value) { loopThruRelease = value; }
+
+    /// optionally retire releasing voices once their amplitude falls below
+    /// this linear threshold (0 disables), bounding render cost by audible voices
+    void setVoiceSilenceThreshold(float amplitude) { voiceSilenceThreshold = amplitude; }
     
+    /// opt in to multicore voice rendering; workerCount helper threads are
+    /// created (0 restores single-threaded rendering). Call before rendering.
+    void setVoiceWorkerCount(int workerCount);
+
     void playNote(unsigned noteNumber, unsigned velocity);
     void stopNote(unsigned noteNumber, bool immediate);
     void sustainPedal(bool down);
@@ -147,13 +168,17 @@ protected:
     
     // if true, sample continue looping thru note release phase
     bool loopThruRelease;
-    
+
+    // linear amplitude below which releasing voices are retired (0 disables)
+    float voiceSilenceThreshold;
+
     // temporary state
     bool stoppingAllVoices;
     
     // helper functions
     AudioKitCore::SamplerVoice *voicePlayingNote(unsigned noteNumber);
     AudioKitCore::KeyMappedSampleBuffer *lookupSample(unsigned noteNumber, unsigned velocity);
+    void rebuildLookupGrid(void);
     void play(unsigned noteNumber,
               unsigned velocity,
               bool anotherKeyWasDown);
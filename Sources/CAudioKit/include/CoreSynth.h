@@ -22,6 +22,9 @@ public:
     /// call this to un-load all samples and clear the keymap
     void deinit();
     
+    // These enqueue lock-free and return immediately, so they are safe to
+    // call from a MIDI callback; the events take effect (and all voice setup
+    // happens) at the start of the next render() call.
     void playNote(unsigned noteNumber, unsigned velocity, float noteFrequency);
     void stopNote(unsigned noteNumber, bool immediate);
     void sustainPedal(bool down);
@@ -44,6 +47,40 @@ public:
     void  setFilterReleaseDurationSeconds(float value);
     float getFilterReleaseDurationSeconds(void);
     
+    // Modulation matrix: shared LFOs are evaluated once per chunk and their
+    // outputs applied to every voice, so LFO cost does not grow with
+    // polyphony. lfoIndex range is [0, 1]; LFO 0 also carries the classic
+    // vibrato controlled by vibratoDepth.
+    void  setLFOFrequencyHz(int lfoIndex, float hz);
+    void  setLFOPitchModSemitones(int lfoIndex, float semitones);
+    void  setLFOCutoffModAmount(int lfoIndex, float amount);
+    void  setLFOAmpModFraction(int lfoIndex, float fraction);
+
+    /// cutoff-multiple offset per octave of key distance from middle C
+    void  setFilterKeyTrackingAmount(float amount);
+
+    /// how far low velocity pulls the filter cutoff multiple down
+    void  setFilterVelocitySensitivity(float amount);
+
+    /// set one of the 9 Hammond-style drawbars (0-8) to a level 0.0 - 1.0
+    /// and rebuild the cached registration cycle that the organ oscillator
+    /// reads with a single phase; call from a non-render thread
+    void  setDrawbarLevel(int drawbar, float level);
+
+    /// rebuild the cached organ registration cycle after editing drawbar
+    /// levels directly; call from a non-render thread
+    void  rebuildOrganRegistration();
+
+    /// select the waveform of ensemble oscillator 1 or 2 (oscIndex 1 or 2):
+    /// 0 = wavetable (the default), 1 = computed band-limited sawtooth,
+    /// 2 = computed band-limited square. The computed modes do no table
+    /// lookups at all, which helps cache behavior at high polyphony.
+    void  setOscillatorWaveform(int oscIndex, int waveform);
+
+    /// opt in to multicore voice rendering; workerCount helper threads are
+    /// created (0 restores single-threaded rendering). Call before rendering.
+    void setVoiceWorkerCount(int workerCount);
+
     void render(unsigned channelCount, unsigned sampleCount, float *outBuffers[]);
     
 protected:
@@ -68,6 +105,9 @@ protected:
     /// resonance [-20 dB, +20 dB] becomes linear [10.0, 0.1]
     float linearResonance;
     
+    /// drain the note-event queue; called at the start of render()
+    void processNoteEvents();
+
     void play(unsigned noteNumber, unsigned velocity, float noteFrequency);
     void stop(unsigned noteNumber, bool immediate);
     
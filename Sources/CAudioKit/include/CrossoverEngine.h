@@ -0,0 +1,47 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+// Linkwitz-Riley 4th-order crossover built on BiquadEngine's Butterworth
+// designs. Each leg cascades the same 2nd-order section twice, putting both
+// outputs 6 dB down at the crossover so the pair sums back to an allpass
+// without a polarity flip. The biquads carry stereo state and interpolate
+// coefficients per block, so sweeping the crossover frequency is click-free.
+
+#pragma once
+
+#ifdef __cplusplus
+
+#include "BiquadEngine.h"
+
+namespace AudioKitCore {
+
+class LinkwitzRileySplitter {
+    StereoBiquad lowA, lowB, highA, highB;
+
+public:
+    void reset()
+    {
+        lowA.reset();
+        lowB.reset();
+        highA.reset();
+        highB.reset();
+    }
+
+    /// Split in into complementary low and high bands at freq. The high leg
+    /// runs first, so low may alias the input but high must not.
+    void process(float sampleRate, float freq,
+                 const float *inL, const float *inR,
+                 float *lowL, float *lowR,
+                 float *highL, float *highR, int count)
+    {
+        BiquadCoefficients lp = biquadButterLowPass(sampleRate, freq);
+        BiquadCoefficients hp = biquadButterHighPass(sampleRate, freq);
+        highA.process(hp, inL, inR, highL, highR, count);
+        highB.process(hp, highL, highR, highL, highR, count);
+        lowA.process(lp, inL, inR, lowL, lowR, count);
+        lowB.process(lp, lowL, lowR, lowL, lowR, count);
+    }
+};
+
+}
+
+#endif
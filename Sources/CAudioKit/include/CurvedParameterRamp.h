@@ -0,0 +1,92 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+#pragma once
+
+#import "ParameterRampBase.h" // have to put this here to get it included in umbrella header
+
+#import <cmath>
+
+#ifdef __cplusplus
+
+// Ramp honoring the base class ramp type: 0 linear, 1 exponential,
+// 2 equal power, 3 s-curve. Sample times that arrive sequentially (the
+// render-loop case) advance a constant-cost recurrence — a multiply for the
+// exponential, a rotation for the equal-power sine, forward differences for
+// the cubic — and any other access reseeds the recurrence in closed form.
+// All shapes land exactly on the target at the end of the duration.
+
+struct CurvedParameterRamp : ParameterRampBase {
+
+    float computeValueAt(int64_t atSample) override {
+        int64_t k = atSample - _startSample;
+        if (atSample != _lastSample + 1 || _lastStart != _startSample) {
+            reseed(k);
+        }
+        _lastSample = atSample;
+        float range = _target - _startValue;
+        switch (_rampType) {
+            case 1: // exponential
+                _expK *= _expPole;
+                return _value = _startValue + range * (1.0f - _expK) * _expNorm;
+            case 2: { // equal power
+                float s = _sin * _cosDelta + _cos * _sinDelta;
+                float c = _cos * _cosDelta - _sin * _sinDelta;
+                _sin = s;
+                _cos = c;
+                return _value = _startValue + range * s;
+            }
+            case 3: // s-curve
+                _poly += _d1;
+                _d1 += _d2;
+                _d2 += _d3;
+                return _value = _poly;
+            default:
+                return _value = _startValue + range * (float(k) / _duration);
+        }
+    }
+
+private:
+    void reseed(int64_t k) {
+        _lastStart = _startSample;
+        float range = _target - _startValue;
+        double n = double(_duration);
+        double t = double(k - 1) / n; // state "one sample back": computeValueAt steps first
+        switch (_rampType) {
+            case 1: {
+                // pole spans three decades over the duration; normalized so
+                // the curve still ends exactly on the target
+                _expPole = expf(float(-6.9077553 / n));
+                _expK = powf(_expPole, float(k - 1));
+                _expNorm = 1.0f / (1.0f - powf(_expPole, float(n)));
+                break;
+            }
+            case 2: {
+                double delta = M_PI_2 / n;
+                _sinDelta = float(sin(delta));
+                _cosDelta = float(cos(delta));
+                _sin = float(sin(M_PI_2 * t));
+                _cos = float(cos(M_PI_2 * t));
+                break;
+            }
+            case 3: {
+                double h = 1.0 / n;
+                double a = double(range);
+                _poly = _startValue + float(a * (3.0 - 2.0 * t) * t * t);
+                _d1 = float(a * h * ((6.0 * t + 3.0 * h) - (6.0 * t * t + 6.0 * t * h + 2.0 * h * h)));
+                _d2 = float(a * h * h * (6.0 - 12.0 * t - 12.0 * h));
+                _d3 = float(a * -12.0 * h * h * h);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    int64_t _lastSample = -2;
+    int64_t _lastStart = -1;
+    float _expPole = 0, _expK = 1, _expNorm = 1;
+    float _sin = 0, _cos = 1, _sinDelta = 0, _cosDelta = 1;
+    float _poly = 0, _d1 = 0, _d2 = 0, _d3 = 0;
+};
+
+#endif
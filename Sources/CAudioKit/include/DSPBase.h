@@ -8,6 +8,18 @@
 #include <stdarg.h>
 
 AK_API DSPRef akCreateDSP(const char* name);
+
+/// Integer node-type ID assigned at registration, for callers that want to
+/// resolve a name once and then instantiate without string-map lookups.
+/// Returns -1 for an unknown name. IDs are stable for the process lifetime.
+AK_API int akGetDSPTypeID(const char* name);
+
+/// Create a DSP from a registered type ID (flat-array lookup).
+AK_API DSPRef akCreateDSPByID(int typeID);
+
+/// Instantiate a whole graph's nodes in one call: fills dsps[i] from
+/// typeIDs[i] (nullptr for invalid IDs) and returns the number created.
+AK_API size_t akCreateDSPBatch(const int* typeIDs, size_t count, DSPRef* dsps);
 AK_API AUParameterAddress akGetParameterAddress(const char* name);
 
 AK_API AUInternalRenderBlock internalRenderBlockDSP(DSPRef pDSP);
@@ -17,6 +29,7 @@ AK_API size_t outputBusCountDSP(DSPRef pDSP);
 AK_API bool canProcessInPlaceDSP(DSPRef pDSP);
 
 AK_API void setBufferDSP(DSPRef pDSP, AudioBufferList* buffer, size_t busIndex);
+AK_API void reserveScratchBuffersDSP(DSPRef pDSP, uint32_t channelCount, uint32_t maxFrames);
 AK_API void allocateRenderResourcesDSP(DSPRef pDSP, uint32_t channelCount, double sampleRate);
 AK_API void deallocateRenderResourcesDSP(DSPRef pDSP);
 AK_API void resetDSP(DSPRef pDSP);
@@ -24,6 +37,44 @@ AK_API void resetDSP(DSPRef pDSP);
 AK_API void setParameterValueDSP(DSPRef pDSP, AUParameterAddress address, AUValue value);
 AK_API AUValue getParameterValueDSP(DSPRef pDSP, AUParameterAddress address);
 
+/// Ramp shape for subsequent changes to one parameter (see
+/// ParameterRamper::Taper: 0 linear, 1 exponential, 2 equal power,
+/// 3 s-curve). One curved ramp replaces the dense linear automation
+/// otherwise needed to approximate a fade; each shape steps with a
+/// constant-cost recurrence per sample.
+AK_API void setParameterRampTaperDSP(DSPRef pDSP, AUParameterAddress address, int taper);
+
+/// Snapshot many parameter values in one call: fills values[i] from
+/// addresses[i]. Reads the same UI-side state as getParameterValueDSP, so a
+/// metering UI polling dozens of parameters per frame pays one call instead
+/// of one message send per parameter.
+AK_API void getParameterValuesDSP(DSPRef pDSP, const AUParameterAddress* addresses,
+                                  AUValue* values, size_t count);
+
+/// Binary session-preset snapshots. Each node serializes a small versioned
+/// blob of its parameter targets; the graph-level calls concatenate the
+/// per-node blobs (nodes must be passed in the same order for save and
+/// restore). Restoring applies every parameter of every node as immediate
+/// updates in one pass — ramps suppressed — so mid-performance preset
+/// switches land in a single render cycle instead of a scatter of ramped
+/// sets.
+AK_API size_t akGraphStateSize(DSPRef const* dsps, size_t count);
+AK_API size_t akSaveGraphState(DSPRef const* dsps, size_t count, void* blob, size_t capacity);
+AK_API bool akRestoreGraphState(DSPRef const* dsps, size_t count, const void* blob, size_t size);
+
+/// Native per-node metering. When enabled, the render thread folds the
+/// node's output into per-channel peak and RMS levels right after process()
+/// — while the samples are still warm in cache — and publishes them through
+/// a wait-free triple buffer. UI meters read the latest levels at any rate
+/// with getMeterLevelsDSP instead of installing buffer-copying taps.
+AK_API void setMeteringEnabledDSP(DSPRef pDSP, bool enabled);
+
+/// Fills peaks[i] and rms[i] for each output channel (up to maxChannels) from
+/// the most recently rendered quantum and returns the channel count, 0 when
+/// metering is disabled or nothing has rendered yet. Wait-free; call from the
+/// UI thread at any rate.
+AK_API uint32_t getMeterLevelsDSP(DSPRef pDSP, float* peaks, float* rms, uint32_t maxChannels);
+
 AK_API void startDSP(DSPRef pDSP);
 AK_API void stopDSP(DSPRef pDSP);
 
@@ -32,6 +83,30 @@ AK_API void initializeConstantDSP(DSPRef pDSP, AUValue value);
 AK_API void triggerDSP(DSPRef pDSP);
 AK_API void triggerFrequencyDSP(DSPRef pDSP, AUValue frequency, AUValue amplitude);
 
+/// One timestamped trigger for triggerBatchDSP. `sampleTime` is on the same
+/// sample clock as the render timestamps; a negative time means "as soon as
+/// possible". A frequency of 0 or less fires the plain trigger() instead of
+/// triggerFrequencyAmplitude.
+typedef struct AKTriggerEvent {
+    AUEventSampleTime sampleTime;
+    AUValue frequency;
+    AUValue amplitude;
+} AKTriggerEvent;
+
+/// Queues a whole batch of timestamped triggers in one call. The events are
+/// handed to the render thread wait-free and each one fires at its exact
+/// sample offset: the render quantum is split around it the same way hosted
+/// render events split it, so rapid patterns keep sub-buffer timing instead
+/// of quantizing to buffer starts. Events whose time has already passed fire
+/// at the start of the next quantum. Single producer: call from one thread
+/// at a time.
+AK_API void triggerBatchDSP(DSPRef pDSP, const AKTriggerEvent* events, size_t count);
+
+/// Hand a wavetable to the DSP. Call from a UI or control thread, never from
+/// the render thread; the DSP copies the data before returning, so the caller
+/// may free `table` immediately. DSPs that render from the table pick the new
+/// one up at the next quantum (see WavetableExchange), so repeated calls
+/// while audio is running are safe.
 AK_API void setWavetableDSP(DSPRef pDSP, const float* table, size_t length, int index);
 
 AK_API void deleteDSP(DSPRef pDSP);
@@ -43,6 +118,10 @@ AK_API void akSetSeed(unsigned int);
 
 #import <vector>
 
+#include "../Internals/Utilities/readerwriterqueue.h"
+#include "../Internals/Utilities/TripleBuffer.h"
+#include "../CoreAudio/ScratchBufferPool.h"
+
 /**
  Base class for DSPKernels. Many of the methods are virtual, because the base AudioUnit class
  does not know the type of the subclass at compile time.
@@ -53,7 +132,43 @@ struct DSPBase {
 private:
 
     std::vector<AudioBufferList*> internalBufferLists;
-    
+
+    /// Scratch buffers checked out of the shared pool for the current render;
+    /// one entry per input bus, returned at the end of each render cycle.
+    std::vector<ScratchBufferPool::Slot*> scratchSlots;
+    uint32_t scratchChannelCount = 0;
+    uint32_t scratchFrameCapacity = 0;
+
+    /// A UI-thread parameter change waiting to be applied on the render
+    /// thread; either a value (possibly ramped) or a ramp-taper change, see
+    /// ParameterRamper::Taper.
+    struct ParameterUpdate {
+        AUParameterAddress address;
+        float value;
+        bool immediate;
+        bool taperChange;
+    };
+
+    /// Lock-free single-producer single-consumer handoff of parameter changes
+    /// from the UI thread. Drained once at the top of each render cycle, so an
+    /// entire UI frame's worth of changes lands as one coherent update and all
+    /// startRamp calls stay on the render thread.
+    moodycamel::ReaderWriterQueue<ParameterUpdate> parameterUpdateQueue{64};
+
+    /// Same handoff pattern for batched triggers from triggerBatchDSP.
+    moodycamel::ReaderWriterQueue<AKTriggerEvent> triggerQueue{64};
+
+    static constexpr int maxPendingTriggers = 64;
+
+    /// Triggers waiting for their sample time, sorted ascending; render
+    /// thread only. Entries whose time falls beyond the current quantum stay
+    /// pending across cycles.
+    AKTriggerEvent pendingTriggers[maxPendingTriggers];
+    int pendingTriggerCount = 0;
+
+    /// Dispatches one trigger to the virtual trigger entry points.
+    void fireTrigger(const AKTriggerEvent& event);
+
 protected:
 
     int channelCount;
@@ -65,13 +180,55 @@ protected:
     bool isInitialized = false;
     std::atomic<bool> isStarted{true};
 
+    /// Set while an offline bounce drives this node (see akRenderGraphBounce).
+    /// Parameter updates snap to their goal instead of dezippering over 20 ms,
+    /// so the vectorized processBlock fast paths stay engaged across the large
+    /// offline quanta. Only touched between render cycles.
+    bool isOffline = false;
+
     // current time in samples
     AUEventSampleTime now = 0;
 
+    /// Profile slot for this node's type, assigned by the factory at
+    /// creation; -1 leaves render timing unrecorded.
+    int profileToken = -1;
+
+    /// Frames of uninterrupted input silence seen so far, for tail tracking.
+    uint64_t silentFrameRun = 0;
+
+    /// Set per quantum when the input is flagged silent and this node's tail
+    /// has died out: the event loop zero-fills the output instead of calling
+    /// processBlock, and the output is flagged silent for downstream nodes.
+    bool silenceBypass = false;
+
+    /// Zero-fills the output segment (the bypass stand-in for processBlock).
+    void zeroFillOutput(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset);
+
+    static constexpr int maxMeterChannels = 8;
+
+    /// One quantum's meter reduction, published whole so peak and RMS always
+    /// belong to the same render.
+    struct MeterLevels {
+        float peak[maxMeterChannels];
+        float rms[maxMeterChannels];
+        uint32_t channelCount;
+    };
+
+    /// Wait-free handoff of meter levels to the UI thread.
+    TripleBuffer<MeterLevels> meterBuffer;
+    std::atomic<bool> meteringEnabled{false};
+
+    /// Reduces the rendered output into per-channel peak/RMS and publishes.
+    void updateMeters(const AudioBufferList* buffers, AUAudioFrameCount frameCount);
+
     static constexpr int maxParameters = 128;
-    
+
     class ParameterRamper* parameters[maxParameters];
 
+    /// When non-null, processSpecialized runs this instead of the scalar
+    /// process. Bound by bindChannelSpecialization from init().
+    void (DSPBase::*specializedKernel)(AUAudioFrameCount, AUAudioFrameCount) = nullptr;
+
 public:
     
     DSPBase(int inputBusCount=1);
@@ -80,6 +237,12 @@ public:
     virtual ~DSPBase();
     
     std::vector<AudioBufferList*> inputBufferLists;
+
+    /// Per-bus silence flags from this quantum's input pull, parallel to
+    /// inputBufferLists. Multi-input nodes (mixers) can skip flagged buses
+    /// entirely instead of summing zeros.
+    std::vector<uint8_t> inputBusSilent;
+
     AudioBufferList* outputBufferList = nullptr;
     
     AUInternalRenderBlock internalRenderBlock();
@@ -87,20 +250,110 @@ public:
     inline bool canProcessInPlace() const { return bCanProcessInPlace; }
     
     void setBuffer(AudioBufferList* buffer, size_t busIndex);
-    
+
+    /// Registers this node's input buses with the shared scratch pool instead
+    /// of a dedicated buffer per bus. Call from allocateRenderResources.
+    void reserveScratchBuffers(uint32_t channelCount, uint32_t maxFrames);
+
     /// The Render function.
     virtual void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) = 0;
-    
+
+    /// Vectorized render path. The default implementation falls through to the
+    /// scalar per-frame `process` (or a bound channel specialization, see
+    /// below). Subclasses whose inner loop is simple gain, mix, or pan math
+    /// can override this instead and compute the whole segment with the block
+    /// kernels in DSPVectorOps.h, 4-8 samples per iteration. The event loop
+    /// always calls `processBlock`, so opting in is just overriding it.
+    ///
+    /// Overrides conventionally open with a guard that falls back to
+    /// `DSPBase::processBlock` while any parameter ramp is moving (and for
+    /// unusual channel layouts): per-frame parameter updates are only needed
+    /// while a ramp is in motion, so the steady state can read each parameter
+    /// once and run the whole block.
+    virtual void processBlock(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset)
+    {
+        processSpecialized(frameCount, bufferOffset);
+    }
+
+    /// Kernel bound once at init time by bindChannelSpecialization.
+    using SpecializedKernel = void (DSPBase::*)(AUAudioFrameCount, AUAudioFrameCount);
+
+    /// Runs the bound channel specialization, or the scalar process when none
+    /// is bound. Kernels with their own processBlock override can use this as
+    /// their fallback path.
+    void processSpecialized(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset)
+    {
+        if (specializedKernel) (this->*specializedKernel)(frameCount, bufferOffset);
+        else process(frameCount, bufferOffset);
+    }
+
+    /// Subclasses that define
+    ///     template <int staticChannelCount>
+    ///     void processTemplated(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset);
+    /// can call this from init() to select a compile-time channel
+    /// specialization once per session: exact stereo binds the unrolled <2>
+    /// instantiation (no per-frame channel loop, paired L/R math) and any
+    /// other layout binds <0>, which should defer to the generic loop.
+    template <typename D>
+    void bindChannelSpecialization()
+    {
+        if (channelCount == 2) {
+            specializedKernel = static_cast<SpecializedKernel>(&D::template processTemplated<2>);
+        }
+        else {
+            specializedKernel = static_cast<SpecializedKernel>(&D::template processTemplated<0>);
+        }
+    }
+
     /// Uses the ParameterAddress as a key
     virtual void setParameter(AUParameterAddress address, float value, bool immediate = false);
 
+    /// Sets the ramp shape for one parameter's subsequent changes; routed
+    /// through the parameter update queue so it lands on the render thread.
+    void setParameterTaper(AUParameterAddress address, int taper);
+
     /// Uses the ParameterAddress as a key
     virtual float getParameter(AUParameterAddress address);
 
+    /// How long this node keeps producing sound after its input goes silent.
+    /// The render block keeps processing a silent-input node until this tail
+    /// has elapsed, then short-circuits it to a zero-fill and propagates the
+    /// silence flag downstream. Memoryless nodes (gain, pan) can return 0;
+    /// reverbs and delays should cover their decay (delay time, RT60). A
+    /// negative value means the tail is unknown and the node never bypasses,
+    /// which is the default: only nodes that explicitly declare a tail take
+    /// part, so a node that forgets to override can never have a legitimate
+    /// tail truncated.
+    virtual float tailTimeSeconds() const { return -1.0f; }
+
+    void setMeteringEnabled(bool enabled) {
+        meteringEnabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    /// UI-thread read of the latest published meter levels; returns the
+    /// channel count (0 when disabled or nothing rendered yet).
+    uint32_t readMeterLevels(float* peaks, float* rms, uint32_t maxChannels);
+
+    /// Size in bytes of this node's state blob (versioned header plus all
+    /// parameter targets). Subclasses carrying kernel-private state worth
+    /// persisting can extend the blob; bump the version when they do.
+    virtual size_t stateBlobSize() const;
+
+    /// Writes the state blob into `blob` (at least stateBlobSize() bytes).
+    /// Returns the number of bytes written, 0 when capacity is too small.
+    virtual size_t saveStateBlob(void* blob, size_t capacity) const;
+
+    /// Applies a blob produced by saveStateBlob. Every parameter lands as one
+    /// immediate update at the top of the next render cycle — no ramps, one
+    /// coherent pass. Returns false for a malformed or mismatched blob.
+    virtual bool restoreStateBlob(const void* blob, size_t size);
+
     /// Get the DSP into initialized state
     virtual void reset() {}
 
-    /// Common for oscillators
+    /// Common for oscillators. Called off the render thread; overrides that
+    /// swap tables while rendering should publish through a
+    /// WavetableExchange rather than mutate tables the render thread reads.
     virtual void setWavetable(const float* table, size_t length, int index) {}
 
     /// Multiple waveform oscillators
@@ -112,6 +365,9 @@ public:
     virtual void trigger() {}
 
     virtual void triggerFrequencyAmplitude(AUValue frequency, AUValue amplitude) {}
+
+    /// Producer side of triggerBatchDSP; safe from one non-render thread.
+    void enqueueTriggerEvents(const AKTriggerEvent* events, size_t count);
     
     /// override this if your DSP kernel allocates memory or requires the session sample rate for initialization
     virtual void init(int channelCount, double sampleRate);
@@ -140,6 +396,13 @@ public:
         return isInitialized;
     }
 
+    /// Toggles offline-bounce behavior; call between render cycles, never
+    /// while a render is in flight.
+    void setOfflineMode(bool offline)
+    {
+        isOffline = offline;
+    }
+
     virtual void handleMIDIEvent(AUMIDIEvent const& midiEvent) {}
 
     /// Pointer to a factory function.
@@ -154,21 +417,30 @@ public:
     /// Create a subclass by name.
     static DSPRef create(const char* name);
 
+    /// Resolve a registered name to its integer type ID (-1 if unknown).
+    static int typeID(const char* name);
+
+    /// Create a subclass from its registration type ID.
+    static DSPRef createByID(int typeID);
+
     virtual void startRamp(const AUParameterEvent& event);
     
-private:
-
     /**
-     Handles the event list processing and rendering loop. Should be called from AU renderBlock
+     Handles the event list processing and rendering loop. Called from the AU
+     render block, or directly by the graph render scheduler (RenderGraph)
+     with the buffer lists pre-wired.
      From Apple Example code
      */
     void processWithEvents(AudioTimeStamp const *timestamp,
                            AUAudioFrameCount frameCount,
                            AURenderEvent const *events);
-    
+
+private:
+
     void handleOneEvent(AURenderEvent const *event);
     
-    void performAllSimultaneousEvents(AUEventSampleTime now, AURenderEvent const *&event);
+    void performAllSimultaneousEvents(AUEventSampleTime now, AURenderEvent const *&event,
+                                      AUEventSampleTime bufferStart);
 
     
 };
@@ -0,0 +1,240 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+// Block kernels for the vectorized render path (see DSPBase::processBlock).
+//
+// Each kernel operates on a contiguous run of samples. On ARM we use NEON
+// directly, on Intel SSE, and anywhere else we fall back to vDSP so the
+// scalar loop is never the only option.
+
+#pragma once
+
+#ifdef __cplusplus
+
+#include <cstddef>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define AK_VECTOR_NEON 1
+#elif defined(__SSE__)
+#include <immintrin.h>
+#define AK_VECTOR_SSE 1
+#else
+#include <Accelerate/Accelerate.h>
+#endif
+
+namespace AudioKitCore {
+
+/// out[i] = in[i] * gain
+inline void vApplyGain(const float* in, float* out, float gain, size_t count)
+{
+#if AK_VECTOR_NEON
+    size_t i = 0;
+    float32x4_t vgain = vdupq_n_f32(gain);
+    for (; i + 4 <= count; i += 4) {
+        vst1q_f32(out + i, vmulq_f32(vld1q_f32(in + i), vgain));
+    }
+    for (; i < count; ++i) out[i] = in[i] * gain;
+#elif AK_VECTOR_SSE
+    size_t i = 0;
+    __m128 vgain = _mm_set1_ps(gain);
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_loadu_ps(in + i), vgain));
+    }
+    for (; i < count; ++i) out[i] = in[i] * gain;
+#else
+    vDSP_vsmul(in, 1, &gain, out, 1, count);
+#endif
+}
+
+/// out[i] = in[i] * (start + i * increment)
+///
+/// Used to fold a parameter ramp into the gain multiply without touching
+/// the ramper once per sample.
+inline void vApplyGainRamp(const float* in, float* out, float start, float increment, size_t count)
+{
+#if AK_VECTOR_NEON
+    size_t i = 0;
+    float32x4_t vgain = { start,
+                          start + increment,
+                          start + 2.0f * increment,
+                          start + 3.0f * increment };
+    float32x4_t vstep = vdupq_n_f32(4.0f * increment);
+    for (; i + 4 <= count; i += 4) {
+        vst1q_f32(out + i, vmulq_f32(vld1q_f32(in + i), vgain));
+        vgain = vaddq_f32(vgain, vstep);
+    }
+    for (; i < count; ++i) out[i] = in[i] * (start + float(i) * increment);
+#elif AK_VECTOR_SSE
+    size_t i = 0;
+    __m128 vgain = _mm_setr_ps(start,
+                               start + increment,
+                               start + 2.0f * increment,
+                               start + 3.0f * increment);
+    __m128 vstep = _mm_set1_ps(4.0f * increment);
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_loadu_ps(in + i), vgain));
+        vgain = _mm_add_ps(vgain, vstep);
+    }
+    for (; i < count; ++i) out[i] = in[i] * (start + float(i) * increment);
+#else
+    float gain = start;
+    float step = increment;
+    vDSP_vrampmul(in, 1, &gain, &step, out, 1, count);
+#endif
+}
+
+/// out[i] = inA[i] * gainA + inB[i] * gainB
+inline void vMix(const float* inA, float gainA, const float* inB, float gainB, float* out, size_t count)
+{
+#if AK_VECTOR_NEON
+    size_t i = 0;
+    float32x4_t vgainA = vdupq_n_f32(gainA);
+    float32x4_t vgainB = vdupq_n_f32(gainB);
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t acc = vmulq_f32(vld1q_f32(inA + i), vgainA);
+        acc = vmlaq_f32(acc, vld1q_f32(inB + i), vgainB);
+        vst1q_f32(out + i, acc);
+    }
+    for (; i < count; ++i) out[i] = inA[i] * gainA + inB[i] * gainB;
+#elif AK_VECTOR_SSE
+    size_t i = 0;
+    __m128 vgainA = _mm_set1_ps(gainA);
+    __m128 vgainB = _mm_set1_ps(gainB);
+    for (; i + 4 <= count; i += 4) {
+        __m128 acc = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(inA + i), vgainA),
+                                _mm_mul_ps(_mm_loadu_ps(inB + i), vgainB));
+        _mm_storeu_ps(out + i, acc);
+    }
+    for (; i < count; ++i) out[i] = inA[i] * gainA + inB[i] * gainB;
+#else
+    vDSP_vsmsma(inA, 1, &gainA, inB, 1, &gainB, out, 1, count);
+#endif
+}
+
+/// out[i] = inA[i] * inB[i]
+inline void vMultiply(const float* inA, const float* inB, float* out, size_t count)
+{
+#if AK_VECTOR_NEON
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        vst1q_f32(out + i, vmulq_f32(vld1q_f32(inA + i), vld1q_f32(inB + i)));
+    }
+    for (; i < count; ++i) out[i] = inA[i] * inB[i];
+#elif AK_VECTOR_SSE
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_loadu_ps(inA + i), _mm_loadu_ps(inB + i)));
+    }
+    for (; i < count; ++i) out[i] = inA[i] * inB[i];
+#else
+    vDSP_vmul(inA, 1, inB, 1, out, 1, count);
+#endif
+}
+
+/// out[i] += in[i]
+inline void vAdd(const float* in, float* out, size_t count)
+{
+#if AK_VECTOR_NEON
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        vst1q_f32(out + i, vaddq_f32(vld1q_f32(out + i), vld1q_f32(in + i)));
+    }
+    for (; i < count; ++i) out[i] += in[i];
+#elif AK_VECTOR_SSE
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(out + i), _mm_loadu_ps(in + i)));
+    }
+    for (; i < count; ++i) out[i] += in[i];
+#else
+    vDSP_vadd(in, 1, out, 1, out, 1, count);
+#endif
+}
+
+/// out[i] += in[i] * gain
+///
+/// The mixer's summing primitive: each input accumulates straight into the
+/// output bus, no intermediate scaled copy.
+inline void vAccumulateGain(const float* in, float* out, float gain, size_t count)
+{
+#if AK_VECTOR_NEON
+    size_t i = 0;
+    float32x4_t vgain = vdupq_n_f32(gain);
+    for (; i + 4 <= count; i += 4) {
+        vst1q_f32(out + i, vmlaq_f32(vld1q_f32(out + i), vld1q_f32(in + i), vgain));
+    }
+    for (; i < count; ++i) out[i] += in[i] * gain;
+#elif AK_VECTOR_SSE
+    size_t i = 0;
+    __m128 vgain = _mm_set1_ps(gain);
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(out + i),
+                                          _mm_mul_ps(_mm_loadu_ps(in + i), vgain)));
+    }
+    for (; i < count; ++i) out[i] += in[i] * gain;
+#else
+    vDSP_vsma(in, 1, &gain, out, 1, out, 1, count);
+#endif
+}
+
+/// out[i] += in[i] * (start + i * increment)
+inline void vAccumulateGainRamp(const float* in, float* out, float start, float increment, size_t count)
+{
+#if AK_VECTOR_NEON
+    size_t i = 0;
+    float32x4_t vgain = { start,
+                          start + increment,
+                          start + 2.0f * increment,
+                          start + 3.0f * increment };
+    float32x4_t vstep = vdupq_n_f32(4.0f * increment);
+    for (; i + 4 <= count; i += 4) {
+        vst1q_f32(out + i, vmlaq_f32(vld1q_f32(out + i), vld1q_f32(in + i), vgain));
+        vgain = vaddq_f32(vgain, vstep);
+    }
+    for (; i < count; ++i) out[i] += in[i] * (start + float(i) * increment);
+#elif AK_VECTOR_SSE
+    size_t i = 0;
+    __m128 vgain = _mm_setr_ps(start,
+                               start + increment,
+                               start + 2.0f * increment,
+                               start + 3.0f * increment);
+    __m128 vstep = _mm_set1_ps(4.0f * increment);
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(out + i),
+                                          _mm_mul_ps(_mm_loadu_ps(in + i), vgain)));
+        vgain = _mm_add_ps(vgain, vstep);
+    }
+    for (; i < count; ++i) out[i] += in[i] * (start + float(i) * increment);
+#else
+    float gain = start;
+    for (size_t i = 0; i < count; ++i) {
+        out[i] += in[i] * gain;
+        gain += increment;
+    }
+#endif
+}
+
+/// out[i] = in[i]
+inline void vCopy(const float* in, float* out, size_t count)
+{
+    if (out == in) return;
+#if AK_VECTOR_NEON
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        vst1q_f32(out + i, vld1q_f32(in + i));
+    }
+    for (; i < count; ++i) out[i] = in[i];
+#elif AK_VECTOR_SSE
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(out + i, _mm_loadu_ps(in + i));
+    }
+    for (; i < count; ++i) out[i] = in[i];
+#else
+    cblas_scopy((int)count, in, 1, out, 1);
+#endif
+}
+
+}
+
+#endif
@@ -4,6 +4,8 @@
 #define DebugDSP_h
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -20,6 +22,120 @@ void DebugDSP(int slot, float value);
 /// slot are what is expected.
 bool DebugDSPCheck(int slot, const char* expected);
 
+#pragma mark - Render profiler
+
+/// Always-on render-time profiler. The render thread stamps each node's
+/// process call with mach_absolute_time and folds the elapsed time into a
+/// per-node-type histogram using relaxed atomics, so recording costs two
+/// timestamps and a few uncontended increments per render cycle. The UI
+/// thread can snapshot mean/worst/99th-percentile render times at any point
+/// without stopping audio.
+
+/// Register (or look up) the profile slot for a node type. Returns a token
+/// for DSPProfilerRecord, or -1 when the table is full. Call from the thread
+/// that creates nodes, not from the render thread.
+int DSPProfilerRegisterNode(const char* name);
+
+/// Current host time in mach ticks.
+uint64_t DSPProfilerTimestamp(void);
+
+/// Fold one render of the given node into its histogram. Lock-free; safe to
+/// call from the render thread every cycle.
+void DSPProfilerRecord(int node, uint64_t startTime, uint64_t endTime);
+
+/// One node type's aggregated render statistics.
+typedef struct DSPProfileStat {
+    const char* name;     ///< registered node-type name (owned by the profiler)
+    uint64_t renderCount; ///< renders recorded since the last reset
+    double averageNs;     ///< mean render time
+    double worstNs;       ///< worst-case render time
+    double p99Ns;         ///< 99th-percentile render time (histogram bucket bound)
+} DSPProfileStat;
+
+/// Snapshot statistics for every registered node type into stats, up to
+/// maxStats entries, and return the number written. Safe to call from the
+/// UI thread while audio renders.
+size_t DSPProfilerSnapshot(DSPProfileStat* stats, size_t maxStats);
+
+/// Zero all histograms and counters, keeping node registrations.
+void DSPProfilerReset(void);
+
+#pragma mark - Energy telemetry
+
+/// Energy telemetry: correlates render load with the SoC's thermal state so
+/// the engine sees throttling coming instead of learning about it from
+/// dropouts. The render thread feeds one load sample per quantum (the
+/// overload governor's render observer does this automatically); the app
+/// feeds thermal-state notifications; anyone may query the smoothed load,
+/// the thermal-derated budget scale, and the remaining headroom.
+
+/// Thermal states mirror NSProcessInfoThermalState raw values.
+enum {
+    DSPThermalNominal  = 0,
+    DSPThermalFair     = 1,
+    DSPThermalSerious  = 2,
+    DSPThermalCritical = 3,
+};
+#define DSP_THERMAL_STATES 4
+
+/// Report a thermal-state change. Call from the app's observer of
+/// NSProcessInfo.thermalStateDidChangeNotification (any thread); each change
+/// is stamped with the smoothed load at that moment so load trends can be
+/// lined up against throttle onsets.
+void DSPEnergySetThermalState(int state);
+
+/// Most recently reported thermal state.
+int DSPEnergyGetThermalState(void);
+
+/// Fold one quantum's load (render time as a fraction of the quantum) into
+/// the telemetry. Lock-free; called from the render thread every cycle.
+void DSPEnergyRecordQuantum(double loadFraction);
+
+/// Budget scale for the current thermal state, in (0, 1]. The overload
+/// governor multiplies its configured budget fraction by this, so degradation
+/// hooks engage earlier as the device heats up.
+double DSPEnergyBudgetScale(void);
+
+/// Replace the per-state budget scales (defaults 1.0 / 0.9 / 0.75 / 0.6 for
+/// nominal / fair / serious / critical).
+void DSPEnergyConfigureDerate(double nominal, double fair, double serious, double critical);
+
+/// Estimated headroom: the thermal-derated load ceiling minus the smoothed
+/// load, as a fraction of the render quantum. Negative means the graph is
+/// already past what the current thermal state can sustain.
+double DSPEnergyHeadroom(void);
+
+/// One thermal-state transition, stamped on the notification thread.
+typedef struct DSPEnergyTransition {
+    uint64_t hostTime;     ///< mach ticks when the notification arrived
+    int fromState;         ///< state before the change
+    int toState;           ///< state after the change
+    double smoothedLoad;   ///< smoothed render load at the moment of change
+} DSPEnergyTransition;
+
+/// Aggregated energy statistics.
+typedef struct DSPEnergyStat {
+    int thermalState;                              ///< current thermal state
+    double smoothedLoad;                           ///< exponentially smoothed load fraction
+    double budgetScale;                            ///< current derate multiplier
+    double headroom;                               ///< budgetScale minus smoothedLoad
+    uint64_t quantaInState[DSP_THERMAL_STATES];    ///< quanta rendered per state
+    double averageLoadInState[DSP_THERMAL_STATES]; ///< mean load fraction per state
+} DSPEnergyStat;
+
+/// Snapshot the aggregated statistics. Safe to call from the UI thread while
+/// audio renders; pair with DSPProfilerSnapshot to see which node types are
+/// driving the load in each thermal state.
+void DSPEnergySnapshot(DSPEnergyStat* stat);
+
+/// Copy the most recent thermal transitions (newest last) into transitions,
+/// up to maxTransitions entries, and return the number written.
+size_t DSPEnergyTransitions(DSPEnergyTransition* transitions, size_t maxTransitions);
+
+/// Zero the load accumulators and transition log, keeping the current
+/// thermal state and derate configuration.
+void DSPEnergyReset(void);
+
 #ifdef __cplusplus
 }
 #endif
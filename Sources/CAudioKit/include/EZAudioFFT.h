@@ -157,7 +157,7 @@
 //------------------------------------------------------------------------------
 
 /**
- A float array containing the last calculated inverse FFT data (the time domain signal).
+ A float array containing the inverse FFT data (the time domain signal) for the last computed FFT. The inverse transform is computed lazily on first access after each compute, so instances that never read this property (such as spectrum views) don't pay for it.
  */
 @property (readonly, nonatomic) float *inversedFFTData;
 
@@ -214,6 +214,19 @@
 
 //------------------------------------------------------------------------------
 
+/**
+ Computes the FFT for a float array representing an incoming audio signal and reduces the magnitude spectrum down to a display resolution. Spectrum views typically draw far fewer bars than the FFT produces bins (for instance 128 bars from a 4096-point FFT), so this method buckets the full spectrum and keeps the peak magnitude of each bucket, which keeps narrow spectral lines visible at the lower resolution. This will trigger the EZAudioFFTDelegate method `fft:updatedWithFFTData:bufferSize:` with the full resolution data.
+ @param buffer          A float array representing the audio data.
+ @param bufferSize      The length of the float array of audio data.
+ @param displayBinCount A vDSP_Length (unsigned long) representing the number of output bins, typically the number of bars the view draws.
+ @return A float array of `displayBinCount` magnitudes, owned by the receiver and valid until the next compute call.
+ */
+- (float *)computeFFTWithBuffer:(float *)buffer
+                 withBufferSize:(UInt32)bufferSize
+                displayBinCount:(vDSP_Length)displayBinCount;
+
+//------------------------------------------------------------------------------
+
 /**
  Provides the frequency corresponding to an index in the last computed FFT data.
  @param index A vDSP_Length (unsigned integer) representing the index of the frequency bin value you'd like to get
@@ -82,7 +82,7 @@ FOUNDATION_EXPORT UInt32 const EZAudioPlotDefaultMaxHistoryBufferLength;
 @interface EZAudioPlot : EZPlot
 
 /**
- A BOOL that allows optimizing the audio plot's drawing for real-time displays. Since the update function may be updating the plot's data very quickly (over 60 frames per second) this property will throttle the drawing calls to be 60 frames per second (or whatever the screen rate is). Specifically, it disables implicit path change animations on the `waveformLayer` and sets up a display link to render 60 fps (audio updating the plot at 44.1 kHz causes it to re-render 86 fps - far greater than what is needed for a visual display).
+ A BOOL that allows optimizing the audio plot's drawing for real-time displays. Since the update function may be updating the plot's data very quickly (over 60 frames per second) this property will throttle the drawing calls to be 60 frames per second (or whatever the screen rate is). Specifically, it disables implicit path change animations on the `waveformLayer` and sets up a display link to render 60 fps (audio updating the plot at 44.1 kHz causes it to re-render 86 fps - far greater than what is needed for a visual display). While enabled, `updateBuffer:withBufferSize:` only copies the samples into a wait-free staging ring and is safe to call directly from the audio thread; all history and drawing work happens once per display-link tick.
  */
 @property (nonatomic, assign) BOOL shouldOptimizeForRealtimePlot;
 
@@ -214,6 +214,8 @@ typedef struct _EZPlotHistoryInfo EZPlotHistoryInfo;
 @property (nonatomic, assign) EZPlotHistoryInfo  *historyInfo;
 @property (nonatomic, assign) CGPoint            *points;
 @property (nonatomic, assign) UInt32              pointCount;
+@property (nonatomic, assign) float              *rollingMinimums;
+@property (nonatomic, assign) float              *rollingMaximums;
 @property (nonatomic, assign) bool                fadeout;
 #if TARGET_OS_IPHONE || TARGET_OS_UIKITFORMAC
 @property (nonatomic, strong) UIColor            *originalColor;
@@ -352,6 +352,17 @@ typedef struct
 
 //------------------------------------------------------------------------------
 
+/**
+ Calculates a single root mean squared over every channel of an AudioBufferList in one pass. Works on both interleaved and non-interleaved buffer lists and avoids allocating or copying any intermediate mono mixdown.
+ @param 	bufferList 	A pointer to the AudioBufferList containing float audio data
+ @param 	frames 	A UInt32 representing the number of frames in each buffer
+ @return	The root mean squared across all samples in the buffer list
+ */
++ (float)RMSFromBufferList:(AudioBufferList *)bufferList
+        withNumberOfFrames:(UInt32)frames;
+
+//------------------------------------------------------------------------------
+
 /**
  Calculate the sign function sgn(x) =
  {  -1 , x < 0,
@@ -362,6 +373,40 @@ typedef struct
  */
 + (float)SGN:(float)value;
 
+//------------------------------------------------------------------------------
+#pragma mark - Float Conversion Utility
+//------------------------------------------------------------------------------
+
+///-----------------------------------------------------------
+/// @name Float Conversion Utility
+///-----------------------------------------------------------
+
+/**
+ Converts a buffer of signed 16-bit integer samples to normalized floats in the range [-1, 1) using the Accelerate framework rather than a scalar loop.
+ @param source      A SInt16 array containing the samples to convert
+ @param destination A float array to receive the converted samples (may not alias the source)
+ @param length      A UInt32 representing the number of samples to convert
+ */
++ (void)convertSInt16:(SInt16 *)source
+              toFloat:(float *)destination
+               length:(UInt32)length;
+
+//------------------------------------------------------------------------------
+
+/**
+ Converts an entire AudioBufferList into an array of non-interleaved float buffers in one batch. Handles float and signed 16-bit integer linear PCM data, interleaved or not, deinterleaving with strided vector operations instead of per-sample loops. Integer samples are normalized to the range [-1, 1).
+ @param bufferList A pointer to the AudioBufferList containing the source audio data
+ @param frames     A UInt32 representing the number of frames in each buffer
+ @param buffers    An array of float arrays (one per channel, each holding at least `frames` samples) to receive the converted audio data
+ @param channels   A UInt32 representing the number of channels to convert
+ @param asbd       The AudioStreamBasicDescription describing the source data's format
+ */
++ (void)convertBufferList:(AudioBufferList *)bufferList
+       withNumberOfFrames:(UInt32)frames
+           toFloatBuffers:(float **)buffers
+         numberOfChannels:(UInt32)channels
+                   format:(AudioStreamBasicDescription)asbd;
+
 //------------------------------------------------------------------------------
 #pragma mark - Music Utilities
 //------------------------------------------------------------------------------
@@ -489,6 +534,18 @@ typedef struct
 
 //------------------------------------------------------------------------------
 
+/**
+ Calculates a single RMS over every channel of an AudioBufferList and appends it to the tail of a EZPlotHistoryInfo data structure. Equivalent to mixing the buffer list down to mono and calling `appendBufferRMS:withBufferSize:toHistoryInfo:`, without the intermediate buffer. Thread-safe.
+ @param bufferList  A pointer to the AudioBufferList containing the incoming float audio data
+ @param frames      A UInt32 representing the number of frames in each buffer
+ @param historyInfo A pointer to a EZPlotHistoryInfo structure to use for managing the history buffers
+ */
++ (void)appendBufferListRMS:(AudioBufferList *)bufferList
+         withNumberOfFrames:(UInt32)frames
+              toHistoryInfo:(EZPlotHistoryInfo *)historyInfo;
+
+//------------------------------------------------------------------------------
+
 /**
  Appends a buffer of audio data to the tail of a EZPlotHistoryInfo data structure. Thread-safe.
  @param buffer      A float array containing the incoming audio buffer to append to the history buffer
@@ -501,6 +558,29 @@ typedef struct
 
 //------------------------------------------------------------------------------
 
+/**
+ Copies the most recent window of samples out of a EZPlotHistoryInfo's internal ring into its contiguous window buffer and returns it. Use this when you need the history as one linear array (for instance to feed an FFT); the copy happens here on demand rather than on every append.
+ @param historyInfo A pointer to a EZPlotHistoryInfo structure to use for managing the history buffers
+ @return A float array containing the last `bufferSize` samples appended, owned by the EZPlotHistoryInfo.
+ */
++ (float *)windowForHistoryInfo:(EZPlotHistoryInfo *)historyInfo;
+
+//------------------------------------------------------------------------------
+
+/**
+ Reads a min/max waveform envelope of the most recent window of a EZPlotHistoryInfo at an arbitrary resolution using the history's decimation pyramid. Each output point receives the minimum and maximum sample value over its share of the window, so narrow peaks survive the downsampling. The cost is proportional to the number of points requested, not the history length.
+ @param historyInfo A pointer to a EZPlotHistoryInfo structure to use for managing the history buffers
+ @param minimums    A float array of `pointCount` elements to receive the per-point minimums
+ @param maximums    A float array of `pointCount` elements to receive the per-point maximums
+ @param pointCount  An int representing the number of output points, typically the width of the view in pixels
+ */
++ (void)readHistoryInfo:(EZPlotHistoryInfo *)historyInfo
+               minimums:(float *)minimums
+               maximums:(float *)maximums
+             pointCount:(int)pointCount;
+
+//------------------------------------------------------------------------------
+
 /**
  Zeroes out a EZPlotHistoryInfo data structure without freeing the resources.
  @param historyInfo A pointer to a EZPlotHistoryInfo data structure
@@ -0,0 +1,49 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "Interop.h"
+
+/// Live memory accounting across the engine's allocation choke points.
+/// Each large allocation — sampler data, delay lines, per-bus pull
+/// buffers, render scratch, soundpipe ftables — reports a signed byte
+/// delta tagged with a subsystem category and an optional node name.
+/// Per-category totals and high-water marks are queryable at runtime, so
+/// a footprint budget can be checked in-app rather than by attaching
+/// Instruments.
+
+enum {
+    AKMemorySampleData,      ///< sampler audio data (SampleBuffer)
+    AKMemoryDelayLines,      ///< delay line circular buffers
+    AKMemoryBusBuffers,      ///< per-bus pull buffers (BufferedAudioBus)
+    AKMemoryScratchBuffers,  ///< shared render scratch pool
+    AKMemorySoundpipe,       ///< soundpipe ftables and arena slabs
+    AKMemoryCategoryCount
+};
+
+#define AK_MEMORY_MAX_NODES 128
+
+/// Reports a signed byte delta against one category. `node` optionally
+/// attributes the delta to a named node or site for the per-node table;
+/// pass NULL to skip it. The first AK_MEMORY_MAX_NODES distinct names are
+/// tracked; later ones still count toward their category. Category totals
+/// are atomic and callable from any thread, though allocation sites
+/// normally run off the render thread.
+AK_API void akMemoryTrack(int category, const char *node, int64_t bytes);
+
+AK_API int64_t akMemoryCategoryBytes(int category);
+AK_API int64_t akMemoryCategoryHighWater(int category);
+AK_API const char *akMemoryCategoryName(int category);
+AK_API int64_t akMemoryTotalBytes(void);
+AK_API int64_t akMemoryTotalHighWater(void);
+
+/// Walks the per-node table: valid indices are [0, akMemoryNodeCount()).
+/// Returns false past the end. Name pointers stay valid for the process.
+AK_API int akMemoryNodeCount(void);
+AK_API bool akMemoryNodeInfo(int index, const char **name, int64_t *bytes,
+                             int64_t *highWater);
+
+/// Restarts every high-water mark from the current live bytes.
+AK_API void akMemoryResetHighWaterMarks(void);
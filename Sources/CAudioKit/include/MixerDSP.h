@@ -0,0 +1,30 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+#pragma once
+
+#import <AVFoundation/AVFoundation.h>
+#import "Interop.h"
+
+/// N-input summing mixer. Every input bus is accumulated straight into the
+/// output in one fused pass, with that input's gain and equal-power pan
+/// folded into the multiply; buses flagged silent by their upstream node are
+/// skipped outright. Per-input parameter addresses are computed, not
+/// enumerated — use the address helpers below.
+
+#define AK_MIXER_MAX_INPUTS 48
+
+typedef NS_ENUM(AUParameterAddress, MixerParameter)
+{
+    MixerParameterMasterVolume,
+};
+
+/// Gain (linear, default 1) for one input bus.
+AK_API AUParameterAddress akMixerInputGainAddress(uint32_t input);
+
+/// Pan (-1 hard left .. 1 hard right, default 0) for one input bus.
+/// Ignored for mono output.
+AK_API AUParameterAddress akMixerInputPanAddress(uint32_t input);
+
+/// Sets the number of input buses (1..AK_MIXER_MAX_INPUTS). Call right after
+/// akCreateDSP, before the audio unit queries the bus count.
+AK_API void akMixerSetInputBusCount(DSPRef pDSP, uint32_t count);
@@ -0,0 +1,45 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "Interop.h"
+
+/// Graph-wide tempo-synced modulation clock. One service tracks beat
+/// position and renders each subscribed LFO shape into a shared buffer once
+/// per quantum; every node reading the same subscription sees
+/// sample-identical values, so twenty synced modulators cost one evaluation
+/// and can never drift apart.
+
+/// LFO shapes, all rendered into [-1, 1].
+enum {
+    ModulationShapeSine,
+    ModulationShapeTriangle,
+    ModulationShapeSawUp,
+    ModulationShapeSawDown,
+    ModulationShapeSquare,
+};
+
+/// Transport controls. Tempo and transport changes land at the next quantum
+/// boundary so a quantum is never split. Callable from any thread.
+AK_API void akModulationClockSetTempo(double bpm);
+AK_API double akModulationClockTempo(void);
+AK_API void akModulationClockSetPlaying(bool playing);
+AK_API void akModulationClockSeekBeats(double beats);
+
+/// Registers interest in (shape, beatsPerCycle) and returns a slot index,
+/// or -1 when the slot table is full. Identical subscriptions share a slot.
+/// Allocates; call from the main thread, not the render thread.
+AK_API int akModulationClockSubscribe(int shape, double beatsPerCycle);
+AK_API void akModulationClockUnsubscribe(int slot);
+
+/// Render-thread read of one quantum of a subscribed shape. The first
+/// caller of a new quantum (identified by `sampleTime`) advances the beat
+/// cursor and renders every active slot; later callers just get the buffer.
+/// The pointer is valid until the next quantum.
+AK_API const float *akModulationClockShapeBuffer(int slot, int64_t sampleTime,
+                                                 uint32_t frameCount, double sampleRate);
+
+/// Beat position at the start of the quantum identified by `sampleTime`.
+AK_API double akModulationClockBeatPosition(int64_t sampleTime, double sampleRate);
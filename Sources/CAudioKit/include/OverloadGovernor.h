@@ -0,0 +1,44 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+#pragma once
+
+#include <AudioToolbox/AudioToolbox.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Called from the render thread when the governor asks a node to shed load
+/// (degrade == true) or restores it (degrade == false). Implementations must
+/// be realtime-safe: flip an atomic flag the kernel reads (voice cap,
+/// tail length), never allocate or lock.
+typedef void (*OverloadDegradationHook)(void* context, bool degrade);
+
+/// Registers a degradation hook. Hooks shed load in ascending priority order
+/// (lowest number first) and are restored in the reverse order. Returns a
+/// token for OverloadGovernorRemoveHook, or -1 when the table is full. Call
+/// from the thread that builds the graph, not from the render thread.
+int OverloadGovernorAddHook(int priority, OverloadDegradationHook hook, void* context);
+
+/// Deactivates a hook. Call before tearing down the node that registered it;
+/// the hook is not invoked again, including for restoration.
+void OverloadGovernorRemoveHook(int token);
+
+/// Number of hooks currently degraded, for UI display.
+int OverloadGovernorEngagedCount(void);
+
+/// Tunes the governor. budgetFraction is the share of the render quantum the
+/// graph may use before a quantum counts as overloaded (default 0.8).
+/// overloadQuanta consecutive overloaded quanta engage one more hook
+/// (default 3); recoveryQuanta consecutive healthy quanta restore one
+/// (default 500, roughly five seconds at typical buffer sizes).
+void OverloadGovernorConfigure(double budgetFraction, int overloadQuanta, int recoveryQuanta);
+
+/// Returns a render observer measuring quantum headroom. Attach it to the
+/// engine's output node so the measured span covers the whole graph pull.
+AURenderObserver OverloadGovernorGetRenderObserver(double sampleRate);
+
+#ifdef __cplusplus
+}
+#endif
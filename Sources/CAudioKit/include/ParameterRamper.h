@@ -14,8 +14,23 @@
 #import <libkern/OSAtomic.h>
 
 #import <atomic>
+#import <cmath>
 
 class ParameterRamper {
+public:
+    /// Ramp shapes. All of them cost a constant couple of operations per
+    /// sample: exponential is one multiply-add (a one-pole settling toward
+    /// the goal, snapped exact at the end), equal power advances a sine by
+    /// rotation, and the s-curve (cubic smoothstep) runs on forward
+    /// differences. Linear is the default and keeps the historic behavior.
+    enum Taper {
+        TaperLinear = 0,
+        TaperExponential = 1,
+        TaperEqualPower = 2,
+        TaperSCurve = 3,
+    };
+
+private:
     float clampLow, clampHigh;
     std::atomic<float> _uiValue{0};
     float _goal;
@@ -24,6 +39,16 @@ class ParameterRamper {
     std::atomic<int32_t> changeCounter;
     int32_t updateCounter = 0;
 
+    int taper = TaperLinear;
+    AUAudioFrameCount rampLength = 0;
+    float rampStart = 0;
+    float shapedValue = 0;
+    // recurrence state: exponential pole, equal-power rotation, s-curve
+    // forward differences
+    float expPole = 0;
+    float sinTheta = 0, cosTheta = 1, sinDelta = 0, cosDelta = 1;
+    float d1 = 0, d2 = 0, d3 = 0;
+
     void setImmediate(float value) {
         // only to be called from the render thread or when resources are not allocated.
         _goal = _uiValue = value;
@@ -31,6 +56,93 @@ class ParameterRamper {
         samplesRemaining = 0;
     }
 
+    void setupShape(float current, AUAudioFrameCount duration) {
+        rampLength = duration;
+        rampStart = shapedValue = current;
+        float range = _goal - rampStart;
+        switch (taper) {
+            case TaperExponential:
+                // settles within 0.1% of the goal over the duration; the end
+                // of the ramp snaps exactly through the steady-state path
+                expPole = expf(-6.9077553f / float(duration));
+                break;
+            case TaperEqualPower: {
+                float delta = float(M_PI_2) / float(duration);
+                sinDelta = sinf(delta);
+                cosDelta = cosf(delta);
+                sinTheta = 0;
+                cosTheta = 1;
+                break;
+            }
+            case TaperSCurve: {
+                // forward differences of range * (3t^2 - 2t^3) sampled at
+                // t = k / duration; the third difference of a cubic is
+                // constant, so stepping is three adds
+                double h = 1.0 / double(duration);
+                double a = double(range);
+                d1 = float(a * (3.0 * h * h - 2.0 * h * h * h));
+                d2 = float(a * (6.0 * h * h - 12.0 * h * h * h));
+                d3 = float(a * -12.0 * h * h * h);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    void stepShape() {
+        switch (taper) {
+            case TaperExponential:
+                shapedValue = _goal + (shapedValue - _goal) * expPole;
+                break;
+            case TaperEqualPower: {
+                float s = sinTheta * cosDelta + cosTheta * sinDelta;
+                float c = cosTheta * cosDelta - sinTheta * sinDelta;
+                sinTheta = s;
+                cosTheta = c;
+                shapedValue = rampStart + (_goal - rampStart) * s;
+                break;
+            }
+            case TaperSCurve:
+                shapedValue += d1;
+                d1 += d2;
+                d2 += d3;
+                break;
+            default:
+                break;
+        }
+    }
+
+    void jumpShape(AUAudioFrameCount n) {
+        // closed-form advance for block-granularity callers; n is the number
+        // of samples actually consumed
+        AUAudioFrameCount position = rampLength - samplesRemaining;
+        float range = _goal - rampStart;
+        switch (taper) {
+            case TaperExponential:
+                shapedValue = _goal + (shapedValue - _goal) * powf(expPole, float(n));
+                break;
+            case TaperEqualPower: {
+                float theta = float(M_PI_2) * float(position) / float(rampLength);
+                sinTheta = sinf(theta);
+                cosTheta = cosf(theta);
+                shapedValue = rampStart + range * sinTheta;
+                break;
+            }
+            case TaperSCurve: {
+                double h = 1.0 / double(rampLength);
+                double a = double(range);
+                double t = double(position) * h;
+                shapedValue = rampStart + float(a * (3.0 - 2.0 * t) * t * t);
+                d1 = float(a * h * ((6.0 * t + 3.0 * h) - (6.0 * t * t + 6.0 * t * h + 2.0 * h * h)));
+                d2 = float(a * h * h * (6.0 - 12.0 * t - 12.0 * h));
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
 public:
     ParameterRamper(float value = 0.0f) : changeCounter(0) {
         setImmediate(value);
@@ -53,6 +165,12 @@ public:
         std::atomic_fetch_add(&changeCounter, 1);
     }
 
+    void updateUIValue(float value) {
+        // Store the new value for getUIValue readback without signalling
+        // dezipperCheck; used when the ramp itself is delivered another way.
+        _uiValue = value;
+    }
+
     float getUIValue() const { return _uiValue; }
 
     void dezipperCheck(AUAudioFrameCount rampDuration)
@@ -65,6 +183,19 @@ public:
         }
     }
 
+    void setTaper(int newTaper) {
+        /*
+         Shape for subsequent ramps (see Taper). Call from the render thread
+         or while resources are not allocated; an active ramp keeps the shape
+         it started with.
+         */
+        if (newTaper >= TaperLinear && newTaper <= TaperSCurve) {
+            taper = newTaper;
+        }
+    }
+
+    int getTaper() const { return taper; }
+
     void startRamp(float newGoal, AUAudioFrameCount duration) {
         if (duration == 0) {
             setImmediate(newGoal);
@@ -74,23 +205,87 @@ public:
              Set a new ramp.
              Assigning to inverseSlope must come before assigning to goal.
              */
-            inverseSlope = (get() - newGoal) / float(duration);
+            float current = get();
+            inverseSlope = (current - newGoal) / float(duration);
             samplesRemaining = duration;
             _goal = _uiValue = newGoal;
+            if (taper != TaperLinear) setupShape(current, duration);
+        }
+    }
+
+    bool isRamping() const {
+        // Lets block kernels pick a constant-gain fast path when no ramp is active.
+        return samplesRemaining != 0;
+    }
+
+    AUAudioFrameCount framesUntilDone() const {
+        // Remaining ramp length in samples; zero when the value is steady.
+        return samplesRemaining;
+    }
+
+    float getIncrement() const {
+        // Per-sample increment of the active ramp; zero when the value is
+        // steady. For a curved taper this is the whole ramp's average slope —
+        // kernels that consume it render the chord and resync each block;
+        // fillBlock is the shape-exact alternative.
+        return samplesRemaining != 0 ? -inverseSlope : 0.0f;
+    }
+
+    float getAndStepBlock(AUAudioFrameCount n, float &increment) {
+        /*
+         Block version of getAndStep. Computes the value at the start of the
+         next n frames and the per-sample increment once, then advances the
+         ramp by n frames. The increment only holds for
+         min(n, framesUntilDone()) frames, so callers should segment their
+         block at the ramp end for sample accuracy.
+         */
+        float value = get();
+        increment = getIncrement();
+        stepBy(n);
+        return value;
+    }
+
+    void fillBlock(float *buffer, AUAudioFrameCount n) {
+        /*
+         Fills a contiguous buffer with the next n values of the ramp and
+         advances by n frames, so a kernel can fold the ramp into one
+         vectorized multiply instead of calling getAndStep per frame. This is
+         the shape-exact block path for every taper.
+         */
+        AUAudioFrameCount ramped = samplesRemaining < n ? samplesRemaining : n;
+        if (taper != TaperLinear) {
+            for (AUAudioFrameCount i = 0; i < ramped; ++i) {
+                buffer[i] = shapedValue;
+                stepShape();
+            }
+        } else {
+            float value = get();
+            float increment = -inverseSlope;
+            for (AUAudioFrameCount i = 0; i < ramped; ++i) {
+                buffer[i] = value;
+                value += increment;
+            }
+        }
+        for (AUAudioFrameCount i = ramped; i < n; ++i) {
+            buffer[i] = _goal;
         }
+        samplesRemaining -= ramped;
     }
 
     float get() const {
         /*
          For long ramps, integrating a sum loses precision and does not reach
          the goal at the right time. So instead, a line equation is used. y = m * x + b.
+         Curved tapers carry their value in the recurrence state instead.
          */
+        if (taper != TaperLinear && samplesRemaining != 0) return shapedValue;
         return inverseSlope * float(samplesRemaining) + _goal;
     }
 
     void step() {
         // Do this in each inner loop iteration after getting the value.
         if (samplesRemaining != 0) {
+            if (taper != TaperLinear) stepShape();
             --samplesRemaining;
         }
     }
@@ -99,6 +294,7 @@ public:
         // Combines get and step. Saves a multiply-add when not ramping.
         if (samplesRemaining != 0) {
             float value = get();
+            if (taper != TaperLinear) stepShape();
             --samplesRemaining;
             return value;
         }
@@ -110,13 +306,13 @@ public:
     void stepBy(AUAudioFrameCount n) {
         /*
          When a parameter does not participate in the current inner loop, you
-         will want to advance it after the end of the loop.
+         will want to advance it after the end of the loop. Curved tapers
+         jump their recurrence state in closed form, so this stays O(1).
          */
-        if (n >= samplesRemaining) {
-            samplesRemaining = 0;
-        }
-        else {
-            samplesRemaining -= n;
+        AUAudioFrameCount consumed = n >= samplesRemaining ? samplesRemaining : n;
+        samplesRemaining -= consumed;
+        if (taper != TaperLinear && consumed != 0 && samplesRemaining != 0) {
+            jumpShape(consumed);
         }
     }
 };
@@ -9,5 +9,23 @@ typedef struct PitchTracker *PitchTrackerRef;
 AK_API PitchTrackerRef akPitchTrackerCreate(unsigned int sampleRate, int hopSize, int peakCount);
 AK_API void akPitchTrackerDestroy(PitchTrackerRef);
 
+/// Change the analysis hop size. Trade latency for CPU: analysis runs once
+/// per hop, not per buffer. Do not call concurrently with analyze.
+AK_API void akPitchTrackerSetHopSize(PitchTrackerRef tracker, int hopSize);
+
 AK_API void akPitchTrackerAnalyze(PitchTrackerRef tracker, float* frames, unsigned int count);
 AK_API void akPitchTrackerGetResults(PitchTrackerRef tracker, float* trackedAmplitude, float* trackedFrequency);
+
+typedef struct PitchTrackerEnsemble *PitchTrackerEnsembleRef;
+
+/// Tracks pitch on `channelCount` channels of the same stream in one pass,
+/// sharing one FFT setup across channels.
+AK_API PitchTrackerEnsembleRef akPitchTrackerEnsembleCreate(unsigned int sampleRate, int hopSize,
+                                                            int peakCount, int channelCount);
+AK_API void akPitchTrackerEnsembleDestroy(PitchTrackerEnsembleRef);
+
+/// `channelFrames` holds one pointer per channel, each with `count` frames.
+AK_API void akPitchTrackerEnsembleAnalyze(PitchTrackerEnsembleRef ensemble, float** channelFrames,
+                                          unsigned int count);
+AK_API void akPitchTrackerEnsembleGetResults(PitchTrackerEnsembleRef ensemble, int channel,
+                                             float* trackedAmplitude, float* trackedFrequency);
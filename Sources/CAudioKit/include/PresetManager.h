@@ -30,6 +30,19 @@
 /// Creates a preset with an array of zones
 +(NSDictionary * _Nullable)presetWithZones:(NSArray <PresetZone *> * _Nonnull)presetZones oneShot:(BOOL)oneShot;
 
+/// Like presetWithZones:oneShot:, backed by a binary plist cache keyed by the
+/// zone parameters and source file attributes. Repeat loads of the same
+/// instrument skip dictionary construction entirely.
++(NSDictionary * _Nullable)cachedPresetWithZones:(NSArray <PresetZone *> * _Nonnull)presetZones oneShot:(BOOL)oneShot;
+
+/// Appends a zone to an existing preset without rebuilding it, reusing the
+/// file reference when the sample is already in the preset.
++(NSDictionary * _Nullable)preset:(NSDictionary * _Nonnull)preset byAddingZone:(PresetZone * _Nonnull)zone;
+
+/// Removes the zone with the given ID, dropping its file reference when no
+/// other zone uses it.
++(NSDictionary * _Nullable)preset:(NSDictionary * _Nonnull)preset byRemovingZoneWithID:(int)zoneID;
+
 /// Retrieve preset from a sampler audio unit.
 +(NSDictionary * _Nullable)samplerPreset:(AudioUnit _Nonnull)samplerUnit;
 
@@ -0,0 +1,30 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+#pragma once
+
+#include "Interop.h"
+
+/// Deferred reclamation for large teardown work. Unloading a sample
+/// library or tearing down a node frees hundreds of megabytes; doing
+/// that synchronously stalls whichever thread asked (usually main).
+/// Instead, teardown hands each object to a low-priority reaper thread
+/// with an atomic queue push and returns immediately; the reaper frees
+/// in bounded batches so it never monopolizes a core.
+///
+/// Jobs run in enqueue order on a single thread, so a dependent pair
+/// (a DSP's deinit, then its delete) can be queued back to back.
+
+/// Queues `destroy(payload)` to run on the reaper thread. The payload
+/// must not be touched by the caller afterwards. Safe from any thread;
+/// the enqueue itself allocates, so keep it off the render thread.
+AK_API void akReaperEnqueue(void (*destroy)(void *payload), void *payload);
+
+/// Queues a plain free() of `ptr`.
+AK_API void akReaperFree(void *ptr);
+
+/// Blocks until every job queued so far has run. Used before re-using
+/// a resource whose teardown may still be queued, and in tests.
+AK_API void akReaperDrain(void);
+
+/// Number of jobs queued but not yet completed.
+AK_API int akReaperPending(void);
@@ -0,0 +1,63 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+#pragma once
+
+#include <AudioToolbox/AudioToolbox.h>
+#include "Interop.h"
+
+/// Optional compiled render scheduler for a DSP graph.
+///
+/// Instead of the pull model's one-isolated-pass-per-node rendering with
+/// buffer staging between every pair, a RenderGraph is compiled from the
+/// connection topology: linear chains of in-place nodes fuse into single
+/// multi-kernel passes over one shared buffer, and independent passes at the
+/// same topological depth can run concurrently on worker threads. A 60-node
+/// chain-heavy graph renders in roughly a dozen buffer sweeps.
+typedef struct RenderGraphData* RenderGraphRef;
+
+AK_API RenderGraphRef akRenderGraphCreate(void);
+AK_API void akRenderGraphDestroy(RenderGraphRef graph);
+
+/// Adds a node and its input connections (indices previously returned by
+/// this call, so the graph is a DAG by construction). Returns the node's
+/// index, or -1 for an invalid input reference.
+AK_API int akRenderGraphAddNode(RenderGraphRef graph, DSPRef dsp,
+                                const int* inputNodes, size_t inputCount);
+
+/// Compiles the topology into fused passes and allocates pass buffers.
+/// workerCount worker threads (0 for single-threaded) help render
+/// independent passes. Call after every node's render resources are
+/// allocated, never while rendering.
+AK_API bool akRenderGraphCompile(RenderGraphRef graph, uint32_t channelCount,
+                                 uint32_t maxFrames, int workerCount);
+
+/// Number of compiled passes (buffer sweeps per render), for inspection.
+AK_API size_t akRenderGraphPassCount(RenderGraphRef graph);
+
+/// Renders one quantum: runs every pass in dependency order and copies the
+/// terminal pass into output. Call from the render thread.
+AK_API void akRenderGraphRender(RenderGraphRef graph, const AudioTimeStamp* timestamp,
+                                uint32_t frameCount, AudioBufferList* output);
+
+/// First-quantum warmup: renders quanta silent maxFrames-sized quanta through
+/// every pass, discards the output, then resets every node. Pass buffers and
+/// node state fault in, caches and branch predictors warm up, and remaining
+/// first-use lazy work runs - all off the render thread, so the first audible
+/// quantum pays none of it. Pair with akSamplerPrewarm (sample pages) for a
+/// fully warm cold start. Call after compile, while a loading screen is up,
+/// never while rendering.
+AK_API void akRenderGraphPrewarm(RenderGraphRef graph, uint32_t quanta);
+
+/// Offline bounce: renders frameCount frames as fast as the graph allows and
+/// streams them to path as a 32-bit float WAV. Quanta are maxFrames large
+/// (the size given to compile, not the realtime buffer size), independent
+/// passes still fan out to the worker pool, and disk writes are double
+/// buffered — the graph renders the next quantum while a writer thread
+/// flushes the previous one. Every node is switched to offline mode for the
+/// duration, so parameter updates snap instead of dezippering. progress (may
+/// be NULL) receives the completed fraction after each quantum. Call from a
+/// non-realtime thread; returns false on file errors.
+AK_API bool akRenderGraphBounce(RenderGraphRef graph, const char* path,
+                                double sampleRate, uint64_t frameCount,
+                                void (*progress)(double fraction, void* context),
+                                void* context);
@@ -51,8 +51,16 @@ typedef NS_ENUM(AUParameterAddress, SamplerParameter)
 
 AK_API DSPRef akSamplerCreateDSP(void);
 AK_API void akSamplerLoadData(DSPRef pDSP, SampleDataDescriptor *pSDD);
+AK_API void akSamplerLoadDataReference(DSPRef pDSP, SampleDataReferenceDescriptor *pSDRD);
 AK_API void akSamplerLoadCompressedFile(DSPRef pDSP, SampleFileDescriptor *pSFD);
+AK_API void akSamplerLoadCompressedFiles(DSPRef pDSP, SampleFileDescriptor *pSFDs, int count);
+AK_API void akSamplerLoadStreamedFile(DSPRef pDSP, StreamedSampleFileDescriptor *pSSFD);
 AK_API void akSamplerUnloadAllSamples(DSPRef pDSP);
+
+/// Touch (and optionally mlock) every loaded sample's pages so first playback
+/// doesn't fault them in on the render thread. Warms buffers in load order;
+/// call from a loading thread while a loading screen is up.
+AK_API void akSamplerPrewarm(DSPRef pDSP, bool lockInMemory);
 AK_API void akSamplerSetNoteFrequency(DSPRef pDSP, int noteNumber, float noteFrequency);
 AK_API void akSamplerBuildSimpleKeyMap(DSPRef pDSP);
 AK_API void akSamplerBuildKeyMap(DSPRef pDSP);
@@ -30,10 +30,43 @@ typedef struct
 
 } SampleDataDescriptor;
 
+// Zero-copy variant of SampleDataDescriptor: the sample data is referenced,
+// not copied, so the pointer must remain valid for as long as the sampler
+// holds the sample (e.g. an mmap'd, page-aligned file of floats). Channel
+// data must be non-interleaved: all left samples followed by all right
+// samples, the sampler's native layout.
 typedef struct
 {
     SampleDescriptor sampleDescriptor;
-    
+
+    float sampleRate;
+    int channelCount;
+    int sampleCount;
+    const float *data;
+
+} SampleDataReferenceDescriptor;
+
+typedef struct
+{
+    SampleDescriptor sampleDescriptor;
+
     const char *path;
-    
+
 } SampleFileDescriptor;
+
+// Descriptor for a disk-streamed sample: only residentSampleCount attack
+// frames stay in RAM, and the remainder streams on demand from the raw
+// float32 data (interleaved when channelCount > 1) that begins dataOffset
+// bytes into the file.
+typedef struct
+{
+    SampleDescriptor sampleDescriptor;
+
+    const char *path;
+    float sampleRate;
+    int channelCount;
+    int sampleCount;
+    int residentSampleCount;
+    unsigned long long dataOffset;
+
+} StreamedSampleFileDescriptor;
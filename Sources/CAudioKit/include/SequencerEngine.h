@@ -36,7 +36,30 @@ AK_API SequencerEngineRef akSequencerEngineCreate(void);
 /// Deallocate the sequencer.
 AK_API void akSequencerEngineDestroy(SequencerEngineRef engine);
 
+/// Adds a track to the engine and returns its index, or -1 when the engine is
+/// full. Track 0 exists from creation. All tracks follow the engine's single
+/// sample clock, so cross-track timing is exactly coherent.
+AK_API int akSequencerEngineAddTrack(SequencerEngineRef engine);
+
+/// Number of tracks owned by the engine.
+AK_API int akSequencerEngineTrackCount(SequencerEngineRef engine);
+
+/// Updates one track's sequence and returns a render observer that advances
+/// the shared clock and plays every track in a single pass. Install the
+/// observer once on the node driving the sequencer; each track delivers its
+/// MIDI through its own block.
+AK_API AURenderObserver SequencerEngineUpdateTrackSequence(SequencerEngineRef engine,
+                                                             int trackIndex,
+                                                             const SequenceEvent* events,
+                                                             size_t eventCount,
+                                                             const SequenceNote* notes,
+                                                             size_t noteCount,
+                                                             SequenceSettings settings,
+                                                             double sampleRate,
+                                                             AUScheduleMIDIEventBlock block);
+
 /// Updates the sequence and returns a new render observer.
+/// Equivalent to SequencerEngineUpdateTrackSequence on track 0.
 AK_API AURenderObserver SequencerEngineUpdateSequence(SequencerEngineRef engine,
                                                         const SequenceEvent* events,
                                                         size_t eventCount,
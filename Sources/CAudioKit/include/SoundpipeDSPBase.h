@@ -9,6 +9,16 @@
 class SoundpipeDSPBase: public DSPBase {
 protected:
     struct sp_data *sp = nullptr;
+
+    /// subclasses implementing processChannel() set this true in their constructor,
+    /// routing rendering through the block path instead of the per-sample loop
+    bool bUsesChannelBlocks = false;
+
+    /// subclasses whose soundpipe module processes both channels with shared
+    /// coefficients (the *_compute_block_stereo variants) set this true in their
+    /// constructor and implement processStereoBlock(); only used when rendering
+    /// exactly two channels, otherwise the per-channel path applies
+    bool bUsesStereoBlocks = false;
 public:
     SoundpipeDSPBase(int inputBusCount=1) : DSPBase(inputBusCount) {
         bCanProcessInPlace = true;
@@ -17,7 +27,20 @@ public:
     virtual void init(int channelCount, double sampleRate) override;
     virtual void deinit() override;
     virtual void processSample(int channel, float *in, float *out);
+
+    /// whole-buffer variant of processSample: in/out point at frameCount contiguous
+    /// samples of one channel, so sp_* modules with block compute functions can be
+    /// fed entire buffers; default implementation is a processSample loop
+    virtual void processChannel(int channel, float *in, float *out, AUAudioFrameCount frameCount);
+
+    /// true-stereo variant of processChannel: both channel buffers are handed over
+    /// in one call so the module can share coefficient math between the two state
+    /// lanes; default implementation processes each channel independently
+    virtual void processStereoBlock(float *inLeft, float *inRight, float *outLeft,
+                                    float *outRight, AUAudioFrameCount frameCount);
+
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override;
+    void processBlock(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override;
 };
 
 #endif
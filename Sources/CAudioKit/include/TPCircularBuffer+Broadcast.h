@@ -0,0 +1,231 @@
+//
+//  TPCircularBuffer+Broadcast.h
+//  Circular/Ring buffer implementation
+//
+//  https://github.com/michaeltyson/TPCircularBuffer
+//
+//  Created by Michael Tyson, revision history on Githbub.
+//
+//
+//  Broadcast (single-producer, multi-consumer) variant of TPCircularBuffer.
+//
+//  One producer writes into a single mirrored allocation and up to
+//  TPBroadcastBufferMaxConsumers independent read cursors consume from it,
+//  each at its own pace. The data is never copied per consumer: every
+//  consumer reads the same virtual-memory-mirrored region, so fanning one
+//  audio tap out to several analyzers costs one write of each frame.
+//
+//  The buffer is thread-safe in the case of a single producer thread and one
+//  thread per consumer cursor. Register and unregister consumers from a
+//  single thread (typically during setup); the producer may be running while
+//  you do.
+//
+//  Note that the producer can only reuse space that every registered
+//  consumer has consumed, so a stalled consumer will eventually stall the
+//  producer. Unregister cursors you stop servicing.
+//
+//  Copyright (C) 2012-2013 A Tasty Pixel
+//
+//  This software is provided 'as-is', without any express or implied
+//  warranty.  In no event will the authors be held liable for any damages
+//  arising from the use of this software.
+//
+//  Permission is granted to anyone to use this software for any purpose,
+//  including commercial applications, and to alter it and redistribute it
+//  freely, subject to the following restrictions:
+//
+//  1. The origin of this software must not be misrepresented; you must not
+//     claim that you wrote the original software. If you use this software
+//     in a product, an acknowledgment in the product documentation would be
+//     appreciated but is not required.
+//
+//  2. Altered source versions must be plainly marked as such, and must not be
+//     misrepresented as being the original software.
+//
+//  3. This notice may not be removed or altered from any source distribution.
+//
+
+#pragma once
+
+#include "TPCircularBuffer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TPBroadcastBufferMaxConsumers 8
+
+typedef struct _TPBroadcastBufferConsumer {
+    int32_t           tail;
+    volatile atomicInt fillCount;
+    volatile atomicInt active;
+} TPBroadcastBufferConsumer;
+
+typedef struct _TPBroadcastBuffer {
+    void             *buffer;
+    int32_t           length;
+    int32_t           head;
+    volatile atomicInt sequence; /* odd while a produce is in progress */
+    volatile atomicInt consumerCount;
+    TPBroadcastBufferConsumer consumers[TPBroadcastBufferMaxConsumers];
+} TPBroadcastBuffer;
+
+/*!
+ * Initialise buffer
+ *
+ *  Note that the length is advisory only: Because of the way the
+ *  memory mirroring technique works, the true buffer length will
+ *  be multiples of the device page size (e.g. 4096 bytes)
+ *
+ * @param buffer Broadcast buffer
+ * @param length Length of buffer
+ */
+#define TPBroadcastBufferInit(buffer, length) \
+    _TPBroadcastBufferInit(buffer, length, sizeof(*buffer))
+bool _TPBroadcastBufferInit(TPBroadcastBuffer *buffer, int32_t length, size_t structSize);
+
+/*!
+ * Cleanup buffer
+ *
+ *  Releases buffer resources.
+ */
+void TPBroadcastBufferCleanup(TPBroadcastBuffer *buffer);
+
+/*!
+ * Register a read cursor
+ *
+ *  The new cursor starts at the producer's current write position, so it
+ *  sees only data produced after registration.
+ *
+ * @param buffer Broadcast buffer
+ * @return A consumer index to pass to the Tail/Consume routines, or -1 if
+ *         all TPBroadcastBufferMaxConsumers slots are taken
+ */
+int TPBroadcastBufferRegisterConsumer(TPBroadcastBuffer *buffer);
+
+/*!
+ * Unregister a read cursor
+ *
+ *  The cursor's unconsumed bytes no longer hold back the producer. The
+ *  index may be reused by a later registration.
+ *
+ * @param buffer   Broadcast buffer
+ * @param consumer Consumer index returned by TPBroadcastBufferRegisterConsumer
+ */
+void TPBroadcastBufferUnregisterConsumer(TPBroadcastBuffer *buffer, int consumer);
+
+/*!
+ * Clear buffer
+ *
+ *  Advances every registered cursor to the producer's write position.
+ */
+void TPBroadcastBufferClear(TPBroadcastBuffer *buffer);
+
+// Reading (consuming)
+
+/*!
+ * Access end of buffer for a consumer
+ *
+ *  This gives you a pointer to this cursor's next unread bytes, and the
+ *  number of bytes available to it. Other cursors are unaffected.
+ *
+ * @param buffer Broadcast buffer
+ * @param consumer Consumer index
+ * @param availableBytes On output, the number of bytes ready for reading
+ * @return Pointer to the first bytes ready for reading, or NULL if buffer is empty
+ */
+static __inline__ __attribute__((always_inline)) void *TPBroadcastBufferTail(TPBroadcastBuffer *buffer, int consumer, int32_t *availableBytes) {
+    *availableBytes = buffer->consumers[consumer].fillCount;
+    if ( *availableBytes == 0 ) return NULL;
+    return (void*)((char*)buffer->buffer + buffer->consumers[consumer].tail);
+}
+
+/*!
+ * Consume bytes for a consumer
+ *
+ *  This advances the given cursor only; the bytes become writable again
+ *  once every registered cursor has consumed them.
+ *
+ * @param buffer Broadcast buffer
+ * @param consumer Consumer index
+ * @param amount Number of bytes to consume
+ */
+static __inline__ __attribute__((always_inline)) void TPBroadcastBufferConsume(TPBroadcastBuffer *buffer, int consumer, int32_t amount) {
+    buffer->consumers[consumer].tail = (buffer->consumers[consumer].tail + amount) % buffer->length;
+    atomicFetchAdd(&buffer->consumers[consumer].fillCount, -amount);
+    assert(buffer->consumers[consumer].fillCount >= 0);
+}
+
+/*!
+ * Access front of buffer
+ *
+ *  This gives you a pointer to the front of the buffer, ready
+ *  for writing, and the number of available bytes to write. The space is
+ *  limited by the slowest registered cursor.
+ *
+ * @param buffer Broadcast buffer
+ * @param availableBytes On output, the number of bytes ready for writing
+ * @return Pointer to the first bytes ready for writing, or NULL if buffer is full
+ */
+static __inline__ __attribute__((always_inline)) void *TPBroadcastBufferHead(TPBroadcastBuffer *buffer, int32_t *availableBytes) {
+    int32_t maxFillCount = 0;
+    int consumerCount = buffer->consumerCount;
+    for ( int i = 0; i < consumerCount; i++ ) {
+        if ( !buffer->consumers[i].active ) continue;
+        int32_t fillCount = buffer->consumers[i].fillCount;
+        if ( fillCount > maxFillCount ) maxFillCount = fillCount;
+    }
+    *availableBytes = buffer->length - maxFillCount;
+    if ( *availableBytes == 0 ) return NULL;
+    return (void*)((char*)buffer->buffer + buffer->head);
+}
+
+// Writing (producing)
+
+/*!
+ * Produce bytes in buffer
+ *
+ *  This marks the given section of the buffer ready for reading by every
+ *  registered cursor.
+ *
+ * @param buffer Broadcast buffer
+ * @param amount Number of bytes to produce
+ */
+static __inline__ __attribute__((always_inline)) void TPBroadcastBufferProduce(TPBroadcastBuffer *buffer, int32_t amount) {
+    // The sequence is odd for the duration of the produce so a concurrent
+    // TPBroadcastBufferRegisterConsumer can tell whether head moved or fill
+    // counts were credited while it was seating a new cursor
+    atomicFetchAdd(&buffer->sequence, 1);
+    buffer->head = (buffer->head + amount) % buffer->length;
+    int consumerCount = buffer->consumerCount;
+    for ( int i = 0; i < consumerCount; i++ ) {
+        if ( !buffer->consumers[i].active ) continue;
+        atomicFetchAdd(&buffer->consumers[i].fillCount, amount);
+        assert(buffer->consumers[i].fillCount <= buffer->length);
+    }
+    atomicFetchAdd(&buffer->sequence, 1);
+}
+
+/*!
+ * Helper routine to copy bytes to buffer
+ *
+ *  This copies the given bytes to the buffer, and marks them ready for
+ *  reading by every registered cursor.
+ *
+ * @param buffer Broadcast buffer
+ * @param src Source buffer
+ * @param len Number of bytes in source buffer
+ * @return true if bytes copied, false if there was insufficient space
+ */
+static __inline__ __attribute__((always_inline)) bool TPBroadcastBufferProduceBytes(TPBroadcastBuffer *buffer, const void *src, int32_t len) {
+    int32_t space;
+    void *ptr = TPBroadcastBufferHead(buffer, &space);
+    if ( space < len ) return false;
+    memcpy(ptr, src, len);
+    TPBroadcastBufferProduce(buffer, len);
+    return true;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,85 @@
+//
+//  TPCircularBuffer+Frames.h
+//  Circular/Ring buffer implementation
+//
+//  Lean timestamped frame format for pushing audio across threads.
+//
+//  Unlike the AudioBufferList category, which stores a full AudioBufferList
+//  structure (headers plus 16-byte-aligned per-channel buffers) for every
+//  enqueued quantum, a frame block is one fixed 32-byte header followed by a
+//  planar-contiguous float payload: all of channel 0, then all of channel 1,
+//  and so on, with no per-channel pointers or padding between them. Enqueue
+//  is one header write and one memcpy per channel; dequeue walks blocks with
+//  fixed-size strides and can drain several queued quanta in a single call.
+//
+
+#ifdef __cplusplus
+extern "C++" {
+#endif
+
+#include "TPCircularBuffer.h"
+#include <AudioToolbox/AudioToolbox.h>
+
+typedef struct {
+    double   sampleTime;     //!< Sample time of the first unconsumed frame
+    uint64_t hostTime;       //!< Host time of the first enqueued frame, or 0
+    uint32_t totalLength;    //!< Whole block in bytes, 8-byte aligned
+    uint32_t frameCount;     //!< Frames in the payload
+    uint32_t channelCount;   //!< Planes in the payload
+    uint32_t consumedFrames; //!< Consumer-side progress within the block
+} TPCircularBufferFrameBlockHeader;
+
+/*!
+ * Enqueue a block of frames
+ *
+ *  Copies frameCount frames from the (non-interleaved float) buffer list
+ *  into one frame block. A caller batching several render quanta can simply
+ *  pass the concatenated audio as one larger block: the header cost is per
+ *  call, not per quantum.
+ *
+ * @param buffer      Circular buffer
+ * @param bufferList  Non-interleaved float source, one buffer per channel
+ * @param frameCount  Number of frames to copy from each channel
+ * @param timestamp   Timestamp of the first frame, or NULL
+ * @return true if the block was enqueued; false if there was insufficient space
+ */
+bool TPCircularBufferEnqueueFrames(TPCircularBuffer *buffer,
+                                   const AudioBufferList *bufferList,
+                                   UInt32 frameCount,
+                                   const AudioTimeStamp *timestamp);
+
+/*!
+ * Dequeue up to frameCount frames, possibly spanning several queued blocks
+ *
+ *  Copies into the (non-interleaved float) output buffer list and consumes
+ *  what it copied. Partially consumed blocks keep their place; their header
+ *  tracks the progress, so no data is moved. Channels beyond the output's
+ *  buffer count are dropped; output channels beyond a block's channel count
+ *  are left untouched.
+ *
+ * @param buffer            Circular buffer
+ * @param outputBufferList  Destination, or NULL to discard the audio
+ * @param frameCount        Maximum number of frames to dequeue
+ * @param outTimestamp      On output, if not NULL, the timestamp of the first
+ *                          returned frame (sample time advanced past anything
+ *                          previously consumed from the same block)
+ * @return The number of frames actually dequeued
+ */
+UInt32 TPCircularBufferDequeueFrames(TPCircularBuffer *buffer,
+                                     const AudioBufferList *outputBufferList,
+                                     UInt32 frameCount,
+                                     AudioTimeStamp *outTimestamp);
+
+/*!
+ * Number of queued frames
+ *
+ *  Note: This function should only be used on the consumer thread, not the producer thread.
+ *
+ * @param buffer Circular buffer
+ * @return Unconsumed frames summed across every queued block
+ */
+UInt32 TPCircularBufferQueuedFrameCount(TPCircularBuffer *buffer);
+
+#ifdef __cplusplus
+}
+#endif
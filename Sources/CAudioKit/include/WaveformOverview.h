@@ -0,0 +1,53 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "Interop.h"
+
+/// Multi-resolution waveform overview of an audio file: min/max/RMS bins at
+/// 256:1, 4096:1, and 65536:1 decimation, built in one streaming decode pass
+/// and persisted to a sidecar file. Reopening a session reads the sidecar
+/// instead of the audio; a file that has grown since the last scan (a live
+/// recording) is scanned only over the appended tail.
+
+#define AK_OVERVIEW_LEVELS 3
+
+/// One overview bin. Channels are folded together: min/max span every
+/// channel's samples in the bin (the drawn envelope is their union) and rms
+/// averages across channels.
+typedef struct WaveformOverviewBin {
+    float minValue;
+    float maxValue;
+    float rms;
+} WaveformOverviewBin;
+
+typedef struct WaveformOverviewData* WaveformOverviewRef;
+
+/// Frames per bin at `level` (256, 4096, 65536).
+AK_API uint32_t akWaveformOverviewDecimation(uint32_t level);
+
+/// Opens the overview for `audioPath`, backed by the sidecar at
+/// `overviewPath`. A valid up-to-date sidecar is loaded without touching the
+/// audio; otherwise the unscanned portion of the file is streamed once and
+/// the sidecar rewritten. Returns null if the audio file cannot be opened.
+AK_API WaveformOverviewRef akWaveformOverviewOpen(const char* audioPath,
+                                                  const char* overviewPath);
+AK_API void akWaveformOverviewClose(WaveformOverviewRef overview);
+
+/// Rescans whatever has been appended to the audio file since the last scan
+/// and rewrites the sidecar. A file that shrank is rescanned from the start.
+/// Returns false if the audio file could no longer be read.
+AK_API bool akWaveformOverviewUpdate(WaveformOverviewRef overview);
+
+AK_API uint64_t akWaveformOverviewFrameCount(WaveformOverviewRef overview);
+AK_API double akWaveformOverviewSampleRate(WaveformOverviewRef overview);
+AK_API uint32_t akWaveformOverviewChannelCount(WaveformOverviewRef overview);
+AK_API uint64_t akWaveformOverviewBinCount(WaveformOverviewRef overview, uint32_t level);
+
+/// Copies up to `binCount` bins starting at `firstBin` into `outBins`;
+/// returns the number copied.
+AK_API uint64_t akWaveformOverviewRead(WaveformOverviewRef overview, uint32_t level,
+                                       uint64_t firstBin, uint64_t binCount,
+                                       WaveformOverviewBin* outBins);
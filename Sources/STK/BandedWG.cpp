@@ -291,6 +291,34 @@ StkFloat BandedWG ::tick(unsigned int) {
   return lastFrame_[0];
 }
 
+void BandedWG ::tickBlockPlucked(StkFloat *samples, unsigned int nFrames,
+                                 unsigned int stride) {
+  StkFloat *out = samples;
+  unsigned int i;
+  for (i = 0; i < nFrames; i++, out += stride)
+    *out = 0.0;
+
+  // In struck operation the excitation input is zero, so the bands only
+  // couple through the output sum.  Accumulating band-by-band preserves the
+  // summation order of the per-sample loop exactly.
+  for (int k = 0; k < nModes_; k++) {
+    BiQuad &bandpass = bandpass_[k];
+    DelayL &delay = delay_[k];
+    StkFloat gain = gains_[k];
+    out = samples;
+    for (i = 0; i < nFrames; i++, out += stride) {
+      bandpass.tick(gain * delay.lastOut());
+      delay.tick(bandpass.lastOut());
+      *out += bandpass.lastOut();
+    }
+  }
+
+  out = samples;
+  for (i = 0; i < nFrames; i++, out += stride)
+    *out *= 4;
+  lastFrame_[0] = *(out - stride);
+}
+
 void BandedWG ::controlChange(int number, StkFloat value) {
 #if defined(_STK_DEBUG_)
   if (value < 0 || (number != 101 && value > 128.0)) {
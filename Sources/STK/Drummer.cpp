@@ -102,7 +102,9 @@ void Drummer ::noteOn(StkFloat instrument, StkFloat amplitude) {
     // std::cout << "iWave = " << iWave << ", nSounding = " << nSounding_ << ",
     // soundOrder[] = " << soundOrder_[iWave] << std::endl;
 
-    // Concatenate the STK rawwave path to the rawwave file
+    // Concatenate the STK rawwave path to the rawwave file.  The
+    // table comes from the RawWaveBank registry, so only the first
+    // note on a given drum sound reads its file from disk.
     waves_[iWave].openFile(
         (Stk::rawwavePath() + waveNames[genMIDIMap[noteNumber]]).c_str(), true);
     if (Stk::sampleRate() != 22050.0)
@@ -38,6 +38,10 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 
+#if defined(__APPLE__)
+#include <Accelerate/Accelerate.h>
+#endif
+
 namespace stk {
 
 FileRead::FileRead()
@@ -852,6 +856,108 @@ error:
   return false;
 }
 
+// The conversion helpers below widen packed file data to StkFloat in
+// place.  The packed values are read into the front of the destination
+// buffer, so each helper works backwards: the widened output for sample
+// \e i never touches the packed bytes of any sample < \e i.  On Apple
+// platforms the widening walks backwards in blocks through a small
+// staging array so the vectorized vDSP kernels never read source
+// samples that a previous (higher-addressed) block has overwritten.
+#if defined(__APPLE__)
+static const long FILEREAD_CONVERT_BLOCK = 2048;
+#endif
+
+// Widen 16-bit values packed at the front of \e buffer, scaling each
+// sample by \e gain.
+static void convertBlock16(StkFloat *buffer, long nSamples, StkFloat gain) {
+#if defined(__APPLE__)
+  SINT16 staging[FILEREAD_CONVERT_BLOCK];
+  long i = nSamples;
+  while (i > 0) {
+    long n = (i < FILEREAD_CONVERT_BLOCK) ? i : FILEREAD_CONVERT_BLOCK;
+    i -= n;
+    memcpy(staging, (SINT16 *)buffer + i, n * sizeof(SINT16));
+    vDSP_vflt16D(staging, 1, buffer + i, 1, (vDSP_Length)n);
+    if (gain != 1.0)
+      vDSP_vsmulD(buffer + i, 1, &gain, buffer + i, 1, (vDSP_Length)n);
+  }
+#else
+  SINT16 *buf = (SINT16 *)buffer;
+  for (long i = nSamples - 1; i >= 0; i--)
+    buffer[i] = buf[i] * gain;
+#endif
+}
+
+// Widen 32-bit values packed at the front of \e buffer, scaling each
+// sample by \e gain.
+static void convertBlock32(StkFloat *buffer, long nSamples, StkFloat gain) {
+#if defined(__APPLE__)
+  SINT32 staging[FILEREAD_CONVERT_BLOCK];
+  long i = nSamples;
+  while (i > 0) {
+    long n = (i < FILEREAD_CONVERT_BLOCK) ? i : FILEREAD_CONVERT_BLOCK;
+    i -= n;
+    memcpy(staging, (SINT32 *)buffer + i, n * sizeof(SINT32));
+    vDSP_vflt32D(staging, 1, buffer + i, 1, (vDSP_Length)n);
+    if (gain != 1.0)
+      vDSP_vsmulD(buffer + i, 1, &gain, buffer + i, 1, (vDSP_Length)n);
+  }
+#else
+  SINT32 *buf = (SINT32 *)buffer;
+  for (long i = nSamples - 1; i >= 0; i--)
+    buffer[i] = buf[i] * gain;
+#endif
+}
+
+// Widen 8-bit values packed at the front of \e buffer, scaling each
+// sample by \e gain and adding \e offset (used to re-center unsigned
+// 8-bit WAV data around zero).
+static void convertBlock8(StkFloat *buffer, long nSamples, bool isUnsigned,
+                          StkFloat gain, StkFloat offset) {
+#if defined(__APPLE__)
+  unsigned char staging[FILEREAD_CONVERT_BLOCK];
+  long i = nSamples;
+  while (i > 0) {
+    long n = (i < FILEREAD_CONVERT_BLOCK) ? i : FILEREAD_CONVERT_BLOCK;
+    i -= n;
+    memcpy(staging, (unsigned char *)buffer + i, n);
+    if (isUnsigned)
+      vDSP_vfltu8D(staging, 1, buffer + i, 1, (vDSP_Length)n);
+    else
+      vDSP_vflt8D((char *)staging, 1, buffer + i, 1, (vDSP_Length)n);
+    vDSP_vsmsaD(buffer + i, 1, &gain, &offset, buffer + i, 1, (vDSP_Length)n);
+  }
+#else
+  if (isUnsigned) {
+    unsigned char *buf = (unsigned char *)buffer;
+    for (long i = nSamples - 1; i >= 0; i--)
+      buffer[i] = buf[i] * gain + offset;
+  } else {
+    char *buf = (char *)buffer;
+    for (long i = nSamples - 1; i >= 0; i--)
+      buffer[i] = buf[i] * gain + offset;
+  }
+#endif
+}
+
+// Widen 32-bit floating-point values packed at the front of \e buffer.
+static void convertBlockFloat32(StkFloat *buffer, long nSamples) {
+#if defined(__APPLE__)
+  FLOAT32 staging[FILEREAD_CONVERT_BLOCK];
+  long i = nSamples;
+  while (i > 0) {
+    long n = (i < FILEREAD_CONVERT_BLOCK) ? i : FILEREAD_CONVERT_BLOCK;
+    i -= n;
+    memcpy(staging, (FLOAT32 *)buffer + i, n * sizeof(FLOAT32));
+    vDSP_vspdp(staging, 1, buffer + i, 1, (vDSP_Length)n);
+  }
+#else
+  FLOAT32 *buf = (FLOAT32 *)buffer;
+  for (long i = nSamples - 1; i >= 0; i--)
+    buffer[i] = buf[i];
+#endif
+}
+
 void FileRead::read(StkFrames &buffer, unsigned long startFrame,
                      bool doNormalize) {
   // Make sure we have an open file.
@@ -901,14 +1007,7 @@ void FileRead::read(StkFrames &buffer, unsigned long startFrame,
       for (i = nSamples - 1; i >= 0; i--)
         swap16((unsigned char *)ptr++);
     }
-    if (doNormalize) {
-      StkFloat gain = 1.0 / 32768.0;
-      for (i = nSamples - 1; i >= 0; i--)
-        buffer[i] = buf[i] * gain;
-    } else {
-      for (i = nSamples - 1; i >= 0; i--)
-        buffer[i] = buf[i];
-    }
+    convertBlock16(&buffer[0], nSamples, doNormalize ? 1.0 / 32768.0 : 1.0);
   } else if (dataType_ == STK_SINT32) {
     SINT32 *buf = (SINT32 *)&buffer[0];
     if (fseek(fd_, dataOffset_ + (offset * 4), SEEK_SET) == -1)
@@ -920,14 +1019,8 @@ void FileRead::read(StkFrames &buffer, unsigned long startFrame,
       for (i = nSamples - 1; i >= 0; i--)
         swap32((unsigned char *)ptr++);
     }
-    if (doNormalize) {
-      StkFloat gain = 1.0 / 2147483648.0;
-      for (i = nSamples - 1; i >= 0; i--)
-        buffer[i] = buf[i] * gain;
-    } else {
-      for (i = nSamples - 1; i >= 0; i--)
-        buffer[i] = buf[i];
-    }
+    convertBlock32(&buffer[0], nSamples,
+                   doNormalize ? 1.0 / 2147483648.0 : 1.0);
   } else if (dataType_ == STK_FLOAT32) {
     FLOAT32 *buf = (FLOAT32 *)&buffer[0];
     if (fseek(fd_, dataOffset_ + (offset * 4), SEEK_SET) == -1)
@@ -939,8 +1032,7 @@ void FileRead::read(StkFrames &buffer, unsigned long startFrame,
       for (i = nSamples - 1; i >= 0; i--)
         swap32((unsigned char *)ptr++);
     }
-    for (i = nSamples - 1; i >= 0; i--)
-      buffer[i] = buf[i];
+    convertBlockFloat32(&buffer[0], nSamples);
   } else if (dataType_ == STK_FLOAT64) {
     FLOAT64 *buf = (FLOAT64 *)&buffer[0];
     if (fseek(fd_, dataOffset_ + (offset * 8), SEEK_SET) == -1)
@@ -952,8 +1044,8 @@ void FileRead::read(StkFrames &buffer, unsigned long startFrame,
       for (i = nSamples - 1; i >= 0; i--)
         swap64((unsigned char *)ptr++);
     }
-    for (i = nSamples - 1; i >= 0; i--)
-      buffer[i] = buf[i];
+    // 64-bit data is already in the native StkFloat layout, so the
+    // samples land in place with the read above ... nothing to convert.
   } else if (dataType_ == STK_SINT8 &&
              wavFile_) { // 8-bit WAV data is unsigned!
     unsigned char *buf = (unsigned char *)&buffer[0];
@@ -961,68 +1053,49 @@ void FileRead::read(StkFrames &buffer, unsigned long startFrame,
       goto error;
     if (fread(buf, nSamples, 1, fd_) != 1)
       goto error;
-    if (doNormalize) {
-      StkFloat gain = 1.0 / 128.0;
-      for (i = nSamples - 1; i >= 0; i--)
-        buffer[i] = (buf[i] - 128) * gain;
-    } else {
-      for (i = nSamples - 1; i >= 0; i--)
-        buffer[i] = buf[i] - 128.0;
-    }
+    if (doNormalize)
+      convertBlock8(&buffer[0], nSamples, true, 1.0 / 128.0, -1.0);
+    else
+      convertBlock8(&buffer[0], nSamples, true, 1.0, -128.0);
   } else if (dataType_ == STK_SINT8) { // signed 8-bit data
     char *buf = (char *)&buffer[0];
     if (fseek(fd_, dataOffset_ + offset, SEEK_SET) == -1)
       goto error;
     if (fread(buf, nSamples, 1, fd_) != 1)
       goto error;
-    if (doNormalize) {
-      StkFloat gain = 1.0 / 128.0;
-      for (i = nSamples - 1; i >= 0; i--)
-        buffer[i] = buf[i] * gain;
-    } else {
-      for (i = nSamples - 1; i >= 0; i--)
-        buffer[i] = buf[i];
-    }
+    convertBlock8(&buffer[0], nSamples, false,
+                  doNormalize ? 1.0 / 128.0 : 1.0, 0.0);
   } else if (dataType_ == STK_SINT24) {
-    // 24-bit values are harder to import efficiently since there is
-    // no native 24-bit type.  The following routine works but is much
-    // less efficient than that used for the other data types.
-    SINT32 temp;
-    unsigned char *ptr = (unsigned char *)&temp;
-    StkFloat gain = 1.0 / 2147483648.0;
+    // 24-bit values have no native type, so the packed bytes are read
+    // in bulk and unpacked in place.  The loop walks backwards: the
+    // widened output for sample \e i never reaches the packed bytes of
+    // any earlier sample.
+    unsigned char *buf = (unsigned char *)&buffer[0];
+    StkFloat gain = doNormalize ? 1.0 / 2147483648.0 : 1.0 / 256;
     if (fseek(fd_, dataOffset_ + (offset * 3), SEEK_SET) == -1)
       goto error;
-    for (i = 0; i < nSamples; i++) {
+    if (fread(buf, nSamples * 3, 1, fd_) != 1)
+      goto error;
+    {
 #ifdef __LITTLE_ENDIAN__
-      if (byteswap_) {
-        if (fread(ptr, 3, 1, fd_) != 1)
-          goto error;
-        temp &= 0x00ffffff;
-        swap32((unsigned char *)ptr);
-      } else {
-        if (fread(ptr + 1, 3, 1, fd_) != 1)
-          goto error;
-        temp &= 0xffffff00;
-      }
+      bool bigEndianData = byteswap_;
 #else
-      if (byteswap_) {
-        if (fread(ptr + 1, 3, 1, fd_) != 1)
-          goto error;
-        temp &= 0xffffff00;
-        swap32((unsigned char *)ptr);
-      } else {
-        if (fread(ptr, 3, 1, fd_) != 1)
-          goto error;
-        temp &= 0x00ffffff;
-      }
+      bool bigEndianData = !byteswap_;
 #endif
-
-      if (doNormalize) {
-        buffer[i] =
-            (StkFloat)temp * gain; // "gain" also  includes 1 / 256 factor.
-      } else
-        buffer[i] =
-            (StkFloat)temp / 256; // right shift without affecting the sign bit
+      for (i = nSamples - 1; i >= 0; i--) {
+        unsigned char *ptr = buf + (i * 3);
+        SINT32 temp;
+        if (bigEndianData)
+          temp = (SINT32)(((UINT32)ptr[0] << 24) | ((UINT32)ptr[1] << 16) |
+                          ((UINT32)ptr[2] << 8));
+        else
+          temp = (SINT32)(((UINT32)ptr[2] << 24) | ((UINT32)ptr[1] << 16) |
+                          ((UINT32)ptr[0] << 8));
+        // the sample value sits in the top three bytes, so "gain" also
+        // includes a 1 / 256 factor (a right shift that preserves the
+        // sign bit)
+        buffer[i] = (StkFloat)temp * gain;
+      }
     }
   }
 
@@ -100,20 +100,55 @@ struct MatHeader {
   // There's more, but it's of variable length
 };
 
-FileWrite ::FileWrite() : fd_(0) {}
+FileWrite ::FileWrite()
+    : fd_(0), asynchronous_(false), ringFrames_(32768), ringHead_(0),
+      ringTail_(0), framesDropped_(0), writerRunning_(false),
+      writeError_(false) {}
 
 FileWrite::FileWrite(std::string fileName, unsigned int nChannels,
                      FILE_TYPE type, Stk::StkFormat format)
-    : fd_(0) {
+    : fd_(0), asynchronous_(false), ringFrames_(32768), ringHead_(0),
+      ringTail_(0), framesDropped_(0), writerRunning_(false),
+      writeError_(false) {
   this->open(fileName, nChannels, type, format);
 }
 
 FileWrite ::~FileWrite() { this->close(); }
 
+void FileWrite ::setAsynchronous(bool enabled, unsigned long ringFrames) {
+  if (fd_) {
+    oStream_ << "FileWrite::setAsynchronous: the mode cannot be changed while "
+                "a file is open!";
+    handleError(StkError::WARNING);
+    return;
+  }
+  asynchronous_ = enabled;
+  if (ringFrames > 0)
+    ringFrames_ = ringFrames;
+}
+
+StkFloat FileWrite ::ringOccupancy(void) const {
+  if (ring_.empty())
+    return 0.0;
+  unsigned long used = ringHead_.load(std::memory_order_relaxed) -
+                       ringTail_.load(std::memory_order_relaxed);
+  return (StkFloat)used / (StkFloat)ring_.size();
+}
+
 void FileWrite ::close(void) {
   if (fd_ == 0)
     return;
 
+  if (writerRunning_.load(std::memory_order_relaxed)) {
+    // The writer thread flushes whatever is still staged before exiting.
+    writerRunning_.store(false, std::memory_order_release);
+    writerThread_.join();
+    if (writeError_.load(std::memory_order_relaxed)) {
+      oStream_ << "FileWrite::close(): error writing data to file!";
+      handleError(StkError::WARNING);
+    }
+  }
+
   if (fileType_ == FILE_RAW)
     fclose(fd_);
   else if (fileType_ == FILE_WAV)
@@ -184,6 +219,22 @@ void FileWrite ::open(std::string fileName, unsigned int nChannels,
     handleError(StkError::FILE_ERROR);
 
   frameCounter_ = 0;
+
+  if (asynchronous_) {
+    // Round the staging ring up to a power of two so index wrapping is a
+    // mask rather than a division.
+    unsigned long samples = ringFrames_ * channels_;
+    unsigned long size = 1;
+    while (size < samples)
+      size <<= 1;
+    ring_.resize(size);
+    ringHead_.store(0, std::memory_order_relaxed);
+    ringTail_.store(0, std::memory_order_relaxed);
+    framesDropped_.store(0, std::memory_order_relaxed);
+    writeError_.store(false, std::memory_order_relaxed);
+    writerRunning_.store(true, std::memory_order_release);
+    writerThread_ = std::thread(&FileWrite::writerLoop, this);
+  }
 }
 
 bool FileWrite ::setRawFile(std::string fileName) {
@@ -774,82 +825,133 @@ void FileWrite ::write(StkFrames &buffer) {
   }
 
   unsigned long nSamples = buffer.size();
-  if (dataType_ == STK_SINT16) {
-    SINT16 sample;
-    for (unsigned long k = 0; k < nSamples; k++) {
-      sample = (SINT16)(buffer[k] * 32767.0);
-      // sample = ((SINT16) (( buffer[k] + 1.0 ) * 32767.5 + 0.5)) - 32768;
-      if (byteswap_)
-        swap16((unsigned char *)&sample);
-      if (fwrite(&sample, 2, 1, fd_) != 1)
-        goto error;
+
+  if (writerRunning_.load(std::memory_order_relaxed)) {
+    unsigned long head = ringHead_.load(std::memory_order_relaxed);
+    unsigned long tail = ringTail_.load(std::memory_order_acquire);
+    if ((unsigned long)ring_.size() - (head - tail) < nSamples) {
+      // Backpressure: never block the caller, drop the buffer and report.
+      framesDropped_ += buffer.frames();
+      return;
     }
+    unsigned long index = head & (ring_.size() - 1);
+    unsigned long contiguous = (unsigned long)ring_.size() - index;
+    if (contiguous > nSamples)
+      contiguous = nSamples;
+    memcpy(&ring_[index], &buffer[0], contiguous * sizeof(StkFloat));
+    if (contiguous < nSamples)
+      memcpy(&ring_[0], &buffer[contiguous],
+             (nSamples - contiguous) * sizeof(StkFloat));
+    ringHead_.store(head + nSamples, std::memory_order_release);
+    frameCounter_ += buffer.frames();
+    return;
+  }
+
+  if (!this->writeSamples(&buffer[0], nSamples)) {
+    oStream_ << "FileWrite::write(): error writing data to file!";
+    handleError(StkError::FILE_ERROR);
+    return;
+  }
+
+  frameCounter_ += buffer.frames();
+}
+
+bool FileWrite ::writeSamples(const StkFloat *samples, unsigned long nSamples) {
+  unsigned long bytesPerSample = 2;
+  if (dataType_ == STK_SINT8)
+    bytesPerSample = 1;
+  else if (dataType_ == STK_SINT24)
+    bytesPerSample = 3;
+  else if (dataType_ == STK_SINT32 || dataType_ == STK_FLOAT32)
+    bytesPerSample = 4;
+  else if (dataType_ == STK_FLOAT64)
+    bytesPerSample = 8;
+
+  unsigned long nBytes = nSamples * bytesPerSample;
+  if (packed_.size() < nBytes)
+    packed_.resize(nBytes);
+  unsigned char *packed = &packed_[0];
+
+  // Convert the whole buffer in one pass, then issue a single large
+  // fwrite(); the branch-free conversion loops auto-vectorize.
+  if (dataType_ == STK_SINT16) {
+    SINT16 *out = (SINT16 *)packed;
+    for (unsigned long k = 0; k < nSamples; k++)
+      out[k] = (SINT16)(samples[k] * 32767.0);
+    if (byteswap_)
+      for (unsigned long k = 0; k < nSamples; k++)
+        swap16((unsigned char *)&out[k]);
   } else if (dataType_ == STK_SINT8) {
     if (fileType_ == FILE_WAV) { // 8-bit WAV data is unsigned!
-      unsigned char sample;
-      for (unsigned long k = 0; k < nSamples; k++) {
-        sample = (unsigned char)(buffer[k] * 127.0 + 128.0);
-        if (fwrite(&sample, 1, 1, fd_) != 1)
-          goto error;
-      }
+      for (unsigned long k = 0; k < nSamples; k++)
+        packed[k] = (unsigned char)(samples[k] * 127.0 + 128.0);
     } else {
-      signed char sample;
-      for (unsigned long k = 0; k < nSamples; k++) {
-        sample = (signed char)(buffer[k] * 127.0);
-        // sample = ((signed char) (( buffer[k] + 1.0 ) * 127.5 + 0.5)) - 128;
-        if (fwrite(&sample, 1, 1, fd_) != 1)
-          goto error;
-      }
+      signed char *out = (signed char *)packed;
+      for (unsigned long k = 0; k < nSamples; k++)
+        out[k] = (signed char)(samples[k] * 127.0);
     }
   } else if (dataType_ == STK_SINT32) {
-    SINT32 sample;
-    for (unsigned long k = 0; k < nSamples; k++) {
-      sample = (SINT32)(buffer[k] * 2147483647.0);
-      // sample = ((SINT32) (( buffer[k] + 1.0 ) * 2147483647.5 + 0.5)) -
-      // 2147483648;
-      if (byteswap_)
-        swap32((unsigned char *)&sample);
-      if (fwrite(&sample, 4, 1, fd_) != 1)
-        goto error;
-    }
+    SINT32 *out = (SINT32 *)packed;
+    for (unsigned long k = 0; k < nSamples; k++)
+      out[k] = (SINT32)(samples[k] * 2147483647.0);
+    if (byteswap_)
+      for (unsigned long k = 0; k < nSamples; k++)
+        swap32((unsigned char *)&out[k]);
   } else if (dataType_ == STK_FLOAT32) {
-    FLOAT32 sample;
-    for (unsigned long k = 0; k < nSamples; k++) {
-      sample = (FLOAT32)(buffer[k]);
-      if (byteswap_)
-        swap32((unsigned char *)&sample);
-      if (fwrite(&sample, 4, 1, fd_) != 1)
-        goto error;
-    }
+    FLOAT32 *out = (FLOAT32 *)packed;
+    for (unsigned long k = 0; k < nSamples; k++)
+      out[k] = (FLOAT32)(samples[k]);
+    if (byteswap_)
+      for (unsigned long k = 0; k < nSamples; k++)
+        swap32((unsigned char *)&out[k]);
   } else if (dataType_ == STK_FLOAT64) {
-    FLOAT64 sample;
-    for (unsigned long k = 0; k < nSamples; k++) {
-      sample = (FLOAT64)(buffer[k]);
-      if (byteswap_)
-        swap64((unsigned char *)&sample);
-      if (fwrite(&sample, 8, 1, fd_) != 1)
-        goto error;
-    }
+    FLOAT64 *out = (FLOAT64 *)packed;
+    for (unsigned long k = 0; k < nSamples; k++)
+      out[k] = (FLOAT64)(samples[k]);
+    if (byteswap_)
+      for (unsigned long k = 0; k < nSamples; k++)
+        swap64((unsigned char *)&out[k]);
   } else if (dataType_ == STK_SINT24) {
-    SINT32 sample;
+    unsigned char *out = packed;
     for (unsigned long k = 0; k < nSamples; k++) {
-      sample = (SINT32)(buffer[k] * 8388607.0);
+      SINT32 sample = (SINT32)(samples[k] * 8388607.0);
       if (byteswap_) {
         swap32((unsigned char *)&sample);
-        unsigned char *ptr = (unsigned char *)&sample;
-        if (fwrite(ptr + 1, 3, 1, fd_) != 1)
-          goto error;
-      } else if (fwrite(&sample, 3, 1, fd_) != 1)
-        goto error;
+        memcpy(out, (unsigned char *)&sample + 1, 3);
+      } else
+        memcpy(out, &sample, 3);
+      out += 3;
     }
   }
 
-  frameCounter_ += buffer.frames();
-  return;
+  return fwrite(packed, 1, nBytes, fd_) == nBytes;
+}
 
-error:
-  oStream_ << "FileWrite::write(): error writing data to file!";
-  handleError(StkError::FILE_ERROR);
+unsigned long FileWrite ::drainRing(void) {
+  unsigned long mask = (unsigned long)ring_.size() - 1;
+  unsigned long tail = ringTail_.load(std::memory_order_relaxed);
+  unsigned long head = ringHead_.load(std::memory_order_acquire);
+  unsigned long drained = 0;
+  while (tail != head) {
+    unsigned long index = tail & mask;
+    unsigned long contiguous = (unsigned long)ring_.size() - index;
+    if (contiguous > head - tail)
+      contiguous = head - tail;
+    if (!this->writeSamples(&ring_[index], contiguous))
+      writeError_.store(true, std::memory_order_relaxed);
+    tail += contiguous;
+    ringTail_.store(tail, std::memory_order_release);
+    drained += contiguous;
+  }
+  return drained;
+}
+
+void FileWrite ::writerLoop(void) {
+  while (writerRunning_.load(std::memory_order_acquire)) {
+    if (this->drainRing() == 0)
+      Stk::sleep(1);
+  }
+  this->drainRing(); // flush whatever arrived before the stop signal
 }
 
 } // namespace stk
@@ -38,19 +38,33 @@ namespace stk {
 
 FileWvIn::FileWvIn(unsigned long chunkThreshold, unsigned long chunkSize)
     : finished_(true), interpolate_(false), time_(0.0), rate_(0.0),
-      chunkThreshold_(chunkThreshold), chunkSize_(chunkSize) {
+      chunkThreshold_(chunkThreshold), chunkSize_(chunkSize),
+      prefetchPointer_(0), prefetching_(false), prefetchState_(kPrefetchIdle),
+      prefetchShutdown_(false), raw_(false) {
   Stk::addSampleRateAlert(this);
 }
 
 FileWvIn::FileWvIn(std::string fileName, bool raw, bool doNormalize,
                     unsigned long chunkThreshold, unsigned long chunkSize)
     : finished_(true), interpolate_(false), time_(0.0), rate_(0.0),
-      chunkThreshold_(chunkThreshold), chunkSize_(chunkSize) {
+      chunkThreshold_(chunkThreshold), chunkSize_(chunkSize),
+      prefetchPointer_(0), prefetching_(false), prefetchState_(kPrefetchIdle),
+      prefetchShutdown_(false), raw_(false) {
   openFile(fileName, raw, doNormalize);
   Stk::addSampleRateAlert(this);
 }
 
 FileWvIn::~FileWvIn() {
+  if (prefetchThread_.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(prefetchMutex_);
+      prefetchShutdown_ = true;
+    }
+    prefetchCondition_.notify_one();
+    prefetchThread_.join();
+    // a request the worker never served must not stall closeFile's wait
+    prefetchState_.store(kPrefetchIdle, std::memory_order_relaxed);
+  }
   this->closeFile();
   Stk::removeSampleRateAlert(this);
 }
@@ -61,6 +75,13 @@ void FileWvIn::sampleRateChanged(StkFloat newRate, StkFloat oldRate) {
 }
 
 void FileWvIn::closeFile() {
+  // Let an in-flight prefetch finish before closing its file handle.
+  while (prefetchState_.load(std::memory_order_acquire) == kPrefetchRequested ||
+         prefetchState_.load(std::memory_order_acquire) == kPrefetchLoading)
+    std::this_thread::yield();
+  prefetchState_.store(kPrefetchIdle, std::memory_order_relaxed);
+  if (prefetchFile_.isOpen())
+    prefetchFile_.close();
   if (file_.isOpen())
     file_.close();
   finished_ = true;
@@ -73,6 +94,8 @@ void FileWvIn::openFile(std::string fileName, bool raw, bool doNormalize) {
 
   // Attempt to open the file ... an error might be thrown here.
   file_.open(fileName, raw);
+  fileName_ = fileName;
+  raw_ = raw;
 
   // Determine whether chunking or not.
   if (file_.fileSize() > chunkThreshold_) {
@@ -105,9 +128,80 @@ void FileWvIn::openFile(std::string fileName, bool raw, bool doNormalize) {
   if (doNormalize & !chunking_)
     this->normalize();
 
+  // Warm the prefetch buffer so the first chunk boundary is already covered.
+  if (chunking_ && prefetching_) {
+    prefetchFile_.open(fileName_, raw_);
+    prefetchData_.resize(chunkSize_, file_.channels());
+    this->schedulePrefetch();
+  }
+
   this->reset();
 }
 
+void FileWvIn::setPrefetching(bool doPrefetch) {
+  if (doPrefetch && !prefetching_) {
+    prefetching_ = true;
+    if (!prefetchThread_.joinable())
+      prefetchThread_ = std::thread(&FileWvIn::prefetchLoop, this);
+    if (chunking_ && file_.isOpen()) {
+      if (!prefetchFile_.isOpen())
+        prefetchFile_.open(fileName_, raw_);
+      prefetchData_.resize(chunkSize_, file_.channels());
+      this->schedulePrefetch();
+    }
+  } else if (!doPrefetch) {
+    // An in-flight load simply completes and is ignored at the next
+    // boundary; the worker stays parked until re-enabled or destroyed.
+    prefetching_ = false;
+  }
+}
+
+void FileWvIn::schedulePrefetch(void) {
+  if (!prefetching_)
+    return;
+
+  // Never overwrite a request the worker may be reading.
+  int state = prefetchState_.load(std::memory_order_relaxed);
+  if (state == kPrefetchRequested || state == kPrefetchLoading)
+    return;
+
+  // Next chunk in the direction of the read rate, overlapped by one
+  // frame and clamped to the file, exactly as the synchronous path does.
+  long pointer;
+  if (rate_ < 0)
+    pointer = chunkPointer_ - (long)(chunkSize_ - 1);
+  else
+    pointer = chunkPointer_ + (long)(chunkSize_ - 1);
+  if (pointer < 0)
+    pointer = 0;
+  if (pointer + (long)chunkSize_ > (long)fileSize_)
+    pointer = fileSize_ - chunkSize_;
+  if (pointer == chunkPointer_)
+    return;
+
+  prefetchPointer_ = pointer;
+  prefetchState_.store(kPrefetchRequested, std::memory_order_release);
+  prefetchCondition_.notify_one();
+}
+
+void FileWvIn::prefetchLoop(void) {
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(prefetchMutex_);
+      prefetchCondition_.wait(lock, [this] {
+        return prefetchShutdown_ ||
+               prefetchState_.load(std::memory_order_acquire) ==
+                   kPrefetchRequested;
+      });
+      if (prefetchShutdown_)
+        return;
+    }
+    prefetchState_.store(kPrefetchLoading, std::memory_order_relaxed);
+    prefetchFile_.read(prefetchData_, prefetchPointer_, normalizing_);
+    prefetchState_.store(kPrefetchReady, std::memory_order_release);
+  }
+}
+
 void FileWvIn::reset() {
   time_ = (StkFloat)0.0;
   for (unsigned int i = 0; i < lastFrame_.size(); i++)
@@ -205,8 +299,22 @@ StkFloat FileWvIn::tick(unsigned int channel) {
           chunkPointer_ = fileSize_ - chunkSize_;
       }
 
-      // Load more data.
-      file_.read(data_, chunkPointer_, normalizing_);
+      // Use the prefetched chunk if the background thread has it ready;
+      // otherwise fall back to a synchronous read.
+      bool loaded = false;
+      if (prefetching_ &&
+          prefetchState_.load(std::memory_order_acquire) == kPrefetchReady) {
+        if (prefetchPointer_ == chunkPointer_) {
+          data_.swap(prefetchData_);
+          loaded = true;
+        }
+        prefetchState_.store(kPrefetchIdle, std::memory_order_relaxed);
+      }
+      if (!loaded)
+        file_.read(data_, chunkPointer_, normalizing_);
+
+      // Start loading the chunk after this one.
+      this->schedulePrefetch();
     }
 
     // Adjust index for the current buffer.
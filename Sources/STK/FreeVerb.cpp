@@ -15,9 +15,17 @@
 /***********************************************************************/
 
 #include "FreeVerb.h"
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
+#if defined(__APPLE__)
+#include <Accelerate/Accelerate.h>
+#endif
+
+// Frames rendered per inner pass of the block tick() variants.
+#define FREEVERB_BLOCK 256
+
 using namespace stk;
 
 // Set static delay line lengths
@@ -62,21 +70,26 @@ FreeVerb::FreeVerb(void) {
     }
   }
 
-  // Initialize delay lines for the LBFC filters
-  for (int i = 0; i < nCombs; i++) {
-    combDelayL_[i].setMaximumDelay(cDelayLengths[i]);
-    combDelayL_[i].setDelay(cDelayLengths[i]);
-    combDelayR_[i].setMaximumDelay(cDelayLengths[i] + stereoSpread);
-    combDelayR_[i].setDelay(cDelayLengths[i] + stereoSpread);
-  }
-
-  // initialize delay lines for the allpass filters
-  for (int i = 0; i < nAllpasses; i++) {
-    allPassDelayL_[i].setMaximumDelay(aDelayLengths[i]);
-    allPassDelayL_[i].setDelay(aDelayLengths[i]);
-    allPassDelayR_[i].setMaximumDelay(aDelayLengths[i] + stereoSpread);
-    allPassDelayR_[i].setDelay(aDelayLengths[i] + stereoSpread);
+  // Lay out all delay lines in one contiguous arena, per channel:
+  // the eight comb lines then the four allpass lines.
+  unsigned long offset = 0;
+  for (int c = 0; c < 2; c++) {
+    int spread = (c == 0) ? 0 : stereoSpread;
+    for (int i = 0; i < nCombs; i++) {
+      combOffset_[c][i] = offset;
+      combLength_[c][i] = (unsigned long)(cDelayLengths[i] + spread);
+      combPos_[c][i] = 0;
+      combLPState_[c][i] = 0.0;
+      offset += combLength_[c][i];
+    }
+    for (int i = 0; i < nAllpasses; i++) {
+      allPassOffset_[c][i] = offset;
+      allPassLength_[c][i] = (unsigned long)(aDelayLengths[i] + spread);
+      allPassPos_[c][i] = 0;
+      offset += allPassLength_[c][i];
+    }
   }
+  arena_.assign(offset, 0.0);
 }
 
 FreeVerb::~FreeVerb() {}
@@ -139,25 +152,16 @@ void FreeVerb::update() {
     gain_ = fixedGain;
   }
 
-  for (int i = 0; i < nCombs; i++) {
-    // set low pass filter for delay output
-    combLPL_[i].setCoefficients(1.0 - damp_, -damp_);
-    combLPR_[i].setCoefficients(1.0 - damp_, -damp_);
-  }
+  // damp_ is applied directly as the one-pole damping coefficient in
+  // the comb loops: y[n] = (1 - damp_) x[n] + damp_ y[n-1].
 }
 
 void FreeVerb::clear() {
-  // Clear LBFC delay lines
-  for (int i = 0; i < nCombs; i++) {
-    combDelayL_[i].clear();
-    combDelayR_[i].clear();
-  }
-
-  // Clear allpass delay lines
-  for (int i = 0; i < nAllpasses; i++) {
-    allPassDelayL_[i].clear();
-    allPassDelayR_[i].clear();
-  }
+  // Clear all delay lines and damping filter state.
+  std::fill(arena_.begin(), arena_.end(), 0.0);
+  for (int c = 0; c < 2; c++)
+    for (int i = 0; i < nCombs; i++)
+      combLPState_[c][i] = 0.0;
 
   lastFrame_[0] = 0.0;
   lastFrame_[1] = 0.0;
@@ -174,10 +178,8 @@ StkFrames &FreeVerb::tick(StkFrames &frames, unsigned int channel) {
 
   StkFloat *samples = &frames[channel];
   unsigned int hop = frames.channels();
-  for (unsigned int i = 0; i < frames.frames(); i++, samples += hop) {
-    *samples = tick(*samples, *(samples + 1));
-    *(samples + 1) = lastFrame_[1];
-  }
+  this->processBlock(samples, samples + 1, hop, samples, samples + 1, hop,
+                     frames.frames());
 
   return frames;
 }
@@ -197,15 +199,98 @@ StkFrames &FreeVerb::tick(StkFrames &iFrames, StkFrames &oFrames,
   unsigned int iHop = iFrames.channels();
   unsigned int oHop = oFrames.channels();
   bool stereoInput = (iFrames.channels() > iChannel + 1) ? true : false;
-  for (unsigned int i = 0; i < iFrames.frames();
-       i++, iSamples += iHop, oSamples += oHop) {
-    if (stereoInput)
-      *oSamples = tick(*iSamples, *(iSamples + 1));
-    else
-      *oSamples = tick(*iSamples);
-
-    *(oSamples + 1) = lastFrame_[1];
-  }
+  this->processBlock(iSamples, stereoInput ? iSamples + 1 : NULL, iHop,
+                     oSamples, oSamples + 1, oHop, iFrames.frames());
 
   return oFrames;
 }
+
+void FreeVerb::processBlock(const StkFloat *inL, const StkFloat *inR,
+                            unsigned int inHop, StkFloat *outL, StkFloat *outR,
+                            unsigned int outHop, unsigned int nFrames) {
+  // The comb and allpass recursions cannot be vectorized along time,
+  // so each filter instead runs over the whole block in turn: its
+  // delay line streams sequentially through the arena and its state
+  // stays in registers.  The input scaling and output mixing stages
+  // have no feedback and are vectorized where available.
+  StkFloat dryL[FREEVERB_BLOCK], dryR[FREEVERB_BLOCK];
+  StkFloat fIn[FREEVERB_BLOCK];
+  StkFloat acc[2][FREEVERB_BLOCK];
+
+  unsigned int frame = 0;
+  while (frame < nFrames) {
+    unsigned int n = nFrames - frame;
+    if (n > FREEVERB_BLOCK)
+      n = FREEVERB_BLOCK;
+
+    // Gather the (possibly strided, possibly in-place) inputs so the
+    // dry signal survives the output writes below.
+    for (unsigned int k = 0; k < n; k++) {
+      dryL[k] = inL[(frame + k) * inHop];
+      dryR[k] = inR ? inR[(frame + k) * inHop] : 0.0;
+    }
+
+#if defined(__APPLE__)
+    vDSP_vaddD(dryL, 1, dryR, 1, fIn, 1, (vDSP_Length)n);
+    vDSP_vsmulD(fIn, 1, &gain_, fIn, 1, (vDSP_Length)n);
+#else
+    for (unsigned int k = 0; k < n; k++)
+      fIn[k] = (dryL[k] + dryR[k]) * gain_;
+#endif
+
+    for (int c = 0; c < 2; c++) {
+      for (unsigned int k = 0; k < n; k++)
+        acc[c][k] = 0.0;
+
+      // Parallel LBCF filters
+      for (int i = 0; i < nCombs; i++) {
+        StkFloat *line = &arena_[combOffset_[c][i]];
+        unsigned long pos = combPos_[c][i];
+        unsigned long length = combLength_[c][i];
+        StkFloat lp = combLPState_[c][i];
+        StkFloat b0 = 1.0 - damp_;
+        for (unsigned int k = 0; k < n; k++) {
+          lp = b0 * line[pos] + damp_ * lp;
+          StkFloat yn = fIn[k] + (roomSize_ * lp);
+          line[pos] = yn;
+          if (++pos == length)
+            pos = 0;
+          acc[c][k] += yn;
+        }
+        combPos_[c][i] = pos;
+        combLPState_[c][i] = lp;
+      }
+
+      // Series allpass filters
+      for (int i = 0; i < nAllpasses; i++) {
+        StkFloat *line = &arena_[allPassOffset_[c][i]];
+        unsigned long pos = allPassPos_[c][i];
+        unsigned long length = allPassLength_[c][i];
+        for (unsigned int k = 0; k < n; k++) {
+          StkFloat vn_m = line[pos];
+          StkFloat vn = acc[c][k] + (g_ * vn_m);
+          line[pos] = vn;
+          if (++pos == length)
+            pos = 0;
+          acc[c][k] = -vn + (1.0 + g_) * vn_m;
+        }
+        allPassPos_[c][i] = pos;
+      }
+    }
+
+    // Mix output
+    for (unsigned int k = 0; k < n; k++) {
+      outL[(frame + k) * outHop] =
+          acc[0][k] * wet1_ + acc[1][k] * wet2_ + dryL[k] * dry_;
+      outR[(frame + k) * outHop] =
+          acc[1][k] * wet1_ + acc[0][k] * wet2_ + dryR[k] * dry_;
+    }
+
+    frame += n;
+  }
+
+  if (nFrames > 0) {
+    lastFrame_[0] = outL[(nFrames - 1) * outHop];
+    lastFrame_[1] = outR[(nFrames - 1) * outHop];
+  }
+}
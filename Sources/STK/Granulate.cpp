@@ -27,6 +27,9 @@ Granulate ::Granulate(void) {
   gStretch_ = 0;
   stretchCounter_ = 0;
   gain_ = 1.0;
+  maxActiveGrains_ = 0;
+  activeGrains_ = 0;
+  randomIndex_ = 0;
 }
 
 Granulate ::Granulate(unsigned int nVoices, std::string fileName,
@@ -35,6 +38,9 @@ Granulate ::Granulate(unsigned int nVoices, std::string fileName,
   this->setRandomFactor();
   gStretch_ = 0;
   stretchCounter_ = 0;
+  maxActiveGrains_ = 0;
+  activeGrains_ = 0;
+  randomIndex_ = 0;
   this->openFile(fileName, typeRaw);
   this->setVoices(nVoices);
 }
@@ -111,6 +117,7 @@ void Granulate ::reset(void) {
     grains_[i].counter = count;
     grains_[i].state = GRAIN_STOPPED;
   }
+  activeGrains_ = 0;
 
   for (unsigned int i = 0; i < lastFrame_.channels(); i++)
     lastFrame_[i] = 0.0;
@@ -137,9 +144,19 @@ void Granulate ::setVoices(unsigned int nVoices) {
     grains_[i].state = GRAIN_STOPPED;
   }
 
+  // Voices dropped by a shrinking resize may have been active.
+  activeGrains_ = 0;
+  for (size_t i = 0; i < grains_.size(); i++)
+    if (grains_[i].state > GRAIN_STOPPED)
+      activeGrains_++;
+
   gain_ = 1.0 / grains_.size();
 }
 
+void Granulate ::setMaxActiveGrains(unsigned int maxGrains) {
+  maxActiveGrains_ = maxGrains;
+}
+
 void Granulate ::calculateGrain(Granulate::Grain &grain) {
   if (grain.repeats > 0) {
     grain.repeats--;
@@ -158,7 +175,7 @@ void Granulate ::calculateGrain(Granulate::Grain &grain) {
 
   // Calculate duration and envelope parameters.
   StkFloat seconds = gDuration_ * 0.001;
-  seconds += (seconds * gRandomFactor_ * noise.tick());
+  seconds += (seconds * gRandomFactor_ * this->nextRandomValue());
   unsigned long count = (unsigned long)(seconds * Stk::sampleRate());
   grain.attackCount = (unsigned int)(gRampPercent_ * 0.005 * count);
   grain.decayCount = grain.attackCount;
@@ -175,7 +192,7 @@ void Granulate ::calculateGrain(Granulate::Grain &grain) {
 
   // Calculate delay parameter.
   seconds = gDelay_ * 0.001;
-  seconds += (seconds * gRandomFactor_ * noise.tick());
+  seconds += (seconds * gRandomFactor_ * this->nextRandomValue());
   count = (unsigned long)(seconds * Stk::sampleRate());
   grain.delayCount = count;
 
@@ -184,11 +201,11 @@ void Granulate ::calculateGrain(Granulate::Grain &grain) {
 
   // Calculate offset parameter.
   seconds = gOffset_ * 0.001;
-  seconds += (seconds * gRandomFactor_ * std::abs(noise.tick()));
+  seconds += (seconds * gRandomFactor_ * std::abs(this->nextRandomValue()));
   int offset = (int)(seconds * Stk::sampleRate());
 
   // Add some randomization to the pointer start position.
-  seconds = gDuration_ * 0.001 * gRandomFactor_ * noise.tick();
+  seconds = gDuration_ * 0.001 * gRandomFactor_ * this->nextRandomValue();
   offset += (int)(seconds * Stk::sampleRate());
   grain.pointer += offset;
   while (grain.pointer >= data_.frames())
@@ -198,6 +215,80 @@ void Granulate ::calculateGrain(Granulate::Grain &grain) {
   grain.startPointer = grain.pointer;
 }
 
+StkFloat Granulate ::nextRandomValue(void) {
+  if (randomIndex_ < randomValues_.size())
+    return randomValues_[randomIndex_++];
+  return noise.tick();
+}
+
+void Granulate ::startGrain(Granulate::Grain &grain) {
+  if (maxActiveGrains_ > 0 && activeGrains_ >= maxActiveGrains_) {
+    // The budget is spent: push the sustaining grain nearest its decay
+    // into fadeout and try this grain again once that slot frees up.
+    // If every active grain is already ramping, just retry shortly.
+    Grain *victim = 0;
+    for (size_t i = 0; i < grains_.size(); i++) {
+      if (grains_[i].state != GRAIN_SUSTAIN)
+        continue;
+      if (victim == 0 || grains_[i].counter < victim->counter)
+        victim = &grains_[i];
+    }
+    if (victim) {
+      victim->counter = victim->decayCount;
+      victim->eRate = -victim->eRate;
+      victim->state = GRAIN_FADEOUT;
+      grain.counter = victim->decayCount + 1;
+    } else
+      grain.counter = (unsigned long)(0.001 * Stk::sampleRate()) + 1;
+    return; // remain GRAIN_STOPPED until the retry
+  }
+
+  this->calculateGrain(grain);
+  activeGrains_++;
+}
+
+void Granulate ::advanceGrainState(Granulate::Grain &grain) {
+  switch (grain.state) {
+
+  case GRAIN_STOPPED:
+    // We're done waiting between grains ... setup for new grain
+    this->startGrain(grain);
+    break;
+
+  case GRAIN_FADEIN:
+    // We're done ramping up the envelope
+    if (grain.sustainCount > 0) {
+      grain.counter = grain.sustainCount;
+      grain.state = GRAIN_SUSTAIN;
+      break;
+    }
+  // else no sustain state (i.e. perfect triangle window)
+
+  case GRAIN_SUSTAIN:
+    // We're done with flat part of envelope ... setup to ramp down
+    if (grain.decayCount > 0) {
+      grain.counter = grain.decayCount;
+      grain.eRate = -grain.eRate;
+      grain.state = GRAIN_FADEOUT;
+      break;
+    }
+  // else no fade out state (gRampPercent = 0)
+
+  case GRAIN_FADEOUT:
+    // We're done ramping down ... setup for wait between grains
+    if (grain.delayCount > 0) {
+      grain.counter = grain.delayCount;
+      grain.state = GRAIN_STOPPED;
+      if (activeGrains_ > 0)
+        activeGrains_--;
+      break;
+    }
+    // else no delay (gDelay = 0)
+
+    this->calculateGrain(grain);
+  }
+}
+
 StkFloat Granulate ::tick(unsigned int channel) {
 #if defined(_STK_DEBUG_)
   if (channel >= data_.channels()) {
@@ -217,46 +308,8 @@ StkFloat Granulate ::tick(unsigned int channel) {
   StkFloat sample;
   for (i = 0; i < grains_.size(); i++) {
 
-    if (grains_[i].counter == 0) { // Update the grain state.
-
-      switch (grains_[i].state) {
-
-      case GRAIN_STOPPED:
-        // We're done waiting between grains ... setup for new grain
-        this->calculateGrain(grains_[i]);
-        break;
-
-      case GRAIN_FADEIN:
-        // We're done ramping up the envelope
-        if (grains_[i].sustainCount > 0) {
-          grains_[i].counter = grains_[i].sustainCount;
-          grains_[i].state = GRAIN_SUSTAIN;
-          break;
-        }
-      // else no sustain state (i.e. perfect triangle window)
-
-      case GRAIN_SUSTAIN:
-        // We're done with flat part of envelope ... setup to ramp down
-        if (grains_[i].decayCount > 0) {
-          grains_[i].counter = grains_[i].decayCount;
-          grains_[i].eRate = -grains_[i].eRate;
-          grains_[i].state = GRAIN_FADEOUT;
-          break;
-        }
-      // else no fade out state (gRampPercent = 0)
-
-      case GRAIN_FADEOUT:
-        // We're done ramping down ... setup for wait between grains
-        if (grains_[i].delayCount > 0) {
-          grains_[i].counter = grains_[i].delayCount;
-          grains_[i].state = GRAIN_STOPPED;
-          break;
-        }
-        // else no delay (gDelay = 0)
-
-        this->calculateGrain(grains_[i]);
-      }
-    }
+    if (grains_[i].counter == 0) // Update the grain state.
+      this->advanceGrainState(grains_[i]);
 
     // Accumulate the grain outputs.
     if (grains_[i].state > 0) {
@@ -293,4 +346,110 @@ StkFloat Granulate ::tick(unsigned int channel) {
   return lastFrame_[channel];
 }
 
+StkFrames &Granulate ::tick(StkFrames &frames, unsigned int channel) {
+  unsigned int nChannels = lastFrame_.channels();
+#if defined(_STK_DEBUG_)
+  if (channel > frames.channels() - nChannels) {
+    oStream_ << "Granulate::tick(): channel and StkFrames arguments are "
+                "incompatible!";
+    handleError(StkError::FUNCTION_ARGUMENT);
+  }
+#endif
+
+  size_t nFrames = frames.frames();
+  if (nFrames == 0)
+    return frames;
+
+  unsigned int j, hop = frames.channels();
+  StkFloat *samples = &frames[channel];
+
+  // Grains accumulate into the output region, so clear it first.
+  for (size_t k = 0; k < nFrames; k++)
+    for (j = 0; j < nChannels; j++)
+      samples[k * hop + j] = 0.0;
+
+  if (data_.size() == 0) {
+    for (j = 0; j < nChannels; j++)
+      lastFrame_[j] = 0.0;
+    return frames;
+  }
+
+  // Batch the randomization for this control period.  Grains
+  // recalculated during the block draw from this pool instead of
+  // ticking the noise generator four times apiece mid-render; if an
+  // unusually busy block drains the pool, nextRandomValue() falls back
+  // to the generator.
+  if (randomValues_.size() != 4 * grains_.size())
+    randomValues_.resize(4 * grains_.size());
+  for (size_t k = 0; k < randomValues_.size(); k++)
+    randomValues_[k] = noise.tick();
+  randomIndex_ = 0;
+
+  // Render each grain a precomputed linear envelope segment at a time.
+  // Within a segment the state, envelope increment, and file pointer
+  // stride are all constant, so the per-sample state dispatch of the
+  // single-sample path disappears.
+  for (size_t g = 0; g < grains_.size(); g++) {
+    Grain &grain = grains_[g];
+    size_t frame = 0;
+    while (frame < nFrames) {
+
+      if (grain.counter == 0) {
+        this->advanceGrainState(grain);
+        if (grain.counter == 0) // never let a zero-length segment stall
+          grain.counter = 1;
+      }
+
+      size_t run = grain.counter;
+      if (run > nFrames - frame)
+        run = nFrames - frame;
+
+      if (grain.state > GRAIN_STOPPED) {
+        // A segment cannot cross the file wrap point.
+        unsigned long position = (unsigned long)grain.pointer;
+        if (run > data_.frames() - position)
+          run = data_.frames() - position;
+
+        StkFloat *out = samples + frame * hop;
+        const StkFloat *in = &data_[nChannels * position];
+        if (grain.state == GRAIN_SUSTAIN) {
+          for (size_t k = 0; k < run; k++)
+            for (j = 0; j < nChannels; j++)
+              out[k * hop + j] += in[k * nChannels + j];
+        } else { // GRAIN_FADEIN or GRAIN_FADEOUT
+          StkFloat eScaler = grain.eScaler;
+          StkFloat eRate = grain.eRate;
+          for (size_t k = 0; k < run; k++) {
+            for (j = 0; j < nChannels; j++) {
+              out[k * hop + j] += in[k * nChannels + j] * eScaler;
+              eScaler += eRate;
+            }
+          }
+          grain.eScaler = eScaler;
+        }
+
+        grain.pointer += run;
+        if (grain.pointer >= data_.frames())
+          grain.pointer = 0;
+      }
+
+      grain.counter -= run;
+      frame += run;
+    }
+  }
+
+  // Advance the global file pointer at the stretch rate over the
+  // whole block.
+  unsigned long stretchTicks = stretchCounter_ + nFrames;
+  gPointer_ += stretchTicks / (gStretch_ + 1);
+  stretchCounter_ = stretchTicks % (gStretch_ + 1);
+  while ((unsigned long)gPointer_ >= data_.frames())
+    gPointer_ -= data_.frames();
+
+  for (j = 0; j < nChannels; j++)
+    lastFrame_[j] = samples[(nFrames - 1) * hop + j];
+
+  return frames;
+}
+
 } // namespace stk
@@ -199,6 +199,21 @@ void Guitar ::noteOn(StkFloat frequency, StkFloat amplitude,
   pluckGains_[string] = amplitude;
 }
 
+void Guitar ::strum(const std::vector<StkFloat> &frequencies,
+                    StkFloat amplitude) {
+  unsigned int nStrings = (unsigned int)frequencies.size();
+  if (nStrings > strings_.size())
+    nStrings = (unsigned int)strings_.size();
+
+  for (unsigned int i = 0; i < nStrings; i++) {
+    strings_[i].setFrequency(frequencies[i]);
+    stringState_[i] = 2;
+    filePointer_[i] = 0;
+    strings_[i].setLoopGain(0.995);
+    pluckGains_[i] = amplitude;
+  }
+}
+
 void Guitar ::noteOff(StkFloat amplitude, unsigned int string) {
 #if defined(_STK_DEBUG_)
   if (string >= strings_.size()) {
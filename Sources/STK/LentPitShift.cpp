@@ -21,16 +21,12 @@ LentPitShift::LentPitShift(StkFloat periodRatio, int tMax)
       new StkFloat[2 * tMax_]; // Allocation of the array for the hamming window
   threshold_ = 0.1;            // Default threshold for pitch tracking
 
-  dt = new StkFloat[tMax + 1];    // Allocation of the euclidian distance
-                                  // coefficient array.  The first one is never
-                                  // used.
-  cumDt = new StkFloat[tMax + 1]; // Allocation of the cumulative sum array
-  cumDt[0] =
-      0.; // Initialization of the first coefficient of the cumulative sum
-  dpt = new StkFloat[tMax + 1]; // Allocation of the pitch tracking function
-                                // coefficient array
-  dpt[0] = 1.; // Initialization of the first coefficient of dpt which is always
-               // the same
+  dt = new StkFloat[tMax + 1]; // Allocation of the euclidian distance
+                               // coefficient array.  The first one is never
+                               // used.  tick() accumulates into the coarse
+                               // grid entries, so they must start at zero.
+  for (int i = 0; i <= tMax; i++)
+    dt[i] = 0.;
 
   // Initialisation of the input and output delay lines
   inputLine_.setMaximumDelay(3 * tMax_);
@@ -48,6 +44,8 @@ LentPitShift::LentPitShift(StkFloat periodRatio, int tMax)
 void LentPitShift ::clear() {
   inputLine_.clear();
   outputLine_.clear();
+  for (unsigned long i = 0; i <= tMax_; i++)
+    dt[i] = 0.;
 }
 
 void LentPitShift ::setShift(StkFloat shift) {
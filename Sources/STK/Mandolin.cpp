@@ -37,7 +37,9 @@ Mandolin::Mandolin(StkFloat lowestFrequency) {
     handleError(StkError::FUNCTION_ARGUMENT);
   }
 
-  // Concatenate the STK rawwave path to the rawwave files
+  // Concatenate the STK rawwave path to the rawwave files.  The body
+  // response tables are shared through the RawWaveBank registry, so
+  // only the first mandolin instance reads them from disk.
   soundfile_[0].openFile((Stk::rawwavePath() + "mand1.raw").c_str(), true);
   soundfile_[1].openFile((Stk::rawwavePath() + "mand2.raw").c_str(), true);
   soundfile_[2].openFile((Stk::rawwavePath() + "mand3.raw").c_str(), true);
@@ -27,6 +27,10 @@
 #include "Mesh2D.h"
 #include "SKINImsg.h"
 
+#if defined(__APPLE__)
+#include <Accelerate/Accelerate.h>
+#endif
+
 namespace stk {
 
 Mesh2D ::Mesh2D(unsigned short nX, unsigned short nY) {
@@ -50,6 +54,9 @@ Mesh2D ::Mesh2D(unsigned short nX, unsigned short nY) {
     filterX_[i].setGain(0.99);
   }
 
+  sparseUpdate_ = false;
+  energyFloor_ = 1.0e-9;
+
   this->clearMesh();
 
   counter_ = 0;
@@ -93,6 +100,8 @@ void Mesh2D ::clearMesh(void) {
       vym1_[x][y] = 0;
     }
   }
+  for (x = 0; x < NXMAX; x++)
+    rowEnergy_[x] = 0.0;
 }
 
 StkFloat Mesh2D ::energy(void) {
@@ -178,6 +187,18 @@ void Mesh2D ::setDecay(StkFloat decayFactor) {
     filterX_[i].setGain(decayFactor);
 }
 
+void Mesh2D ::setSparseUpdate(bool enable, StkFloat energyFloor) {
+  if (energyFloor < 0.0) {
+    oStream_ << "Mesh2D::setSparseUpdate: energyFloor is negative ... setting "
+                "to zero!";
+    handleError(StkError::WARNING);
+    energyFloor = 0.0;
+  }
+
+  sparseUpdate_ = enable;
+  energyFloor_ = energyFloor;
+}
+
 void Mesh2D ::setInputPosition(StkFloat xFactor, StkFloat yFactor) {
   if (xFactor < 0.0 || xFactor > 1.0) {
     oStream_ << "Mesh2D::setInputPosition xFactor value is out of range!";
@@ -196,6 +217,10 @@ void Mesh2D ::setInputPosition(StkFloat xFactor, StkFloat yFactor) {
 }
 
 void Mesh2D ::noteOn(StkFloat frequency, StkFloat amplitude) {
+  // Let the sparse gate see the excitation before the next update.
+  unsigned short xRow = (xInput_ < NX_ - 1) ? xInput_ : NX_ - 2;
+  rowEnergy_[xRow] += amplitude * amplitude;
+
   // Input at corner.
   if (counter_ & 1) {
     vxp1_[xInput_][yInput_] += amplitude;
@@ -209,6 +234,10 @@ void Mesh2D ::noteOn(StkFloat frequency, StkFloat amplitude) {
 void Mesh2D ::noteOff(StkFloat amplitude) { return; }
 
 StkFloat Mesh2D ::inputTick(StkFloat input) {
+  // Let the sparse gate see the excitation before the next update.
+  unsigned short xRow = (xInput_ < NX_ - 1) ? xInput_ : NX_ - 2;
+  rowEnergy_[xRow] += input * input;
+
   if (counter_ & 1) {
     vxp1_[xInput_][yInput_] += input;
     vyp1_[xInput_][yInput_] += input;
@@ -232,40 +261,100 @@ StkFloat Mesh2D ::tick(unsigned int) {
 const StkFloat VSCALE = 0.5;
 
 StkFloat Mesh2D ::tick0(void) {
+  return this->tickMesh(vxp_, vxm_, vyp_, vym_, vxp1_, vxm1_, vyp1_, vym1_);
+}
+
+StkFloat Mesh2D ::tick1(void) {
+  return this->tickMesh(vxp1_, vxm1_, vyp1_, vym1_, vxp_, vxm_, vyp_, vym_);
+}
+
+StkFloat Mesh2D ::tickMesh(StkFloat vxp[][NYMAX], StkFloat vxm[][NYMAX],
+                           StkFloat vyp[][NYMAX], StkFloat vym[][NYMAX],
+                           StkFloat vxp1[][NYMAX], StkFloat vxm1[][NYMAX],
+                           StkFloat vyp1[][NYMAX], StkFloat vym1[][NYMAX]) {
   int x, y;
-  StkFloat outsamp = 0;
+  int nY = NY_ - 1;
+
+  // Decide which junction rows participate this sample.  A row is
+  // updated when it or an adjacent row holds energy above the floor,
+  // so energy spreading toward a quiet region wakes that region one
+  // row ahead of the wavefront.
+  bool rowActive[NXMAX];
+  for (x = 0; x < NX_ - 1; x++) {
+    if (sparseUpdate_) {
+      StkFloat e = rowEnergy_[x];
+      if (x > 0 && rowEnergy_[x - 1] > e)
+        e = rowEnergy_[x - 1];
+      if (x < NX_ - 2 && rowEnergy_[x + 1] > e)
+        e = rowEnergy_[x + 1];
+      rowActive[x] = (e >= energyFloor_);
+    } else
+      rowActive[x] = true;
+  }
 
-  // Update junction velocities.
+  // Update junction velocities a row at a time (rows are contiguous
+  // in y), tracking each active row's energy for the sparse gate.
   for (x = 0; x < NX_ - 1; x++) {
-    for (y = 0; y < NY_ - 1; y++) {
-      v_[x][y] =
-          (vxp_[x][y] + vxm_[x + 1][y] + vyp_[x][y] + vym_[x][y + 1]) * VSCALE;
+    if (!rowActive[x])
+      continue;
+    StkFloat e = 0.0;
+#if defined(__APPLE__)
+    StkFloat scale = VSCALE;
+    vDSP_vaddD(vxp[x], 1, vxm[x + 1], 1, v_[x], 1, (vDSP_Length)nY);
+    vDSP_vaddD(v_[x], 1, vyp[x], 1, v_[x], 1, (vDSP_Length)nY);
+    vDSP_vaddD(v_[x], 1, vym[x] + 1, 1, v_[x], 1, (vDSP_Length)nY);
+    vDSP_vsmulD(v_[x], 1, &scale, v_[x], 1, (vDSP_Length)nY);
+    vDSP_svesqD(v_[x], 1, &e, (vDSP_Length)nY);
+#else
+    for (y = 0; y < nY; y++) {
+      StkFloat vxy =
+          (vxp[x][y] + vxm[x + 1][y] + vyp[x][y] + vym[x][y + 1]) * VSCALE;
+      v_[x][y] = vxy;
+      e += vxy * vxy;
     }
+#endif
+    rowEnergy_[x] = e;
   }
 
   // Update junction outgoing waves, using alternate wave-variable buffers.
   for (x = 0; x < NX_ - 1; x++) {
-    for (y = 0; y < NY_ - 1; y++) {
+    if (!rowActive[x])
+      continue;
+#if defined(__APPLE__)
+    // Note that vDSP_vsubD computes C = B - A.
+    vDSP_vsubD(vxm[x + 1], 1, v_[x], 1, vxp1[x + 1], 1, (vDSP_Length)nY);
+    vDSP_vsubD(vym[x] + 1, 1, v_[x], 1, vyp1[x] + 1, 1, (vDSP_Length)nY);
+    vDSP_vsubD(vxp[x], 1, v_[x], 1, vxm1[x], 1, (vDSP_Length)nY);
+    vDSP_vsubD(vyp[x], 1, v_[x], 1, vym1[x], 1, (vDSP_Length)nY);
+#else
+    for (y = 0; y < nY; y++) {
       StkFloat vxy = v_[x][y];
       // Update positive-going waves.
-      vxp1_[x + 1][y] = vxy - vxm_[x + 1][y];
-      vyp1_[x][y + 1] = vxy - vym_[x][y + 1];
+      vxp1[x + 1][y] = vxy - vxm[x + 1][y];
+      vyp1[x][y + 1] = vxy - vym[x][y + 1];
       // Update minus-going waves.
-      vxm1_[x][y] = vxy - vxp_[x][y];
-      vym1_[x][y] = vxy - vyp_[x][y];
+      vxm1[x][y] = vxy - vxp[x][y];
+      vym1[x][y] = vxy - vyp[x][y];
     }
+#endif
   }
 
   // Loop over velocity-junction boundary faces, update edge
   // reflections, with filtering.  We're only filtering on one x and y
   // edge here and even this could be made much sparser.
-  for (y = 0; y < NY_ - 1; y++) {
-    vxp1_[0][y] = filterY_[y].tick(vxm_[0][y]);
-    vxm1_[NX_ - 1][y] = vxp_[NX_ - 1][y];
+  if (rowActive[0]) {
+    for (y = 0; y < nY; y++)
+      vxp1[0][y] = filterY_[y].tick(vxm[0][y]);
+  }
+  if (rowActive[NX_ - 2]) {
+    for (y = 0; y < nY; y++)
+      vxm1[NX_ - 1][y] = vxp[NX_ - 1][y];
   }
   for (x = 0; x < NX_ - 1; x++) {
-    vyp1_[x][0] = filterX_[x].tick(vym_[x][0]);
-    vym1_[x][NY_ - 1] = vyp_[x][NY_ - 1];
+    if (!rowActive[x])
+      continue;
+    vyp1[x][0] = filterX_[x].tick(vym[x][0]);
+    vym1[x][NY_ - 1] = vyp[x][NY_ - 1];
   }
 
   // Output = sum of outgoing waves at far corner.  Note that the last
@@ -273,56 +362,7 @@ StkFloat Mesh2D ::tick0(void) {
   // coordinate indices at their next-to-last values.  This is because
   // the "unit strings" attached to each velocity node to terminate
   // the mesh are not themselves connected together.
-  outsamp = vxp_[NX_ - 1][NY_ - 2] + vyp_[NX_ - 2][NY_ - 1];
-
-  return outsamp;
-}
-
-StkFloat Mesh2D ::tick1(void) {
-  int x, y;
-  StkFloat outsamp = 0;
-
-  // Update junction velocities.
-  for (x = 0; x < NX_ - 1; x++) {
-    for (y = 0; y < NY_ - 1; y++) {
-      v_[x][y] =
-          (vxp1_[x][y] + vxm1_[x + 1][y] + vyp1_[x][y] + vym1_[x][y + 1]) *
-          VSCALE;
-    }
-  }
-
-  // Update junction outgoing waves,
-  // using alternate wave-variable buffers.
-  for (x = 0; x < NX_ - 1; x++) {
-    for (y = 0; y < NY_ - 1; y++) {
-      StkFloat vxy = v_[x][y];
-
-      // Update positive-going waves.
-      vxp_[x + 1][y] = vxy - vxm1_[x + 1][y];
-      vyp_[x][y + 1] = vxy - vym1_[x][y + 1];
-
-      // Update minus-going waves.
-      vxm_[x][y] = vxy - vxp1_[x][y];
-      vym_[x][y] = vxy - vyp1_[x][y];
-    }
-  }
-
-  // Loop over velocity-junction boundary faces, update edge
-  // reflections, with filtering.  We're only filtering on one x and y
-  // edge here and even this could be made much sparser.
-  for (y = 0; y < NY_ - 1; y++) {
-    vxp_[0][y] = filterY_[y].tick(vxm1_[0][y]);
-    vxm_[NX_ - 1][y] = vxp1_[NX_ - 1][y];
-  }
-  for (x = 0; x < NX_ - 1; x++) {
-    vyp_[x][0] = filterX_[x].tick(vym1_[x][0]);
-    vym_[x][NY_ - 1] = vyp1_[x][NY_ - 1];
-  }
-
-  // Output = sum of outgoing waves at far corner.
-  outsamp = vxp1_[NX_ - 1][NY_ - 2] + vyp1_[NX_ - 2][NY_ - 1];
-
-  return outsamp;
+  return vxp[NX_ - 1][NY_ - 2] + vyp[NX_ - 2][NY_ - 1];
 }
 
 void Mesh2D ::controlChange(int number, StkFloat value) {
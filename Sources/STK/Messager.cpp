@@ -14,7 +14,9 @@
     socket, or stdin) take place asynchronously, filling the message
     queue.  A call to popMessage() will pop the next available control
     message from the queue and return it via the referenced Message
-    structure.  When a \e non-realtime scorefile is set, it is not
+    structure.  The popMessages() function instead drains every queued
+    message in one call, sorted by time stamp, without taking a lock
+    on the consumer side.  When a \e non-realtime scorefile is set, it is not
     possible to start reading realtime input messages (from MIDI,
     socket, or stdin).  Likewise, it is not possible to read from a
     scorefile when a realtime input mechanism is running.
@@ -55,6 +57,7 @@ MessagerSourceType STK_SOCKET = 0x8;
 Messager ::Messager() {
   data_.sources = 0;
   data_.queueLimit = DEFAULT_QUEUE_LIMIT;
+  data_.ring.resize(DEFAULT_QUEUE_LIMIT + 1); // one slot is kept empty
 #if defined(__STK_REALTIME__)
   data_.socket = 0;
   data_.midi = 0;
@@ -66,8 +69,8 @@ Messager ::~Messager() {
 #if defined(__STK_REALTIME__)
   data_.mutex.lock();
 #endif
-  while (data_.queue.size())
-    data_.queue.pop();
+  data_.ringTail.store(data_.ringHead.load(std::memory_order_acquire),
+                       std::memory_order_release);
   data_.sources = 0;
 
 #if defined(__STK_REALTIME__)
@@ -108,30 +111,52 @@ void Messager ::popMessage(Skini::Message &message) {
     return;
   }
 
-  if (data_.queue.size() == 0) {
-    // An empty (or invalid) message is indicated by a type = 0.
+  // An empty (or invalid) message is indicated by a type = 0.
+  if (!data_.pop(message))
     message.type = 0;
-    return;
+}
+
+unsigned int Messager ::popMessages(std::vector<Skini::Message> &messages) {
+  messages.clear();
+
+  Skini::Message message;
+  if (data_.sources == STK_FILE) { // scorefile input
+    if (!data_.skini.nextMessage(message))
+      message.type = __SK_Exit_;
+    messages.push_back(message);
+    return 1;
   }
 
-// Copy queued message to the message pointer structure and then "pop" it.
-#if defined(__STK_REALTIME__)
-  data_.mutex.lock();
-#endif
-  message = data_.queue.front();
-  data_.queue.pop();
-#if defined(__STK_REALTIME__)
-  data_.mutex.unlock();
-#endif
+  // Drain the ring in one pass ... no lock is taken on this side.
+  while (data_.pop(message))
+    messages.push_back(message);
+
+  // Deliver in time order.  The sort is stable, so messages with
+  // equal time stamps keep their arrival order.
+  std::stable_sort(messages.begin(), messages.end(),
+                   [](const Skini::Message &a, const Skini::Message &b) {
+                     return a.time < b.time;
+                   });
+
+  return (unsigned int)messages.size();
 }
 
 void Messager ::pushMessage(Skini::Message &message) {
 #if defined(__STK_REALTIME__)
   data_.mutex.lock();
-#endif
-  data_.queue.push(message);
-#if defined(__STK_REALTIME__)
+  while (!data_.push(message)) {
+    data_.mutex.unlock();
+    Stk::sleep(50);
+    data_.mutex.lock();
+  }
   data_.mutex.unlock();
+#else
+  if (!data_.push(message)) {
+    // Nothing can drain the ring concurrently in a non-realtime
+    // build, so an overflowing message is dropped with a warning.
+    oStream_ << "Messager::pushMessage: message queue is full!";
+    handleError(StkError::WARNING);
+  }
 #endif
 }
 
@@ -173,18 +198,25 @@ THREAD_RETURN THREAD_TYPE stdinHandler(void *ptr) {
       break;
 
     data->mutex.lock();
-    if (data->skini.parseString(line, message))
-      data->queue.push(message);
-    data->mutex.unlock();
-
-    while (data->queue.size() >= data->queueLimit)
+    bool parsed = data->skini.parseString(line, message);
+    while (parsed && !data->push(message)) {
+      data->mutex.unlock();
       Stk::sleep(50);
+      data->mutex.lock();
+    }
+    data->mutex.unlock();
   }
 
   // We assume here that if someone types an "exit" message in the
   // terminal window, all processing should stop.
   message.type = __SK_Exit_;
-  data->queue.push(message);
+  data->mutex.lock();
+  while (!data->push(message)) {
+    data->mutex.unlock();
+    Stk::sleep(50);
+    data->mutex.lock();
+  }
+  data->mutex.unlock();
   data->sources &= ~STK_STDIN;
 
   return NULL;
@@ -219,11 +251,12 @@ void midiHandler(double timeStamp, std::vector<unsigned char> *bytes,
       message.floatValues[1] = (StkFloat)message.intValues[1];
   }
 
-  while (data->queue.size() >= data->queueLimit)
-    Stk::sleep(50);
-
   data->mutex.lock();
-  data->queue.push(message);
+  while (!data->push(message)) {
+    data->mutex.unlock();
+    Stk::sleep(50);
+    data->mutex.lock();
+  }
   data->mutex.unlock();
 }
 
@@ -383,13 +416,19 @@ THREAD_RETURN THREAD_TYPE socketHandler(void *ptr) {
           line += buffer[index];
           if (buffer[index++] == '\n') {
             data->mutex.lock();
+            bool parsed = false;
             if (line.compare(0, 4, "Exit") == 0 ||
                 line.compare(0, 4, "exit") == 0) {
               // Ignore this line and assume the connection will be
               // closed on a subsequent read call.
               ;
-            } else if (data->skini.parseString(line, message))
-              data->queue.push(message);
+            } else
+              parsed = data->skini.parseString(line, message);
+            while (parsed && !data->push(message)) {
+              data->mutex.unlock();
+              Stk::sleep(50);
+              data->mutex.lock();
+            }
             data->mutex.unlock();
             line.erase();
           }
@@ -425,15 +464,17 @@ THREAD_RETURN THREAD_TYPE socketHandler(void *ptr) {
         else if (!(data->sources & STK_STDIN)) {
           // No stdin thread running, so quit now.
           message.type = __SK_Exit_;
-          data->queue.push(message);
+          data->mutex.lock();
+          while (!data->push(message)) {
+            data->mutex.unlock();
+            Stk::sleep(50);
+            data->mutex.lock();
+          }
+          data->mutex.unlock();
         }
       }
       fdclose.clear();
     }
-
-    // Wait until we're below the queue limit.
-    while (data->queue.size() >= data->queueLimit)
-      Stk::sleep(50);
   }
 
   return NULL;
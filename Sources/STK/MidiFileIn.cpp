@@ -9,13 +9,18 @@
     Event delta-times are returned in the form of "ticks" and a
     function is provided to determine the current "seconds per tick".
     Tempo changes are internally tracked by the class and reflected in
-    the values returned by the function getTickSeconds().
+    the values returned by the function getTickSeconds().  A per-track
+    index of reader-state checkpoints is built when a file is opened,
+    so the seekTrack() function can jump to an arbitrary tick position
+    with a binary search and a short forward parse instead of
+    re-reading the track from its beginning.
 
     by Gary P. Scavone, 2003 - 2010.
 */
 /**********************************************************************/
 
 #include "MidiFileIn.h"
+#include <algorithm>
 #include <cstring>
 #include <iostream>
 
@@ -162,6 +167,10 @@ MidiFileIn ::MidiFileIn(std::string fileName) {
     usingTimeCode_ = false;
   }
 
+  // Build the per-track seek index.
+  trackIndex_.resize(nTracks_);
+  this->buildTrackIndex();
+
   return;
 
 error:
@@ -186,6 +195,109 @@ void MidiFileIn ::rewindTrack(unsigned int track) {
   trackPointers_[track] = trackOffsets_[track];
   trackStatus_[track] = 0;
   tickSeconds_[track] = tempoEvents_[0].tickSeconds;
+  if (trackCounters_.size()) { // format 1 tempo map state
+    trackCounters_[track] = 0;
+    trackTempoIndex_[track] = 0;
+  }
+}
+
+void MidiFileIn ::buildTrackIndex(void) {
+  std::vector<unsigned char> event;
+
+  for (unsigned int track = 0; track < nTracks_; track++) {
+    this->rewindTrack(track);
+
+    std::vector<TrackCheckpoint> &index = trackIndex_[track];
+    index.clear();
+
+    // The first checkpoint is the track start, so a lower-bound
+    // search below always has a checkpoint at or before its target.
+    TrackCheckpoint checkpoint;
+    checkpoint.count = 0;
+    checkpoint.pointer = trackOffsets_[track];
+    checkpoint.status = 0;
+    checkpoint.tickSeconds = tickSeconds_[track];
+    checkpoint.counter = 0;
+    checkpoint.tempoIndex = 0;
+    index.push_back(checkpoint);
+
+    unsigned long count = 0, nEvents = 0;
+    while (true) {
+      unsigned long ticks = this->getNextEvent(&event, track);
+      if (event.size() == 0)
+        break;
+      count += ticks;
+      if (++nEvents % trackIndexInterval_ == 0) {
+        checkpoint.count = count;
+        checkpoint.pointer = trackPointers_[track];
+        checkpoint.status = trackStatus_[track];
+        checkpoint.tickSeconds = tickSeconds_[track];
+        checkpoint.counter = trackCounters_.size() ? trackCounters_[track] : 0;
+        checkpoint.tempoIndex =
+            trackTempoIndex_.size() ? trackTempoIndex_[track] : 0;
+        index.push_back(checkpoint);
+      }
+    }
+
+    this->rewindTrack(track);
+  }
+}
+
+void MidiFileIn ::seekTrack(unsigned long tick, unsigned int track) {
+  if (track >= nTracks_) {
+    oStream_ << "MidiFileIn::seekTrack: invalid track argument (" << track
+             << ").";
+    handleError(StkError::WARNING);
+    return;
+  }
+
+  // Binary search for the last checkpoint at or before the target.
+  const std::vector<TrackCheckpoint> &index = trackIndex_[track];
+  TrackCheckpoint target;
+  target.count = tick;
+  std::vector<TrackCheckpoint>::const_iterator it = std::upper_bound(
+      index.begin(), index.end(), target,
+      [](const TrackCheckpoint &a, const TrackCheckpoint &b) {
+        return a.count < b.count;
+      });
+  --it; // safe: the track-start checkpoint has count = 0
+
+  trackPointers_[track] = it->pointer;
+  trackStatus_[track] = it->status;
+  tickSeconds_[track] = it->tickSeconds;
+  if (trackCounters_.size()) {
+    trackCounters_[track] = it->counter;
+    trackTempoIndex_[track] = it->tempoIndex;
+  }
+
+  // Parse forward until the next event lies at or past the target,
+  // re-saving the reader state before each read so that event is the
+  // next one delivered.
+  unsigned long count = it->count;
+  std::vector<unsigned char> event;
+  while (true) {
+    long pointer = trackPointers_[track];
+    char status = trackStatus_[track];
+    double tickSeconds = tickSeconds_[track];
+    unsigned long counter = trackCounters_.size() ? trackCounters_[track] : 0;
+    unsigned int tempoIndex =
+        trackTempoIndex_.size() ? trackTempoIndex_[track] : 0;
+
+    unsigned long ticks = this->getNextEvent(&event, track);
+    if (event.size() == 0)
+      break; // target is at or past the end of the track
+    if (count + ticks >= tick) {
+      trackPointers_[track] = pointer;
+      trackStatus_[track] = status;
+      tickSeconds_[track] = tickSeconds;
+      if (trackCounters_.size()) {
+        trackCounters_[track] = counter;
+        trackTempoIndex_[track] = tempoIndex;
+      }
+      break;
+    }
+    count += ticks;
+  }
 }
 
 double MidiFileIn ::getTickSeconds(unsigned int track) {
@@ -0,0 +1,80 @@
+/***************************************************/
+/*! \class RawWaveBank
+    \brief STK shared wavetable registry class.
+
+    This class maintains a process-wide registry of immutable audio
+    tables loaded from file.  Each file is read from disk at most
+    once; subsequent acquisitions of the same file name return a
+    reference to the already loaded table, so many instrument voices
+    can share one copy of their wavetable data and instance
+    construction involves no disk I/O after the first voice.
+
+    by Perry R. Cook and Gary P. Scavone, 1995--2016.
+*/
+/***************************************************/
+
+#include "RawWaveBank.h"
+#include "FileRead.h"
+#include <cmath>
+
+namespace stk {
+
+std::map<std::string, RawWaveBank::Entry> RawWaveBank::tables_;
+std::mutex RawWaveBank::mutex_;
+
+const StkFrames &RawWaveBank::acquire(const std::string &fileName, bool raw,
+                                      bool doNormalize) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  std::map<std::string, Entry>::iterator it = tables_.find(fileName);
+  if (it != tables_.end()) {
+    it->second.refCount++;
+    return it->second.data;
+  }
+
+  // Load the file into a new registry entry.  Map nodes are stable, so
+  // the reference returned here remains valid until the entry is erased.
+  Entry &entry = tables_[fileName];
+  try {
+    FileRead file(fileName, raw);
+    entry.data.resize((size_t)file.fileSize(), file.channels());
+    file.read(entry.data, 0, doNormalize);
+  } catch (StkError &) {
+    tables_.erase(fileName);
+    throw;
+  }
+
+  // Normalize all channels equally by the greatest magnitude in the
+  // data, as FileWvIn does for fully loaded files.
+  if (doNormalize) {
+    StkFloat max = 0.0;
+    size_t i;
+    for (i = 0; i < entry.data.size(); i++) {
+      if (fabs(entry.data[i]) > max)
+        max = (StkFloat)fabs((double)entry.data[i]);
+    }
+    if (max > 0.0) {
+      max = 1.0 / max;
+      for (i = 0; i < entry.data.size(); i++)
+        entry.data[i] *= max;
+    }
+  }
+
+  entry.refCount = 1;
+  return entry.data;
+}
+
+void RawWaveBank::release(const std::string &fileName) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  std::map<std::string, Entry>::iterator it = tables_.find(fileName);
+  if (it == tables_.end())
+    return;
+
+  if (it->second.refCount > 0)
+    it->second.refCount--;
+  if (it->second.refCount == 0)
+    tables_.erase(it);
+}
+
+} // namespace stk
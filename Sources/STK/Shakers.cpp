@@ -717,4 +717,159 @@ void Shakers::controlChange(int number, StkFloat value) {
 #endif
 }
 
+// Largest resonator bank in the tables above (angklung uses 7).
+const int MAX_SHAKER_RESONANCES = 8;
+
+void Shakers::tickBlock(StkFloat *samples, unsigned int nFrames,
+                        unsigned int stride) {
+  if (nFrames == 0)
+    return;
+
+  if (shakerType_ == 21 || nResonances_ > MAX_SHAKER_RESONANCES) {
+    // Water drops resweep the filter frequencies every sample; keep them
+    // on the per-sample path.
+    for (unsigned int i = 0; i < nFrames; i++, samples += stride)
+      *samples = tick();
+    return;
+  }
+
+  // Gather the bank coefficients and recursion state into contiguous
+  // stack arrays so the resonator update below runs across the bank
+  // without hopping between BiQuad structs.
+  unsigned int nResonances = nResonances_;
+  StkFloat a1[MAX_SHAKER_RESONANCES], a2[MAX_SHAKER_RESONANCES];
+  StkFloat g[MAX_SHAKER_RESONANCES];
+  StkFloat y1[MAX_SHAKER_RESONANCES], y2[MAX_SHAKER_RESONANCES];
+  for (unsigned int i = 0; i < nResonances; i++) {
+    a1[i] = filters_[i].a[1];
+    a2[i] = filters_[i].a[2];
+    g[i] = filters_[i].gain;
+    y1[i] = filters_[i].outputs[1];
+    y2[i] = filters_[i].outputs[2];
+  }
+
+  // Decay and gain scalars, hoisted once per block.
+  const bool ratchet = (shakerType_ == 19 || shakerType_ == 20);
+  const StkFloat systemDecay = systemDecay_;
+  const StkFloat soundDecay = soundDecay_;
+  const StkFloat currentGain = currentGain_;
+  const StkFloat nObjects = nObjects_;
+  const StkFloat ratchetDelta = ratchetDelta_;
+  StkFloat shakeEnergy = shakeEnergy_;
+  StkFloat sndLevel = sndLevel_;
+
+  bool anyVary = false;
+  for (unsigned int i = 0; i < nResonances; i++)
+    if (doVaryFrequency_[i])
+      anyVary = true;
+
+  const StkFloat eqB0 = equalizer_.b[0];
+  const StkFloat eqB1 = equalizer_.b[1];
+  const StkFloat eqB2 = equalizer_.b[2];
+  StkFloat eqX1 = equalizer_.inputs[1], eqX2 = equalizer_.inputs[2];
+
+  StkFloat output = 0.0;
+  unsigned int frame = 0;
+  for (; frame < nFrames; frame++, samples += stride) {
+    unsigned int iTube = 0;
+    StkFloat input = 0.0;
+    if (ratchet) {
+      if (ratchetCount_ <= 0)
+        break;
+
+      shakeEnergy -= (ratchetDelta + (0.002 * shakeEnergy));
+      if (shakeEnergy < 0.0) {
+        shakeEnergy = 1.0;
+        ratchetCount_--;
+      }
+
+      if (randomFloat(1024) < nObjects)
+        sndLevel += shakeEnergy * shakeEnergy;
+
+      // Sound is enveloped noise
+      input = sndLevel * noise() * shakeEnergy;
+    } else {
+      if (shakeEnergy < MIN_ENERGY)
+        break;
+
+      // Exponential system decay
+      shakeEnergy *= systemDecay;
+
+      // Random events
+      if (randomFloat(1024.0) < nObjects) {
+        sndLevel += shakeEnergy;
+        input = sndLevel;
+        // Vary resonance frequencies if specified.
+        if (anyVary) {
+          for (unsigned int i = 0; i < nResonances; i++) {
+            if (doVaryFrequency_[i]) {
+              StkFloat tempRand =
+                  baseFrequencies_[i] * (1.0 + (varyFactor_ * noise()));
+              a1[i] = -2.0 * baseRadii_[i] *
+                      cos(TWO_PI * tempRand / Stk::sampleRate());
+            }
+          }
+        }
+        if (shakerType_ == 22)
+          iTube = randomInt(7); // ANGKLUNG_RESONANCES
+      }
+    }
+
+    // Exponential sound decay
+    sndLevel *= soundDecay;
+
+    // Do resonance filtering
+    output = 0.0;
+    if (shakerType_ == 22) {
+      for (unsigned int i = 0; i < nResonances; i++) {
+        StkFloat y = (i == iTube ? input : 0.0) * g[i] * currentGain;
+        y -= a1[i] * y1[i] + a2[i] * y2[i];
+        y2[i] = y1[i];
+        y1[i] = y;
+        output += y;
+      }
+    } else {
+      for (unsigned int i = 0; i < nResonances; i++) {
+        StkFloat y = input * g[i] * currentGain;
+        y -= a1[i] * y1[i] + a2[i] * y2[i];
+        y2[i] = y1[i];
+        y1[i] = y;
+        output += y;
+      }
+    }
+
+    // Do final FIR filtering (lowpass or highpass)
+    StkFloat equalized = eqB0 * output + eqB1 * eqX1 + eqB2 * eqX2;
+    eqX2 = eqX1;
+    eqX1 = output;
+    output = equalized;
+    *samples = output;
+  }
+
+  if (frame > 0) {
+    // Scatter the advanced state back to the member structs.
+    for (unsigned int i = 0; i < nResonances; i++) {
+      filters_[i].a[1] = a1[i];
+      filters_[i].outputs[0] = y1[i];
+      filters_[i].outputs[1] = y1[i];
+      filters_[i].outputs[2] = y2[i];
+    }
+    equalizer_.inputs[0] = eqX1;
+    equalizer_.inputs[1] = eqX1;
+    equalizer_.inputs[2] = eqX2;
+    equalizer_.outputs[0] = output;
+    shakeEnergy_ = shakeEnergy;
+    sndLevel_ = sndLevel;
+    lastFrame_[0] = output;
+  }
+
+  if (frame < nFrames) {
+    // Energy is fully decayed (or the ratchet is spent): the per-sample
+    // path would output zeros for the rest of the block.
+    lastFrame_[0] = 0.0;
+    for (; frame < nFrames; frame++, samples += stride)
+      *samples = 0.0;
+  }
+}
+
 }
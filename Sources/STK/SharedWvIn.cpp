@@ -0,0 +1,179 @@
+/***************************************************/
+/*! \class SharedWvIn
+    \brief STK shared wavetable input class.
+
+    This class inherits from WvIn and provides the same "tick-level",
+    variable-rate playback interface as FileWvIn, but plays a table
+    held by the process-wide RawWaveBank registry instead of a
+    per-instance copy of the file data.  The table is loaded from
+    disk only for the first instance that opens a given file; every
+    later open of the same file is a registry lookup, so instrument
+    voices that share their wavetables construct without disk I/O and
+    without duplicating the data.  Linear interpolation is used for
+    fractional read rates.
+
+    by Perry R. Cook and Gary P. Scavone, 1995--2016.
+*/
+/***************************************************/
+
+#include "SharedWvIn.h"
+#include <cmath>
+
+namespace stk {
+
+SharedWvIn::SharedWvIn(void)
+    : table_(0), finished_(true), interpolate_(false), time_(0.0), rate_(0.0),
+      fileSize_(0) {
+  Stk::addSampleRateAlert(this);
+}
+
+SharedWvIn::SharedWvIn(std::string fileName, bool raw, bool doNormalize)
+    : table_(0), finished_(true), interpolate_(false), time_(0.0), rate_(0.0),
+      fileSize_(0) {
+  openFile(fileName, raw, doNormalize);
+  Stk::addSampleRateAlert(this);
+}
+
+SharedWvIn::~SharedWvIn(void) {
+  this->closeFile();
+  Stk::removeSampleRateAlert(this);
+}
+
+void SharedWvIn::sampleRateChanged(StkFloat newRate, StkFloat oldRate) {
+  if (!ignoreSampleRateChange_)
+    this->setRate(oldRate * rate_ / newRate);
+}
+
+void SharedWvIn::closeFile(void) {
+  if (table_) {
+    RawWaveBank::release(fileName_);
+    table_ = 0;
+    fileName_.clear();
+  }
+  fileSize_ = 0;
+  finished_ = true;
+  lastFrame_.resize(0, 0);
+}
+
+void SharedWvIn::openFile(std::string fileName, bool raw, bool doNormalize) {
+  // Release any previously acquired table.
+  this->closeFile();
+
+  // Acquire the shared table ... an error might be thrown here.
+  const StkFrames &table = RawWaveBank::acquire(fileName, raw, doNormalize);
+  table_ = &table;
+  fileName_ = fileName;
+  fileSize_ = (unsigned long)table.frames();
+
+  // Resize our lastFrame container.
+  lastFrame_.resize(1, table.channels());
+
+  // Set default rate based on file sampling rate.
+  this->setRate(table.dataRate() / Stk::sampleRate());
+
+  this->reset();
+}
+
+void SharedWvIn::reset(void) {
+  time_ = (StkFloat)0.0;
+  for (unsigned int i = 0; i < lastFrame_.size(); i++)
+    lastFrame_[i] = 0.0;
+  finished_ = false;
+}
+
+void SharedWvIn::setRate(StkFloat rate) {
+  rate_ = rate;
+
+  // If negative rate and at beginning of sound, move pointer to end
+  // of sound.
+  if ((rate_ < 0) && (time_ == 0.0))
+    time_ = fileSize_ - 1.0;
+
+  if (fmod(rate_, 1.0) != 0.0)
+    interpolate_ = true;
+  else
+    interpolate_ = false;
+}
+
+void SharedWvIn::addTime(StkFloat time) {
+  // Add an absolute time in samples
+  time_ += time;
+
+  if (time_ < 0.0)
+    time_ = 0.0;
+  if (time_ > fileSize_ - 1.0) {
+    time_ = fileSize_ - 1.0;
+    for (unsigned int i = 0; i < lastFrame_.size(); i++)
+      lastFrame_[i] = 0.0;
+    finished_ = true;
+  }
+}
+
+StkFloat SharedWvIn::tick(unsigned int channel) {
+#if defined(_STK_DEBUG_)
+  if (table_ == 0 || channel >= table_->channels()) {
+    oStream_ << "SharedWvIn::tick(): channel argument and table data are "
+                "incompatible!";
+    handleError(StkError::FUNCTION_ARGUMENT);
+  }
+#endif
+
+  if (finished_)
+    return 0.0;
+
+  if (time_ < 0.0 || time_ > (StkFloat)(fileSize_ - 1.0)) {
+    for (unsigned int i = 0; i < lastFrame_.size(); i++)
+      lastFrame_[i] = 0.0;
+    finished_ = true;
+    return 0.0;
+  }
+
+  const StkFrames &table = *table_;
+  if (interpolate_) {
+    for (unsigned int i = 0; i < lastFrame_.size(); i++)
+      lastFrame_[i] = table.interpolate(time_, i);
+  } else {
+    for (unsigned int i = 0; i < lastFrame_.size(); i++)
+      lastFrame_[i] = table((size_t)time_, i);
+  }
+
+  // Increment time, which can be negative.
+  time_ += rate_;
+
+  return lastFrame_[channel];
+}
+
+StkFrames &SharedWvIn::tick(StkFrames &frames, unsigned int channel) {
+  if (table_ == 0) {
+#if defined(_STK_DEBUG_)
+    oStream_ << "SharedWvIn::tick(): no table data is loaded!";
+    handleError(StkError::DEBUG_PRINT);
+#endif
+    return frames;
+  }
+
+  unsigned int nChannels = lastFrame_.channels();
+#if defined(_STK_DEBUG_)
+  if (channel > frames.channels() - nChannels) {
+    oStream_ << "SharedWvIn::tick(): channel and StkFrames arguments are "
+                "incompatible!";
+    handleError(StkError::FUNCTION_ARGUMENT);
+  }
+#endif
+
+  StkFloat *samples = &frames[channel];
+  unsigned int j, hop = frames.channels() - nChannels;
+  if (nChannels == 1) {
+    for (unsigned int i = 0; i < frames.frames(); i++, samples += hop)
+      *samples++ = tick();
+  } else {
+    for (unsigned int i = 0; i < frames.frames(); i++, samples += hop) {
+      *samples++ = tick();
+      for (j = 1; j < nChannels; j++)
+        *samples++ = lastFrame_[j];
+    }
+  }
+  return frames;
+}
+
+} // namespace stk
@@ -53,6 +53,10 @@
 #include "Stk.h"
 #include <stdlib.h>
 
+#if defined(__APPLE__)
+#include <Accelerate/Accelerate.h>
+#endif
+
 namespace stk {
 
 StkFloat Stk::srate_ = (StkFloat)SRATE;
@@ -384,4 +388,100 @@ StkFloat StkFrames::interpolate(StkFloat frame, unsigned int channel) const {
   return output;
 }
 
+void StkFrames::add(const StkFrames &f) {
+#if defined(_STK_DEBUG_)
+  if (f.frames() != nFrames_ || f.channels() != nChannels_) {
+    std::ostringstream error;
+    error << "StkFrames::add: frames argument must be of equal dimensions!";
+    Stk::handleError(error.str(), StkError::MEMORY_ACCESS);
+  }
+#endif
+#if defined(__APPLE__)
+  vDSP_vaddD(data_, 1, f.data_, 1, data_, 1, size_);
+#else
+  const StkFloat *fptr = f.data_;
+  StkFloat *dptr = data_;
+  for (size_t i = 0; i < size_; i++)
+    *dptr++ += *fptr++;
+#endif
+}
+
+void StkFrames::multiply(const StkFrames &f) {
+#if defined(_STK_DEBUG_)
+  if (f.frames() != nFrames_ || f.channels() != nChannels_) {
+    std::ostringstream error;
+    error
+        << "StkFrames::multiply: frames argument must be of equal dimensions!";
+    Stk::handleError(error.str(), StkError::MEMORY_ACCESS);
+  }
+#endif
+#if defined(__APPLE__)
+  vDSP_vmulD(data_, 1, f.data_, 1, data_, 1, size_);
+#else
+  const StkFloat *fptr = f.data_;
+  StkFloat *dptr = data_;
+  for (size_t i = 0; i < size_; i++)
+    *dptr++ *= *fptr++;
+#endif
+}
+
+void StkFrames::scale(StkFloat gain) {
+#if defined(__APPLE__)
+  vDSP_vsmulD(data_, 1, &gain, data_, 1, size_);
+#else
+  StkFloat *dptr = data_;
+  for (size_t i = 0; i < size_; i++)
+    *dptr++ *= gain;
+#endif
+}
+
+void StkFrames::mixAccumulate(const StkFrames &f, StkFloat gain) {
+#if defined(_STK_DEBUG_)
+  if (f.frames() != nFrames_ || f.channels() != nChannels_) {
+    std::ostringstream error;
+    error << "StkFrames::mixAccumulate: frames argument must be of equal "
+             "dimensions!";
+    Stk::handleError(error.str(), StkError::MEMORY_ACCESS);
+  }
+#endif
+#if defined(__APPLE__)
+  vDSP_vsmaD(f.data_, 1, &gain, data_, 1, data_, 1, size_);
+#else
+  const StkFloat *fptr = f.data_;
+  StkFloat *dptr = data_;
+  for (size_t i = 0; i < size_; i++)
+    *dptr++ += gain * *fptr++;
+#endif
+}
+
+void StkChannelView::copyTo(StkFloat *destination) const {
+#if defined(__APPLE__)
+  cblas_dcopy((int)nFrames_, data_, hop_, destination, 1);
+#else
+  const StkFloat *sptr = data_;
+  for (size_t i = 0; i < nFrames_; i++, sptr += hop_)
+    destination[i] = *sptr;
+#endif
+}
+
+void StkChannelView::copyFrom(const StkFloat *source) {
+#if defined(__APPLE__)
+  cblas_dcopy((int)nFrames_, source, 1, data_, hop_);
+#else
+  StkFloat *dptr = data_;
+  for (size_t i = 0; i < nFrames_; i++, dptr += hop_)
+    *dptr = source[i];
+#endif
+}
+
+void StkChannelView::accumulateTo(StkFloat *destination, StkFloat gain) const {
+#if defined(__APPLE__)
+  vDSP_vsmaD(data_, hop_, &gain, destination, 1, destination, 1, nFrames_);
+#else
+  const StkFloat *sptr = data_;
+  for (size_t i = 0; i < nFrames_; i++, sptr += hop_)
+    destination[i] += gain * *sptr;
+#endif
+}
+
 }
@@ -96,6 +96,13 @@ public:
   StkFrames &tick(StkFrames &frames, unsigned int channel = 0);
 
 protected:
+  // Advance every band over a whole block in band-major order (struck
+  // operation only, where the bands are uncoupled within a sample).  Each
+  // band's filter and delay state stays hot across the block instead of
+  // every delay line being touched once per sample.
+  void tickBlockPlucked(StkFloat *samples, unsigned int nFrames,
+                        unsigned int stride);
+
   bool doPluck_;
   bool trackVelocity_;
   int nModes_;
@@ -133,8 +140,11 @@ inline StkFrames &BandedWG ::tick(StkFrames &frames, unsigned int channel) {
   StkFloat *samples = &frames[channel];
   unsigned int j, hop = frames.channels() - nChannels;
   if (nChannels == 1) {
-    for (unsigned int i = 0; i < frames.frames(); i++, samples += hop)
-      *samples++ = tick();
+    if (doPluck_ && frames.frames() > 0)
+      this->tickBlockPlucked(samples, frames.frames(), frames.channels());
+    else
+      for (unsigned int i = 0; i < frames.frames(); i++, samples += hop)
+        *samples++ = tick();
   } else {
     for (unsigned int i = 0; i < frames.frames(); i++, samples += hop) {
       *samples++ = tick();
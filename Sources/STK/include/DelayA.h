@@ -112,6 +112,13 @@ public:
                   unsigned int iChannel = 0, unsigned int oChannel = 0);
 
 protected:
+  // Block fast path shared by the StkFrames tick variants: keeps the
+  // buffer pointers, indices and allpass state in locals and splits the
+  // block into wrap-free runs so the modulo checks run once per run
+  // instead of once per sample.
+  void tickBlock(const StkFloat *in, StkFloat *out, unsigned int nFrames,
+                 unsigned int iHop, unsigned int oHop);
+
   unsigned long inPoint_;
   unsigned long outPoint_;
   StkFloat delay_;
@@ -151,6 +158,68 @@ inline StkFloat DelayA::tick(StkFloat input) {
   return lastFrame_[0];
 }
 
+inline void DelayA::tickBlock(const StkFloat *in, StkFloat *out,
+                              unsigned int nFrames, unsigned int iHop,
+                              unsigned int oHop) {
+  if (nFrames == 0)
+    return;
+
+  if (!doNextOut_) {
+    // Honor a pending nextOut() cache, which predates this sample's write.
+    inputs_[inPoint_++] = *in * gain_;
+    if (inPoint_ == inputs_.size())
+      inPoint_ = 0;
+    *out = nextOutput_;
+    lastFrame_[0] = nextOutput_;
+    doNextOut_ = true;
+    apInput_ = inputs_[outPoint_++];
+    if (outPoint_ == inputs_.size())
+      outPoint_ = 0;
+    in += iHop;
+    out += oHop;
+    if (--nFrames == 0)
+      return;
+  }
+
+  StkFloat *buf = &inputs_[0];
+  unsigned long size = inputs_.size();
+  unsigned long inPoint = inPoint_, outPoint = outPoint_;
+  StkFloat coeff = coeff_, gain = gain_;
+  StkFloat output = lastFrame_[0], apInput = apInput_;
+
+  unsigned int i = 0;
+  while (i < nFrames) {
+    unsigned long run = nFrames - i;
+    if (run > size - inPoint)
+      run = size - inPoint;
+    if (run > size - outPoint)
+      run = size - outPoint;
+    for (unsigned long k = 0; k < run; k++) {
+      buf[inPoint + k] = in[k * iHop] * gain;
+      StkFloat next = -coeff * output;
+      next += apInput + (coeff * buf[outPoint + k]);
+      apInput = buf[outPoint + k];
+      output = next;
+      out[k * oHop] = next;
+    }
+    inPoint += run;
+    if (inPoint == size)
+      inPoint = 0;
+    outPoint += run;
+    if (outPoint == size)
+      outPoint = 0;
+    in += run * iHop;
+    out += run * oHop;
+    i += run;
+  }
+
+  inPoint_ = inPoint;
+  outPoint_ = outPoint;
+  apInput_ = apInput;
+  doNextOut_ = true;
+  lastFrame_[0] = output;
+}
+
 inline StkFrames &DelayA::tick(StkFrames &frames, unsigned int channel) {
 #if defined(_STK_DEBUG_)
   if (channel >= frames.channels()) {
@@ -162,18 +231,7 @@ inline StkFrames &DelayA::tick(StkFrames &frames, unsigned int channel) {
 
   StkFloat *samples = &frames[channel];
   unsigned int hop = frames.channels();
-  for (unsigned int i = 0; i < frames.frames(); i++, samples += hop) {
-    inputs_[inPoint_++] = *samples * gain_;
-    if (inPoint_ == inputs_.size())
-      inPoint_ = 0;
-    *samples = nextOut();
-    lastFrame_[0] = *samples;
-    doNextOut_ = true;
-    apInput_ = inputs_[outPoint_++];
-    if (outPoint_ == inputs_.size())
-      outPoint_ = 0;
-  }
-
+  tickBlock(samples, samples, frames.frames(), hop, hop);
   return frames;
 }
 
@@ -187,22 +245,8 @@ inline StkFrames &DelayA::tick(StkFrames &iFrames, StkFrames &oFrames,
   }
 #endif
 
-  StkFloat *iSamples = &iFrames[iChannel];
-  StkFloat *oSamples = &oFrames[oChannel];
-  unsigned int iHop = iFrames.channels(), oHop = oFrames.channels();
-  for (unsigned int i = 0; i < iFrames.frames();
-       i++, iSamples += iHop, oSamples += oHop) {
-    inputs_[inPoint_++] = *iSamples * gain_;
-    if (inPoint_ == inputs_.size())
-      inPoint_ = 0;
-    *oSamples = nextOut();
-    lastFrame_[0] = *oSamples;
-    doNextOut_ = true;
-    apInput_ = inputs_[outPoint_++];
-    if (outPoint_ == inputs_.size())
-      outPoint_ = 0;
-  }
-
+  tickBlock(&iFrames[iChannel], &oFrames[oChannel], iFrames.frames(),
+            iFrames.channels(), oFrames.channels());
   return iFrames;
 }
 
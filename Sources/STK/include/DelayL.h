@@ -108,6 +108,13 @@ public:
                   unsigned int iChannel = 0, unsigned int oChannel = 0);
 
 protected:
+  // Block fast path shared by the StkFrames tick variants: keeps the
+  // buffer pointers, indices and interpolation coefficients in locals and
+  // splits the block into wrap-free runs so the modulo checks run once per
+  // run instead of once per sample.
+  void tickBlock(const StkFloat *in, StkFloat *out, unsigned int nFrames,
+                 unsigned int iHop, unsigned int oHop);
+
   unsigned long inPoint_;
   unsigned long outPoint_;
   StkFloat delay_;
@@ -179,6 +186,78 @@ inline StkFloat DelayL::tick(StkFloat input) {
   return lastFrame_[0];
 }
 
+inline void DelayL::tickBlock(const StkFloat *in, StkFloat *out,
+                              unsigned int nFrames, unsigned int iHop,
+                              unsigned int oHop) {
+  if (nFrames == 0)
+    return;
+
+  StkFloat output = 0.0;
+  if (!doNextOut_) {
+    // Honor a pending nextOut() cache, which predates this sample's write.
+    inputs_[inPoint_++] = *in * gain_;
+    if (inPoint_ == inputs_.size())
+      inPoint_ = 0;
+    output = nextOutput_;
+    *out = output;
+    doNextOut_ = true;
+    if (++outPoint_ == inputs_.size())
+      outPoint_ = 0;
+    in += iHop;
+    out += oHop;
+    if (--nFrames == 0) {
+      lastFrame_[0] = output;
+      return;
+    }
+  }
+
+  StkFloat *buf = &inputs_[0];
+  unsigned long size = inputs_.size();
+  unsigned long inPoint = inPoint_, outPoint = outPoint_;
+  StkFloat alpha = alpha_, omAlpha = omAlpha_, gain = gain_;
+
+  unsigned int i = 0;
+  while (i < nFrames) {
+    if (outPoint + 1 == size) {
+      // The interpolation tap wraps here: take this one sample slowly.
+      buf[inPoint++] = *in * gain;
+      if (inPoint == size)
+        inPoint = 0;
+      output = buf[outPoint] * omAlpha;
+      output += buf[0] * alpha;
+      *out = output;
+      outPoint = 0;
+      in += iHop;
+      out += oHop;
+      i++;
+      continue;
+    }
+    unsigned long run = nFrames - i;
+    if (run > size - inPoint)
+      run = size - inPoint;
+    if (run > size - 1 - outPoint)
+      run = size - 1 - outPoint;
+    for (unsigned long k = 0; k < run; k++) {
+      buf[inPoint + k] = in[k * iHop] * gain;
+      output = buf[outPoint + k] * omAlpha;
+      output += buf[outPoint + k + 1] * alpha;
+      out[k * oHop] = output;
+    }
+    inPoint += run;
+    if (inPoint == size)
+      inPoint = 0;
+    outPoint += run;
+    in += run * iHop;
+    out += run * oHop;
+    i += run;
+  }
+
+  inPoint_ = inPoint;
+  outPoint_ = outPoint;
+  doNextOut_ = true;
+  lastFrame_[0] = output;
+}
+
 inline StkFrames &DelayL::tick(StkFrames &frames, unsigned int channel) {
 #if defined(_STK_DEBUG_)
   if (channel >= frames.channels()) {
@@ -190,17 +269,7 @@ inline StkFrames &DelayL::tick(StkFrames &frames, unsigned int channel) {
 
   StkFloat *samples = &frames[channel];
   unsigned int hop = frames.channels();
-  for (unsigned int i = 0; i < frames.frames(); i++, samples += hop) {
-    inputs_[inPoint_++] = *samples * gain_;
-    if (inPoint_ == inputs_.size())
-      inPoint_ = 0;
-    *samples = nextOut();
-    doNextOut_ = true;
-    if (++outPoint_ == inputs_.size())
-      outPoint_ = 0;
-  }
-
-  lastFrame_[0] = *(samples - hop);
+  tickBlock(samples, samples, frames.frames(), hop, hop);
   return frames;
 }
 
@@ -214,21 +283,8 @@ inline StkFrames &DelayL::tick(StkFrames &iFrames, StkFrames &oFrames,
   }
 #endif
 
-  StkFloat *iSamples = &iFrames[iChannel];
-  StkFloat *oSamples = &oFrames[oChannel];
-  unsigned int iHop = iFrames.channels(), oHop = oFrames.channels();
-  for (unsigned int i = 0; i < iFrames.frames();
-       i++, iSamples += iHop, oSamples += oHop) {
-    inputs_[inPoint_++] = *iSamples * gain_;
-    if (inPoint_ == inputs_.size())
-      inPoint_ = 0;
-    *oSamples = nextOut();
-    doNextOut_ = true;
-    if (++outPoint_ == inputs_.size())
-      outPoint_ = 0;
-  }
-
-  lastFrame_[0] = *(oSamples - oHop);
+  tickBlock(&iFrames[iChannel], &oFrames[oChannel], iFrames.frames(),
+            iFrames.channels(), oFrames.channels());
   return iFrames;
 }
 
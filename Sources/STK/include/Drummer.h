@@ -1,8 +1,8 @@
 #ifndef STK_DRUMMER_H
 #define STK_DRUMMER_H
 
-#include "FileWvIn.h"
 #include "Instrmnt.h"
+#include "SharedWvIn.h"
 #include "OnePole.h"
 
 namespace stk {
@@ -64,7 +64,7 @@ public:
   StkFrames &tick(StkFrames &frames, unsigned int channel = 0);
 
 protected:
-  FileWvIn waves_[DRUM_POLYPHONY];
+  SharedWvIn waves_[DRUM_POLYPHONY];
   OnePole filters_[DRUM_POLYPHONY];
   std::vector<int> soundOrder_;
   std::vector<int> soundNumber_;
@@ -2,6 +2,9 @@
 #define STK_FILEWRITE_H
 
 #include "Stk.h"
+#include <atomic>
+#include <thread>
+#include <vector>
 
 namespace stk {
 
@@ -77,6 +80,28 @@ public:
    */
   void write(StkFrames &buffer);
 
+  //! Enable or disable asynchronous writing (default disabled).
+  /*!
+    In asynchronous mode, write() only copies samples into a lock-free
+    staging ring and returns; a background thread performs the format
+    conversion and file output in large blocks, making write() safe to
+    call from time-critical threads.  The ring holds \e ringFrames
+    frames.  When the ring is full, write() drops the buffer rather
+    than block; see framesDropped().  The mode cannot be changed while
+    a file is open.
+  */
+  void setAsynchronous(bool enabled, unsigned long ringFrames = 32768);
+
+  //! Return the fraction of the staging ring currently occupied (0.0 to 1.0).
+  /*!
+    An occupancy approaching 1.0 warns that the disk is not keeping up
+    and the next write() calls are likely to drop frames.
+  */
+  StkFloat ringOccupancy(void) const;
+
+  //! Return the number of frames dropped because the staging ring was full.
+  unsigned long framesDropped(void) const { return framesDropped_; };
+
 protected:
   // Write STK RAW file header.
   bool setRawFile(std::string fileName);
@@ -105,12 +130,35 @@ protected:
   // Close MAT-file, updating the header.
   void closeMatFile(void);
 
+  // Convert interleaved samples to the output data format in one pass and
+  // write them to the file with a single fwrite().  Returns false on a
+  // write error.
+  bool writeSamples(const StkFloat *samples, unsigned long nSamples);
+
+  // Write out everything currently staged in the ring, returning the
+  // number of samples written (writer thread only).
+  unsigned long drainRing(void);
+
+  // Background writer thread routine.
+  void writerLoop(void);
+
   FILE *fd_;
   FILE_TYPE fileType_;
   StkFormat dataType_;
   unsigned int channels_;
   unsigned long frameCounter_;
   bool byteswap_;
+
+  bool asynchronous_;
+  unsigned long ringFrames_;
+  std::vector<StkFloat> ring_;
+  std::atomic<unsigned long> ringHead_; // next slot to write (caller)
+  std::atomic<unsigned long> ringTail_; // next slot to read (writer thread)
+  std::atomic<unsigned long> framesDropped_;
+  std::atomic<bool> writerRunning_;
+  std::atomic<bool> writeError_;
+  std::thread writerThread_;
+  std::vector<unsigned char> packed_; // conversion staging (writer side)
 };
 
 } // namespace stk
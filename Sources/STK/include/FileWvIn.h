@@ -3,6 +3,11 @@
 #include "FileRead.h"
 #include "WvIn.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 namespace stk {
 
 /***************************************************/
@@ -127,6 +132,21 @@ public:
   */
   void setInterpolate(bool doInterpolate) { interpolate_ = doInterpolate; };
 
+  //! Turn asynchronous chunk prefetching on/off.
+  /*!
+    When enabled and the file is being read incrementally in chunks,
+    the chunk following the current one (in the direction of the read
+    rate) is loaded by a background thread into a second buffer while
+    the current chunk plays.  At a chunk boundary the buffers are
+    swapped without copying, so the tick() functions do no disk I/O on
+    the calling (typically audio) thread.  If a seek lands outside the
+    prefetched chunk, or the prefetch has not completed in time, the
+    read falls back to the original synchronous path and prefetching
+    resumes from the new position.  This setting has no effect on
+    files small enough to be loaded entirely into memory.
+  */
+  void setPrefetching(bool doPrefetch);
+
   //! Return the specified channel value of the last computed frame.
   /*!
     If no file is loaded, the returned value is 0.0.  The \c
@@ -165,6 +185,14 @@ public:
 protected:
   void sampleRateChanged(StkFloat newRate, StkFloat oldRate);
 
+  // Ask the background thread for the chunk adjacent to chunkPointer_ in
+  // the direction of the current read rate.  Never blocks the caller.
+  void schedulePrefetch(void);
+
+  // Background thread body: sleeps until a prefetch is requested, reads
+  // the chunk through its own FileRead handle, and marks it ready.
+  void prefetchLoop(void);
+
   FileRead file_;
   bool finished_;
   bool interpolate_;
@@ -176,6 +204,29 @@ protected:
   unsigned long chunkThreshold_;
   unsigned long chunkSize_;
   long chunkPointer_;
+
+  // Asynchronous prefetch state.  The tick() side touches prefetchData_
+  // and prefetchPointer_ only when prefetchState_ is kPrefetchReady (or
+  // the thread is idle); the handoff is the acquire/release on
+  // prefetchState_.  The worker has its own FileRead so the two threads
+  // never share a file handle.
+  enum PrefetchState {
+    kPrefetchIdle,
+    kPrefetchRequested,
+    kPrefetchLoading,
+    kPrefetchReady
+  };
+  FileRead prefetchFile_;
+  StkFrames prefetchData_;
+  long prefetchPointer_;
+  bool prefetching_;
+  std::atomic<int> prefetchState_;
+  std::thread prefetchThread_;
+  std::mutex prefetchMutex_;
+  std::condition_variable prefetchCondition_;
+  bool prefetchShutdown_;
+  std::string fileName_;
+  bool raw_;
 };
 
 inline StkFloat FileWvIn::lastOut(unsigned int channel) {
@@ -1,9 +1,9 @@
 #ifndef STK_FREEVERB_H
 #define STK_FREEVERB_H
 
-#include "Delay.h"
 #include "Effect.h"
-#include "OnePole.h"
+
+#include <vector>
 
 namespace stk {
 
@@ -155,15 +155,27 @@ protected:
   StkFloat width_;
   bool frozenMode_;
 
-  // LBFC: Lowpass Feedback Comb Filters
-  Delay combDelayL_[nCombs];
-  Delay combDelayR_[nCombs];
-  OnePole combLPL_[nCombs];
-  OnePole combLPR_[nCombs];
-
-  // AP: Allpass Filters
-  Delay allPassDelayL_[nAllpasses];
-  Delay allPassDelayR_[nAllpasses];
+  // Render a block through the reverb network.  \e inR may be NULL
+  // for mono input; the input and output pointers are strided by the
+  // given hops so both StkFrames tick() variants share this path.
+  void processBlock(const StkFloat *inL, const StkFloat *inR,
+                    unsigned int inHop, StkFloat *outL, StkFloat *outR,
+                    unsigned int outHop, unsigned int nFrames);
+
+  // All comb and allpass delay lines for both channels live in one
+  // contiguous arena (left combs, left allpasses, right combs, right
+  // allpasses) so a render pass streams through a single allocation
+  // instead of twenty-four separate heap buffers.  Each line is a
+  // simple ring: read the delayed sample at the position, write the
+  // new sample over it, advance.  Channel index 0 is left, 1 right.
+  std::vector<StkFloat> arena_;
+  unsigned long combOffset_[2][nCombs];
+  unsigned long combLength_[2][nCombs];
+  unsigned long combPos_[2][nCombs];
+  StkFloat combLPState_[2][nCombs]; // one-pole damping filter state
+  unsigned long allPassOffset_[2][nAllpasses];
+  unsigned long allPassLength_[2][nAllpasses];
+  unsigned long allPassPos_[2][nAllpasses];
 };
 
 inline StkFloat FreeVerb ::lastOut(unsigned int channel) {
@@ -187,47 +199,44 @@ inline StkFloat FreeVerb::tick(StkFloat inputL, StkFloat inputR,
 #endif
 
   StkFloat fInput = (inputL + inputR) * gain_;
-  StkFloat outL = 0.0;
-  StkFloat outR = 0.0;
-
-  // Parallel LBCF filters
-  for (int i = 0; i < nCombs; i++) {
-    // Left channel
-    // StkFloat yn = fInput + (roomSize_ *
-    // FreeVerb::undenormalize(combLPL_[i].tick(FreeVerb::undenormalize(combDelayL_[i].nextOut()))));
-    StkFloat yn =
-        fInput + (roomSize_ * combLPL_[i].tick(combDelayL_[i].nextOut()));
-    combDelayL_[i].tick(yn);
-    outL += yn;
-
-    // Right channel
-    // yn = fInput + (roomSize_ *
-    // FreeVerb::undenormalize(combLPR_[i].tick(FreeVerb::undenormalize(combDelayR_[i].nextOut()))));
-    yn = fInput + (roomSize_ * combLPR_[i].tick(combDelayR_[i].nextOut()));
-    combDelayR_[i].tick(yn);
-    outR += yn;
+  StkFloat out[2] = {0.0, 0.0};
+
+  for (int c = 0; c < 2; c++) {
+
+    // Parallel LBCF filters
+    for (int i = 0; i < nCombs; i++) {
+      StkFloat *line = &arena_[combOffset_[c][i]];
+      unsigned long pos = combPos_[c][i];
+      // StkFloat lp = FreeVerb::undenormalize( ... );
+      StkFloat lp = (1.0 - damp_) * line[pos] + damp_ * combLPState_[c][i];
+      combLPState_[c][i] = lp;
+      StkFloat yn = fInput + (roomSize_ * lp);
+      line[pos] = yn;
+      if (++pos == combLength_[c][i])
+        pos = 0;
+      combPos_[c][i] = pos;
+      out[c] += yn;
+    }
+
+    // Series allpass filters
+    for (int i = 0; i < nAllpasses; i++) {
+      StkFloat *line = &arena_[allPassOffset_[c][i]];
+      unsigned long pos = allPassPos_[c][i];
+      // StkFloat vn_m = FreeVerb::undenormalize( line[pos] );
+      StkFloat vn_m = line[pos];
+      StkFloat vn = out[c] + (g_ * vn_m);
+      line[pos] = vn;
+      if (++pos == allPassLength_[c][i])
+        pos = 0;
+      allPassPos_[c][i] = pos;
+
+      // calculate output
+      out[c] = -vn + (1.0 + g_) * vn_m;
+    }
   }
 
-  // Series allpass filters
-  for (int i = 0; i < nAllpasses; i++) {
-    // Left channel
-    // StkFloat vn_m = FreeVerb::undenormalize(allPassDelayL_[i].nextOut());
-    StkFloat vn_m = allPassDelayL_[i].nextOut();
-    StkFloat vn = outL + (g_ * vn_m);
-    allPassDelayL_[i].tick(vn);
-
-    // calculate output
-    outL = -vn + (1.0 + g_) * vn_m;
-
-    // Right channel
-    // vn_m = FreeVerb::undenormalize(allPassDelayR_[i].nextOut());
-    vn_m = allPassDelayR_[i].nextOut();
-    vn = outR + (g_ * vn_m);
-    allPassDelayR_[i].tick(vn);
-
-    // calculate output
-    outR = -vn + (1.0 + g_) * vn_m;
-  }
+  StkFloat outL = out[0];
+  StkFloat outR = out[1];
 
   // Mix output
   lastFrame_[0] = outL * wet1_ + outR * wet2_ + inputL * dry_;
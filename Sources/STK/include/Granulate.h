@@ -58,6 +58,18 @@ public:
   */
   void setVoices(unsigned int nVoices = 1);
 
+  //! Set a hard budget on the number of simultaneously sounding grains.
+  /*!
+    By default (\e maxGrains = 0) every voice may sound at once and
+    rendering cost grows with the voice count.  When a budget is set
+    and a new grain is scheduled to start while the budget is spent,
+    the sounding grain closest to its decay is pushed into its fadeout
+    early and the new grain waits for that slot to free up, so large
+    voice counts degrade gracefully instead of saturating the render
+    thread.
+  */
+  void setMaxActiveGrains(unsigned int maxGrains = 0);
+
   //! Set the stretch factor used for grain playback (1 - 1000).
   /*!
     Granular synthesis allows for time-stetching without affecting
@@ -115,9 +127,13 @@ public:
   //! Fill the StkFrames object with computed sample frames, starting at the
   //! specified channel.
   /*!
-    The \c channel argument plus the number of output channels must
-    be less than the number of channels in the StkFrames argument (the
-    first channel is specified by 0).  However, range checking is only
+    Unlike the single-sample tick(), this function renders whole
+    blocks: each grain is advanced a precomputed linear envelope
+    segment at a time and the per-grain randomization is batched once
+    per block, so per-sample state dispatch is avoided.  The \c
+    channel argument plus the number of output channels must be less
+    than the number of channels in the StkFrames argument (the first
+    channel is specified by 0).  However, range checking is only
     performed if _STK_DEBUG_ is defined during compilation, in which
     case an out-of-range value will trigger an StkError exception.
   */
@@ -149,6 +165,19 @@ protected:
 
   void calculateGrain(Granulate::Grain &grain);
 
+  // Advance a grain whose counter has expired to its next envelope
+  // state.  Shared by the single-sample and block tick() paths.
+  void advanceGrainState(Granulate::Grain &grain);
+
+  // Start a new grain, respecting the active-grain budget.  If the
+  // budget is spent, the sounding grain nearest its decay is pushed
+  // into fadeout and this grain waits for the slot.
+  void startGrain(Granulate::Grain &grain);
+
+  // Return the next value from the per-block randomization batch,
+  // falling back to the noise generator when the batch is spent.
+  StkFloat nextRandomValue(void);
+
   StkFrames data_;
   std::vector<Grain> grains_;
   Noise noise;
@@ -164,6 +193,14 @@ protected:
   int gOffset_;
   StkFloat gRandomFactor_;
   StkFloat gain_;
+
+  // Active-grain budget (0 = unlimited) and the current active count.
+  unsigned int maxActiveGrains_;
+  unsigned int activeGrains_;
+
+  // Randomization batch refilled once per block tick().
+  std::vector<StkFloat> randomValues_;
+  size_t randomIndex_;
 };
 
 inline StkFloat Granulate ::lastOut(unsigned int channel) {
@@ -177,27 +214,6 @@ inline StkFloat Granulate ::lastOut(unsigned int channel) {
   return lastFrame_[channel];
 }
 
-inline StkFrames &Granulate ::tick(StkFrames &frames, unsigned int channel) {
-  unsigned int nChannels = lastFrame_.channels();
-#if defined(_STK_DEBUG_)
-  if (channel > frames.channels() - nChannels) {
-    oStream_ << "Granulate::tick(): channel and StkFrames arguments are "
-                "incompatible!";
-    handleError(StkError::FUNCTION_ARGUMENT);
-  }
-#endif
-
-  StkFloat *samples = &frames[channel];
-  unsigned int j, hop = frames.channels() - nChannels;
-  for (unsigned int i = 0; i < frames.frames(); i++, samples += hop) {
-    *samples++ = tick();
-    for (j = 1; j < nChannels; j++)
-      *samples++ = lastFrame_[j];
-  }
-
-  return frames;
-}
-
 } // namespace stk
 
 #endif
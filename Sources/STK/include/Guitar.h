@@ -82,6 +82,15 @@ public:
   //! Stop a note with the given amplitude (speed of decay).
   void noteOff(StkFloat amplitude, unsigned int string = 0);
 
+  //! Start a note on several strings at once, as one batched update.
+  /*!
+     Strings 0 through frequencies.size()-1 are plucked with the given
+     amplitude in a single pass over the string state, avoiding the
+     per-string call overhead of repeated noteOn() invocations.  Extra
+     entries beyond the number of strings are ignored.
+  */
+  void strum(const std::vector<StkFloat> &frequencies, StkFloat amplitude);
+
   //! Perform the control change specified by \e number and \e value (0.0 -
   //! 128.0).
   /*!
@@ -122,6 +131,10 @@ public:
                   unsigned int iChannel = 0, unsigned int oChannel = 0);
 
 protected:
+  // Advance every string one sample.  The decay threshold is passed in so
+  // block callers hoist it out of the sample loop.
+  StkFloat tickSample(StkFloat input, unsigned int decayFrames);
+
   std::vector<stk::Twang> strings_;
   std::vector<int> stringState_; // 0 = off, 1 = decaying, 2 = on
   std::vector<unsigned int> decayCounter_;
@@ -135,17 +148,18 @@ protected:
   StkFrames lastFrame_;
 };
 
-inline StkFloat Guitar ::tick(StkFloat input) {
+inline StkFloat Guitar ::tickSample(StkFloat input, unsigned int decayFrames) {
   StkFloat temp, output = 0.0;
-  lastFrame_[0] /= strings_.size(); // evenly spread coupling across strings
+  StkFloat coupling =
+      lastFrame_[0] / strings_.size(); // evenly spread coupling across strings
+  unsigned long excitationFrames = excitation_.frames();
   for (unsigned int i = 0; i < strings_.size(); i++) {
     if (stringState_[i]) {
       temp = input;
       // If pluckGain < 0.2, let string ring but don't pluck it.
-      if (filePointer_[i] < excitation_.frames() && pluckGains_[i] > 0.2)
+      if (filePointer_[i] < excitationFrames && pluckGains_[i] > 0.2)
         temp += pluckGains_[i] * excitation_[filePointer_[i]++];
-      temp += couplingGain_ *
-              couplingFilter_.tick(lastFrame_[0]); // bridge coupling
+      temp += couplingGain_ * couplingFilter_.tick(coupling); // bridge coupling
       output += strings_[i].tick(temp);
       // Check if string energy has decayed sufficiently to turn it off.
       if (stringState_[i] == 1) {
@@ -153,7 +167,7 @@ inline StkFloat Guitar ::tick(StkFloat input) {
           decayCounter_[i]++;
         else
           decayCounter_[i] = 0;
-        if (decayCounter_[i] > (unsigned int)floor(0.1 * Stk::sampleRate())) {
+        if (decayCounter_[i] > decayFrames) {
           stringState_[i] = 0;
           decayCounter_[i] = 0;
         }
@@ -164,6 +178,10 @@ inline StkFloat Guitar ::tick(StkFloat input) {
   return lastFrame_[0] = output;
 }
 
+inline StkFloat Guitar ::tick(StkFloat input) {
+  return tickSample(input, (unsigned int)floor(0.1 * Stk::sampleRate()));
+}
+
 inline StkFrames &Guitar ::tick(StkFrames &frames, unsigned int channel) {
 #if defined(_STK_DEBUG_)
   if (channel >= frames.channels()) {
@@ -175,8 +193,9 @@ inline StkFrames &Guitar ::tick(StkFrames &frames, unsigned int channel) {
 
   StkFloat *samples = &frames[channel];
   unsigned int hop = frames.channels();
+  unsigned int decayFrames = (unsigned int)floor(0.1 * Stk::sampleRate());
   for (unsigned int i = 0; i < frames.frames(); i++, samples += hop)
-    *samples = tick(*samples);
+    *samples = tickSample(*samples, decayFrames);
 
   return frames;
 }
@@ -194,9 +213,10 @@ inline StkFrames &Guitar ::tick(StkFrames &iFrames, StkFrames &oFrames,
   StkFloat *iSamples = &iFrames[iChannel];
   StkFloat *oSamples = &oFrames[oChannel];
   unsigned int iHop = iFrames.channels(), oHop = oFrames.channels();
+  unsigned int decayFrames = (unsigned int)floor(0.1 * Stk::sampleRate());
   for (unsigned int i = 0; i < iFrames.frames();
        i++, iSamples += iHop, oSamples += oHop)
-    *oSamples = tick(*iSamples);
+    *oSamples = tickSample(*iSamples, decayFrames);
 
   return iFrames;
 }
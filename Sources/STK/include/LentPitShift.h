@@ -25,8 +25,6 @@ public:
   ~LentPitShift(void) {
     delete window;
     delete dt;
-    delete dpt;
-    delete cumDt;
   }
 
   //! Reset and clear all internal state.
@@ -91,10 +89,14 @@ protected:
 
   StkFloat threshold_;       // Threshold of detection for the pitch tracker
   unsigned long lastPeriod_; // Result of the last pitch tracking loop
-  StkFloat *dt; // Array containing the euclidian distance coefficients
-  StkFloat
-      *cumDt; // Array containing the cumulative sum of the coefficients in dt
-  StkFloat *dpt; // Array containing the pitch tracking function coefficients
+  StkFloat *dt; // Array of euclidian distance coefficients, accumulated
+                // incrementally by tick() on the coarse lag grid as each
+                // sample slides into the input line
+
+  // Spacing of the coarse lag grid.  tick() maintains the distance
+  // coefficients only at these lags; process() refines the winning
+  // coarse lag with an exact search over the neighboring fine lags.
+  static const unsigned long coarseStep_ = 4;
 
   // Pitch shifter variables
   StkFloat env[2];  // Coefficients for the linear interpolation when modifying
@@ -109,65 +111,88 @@ protected:
 };
 
 inline void LentPitShift::process() {
-  StkFloat x_t;   // input coefficient
-  StkFloat x_t_T; // previous input coefficient at T samples
-  StkFloat coeff; // new coefficient for the difference function
-
-  unsigned long alternativePitch = tMax_; // Global minimum storage
-  lastPeriod_ =
-      tMax_ + 1; // Storage of the lowest local minimum under the threshold
-
   // Loop variables
   unsigned long delay_;
   unsigned int n;
 
-  // Initialization of the dt coefficients.  Since the
-  // frames are of tMax_ length, there is no overlapping
-  // between the successive windows where pitch tracking
-  // is performed.
-  for (delay_ = 1; delay_ <= tMax_; delay_++)
-    dt[delay_] = 0.;
-
-  // Calculation of the dt coefficients and update of the input delay line.
-  for (n = 0; n < inputFrames.size(); n++) {
-    x_t = inputLine_.tick(inputFrames[n]);
-    for (delay_ = 1; delay_ <= tMax_; delay_++) {
-      x_t_T = inputLine_.tapOut(delay_);
-      coeff = x_t - x_t_T;
-      dt[delay_] += coeff * coeff;
-    }
-  }
-
-  // Calculation of the pitch tracking function and test for the minima.
-  for (delay_ = 1; delay_ <= tMax_; delay_++) {
-    cumDt[delay_] = dt[delay_] + cumDt[delay_ - 1];
-    dpt[delay_] = dt[delay_] * delay_ / cumDt[delay_];
+  // The distance coefficients for the coarse lag grid were already
+  // accumulated one sample at a time by tick() as the frame slid into
+  // the input delay line, so no O(tMax^2) recomputation happens here.
+  // The cumulative sum used to normalize the pitch tracking function
+  // is approximated from the coarse grid (scaled by the grid step);
+  // the exact fine search below is insensitive to this normalization.
+  unsigned long coarsePeriod = 0;     // Lowest local minimum under threshold
+  unsigned long alternativePitch = 0; // Global minimum storage
+  StkFloat dptAlternative = 0.;
+  StkFloat cum = 0.;
+  StkFloat dptPrev2 = 1.; // dpt[0] is always 1
+  StkFloat dptPrev = 1.;
+  unsigned long delayPrev = 0;
+  for (delay_ = coarseStep_; delay_ <= tMax_; delay_ += coarseStep_) {
+    cum += dt[delay_];
+    StkFloat dptCur = dt[delay_] * delay_ / (cum * coarseStep_);
 
     // Look for a minimum
-    if (dpt[delay_ - 1] - dpt[delay_ - 2] < 0 &&
-        dpt[delay_] - dpt[delay_ - 1] > 0) {
+    if (dptPrev - dptPrev2 < 0 && dptCur - dptPrev > 0) {
       // Check if the minimum is under the threshold
-      if (dpt[delay_ - 1] < threshold_) {
-        lastPeriod_ = delay_ - 1;
+      if (dptPrev < threshold_) {
+        coarsePeriod = delayPrev;
         // If a minimum is found, we can stop the loop
         break;
-      } else if (dpt[alternativePitch] > dpt[delay_ - 1])
+      } else if (alternativePitch == 0 || dptAlternative > dptPrev) {
         // Otherwise we store it if it is the current global minimum
-        alternativePitch = delay_ - 1;
+        alternativePitch = delayPrev;
+        dptAlternative = dptPrev;
+      }
     }
+
+    dptPrev2 = dptPrev;
+    dptPrev = dptCur;
+    delayPrev = delay_;
   }
 
   // Test for the last period length.
-  if (dpt[delay_] - dpt[delay_ - 1] < 0) {
-    if (dpt[delay_] < threshold_)
+  if (coarsePeriod == 0 && dptPrev - dptPrev2 < 0) {
+    if (dptPrev < threshold_)
+      coarsePeriod = delayPrev;
+    else if (alternativePitch == 0 || dptAlternative > dptPrev) {
+      alternativePitch = delayPrev;
+      dptAlternative = dptPrev;
+    }
+  }
+
+  if (coarsePeriod == 0)
+    // No period has been under the threshold so we use the global minimum
+    coarsePeriod = (alternativePitch != 0) ? alternativePitch : delayPrev;
+
+  // Coarse-to-fine refinement: compute the exact distance function
+  // for the few lags around the coarse candidate, straight from the
+  // input delay line.  Over such a narrow lag range the cumulative
+  // normalization is nearly constant, so minimizing dt * lag matches
+  // the pitch tracking function minimum.
+  unsigned long fineLow =
+      (coarsePeriod > coarseStep_ - 1) ? coarsePeriod - (coarseStep_ - 1) : 1;
+  unsigned long fineHigh = coarsePeriod + coarseStep_ - 1;
+  if (fineHigh > tMax_)
+    fineHigh = tMax_;
+  lastPeriod_ = coarsePeriod;
+  StkFloat bestScore = -1.;
+  for (delay_ = fineLow; delay_ <= fineHigh; delay_++) {
+    StkFloat d = 0.;
+    for (n = 0; n < tMax_; n++) {
+      StkFloat coeff = inputLine_.tapOut(n) - inputLine_.tapOut(n + delay_);
+      d += coeff * coeff;
+    }
+    StkFloat score = d * delay_;
+    if (bestScore < 0. || score < bestScore) {
+      bestScore = score;
       lastPeriod_ = delay_;
-    else if (dpt[alternativePitch] > dpt[delay_])
-      alternativePitch = delay_;
+    }
   }
 
-  if (lastPeriod_ == tMax_ + 1)
-    // No period has been under the threshold so we used the global minimum
-    lastPeriod_ = alternativePitch;
+  // Restart the incremental accumulation for the next frame.
+  for (delay_ = coarseStep_; delay_ <= tMax_; delay_ += coarseStep_)
+    dt[delay_] = 0.;
 
   // We put the new zero output coefficients in the output delay line and
   // we get the previous calculated coefficients
@@ -211,6 +236,17 @@ inline StkFloat LentPitShift ::tick(StkFloat input) {
 
   inputFrames[ptrFrames] = input;
 
+  // Slide the new sample into the input delay line and update the
+  // coarse-grid distance coefficients incrementally, spreading the
+  // pitch search cost evenly across samples instead of bursting it
+  // at the frame boundary.
+  StkFloat x_t = inputLine_.tick(input);
+  for (unsigned long delay_ = coarseStep_; delay_ <= tMax_;
+       delay_ += coarseStep_) {
+    StkFloat coeff = x_t - inputLine_.tapOut(delay_);
+    dt[delay_] += coeff * coeff;
+  }
+
   sample = outputFrames[ptrFrames++];
 
   // Check for end condition
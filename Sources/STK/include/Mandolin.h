@@ -1,7 +1,7 @@
 #pragma once
 
-#include "FileWvIn.h"
 #include "Instrmnt.h"
+#include "SharedWvIn.h"
 #include "Twang.h"
 
 namespace stk {
@@ -91,7 +91,7 @@ public:
 
 protected:
   Twang strings_[2];
-  FileWvIn soundfile_[12];
+  SharedWvIn soundfile_[12];
 
   int mic_;
   StkFloat detuning_;
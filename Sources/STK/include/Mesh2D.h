@@ -58,6 +58,19 @@ public:
   //! Set the loss filters gains (0.0 - 1.0).
   void setDecay(StkFloat decayFactor);
 
+  //! Enable or disable energy-gated sparse mesh updates.
+  /*!
+    When enabled, rows of scattering junctions are skipped whenever
+    neither they nor an adjacent row hold junction energy (summed
+    squared junction velocity) above \e energyFloor, so a mesh that
+    has decayed to silence in some region costs almost nothing there.
+    Because energy spreading toward a quiet region wakes that region
+    one row ahead of the wavefront, the gating error is bounded by the
+    floor itself.  Sparse updating is disabled by default and the
+    dense result is bit-exact with gating disabled.
+  */
+  void setSparseUpdate(bool enable, StkFloat energyFloor = 1.0e-9);
+
   //! Impulse the mesh with the given amplitude (frequency ignored).
   void noteOn(StkFloat frequency, StkFloat amplitude);
 
@@ -91,6 +104,17 @@ public:
 protected:
   StkFloat tick0();
   StkFloat tick1();
+
+  // Common scattering update shared by tick0() and tick1(), which
+  // differ only in which wave-variable buffer set is current.  Rows
+  // are contiguous in y, so the junction update runs row at a time
+  // (vectorized where available) and each row's energy is tracked for
+  // the sparse gate.
+  StkFloat tickMesh(StkFloat vxp[][NYMAX], StkFloat vxm[][NYMAX],
+                    StkFloat vyp[][NYMAX], StkFloat vym[][NYMAX],
+                    StkFloat vxp1[][NYMAX], StkFloat vxm1[][NYMAX],
+                    StkFloat vyp1[][NYMAX], StkFloat vym1[][NYMAX]);
+
   void clearMesh();
 
   unsigned short NX_, NY_;
@@ -110,6 +134,11 @@ protected:
   StkFloat vym1_[NXMAX][NYMAX]; // negative-y velocity wave
 
   int counter_; // time in samples
+
+  // Sparse update gating.
+  bool sparseUpdate_;
+  StkFloat energyFloor_;
+  StkFloat rowEnergy_[NXMAX]; // summed squared junction velocity per row
 };
 
 inline StkFrames &Mesh2D ::tick(StkFrames &frames, unsigned int channel) {
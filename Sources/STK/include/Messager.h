@@ -3,7 +3,8 @@
 
 #include "Skini.h"
 #include "Stk.h"
-#include <queue>
+#include <atomic>
+#include <vector>
 
 #if defined(__STK_REALTIME__)
 
@@ -32,7 +33,9 @@ namespace stk {
     socket, or stdin) take place asynchronously, filling the message
     queue.  A call to popMessage() will pop the next available control
     message from the queue and return it via the referenced Message
-    structure.  When a \e non-realtime scorefile is set, it is not
+    structure.  The popMessages() function instead drains every queued
+    message in one call, sorted by time stamp, without taking a lock
+    on the consumer side.  When a \e non-realtime scorefile is set, it is not
     possible to start reading realtime input messages (from MIDI,
     socket, or stdin).  Likewise, it is not possible to read from a
     scorefile when a realtime input mechanism is running.
@@ -58,12 +61,54 @@ public:
   // messager threads.  It must be public.
   struct MessagerData {
     Skini skini;
-    std::queue<Skini::Message> queue;
     unsigned int queueLimit;
     int sources;
 
+    // The message queue is a bounded ring buffer.  The input threads
+    // serialize among themselves with the mutex below, but the
+    // consumer (render) side reads with atomics only and never takes
+    // a lock.
+    std::vector<Skini::Message> ring;
+    std::atomic<unsigned long> ringHead; // next slot to write (producers)
+    std::atomic<unsigned long> ringTail; // next slot to read (consumer)
+
+    //! Return the number of queued messages.
+    unsigned long size(void) const {
+      unsigned long head = ringHead.load(std::memory_order_acquire);
+      unsigned long tail = ringTail.load(std::memory_order_acquire);
+      return (head + ring.size() - tail) % ring.size();
+    }
+
+    //! Queue a message, returning \c false when the ring is full.
+    /*!
+      When multiple input threads are running, this must be called
+      with the producer mutex held.
+    */
+    bool push(const Skini::Message &message) {
+      unsigned long head = ringHead.load(std::memory_order_relaxed);
+      unsigned long next = (head + 1) % ring.size();
+      if (next == ringTail.load(std::memory_order_acquire))
+        return false;
+      ring[head] = message;
+      ringHead.store(next, std::memory_order_release);
+      return true;
+    }
+
+    //! Dequeue a message, returning \c false when the ring is empty.
+    /*!
+      Consumer side only ... no lock is taken.
+    */
+    bool pop(Skini::Message &message) {
+      unsigned long tail = ringTail.load(std::memory_order_relaxed);
+      if (tail == ringHead.load(std::memory_order_acquire))
+        return false;
+      message = ring[tail];
+      ringTail.store((tail + 1) % ring.size(), std::memory_order_release);
+      return true;
+    }
+
 #if defined(__STK_REALTIME__)
-    Mutex mutex;
+    Mutex mutex; // serializes producers only, never the consumer
     RtMidiIn *midi;
     TcpServer *socket;
     std::vector<int> fd;
@@ -71,7 +116,7 @@ public:
 #endif
 
     // Default constructor.
-    MessagerData() : queueLimit(0), sources(0) {}
+    MessagerData() : queueLimit(0), sources(0), ringHead(0), ringTail(0) {}
   };
 
   //! Default constructor.
@@ -90,6 +135,18 @@ public:
   */
   void popMessage(Skini::Message &message);
 
+  //! Pop all currently queued messages into the referenced vector.
+  /*!
+    The vector is cleared and then filled with every message queued
+    at the time of the call, sorted by time stamp (the sort is
+    stable, so messages with equal time stamps keep their arrival
+    order).  This allows a render loop to drain the queue once per
+    buffer instead of once per tick period.  When a scorefile is
+    set, at most one message is delivered per call, as with
+    popMessage().  The number of messages delivered is returned.
+  */
+  unsigned int popMessages(std::vector<Skini::Message> &messages);
+
   //! Push the referenced message onto the message stack.
   void pushMessage(Skini::Message &message);
 
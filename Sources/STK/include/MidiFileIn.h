@@ -20,7 +20,11 @@ namespace stk {
     Event delta-times are returned in the form of "ticks" and a
     function is provided to determine the current "seconds per tick".
     Tempo changes are internally tracked by the class and reflected in
-    the values returned by the function getTickSeconds().
+    the values returned by the function getTickSeconds().  A per-track
+    index of reader-state checkpoints is built when a file is opened,
+    so the seekTrack() function can jump to an arbitrary tick position
+    with a binary search and a short forward parse instead of
+    re-reading the track from its beginning.
 
     by Gary P. Scavone, 2003 - 2010.
 */
@@ -59,6 +63,22 @@ public:
   */
   void rewindTrack(unsigned int track = 0);
 
+  //! Reposition the specified track event reader at the given absolute tick
+  //! count.
+  /*!
+      After this call, the next event delivered for the track is the
+      first event at or after \e tick ticks from the start of the
+      track, and the running status and tempo state are restored as
+      if the track had been read forward from its beginning.  A tick
+      value at or past the end of the track leaves the reader at the
+      track end.  Seeking is a binary search over the checkpoint
+      index built when the file was opened, followed by a forward
+      parse of at most one index interval of events.  If an invalid
+      track number is specified, an StkError exception will be
+      thrown.
+  */
+  void seekTrack(unsigned long tick, unsigned int track = 0);
+
   //! Get the current value, in seconds, of delta-time ticks for the specified
   //! track.
   /*!
@@ -110,6 +130,11 @@ protected:
   // successfully parsed.  Otherwise, it returns false.
   bool readVariableLength(unsigned long *value);
 
+  // Scan every track once and record a checkpoint of the complete
+  // reader state every trackIndexInterval_ events.  Called at the end
+  // of construction, after the tempo map has been parsed.
+  void buildTrackIndex(void);
+
   std::ifstream file_;
   unsigned int nTracks_;
   int format_;
@@ -131,6 +156,20 @@ protected:
   std::vector<TempoChange> tempoEvents_;
   std::vector<unsigned long> trackCounters_;
   std::vector<unsigned int> trackTempoIndex_;
+
+  // Everything needed to resume reading a track mid-stream, recorded
+  // at regular event intervals so seekTrack() never parses more than
+  // one interval of events.
+  struct TrackCheckpoint {
+    unsigned long count; // accumulated ticks at this event boundary
+    long pointer;        // file byte offset of the next event
+    char status;         // running status byte
+    double tickSeconds;
+    unsigned long counter;   // format 1 running tick sum
+    unsigned int tempoIndex; // format 1 tempo map position
+  };
+  static const unsigned long trackIndexInterval_ = 256; // events
+  std::vector<std::vector<TrackCheckpoint> > trackIndex_;
 };
 
 } // namespace stk
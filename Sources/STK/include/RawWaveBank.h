@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Stk.h"
+
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace stk {
+
+/***************************************************/
+/*! \class RawWaveBank
+    \brief STK shared wavetable registry class.
+
+    This class maintains a process-wide registry of immutable audio
+    tables loaded from file.  Each file is read from disk at most
+    once; subsequent acquisitions of the same file name return a
+    reference to the already loaded table, so many instrument voices
+    can share one copy of their wavetable data and instance
+    construction involves no disk I/O after the first voice.
+
+    Tables are reference counted.  Every successful call to acquire()
+    must be balanced by a call to release() with the same file name;
+    a table is freed when its last reference is released.  The
+    returned StkFrames reference remains valid until that point and
+    must never be modified.
+
+    Tables are keyed by file name only, so the \e raw and \e
+    doNormalize arguments of the first load apply to all subsequent
+    acquisitions of that file.
+
+    by Perry R. Cook and Gary P. Scavone, 1995--2016.
+*/
+/***************************************************/
+
+class RawWaveBank {
+public:
+  //! Return a reference to the shared table for \e fileName, loading it on
+  //! first acquisition.
+  /*!
+    An StkError is thrown if the file is not found, its format is
+    unknown, or a read error occurs.  If \e doNormalize is true, the
+    table is scaled to a maximum absolute value of 1.0 after loading.
+  */
+  static const StkFrames &acquire(const std::string &fileName, bool raw = false,
+                                  bool doNormalize = true);
+
+  //! Release one reference to the table for \e fileName.
+  /*!
+    The table is freed when its reference count reaches zero.  A
+    file name that is not currently registered is ignored.
+  */
+  static void release(const std::string &fileName);
+
+private:
+  //! This class provides only static functions and is never instantiated.
+  RawWaveBank(void) {}
+
+  struct Entry {
+    Entry(void) : refCount(0) {}
+    StkFrames data;
+    unsigned int refCount;
+  };
+
+  static std::map<std::string, Entry> tables_;
+  static std::mutex mutex_;
+};
+
+} // namespace stk
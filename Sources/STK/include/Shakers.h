@@ -118,6 +118,13 @@ protected:
   StkFloat noise();
   void waterDrop();
 
+  // Advance the whole resonator bank over a block of samples.  The biquad
+  // coefficients and recursion state are gathered into contiguous stack
+  // arrays once per block so the inner update vectorizes across the bank,
+  // and the decay and gain scalars stay in registers instead of being
+  // re-read from the object every sample.
+  void tickBlock(StkFloat *samples, unsigned int nFrames, unsigned int stride);
+
   int shakerType_;
   unsigned int nResonances_;
   StkFloat shakeEnergy_;
@@ -312,8 +319,7 @@ inline StkFrames &Shakers::tick(StkFrames &frames, unsigned int channel) {
   StkFloat *samples = &frames[channel];
   unsigned int j, hop = frames.channels() - nChannels;
   if (nChannels == 1) {
-    for (unsigned int i = 0; i < frames.frames(); i++, samples += hop)
-      *samples++ = tick();
+    this->tickBlock(samples, frames.frames(), frames.channels());
   } else {
     for (unsigned int i = 0; i < frames.frames(); i++, samples += hop) {
       *samples++ = tick();
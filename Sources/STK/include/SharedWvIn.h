@@ -0,0 +1,170 @@
+#pragma once
+
+#include "RawWaveBank.h"
+#include "WvIn.h"
+
+namespace stk {
+
+/***************************************************/
+/*! \class SharedWvIn
+    \brief STK shared wavetable input class.
+
+    This class inherits from WvIn and provides the same "tick-level",
+    variable-rate playback interface as FileWvIn, but plays a table
+    held by the process-wide RawWaveBank registry instead of a
+    per-instance copy of the file data.  The table is loaded from
+    disk only for the first instance that opens a given file; every
+    later open of the same file is a registry lookup, so instrument
+    voices that share their wavetables construct without disk I/O and
+    without duplicating the data.  Linear interpolation is used for
+    fractional read rates.
+
+    Because the table is shared and immutable, there is no support
+    for incremental (chunked) reading or for renormalizing the data
+    after loading.  Use FileWvIn when per-instance or very large file
+    data is required.
+
+    When the file end is reached, subsequent calls to the tick()
+    functions return zeros and isFinished() returns \e true.
+
+    by Perry R. Cook and Gary P. Scavone, 1995--2016.
+*/
+/***************************************************/
+
+class SharedWvIn : public WvIn {
+public:
+  //! Default constructor.
+  SharedWvIn(void);
+
+  //! Overloaded constructor for file input.
+  /*!
+    An StkError will be thrown if the file is not found, its format is
+    unknown, or a read error occurs.
+  */
+  SharedWvIn(std::string fileName, bool raw = false, bool doNormalize = true);
+
+  //! Class destructor.
+  ~SharedWvIn(void);
+
+  //! Open the specified file via the RawWaveBank registry.
+  /*!
+    A reference to a previously opened file is released by this
+    function.  An StkError will be thrown if the file is not found,
+    its format is unknown, or a read error occurs.
+  */
+  virtual void openFile(std::string fileName, bool raw = false,
+                        bool doNormalize = true);
+
+  //! Release the shared table if one is open.
+  virtual void closeFile(void);
+
+  //! Clear outputs and reset time (file) pointer to zero.
+  virtual void reset(void);
+
+  //! Return the file size in sample frames.
+  virtual unsigned long getSize(void) const { return fileSize_; };
+
+  //! Return the input file sample rate in Hz (not the data read rate).
+  /*!
+    WAV, SND, and AIF formatted files specify a sample rate in
+    their headers.  STK RAW files have a sample rate of 22050 Hz
+    by definition.  MAT-files are assumed to have a rate of 44100 Hz.
+  */
+  virtual StkFloat getFileRate(void) const {
+    return table_ ? table_->dataRate() : 0.0;
+  };
+
+  //! Return the number of audio channels in the shared table.
+  unsigned int channelsOut(void) const {
+    return table_ ? table_->channels() : 0;
+  };
+
+  //! Query whether a shared table is open.
+  bool isOpen(void) { return table_ != 0; };
+
+  //! Query whether reading is complete.
+  bool isFinished(void) const { return finished_; };
+
+  //! Set the data read rate in samples.  The rate can be negative.
+  /*!
+    If the rate value is negative, the data is read in reverse order.
+  */
+  virtual void setRate(StkFloat rate);
+
+  //! Increment the read pointer by \e time samples.
+  /*!
+    Note that this function will not modify the interpolation flag status.
+   */
+  virtual void addTime(StkFloat time);
+
+  //! Turn linear interpolation on/off.
+  /*!
+    Interpolation is automatically off when the read rate is
+    an integer value.  If interpolation is turned off for a
+    fractional rate, the time index is truncated to an integer
+    value.
+  */
+  void setInterpolate(bool doInterpolate) { interpolate_ = doInterpolate; };
+
+  //! Return the specified channel value of the last computed frame.
+  /*!
+    If no file is loaded, the returned value is 0.0.  The \c
+    channel argument must be less than the number of output channels,
+    which can be determined with the channelsOut() function (the first
+    channel is specified by 0).  However, range checking is only
+    performed if _STK_DEBUG_ is defined during compilation, in which
+    case an out-of-range value will trigger an StkError exception. \sa
+    lastFrame()
+  */
+  StkFloat lastOut(unsigned int channel = 0);
+
+  //! Compute a sample frame and return the specified \c channel value.
+  /*!
+    For multi-channel files, use the lastFrame() function to get
+    all values from the computed frame.  If no file data is loaded,
+    the returned value is 0.0.  The \c channel argument must be less
+    than the number of channels in the file data (the first channel is
+    specified by 0).  However, range checking is only performed if
+    _STK_DEBUG_ is defined during compilation, in which case an
+    out-of-range value will trigger an StkError exception.
+  */
+  virtual StkFloat tick(unsigned int channel = 0);
+
+  //! Fill the StkFrames object with computed sample frames, starting at the
+  //! specified channel and return the same reference.
+  /*!
+    The \c channel argument plus the number of input channels must
+    be less than the number of channels in the StkFrames argument (the
+    first channel is specified by 0).  However, range checking is only
+    performed if _STK_DEBUG_ is defined during compilation, in which
+    case an out-of-range value will trigger an StkError exception.
+  */
+  virtual StkFrames &tick(StkFrames &frames, unsigned int channel = 0);
+
+protected:
+  void sampleRateChanged(StkFloat newRate, StkFloat oldRate);
+
+  const StkFrames *table_; // shared table owned by the RawWaveBank
+  std::string fileName_;   // registry key for release on close
+  bool finished_;
+  bool interpolate_;
+  StkFloat time_;
+  StkFloat rate_;
+  unsigned long fileSize_;
+};
+
+inline StkFloat SharedWvIn::lastOut(unsigned int channel) {
+#if defined(_STK_DEBUG_)
+  if (channel >= lastFrame_.channels()) {
+    oStream_ << "SharedWvIn::lastOut(): channel argument and table data are "
+                "incompatible!";
+    handleError(StkError::FUNCTION_ARGUMENT);
+  }
+#endif
+
+  if (finished_)
+    return 0.0;
+  return lastFrame_[channel];
+}
+
+} // namespace stk
@@ -246,6 +246,72 @@ protected:
   void handleError(StkError::Type type) const;
 };
 
+/***************************************************/
+/*! \class StkChannelView
+    \brief A zero-copy view of one channel of interleaved audio data.
+
+    The view holds a pointer into an StkFrames object's interleaved
+    data plus the channel hop, so per-channel reads and writes need no
+    intermediate StkFrames copy (compare StkFrames::getChannel, which
+    copies).  The view is valid until the underlying StkFrames is
+    resized or destroyed.  Use StkFrames::channel() to obtain one.
+
+    The bulk copyTo / copyFrom / accumulateTo routines use vectorized
+    strided operations where the platform provides them, so moving a
+    channel between STK and an external deinterleaved buffer is a
+    single pass rather than an element-at-a-time loop.
+*/
+/***************************************************/
+
+class StkChannelView {
+public:
+  //! Construct a view from raw interleaved data.
+  /*!
+    \c data points at the first sample of the channel, \c nFrames is
+    the number of frames visible through the view and \c hop is the
+    distance in samples between consecutive frames of the channel
+    (i.e. the channel count of the interleaved buffer).
+  */
+  StkChannelView(StkFloat *data, size_t nFrames, unsigned int hop)
+      : data_(data), nFrames_(nFrames), hop_(hop){};
+
+  //! Frame subscript operator that returns a reference.
+  StkFloat &operator[](size_t frame) { return data_[frame * hop_]; };
+
+  //! Frame subscript operator that returns a value.
+  StkFloat operator[](size_t frame) const { return data_[frame * hop_]; };
+
+  //! Return the number of sample frames visible through the view.
+  size_t frames(void) const { return nFrames_; };
+
+  //! Return the hop, in samples, between consecutive frames.
+  unsigned int hop(void) const { return hop_; };
+
+  //! Copy the channel into a contiguous destination buffer.
+  /*!
+    \c destination must hold at least frames() samples.
+  */
+  void copyTo(StkFloat *destination) const;
+
+  //! Fill the channel from a contiguous source buffer.
+  /*!
+    \c source must hold at least frames() samples.
+  */
+  void copyFrom(const StkFloat *source);
+
+  //! Accumulate \c gain times the channel into a contiguous destination
+  //! buffer.
+  /*!
+    \c destination must hold at least frames() samples.
+  */
+  void accumulateTo(StkFloat *destination, StkFloat gain) const;
+
+private:
+  StkFloat *data_;
+  size_t nFrames_;
+  unsigned int hop_;
+};
+
 /***************************************************/
 /*! \class StkFrames
     \brief An STK class to handle vectorized audio data.
@@ -333,6 +399,53 @@ public:
   */
   void operator*=(StkFrames &f);
 
+  //! Add the elements of \c f into self.
+  /*!
+    The dimensions of the argument are expected to be the same as
+    self.  Uses vectorized operations where the platform provides
+    them; operator+= delegates here.
+  */
+  void add(const StkFrames &f);
+
+  //! Multiply self, element-wise, by the elements of \c f.
+  /*!
+    The dimensions of the argument are expected to be the same as
+    self.  Uses vectorized operations where the platform provides
+    them; operator*= delegates here.
+  */
+  void multiply(const StkFrames &f);
+
+  //! Multiply every element of self by \c gain.
+  /*!
+    Uses vectorized operations where the platform provides them.
+  */
+  void scale(StkFloat gain);
+
+  //! Accumulate \c gain times the elements of \c f into self.
+  /*!
+    The dimensions of the argument are expected to be the same as
+    self.  This is the usual mixing primitive (self += gain * f) and
+    uses a fused scalar-multiply-add where the platform provides one.
+  */
+  void mixAccumulate(const StkFrames &f, StkFloat gain);
+
+  //! Exchange the contents of self with \c f without copying sample data.
+  /*!
+    Only the internal pointers and dimensions are exchanged, so this
+    is constant-time regardless of size.  Useful for double-buffering
+    schemes where one buffer is filled while the other is read.
+  */
+  void swap(StkFrames &f);
+
+  //! Return a zero-copy StkChannelView of channel \c channel.
+  /*!
+    The view is valid until the resize function is called or the
+    array is destroyed.  The \c channel index must be between 0 and
+    channels() - 1.  No range checking is performed unless
+    _STK_DEBUG_ is defined.
+  */
+  StkChannelView channel(unsigned int channel);
+
   //! Channel / frame subscript operator that returns a reference.
   /*!
     The result can be used as an lvalue. This reference is valid
@@ -523,10 +636,7 @@ inline void StkFrames::operator+=(StkFrames &f) {
   }
 #endif
 
-  StkFloat *fptr = &f[0];
-  StkFloat *dptr = data_;
-  for (unsigned int i = 0; i < size_; i++)
-    *dptr++ += *fptr++;
+  this->add(f);
 }
 
 inline void StkFrames::operator*=(StkFrames &f) {
@@ -539,10 +649,45 @@ inline void StkFrames::operator*=(StkFrames &f) {
   }
 #endif
 
-  StkFloat *fptr = &f[0];
-  StkFloat *dptr = data_;
-  for (unsigned int i = 0; i < size_; i++)
-    *dptr++ *= *fptr++;
+  this->multiply(f);
+}
+
+inline void StkFrames::swap(StkFrames &f) {
+  StkFloat *data = data_;
+  data_ = f.data_;
+  f.data_ = data;
+
+  StkFloat dataRate = dataRate_;
+  dataRate_ = f.dataRate_;
+  f.dataRate_ = dataRate;
+
+  size_t nFrames = nFrames_;
+  nFrames_ = f.nFrames_;
+  f.nFrames_ = nFrames;
+
+  unsigned int nChannels = nChannels_;
+  nChannels_ = f.nChannels_;
+  f.nChannels_ = nChannels;
+
+  size_t size = size_;
+  size_ = f.size_;
+  f.size_ = size;
+
+  size_t bufferSize = bufferSize_;
+  bufferSize_ = f.bufferSize_;
+  f.bufferSize_ = bufferSize;
+}
+
+inline StkChannelView StkFrames::channel(unsigned int channel) {
+#if defined(_STK_DEBUG_)
+  if (channel >= nChannels_) {
+    std::ostringstream error;
+    error << "StkFrames::channel: invalid channel (" << channel << ") value!";
+    Stk::handleError(error.str(), StkError::MEMORY_ACCESS);
+  }
+#endif
+
+  return StkChannelView(data_ + channel, nFrames_, nChannels_);
 }
 
 // Here are a few other useful typedefs.
@@ -25,8 +25,19 @@ typedef unsigned long sp_frame;
 typedef struct sp_auxdata {
     size_t size;
     void *ptr;
+    char arena;
 } sp_auxdata;
 
+/* Optional slab allocator. After sp_arena_create, auxdata and ftbl state is
+ * carved out of one block instead of individual mallocs, so a whole patch's
+ * state is contiguous and sp_arena_destroy reclaims all of it at once.
+ * Allocations that don't fit in the slab fall back to malloc transparently. */
+typedef struct sp_arena {
+    char *mem;
+    size_t size;
+    size_t used;
+} sp_arena;
+
 typedef struct sp_data {
     SPFLOAT *out;
     int sr;
@@ -35,6 +46,7 @@ typedef struct sp_data {
     unsigned long pos;
     char filename[200];
     uint32_t rand;
+    struct sp_arena *arena;
 } sp_data;
 
 typedef struct {
@@ -45,6 +57,19 @@ typedef struct {
 int sp_auxdata_alloc(sp_auxdata *aux, size_t size);
 int sp_auxdata_free(sp_auxdata *aux);
 
+int sp_arena_create(sp_data *sp, size_t size);
+int sp_arena_destroy(sp_data *sp);
+/* returns NULL if no arena is set or the slab is exhausted */
+void *sp_arena_alloc(sp_data *sp, size_t size);
+
+/* Optional allocation accounting hook. When set, the heap allocations made
+ * at the library's choke points — ftables, auxdata, arena slabs — report
+ * signed byte deltas tagged with the site name ("ftbl", "auxdata", "arena").
+ * Arena-backed blocks are covered by the slab's own report. The host
+ * installs this once at startup; it is called from whichever thread
+ * allocates, never the audio callback. */
+extern void (*sp_alloc_report)(const char *tag, long bytes);
+
 int sp_create(sp_data **spp);
 int sp_createn(sp_data **spp, int nchan);
 
@@ -64,10 +89,19 @@ uint32_t sp_rand(sp_data *sp);
 void sp_srand(sp_data *sp, uint32_t val);
 
 
+/* sp_fft is a pluggable interface: lib/fft/fft.c holds the portable
+ * implementation, lib/fft/fft_vdsp.c an Accelerate-backed one chosen by
+ * defining SOUNDPIPE_USE_VDSP (see Package.swift). Both produce the same
+ * packed layout and scaling. */
 typedef struct {
     SPFLOAT *utbl;
     int16_t *BRLow;
     int16_t *BRLowCpx;
+    /* used by the vDSP backend only; kept unconditional so the struct
+     * layout is the same in every target that includes this header */
+    void *setup;    /* FFTSetup */
+    SPFLOAT *tmp;   /* split-complex scratch */
+    int M;
 } sp_fft;
 
 void sp_fft_create(sp_fft **fft);
@@ -98,12 +132,36 @@ typedef struct sp_ftbl{
     SPFLOAT sicvt;
     SPFLOAT *tbl;
     char del;
+    char arena;      /* struct allocated from the sp arena slab */
+    char tbl_arena;  /* tbl allocated from the sp arena slab */
+    void *cache;     /* shared-table cache entry when tbl is interned */
+    void *filemap;   /* shared file mapping when tbl aliases an mmap'd file */
 }sp_ftbl;
 
 int sp_ftbl_create(sp_data *sp, sp_ftbl **ft, size_t size);
 int sp_ftbl_init(sp_data *sp, sp_ftbl *ft, size_t size);
 int sp_ftbl_bind(sp_data *sp, sp_ftbl **ft, SPFLOAT *tbl, size_t size);
+int sp_ftbl_view(sp_data *sp, sp_ftbl **ft, sp_ftbl *parent, size_t offset, size_t size);
 int sp_ftbl_destroy(sp_ftbl **ft);
+
+/* process-wide interned table cache: identical generated tables are
+ * shared across sp_data instances via read-only aliases */
+int sp_ftbl_cache_get(sp_data *sp, sp_ftbl **ft, size_t size,
+        const char *name, int (*gen)(sp_data *, sp_ftbl *));
+int sp_ftbl_cache_get_args(sp_data *sp, sp_ftbl **ft, size_t size,
+        const char *name, const char *args,
+        int (*gen)(sp_data *, sp_ftbl *, const char *));
+int sp_ftbl_cache_get_data(sp_data *sp, sp_ftbl **ft,
+        const SPFLOAT *data, size_t size);
+int sp_ftbl_cache_cow(sp_data *sp, sp_ftbl **ft);
+int sp_ftbl_cache_prefetch(size_t size, const char *name,
+        int (*gen)(sp_data *, sp_ftbl *));
+int sp_ftbl_cache_prefetch_args(size_t size, const char *name,
+        const char *args,
+        int (*gen)(sp_data *, sp_ftbl *, const char *));
+int sp_ftbl_cache_prefetch_run(void);
+void sp_ftbl_cache_release(sp_ftbl *ft);
+int sp_ftbl_cache_clear(void);
 int sp_gen_vals(sp_data *sp, sp_ftbl *ft, const char *string);
 int sp_gen_sine(sp_data *sp, sp_ftbl *ft);
 int sp_gen_file(sp_data *sp, sp_ftbl *ft, const char *filename);
@@ -112,6 +170,25 @@ int sp_gen_line(sp_data *sp, sp_ftbl *ft, const char *argstring);
 int sp_gen_xline(sp_data *sp, sp_ftbl *ft, const char *argstring);
 int sp_gen_gauss(sp_data *sp, sp_ftbl *ft, SPFLOAT scale, uint32_t seed);
 int sp_ftbl_loadfile(sp_data *sp, sp_ftbl **ft, const char *filename);
+
+/* memory-mapped loading: float-format files are mapped read-only and
+ * shared across every ftable referencing the same path; other formats
+ * fall back to sp_ftbl_loadfile */
+int sp_ftbl_loadfile_mmap(sp_data *sp, sp_ftbl **ft, const char *filename);
+void sp_ftbl_filemap_release(sp_ftbl *ft);
+int sp_ftbl_filemap_clear(void);
+
+/* streaming loading: the table is sized from the file header and a
+ * background thread decodes into it, publishing a loaded-sample
+ * watermark */
+typedef struct sp_ftbl_stream sp_ftbl_stream;
+int sp_ftbl_stream_create(sp_data *sp, sp_ftbl_stream **stream,
+        const char *filename);
+sp_ftbl * sp_ftbl_stream_ftbl(sp_ftbl_stream *stream);
+size_t sp_ftbl_stream_loaded(sp_ftbl_stream *stream);
+int sp_ftbl_stream_done(sp_ftbl_stream *stream);
+int sp_ftbl_stream_error(sp_ftbl_stream *stream);
+int sp_ftbl_stream_destroy(sp_ftbl_stream **stream);
 int sp_ftbl_loadspa(sp_data *sp, sp_ftbl **ft, const char *filename);
 int sp_gen_composite(sp_data *sp, sp_ftbl *ft, const char *argstring);
 int sp_gen_rand(sp_data *sp, sp_ftbl *ft, const char *argstring);
@@ -147,6 +224,7 @@ int sp_adsr_create(sp_adsr **p);
 int sp_adsr_destroy(sp_adsr **p);
 int sp_adsr_init(sp_data *sp, sp_adsr *p);
 int sp_adsr_compute(sp_data *sp, sp_adsr *p, SPFLOAT *in, SPFLOAT *out);
+int sp_adsr_compute_block(sp_data *sp, sp_adsr *p, SPFLOAT *in, SPFLOAT *out, int n);
 typedef struct {
     SPFLOAT revtime, looptime;
     SPFLOAT coef, prvt;
@@ -159,6 +237,7 @@ int sp_allpass_create(sp_allpass **p);
 int sp_allpass_destroy(sp_allpass **p);
 int sp_allpass_init(sp_data *sp, sp_allpass *p, SPFLOAT looptime);
 int sp_allpass_compute(sp_data *sp, sp_allpass *p, SPFLOAT *in, SPFLOAT *out);
+int sp_allpass_compute_block(sp_data *sp, sp_allpass *p, SPFLOAT *in, SPFLOAT *out, int n);
 typedef struct {
     SPFLOAT hp;
     SPFLOAT c1, c2, yt1, prvhp;
@@ -182,6 +261,7 @@ int sp_autowah_create(sp_autowah **p);
 int sp_autowah_destroy(sp_autowah **p);
 int sp_autowah_init(sp_data *sp, sp_autowah *p);
 int sp_autowah_compute(sp_data *sp, sp_autowah *p, SPFLOAT *in, SPFLOAT *out);
+int sp_autowah_compute_block(sp_data *sp, sp_autowah *p, SPFLOAT *in, SPFLOAT *out, int n);
 typedef struct sp_bal{
     SPFLOAT asig, csig, ihp;
     SPFLOAT c1, c2, prvq, prvr, prva;
@@ -191,6 +271,8 @@ int sp_bal_create(sp_bal **p);
 int sp_bal_destroy(sp_bal **p);
 int sp_bal_init(sp_data *sp, sp_bal *p);
 int sp_bal_compute(sp_data *sp, sp_bal *p, SPFLOAT *sig, SPFLOAT *comp, SPFLOAT *out);
+int sp_bal_compute_block(sp_data *sp, sp_bal *p, SPFLOAT *sig, SPFLOAT *comp,
+                         SPFLOAT *out, int n);
 typedef struct {
     SPFLOAT bcL, bcR, iK, ib, scan, T30;
     SPFLOAT pos, vel, wid;
@@ -206,6 +288,7 @@ int sp_bar_create(sp_bar **p);
 int sp_bar_destroy(sp_bar **p);
 int sp_bar_init(sp_data *sp, sp_bar *p, SPFLOAT iK, SPFLOAT ib);
 int sp_bar_compute(sp_data *sp, sp_bar *p, SPFLOAT *in, SPFLOAT *out);
+int sp_bar_compute_block(sp_data *sp, sp_bar *p, SPFLOAT *in, SPFLOAT *out, int n);
 typedef struct{
     SPFLOAT b0, b1, b2, a0, a1, a2, reinit, xnm1, xnm2, ynm1, ynm2, cutoff, res;
     SPFLOAT sr;
@@ -290,6 +373,7 @@ int sp_brown_create(sp_brown **p);
 int sp_brown_destroy(sp_brown **p);
 int sp_brown_init(sp_data *sp, sp_brown *p);
 int sp_brown_compute(sp_data *sp, sp_brown *p, SPFLOAT *in, SPFLOAT *out);
+int sp_brown_compute_block(sp_data *sp, sp_brown *p, SPFLOAT *in, SPFLOAT *out, int n);
 typedef struct {
     SPFLOAT sr, freq, bw, istor;
     SPFLOAT lkf, lkb;
@@ -323,6 +407,7 @@ int sp_buthp_create(sp_buthp **p);
 int sp_buthp_destroy(sp_buthp **p);
 int sp_buthp_init(sp_data *sp, sp_buthp *p);
 int sp_buthp_compute(sp_data *sp, sp_buthp *p, SPFLOAT *in, SPFLOAT *out);
+int sp_buthp_compute_block(sp_data *sp, sp_buthp *p, SPFLOAT *in, SPFLOAT *out, int n);
 typedef struct  {
     SPFLOAT sr, freq, istor;
     SPFLOAT lkf;
@@ -334,6 +419,7 @@ int sp_butlp_create(sp_butlp **p);
 int sp_butlp_destroy(sp_butlp **p);
 int sp_butlp_init(sp_data *sp, sp_butlp *p);
 int sp_butlp_compute(sp_data *sp, sp_butlp *p, SPFLOAT *in, SPFLOAT *out);
+int sp_butlp_compute_block(sp_data *sp, sp_butlp *p, SPFLOAT *in, SPFLOAT *out, int n);
 typedef struct {
     SPFLOAT min;
     SPFLOAT max;
@@ -361,6 +447,7 @@ int sp_clock_create(sp_clock **p);
 int sp_clock_destroy(sp_clock **p);
 int sp_clock_init(sp_data *sp, sp_clock *p);
 int sp_clock_compute(sp_data *sp, sp_clock *p, SPFLOAT *trig, SPFLOAT *out);
+int sp_clock_compute_kr(sp_data *sp, sp_clock *p, SPFLOAT *trig, SPFLOAT *out, int n, int *offset);
 typedef struct sp_comb{
     SPFLOAT revtime, looptime;
     SPFLOAT coef, prvt;
@@ -373,6 +460,7 @@ int sp_comb_create(sp_comb **p);
 int sp_comb_destroy(sp_comb **p);
 int sp_comb_init(sp_data *sp, sp_comb *p, SPFLOAT looptime);
 int sp_comb_compute(sp_data *sp, sp_comb *p, SPFLOAT *in, SPFLOAT *out);
+int sp_comb_compute_block(sp_data *sp, sp_comb *p, SPFLOAT *in, SPFLOAT *out, int n);
 typedef struct {
     void *faust;
     int argpos;
@@ -387,6 +475,7 @@ int sp_compressor_create(sp_compressor **p);
 int sp_compressor_destroy(sp_compressor **p);
 int sp_compressor_init(sp_data *sp, sp_compressor *p);
 int sp_compressor_compute(sp_data *sp, sp_compressor *p, SPFLOAT *in, SPFLOAT *out);
+int sp_compressor_compute_det(sp_data *sp, sp_compressor *p, SPFLOAT *in, SPFLOAT *det, SPFLOAT *out);
 typedef struct sp_count{
     int32_t count, curcount;
     int mode;
@@ -417,10 +506,48 @@ typedef struct {
     sp_fft fft;
 } sp_conv;
 
+/* Frequency-domain impulse-response partitions, held separately from
+ * per-instance sp_conv state so one preprocessed IR can be shared by many
+ * instances and cached to disk; re-init becomes a pointer swap. */
+typedef struct sp_conv_ir {
+    int partSize;
+    int nPartitions;
+    SPFLOAT *data;   /* nPartitions blocks of partSize*2 samples */
+    sp_auxdata aux;
+} sp_conv_ir;
+
 int sp_conv_create(sp_conv **p);
 int sp_conv_destroy(sp_conv **p);
 int sp_conv_init(sp_data *sp, sp_conv *p, sp_ftbl *ft, SPFLOAT iPartLen);
 int sp_conv_compute(sp_data *sp, sp_conv *p, SPFLOAT *in, SPFLOAT *out);
+
+int sp_conv_ir_create(sp_conv_ir **ir);
+int sp_conv_ir_destroy(sp_conv_ir **ir);
+int sp_conv_ir_init(sp_data *sp, sp_conv_ir *ir, sp_ftbl *ft, SPFLOAT iPartLen);
+int sp_conv_ir_save(sp_conv_ir *ir, const char *path);
+int sp_conv_ir_load(sp_data *sp, sp_conv_ir *ir, const char *path);
+/* like sp_conv_init, but borrows a preprocessed IR instead of re-FFTing;
+ * the IR must outlive the instance */
+int sp_conv_init_ir(sp_data *sp, sp_conv *p, sp_conv_ir *ir);
+
+/* Two-stage non-uniform partitioned convolution: a head convolver with
+ * short partitions (= overall latency) covers the start of the IR, and a
+ * tail convolver with long partitions covers the rest, aligned so the sum
+ * equals a single convolution at the head's latency. Gives short-partition
+ * latency at close to long-partition CPU cost on long IRs. */
+typedef struct {
+    sp_conv head;
+    sp_conv tail;
+    int hasTail;
+    int headPartSize;
+    int tailPartSize;
+} sp_nconv;
+
+int sp_nconv_create(sp_nconv **p);
+int sp_nconv_destroy(sp_nconv **p);
+int sp_nconv_init(sp_data *sp, sp_nconv *p, sp_ftbl *ft,
+                  SPFLOAT iHeadPartLen, SPFLOAT iTailPartLen);
+int sp_nconv_compute(sp_data *sp, sp_nconv *p, SPFLOAT *in, SPFLOAT *out);
 typedef struct {
     SPFLOAT pos;
 } sp_crossfade;
@@ -470,12 +597,14 @@ typedef struct {
     SPFLOAT freq;
     SPFLOAT K;
     SPFLOAT res;
+    SPFLOAT pfreq;
 } sp_diode;
 
 int sp_diode_create(sp_diode **p);
 int sp_diode_destroy(sp_diode **p);
 int sp_diode_init(sp_data *sp, sp_diode *p);
 int sp_diode_compute(sp_data *sp, sp_diode *p, SPFLOAT *in, SPFLOAT *out);
+int sp_diode_compute_block(sp_data *sp, sp_diode *p, SPFLOAT *in, SPFLOAT *out, int n);
 typedef struct sp_dist{
     SPFLOAT pregain, postgain, shape1, shape2, mode;
 } sp_dist;
@@ -571,6 +700,7 @@ int sp_dust_create(sp_dust **p);
 int sp_dust_destroy(sp_dust **p);
 int sp_dust_init(sp_data *sp, sp_dust *p);
 int sp_dust_compute(sp_data *sp, sp_dust *p, SPFLOAT *in, SPFLOAT *out);
+int sp_dust_compute_block(sp_data *sp, sp_dust *p, SPFLOAT *in, SPFLOAT *out, int n);
 typedef struct {
     SPFLOAT freq, amp, iphs;
     int32_t   lphs;
@@ -628,6 +758,7 @@ int sp_fof_create(sp_fof **p);
 int sp_fof_destroy(sp_fof **p);
 int sp_fof_init(sp_data *sp, sp_fof *p, sp_ftbl *sine, sp_ftbl *win, int iolaps, SPFLOAT iphs);
 int sp_fof_compute(sp_data *sp, sp_fof *p, SPFLOAT *in, SPFLOAT *out);
+int sp_fof_compute_block(sp_data *sp, sp_fof *p, SPFLOAT *in, SPFLOAT *out, int n);
 typedef struct sp_fog_overlap {
     struct sp_fog_overlap *nxtact;
     struct sp_fog_overlap *nxtfree;
@@ -653,6 +784,7 @@ int sp_fog_create(sp_fog **p);
 int sp_fog_destroy(sp_fog **p);
 int sp_fog_init(sp_data *sp, sp_fog *p, sp_ftbl *wav, sp_ftbl *win, int iolaps, SPFLOAT iphs);
 int sp_fog_compute(sp_data *sp, sp_fog *p, SPFLOAT *in, SPFLOAT *out);
+int sp_fog_compute_block(sp_data *sp, sp_fog *p, SPFLOAT *in, SPFLOAT *out, int n);
 typedef struct{
     SPFLOAT freq, atk, dec, istor;
     SPFLOAT tpidsr;
@@ -682,6 +814,7 @@ int sp_fosc_create(sp_fosc **p);
 int sp_fosc_destroy(sp_fosc **p);
 int sp_fosc_init(sp_data *sp, sp_fosc *p, sp_ftbl *ft);
 int sp_fosc_compute(sp_data *sp, sp_fosc *p, SPFLOAT *in, SPFLOAT *out);
+int sp_fosc_compute_block(sp_data *sp, sp_fosc *p, SPFLOAT *in, SPFLOAT *out, int n);
 typedef struct {
         SPFLOAT amp, freq, nharm, lharm, mul, iphs;
         int16_t ampcod, cpscod, prvn;
@@ -704,6 +837,8 @@ int sp_hilbert_create(sp_hilbert **p);
 int sp_hilbert_destroy(sp_hilbert **p);
 int sp_hilbert_init(sp_data *sp, sp_hilbert *p);
 int sp_hilbert_compute(sp_data *sp, sp_hilbert *p, SPFLOAT *in, SPFLOAT *out1, SPFLOAT *out2);
+int sp_hilbert_compute_block(sp_data *sp, sp_hilbert *p,
+    SPFLOAT *in, SPFLOAT *out1, SPFLOAT *out2, int n);
 typedef struct {
     FILE *fp;
 } sp_in;
@@ -743,6 +878,7 @@ int sp_jitter_create(sp_jitter **p);
 int sp_jitter_destroy(sp_jitter **p);
 int sp_jitter_init(sp_data *sp, sp_jitter *p);
 int sp_jitter_compute(sp_data *sp, sp_jitter *p, SPFLOAT *in, SPFLOAT *out);
+int sp_jitter_compute_kr(sp_data *sp, sp_jitter *p, SPFLOAT *in, SPFLOAT *out, int n);
 typedef struct {
     SPFLOAT a, dur, b;
     SPFLOAT val, incr;
@@ -754,6 +890,7 @@ int sp_line_create(sp_line **p);
 int sp_line_destroy(sp_line **p);
 int sp_line_init(sp_data *sp, sp_line *p);
 int sp_line_compute(sp_data *sp, sp_line *p, SPFLOAT *in, SPFLOAT *out);
+int sp_line_compute_kr(sp_data *sp, sp_line *p, SPFLOAT *in, SPFLOAT *out, int n);
 typedef struct sp_lpf18{
     SPFLOAT cutoff, res, dist;
     SPFLOAT ay1, ay2, aout, lastin, onedsr;
@@ -784,6 +921,19 @@ int sp_metro_create(sp_metro **p);
 int sp_metro_destroy(sp_metro **p);
 int sp_metro_init(sp_data *sp, sp_metro *p);
 int sp_metro_compute(sp_data *sp, sp_metro *p, SPFLOAT *in, SPFLOAT *out);
+int sp_metro_compute_kr(sp_data *sp, sp_metro *p, SPFLOAT *in, SPFLOAT *out, int n, int *offset);
+/* shared phase-vocoder analysis cache: spectral frames of a source
+ * table, memoized so instances stretching the same table at the same
+ * positions analyze each frame once */
+typedef struct {
+    sp_ftbl *ft;
+    SPFLOAT *tbl;    /* table pointer the frames were computed from */
+    int N;
+    uint32_t nslots;
+    long *pos;       /* read position per slot, -1 = empty */
+    SPFLOAT *spec;   /* nslots frames of N + 2 bins */
+} sp_mincer_cache;
+
 typedef struct {
     SPFLOAT time, amp, pitch, lock, iN,
         idecim, onset, offset, dbthresh;
@@ -797,12 +947,20 @@ typedef struct {
     SPFLOAT resamp;
     sp_ftbl *ft;
     sp_fft fft;
+    sp_mincer_cache *cache;
 } sp_mincer;
 
 int sp_mincer_create(sp_mincer **p);
 int sp_mincer_destroy(sp_mincer **p);
 int sp_mincer_init(sp_data *sp, sp_mincer *p, sp_ftbl *ft, int winsize);
 int sp_mincer_compute(sp_data *sp, sp_mincer *p, SPFLOAT *in, SPFLOAT *out);
+int sp_mincer_compute_block(sp_data *sp, sp_mincer *p, SPFLOAT *time,
+        SPFLOAT *out, int nframes);
+int sp_mincer_cache_create(sp_mincer_cache **c);
+int sp_mincer_cache_init(sp_data *sp, sp_mincer_cache *c, sp_ftbl *ft,
+        int winsize);
+int sp_mincer_set_cache(sp_mincer *p, sp_mincer_cache *c);
+int sp_mincer_cache_destroy(sp_mincer_cache **c);
 typedef struct{
     SPFLOAT freq, q, xnm1, ynm1, ynm2, a0, a1, a2, d, lfq, lq;
     SPFLOAT sr;
@@ -812,6 +970,25 @@ int sp_mode_create(sp_mode **p);
 int sp_mode_destroy(sp_mode **p);
 int sp_mode_init(sp_data *sp, sp_mode *p);
 int sp_mode_compute(sp_data *sp, sp_mode *p, SPFLOAT *in, SPFLOAT *out);
+typedef struct{
+    int nmodes;
+    sp_auxdata aux;
+    /* per-mode parameters */
+    SPFLOAT *freq, *q, *gain;
+    /* last seen parameter values, for change detection */
+    SPFLOAT *lfreq, *lq;
+    /* per-mode coefficients and filter state */
+    SPFLOAT *a0, *a1, *a2, *d;
+    SPFLOAT *ynm1, *ynm2;
+    SPFLOAT xnm1;
+    SPFLOAT sr;
+}sp_modebank;
+
+int sp_modebank_create(sp_modebank **p);
+int sp_modebank_destroy(sp_modebank **p);
+int sp_modebank_init(sp_data *sp, sp_modebank *p, int nmodes);
+int sp_modebank_compute(sp_data *sp, sp_modebank *p, SPFLOAT *in, SPFLOAT *out);
+int sp_modebank_compute_block(sp_data *sp, sp_modebank *p, SPFLOAT *in, SPFLOAT *out, int n);
 typedef struct {
     SPFLOAT freq;
     SPFLOAT res;
@@ -829,6 +1006,9 @@ int sp_moogladder_create(sp_moogladder **t);
 int sp_moogladder_destroy(sp_moogladder **t);
 int sp_moogladder_init(sp_data *sp, sp_moogladder *p);
 int sp_moogladder_compute(sp_data *sp, sp_moogladder *p, SPFLOAT *in, SPFLOAT *out);
+int sp_moogladder_compute_block(sp_data *sp, sp_moogladder *p, SPFLOAT *in, SPFLOAT *out, int n);
+int sp_moogladder_compute_block_stereo(sp_data *sp, sp_moogladder *left, sp_moogladder *right,
+    SPFLOAT *inl, SPFLOAT *inr, SPFLOAT *outl, SPFLOAT *outr, int n);
 typedef struct{
     SPFLOAT amp;
 }sp_noise;
@@ -836,6 +1016,7 @@ typedef struct{
 int sp_noise_create(sp_noise **ns);
 int sp_noise_init(sp_data *sp, sp_noise *ns);
 int sp_noise_compute(sp_data *sp, sp_noise *ns, SPFLOAT *in, SPFLOAT *out);
+int sp_noise_compute_block(sp_data *sp, sp_noise *ns, SPFLOAT *in, SPFLOAT *out, int n);
 int sp_noise_destroy(sp_noise **ns);
 typedef struct nano_entry {
     char name[50];
@@ -886,6 +1067,7 @@ int sp_osc_create(sp_osc **osc);
 int sp_osc_destroy(sp_osc **osc);
 int sp_osc_init(sp_data *sp, sp_osc *osc, sp_ftbl *ft, SPFLOAT iphs);
 int sp_osc_compute(sp_data *sp, sp_osc *osc, SPFLOAT *in, SPFLOAT *out);
+int sp_osc_compute_block(sp_data *sp, sp_osc *osc, SPFLOAT *in, SPFLOAT *out, int n);
 typedef struct {
     SPFLOAT freq, amp, iphs;
     int32_t lphs;
@@ -893,12 +1075,16 @@ typedef struct {
     int inc;
     SPFLOAT wtpos;
     int nft;
+    sp_auxdata blend_aux;
+    SPFLOAT blend_wtpos;
+    int blend_valid;
 } sp_oscmorph;
 
 int sp_oscmorph_create(sp_oscmorph **p);
 int sp_oscmorph_destroy(sp_oscmorph **p);
 int sp_oscmorph_init(sp_data *sp, sp_oscmorph *osc, sp_ftbl **ft, int nft, SPFLOAT iphs);
 int sp_oscmorph_compute(sp_data *sp, sp_oscmorph *p, SPFLOAT *in, SPFLOAT *out);
+int sp_oscmorph_compute_block(sp_data *sp, sp_oscmorph *p, SPFLOAT *in, SPFLOAT *out, int n);
 typedef struct {
     SPFLOAT freq, amp, iphs;
     int32_t lphs;
@@ -910,30 +1096,52 @@ typedef struct {
     float *fbl; // array of frequencies per bandlimited waveform
     int enableBandlimit; // if 0 use index 0, if 1 select index based on freq
     int bandlimitIndexOverride; // temporary
+    sp_auxdata blend_aux;
+    SPFLOAT blend_findex; // row-folded morph index the cache was rendered at
+    int blend_valid;
+    SPFLOAT last_findex;  // morph index seen on the previous sample/block
+    int rest_count;       // consecutive samples the morph has rested
+    int build_pos;        // next cache entry to render, -1 when idle
 } sp_oscmorph2d;
 
 int sp_oscmorph2d_create(sp_oscmorph2d **p);
 int sp_oscmorph2d_destroy(sp_oscmorph2d **p);
 int sp_oscmorph2d_init(sp_data *sp, sp_oscmorph2d *osc, sp_ftbl **ft, int nft, int nbl, float *fbls, SPFLOAT iphs);
 int sp_oscmorph2d_compute(sp_data *sp, sp_oscmorph2d *p, SPFLOAT *in, SPFLOAT *out);
+int sp_oscmorph2d_compute_block(sp_data *sp, sp_oscmorph2d *p, SPFLOAT *in, SPFLOAT *out, int n);
 typedef struct {
     SPFLOAT pan;
     uint32_t type;
+    /* gain pair cached until pan or type changes */
+    SPFLOAT ppan;
+    uint32_t ptype;
+    SPFLOAT lgain, rgain;
 } sp_pan2;
 
 int sp_pan2_create(sp_pan2 **p);
 int sp_pan2_destroy(sp_pan2 **p);
 int sp_pan2_init(sp_data *sp, sp_pan2 *p);
 int sp_pan2_compute(sp_data *sp, sp_pan2 *p, SPFLOAT *in, SPFLOAT *out1, SPFLOAT *out2);
+int sp_pan2_compute_block(sp_data *sp, sp_pan2 *p, SPFLOAT *in,
+    SPFLOAT *out1, SPFLOAT *out2, int n);
+/* Gain pair for a pan law; pan is normalized to [0, 1]. Shared by
+ * sp_pan2 and sp_panst. */
+void sp_pan_gains(uint32_t type, SPFLOAT pan, SPFLOAT *l, SPFLOAT *r);
 typedef struct {
     SPFLOAT pan;
     uint32_t type;
+    /* gain pair cached until pan or type changes */
+    SPFLOAT ppan;
+    uint32_t ptype;
+    SPFLOAT lgain, rgain;
 } sp_panst;
 
 int sp_panst_create(sp_panst **p);
 int sp_panst_destroy(sp_panst **p);
 int sp_panst_init(sp_data *sp, sp_panst *p);
 int sp_panst_compute(sp_data *sp, sp_panst *p, SPFLOAT *in1, SPFLOAT *in2, SPFLOAT *out1, SPFLOAT *out2);
+int sp_panst_compute_block(sp_data *sp, sp_panst *p, SPFLOAT *in1, SPFLOAT *in2,
+    SPFLOAT *out1, SPFLOAT *out2, int n);
 typedef struct {
     SPFLOAT fc, v, q, mode;
 
@@ -948,6 +1156,21 @@ int sp_pareq_create(sp_pareq **p);
 int sp_pareq_destroy(sp_pareq **p);
 int sp_pareq_init(sp_data *sp, sp_pareq *p);
 int sp_pareq_compute(sp_data *sp, sp_pareq *p, SPFLOAT *in, SPFLOAT *out);
+void sp_pareq_update(sp_pareq *p);
+
+/* Four-band serial EQ (low shelf, two peaks, high shelf) built from
+ * sp_pareq bands and processed in one fused block loop. Band
+ * parameters are set directly on band[i] (fc, v, q, mode). */
+#define SP_EQ4_NBANDS 4
+typedef struct {
+    sp_pareq band[SP_EQ4_NBANDS];
+} sp_eq4;
+
+int sp_eq4_create(sp_eq4 **p);
+int sp_eq4_destroy(sp_eq4 **p);
+int sp_eq4_init(sp_data *sp, sp_eq4 *p);
+int sp_eq4_compute(sp_data *sp, sp_eq4 *p, SPFLOAT *in, SPFLOAT *out);
+int sp_eq4_compute_block(sp_data *sp, sp_eq4 *p, SPFLOAT *in, SPFLOAT *out, int n);
 typedef struct {
     uint32_t windowsize;
     uint32_t half_windowsize;
@@ -969,12 +1192,23 @@ typedef struct {
     sp_auxdata m_buf;
     sp_auxdata m_output;
     unsigned char wrap;
+    /* streaming mode: ft is NULL and input is pulled incrementally */
+    SPFLOAT *stream_buf;
+    sp_auxdata m_stream_buf;
+    uint32_t (*pull)(void *ud, SPFLOAT *buf, uint32_t n);
+    void *pull_ud;
+    SPFLOAT stream_frac;
+    unsigned char stream_end;
 } sp_paulstretch;
 
 int sp_paulstretch_create(sp_paulstretch **p);
 int sp_paulstretch_destroy(sp_paulstretch **p);
 int sp_paulstretch_init(sp_data *sp, sp_paulstretch *p, sp_ftbl *ft, SPFLOAT windowsize, SPFLOAT stretch);
+int sp_paulstretch_init_stream(sp_data *sp, sp_paulstretch *p,
+        SPFLOAT windowsize, SPFLOAT stretch,
+        uint32_t (*pull)(void *ud, SPFLOAT *buf, uint32_t n), void *ud);
 int sp_paulstretch_compute(sp_data *sp, sp_paulstretch *p, SPFLOAT *in, SPFLOAT *out);
+int sp_paulstretch_compute_block(sp_data *sp, sp_paulstretch *p, SPFLOAT *out, int nframes);
 typedef struct {
     SPFLOAT amount, ibipolar, ifullscale;
 } sp_pdhalf;
@@ -1014,6 +1248,8 @@ int sp_phaser_destroy(sp_phaser **p);
 int sp_phaser_init(sp_data *sp, sp_phaser *p);
 int sp_phaser_compute(sp_data *sp, sp_phaser *p,
 	SPFLOAT *in1, SPFLOAT *in2, SPFLOAT *out1, SPFLOAT *out2);
+int sp_phaser_compute_block(sp_data *sp, sp_phaser *p,
+	SPFLOAT *in1, SPFLOAT *in2, SPFLOAT *out1, SPFLOAT *out2, int n);
 typedef struct sp_phasor{
     SPFLOAT freq, phs;
     SPFLOAT curphs, onedsr;
@@ -1038,6 +1274,7 @@ int sp_pinknoise_create(sp_pinknoise **p);
 int sp_pinknoise_destroy(sp_pinknoise **p);
 int sp_pinknoise_init(sp_data *sp, sp_pinknoise *p);
 int sp_pinknoise_compute(sp_data *sp, sp_pinknoise *p, SPFLOAT *in, SPFLOAT *out);
+int sp_pinknoise_compute_block(sp_data *sp, sp_pinknoise *p, SPFLOAT *in, SPFLOAT *out, int n);
 typedef struct {
     SPFLOAT imincps, imaxcps, icps;
     SPFLOAT imedi, idowns, iexcps, irmsmedi;
@@ -1077,6 +1314,35 @@ int sp_pluck_create(sp_pluck **p);
 int sp_pluck_destroy(sp_pluck **p);
 int sp_pluck_init(sp_data *sp, sp_pluck *p, SPFLOAT ifreq);
 int sp_pluck_compute(sp_data *sp, sp_pluck *p, SPFLOAT *trig, SPFLOAT *out);
+int sp_pluck_compute_block(sp_data *sp, sp_pluck *p, SPFLOAT *trig, SPFLOAT *out, int n);
+
+typedef struct {
+    int nstrings;
+    sp_auxdata aux;
+    sp_pluck **strings;
+}sp_pluckbank;
+
+int sp_pluckbank_create(sp_pluckbank **p);
+int sp_pluckbank_destroy(sp_pluckbank **p);
+int sp_pluckbank_init(sp_data *sp, sp_pluckbank *p, int nstrings, SPFLOAT ifreq);
+int sp_pluckbank_compute(sp_data *sp, sp_pluckbank *p, SPFLOAT *trig, SPFLOAT *out);
+int sp_pluckbank_compute_block(sp_data *sp, sp_pluckbank *p, SPFLOAT *trig, SPFLOAT *out, int n);
+
+#define SP_POLYBLEP_SQUARE 0
+#define SP_POLYBLEP_SAW 1
+
+typedef struct {
+    SPFLOAT freq, amp, width, pd;
+    int type;
+    SPFLOAT phs;
+    SPFLOAT onedsr;
+} sp_polyblep;
+
+int sp_polyblep_create(sp_polyblep **p);
+int sp_polyblep_destroy(sp_polyblep **p);
+int sp_polyblep_init(sp_data *sp, sp_polyblep *p);
+int sp_polyblep_compute(sp_data *sp, sp_polyblep *p, SPFLOAT *in, SPFLOAT *out);
+int sp_polyblep_compute_block(sp_data *sp, sp_polyblep *p, SPFLOAT *out, int n);
 typedef struct{
     SPFLOAT htime;
     SPFLOAT c1, c2, yt1, prvhtim;
@@ -1087,6 +1353,7 @@ int sp_port_create(sp_port **p);
 int sp_port_destroy(sp_port **p);
 int sp_port_init(sp_data *sp, sp_port *p, SPFLOAT htime);
 int sp_port_compute(sp_data *sp, sp_port *p, SPFLOAT *in, SPFLOAT *out);
+int sp_port_compute_kr(sp_data *sp, sp_port *p, SPFLOAT *in, SPFLOAT *out, int n);
 int sp_port_reset(sp_data *sp, sp_port *p, SPFLOAT *in);
 typedef struct {
     SPFLOAT freq, amp, iphs;
@@ -1177,12 +1444,16 @@ typedef struct {
     SPFLOAT *shift;
     SPFLOAT *window;
     SPFLOAT *xfade;
+    /* tap interpolation in the block path:
+     * 0 = nearest sample, 1 = linear (default) */
+    int quality;
 } sp_pshift;
 
 int sp_pshift_create(sp_pshift **p);
 int sp_pshift_destroy(sp_pshift **p);
 int sp_pshift_init(sp_data *sp, sp_pshift *p);
 int sp_pshift_compute(sp_data *sp, sp_pshift *p, SPFLOAT *in, SPFLOAT *out);
+int sp_pshift_compute_block(sp_data *sp, sp_pshift *p, SPFLOAT *in, SPFLOAT *out, int n);
 typedef struct {
     SPFLOAT freq, amp;
     SPFLOAT asig,size,peak;
@@ -1200,12 +1471,15 @@ typedef struct {
     SPFLOAT dbfs;
     SPFLOAT prevf;
     sp_fft fft;
+    char fft_shared;
 } sp_ptrack;
 
 int sp_ptrack_create(sp_ptrack **p);
 int sp_ptrack_destroy(sp_ptrack **p);
 int sp_ptrack_init(sp_data *sp, sp_ptrack *p, int ihopsize, int ipeaks);
+int sp_ptrack_init_shared_fft(sp_data *sp, sp_ptrack *p, int ihopsize, int ipeaks, sp_ptrack *donor);
 int sp_ptrack_compute(sp_data *sp, sp_ptrack *p, SPFLOAT *in, SPFLOAT *freq, SPFLOAT *amp);
+int sp_ptrack_compute_block(sp_data *sp, sp_ptrack *p, SPFLOAT *in, int n, SPFLOAT *freq, SPFLOAT *amp);
 typedef struct {
     SPFLOAT freq;
     SPFLOAT min, max;
@@ -1299,6 +1573,7 @@ int sp_revsc_create(sp_revsc **p);
 int sp_revsc_destroy(sp_revsc **p);
 int sp_revsc_init(sp_data *sp, sp_revsc *p);
 int sp_revsc_compute(sp_data *sp, sp_revsc *p, SPFLOAT *in1, SPFLOAT *in2, SPFLOAT *out1, SPFLOAT *out2);
+int sp_revsc_compute_block(sp_data *sp, sp_revsc *p, SPFLOAT *in1, SPFLOAT *in2, SPFLOAT *out1, SPFLOAT *out2, int nframes);
 typedef struct sp_rms{
     SPFLOAT ihp, istor;
     SPFLOAT c1, c2, prvq;
@@ -1394,24 +1669,24 @@ int sp_slice_create(sp_slice **p);
 int sp_slice_destroy(sp_slice **p);
 int sp_slice_init(sp_data *sp, sp_slice *p, sp_ftbl *vals, sp_ftbl *buf);
 int sp_slice_compute(sp_data *sp, sp_slice *p, SPFLOAT *in, SPFLOAT *out);
+int sp_slice_compute_block(sp_data *sp, sp_slice *p, SPFLOAT *in, SPFLOAT *out, int n);
 typedef struct {
     SPFLOAT del, maxdel, pdel;
     SPFLOAT sr;
     SPFLOAT feedback;
 
-    int counter;
+    /* delay time in samples, slew-limited toward its target over
+     * maxcount samples (the init interp argument) and read with a
+     * fractional (Lagrange-interpolated) head off a single buffer */
+    SPFLOAT curdel;
+    SPFLOAT targetdel;
+    SPFLOAT slew;
     int maxcount;
 
     uint32_t maxbuf;
 
     sp_auxdata buf1;
     uint32_t bufpos1;
-    uint32_t deltime1;
-
-    sp_auxdata buf2;
-    uint32_t bufpos2;
-    uint32_t deltime2;
-    int curbuf;
 } sp_smoothdelay;
 
 int sp_smoothdelay_create(sp_smoothdelay **p);
@@ -1444,12 +1719,27 @@ typedef struct{
     SPFLOAT *Cdelay;
     sp_auxdata buf;
     int wpointer, rpointer, size;
+    /* interpolation coefficients, cached until freq changes */
+    SPFLOAT lfreq, ca;
+    int cvdt;
 }sp_streson;
 
 int sp_streson_create(sp_streson **p);
 int sp_streson_destroy(sp_streson **p);
 int sp_streson_init(sp_data *sp, sp_streson *p);
 int sp_streson_compute(sp_data *sp, sp_streson *p, SPFLOAT *in, SPFLOAT *out);
+int sp_streson_compute_block(sp_data *sp, sp_streson *p, SPFLOAT *in, SPFLOAT *out, int n);
+typedef struct{
+    int nstrings;
+    sp_auxdata aux;
+    sp_streson **strings;
+}sp_stresonbank;
+
+int sp_stresonbank_create(sp_stresonbank **p);
+int sp_stresonbank_destroy(sp_stresonbank **p);
+int sp_stresonbank_init(sp_data *sp, sp_stresonbank *p, int nstrings);
+int sp_stresonbank_compute(sp_data *sp, sp_stresonbank *p, SPFLOAT *in, SPFLOAT *out);
+int sp_stresonbank_compute_block(sp_data *sp, sp_stresonbank *p, SPFLOAT *in, SPFLOAT *out, int n);
 typedef struct {
     SPFLOAT mode;
 } sp_switch;
@@ -1470,6 +1760,7 @@ int sp_tabread_create(sp_tabread **p);
 int sp_tabread_destroy(sp_tabread **p);
 int sp_tabread_init(sp_data *sp, sp_tabread *p, sp_ftbl *ft, int mode);
 int sp_tabread_compute(sp_data *sp, sp_tabread *p, SPFLOAT *in, SPFLOAT *out);
+int sp_tabread_compute_block(sp_data *sp, sp_tabread *p, SPFLOAT rate, SPFLOAT *out, int n);
 typedef struct {
     SPFLOAT value;
     SPFLOAT target;
@@ -1495,6 +1786,10 @@ int sp_tadsr_compute(sp_data *sp, sp_tadsr *p, SPFLOAT *trig, SPFLOAT *out);
 #define SP_TALKBOX_BUFMAX 1600
 #endif
 
+/* scratch for the FFT autocorrelation path: next power of two
+ * above SP_TALKBOX_BUFMAX plus the maximum LPC order */
+#define SP_TALKBOX_FFTMAX 2048
+
 typedef struct {
     SPFLOAT quality;
     SPFLOAT d0, d1, d2, d3, d4;
@@ -1506,6 +1801,13 @@ typedef struct {
     SPFLOAT window[SP_TALKBOX_BUFMAX];
     SPFLOAT buf0[SP_TALKBOX_BUFMAX];
     SPFLOAT buf1[SP_TALKBOX_BUFMAX];
+    /* set nonzero to compute the per-hop LPC autocorrelation with one
+     * FFT (Wiener-Khinchin) instead of the O(order * N) time-domain
+     * loops; defaults to 0 (time-domain) */
+    int use_fft;
+    int fft_size;
+    sp_fft fft;
+    SPFLOAT fft_buf[SP_TALKBOX_FFTMAX];
     uint32_t K, N, O, pos;
 } sp_talkbox;
 
@@ -1529,12 +1831,16 @@ typedef struct{
     SPFLOAT sr;
     SPFLOAT onedsr;
 
+    /* control-rate coefficient cache, rebuilt when fco/res/dist change */
+    SPFLOAT pfco, pres, pdist;
+    SPFLOAT cq1, cq, cfc;
 }sp_tbvcf;
 
 int sp_tbvcf_create(sp_tbvcf **p);
 int sp_tbvcf_destroy(sp_tbvcf **p);
 int sp_tbvcf_init(sp_data *sp, sp_tbvcf *p);
 int sp_tbvcf_compute(sp_data *sp, sp_tbvcf *p, SPFLOAT *in, SPFLOAT *out);
+int sp_tbvcf_compute_block(sp_data *sp, sp_tbvcf *p, SPFLOAT *in, SPFLOAT *out, int n);
 typedef struct {
     uint32_t num, counter, offset;
 } sp_tdiv;
@@ -1778,6 +2084,7 @@ int sp_wpkorg35_create(sp_wpkorg35 **p);
 int sp_wpkorg35_destroy(sp_wpkorg35 **p);
 int sp_wpkorg35_init(sp_data *sp, sp_wpkorg35 *p);
 int sp_wpkorg35_compute(sp_data *sp, sp_wpkorg35 *p, SPFLOAT *in, SPFLOAT *out);
+int sp_wpkorg35_compute_block(sp_data *sp, sp_wpkorg35 *p, SPFLOAT *in, SPFLOAT *out, int n);
 typedef struct {
     void *faust;
     int argpos;
@@ -1799,6 +2106,7 @@ int sp_zitarev_create(sp_zitarev **p);
 int sp_zitarev_destroy(sp_zitarev **p);
 int sp_zitarev_init(sp_data *sp, sp_zitarev *p);
 int sp_zitarev_compute(sp_data *sp, sp_zitarev *p, SPFLOAT *in1, SPFLOAT *in2, SPFLOAT *out1, SPFLOAT *out2);
+int sp_zitarev_compute_block(sp_data *sp, sp_zitarev *p, SPFLOAT *in1, SPFLOAT *in2, SPFLOAT *out1, SPFLOAT *out2, int nframes);
 
 #ifdef USE_FFTW3
 #include <fftw3.h>
@@ -1839,6 +2147,25 @@ typedef struct sp_padsynth {
 
 int sp_gen_padsynth(sp_data *sp, sp_ftbl *ps, sp_ftbl *amps, SPFLOAT f, SPFLOAT bw);
 
+/* asynchronous padsynth generation: the table is built on a worker
+ * thread and swapped into ps atomically on completion */
+enum {
+SP_PADSYNTH_IDLE,
+SP_PADSYNTH_RUNNING,
+SP_PADSYNTH_DONE,
+SP_PADSYNTH_CANCELLED
+};
+typedef struct sp_padsynth_job sp_padsynth_job;
+int sp_gen_padsynth_async(sp_data *sp, sp_ftbl *ps, sp_ftbl *amps,
+        SPFLOAT f, SPFLOAT bw,
+        void (*progress)(int percent, void *ud), void *ud,
+        sp_padsynth_job **job);
+int sp_padsynth_job_regen(sp_data *sp, sp_padsynth_job *job,
+        sp_ftbl *amps, SPFLOAT f, SPFLOAT bw);
+int sp_padsynth_job_cancel(sp_padsynth_job *job);
+int sp_padsynth_job_state(sp_padsynth_job *job);
+int sp_padsynth_job_destroy(sp_padsynth_job **job);
+
 SPFLOAT sp_padsynth_profile(SPFLOAT fi, SPFLOAT bwi);
 
 int sp_padsynth_ifft(int N, SPFLOAT *freq_amp,
@@ -13,6 +13,9 @@
 #include <math.h>
 #include "soundpipe.h"
 
+/* compiled out when the vDSP backend (fft_vdsp.c) is selected */
+#ifndef SOUNDPIPE_USE_VDSP
+
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
@@ -3141,3 +3144,5 @@ void sp_fft_destroy(sp_fft *fft)
     free(fft->BRLow);
     free(fft->BRLowCpx);
 }
+
+#endif /* SOUNDPIPE_USE_VDSP */
@@ -0,0 +1,79 @@
+/*
+    vDSP-backed implementation of the sp_fft interface.
+
+    Selected by defining SOUNDPIPE_USE_VDSP on the soundpipe target; fft.c
+    provides the portable implementation otherwise. Output layout and scaling
+    match rffts1/riffts1/ffts1 exactly:
+
+      sp_fftr:  in-place real FFT, packed as
+                Re(x[0]), Re(x[N/2]), Re(x[1]), Im(x[1]), ..., unscaled
+      sp_ifftr: inverse of the above, scaled by 1/N
+      sp_fft_cpx: in-place interleaved complex FFT, unscaled
+
+    vDSP's packed real format is identical (DC in realp[0], Nyquist in
+    imagp[0]), so only scale factors need compensating: the forward real
+    transform is 2x the mathematical DFT, and the inverse is N times the
+    mathematical inverse.
+*/
+#ifdef SOUNDPIPE_USE_VDSP
+
+#include <stdlib.h>
+#include <math.h>
+#include <Accelerate/Accelerate.h>
+#include "soundpipe.h"
+
+void sp_fft_init(sp_fft *fft, int M)
+{
+    fft->M = M;
+    fft->setup = vDSP_create_fftsetup(M, kFFTRadix2);
+    /* sized for sp_fft_cpx, which transforms 2^M complex points */
+    fft->tmp = malloc(sizeof(SPFLOAT) * ((size_t)2 << M));
+    fft->utbl = NULL;
+    fft->BRLow = NULL;
+    fft->BRLowCpx = NULL;
+}
+
+void sp_fftr(sp_fft *fft, SPFLOAT *buf, int FFTsize)
+{
+    int M = (int)log2(FFTsize);
+    DSPSplitComplex split;
+    SPFLOAT half = 0.5;
+    split.realp = fft->tmp;
+    split.imagp = fft->tmp + FFTsize / 2;
+    vDSP_ctoz((const DSPComplex *)buf, 2, &split, 1, FFTsize / 2);
+    vDSP_fft_zrip(fft->setup, &split, 1, M, kFFTDirection_Forward);
+    vDSP_vsmul(fft->tmp, 1, &half, fft->tmp, 1, FFTsize);
+    vDSP_ztoc(&split, 1, (DSPComplex *)buf, 2, FFTsize / 2);
+}
+
+void sp_fft_cpx(sp_fft *fft, SPFLOAT *buf, int FFTsize)
+{
+    int M = (int)log2(FFTsize);
+    DSPSplitComplex split;
+    split.realp = fft->tmp;
+    split.imagp = fft->tmp + FFTsize;
+    vDSP_ctoz((const DSPComplex *)buf, 2, &split, 1, FFTsize);
+    vDSP_fft_zip(fft->setup, &split, 1, M, kFFTDirection_Forward);
+    vDSP_ztoc(&split, 1, (DSPComplex *)buf, 2, FFTsize);
+}
+
+void sp_ifftr(sp_fft *fft, SPFLOAT *buf, int FFTsize)
+{
+    int M = (int)log2(FFTsize);
+    DSPSplitComplex split;
+    SPFLOAT scale = 1.0 / FFTsize;
+    split.realp = fft->tmp;
+    split.imagp = fft->tmp + FFTsize / 2;
+    vDSP_ctoz((const DSPComplex *)buf, 2, &split, 1, FFTsize / 2);
+    vDSP_fft_zrip(fft->setup, &split, 1, M, kFFTDirection_Inverse);
+    vDSP_vsmul(fft->tmp, 1, &scale, fft->tmp, 1, FFTsize);
+    vDSP_ztoc(&split, 1, (DSPComplex *)buf, 2, FFTsize / 2);
+}
+
+void sp_fft_destroy(sp_fft *fft)
+{
+    vDSP_destroy_fftsetup(fft->setup);
+    free(fft->tmp);
+}
+
+#endif /* SOUNDPIPE_USE_VDSP */
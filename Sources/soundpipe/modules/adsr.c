@@ -93,3 +93,71 @@ int sp_adsr_compute(sp_data *sp, sp_adsr *p, SPFLOAT *in, SPFLOAT *out)
 
     return SP_OK;
 }
+
+int sp_adsr_compute_block(sp_data *sp, sp_adsr *p, SPFLOAT *gate, SPFLOAT *out, int n)
+{
+    int i = 0;
+
+    /* the gate changes at most a few times per buffer, so the state
+     * machine runs once per gate run and each segment is a bare one-pole
+     * recurrence (or a zero fill) with its state held in registers */
+    while (i < n) {
+        SPFLOAT g = gate[i];
+        SPFLOAT pole;
+        int run = 1, end;
+
+        while (i + run < n && gate[i + run] == g) run++;
+        end = i + run;
+
+        if (p->prev < g && p->mode != DECAY) {
+            p->mode = ATTACK;
+            p->timer = 0;
+            pole = tau2pole(sp, p, p->atk * 0.6);
+            p->atk_time = p->atk * sp->sr;
+            p->a = pole;
+            p->b = 1 - pole;
+        } else if (p->prev > g) {
+            p->mode = RELEASE;
+            pole = tau2pole(sp, p, p->rel);
+            p->a = pole;
+            p->b = 1 - pole;
+        }
+        p->prev = g;
+
+        while (i < end) {
+            if (p->mode == CLEAR) {
+                for (; i < end; i++) out[i] = 0;
+                p->x = g;
+            } else if (p->mode == ATTACK) {
+                SPFLOAT a = p->a, b = p->b, y = p->y;
+                while (i < end) {
+                    y = b*g + a*y;
+                    out[i] = y;
+                    p->timer++;
+                    i++;
+                    if (y > 0.99) {
+                        p->mode = DECAY;
+                        pole = tau2pole(sp, p, p->dec);
+                        p->a = pole;
+                        p->b = 1 - pole;
+                        break;
+                    }
+                }
+                p->y = y;
+                p->x = g;
+            } else {
+                /* DECAY and RELEASE settle toward gate * sustain */
+                SPFLOAT a = p->a, b = p->b, y = p->y;
+                SPFLOAT x = g * p->sus;
+                for (; i < end; i++) {
+                    y = b*x + a*y;
+                    out[i] = y;
+                }
+                p->y = y;
+                p->x = x;
+            }
+        }
+    }
+
+    return SP_OK;
+}
@@ -58,3 +58,38 @@ int sp_allpass_compute(sp_data *sp, sp_allpass *p, SPFLOAT *in, SPFLOAT *out)
     p->bufpos %= p->bufsize;
     return SP_OK;
 }
+
+int sp_allpass_compute_block(sp_data *sp, sp_allpass *p, SPFLOAT *in, SPFLOAT *out, int n)
+{
+    SPFLOAT coef = p->coef;
+    SPFLOAT *buf = (SPFLOAT *)p->aux.ptr;
+    uint32_t pos = p->bufpos;
+    uint32_t bufsize = p->bufsize;
+    int i = 0;
+
+    if(p->prvt != p->revtime) {
+        p->prvt = p->revtime;
+        coef = p->coef = exp(-6.9078 * p->looptime / p->prvt);
+    }
+
+    /* each sample reads then rewrites its own slot, so a contiguous span
+     * is independent and vectorizable; the wrap costs one check per span */
+    while(i < n) {
+        int run = n - i;
+        int j;
+        SPFLOAT *slot = buf + pos;
+        if((int)(bufsize - pos) < run) run = bufsize - pos;
+        for(j = 0; j < run; j++) {
+            SPFLOAT y = slot[j];
+            SPFLOAT z = coef * y + in[i + j];
+            slot[j] = z;
+            out[i + j] = y - coef * z;
+        }
+        pos += run;
+        if(pos == bufsize) pos = 0;
+        i += run;
+    }
+
+    p->bufpos = pos;
+    return SP_OK;
+}
@@ -34,6 +34,11 @@ typedef struct {
 	float fConst6;
 	FAUSTFLOAT fVslider1;
 	FAUSTFLOAT fVslider2;
+	/* control-rate coefficient targets for the streaming path */
+	int iCtrlCount;
+	float fTgt1;
+	float fTgt4;
+	float fTgt5;
 
 } autowah;
 
@@ -94,6 +99,10 @@ void instanceInitautowah(autowah* dsp, int samplingFreq) {
 	}
 	dsp->fVslider1 = (FAUSTFLOAT)100.;
 	dsp->fVslider2 = (FAUSTFLOAT)0.1;
+	dsp->iCtrlCount = 0;
+	dsp->fTgt1 = 0.f;
+	dsp->fTgt4 = 0.f;
+	dsp->fTgt5 = 0.f;
 	/* C99 loop */
 	{
 		int i4;
@@ -161,6 +170,92 @@ void computeautowah(autowah* dsp, int count, FAUSTFLOAT** inputs, FAUSTFLOAT** o
 
 }
 
+/*
+ * Control-rate variant of computeautowah. The envelope followers (the
+ * fast/slow one-poles in fRec3/fRec2) still run per sample so tracking is
+ * unchanged, but the pow/cos coefficient targets they feed can only move
+ * as fast as the envelope, so they are re-derived once every
+ * AUTOWAH_CTRL_SAMPS samples and ramped linearly in between. The 0.999
+ * one-pole smoothers (~23 ms time constant at 44.1 kHz) then chase the
+ * ramped targets per sample exactly as before, which buries the
+ * difference between the ramped and the exact per-sample targets.
+ */
+#define AUTOWAH_CTRL_SAMPS 8
+
+/* the pow/cos coefficient targets derived from the current envelope; this
+   is the expensive part of the per-sample loop above */
+static void autowah_targets(autowah* dsp, float* t1, float* t4, float* t5) {
+	float fTemp2 = min(1.f, dsp->fRec2[0]);
+	float fTemp3 = pow(2.f, (2.3f * fTemp2));
+	float fTemp4 = (1.f - (dsp->fConst1 * (fTemp3 / pow(2.f, (1.f + (2.f * (1.f - fTemp2)))))));
+	*t1 = (0.f - (2.f * (fTemp4 * cos((dsp->fConst6 * fTemp3)))));
+	*t4 = faustpower2_f(fTemp4);
+	*t5 = pow(4.f, fTemp2);
+}
+
+static void computeautowah_ctrl(autowah* dsp, int count, FAUSTFLOAT* input0, FAUSTFLOAT* output0) {
+	float fSlow0 = (float)dsp->fVslider0;
+	float fSlow1 = (float)dsp->fVslider1;
+	float fSlow2 = (0.01f * (fSlow1 * (float)dsp->fVslider2));
+	float fSlow3 = ((1.f - (0.01f * fSlow1)) + (1.f - fSlow0));
+	float fPrev1;
+	float fPrev4;
+	float fPrev5;
+	int i0 = 0;
+	autowah_targets(dsp, &fPrev1, &fPrev4, &fPrev5);
+	while (i0 < count) {
+		int span = min(AUTOWAH_CTRL_SAMPS, (count - i0));
+		float fNew1;
+		float fNew4;
+		float fNew5;
+		float fInc1;
+		float fInc4;
+		float fInc5;
+		float fTgt1 = fPrev1;
+		float fTgt4 = fPrev4;
+		float fTgt5 = fPrev5;
+		int i;
+		/* the envelope depends only on the input, so advance it over the
+		   whole span first and derive the span-end targets from it; the
+		   per-sample targets are then the lag-free linear interpolation
+		   between the span-start and span-end values */
+		for (i = i0; (i < (i0 + span)); i = (i + 1)) {
+			float fTemp1 = fabs((float)input0[i]);
+			dsp->fRec3[0] = max(fTemp1, ((dsp->fConst4 * dsp->fRec3[1]) + (dsp->fConst5 * fTemp1)));
+			dsp->fRec2[0] = ((dsp->fConst2 * dsp->fRec2[1]) + (dsp->fConst3 * dsp->fRec3[0]));
+			dsp->fRec3[1] = dsp->fRec3[0];
+			dsp->fRec2[1] = dsp->fRec2[0];
+		}
+		autowah_targets(dsp, &fNew1, &fNew4, &fNew5);
+		fInc1 = ((fNew1 - fPrev1) / (float)span);
+		fInc4 = ((fNew4 - fPrev4) / (float)span);
+		fInc5 = ((fNew5 - fPrev5) / (float)span);
+		for (i = i0; (i < (i0 + span)); i = (i + 1)) {
+			float fTemp0 = (float)input0[i];
+			fTgt1 = (fTgt1 + fInc1);
+			fTgt4 = (fTgt4 + fInc4);
+			fTgt5 = (fTgt5 + fInc5);
+			dsp->fRec1[0] = ((0.999f * dsp->fRec1[1]) + (0.001f * fTgt1));
+			dsp->fRec4[0] = ((0.999f * dsp->fRec4[1]) + (0.001f * fTgt4));
+			dsp->fRec5[0] = ((0.999f * dsp->fRec5[1]) + (0.0001f * fTgt5));
+			dsp->fRec0[0] = (0.f - (((dsp->fRec1[0] * dsp->fRec0[1]) + (dsp->fRec4[0] * dsp->fRec0[2])) - (fSlow2 * (dsp->fRec5[0] * fTemp0))));
+			output0[i] = (FAUSTFLOAT)((fSlow0 * (dsp->fRec0[0] - dsp->fRec0[1])) + (fSlow3 * fTemp0));
+			dsp->fRec1[1] = dsp->fRec1[0];
+			dsp->fRec4[1] = dsp->fRec4[0];
+			dsp->fRec5[1] = dsp->fRec5[0];
+			dsp->fRec0[2] = dsp->fRec0[1];
+			dsp->fRec0[1] = dsp->fRec0[0];
+		}
+		fPrev1 = fNew1;
+		fPrev4 = fNew4;
+		fPrev5 = fNew5;
+		i0 = (i0 + span);
+	}
+	/* make an interleaved per-sample call re-derive from fresh state */
+	dsp->iCtrlCount = 0;
+
+}
+
 static void addVerticalSlider(void* ui_interface, const char* label, FAUSTFLOAT* zone, FAUSTFLOAT init, FAUSTFLOAT min, FAUSTFLOAT max, FAUSTFLOAT step)
 {
     sp_autowah *p = ui_interface;
@@ -203,9 +298,40 @@ int sp_autowah_init(sp_data *sp, sp_autowah *p)
 
 int sp_autowah_compute(sp_data *sp, sp_autowah *p, SPFLOAT *in, SPFLOAT *out)
 {
+    /* single-sample path used by the sporth ugen: same control-rate
+       coefficient scheme as the block variant, with the targets held
+       between re-derivations instead of ramped */
     autowah *dsp = p->faust;
-    SPFLOAT *faust_out[] = {out};
-    SPFLOAT *faust_in[] = {in};
-    computeautowah(dsp, 1, faust_in, faust_out);
+    float fSlow0 = (float)dsp->fVslider0;
+    float fSlow1 = (float)dsp->fVslider1;
+    float fSlow2 = (0.01f * (fSlow1 * (float)dsp->fVslider2));
+    float fSlow3 = ((1.f - (0.01f * fSlow1)) + (1.f - fSlow0));
+    float fTemp0 = (float)*in;
+    float fTemp1 = fabs(fTemp0);
+    dsp->fRec3[0] = max(fTemp1, ((dsp->fConst4 * dsp->fRec3[1]) + (dsp->fConst5 * fTemp1)));
+    dsp->fRec2[0] = ((dsp->fConst2 * dsp->fRec2[1]) + (dsp->fConst3 * dsp->fRec3[0]));
+    if (dsp->iCtrlCount == 0) {
+        autowah_targets(dsp, &dsp->fTgt1, &dsp->fTgt4, &dsp->fTgt5);
+        dsp->iCtrlCount = AUTOWAH_CTRL_SAMPS;
+    }
+    dsp->iCtrlCount--;
+    dsp->fRec1[0] = ((0.999f * dsp->fRec1[1]) + (0.001f * dsp->fTgt1));
+    dsp->fRec4[0] = ((0.999f * dsp->fRec4[1]) + (0.001f * dsp->fTgt4));
+    dsp->fRec5[0] = ((0.999f * dsp->fRec5[1]) + (0.0001f * dsp->fTgt5));
+    dsp->fRec0[0] = (0.f - (((dsp->fRec1[0] * dsp->fRec0[1]) + (dsp->fRec4[0] * dsp->fRec0[2])) - (fSlow2 * (dsp->fRec5[0] * fTemp0))));
+    *out = (SPFLOAT)((fSlow0 * (dsp->fRec0[0] - dsp->fRec0[1])) + (fSlow3 * fTemp0));
+    dsp->fRec3[1] = dsp->fRec3[0];
+    dsp->fRec2[1] = dsp->fRec2[0];
+    dsp->fRec1[1] = dsp->fRec1[0];
+    dsp->fRec4[1] = dsp->fRec4[0];
+    dsp->fRec5[1] = dsp->fRec5[0];
+    dsp->fRec0[2] = dsp->fRec0[1];
+    dsp->fRec0[1] = dsp->fRec0[0];
+    return SP_OK;
+}
+
+int sp_autowah_compute_block(sp_data *sp, sp_autowah *p, SPFLOAT *in, SPFLOAT *out, int n)
+{
+    computeautowah_ctrl(p->faust, n, in, out);
     return SP_OK;
 }
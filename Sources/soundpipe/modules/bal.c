@@ -74,3 +74,45 @@ int sp_bal_compute(sp_data *sp, sp_bal *p, SPFLOAT *sig, SPFLOAT *comp, SPFLOAT
 
     return SP_OK;
 }
+
+int sp_bal_compute_block(sp_data *sp, sp_bal *p, SPFLOAT *sig, SPFLOAT *comp,
+                         SPFLOAT *out, int n)
+{
+    SPFLOAT q, r, a, g, incr;
+    SPFLOAT c1 = p->c1, c2 = p->c2;
+    int i;
+
+    /* the RMS followers are two multiply-adds per sample and must run at
+     * audio rate to keep their state exact; only the correction gain --
+     * the divide and square root of their ratio -- moves slowly enough
+     * to evaluate once per block */
+    q = p->prvq;
+    r = p->prvr;
+    for(i = 0; i < n; i++) {
+        SPFLOAT as = sig[i];
+        SPFLOAT cs = comp[i];
+        q = c1 * as * as + c2 * q;
+        r = c1 * cs * cs + c2 * r;
+    }
+    p->prvq = q;
+    p->prvr = r;
+
+    if (q != 0.0) {
+        a = sqrt(r/q);
+    } else {
+        a = sqrt(r);
+    }
+
+    /* slew from the previous block's gain to the new one across the
+     * block; the per-sample version applies the old gain for one sample
+     * after a change, and this is the same idea stretched to n samples */
+    g = p->prva;
+    incr = (a - g) / n;
+    for(i = 0; i < n; i++) {
+        out[i] = sig[i] * g;
+        g += incr;
+    }
+    p->prva = a;
+
+    return SP_OK;
+}
@@ -189,3 +189,137 @@ int sp_bar_compute(sp_data *sp, sp_bar *p, SPFLOAT *in, SPFLOAT *out)
     p->w2 = w2;
     return SP_OK;
 }
+
+/* Advances the scheme n steps with the grid rows, scheme coefficients,
+ * and boundary types held in locals, so the three rows stay cache
+ * resident across the whole block. The spatial update runs over
+ * restrict-qualified row pointers (the rows are disjoint slices of one
+ * allocation), which lets the compiler vectorize the stencil sweep. A
+ * nonzero in[i] restrikes the bar exactly as in sp_bar_compute. */
+int sp_bar_compute_block(sp_data *sp, sp_bar *p, SPFLOAT *in, SPFLOAT *out, int n)
+{
+    SPFLOAT xofreq = 2 * M_PI * (p->scan)/sp->sr;
+    SPFLOAT xo, xofrac;
+    int xoint;
+    int step = p->step;
+    int first;
+    int N = p->N, rr, i;
+    SPFLOAT *w = p->w, *w1 = p->w1, *w2 = p->w2;
+    SPFLOAT s0 = p->s0, s1 = p->s1, s2 = p->s2, t0 = p->t0, t1 = p->t1;
+    int bcL = (int)lrintf((SPFLOAT)p->bcL);
+    int bcR = (int)lrintf((SPFLOAT)p->bcR);
+    SPFLOAT SIN1W = sin(xofreq);
+    SPFLOAT COS1W = cos(xofreq);
+
+    if ((bcL|bcR)&(~3) && (bcL|bcR)!=0) {
+        fprintf(stderr,
+                "sp_bar: Ends must be clamped(1), pivoting(2), or free(3)\n");
+        return SP_NOT_OK;
+    }
+
+    for (i = 0; i < n; i++) {
+        SPFLOAT SINNW = sin(xofreq*step);
+        SPFLOAT COSNW = cos(xofreq*step);
+
+        /* a strike lands on the step after the trigger, as in the
+           single-sample path */
+        first = p->first;
+
+        if (in[i]) {
+            p->first = 0;
+            SPFLOAT K = p->iK;
+            SPFLOAT T30 = p->T30;
+            SPFLOAT b = p->ib;
+
+            SPFLOAT dt = 1.0 / sp->sr;
+            SPFLOAT sig = (2.0 * sp->sr) * (pow(10.0, 3.0 * dt / T30) - 1.0);
+            SPFLOAT dxmin = sqrt(dt * (b+hypot(b, K+K) ));
+            int Nc = (int) (1.0/dxmin);
+            SPFLOAT dx = 1.0/Nc;
+
+            p->s0 = (2.0-6.0*K*K*dt*dt/(dx*dx*dx*dx)-2.0*b*dt/(dx*dx))/(1.0+sig*dt*0.5);
+            p->s1 = (4.0*K*K*dt*dt/(dx*dx*dx*dx)+b*dt/(dx*dx))/(1.0+sig*dt*0.5);
+            p->s2 = -K*K*dt*dt/((dx*dx*dx*dx)*(1.0+sig*dt*0.5));
+            p->t0 = (-1.0+2.0*b*dt/(dx*dx)+sig*dt*0.5)/(1.0+sig*dt*0.5);
+            p->t1 = (-b*dt)/(dx*dx*(1.0+sig*dt*0.5));
+
+            s0 = p->s0;
+            s1 = p->s1;
+            s2 = p->s2;
+            t0 = p->t0;
+            t1 = p->t1;
+        }
+
+        if (bcL == 3) {
+            w1[1] = 2.0*w1[2]-w1[3];
+            w1[0] = 3.0*w1[1]-3.0*w1[2]+w1[3];
+        }
+        else if (bcL == 1) {
+            w1[2] = 0.0;
+            w1[3] = 0.0;
+        }
+        else if (bcL == 2) {
+            w1[2] = 0.0;
+            w1[1] = -w1[3];
+        }
+
+        if (bcR == 3) {
+            w1[N+3] = 2.0*w1[N+2]-w1[N+1];
+            w1[N+4] = 3.0*w1[N+3]-3.0*w1[N+2]+w1[N+1];
+        } else if (bcR == 1) {
+            w1[N+1] = 0.0;
+            w1[N+2] = 0.0;
+        } else if (bcR == 2) {
+            w1[N+2] = 0.0;
+            w1[N+3] = -w1[N+1];
+        }
+
+        /* Iterate model */
+        {
+            SPFLOAT * restrict q0 = w;
+            const SPFLOAT * restrict q1 = w1;
+            const SPFLOAT * restrict q2 = w2;
+            for (rr = 0; rr < N+1; rr++) {
+                q0[rr+2] = s0*q1[rr+2] + s1*(q1[rr+3]+q1[rr+1]) + s2*(q1[rr+4]+q1[rr]) +
+                           t0*q2[rr+2] + t1*(q2[rr+3]+q2[rr+1]);
+            }
+        }
+
+        /*  strike inputs */
+
+        if (first == 0) {
+            p->first = 1;
+            for (rr = 0; rr < N; rr++) {
+                if (fabs(rr/(SPFLOAT)N - p->pos) <= p->wid) {
+                    w[rr+2] += (1.0/sp->sr)*(p->vel)*0.5*
+                        (1.0+cos(M_PI*fabs(rr/(SPFLOAT)N-(p->pos))/(p->wid)));
+                }
+            }
+        }
+        {
+            SPFLOAT xx = SINNW*COS1W + COSNW*SIN1W;
+            SPFLOAT yy = COSNW*COS1W - SINNW*SIN1W;
+
+            SINNW = xx;
+            COSNW = yy;
+        }
+        xo = 0.5 + 0.5*SINNW;
+        xoint = (int) (xo*N) + 2;
+        xofrac = xo*N - (int)(xo*N);
+
+        out[i] = ((1.0-xofrac)*w[xoint] + xofrac*w[xoint+1]);
+        step++;
+        {
+            SPFLOAT *ww = w2;
+
+            w2 = w1;
+            w1 = w;
+            w = ww;
+        }
+    }
+    p->step = step;
+    p->w = w;
+    p->w1 = w1;
+    p->w2 = w2;
+    return SP_OK;
+}
@@ -4,6 +4,62 @@
 #include <math.h>
 #include "soundpipe.h"
 
+/* The arena most recently created; sp_auxdata_alloc has no sp_data argument,
+ * so it draws from here. Patch construction is single-threaded in practice,
+ * like the rest of soundpipe. */
+static sp_arena *sp_active_arena = NULL;
+
+void (*sp_alloc_report)(const char *tag, long bytes) = NULL;
+
+static void *arena_slab_alloc(sp_arena *arena, size_t size)
+{
+    void *ptr;
+    /* keep every block 16-byte aligned */
+    size = (size + 15) & ~(size_t)15;
+    if (arena->used + size > arena->size) return NULL;
+    ptr = arena->mem + arena->used;
+    arena->used += size;
+    return ptr;
+}
+
+int sp_arena_create(sp_data *sp, size_t size)
+{
+    sp_arena *arena = malloc(sizeof(sp_arena));
+    if (arena == NULL) return SP_NOT_OK;
+    arena->mem = malloc(size);
+    if (arena->mem == NULL) {
+        free(arena);
+        return SP_NOT_OK;
+    }
+    arena->size = size;
+    arena->used = 0;
+    sp->arena = arena;
+    sp_active_arena = arena;
+    if (sp_alloc_report) {
+        sp_alloc_report("arena", (long)(size + sizeof(sp_arena)));
+    }
+    return SP_OK;
+}
+
+int sp_arena_destroy(sp_data *sp)
+{
+    if (sp->arena == NULL) return SP_OK;
+    if (sp_active_arena == sp->arena) sp_active_arena = NULL;
+    if (sp_alloc_report) {
+        sp_alloc_report("arena", -(long)(sp->arena->size + sizeof(sp_arena)));
+    }
+    free(sp->arena->mem);
+    free(sp->arena);
+    sp->arena = NULL;
+    return SP_OK;
+}
+
+void *sp_arena_alloc(sp_data *sp, size_t size)
+{
+    if (sp->arena == NULL) return NULL;
+    return arena_slab_alloc(sp->arena, size);
+}
+
 int sp_create(sp_data **spp)
 {
     *spp = (sp_data *) malloc(sizeof(sp_data));
@@ -17,6 +73,7 @@ int sp_create(sp_data **spp)
     sp->len = 5 * sp->sr;
     sp->pos = 0;
     sp->rand = 0;
+    sp->arena = NULL;
     return 0;
 }
 
@@ -33,12 +90,14 @@ int sp_createn(sp_data **spp, int nchan)
     sp->len = 5 * sp->sr;
     sp->pos = 0;
     sp->rand = 0;
+    sp->arena = NULL;
     return 0;
 }
 
 int sp_destroy(sp_data **spp)
 {
     sp_data *sp = *spp;
+    sp_arena_destroy(sp);
     free(sp->out);
     free(*spp);
     return 0;
@@ -93,7 +152,16 @@ int sp_process_plot(sp_data *sp, void *ud, void (*callback)(sp_data *, void *))
 
 int sp_auxdata_alloc(sp_auxdata *aux, size_t size)
 {
-    aux->ptr = malloc(size);
+    aux->ptr = NULL;
+    aux->arena = 0;
+    if (sp_active_arena != NULL) {
+        aux->ptr = arena_slab_alloc(sp_active_arena, size);
+        aux->arena = (aux->ptr != NULL);
+    }
+    if (aux->ptr == NULL) {
+        aux->ptr = malloc(size);
+        if (sp_alloc_report) sp_alloc_report("auxdata", (long)size);
+    }
     aux->size = size;
     memset(aux->ptr, 0, size);
     return SP_OK;
@@ -101,7 +169,11 @@ int sp_auxdata_alloc(sp_auxdata *aux, size_t size)
 
 int sp_auxdata_free(sp_auxdata *aux)
 {
-    free(aux->ptr);
+    /* arena memory is reclaimed all at once by sp_arena_destroy */
+    if (!aux->arena) {
+        free(aux->ptr);
+        if (sp_alloc_report) sp_alloc_report("auxdata", -(long)aux->size);
+    }
     return SP_OK;
 }
 
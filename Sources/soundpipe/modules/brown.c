@@ -45,3 +45,29 @@ int sp_brown_compute(sp_data *sp, sp_brown *p, SPFLOAT *in, SPFLOAT *out)
     *out = p->brown * 0.0625;
     return SP_OK;
 }
+
+/* Fills a whole block with the walk state held in a local. Same
+ * sequence as sp_brown_compute. */
+int sp_brown_compute_block(sp_data *sp, sp_brown *p, SPFLOAT *in, SPFLOAT *out, int n)
+{
+    SPFLOAT brown = p->brown;
+    SPFLOAT r;
+    int i;
+
+    for (i = 0; i < n; i++) {
+        while(1) {
+            r = (sp_rand(sp) % SP_RANDMAX) / (SPFLOAT)(SP_RANDMAX);
+            r = ((r * 2) - 1) * 0.5;
+            brown += r;
+            if(brown < -8.0f || brown > 8.0f) {
+                brown -= r;
+            } else {
+                break;
+            }
+        }
+        out[i] = brown * 0.0625;
+    }
+
+    p->brown = brown;
+    return SP_OK;
+}
@@ -82,3 +82,39 @@ int sp_buthp_compute(sp_data *sp, sp_buthp *p, SPFLOAT *in, SPFLOAT *out)
     sp_butter_filter(in, out, p->a);
     return SP_OK;
 }
+
+int sp_buthp_compute_block(sp_data *sp, sp_buthp *p, SPFLOAT *in, SPFLOAT *out, int n)
+{
+    SPFLOAT *a = p->a;
+    SPFLOAT a1, a2, a3, a4, a5, z1, z2;
+    int i;
+
+    if (p->freq <= 0.0) {
+        for (i = 0; i < n; i++) out[i] = 0;
+        return SP_OK;
+    }
+
+    if (p->freq != p->lkf) {
+        SPFLOAT c;
+        p->lkf = p->freq;
+        c = tan((SPFLOAT)(p->pidsr * p->lkf));
+        a[1] = 1.0 / ( 1.0 + ROOT2 * c + c * c);
+        a[2] = -(a[1] + a[1]);
+        a[3] = a[1];
+        a[4] = 2.0 * ( c*c - 1.0) * a[1];
+        a[5] = ( 1.0 - ROOT2 * c + c * c) * a[1];
+    }
+
+    /* coefficients and filter state stay in locals for the whole block */
+    a1 = a[1]; a2 = a[2]; a3 = a[3]; a4 = a[4]; a5 = a[5];
+    z1 = a[6]; z2 = a[7];
+    for (i = 0; i < n; i++) {
+        SPFLOAT t = in[i] - a4 * z1 - a5 * z2;
+        out[i] = t * a1 + a2 * z1 + a3 * z2;
+        z2 = z1;
+        z1 = t;
+    }
+    a[6] = z1;
+    a[7] = z2;
+    return SP_OK;
+}
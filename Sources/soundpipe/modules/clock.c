@@ -39,3 +39,34 @@ int sp_clock_compute(sp_data *sp, sp_clock *p, SPFLOAT *in, SPFLOAT *out)
     p->counter--;
     return SP_OK;
 }
+
+/* Evaluates n samples of the clock in one call. The integer counter
+ * makes tick placement exact: *offset receives the sample offset of
+ * the first tick in the block (-1 when none fires) and the counter is
+ * advanced across every tick. A nonzero *in retriggers at the start
+ * of the block, which is the view a block-rate graph has of a held
+ * trigger input. */
+int sp_clock_compute_kr(sp_data *sp, sp_clock *p, SPFLOAT *in, SPFLOAT *out,
+    int n, int *offset)
+{
+    uint32_t period = (uint32_t)(sp->sr * (60.0 / (p->bpm * p->subdiv))) + 1;
+    uint32_t c = p->counter;
+    int first = -1;
+    int i = 0;
+
+    while (i < n) {
+        uint32_t run;
+        if (c == 0 || (i == 0 && *in != 0)) {
+            if (first < 0) first = i;
+            c = period;
+        }
+        run = c < (uint32_t)(n - i) ? c : (uint32_t)(n - i);
+        c -= run;
+        i += (int)run;
+    }
+
+    p->counter = c;
+    *offset = first;
+    *out = (first >= 0) ? 1.0 : 0.0;
+    return SP_OK;
+}
@@ -69,3 +69,42 @@ int sp_comb_compute(sp_data *sp, sp_comb *p, SPFLOAT *in, SPFLOAT *out)
     p->bufpos %= p->bufsize;
     return SP_OK;
 }
+
+int sp_comb_compute_block(sp_data *sp, sp_comb *p, SPFLOAT *in, SPFLOAT *out, int n)
+{
+    SPFLOAT coef = p->coef;
+    SPFLOAT *buf = (SPFLOAT *)p->aux.ptr;
+    uint32_t pos = p->bufpos;
+    uint32_t bufsize = p->bufsize;
+    int i = 0;
+
+    if(p->prvt != p->revtime) {
+        p->prvt = p->revtime;
+        SPFLOAT exp_arg = (SPFLOAT) (log001 * p->looptime / p->prvt);
+        if(exp_arg < -36.8413615) {
+            coef = p->coef = 0;
+        } else {
+            coef = p->coef = exp(exp_arg);
+        }
+    }
+
+    /* each sample reads then rewrites its own slot, so a contiguous span
+     * is independent and vectorizable; the wrap costs one check per span */
+    while(i < n) {
+        int run = n - i;
+        int j;
+        SPFLOAT *slot = buf + pos;
+        if((int)(bufsize - pos) < run) run = bufsize - pos;
+        for(j = 0; j < run; j++) {
+            SPFLOAT outsamp = slot[j];
+            slot[j] = outsamp * coef + in[i + j];
+            out[i + j] = outsamp;
+        }
+        pos += run;
+        if(pos == bufsize) pos = 0;
+        i += run;
+    }
+
+    p->bufpos = pos;
+    return SP_OK;
+}
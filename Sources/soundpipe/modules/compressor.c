@@ -114,6 +114,39 @@ static void computecompressor(compressor* dsp, int count, FAUSTFLOAT** inputs, F
 
 }
 
+/* computecompressor with the envelope driven by a separate detector
+ * signal: detector feeds the level follower (fRec2/fRec1), inputs[0]
+ * only feeds the gain stage. */
+static void computecompressordet(compressor* dsp, int count, FAUSTFLOAT** inputs, FAUSTFLOAT* detector, FAUSTFLOAT** outputs) {
+	FAUSTFLOAT* input0 = inputs[0];
+	FAUSTFLOAT* output0 = outputs[0];
+	float fSlow0 = (float)dsp->fHslider0;
+	float fSlow1 = exp((0.f - (dsp->fConst1 / fSlow0)));
+	float fSlow2 = ((1.f - fSlow1) * ((1.f / (float)dsp->fHslider1) - 1.f));
+	float fSlow3 = exp((0.f - (dsp->fConst2 / fSlow0)));
+	float fSlow4 = exp((0.f - (dsp->fConst2 / (float)dsp->fHslider2)));
+	float fSlow5 = (float)dsp->fHslider3;
+	/* C99 loop */
+	{
+		int i;
+		for (i = 0; (i < count); i = (i + 1)) {
+			float fTemp0 = (float)input0[i];
+			float fTemp1 = fabs((float)detector[i]);
+			float fTemp2 = ((dsp->fRec1[1] > fTemp1)?fSlow4:fSlow3);
+			dsp->fRec2[0] = ((dsp->fRec2[1] * fTemp2) + ((1.f - fTemp2) * fTemp1));
+			dsp->fRec1[0] = dsp->fRec2[0];
+			dsp->fRec0[0] = ((fSlow1 * dsp->fRec0[1]) + (fSlow2 * max(((20.f * log10(dsp->fRec1[0])) - fSlow5), 0.f)));
+			output0[i] = (FAUSTFLOAT)(pow(10.f, (0.05f * dsp->fRec0[0])) * fTemp0);
+			dsp->fRec2[1] = dsp->fRec2[0];
+			dsp->fRec1[1] = dsp->fRec1[0];
+			dsp->fRec0[1] = dsp->fRec0[0];
+
+		}
+
+	}
+
+}
+
 static void addHorizontalSlider(void* ui_interface, const char* label, FAUSTFLOAT* zone, FAUSTFLOAT init, FAUSTFLOAT min, FAUSTFLOAT max, FAUSTFLOAT step)
 {
     sp_compressor *p = ui_interface;
@@ -165,3 +198,15 @@ int sp_compressor_compute(sp_data *sp, sp_compressor *p, SPFLOAT *in, SPFLOAT *o
     computecompressor(dsp, 1, faust_in, faust_out);
     return SP_OK;
 }
+
+/* sidechain variant: the envelope follows det while the gain is
+ * applied to in.  Feeding a unity in yields the bare gain signal,
+ * which is how one detector can drive several gain stages. */
+int sp_compressor_compute_det(sp_data *sp, sp_compressor *p, SPFLOAT *in, SPFLOAT *det, SPFLOAT *out)
+{
+    compressor *dsp = p->faust;
+    SPFLOAT *faust_out[] = {out};
+    SPFLOAT *faust_in[] = {in};
+    computecompressordet(dsp, 1, faust_in, det, faust_out);
+    return SP_OK;
+}
@@ -12,7 +12,9 @@
 
 #include <math.h>
 #include <string.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include "soundpipe.h"
 
 static void multiply_fft_buffers(SPFLOAT *outBuf, SPFLOAT *ringBuf,
@@ -195,6 +197,136 @@ int sp_conv_init(sp_data *sp, sp_conv *p, sp_ftbl *ft, SPFLOAT iPartLen)
     return SP_OK;
 }
 
+int sp_conv_ir_create(sp_conv_ir **ir)
+{
+    *ir = malloc(sizeof(sp_conv_ir));
+    return SP_OK;
+}
+
+int sp_conv_ir_destroy(sp_conv_ir **ir)
+{
+    sp_auxdata_free(&(*ir)->aux);
+    free(*ir);
+    return SP_OK;
+}
+
+int sp_conv_ir_init(sp_data *sp, sp_conv_ir *ir, sp_ftbl *ft, SPFLOAT iPartLen)
+{
+    sp_fft fft;
+    int i, k, n;
+
+    ir->partSize = (int)lrintf(iPartLen);
+    if (ir->partSize < 4 || (ir->partSize & (ir->partSize - 1)) != 0) {
+        fprintf(stderr, "conv: invalid partition size.\n");
+        return SP_NOT_OK;
+    }
+    n = (int)ft->size;
+    if (n <= 0) {
+        fprintf(stderr, "uh oh.\n");
+        return SP_NOT_OK;
+    }
+    ir->nPartitions = (n + (ir->partSize - 1)) / ir->partSize;
+    sp_auxdata_alloc(&ir->aux,
+        sizeof(SPFLOAT) * (ir->partSize << 1) * ir->nPartitions);
+    ir->data = (SPFLOAT *)ir->aux.ptr;
+
+    /* same partition layout and scaling as sp_conv_init: last partition
+     * first, each zero-padded to twice the partition size */
+    sp_fft_init(&fft, (int)log2(ir->partSize << 1));
+    i = 0;
+    n = (ir->partSize << 1) * (ir->nPartitions - 1);
+    do {
+        for (k = 0; k < ir->partSize; k++) {
+            ir->data[n + k] = (i < (int)ft->size) ? ft->tbl[i] : 0.0;
+            i++;
+        }
+        for (k = ir->partSize; k < (ir->partSize << 1); k++) {
+            ir->data[n + k] = 0.0;
+        }
+        sp_fftr(&fft, &(ir->data[n]), (ir->partSize << 1));
+        n -= (ir->partSize << 1);
+    } while (n >= 0);
+    sp_fft_destroy(&fft);
+    return SP_OK;
+}
+
+/* IR cache files: a small header followed by the frequency-domain blocks */
+struct sp_conv_ir_header {
+    char magic[4];      /* "SPIR" */
+    int32_t partSize;
+    int32_t nPartitions;
+};
+
+int sp_conv_ir_save(sp_conv_ir *ir, const char *path)
+{
+    FILE *fp = fopen(path, "wb");
+    struct sp_conv_ir_header hdr;
+    size_t count = (size_t)(ir->partSize << 1) * ir->nPartitions;
+    int ok;
+    if (fp == NULL) return SP_NOT_OK;
+    memcpy(hdr.magic, "SPIR", 4);
+    hdr.partSize = ir->partSize;
+    hdr.nPartitions = ir->nPartitions;
+    ok = fwrite(&hdr, sizeof(hdr), 1, fp) == 1 &&
+        fwrite(ir->data, sizeof(SPFLOAT), count, fp) == count;
+    fclose(fp);
+    return ok ? SP_OK : SP_NOT_OK;
+}
+
+int sp_conv_ir_load(sp_data *sp, sp_conv_ir *ir, const char *path)
+{
+    FILE *fp = fopen(path, "rb");
+    struct sp_conv_ir_header hdr;
+    size_t count;
+    int ok;
+    if (fp == NULL) return SP_NOT_OK;
+    if (fread(&hdr, sizeof(hdr), 1, fp) != 1 ||
+        memcmp(hdr.magic, "SPIR", 4) != 0 ||
+        hdr.partSize < 4 || (hdr.partSize & (hdr.partSize - 1)) != 0 ||
+        hdr.nPartitions <= 0) {
+        fclose(fp);
+        return SP_NOT_OK;
+    }
+    ir->partSize = hdr.partSize;
+    ir->nPartitions = hdr.nPartitions;
+    count = (size_t)(ir->partSize << 1) * ir->nPartitions;
+    sp_auxdata_alloc(&ir->aux, sizeof(SPFLOAT) * count);
+    ir->data = (SPFLOAT *)ir->aux.ptr;
+    ok = fread(ir->data, sizeof(SPFLOAT), count, fp) == count;
+    fclose(fp);
+    return ok ? SP_OK : SP_NOT_OK;
+}
+
+int sp_conv_init_ir(sp_data *sp, sp_conv *p, sp_conv_ir *ir)
+{
+    int nSmps;
+
+    p->nChannels = 1;
+    p->partSize = ir->partSize;
+    p->nPartitions = ir->nPartitions;
+    p->iPartLen = (SPFLOAT)ir->partSize;
+    p->iSkipSamples = 0;
+    p->iTotLen = (SPFLOAT)(ir->partSize * ir->nPartitions);
+
+    sp_fft_init(&p->fft, (int)log2(p->partSize << 1));
+
+    /* per-instance state only: tmpBuf + ringBuf + outBuffers; the
+     * frequency-domain partitions are borrowed from ir */
+    nSmps = (p->partSize << 1)                       /* tmpBuf     */
+        + ((p->partSize << 1) * p->nPartitions)      /* ringBuf    */
+        + (p->partSize << 1);                        /* outBuffers */
+    sp_auxdata_alloc(&p->auxData, sizeof(SPFLOAT) * nSmps);
+    p->tmpBuf = (SPFLOAT *)p->auxData.ptr;
+    p->ringBuf = p->tmpBuf + (p->partSize << 1);
+    p->outBuffers[0] = p->ringBuf + (p->partSize << 1) * p->nPartitions;
+    p->IR_Data[0] = ir->data;
+
+    p->cnt = 0;
+    p->rbCnt = 0;
+    p->initDone = 1;
+    return SP_OK;
+}
+
 int sp_conv_compute(sp_data *sp, sp_conv *p, SPFLOAT *in, SPFLOAT *out)
 {
     SPFLOAT *x, *rBuf;
@@ -244,3 +376,72 @@ int sp_conv_compute(sp_data *sp, sp_conv *p, SPFLOAT *in, SPFLOAT *out)
     }
     return SP_OK;
 }
+
+int sp_nconv_create(sp_nconv **p)
+{
+    *p = malloc(sizeof(sp_nconv));
+    return SP_OK;
+}
+
+int sp_nconv_destroy(sp_nconv **p)
+{
+    sp_nconv *pp = *p;
+    sp_auxdata_free(&pp->head.auxData);
+    sp_fft_destroy(&pp->head.fft);
+    if (pp->hasTail) {
+        sp_auxdata_free(&pp->tail.auxData);
+        sp_fft_destroy(&pp->tail.fft);
+    }
+    free(*p);
+    return SP_OK;
+}
+
+int sp_nconv_init(sp_data *sp, sp_nconv *p, sp_ftbl *ft,
+                  SPFLOAT iHeadPartLen, SPFLOAT iTailPartLen)
+{
+    sp_ftbl *seg;
+    int headPart, tailPart, headLen;
+    int rc;
+
+    headPart = (int)lrintf(iHeadPartLen);
+    tailPart = (int)lrintf(iTailPartLen);
+    if (headPart < 4 || (headPart & (headPart - 1)) != 0 ||
+        tailPart <= headPart || (tailPart & (tailPart - 1)) != 0) {
+        fprintf(stderr, "nconv: invalid partition sizes.\n");
+        return SP_NOT_OK;
+    }
+    p->headPartSize = headPart;
+    p->tailPartSize = tailPart;
+
+    /* With sp_conv's latency of exactly one partition, a tail convolver
+     * with partition T lines up with a head of partition H when the tail
+     * segment starts T - H samples into the IR. */
+    headLen = tailPart - headPart;
+    if (headLen > (int)ft->size) headLen = (int)ft->size;
+    p->hasTail = (int)ft->size > headLen;
+
+    sp_ftbl_bind(sp, &seg, ft->tbl, headLen);
+    rc = sp_conv_init(sp, &p->head, seg, (SPFLOAT)headPart);
+    sp_ftbl_destroy(&seg);
+    if (rc != SP_OK) return rc;
+
+    if (p->hasTail) {
+        sp_ftbl_bind(sp, &seg, ft->tbl + headLen, ft->size - headLen);
+        rc = sp_conv_init(sp, &p->tail, seg, (SPFLOAT)tailPart);
+        sp_ftbl_destroy(&seg);
+        if (rc != SP_OK) return rc;
+    }
+    return SP_OK;
+}
+
+int sp_nconv_compute(sp_data *sp, sp_nconv *p, SPFLOAT *in, SPFLOAT *out)
+{
+    SPFLOAT headOut = 0.0, tailOut = 0.0;
+
+    sp_conv_compute(sp, &p->head, in, &headOut);
+    if (p->hasTail) {
+        sp_conv_compute(sp, &p->tail, in, &tailOut);
+    }
+    *out = headOut + tailOut;
+    return SP_OK;
+}
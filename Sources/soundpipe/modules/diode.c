@@ -143,6 +143,7 @@ int sp_diode_init(sp_data *sp, sp_diode *p)
     /* update filter coefs */
 
     sp_diode_update(sp, p);
+    p->pfreq = p->freq;
     return SP_OK;
 }
 
@@ -153,9 +154,13 @@ int sp_diode_compute(sp_data *sp, sp_diode *p, SPFLOAT *in, SPFLOAT *out)
     SPFLOAT un;
     SPFLOAT tmp = 0.0;
 
-    /* update filter coefficients */
+    /* coefficients only depend on freq (K on res, but it's one multiply),
+     * so the tan() re-derivation runs at control rate, not per sample */
     p->K = p->res * 17;
-    sp_diode_update(sp, p);
+    if(p->pfreq != p->freq) {
+        sp_diode_update(sp, p);
+        p->pfreq = p->freq;
+    }
 
     p->opva_fdbk[2] = sp_diode_opva_fdbk_out(sp, p, 3);
     p->opva_fdbk[1] = sp_diode_opva_fdbk_out(sp, p, 2);
@@ -175,3 +180,40 @@ int sp_diode_compute(sp_data *sp, sp_diode *p, SPFLOAT *in, SPFLOAT *out)
     *out = tmp;
     return SP_OK;
 }
+
+int sp_diode_compute_block(sp_data *sp, sp_diode *p, SPFLOAT *in, SPFLOAT *out, int n)
+{
+    int i, j;
+    SPFLOAT sigma;
+    SPFLOAT un;
+    SPFLOAT tmp;
+
+    /* derive coefficients once for the whole block */
+    p->K = p->res * 17;
+    if(p->pfreq != p->freq) {
+        sp_diode_update(sp, p);
+        p->pfreq = p->freq;
+    }
+
+    /* the feedback chain is recursive, so the core stays scalar; hoisting
+     * the update still removes the per-sample tan() and divisions setup */
+    for(j = 0; j < n; j++) {
+        p->opva_fdbk[2] = sp_diode_opva_fdbk_out(sp, p, 3);
+        p->opva_fdbk[1] = sp_diode_opva_fdbk_out(sp, p, 2);
+        p->opva_fdbk[0] = sp_diode_opva_fdbk_out(sp, p, 1);
+
+        sigma =
+            p->SG[0] * sp_diode_opva_fdbk_out(sp, p, 0) +
+            p->SG[1] * sp_diode_opva_fdbk_out(sp, p, 1) +
+            p->SG[2] * sp_diode_opva_fdbk_out(sp, p, 2) +
+            p->SG[3] * sp_diode_opva_fdbk_out(sp, p, 3);
+
+        un = (in[j] - p->K * sigma) / (1 + p->K * p->gamma);
+        tmp = un;
+        for(i = 0; i < 4; i++) {
+            tmp = sp_diode_opva_compute(sp, p, tmp, i);
+        }
+        out[j] = tmp;
+    }
+    return SP_OK;
+}
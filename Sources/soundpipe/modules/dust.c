@@ -69,3 +69,41 @@ int sp_dust_compute(sp_data *sp, sp_dust *p, SPFLOAT *in, SPFLOAT *out)
 
     return SP_OK;
 }
+
+/* Fills a whole block, refreshing the threshold and scale once per
+ * block instead of once per sample. Same sequence as sp_dust_compute. */
+int sp_dust_compute_block(sp_data *sp, sp_dust *p, SPFLOAT *in, SPFLOAT *out, int n)
+{
+    const SPFLOAT dv2_31 = 4.656612873077392578125e-10;
+    SPFLOAT density, thresh, scale;
+    SPFLOAT amp = p->amp;
+    int bipolar = p->bipolar;
+    int i;
+
+    density = p->density;
+    if (density != p->density0) {
+        thresh = p->thresh = density * p->onedsr;
+        if(bipolar) {
+            scale  = p->scale  = (thresh > 0.0 ? 2.0 / thresh : 0.0);
+        } else {
+            scale  = p->scale  = (thresh > 0.0 ? 1.0 / thresh : 0.0);
+        }
+        p->density0 = density;
+    } else {
+        thresh = p->thresh;
+        scale  = p->scale;
+    }
+
+    for (i = 0; i < n; i++) {
+        SPFLOAT r;
+        p->rand = sp_rand(sp);
+        r = (SPFLOAT)p->rand * dv2_31;
+        if(bipolar) {
+            out[i] = amp * (r < thresh ? r*scale - 1.0 : 0.0);
+        } else {
+            out[i] = amp * (r < thresh ? r*scale : 0.0);
+        }
+    }
+
+    return SP_OK;
+}
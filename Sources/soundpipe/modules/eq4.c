@@ -0,0 +1,92 @@
+/*
+ * Eq4
+ *
+ * Four-band channel-strip equalizer built from sp_pareq bands: a low
+ * shelf, two peaking sections, and a high shelf, run serially in one
+ * fused loop over the block. Replaces a chain of four separate pareq
+ * nodes and the three buffer passes between them.
+ *
+ */
+
+#include <stdlib.h>
+#include "soundpipe.h"
+
+int sp_eq4_create(sp_eq4 **p)
+{
+    *p = malloc(sizeof(sp_eq4));
+    return SP_OK;
+}
+
+int sp_eq4_destroy(sp_eq4 **p)
+{
+    free(*p);
+    return SP_OK;
+}
+
+int sp_eq4_init(sp_data *sp, sp_eq4 *p)
+{
+    int b;
+    static const SPFLOAT fc[SP_EQ4_NBANDS] = {100, 400, 2000, 8000};
+    static const SPFLOAT mode[SP_EQ4_NBANDS] = {1, 0, 0, 2};
+
+    for (b = 0; b < SP_EQ4_NBANDS; b++) {
+        sp_pareq_init(sp, &p->band[b]);
+        p->band[b].fc = fc[b];
+        p->band[b].mode = mode[b];
+    }
+    return SP_OK;
+}
+
+int sp_eq4_compute(sp_data *sp, sp_eq4 *p, SPFLOAT *in, SPFLOAT *out)
+{
+    SPFLOAT x = *in;
+    int b;
+
+    for (b = 0; b < SP_EQ4_NBANDS; b++) {
+        sp_pareq_compute(sp, &p->band[b], &x, &x);
+    }
+    *out = x;
+    return SP_OK;
+}
+
+/* Processes all bands in one traversal of the block: coefficients are
+ * refreshed once per call (control rate) and every band's filter state
+ * stays in locals for the whole loop. */
+int sp_eq4_compute_block(sp_data *sp, sp_eq4 *p, SPFLOAT *in, SPFLOAT *out, int n)
+{
+    SPFLOAT b0[SP_EQ4_NBANDS], b1[SP_EQ4_NBANDS], b2[SP_EQ4_NBANDS];
+    SPFLOAT a1[SP_EQ4_NBANDS], a2[SP_EQ4_NBANDS];
+    SPFLOAT x1[SP_EQ4_NBANDS], x2[SP_EQ4_NBANDS];
+    SPFLOAT y1[SP_EQ4_NBANDS], y2[SP_EQ4_NBANDS];
+    int b, i;
+
+    for (b = 0; b < SP_EQ4_NBANDS; b++) {
+        sp_pareq *eq = &p->band[b];
+        sp_pareq_update(eq);
+        b0[b] = eq->b0; b1[b] = eq->b1; b2[b] = eq->b2;
+        a1[b] = eq->a1; a2[b] = eq->a2;
+        x1[b] = eq->xnm1; x2[b] = eq->xnm2;
+        y1[b] = eq->ynm1; y2[b] = eq->ynm2;
+    }
+
+    for (i = 0; i < n; i++) {
+        SPFLOAT x = in[i];
+        for (b = 0; b < SP_EQ4_NBANDS; b++) {
+            SPFLOAT y = b0[b] * x + b1[b] * x1[b] + b2[b] * x2[b]
+                      - a1[b] * y1[b] - a2[b] * y2[b];
+            x2[b] = x1[b];
+            x1[b] = x;
+            y2[b] = y1[b];
+            y1[b] = y;
+            x = y;
+        }
+        out[i] = x;
+    }
+
+    for (b = 0; b < SP_EQ4_NBANDS; b++) {
+        sp_pareq *eq = &p->band[b];
+        eq->xnm1 = x1[b]; eq->xnm2 = x2[b];
+        eq->ynm1 = y1[b]; eq->ynm2 = y2[b];
+    }
+    return SP_OK;
+}
@@ -231,3 +231,128 @@ int sp_fof_compute(sp_data *sp, sp_fof *p, SPFLOAT *in, SPFLOAT *out)
     p->fundphs += fund_inc;
     return SP_OK;
 }
+
+/* Render one grain's next nsmps samples in a single pass over local
+ * state, splitting the span at the rise/decay envelope boundaries so
+ * the inner loop carries no per-sample envelope tests. */
+static void fof_grain_span(sp_fof *p, sp_fof_overlap *ovp, int32_t form_inc,
+                           SPFLOAT *out, int32_t nsmps)
+{
+    sp_ftbl *ftp1 = p->ftp1;
+    sp_ftbl *ftp2 = p->ftp2;
+    SPFLOAT curamp = ovp->curamp;
+    SPFLOAT expamp = ovp->expamp;
+    int32_t formphs = ovp->formphs;
+    int32_t done = 0;
+
+    while (done < nsmps) {
+        int32_t i, run = nsmps - done;
+        int rising = ovp->risphs < SP_FT_MAXLEN;
+        int decaying = ovp->timrem <= ovp->dectim;
+        int32_t risphs = ovp->risphs;
+        int32_t decphs = ovp->decphs;
+
+        if (rising && ovp->risinc > 0) {
+            int32_t r = (SP_FT_MAXLEN - risphs + ovp->risinc - 1) / ovp->risinc;
+            if (r < run) run = r;
+        }
+        if (!decaying) {
+            int32_t d = ovp->timrem - ovp->dectim;
+            if (d < run) run = d;
+        }
+
+        for (i = 0; i < run; i++) {
+            SPFLOAT v1, fract, result, *ftab;
+            fract = PFRAC1(formphs);
+            ftab = ftp1->tbl + (formphs >> ftp1->lobits);
+            v1 = *ftab++;
+            result = v1 + (*ftab - v1) * fract;
+            if (p->foftype) {
+                if (p->fmtmod) formphs += form_inc;
+                else formphs += ovp->forminc;
+            } else {
+                formphs += (int32_t)(ovp->forminc + ovp->glissbas * ovp->sampct++);
+            }
+            formphs &= SP_FT_PHMASK;
+            if (rising) {
+                result *= *(ftp2->tbl + (risphs >> ftp2->lobits));
+                risphs += ovp->risinc;
+            }
+            if (decaying) {
+                result *= *(ftp2->tbl + (decphs >> ftp2->lobits));
+                if ((decphs -= ovp->decinc) < 0) decphs = 0;
+            }
+            out[done + i] += result * curamp;
+            curamp *= expamp;
+        }
+
+        ovp->risphs = risphs;
+        ovp->decphs = decphs;
+        ovp->timrem -= run;
+        done += run;
+    }
+
+    ovp->curamp = curamp;
+    ovp->formphs = formphs;
+}
+
+/* Block variant: grain activations are scheduled from the fundamental
+ * phase, splitting the block at each new pulse, and within a segment
+ * every active grain renders its contiguous span in one pass instead of
+ * being revisited through the overlap list on each sample.  Grains are
+ * still rendered in overlap list order, so each output sample sums its
+ * grain contributions in the same order as the per-sample version and
+ * the output is identical.  Parameters are read once and held for the
+ * whole block. */
+int sp_fof_compute_block(sp_data *sp, sp_fof *p, SPFLOAT *in, SPFLOAT *out, int n)
+{
+    sp_fof_overlap *ovp;
+    SPFLOAT amp, fund, form;
+    int32_t fund_inc, form_inc;
+    int32_t pos = 0, seg, span, i;
+
+    amp = p->amp;
+    fund = p->fund;
+    form = p->form;
+    fund_inc = (int32_t)(fund * p->ftp1->sicvt);
+    form_inc = (int32_t)(form * p->ftp1->sicvt);
+
+    for (i = 0; i < n; i++) out[i] = 0.0;
+
+    while (pos < n) {
+        if (p->fundphs & SP_FT_MAXLEN) {
+            p->fundphs &= SP_FT_PHMASK;
+            ovp = p->basovrlap.nxtfree;
+            if (newpulse(sp, p, ovp, amp, fund, form)) {
+                ovp->nxtact = p->basovrlap.nxtact;
+                p->basovrlap.nxtact = ovp;
+                p->basovrlap.nxtfree = ovp->nxtfree;
+            }
+        }
+
+        /* segment runs until the next pulse is due or the block ends */
+        seg = n - pos;
+        if (fund_inc > 0) {
+            int32_t steps = (SP_FT_MAXLEN - p->fundphs + fund_inc - 1) / fund_inc;
+            if (steps < seg) seg = steps;
+        }
+
+        ovp = &p->basovrlap;
+        while (ovp->nxtact != NULL) {
+            sp_fof_overlap *prvact = ovp;
+            ovp = ovp->nxtact;
+            span = (seg < ovp->timrem) ? seg : ovp->timrem;
+            fof_grain_span(p, ovp, form_inc, out + pos, span);
+            if (ovp->timrem <= 0) {
+                prvact->nxtact = ovp->nxtact;
+                ovp->nxtfree = p->basovrlap.nxtfree;
+                p->basovrlap.nxtfree = ovp;
+                ovp = prvact;
+            }
+        }
+
+        p->fundphs += seg * fund_inc;
+        pos += seg;
+    }
+    return SP_OK;
+}
@@ -242,3 +242,140 @@ int sp_fog_compute(sp_data *sp, sp_fog *p, SPFLOAT *in, SPFLOAT *out)
     p->spdphs &= SP_FT_PHMASK;
     return SP_OK;
 }
+
+/* Render one grain's next nsmps samples in a single pass over local
+ * state, splitting the span at the rise/decay envelope boundaries so
+ * the inner loop carries no per-sample envelope tests. */
+static void fog_grain_span(sp_fog *p, sp_fog_overlap *ovp, SPFLOAT *out,
+                           int32_t nsmps)
+{
+    sp_ftbl *ftp1 = p->ftp1;
+    sp_ftbl *ftp2 = p->ftp2;
+    SPFLOAT curamp = ovp->curamp;
+    SPFLOAT expamp = ovp->expamp;
+    SPFLOAT pos = ovp->pos;
+    SPFLOAT inc = ovp->inc;
+    int32_t done = 0;
+
+    while (done < nsmps) {
+        int32_t i, run = nsmps - done;
+        int rising = ovp->risphs < SP_FT_MAXLEN;
+        int decaying = ovp->timrem <= ovp->dectim;
+        uint32_t risphs = ovp->risphs;
+        int32_t decphs = ovp->decphs;
+
+        if (rising && ovp->risinc > 0) {
+            int32_t r = (int32_t)((SP_FT_MAXLEN - risphs + ovp->risinc - 1)
+                                  / ovp->risinc);
+            if (r < run) run = r;
+        }
+        if (!decaying) {
+            int32_t d = ovp->timrem - ovp->dectim;
+            if (d < run) run = d;
+        }
+
+        for (i = 0; i < run; i++) {
+            SPFLOAT x1, x2, fract, result;
+            int32_t ndx, incr;
+            ndx = floor(pos);
+            fract = pos - ndx;
+            while (ndx >= ftp1->size) ndx -= ftp1->size;
+            while (ndx < 0) ndx += ftp1->size;
+            x1 = ftp1->tbl[ndx];
+            x2 = ftp1->tbl[ndx + 1];
+            result = x1 + (x2 - x1) * fract;
+            pos += inc;
+            if (rising) {
+                /* bounds checking so it doesn't segfault */
+                incr = (risphs >> ftp2->lobits);
+                if (incr <= ftp2->size) result *= *(ftp2->tbl + incr);
+                else result = 0;
+                risphs += ovp->risinc;
+            }
+            if (decaying) {
+                incr = (decphs >> ftp2->lobits);
+                if (incr <= ftp2->size) result *= *(ftp2->tbl + incr);
+                else result = 0;
+                if ((decphs -= ovp->decinc) < 0) decphs = 0;
+            }
+            out[done + i] += result * curamp;
+            curamp *= expamp;
+        }
+
+        ovp->risphs = risphs;
+        ovp->decphs = decphs;
+        ovp->timrem -= run;
+        done += run;
+    }
+
+    ovp->curamp = curamp;
+    ovp->pos = pos;
+}
+
+/* Block variant: grain activations are scheduled from the fundamental
+ * phase, splitting the block at each new pulse, and within a segment
+ * every active grain renders its contiguous span in one pass instead of
+ * being revisited through the overlap list on each sample.  Grains are
+ * still rendered in overlap list order, so each output sample sums its
+ * grain contributions in the same order as the per-sample version and
+ * the output is identical.  Parameters are read once and held for the
+ * whole block. */
+int sp_fog_compute_block(sp_data *sp, sp_fog *p, SPFLOAT *in, SPFLOAT *out, int n)
+{
+    sp_fog_overlap *ovp;
+    SPFLOAT amp, fund, ptch, speed;
+    int32_t fund_inc;
+    int32_t pos = 0, seg, span, i;
+
+    amp = p->amp;
+    fund = p->dens;
+    ptch = p->trans;
+    speed = p->spd;
+    fund_inc = (int32_t)(fund * p->ftp1->sicvt);
+
+    for (i = 0; i < n; i++) out[i] = 0.0;
+
+    while (pos < n) {
+        if (p->fundphs & SP_FT_MAXLEN) {
+            p->fundphs &= SP_FT_PHMASK;
+            ovp = p->basovrlap.nxtfree;
+            if (newpulse(sp, p, ovp, amp, fund, ptch)) {
+                ovp->nxtact = p->basovrlap.nxtact;
+                p->basovrlap.nxtact = ovp;
+                p->basovrlap.nxtfree = ovp->nxtfree;
+            }
+        }
+        if (pos == 0) {
+            /* the per-sample version refreshes the speed phase after
+               every sample, so only a pulse on the block's first sample
+               sees the value carried over from the previous call */
+            p->spdphs = (int32_t)(speed * SP_FT_MAXLEN);
+            p->spdphs &= SP_FT_PHMASK;
+        }
+
+        /* segment runs until the next pulse is due or the block ends */
+        seg = n - pos;
+        if (fund_inc > 0) {
+            int32_t steps = (SP_FT_MAXLEN - p->fundphs + fund_inc - 1) / fund_inc;
+            if (steps < seg) seg = steps;
+        }
+
+        ovp = &p->basovrlap;
+        while (ovp->nxtact != NULL) {
+            sp_fog_overlap *prvact = ovp;
+            ovp = ovp->nxtact;
+            span = (seg < ovp->timrem) ? seg : ovp->timrem;
+            fog_grain_span(p, ovp, out + pos, span);
+            if (ovp->timrem <= 0) {
+                prvact->nxtact = ovp->nxtact;
+                ovp->nxtfree = p->basovrlap.nxtfree;
+                p->basovrlap.nxtfree = ovp;
+                ovp = prvact;
+            }
+        }
+
+        p->fundphs += seg * fund_inc;
+        pos += seg;
+    }
+    return SP_OK;
+}
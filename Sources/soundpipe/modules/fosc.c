@@ -99,3 +99,50 @@ int sp_fosc_compute(sp_data *sp, sp_fosc *p, SPFLOAT *in, SPFLOAT *out)
 
     return SP_OK;
 }
+
+int sp_fosc_compute_block(sp_data *sp, sp_fosc *p, SPFLOAT *in, SPFLOAT *out, int n)
+{
+    sp_ftbl *ftp = p->ft;
+    SPFLOAT *ft = ftp->tbl;
+    SPFLOAT lodiv = ftp->lodiv;
+    SPFLOAT sicvt = ftp->sicvt;
+    int32_t lobits = ftp->lobits;
+    int32_t lomask = ftp->lomask;
+    int32_t size = (int32_t)ftp->size;
+    int32_t mphs = p->mphs & SP_FT_PHMASK;
+    int32_t cphs = p->cphs & SP_FT_PHMASK;
+    SPFLOAT amp = p->amp;
+    SPFLOAT car = p->freq * p->car;
+    SPFLOAT mod = p->freq * p->mod;
+    SPFLOAT ndx = p->indx * mod;
+    int32_t minc = (int32_t)(mod * sicvt);
+    int i;
+
+    /* both operators' phase accumulators stay in registers for the block;
+     * parameters are held constant and re-read at block rate by the caller */
+    for (i = 0; i < n; i++) {
+        SPFLOAT fract, v1, v2, fmod, cfreq;
+        int32_t pos, cinc;
+
+        fract = (mphs & lomask) * lodiv;
+        pos = mphs >> lobits;
+        v1 = ft[pos];
+        v2 = ft[(pos + 1) % size];
+        fmod = (v1 + (v2 - v1) * fract) * ndx;
+        mphs = (mphs + minc) & SP_FT_PHMASK;
+
+        cfreq = car + fmod;
+        cinc = (int32_t)(cfreq * sicvt);
+        fract = (cphs & lomask) * lodiv;
+        pos = cphs >> lobits;
+        v1 = ft[pos];
+        v2 = ft[(pos + 1) % size];
+        out[i] = (v1 + (v2 - v1) * fract) * amp;
+        cphs = (cphs + cinc) & SP_FT_PHMASK;
+    }
+
+    p->mphs = mphs;
+    p->cphs = cphs;
+
+    return SP_OK;
+}
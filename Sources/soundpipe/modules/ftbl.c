@@ -24,9 +24,24 @@ int sp_ftbl_init(sp_data *sp, sp_ftbl *ft, size_t size)
 
 int sp_ftbl_create(sp_data *sp, sp_ftbl **ft, size_t size)
 {
-    *ft = malloc(sizeof(sp_ftbl));
-    sp_ftbl *ftp = *ft;
-    ftp->tbl = malloc(sizeof(SPFLOAT) * (size + 1));
+    /* struct and table come from the arena slab in one block when one is set */
+    sp_ftbl *ftp = sp_arena_alloc(sp, sizeof(sp_ftbl) + sizeof(SPFLOAT) * (size + 1));
+    if (ftp != NULL) {
+        ftp->tbl = (SPFLOAT *)(ftp + 1);
+        ftp->arena = 1;
+        ftp->tbl_arena = 1;
+    } else {
+        ftp = malloc(sizeof(sp_ftbl));
+        ftp->tbl = malloc(sizeof(SPFLOAT) * (size + 1));
+        ftp->arena = 0;
+        ftp->tbl_arena = 0;
+        if (sp_alloc_report) {
+            sp_alloc_report("ftbl", (long)(sizeof(sp_ftbl) + sizeof(SPFLOAT) * (size + 1)));
+        }
+    }
+    ftp->cache = NULL;
+    ftp->filemap = NULL;
+    *ft = ftp;
     memset(ftp->tbl, 0, sizeof(SPFLOAT) * (size + 1));
 
     sp_ftbl_init(sp, ftp, size);
@@ -35,19 +50,50 @@ int sp_ftbl_create(sp_data *sp, sp_ftbl **ft, size_t size)
 
 int sp_ftbl_bind(sp_data *sp, sp_ftbl **ft, SPFLOAT *tbl, size_t size)
 {
-    *ft = malloc(sizeof(sp_ftbl));
-    sp_ftbl *ftp = *ft;
+    sp_ftbl *ftp = sp_arena_alloc(sp, sizeof(sp_ftbl));
+    if (ftp != NULL) {
+        ftp->arena = 1;
+    } else {
+        ftp = malloc(sizeof(sp_ftbl));
+        ftp->arena = 0;
+        if (sp_alloc_report) sp_alloc_report("ftbl", (long)sizeof(sp_ftbl));
+    }
+    ftp->tbl_arena = 0;
+    ftp->cache = NULL;
+    ftp->filemap = NULL;
+    *ft = ftp;
     ftp->tbl = tbl;
     sp_ftbl_init(sp, ftp, size);
     ftp->del = 0;
     return SP_OK;
 }
 
+/* zero-copy view of a region of a parent table; the view shares the
+ * parent's samples and must not outlive them. The region may end at the
+ * parent's last sample: interpolating readers then use the parent's
+ * guard point. */
+int sp_ftbl_view(sp_data *sp, sp_ftbl **ft, sp_ftbl *parent, size_t offset, size_t size)
+{
+    if (offset + size > parent->size) return SP_NOT_OK;
+    return sp_ftbl_bind(sp, ft, parent->tbl + offset, size);
+}
+
 int sp_ftbl_destroy(sp_ftbl **ft)
 {
     sp_ftbl *ftp = *ft;
-    if(ftp->del) free(ftp->tbl);
-    free(*ft);
+    if(ftp->cache != NULL) sp_ftbl_cache_release(ftp);
+    if(ftp->filemap != NULL) sp_ftbl_filemap_release(ftp);
+    /* arena-backed memory is reclaimed all at once by sp_arena_destroy */
+    if(ftp->del && !ftp->tbl_arena) {
+        free(ftp->tbl);
+        if (sp_alloc_report) {
+            sp_alloc_report("ftbl", -(long)(sizeof(SPFLOAT) * (ftp->size + 1)));
+        }
+    }
+    if(!ftp->arena) {
+        free(*ft);
+        if (sp_alloc_report) sp_alloc_report("ftbl", -(long)sizeof(sp_ftbl));
+    }
     return SP_OK;
 }
 
@@ -82,7 +128,20 @@ int sp_gen_vals(sp_data *sp, sp_ftbl *ft, const char *string)
     while(size > 0) {
         out = tokenize(&str, &size);
         if(ft->size < j + 1){
-            ft->tbl = realloc(ft->tbl, sizeof(SPFLOAT) * (ft->size + 2));
+            if(ft->tbl_arena) {
+                /* arena blocks can't be realloc'd; migrate the table to the heap */
+                SPFLOAT *tbl = malloc(sizeof(SPFLOAT) * (ft->size + 2));
+                memcpy(tbl, ft->tbl, sizeof(SPFLOAT) * (ft->size + 1));
+                ft->tbl = tbl;
+                ft->tbl_arena = 0;
+                ft->del = 1;
+                if (sp_alloc_report) {
+                    sp_alloc_report("ftbl", (long)(sizeof(SPFLOAT) * (ft->size + 2)));
+                }
+            } else {
+                ft->tbl = realloc(ft->tbl, sizeof(SPFLOAT) * (ft->size + 2));
+                if (sp_alloc_report && ft->del) sp_alloc_report("ftbl", (long)sizeof(SPFLOAT));
+            }
             /* zero out new tables */
             ft->tbl[ft->size] = 0;
             ft->tbl[ft->size + 1] = 0;
@@ -0,0 +1,454 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "soundpipe.h"
+
+/* Process-wide interned ftable cache.
+ *
+ * Nodes that want the same generated table (a 4096-point sine, say)
+ * share one buffer instead of each generating their own: the cache
+ * keys on (generator name, size, argument string) and hands out
+ * per-sp_data aliases bound to the interned buffer, so the table data
+ * stays resident across every node that uses it.  The alias structs
+ * are ordinary ftables (sicvt and friends computed for the caller's
+ * sp_data) with del = 0, so sp_ftbl_destroy never frees the shared
+ * buffer; it just drops the entry's refcount.  Entries stay interned
+ * at zero refs so reloading a patch hits the cache; a host can trim
+ * them with sp_ftbl_cache_clear.
+ *
+ * A writer must call sp_ftbl_cache_cow first to detach onto a private
+ * copy; mutating an alias in place would alter the table under every
+ * other holder.
+ */
+
+typedef struct sp_ftcache_entry {
+    char *name;
+    char *args;
+    size_t size;
+    uint64_t hash; /* content hash; 0 for generator-keyed entries */
+    SPFLOAT *tbl;
+    uint32_t refs;
+    int busy; /* queued for pre-generation; readers wait on ftcache_cond */
+    struct sp_ftcache_entry *next;
+} sp_ftcache_entry;
+
+static sp_ftcache_entry *ftcache_root = NULL;
+static pthread_mutex_t ftcache_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t ftcache_cond = PTHREAD_COND_INITIALIZER;
+
+static char * ftcache_strdup(const char *str)
+{
+    char *out = malloc(strlen(str) + 1);
+    if(out != NULL) strcpy(out, str);
+    return out;
+}
+
+static sp_ftcache_entry * ftcache_find(const char *name, const char *args,
+        size_t size)
+{
+    sp_ftcache_entry *entry = ftcache_root;
+    while(entry != NULL) {
+        if(entry->size == size &&
+                !strcmp(entry->name, name) &&
+                !strcmp(entry->args, args)) {
+            return entry;
+        }
+        entry = entry->next;
+    }
+    return NULL;
+}
+
+/* binds a caller-local ftbl onto the entry's shared buffer */
+static int ftcache_alias(sp_data *sp, sp_ftbl **ft, sp_ftcache_entry *entry)
+{
+    if(sp_ftbl_bind(sp, ft, entry->tbl, entry->size) != SP_OK) {
+        return SP_NOT_OK;
+    }
+    (*ft)->cache = entry;
+    entry->refs++;
+    return SP_OK;
+}
+
+static sp_ftcache_entry * ftcache_insert(const char *name, const char *args,
+        size_t size)
+{
+    sp_ftcache_entry *entry = malloc(sizeof(sp_ftcache_entry));
+    if(entry == NULL) return NULL;
+    entry->tbl = calloc(size + 1, sizeof(SPFLOAT));
+    entry->name = ftcache_strdup(name);
+    entry->args = ftcache_strdup(args);
+    if(entry->tbl == NULL || entry->name == NULL || entry->args == NULL) {
+        free(entry->tbl);
+        free(entry->name);
+        free(entry->args);
+        free(entry);
+        return NULL;
+    }
+    entry->size = size;
+    entry->hash = 0;
+    entry->refs = 0;
+    entry->busy = 0;
+    entry->next = ftcache_root;
+    ftcache_root = entry;
+    return entry;
+}
+
+static void ftcache_make_ready(sp_data *sp, sp_ftcache_entry *entry);
+
+/* FNV-1a over the raw sample bytes */
+static uint64_t ftcache_hash(const SPFLOAT *data, size_t size)
+{
+    const unsigned char *bytes = (const unsigned char *)data;
+    size_t nbytes = size * sizeof(SPFLOAT);
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    size_t i;
+    for(i = 0; i < nbytes; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+/* Content-keyed variant for tables delivered as raw sample data (the
+ * setWavetableDSP path): identical tables intern to one buffer no
+ * matter which node or sp_data sent them. The hash narrows the search;
+ * a memcmp guards against collisions. The name "@data" cannot clash
+ * with generator names. */
+int sp_ftbl_cache_get_data(sp_data *sp, sp_ftbl **ft,
+        const SPFLOAT *data, size_t size)
+{
+    sp_ftcache_entry *entry;
+    uint64_t hash = ftcache_hash(data, size);
+    int rc;
+
+    pthread_mutex_lock(&ftcache_lock);
+    entry = ftcache_root;
+    while(entry != NULL) {
+        if(entry->hash == hash && entry->size == size &&
+                !strcmp(entry->name, "@data") &&
+                !memcmp(entry->tbl, data, size * sizeof(SPFLOAT))) {
+            break;
+        }
+        entry = entry->next;
+    }
+    if(entry == NULL) {
+        entry = ftcache_insert("@data", "", size);
+        if(entry == NULL) {
+            pthread_mutex_unlock(&ftcache_lock);
+            /* fall back to a private table */
+            if(sp_ftbl_create(sp, ft, size) != SP_OK) return SP_NOT_OK;
+            memcpy((*ft)->tbl, data, size * sizeof(SPFLOAT));
+            return SP_OK;
+        }
+        entry->hash = hash;
+        memcpy(entry->tbl, data, size * sizeof(SPFLOAT));
+    }
+    rc = ftcache_alias(sp, ft, entry);
+    pthread_mutex_unlock(&ftcache_lock);
+    return rc;
+}
+
+int sp_ftbl_cache_get(sp_data *sp, sp_ftbl **ft, size_t size,
+        const char *name, int (*gen)(sp_data *, sp_ftbl *))
+{
+    sp_ftcache_entry *entry;
+    int rc;
+
+    pthread_mutex_lock(&ftcache_lock);
+    entry = ftcache_find(name, "", size);
+    if(entry == NULL) {
+        entry = ftcache_insert(name, "", size);
+        if(entry == NULL) {
+            pthread_mutex_unlock(&ftcache_lock);
+            /* fall back to a private table */
+            if(sp_ftbl_create(sp, ft, size) != SP_OK) return SP_NOT_OK;
+            return gen(sp, *ft);
+        }
+        rc = ftcache_alias(sp, ft, entry);
+        if(rc == SP_OK) rc = gen(sp, *ft);
+        pthread_mutex_unlock(&ftcache_lock);
+        return rc;
+    }
+    ftcache_make_ready(sp, entry);
+    rc = ftcache_alias(sp, ft, entry);
+    pthread_mutex_unlock(&ftcache_lock);
+    return rc;
+}
+
+int sp_ftbl_cache_get_args(sp_data *sp, sp_ftbl **ft, size_t size,
+        const char *name, const char *args,
+        int (*gen)(sp_data *, sp_ftbl *, const char *))
+{
+    sp_ftcache_entry *entry;
+    int rc;
+
+    pthread_mutex_lock(&ftcache_lock);
+    entry = ftcache_find(name, args, size);
+    if(entry == NULL) {
+        entry = ftcache_insert(name, args, size);
+        if(entry == NULL) {
+            pthread_mutex_unlock(&ftcache_lock);
+            if(sp_ftbl_create(sp, ft, size) != SP_OK) return SP_NOT_OK;
+            return gen(sp, *ft, args);
+        }
+        rc = ftcache_alias(sp, ft, entry);
+        if(rc == SP_OK) rc = gen(sp, *ft, args);
+        pthread_mutex_unlock(&ftcache_lock);
+        return rc;
+    }
+    ftcache_make_ready(sp, entry);
+    rc = ftcache_alias(sp, ft, entry);
+    pthread_mutex_unlock(&ftcache_lock);
+    return rc;
+}
+
+/* Detach an alias onto a private copy before writing to it. */
+int sp_ftbl_cache_cow(sp_data *sp, sp_ftbl **ft)
+{
+    sp_ftbl *alias = *ft;
+    sp_ftbl *copy;
+
+    if(alias->cache == NULL) return SP_OK;
+
+    if(sp_ftbl_create(sp, &copy, alias->size) != SP_OK) return SP_NOT_OK;
+    memcpy(copy->tbl, alias->tbl, sizeof(SPFLOAT) * (alias->size + 1));
+    sp_ftbl_destroy(&alias);
+    *ft = copy;
+    return SP_OK;
+}
+
+/* Parallel pre-generation.
+ *
+ * Session load can queue every generated table it is about to need with
+ * sp_ftbl_cache_prefetch / _prefetch_args, then call
+ * sp_ftbl_cache_prefetch_run once: the queued generators execute on a
+ * small worker pool instead of serially on the loading thread.  Specs
+ * dedupe through the same (name, args, size) key as the cache itself,
+ * so a patch with a dozen identical sines queues one job.  A
+ * sp_ftbl_cache_get that hits a queued entry steals the job and runs
+ * the generator itself when the job is still on the queue, and only
+ * waits on ftcache_cond when a worker has already claimed it, so
+ * calling get without ever running the queue is still correct -- and
+ * cannot deadlock the thread that was going to call run. */
+
+typedef struct ftcache_job {
+    sp_ftcache_entry *entry;
+    int (*gen)(sp_data *, sp_ftbl *);
+    int (*gen_args)(sp_data *, sp_ftbl *, const char *);
+    struct ftcache_job *next;
+} ftcache_job;
+
+#define FTCACHE_MAX_WORKERS 8
+
+static ftcache_job *ftcache_jobs = NULL;
+static int ftcache_njobs = 0;
+
+/* Ensures a queued entry's buffer is filled before it is aliased.  If
+ * the entry's prefetch job is still sitting on ftcache_jobs there is no
+ * worker that will ever run it, so steal it and run the generator on
+ * this thread; busy stays set while the lock is dropped, so concurrent
+ * getters wait as usual.  Only when the job is gone -- a running worker
+ * owns it -- is waiting on ftcache_cond safe.  Called with ftcache_lock
+ * held; may drop and retake it. */
+static void ftcache_make_ready(sp_data *sp, sp_ftcache_entry *entry)
+{
+    ftcache_job **link, *job;
+    sp_ftbl *ft;
+
+    if(!entry->busy) return;
+
+    job = NULL;
+    for(link = &ftcache_jobs; *link != NULL; link = &(*link)->next) {
+        if((*link)->entry == entry) {
+            job = *link;
+            *link = job->next;
+            ftcache_njobs--;
+            break;
+        }
+    }
+    if(job == NULL) {
+        while(entry->busy) pthread_cond_wait(&ftcache_cond, &ftcache_lock);
+        return;
+    }
+
+    pthread_mutex_unlock(&ftcache_lock);
+    if(sp_ftbl_bind(sp, &ft, entry->tbl, entry->size) == SP_OK) {
+        if(job->gen_args != NULL) job->gen_args(sp, ft, entry->args);
+        else job->gen(sp, ft);
+        sp_ftbl_destroy(&ft);
+    }
+    free(job);
+    pthread_mutex_lock(&ftcache_lock);
+    entry->busy = 0;
+    pthread_cond_broadcast(&ftcache_cond);
+}
+
+static int ftcache_prefetch(size_t size, const char *name, const char *args,
+        int (*gen)(sp_data *, sp_ftbl *),
+        int (*gen_args)(sp_data *, sp_ftbl *, const char *))
+{
+    sp_ftcache_entry *entry;
+    ftcache_job *job;
+
+    job = malloc(sizeof(ftcache_job));
+    if(job == NULL) return SP_NOT_OK;
+
+    pthread_mutex_lock(&ftcache_lock);
+    entry = ftcache_find(name, args, size);
+    if(entry != NULL) {
+        /* interned or already queued; duplicates generate once */
+        pthread_mutex_unlock(&ftcache_lock);
+        free(job);
+        return SP_OK;
+    }
+    entry = ftcache_insert(name, args, size);
+    if(entry == NULL) {
+        pthread_mutex_unlock(&ftcache_lock);
+        free(job);
+        return SP_NOT_OK;
+    }
+    entry->busy = 1;
+    job->entry = entry;
+    job->gen = gen;
+    job->gen_args = gen_args;
+    job->next = ftcache_jobs;
+    ftcache_jobs = job;
+    ftcache_njobs++;
+    pthread_mutex_unlock(&ftcache_lock);
+    return SP_OK;
+}
+
+int sp_ftbl_cache_prefetch(size_t size, const char *name,
+        int (*gen)(sp_data *, sp_ftbl *))
+{
+    return ftcache_prefetch(size, name, "", gen, NULL);
+}
+
+int sp_ftbl_cache_prefetch_args(size_t size, const char *name,
+        const char *args,
+        int (*gen)(sp_data *, sp_ftbl *, const char *))
+{
+    return ftcache_prefetch(size, name, args, NULL, gen);
+}
+
+typedef struct {
+    ftcache_job *next;
+    pthread_mutex_t lock;
+} ftcache_pool;
+
+static void * ftcache_worker(void *ud)
+{
+    ftcache_pool *pool = ud;
+    sp_data *sp;
+
+    /* generators only write ft->tbl; a throwaway sp_data satisfies
+     * their signature without touching any caller's instance */
+    sp_create(&sp);
+    for(;;) {
+        ftcache_job *job;
+        sp_ftbl *ft;
+
+        pthread_mutex_lock(&pool->lock);
+        job = pool->next;
+        if(job != NULL) pool->next = job->next;
+        pthread_mutex_unlock(&pool->lock);
+        if(job == NULL) break;
+
+        if(sp_ftbl_bind(sp, &ft, job->entry->tbl, job->entry->size) == SP_OK) {
+            if(job->gen_args != NULL) job->gen_args(sp, ft, job->entry->args);
+            else job->gen(sp, ft);
+            sp_ftbl_destroy(&ft);
+        }
+
+        pthread_mutex_lock(&ftcache_lock);
+        job->entry->busy = 0;
+        pthread_cond_broadcast(&ftcache_cond);
+        pthread_mutex_unlock(&ftcache_lock);
+        free(job);
+    }
+    sp_destroy(&sp);
+    return NULL;
+}
+
+/* Runs every queued generator on up to FTCACHE_MAX_WORKERS threads and
+ * returns when all queued tables are filled. */
+int sp_ftbl_cache_prefetch_run(void)
+{
+    ftcache_pool pool;
+    pthread_t threads[FTCACHE_MAX_WORKERS];
+    int nthreads, spawned, njobs, i;
+
+    pthread_mutex_lock(&ftcache_lock);
+    pool.next = ftcache_jobs;
+    njobs = ftcache_njobs;
+    ftcache_jobs = NULL;
+    ftcache_njobs = 0;
+    pthread_mutex_unlock(&ftcache_lock);
+
+    if(njobs == 0) return SP_OK;
+    pthread_mutex_init(&pool.lock, NULL);
+
+    nthreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if(nthreads > njobs) nthreads = njobs;
+    if(nthreads > FTCACHE_MAX_WORKERS) nthreads = FTCACHE_MAX_WORKERS;
+    if(nthreads < 1) nthreads = 1;
+
+    spawned = 0;
+    for(i = 0; i < nthreads; i++) {
+        if(pthread_create(&threads[spawned], NULL, ftcache_worker, &pool) == 0) {
+            spawned++;
+        }
+    }
+    if(spawned == 0) {
+        /* no threads available: drain the queue on this thread */
+        ftcache_worker(&pool);
+    }
+    for(i = 0; i < spawned; i++) pthread_join(threads[i], NULL);
+
+    pthread_mutex_destroy(&pool.lock);
+    return SP_OK;
+}
+
+/* Called from sp_ftbl_destroy when the ftable is a cache alias. */
+void sp_ftbl_cache_release(sp_ftbl *ft)
+{
+    sp_ftcache_entry *entry = ft->cache;
+    pthread_mutex_lock(&ftcache_lock);
+    if(entry->refs > 0) entry->refs--;
+    pthread_mutex_unlock(&ftcache_lock);
+    ft->cache = NULL;
+}
+
+/* Frees every unreferenced entry; returns the number still in use.
+ * Busy entries are kept too: their prefetch jobs -- queued or already
+ * claimed by a worker -- hold raw entry pointers, so freeing them here
+ * would leave the generators writing through freed memory. */
+int sp_ftbl_cache_clear(void)
+{
+    sp_ftcache_entry *entry, *next, *kept;
+    int inuse = 0;
+
+    pthread_mutex_lock(&ftcache_lock);
+    entry = ftcache_root;
+    ftcache_root = NULL;
+    kept = NULL;
+    while(entry != NULL) {
+        next = entry->next;
+        if(entry->refs == 0 && !entry->busy) {
+            free(entry->tbl);
+            free(entry->name);
+            free(entry->args);
+            free(entry);
+        } else {
+            entry->next = kept;
+            kept = entry;
+            inuse++;
+        }
+        entry = next;
+    }
+    ftcache_root = kept;
+    pthread_mutex_unlock(&ftcache_lock);
+    return inuse;
+}
@@ -0,0 +1,478 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "soundpipe.h"
+
+/* File-backed ftables.
+ *
+ * sp_ftbl_loadfile decodes a whole file into an ordinary table:
+ * RIFF/WAVE with 16-bit or 24-bit PCM or 32-bit float samples, or a
+ * headerless file taken as raw 32-bit floats.  Multi-channel data is
+ * kept interleaved, matching how the table-reading ugens expect
+ * file-loaded tables to be laid out.
+ *
+ * sp_ftbl_loadfile_mmap maps float-format files read-only instead of
+ * decoding them: the table points straight into the page cache, so
+ * load time is metadata-bound and every patch referencing the same
+ * file shares one mapping.  Mappings are interned in a process-wide
+ * registry keyed by path, in the manner of the ftable cache in
+ * ftcache.c; aliases are ordinary ftables with del = 0, and
+ * sp_ftbl_destroy drops the mapping's refcount through
+ * sp_ftbl_filemap_release.  Non-float files fall back to a full
+ * decode.
+ *
+ * sp_ftbl_stream_create sizes the table from the header alone, then a
+ * decode thread fills it in the background, publishing a watermark of
+ * samples decoded so far.  Reads beyond the watermark see the zeros
+ * the table was created with, so a patch can start the moment the
+ * header is parsed while the decode races ahead of playback.
+ */
+
+typedef struct {
+    int format;          /* 1 = PCM, 3 = IEEE float */
+    int channels;
+    int bits;
+    uint32_t sr;
+    size_t data_offset;  /* byte offset of the first sample */
+    size_t data_bytes;
+} ftfile_info;
+
+static uint32_t ftfile_u32(const unsigned char *b)
+{
+    return (uint32_t)b[0] | ((uint32_t)b[1] << 8) |
+           ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+}
+
+static uint16_t ftfile_u16(const unsigned char *b)
+{
+    return (uint16_t)b[0] | ((uint16_t)b[1] << 8);
+}
+
+/* Parses a RIFF/WAVE header, walking the chunk list for fmt and data.
+ * A file without the RIFF magic is treated as raw 32-bit float mono. */
+static int ftfile_read_header(FILE *fp, ftfile_info *info)
+{
+    unsigned char buf[24];
+    size_t fsize;
+    uint32_t chunk_bytes;
+
+    fseek(fp, 0, SEEK_END);
+    fsize = (size_t)ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+
+    if(fread(buf, 1, 12, fp) != 12 || memcmp(buf, "RIFF", 4) ||
+            memcmp(buf + 8, "WAVE", 4)) {
+        if(fsize < sizeof(float)) return SP_NOT_OK;
+        info->format = 3;
+        info->channels = 1;
+        info->bits = 32;
+        info->sr = 0;
+        info->data_offset = 0;
+        info->data_bytes = fsize - (fsize % sizeof(float));
+        return SP_OK;
+    }
+
+    info->format = 0;
+    info->data_bytes = 0;
+    while(fread(buf, 1, 8, fp) == 8) {
+        chunk_bytes = ftfile_u32(buf + 4);
+        if(!memcmp(buf, "fmt ", 4)) {
+            if(chunk_bytes < 16 || fread(buf, 1, 16, fp) != 16) return SP_NOT_OK;
+            info->format = ftfile_u16(buf);
+            info->channels = ftfile_u16(buf + 2);
+            info->sr = ftfile_u32(buf + 4);
+            info->bits = ftfile_u16(buf + 14);
+            if(chunk_bytes > 16) fseek(fp, chunk_bytes - 16, SEEK_CUR);
+        } else if(!memcmp(buf, "data", 4)) {
+            info->data_offset = (size_t)ftell(fp);
+            info->data_bytes = chunk_bytes;
+            if(info->data_offset + info->data_bytes > fsize)
+                info->data_bytes = fsize - info->data_offset;
+            break;
+        } else {
+            /* chunks are word aligned */
+            fseek(fp, chunk_bytes + (chunk_bytes & 1), SEEK_CUR);
+        }
+    }
+
+    if(info->data_bytes == 0 || info->channels < 1) return SP_NOT_OK;
+    if(info->format == 1 && (info->bits == 16 || info->bits == 24)) return SP_OK;
+    if(info->format == 3 && info->bits == 32) return SP_OK;
+    return SP_NOT_OK;
+}
+
+/* Converts one chunk of raw sample bytes into SPFLOATs. */
+static void ftfile_convert(const ftfile_info *info, const unsigned char *in,
+        SPFLOAT *out, size_t nsamples)
+{
+    size_t i;
+    if(info->format == 3) {
+        for(i = 0; i < nsamples; i++) {
+            float val;
+            memcpy(&val, in + i * 4, 4);
+            out[i] = val;
+        }
+    } else if(info->bits == 16) {
+        for(i = 0; i < nsamples; i++) {
+            int16_t val = (int16_t)ftfile_u16(in + i * 2);
+            out[i] = val / 32768.0f;
+        }
+    } else {
+        for(i = 0; i < nsamples; i++) {
+            const unsigned char *b = in + i * 3;
+            int32_t val = ((int32_t)b[0] << 8) | ((int32_t)b[1] << 16) |
+                          ((int32_t)b[2] << 24);
+            out[i] = (val >> 8) / 8388608.0f;
+        }
+    }
+}
+
+int sp_ftbl_loadfile(sp_data *sp, sp_ftbl **ft, const char *filename)
+{
+    FILE *fp;
+    ftfile_info info;
+    size_t size, done, chunk;
+    unsigned char *buf;
+    sp_ftbl *ftp;
+
+    fp = fopen(filename, "rb");
+    if(fp == NULL) return SP_NOT_OK;
+    if(ftfile_read_header(fp, &info) != SP_OK) {
+        fclose(fp);
+        return SP_NOT_OK;
+    }
+
+    size = info.data_bytes / (info.bits / 8);
+    if(size == 0 || sp_ftbl_create(sp, ft, size) != SP_OK) {
+        fclose(fp);
+        return SP_NOT_OK;
+    }
+    ftp = *ft;
+
+    buf = malloc(4096 * (info.bits / 8));
+    if(buf == NULL) {
+        sp_ftbl_destroy(ft);
+        fclose(fp);
+        return SP_NOT_OK;
+    }
+
+    fseek(fp, (long)info.data_offset, SEEK_SET);
+    done = 0;
+    while(done < size) {
+        chunk = size - done;
+        if(chunk > 4096) chunk = 4096;
+        if(fread(buf, info.bits / 8, chunk, fp) != chunk) break;
+        ftfile_convert(&info, buf, ftp->tbl + done, chunk);
+        done += chunk;
+    }
+    free(buf);
+    fclose(fp);
+    return SP_OK;
+}
+
+/* ---- shared read-only mappings ---- */
+
+typedef struct sp_ftfile_map {
+    char *path;
+    void *base;
+    size_t bytes;
+    SPFLOAT *tbl;
+    size_t size;
+    uint32_t refs;
+    struct sp_ftfile_map *next;
+} sp_ftfile_map;
+
+static sp_ftfile_map *ftfile_root = NULL;
+static pthread_mutex_t ftfile_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static sp_ftfile_map * ftfile_map_open(const char *filename)
+{
+    FILE *fp;
+    ftfile_info info;
+    struct stat st;
+    sp_ftfile_map *map;
+    int fd;
+    void *base;
+    size_t size;
+
+    fp = fopen(filename, "rb");
+    if(fp == NULL) return NULL;
+    if(ftfile_read_header(fp, &info) != SP_OK ||
+            info.format != 3 || sizeof(SPFLOAT) != sizeof(float)) {
+        /* only float-format files can alias the table onto the file */
+        fclose(fp);
+        return NULL;
+    }
+    fclose(fp);
+
+    fd = open(filename, O_RDONLY);
+    if(fd < 0) return NULL;
+    if(fstat(fd, &st) != 0) {
+        close(fd);
+        return NULL;
+    }
+    base = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if(base == MAP_FAILED) return NULL;
+
+    size = info.data_bytes / sizeof(float);
+    /* every table carries a guard sample at tbl[size]; drop the last
+     * sample when reading it would cross the mapping's final page */
+    {
+        size_t page = (size_t)sysconf(_SC_PAGESIZE);
+        size_t mapped = (((size_t)st.st_size + page - 1) / page) * page;
+        while(size > 0 &&
+                info.data_offset + (size + 1) * sizeof(float) > mapped)
+            size--;
+    }
+    if(size == 0) {
+        munmap(base, (size_t)st.st_size);
+        return NULL;
+    }
+
+    map = malloc(sizeof(sp_ftfile_map));
+    if(map == NULL) {
+        munmap(base, (size_t)st.st_size);
+        return NULL;
+    }
+    map->path = malloc(strlen(filename) + 1);
+    if(map->path == NULL) {
+        munmap(base, (size_t)st.st_size);
+        free(map);
+        return NULL;
+    }
+    strcpy(map->path, filename);
+    map->base = base;
+    map->bytes = (size_t)st.st_size;
+    map->tbl = (SPFLOAT *)((char *)base + info.data_offset);
+    map->size = size;
+    map->refs = 0;
+    map->next = ftfile_root;
+    ftfile_root = map;
+    return map;
+}
+
+int sp_ftbl_loadfile_mmap(sp_data *sp, sp_ftbl **ft, const char *filename)
+{
+    sp_ftfile_map *map;
+
+    pthread_mutex_lock(&ftfile_lock);
+    map = ftfile_root;
+    while(map != NULL) {
+        if(!strcmp(map->path, filename)) break;
+        map = map->next;
+    }
+    if(map == NULL) map = ftfile_map_open(filename);
+    if(map == NULL) {
+        pthread_mutex_unlock(&ftfile_lock);
+        /* non-float or unreadable: decode it like sp_ftbl_loadfile */
+        return sp_ftbl_loadfile(sp, ft, filename);
+    }
+    if(sp_ftbl_bind(sp, ft, map->tbl, map->size) != SP_OK) {
+        pthread_mutex_unlock(&ftfile_lock);
+        return SP_NOT_OK;
+    }
+    (*ft)->filemap = map;
+    map->refs++;
+    pthread_mutex_unlock(&ftfile_lock);
+    return SP_OK;
+}
+
+/* Called from sp_ftbl_destroy when the ftable aliases a file mapping. */
+void sp_ftbl_filemap_release(sp_ftbl *ft)
+{
+    sp_ftfile_map *map = ft->filemap;
+    pthread_mutex_lock(&ftfile_lock);
+    if(map->refs > 0) map->refs--;
+    pthread_mutex_unlock(&ftfile_lock);
+    ft->filemap = NULL;
+}
+
+/* Unmaps every unreferenced file; returns the number still in use.
+ * Mappings stay interned at zero refs so reloading a patch reuses
+ * them, mirroring sp_ftbl_cache_clear. */
+int sp_ftbl_filemap_clear(void)
+{
+    sp_ftfile_map *map, *next, *kept;
+    int inuse = 0;
+
+    pthread_mutex_lock(&ftfile_lock);
+    map = ftfile_root;
+    ftfile_root = NULL;
+    kept = NULL;
+    while(map != NULL) {
+        next = map->next;
+        if(map->refs == 0) {
+            munmap(map->base, map->bytes);
+            free(map->path);
+            free(map);
+        } else {
+            map->next = kept;
+            kept = map;
+            inuse++;
+        }
+        map = next;
+    }
+    ftfile_root = kept;
+    pthread_mutex_unlock(&ftfile_lock);
+    return inuse;
+}
+
+/* ---- background decode ---- */
+
+struct sp_ftbl_stream {
+    sp_ftbl *ft;
+    char *path;
+    ftfile_info info;
+    pthread_t thread;
+    pthread_mutex_t lock;
+    size_t loaded;
+    int done;
+    int error;
+};
+
+static void * ftfile_stream_thread(void *ud)
+{
+    sp_ftbl_stream *stream = ud;
+    FILE *fp;
+    unsigned char *buf;
+    size_t done, chunk, size;
+
+    size = stream->ft->size;
+    fp = fopen(stream->path, "rb");
+    buf = malloc(16384 * (stream->info.bits / 8));
+    if(fp == NULL || buf == NULL) {
+        if(fp != NULL) fclose(fp);
+        free(buf);
+        pthread_mutex_lock(&stream->lock);
+        stream->error = 1;
+        stream->done = 1;
+        pthread_mutex_unlock(&stream->lock);
+        return NULL;
+    }
+
+    fseek(fp, (long)stream->info.data_offset, SEEK_SET);
+    done = 0;
+    while(done < size) {
+        chunk = size - done;
+        if(chunk > 16384) chunk = 16384;
+        if(fread(buf, stream->info.bits / 8, chunk, fp) != chunk) break;
+        ftfile_convert(&stream->info, buf, stream->ft->tbl + done, chunk);
+        done += chunk;
+        pthread_mutex_lock(&stream->lock);
+        stream->loaded = done;
+        pthread_mutex_unlock(&stream->lock);
+    }
+    free(buf);
+    fclose(fp);
+
+    pthread_mutex_lock(&stream->lock);
+    stream->error = (done < size);
+    stream->done = 1;
+    pthread_mutex_unlock(&stream->lock);
+    return NULL;
+}
+
+/* The table is sized from the header alone and usable immediately;
+ * samples beyond the watermark read as the zeros they were created
+ * with until the decode thread reaches them. */
+int sp_ftbl_stream_create(sp_data *sp, sp_ftbl_stream **stream,
+        const char *filename)
+{
+    FILE *fp;
+    ftfile_info info;
+    size_t size;
+    sp_ftbl_stream *s;
+
+    fp = fopen(filename, "rb");
+    if(fp == NULL) return SP_NOT_OK;
+    if(ftfile_read_header(fp, &info) != SP_OK) {
+        fclose(fp);
+        return SP_NOT_OK;
+    }
+    fclose(fp);
+
+    size = info.data_bytes / (info.bits / 8);
+    if(size == 0) return SP_NOT_OK;
+
+    s = malloc(sizeof(sp_ftbl_stream));
+    if(s == NULL) return SP_NOT_OK;
+    s->path = malloc(strlen(filename) + 1);
+    if(s->path == NULL) {
+        free(s);
+        return SP_NOT_OK;
+    }
+    strcpy(s->path, filename);
+    if(sp_ftbl_create(sp, &s->ft, size) != SP_OK) {
+        free(s->path);
+        free(s);
+        return SP_NOT_OK;
+    }
+    s->info = info;
+    s->loaded = 0;
+    s->done = 0;
+    s->error = 0;
+    pthread_mutex_init(&s->lock, NULL);
+    if(pthread_create(&s->thread, NULL, ftfile_stream_thread, s) != 0) {
+        sp_ftbl_destroy(&s->ft);
+        pthread_mutex_destroy(&s->lock);
+        free(s->path);
+        free(s);
+        return SP_NOT_OK;
+    }
+    *stream = s;
+    return SP_OK;
+}
+
+sp_ftbl * sp_ftbl_stream_ftbl(sp_ftbl_stream *stream)
+{
+    return stream->ft;
+}
+
+/* Samples decoded so far. */
+size_t sp_ftbl_stream_loaded(sp_ftbl_stream *stream)
+{
+    size_t loaded;
+    pthread_mutex_lock(&stream->lock);
+    loaded = stream->loaded;
+    pthread_mutex_unlock(&stream->lock);
+    return loaded;
+}
+
+/* 1 when the decode thread has finished (check sp_ftbl_stream_error). */
+int sp_ftbl_stream_done(sp_ftbl_stream *stream)
+{
+    int done;
+    pthread_mutex_lock(&stream->lock);
+    done = stream->done;
+    pthread_mutex_unlock(&stream->lock);
+    return done;
+}
+
+int sp_ftbl_stream_error(sp_ftbl_stream *stream)
+{
+    int error;
+    pthread_mutex_lock(&stream->lock);
+    error = stream->error;
+    pthread_mutex_unlock(&stream->lock);
+    return error;
+}
+
+/* Joins the decode thread and frees the table. */
+int sp_ftbl_stream_destroy(sp_ftbl_stream **stream)
+{
+    sp_ftbl_stream *s = *stream;
+    pthread_join(s->thread, NULL);
+    sp_ftbl_destroy(&s->ft);
+    pthread_mutex_destroy(&s->lock);
+    free(s->path);
+    free(s);
+    *stream = NULL;
+    return SP_OK;
+}
@@ -83,3 +83,60 @@ int sp_hilbert_compute(sp_data *sp, sp_hilbert *p, SPFLOAT *in, SPFLOAT *out1, S
     *out2 = yn1;
     return SP_OK;
 }
+
+int sp_hilbert_compute_block(sp_data *sp, sp_hilbert *p,
+    SPFLOAT *in, SPFLOAT *out1, SPFLOAT *out2, int n)
+{
+    /* coefficients are constants after init and each cascade is a chain,
+     * so the sections run unrolled with their state held in registers and
+     * the two independent cascades interleaved as parallel lanes */
+    SPFLOAT c0 = p->coef[0], c1 = p->coef[1], c2 = p->coef[2];
+    SPFLOAT c3 = p->coef[3], c4 = p->coef[4], c5 = p->coef[5];
+    SPFLOAT c6 = p->coef[6], c7 = p->coef[7], c8 = p->coef[8];
+    SPFLOAT c9 = p->coef[9], c10 = p->coef[10], c11 = p->coef[11];
+    SPFLOAT x0 = p->xnm1[0], x1 = p->xnm1[1], x2 = p->xnm1[2];
+    SPFLOAT x3 = p->xnm1[3], x4 = p->xnm1[4], x5 = p->xnm1[5];
+    SPFLOAT x6 = p->xnm1[6], x7 = p->xnm1[7], x8 = p->xnm1[8];
+    SPFLOAT x9 = p->xnm1[9], x10 = p->xnm1[10], x11 = p->xnm1[11];
+    SPFLOAT y0 = p->ynm1[0], y1 = p->ynm1[1], y2 = p->ynm1[2];
+    SPFLOAT y3 = p->ynm1[3], y4 = p->ynm1[4], y5 = p->ynm1[5];
+    SPFLOAT y6 = p->ynm1[6], y7 = p->ynm1[7], y8 = p->ynm1[8];
+    SPFLOAT y9 = p->ynm1[9], y10 = p->ynm1[10], y11 = p->ynm1[11];
+    SPFLOAT s, t, yn;
+    int i;
+
+    for (i = 0; i < n; i++) {
+        s = t = in[i];
+
+        yn = c0 * (s - y0) + x0; x0 = s; y0 = yn; s = yn;
+        yn = c6 * (t - y6) + x6; x6 = t; y6 = yn; t = yn;
+
+        yn = c1 * (s - y1) + x1; x1 = s; y1 = yn; s = yn;
+        yn = c7 * (t - y7) + x7; x7 = t; y7 = yn; t = yn;
+
+        yn = c2 * (s - y2) + x2; x2 = s; y2 = yn; s = yn;
+        yn = c8 * (t - y8) + x8; x8 = t; y8 = yn; t = yn;
+
+        yn = c3 * (s - y3) + x3; x3 = s; y3 = yn; s = yn;
+        yn = c9 * (t - y9) + x9; x9 = t; y9 = yn; t = yn;
+
+        yn = c4 * (s - y4) + x4; x4 = s; y4 = yn; s = yn;
+        yn = c10 * (t - y10) + x10; x10 = t; y10 = yn; t = yn;
+
+        yn = c5 * (s - y5) + x5; x5 = s; y5 = yn; s = yn;
+        yn = c11 * (t - y11) + x11; x11 = t; y11 = yn; t = yn;
+
+        out1[i] = t;
+        out2[i] = s;
+    }
+
+    p->xnm1[0] = x0; p->xnm1[1] = x1; p->xnm1[2] = x2;
+    p->xnm1[3] = x3; p->xnm1[4] = x4; p->xnm1[5] = x5;
+    p->xnm1[6] = x6; p->xnm1[7] = x7; p->xnm1[8] = x8;
+    p->xnm1[9] = x9; p->xnm1[10] = x10; p->xnm1[11] = x11;
+    p->ynm1[0] = y0; p->ynm1[1] = y1; p->ynm1[2] = y2;
+    p->ynm1[3] = y3; p->ynm1[4] = y4; p->ynm1[5] = y5;
+    p->ynm1[6] = y6; p->ynm1[7] = y7; p->ynm1[8] = y8;
+    p->ynm1[9] = y9; p->ynm1[10] = y10; p->ynm1[11] = y11;
+    return SP_OK;
+}
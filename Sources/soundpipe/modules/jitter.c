@@ -77,3 +77,46 @@ int sp_jitter_compute(sp_data *sp, sp_jitter *p, SPFLOAT *in, SPFLOAT *out)
     }
     return SP_OK;
 }
+
+/* Evaluates the jitter segment once per block: the output is the
+ * interpolated value at the current phase, and the phase then advances
+ * n samples, re-randomizing the segment targets on each wrap exactly
+ * as the per-sample path does. */
+int sp_jitter_compute_kr(sp_data *sp, sp_jitter *p, SPFLOAT *in, SPFLOAT *out, int n)
+{
+    int32_t remaining = n;
+
+    if (p->initflag) {
+        p->initflag = 0;
+        *out = p->num2 * p->amp;
+        p->cps = sp_jitter_randgab(sp) * (p->cpsMax - p->cpsMin) + p->cpsMin;
+        p->phs &= SP_FT_PHMASK;
+        p->num1 = p->num2;
+        p->num2 = sp_jitter_birandgab(sp);
+        p->dfdmax = 1.0 * (p->num2 - p->num1) / SP_FT_MAXLEN;
+        remaining--;
+    } else {
+        *out = (p->num1 + (SPFLOAT)p->phs * p->dfdmax) * p->amp;
+    }
+
+    while (remaining > 0) {
+        int32_t step = (int32_t)(p->cps * (SPFLOAT)(SP_FT_MAXLEN / sp->sr));
+        int32_t until;
+        if (step <= 0) break;
+        /* samples until the phase next wraps */
+        until = (SP_FT_MAXLEN - p->phs + step - 1) / step;
+        if (until > remaining) {
+            p->phs += remaining * step;
+            remaining = 0;
+        } else {
+            p->phs += until * step;
+            remaining -= until;
+            p->cps = sp_jitter_randgab(sp) * (p->cpsMax - p->cpsMin) + p->cpsMin;
+            p->phs &= SP_FT_PHMASK;
+            p->num1 = p->num2;
+            p->num2 = sp_jitter_birandgab(sp);
+            p->dfdmax = 1.0 * (p->num2 - p->num1) / SP_FT_MAXLEN;
+        }
+    }
+    return SP_OK;
+}
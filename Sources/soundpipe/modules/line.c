@@ -55,3 +55,31 @@ int sp_line_compute(sp_data *sp, sp_line *p, SPFLOAT *in, SPFLOAT *out)
 
     return SP_OK;
 }
+
+/* Evaluates the line once per block: the output is the value at the
+ * block start and the segment then advances n samples. A nonzero *in
+ * retriggers at the start of the block. */
+int sp_line_compute_kr(sp_data *sp, sp_line *p, SPFLOAT *in, SPFLOAT *out, int n)
+{
+    if(*in != 0 ) {
+        line_reinit(sp, p);
+        p->init = 0;
+    }
+
+    if(p->init) {
+        *out = 0;
+        return SP_OK;
+    }
+
+    if(p->stime < p->sdur) {
+        uint32_t rem = p->sdur - p->stime;
+        uint32_t adv = (uint32_t)n < rem ? (uint32_t)n : rem;
+        *out = p->val;
+        p->val += p->incr * adv;
+        p->stime += adv;
+    } else {
+        *out = p->b;
+    }
+
+    return SP_OK;
+}
@@ -10,6 +10,7 @@
  *
  */
 
+#include <math.h>
 #include <stdlib.h>
 #include "soundpipe.h"
 
@@ -55,3 +56,46 @@ int sp_metro_compute(sp_data *sp, sp_metro *p, SPFLOAT *in, SPFLOAT *out)
     p->curphs = phs;
     return SP_OK;
 }
+
+/* Evaluates n samples of the metronome in one call. *out is 1 when a
+ * tick falls inside the block and *offset receives the sample offset
+ * of the first tick (-1 when none fires), so a block-rate caller can
+ * still place events sample-accurately. The phase advances over the
+ * whole block in closed form (in double), which keeps the tick grid
+ * exactly periodic where the per-sample path slowly drifts from
+ * accumulated float rounding. */
+int sp_metro_compute_kr(sp_data *sp, sp_metro *p, SPFLOAT *in, SPFLOAT *out,
+    int n, int *offset)
+{
+    SPFLOAT inc = p->freq * p->onedsr;
+    SPFLOAT phs = p->curphs;
+    int first = -1;
+    int m = n;
+
+    if (phs == 0.0 && p->flag) {
+        /* the initial tick's sample does not advance the phase */
+        first = 0;
+        p->flag = 0;
+        m = n - 1;
+    }
+
+    if (inc > 0 && m > 0) {
+        double end = (double)phs + (double)m * inc;
+        if (end >= 1.0) {
+            if (first < 0) {
+                int k = (int)ceil((1.0 - (double)phs) / inc);
+                if (k < 1) k = 1;
+                if (k > m) k = m;
+                first = (n - m) + (k - 1);
+            }
+            p->flag = 0;
+            end -= (double)((int)end);
+        }
+        phs = (SPFLOAT)end;
+    }
+
+    p->curphs = phs;
+    *offset = first;
+    *out = (first >= 0) ? 1.0 : 0.0;
+    return SP_OK;
+}
@@ -12,6 +12,7 @@
 
 #include <math.h>
 #include <stdlib.h>
+#include <string.h>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -100,18 +101,70 @@ int sp_mincer_init(sp_data *sp, sp_mincer *p, sp_ftbl *ft, int winsize)
 
     p->N = N;
     p->decim = decim;
+    p->cache = NULL;
 
     return SP_OK;
 }
 
-int sp_mincer_compute(sp_data *sp, sp_mincer *p, SPFLOAT *in2, SPFLOAT *out)
+/* Computes one windowed analysis frame of the table at an integer
+ * read position: N windowed samples, real FFT, Nyquist bin re-ordered
+ * from pos 1 to N.  This is the hop analysis for the pitch == 1 case,
+ * where the interpolation fraction is always zero, and it is what the
+ * shared cache memoizes. */
+static void mincer_frame(sp_mincer *p, SPFLOAT *tab, int size,
+        long spos, SPFLOAT *dest)
+{
+    int i, post;
+    int N = p->N;
+    SPFLOAT *win = (SPFLOAT *) p->win.ptr;
+    long pos = spos;
+
+    for(i = 0; i < N; i++) {
+        post = (int) pos;
+        while(post < 0) post += size;
+        while(post >= size) post -= size;
+        dest[i] = tab[post] * win[i];
+        pos++;
+    }
+    sp_fftr(&p->fft, dest, N);
+    dest[N] = dest[1];
+    dest[N+1] = 0.0;
+}
+
+/* Returns the cached spectral frame at spos, computing and memoizing
+ * it on a miss.  The cache is direct-mapped on the read position; a
+ * table swap (regenerated ftbl) flushes it. */
+static SPFLOAT * mincer_cache_frame(sp_mincer *p, sp_ftbl *ft, long spos)
+{
+    sp_mincer_cache *c = p->cache;
+    uint32_t slot;
+    SPFLOAT *spec;
+
+    if(c->tbl != ft->tbl) {
+        uint32_t n;
+        for(n = 0; n < c->nslots; n++) c->pos[n] = -1;
+        c->tbl = ft->tbl;
+    }
+
+    slot = (uint32_t)(spos % (long)c->nslots);
+    spec = c->spec + (size_t)slot * (c->N + 2);
+    if(c->pos[slot] != spos) {
+        mincer_frame(p, ft->tbl, (int)ft->size, spos, spec);
+        c->pos[slot] = spos;
+    }
+    return spec;
+}
+
+/* One hop of analysis and phase-vocoder processing: fills the next
+ * overlap-add output frame and resets the hop counter. */
+static void mincer_analyze(sp_data *sp, sp_mincer *p)
 {
-    SPFLOAT pitch = p->pitch, time = p->time, lock = p->lock, amp =p->amp;
+    SPFLOAT pitch = p->pitch, time = p->time, lock = p->lock;
     SPFLOAT *tab, frac;
     sp_ftbl *ft = p->ft;
-    int N = p->N, hsize = p->hsize, cnt = p->cnt;
+    int N = p->N, hsize = p->hsize;
     int sizefrs, size, post, i;
-    long spos = p->pos;
+    long spos;
     SPFLOAT pos;
     SPFLOAT *fwin, *bwin, insig = 0,
     *prev, *win = (SPFLOAT *) p->win.ptr;
@@ -119,28 +172,39 @@ int sp_mincer_compute(sp_data *sp, sp_mincer *p, SPFLOAT *in2, SPFLOAT *out)
     SPFLOAT ph_real, ph_im, tmp_real, tmp_im, divi;
     int *framecnt;
     int curframe = p->curframe, decim = p->decim;
-    SPFLOAT scaling = (8./decim)/3.;
-
-    if (cnt == hsize) {
-        tab = ft->tbl;
-        size = (int)ft->size;
 
-        /* spos is the reading position in samples, hsize is hopsize,
-        time[n] is current read position in secs
-        esr is sampling rate
-        */
-        spos  = hsize*(long)((time)*sp->sr/hsize);
-        sizefrs = size;
-        while(spos > sizefrs) spos -= sizefrs;
-        while(spos <= 0)  spos += sizefrs;
-
-
-        pos = spos;
-        bwin = (SPFLOAT *) p->bwin.ptr;
-        fwin = (SPFLOAT *) p->fwin.ptr;
-        prev = (SPFLOAT *)p->prev.ptr;
-        framecnt  = (int *)p->framecount.ptr;
-        outframe= (SPFLOAT *) p->outframe.ptr;
+    tab = ft->tbl;
+    size = (int)ft->size;
+
+    /* spos is the reading position in samples, hsize is hopsize,
+    time[n] is current read position in secs
+    esr is sampling rate
+    */
+    spos  = hsize*(long)((time)*sp->sr/hsize);
+    sizefrs = size;
+    while(spos > sizefrs) spos -= sizefrs;
+    while(spos <= 0)  spos += sizefrs;
+
+    pos = spos;
+    bwin = (SPFLOAT *) p->bwin.ptr;
+    fwin = (SPFLOAT *) p->fwin.ptr;
+    prev = (SPFLOAT *)p->prev.ptr;
+    framecnt  = (int *)p->framecount.ptr;
+    outframe= (SPFLOAT *) p->outframe.ptr;
+
+    if(p->cache != NULL && pitch == 1 &&
+            p->cache->N == N && p->cache->ft == ft) {
+        /* unity pitch reads whole samples, so both windows are plain
+         * frames of the table: the front one at spos and the back one
+         * a hop earlier.  Fetch them from the shared cache; other
+         * instances stretching the same table reuse them. */
+        long bpos = spos - hsize;
+        while(bpos <= 0) bpos += size;
+        memcpy(fwin, mincer_cache_frame(p, ft, spos),
+               sizeof(SPFLOAT) * (N + 2));
+        memcpy(bwin, mincer_cache_frame(p, ft, bpos),
+               sizeof(SPFLOAT) * (N + 2));
+    } else {
         /* this loop fills two frames/windows with samples from table,
         reading is linearly-interpolated,
         frames are separated by 1 hopsize
@@ -180,71 +244,84 @@ int sp_mincer_compute(sp_data *sp, sp_mincer *p, SPFLOAT *in2, SPFLOAT *out)
         sp_fftr(&p->fft, fwin, N);
         fwin[N] = fwin[1];
         fwin[N+1] = 0.0;
+    }
 
-        /* phase vocoder processing */
-
-        for (i=0; i < N + 2; i+=2) {
-            /* phases of previous output frame in exponential format,
-            obtained by dividing by magnitude */
-            divi =  1.0/(hypot(prev[i], prev[i+1]) + 1e-20);
-            ph_real  =    prev[i]*divi;
-            ph_im =       prev[i+1]*divi;
-
-            /* back window magnitudes, phase differences between
-            prev and back windows */
-            tmp_real =   bwin[i] * ph_real + bwin[i+1] * ph_im;
-            tmp_im =   bwin[i] * ph_im - bwin[i+1] * ph_real;
-            bwin[i] = tmp_real;
-            bwin[i+1] = tmp_im;
-        }
+    /* phase vocoder processing */
+
+    for (i=0; i < N + 2; i+=2) {
+        /* phases of previous output frame in exponential format,
+        obtained by dividing by magnitude */
+        divi =  1.0/(hypot(prev[i], prev[i+1]) + 1e-20);
+        ph_real  =    prev[i]*divi;
+        ph_im =       prev[i+1]*divi;
+
+        /* back window magnitudes, phase differences between
+        prev and back windows */
+        tmp_real =   bwin[i] * ph_real + bwin[i+1] * ph_im;
+        tmp_im =   bwin[i] * ph_im - bwin[i+1] * ph_real;
+        bwin[i] = tmp_real;
+        bwin[i+1] = tmp_im;
+    }
 
-        for (i=0; i < N + 2; i+=2) {
-            if (lock) {  /* phase-locking */
-                if (i > 0) {
-                    if (i < N){
-                        tmp_real = bwin[i] + bwin[i-2] + bwin[i+2];
-                        tmp_im = bwin[i+1] + bwin[i-1] + bwin[i+3];
-                    } else { /* Nyquist */
-                        tmp_real = bwin[i] + bwin[i-2];
-                        tmp_im = 0.0;
-                    }
-                } else { /* 0 Hz */
-                    tmp_real = bwin[i] + bwin[i+2];
+    for (i=0; i < N + 2; i+=2) {
+        if (lock) {  /* phase-locking */
+            if (i > 0) {
+                if (i < N){
+                    tmp_real = bwin[i] + bwin[i-2] + bwin[i+2];
+                    tmp_im = bwin[i+1] + bwin[i-1] + bwin[i+3];
+                } else { /* Nyquist */
+                    tmp_real = bwin[i] + bwin[i-2];
                     tmp_im = 0.0;
                 }
-            } else { /* no locking */
-                tmp_real = bwin[i];
-                tmp_im = bwin[i+1];
+            } else { /* 0 Hz */
+                tmp_real = bwin[i] + bwin[i+2];
+                tmp_im = 0.0;
             }
+        } else { /* no locking */
+            tmp_real = bwin[i];
+            tmp_im = bwin[i+1];
+        }
 
-            tmp_real += 1e-15;
-            divi =  1.0/(hypot(tmp_real, tmp_im));
+        tmp_real += 1e-15;
+        divi =  1.0/(hypot(tmp_real, tmp_im));
 
-            /* phases of tmp frame */
-            ph_real = tmp_real*divi;
-            ph_im = tmp_im*divi;
+        /* phases of tmp frame */
+        ph_real = tmp_real*divi;
+        ph_im = tmp_im*divi;
 
-            /* front window mags, phase sum of
-            tmp and front windows */
-            tmp_real =   fwin[i] * ph_real - fwin[i+1] * ph_im;
-            tmp_im =   fwin[i] * ph_im + fwin[i+1] * ph_real;
+        /* front window mags, phase sum of
+        tmp and front windows */
+        tmp_real =   fwin[i] * ph_real - fwin[i+1] * ph_im;
+        tmp_im =   fwin[i] * ph_im + fwin[i+1] * ph_real;
 
-            /* phase vocoder output */
-            prev[i] = fwin[i] = tmp_real;
-            prev[i+1] = fwin[i+1] = tmp_im;
-        }
-        /* re-order bins and take inverse FFT */
-        fwin[1] = fwin[N];
-        sp_ifftr(&p->fft, fwin, N);
-        /* frame counter */
-        framecnt[curframe] = curframe*N;
-        /* write to overlapped output frames */
-        for (i=0;i<N;i++) outframe[framecnt[curframe]+i] = win[i]*fwin[i];
-
-        cnt=0;
-        curframe++;
-        if (curframe == decim) curframe = 0;
+        /* phase vocoder output */
+        prev[i] = fwin[i] = tmp_real;
+        prev[i+1] = fwin[i+1] = tmp_im;
     }
+    /* re-order bins and take inverse FFT */
+    fwin[1] = fwin[N];
+    sp_ifftr(&p->fft, fwin, N);
+    /* frame counter */
+    framecnt[curframe] = curframe*N;
+    /* write to overlapped output frames */
+    for (i=0;i<N;i++) outframe[framecnt[curframe]+i] = win[i]*fwin[i];
+
+    curframe++;
+    if (curframe == decim) curframe = 0;
+
+    p->cnt = 0;
+    p->curframe = curframe;
+}
+
+int sp_mincer_compute(sp_data *sp, sp_mincer *p, SPFLOAT *in2, SPFLOAT *out)
+{
+    int i;
+    int decim = p->decim;
+    SPFLOAT scaling = (8./decim)/3.;
+    SPFLOAT *outframe;
+    int *framecnt;
+
+    if (p->cnt == p->hsize) mincer_analyze(sp, p);
 
     framecnt  = (int *) p->framecount.ptr;
     outframe  = (SPFLOAT *) p->outframe.ptr;
@@ -255,11 +332,94 @@ int sp_mincer_compute(sp_data *sp, sp_mincer *p, SPFLOAT *in2, SPFLOAT *out)
         framecnt[i]++;
     }
     /* scale output */
-    *out *= amp*scaling;
-    cnt++;
+    *out *= p->amp*scaling;
+    p->cnt++;
 
-    p->cnt = cnt;
-    p->curframe = curframe;
+    return SP_OK;
+}
+
+/* Renders a whole quantum in one call.  Between hops the overlap-add
+ * reduces to summing decim contiguous runs of the output frames, so
+ * the per-sample counter updates hoist out of the inner loop.  time
+ * holds the per-sample read positions in seconds, as p->time would. */
+int sp_mincer_compute_block(sp_data *sp, sp_mincer *p, SPFLOAT *time,
+        SPFLOAT *out, int nframes)
+{
+    int i, k, run;
+    int j = 0;
+    int decim = p->decim;
+    SPFLOAT scaling = (8./decim)/3.;
+    SPFLOAT amp = p->amp;
+    SPFLOAT *outframe = (SPFLOAT *) p->outframe.ptr;
+    int *framecnt = (int *) p->framecount.ptr;
+
+    while(j < nframes) {
+        if(p->cnt == p->hsize) {
+            p->time = time[j];
+            mincer_analyze(sp, p);
+        }
+        run = p->hsize - p->cnt;
+        if(run > nframes - j) run = nframes - j;
+
+        for(k = 0; k < run; k++) out[j + k] = 0;
+        for(i = 0; i < decim; i++) {
+            SPFLOAT *frame = &outframe[framecnt[i]];
+            for(k = 0; k < run; k++) out[j + k] += frame[k];
+            framecnt[i] += run;
+        }
+        for(k = 0; k < run; k++) out[j + k] *= amp*scaling;
+
+        p->cnt += run;
+        j += run;
+    }
 
     return SP_OK;
 }
+
+int sp_mincer_cache_create(sp_mincer_cache **c)
+{
+    *c = malloc(sizeof(sp_mincer_cache));
+    return SP_OK;
+}
+
+int sp_mincer_cache_init(sp_data *sp, sp_mincer_cache *c, sp_ftbl *ft,
+        int winsize)
+{
+    uint32_t n;
+    int hsize = winsize/4;
+
+    c->ft = ft;
+    c->tbl = ft->tbl;
+    c->N = winsize;
+    /* roughly two slots per hop position in the table */
+    c->nslots = (uint32_t)(ft->size / hsize) * 2 + 1;
+    c->pos = malloc(sizeof(long) * c->nslots);
+    c->spec = malloc(sizeof(SPFLOAT) * c->nslots * (winsize + 2));
+    if(c->pos == NULL || c->spec == NULL) {
+        free(c->pos);
+        free(c->spec);
+        c->pos = NULL;
+        c->spec = NULL;
+        c->nslots = 0;
+        return SP_NOT_OK;
+    }
+    for(n = 0; n < c->nslots; n++) c->pos[n] = -1;
+    return SP_OK;
+}
+
+/* Attach a shared analysis cache; instances sharing one must render
+ * on the same thread.  Pass NULL to detach. */
+int sp_mincer_set_cache(sp_mincer *p, sp_mincer_cache *c)
+{
+    p->cache = c;
+    return SP_OK;
+}
+
+int sp_mincer_cache_destroy(sp_mincer_cache **c)
+{
+    sp_mincer_cache *cp = *c;
+    free(cp->pos);
+    free(cp->spec);
+    free(*c);
+    return SP_OK;
+}
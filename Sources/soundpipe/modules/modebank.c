@@ -0,0 +1,126 @@
+/*
+ * Modebank
+ *
+ * A bank of parallel modal resonators sharing one state pass. The
+ * per-mode filter is the same two-pole resonator as sp_mode, but the
+ * coefficients and state are laid out as flat per-mode arrays so that
+ * the inner loop over modes is branch-free and vectorizable. One bank
+ * replaces a chain of sp_mode nodes for modal synthesis.
+ *
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef M_PI
+#define M_PI		3.14159265358979323846	/* pi */
+#endif
+
+#include "soundpipe.h"
+
+int sp_modebank_create(sp_modebank **p)
+{
+    *p = malloc(sizeof(sp_modebank));
+    return SP_OK;
+}
+
+int sp_modebank_destroy(sp_modebank **p)
+{
+    sp_auxdata_free(&(*p)->aux);
+    free(*p);
+    return SP_OK;
+}
+
+int sp_modebank_init(sp_data *sp, sp_modebank *p, int nmodes)
+{
+    int m;
+
+    if(nmodes < 1) nmodes = 1;
+    p->nmodes = nmodes;
+
+    /* eleven per-mode arrays carved out of one allocation */
+    sp_auxdata_alloc(&p->aux, sizeof(SPFLOAT) * nmodes * 11);
+    p->freq  = (SPFLOAT *)p->aux.ptr;
+    p->q     = p->freq  + nmodes;
+    p->gain  = p->q     + nmodes;
+    p->lfreq = p->gain  + nmodes;
+    p->lq    = p->lfreq + nmodes;
+    p->a0    = p->lq    + nmodes;
+    p->a1    = p->a0    + nmodes;
+    p->a2    = p->a1    + nmodes;
+    p->d     = p->a2    + nmodes;
+    p->ynm1  = p->d     + nmodes;
+    p->ynm2  = p->ynm1  + nmodes;
+
+    for(m = 0; m < nmodes; m++) {
+        p->freq[m] = 500.0;
+        p->q[m] = 50;
+        p->gain[m] = 1.0;
+        p->lfreq[m] = -1.0;
+        p->lq[m] = -1.0;
+        p->a0[m] = p->a1[m] = p->a2[m] = p->d[m] = 0.0;
+        p->ynm1[m] = p->ynm2[m] = 0.0;
+    }
+
+    p->xnm1 = 0.0;
+    p->sr = sp->sr;
+
+    return SP_OK;
+}
+
+/* re-derive coefficients for any mode whose freq or q changed */
+static void modebank_update(sp_modebank *p)
+{
+    int m;
+    for(m = 0; m < p->nmodes; m++) {
+        SPFLOAT kfq = p->freq[m];
+        SPFLOAT kq  = p->q[m];
+        if(p->lfreq[m] != kfq || p->lq[m] != kq) {
+            SPFLOAT kfreq = kfq*(2.0 * M_PI);
+            SPFLOAT kalpha = (p->sr/kfreq);
+            SPFLOAT kbeta = kalpha*kalpha;
+            SPFLOAT d = 0.5*kalpha;
+
+            p->lfreq[m] = kfq;
+            p->lq[m] = kq;
+            p->a0[m] = 1.0/ (kbeta+d/kq);
+            p->a1[m] = p->a0[m] * (1.0-2.0*kbeta);
+            p->a2[m] = p->a0[m] * (kbeta-d/kq);
+            p->d[m] = d;
+        }
+    }
+}
+
+int sp_modebank_compute(sp_data *sp, sp_modebank *p, SPFLOAT *in, SPFLOAT *out)
+{
+    return sp_modebank_compute_block(sp, p, in, out, 1);
+}
+
+int sp_modebank_compute_block(sp_data *sp, sp_modebank *p, SPFLOAT *in, SPFLOAT *out, int n)
+{
+    const SPFLOAT *a0 = p->a0, *a1 = p->a1, *a2 = p->a2;
+    const SPFLOAT *d = p->d, *gain = p->gain;
+    SPFLOAT *ynm1 = p->ynm1, *ynm2 = p->ynm2;
+    SPFLOAT xnm1 = p->xnm1;
+    int nmodes = p->nmodes;
+    int i, m;
+
+    modebank_update(p);
+
+    for(i = 0; i < n; i++) {
+        SPFLOAT sum = 0.0;
+        /* the modes are independent, so this inner loop vectorizes */
+        for(m = 0; m < nmodes; m++) {
+            SPFLOAT yn = a0[m]*xnm1 - a1[m]*ynm1[m] - a2[m]*ynm2[m];
+            ynm2[m] = ynm1[m];
+            ynm1[m] = yn;
+            sum += yn*d[m]*gain[m];
+        }
+        xnm1 = in[i];
+        out[i] = sum;
+    }
+
+    p->xnm1 = xnm1;
+    return SP_OK;
+}
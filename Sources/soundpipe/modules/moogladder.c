@@ -122,3 +122,145 @@ int sp_moogladder_compute(sp_data *sp, sp_moogladder *p, SPFLOAT *in, SPFLOAT *o
     *out = (SPFLOAT) delay[5];
     return SP_OK;
 }
+
+int sp_moogladder_compute_block(sp_data *sp, sp_moogladder *p, SPFLOAT *in, SPFLOAT *out, int n)
+{
+    SPFLOAT freq = p->freq;
+    SPFLOAT res = p->res;
+    SPFLOAT res4;
+    SPFLOAT *delay = p->delay;
+    SPFLOAT *tanhstg = p->tanhstg;
+    SPFLOAT stg[4], input;
+    SPFLOAT acr, tune;
+    int     i, j, k;
+
+    if (res < 0) res = 0;
+
+    /* tuning is recomputed at most once per block instead of per sample */
+    if (p->oldfreq != freq || p->oldres != res) {
+        SPFLOAT f, fc, fc2, fc3, fcr;
+        p->oldfreq = freq;
+        /* sr is half the actual filter sampling rate  */
+        fc =  (SPFLOAT)(freq/sp->sr);
+        f  =  0.5*fc;
+        fc2 = fc*fc;
+        fc3 = fc2*fc;
+        /* frequency & amplitude correction  */
+        fcr = 1.8730*fc3 + 0.4955*fc2 - 0.6490*fc + 0.9988;
+        acr = -3.9364*fc2 + 1.8409*fc + 0.9968;
+        tune = (1.0 - exp(-((2 * M_PI)*f*fcr))) / THERMAL;   /* filter tuning  */
+        p->oldres = res;
+        p->oldacr = acr;
+        p->oldtune = tune;
+    } else {
+        res = p->oldres;
+        acr = p->oldacr;
+        tune = p->oldtune;
+    }
+    res4 = 4.0*(SPFLOAT)res*acr;
+
+    for (i = 0; i < n; i++) {
+        /* oversampling  */
+        for (j = 0; j < 2; j++) {
+            /* filter stages  */
+            input = in[i] - res4*delay[5];
+            delay[0] = stg[0] = delay[0] + tune*(my_tanh(input*THERMAL) - tanhstg[0]);
+            for (k = 1; k < 4; k++) {
+              input = stg[k-1];
+              stg[k] = delay[k]
+                + tune*((tanhstg[k-1] = my_tanh(input*THERMAL))
+                        - (k != 3 ? tanhstg[k] : my_tanh(delay[k]*THERMAL)));
+              delay[k] = stg[k];
+            }
+            /* 1/2-sample delay for phase compensation  */
+            delay[5] = (stg[3] + delay[4])*0.5;
+            delay[4] = stg[3];
+        }
+        out[i] = (SPFLOAT) delay[5];
+    }
+    return SP_OK;
+}
+
+/* True-stereo variant: both state lanes are tuned from the left instance's
+ * parameters, so identical channel settings cost one coefficient update per
+ * block instead of two, and the two lanes advance together through the same
+ * sample loop. */
+int sp_moogladder_compute_block_stereo(sp_data *sp, sp_moogladder *left, sp_moogladder *right,
+    SPFLOAT *inl, SPFLOAT *inr, SPFLOAT *outl, SPFLOAT *outr, int n)
+{
+    SPFLOAT freq = left->freq;
+    SPFLOAT res = left->res;
+    SPFLOAT res4;
+    SPFLOAT *delayl = left->delay;
+    SPFLOAT *delayr = right->delay;
+    SPFLOAT *tanhstgl = left->tanhstg;
+    SPFLOAT *tanhstgr = right->tanhstg;
+    SPFLOAT stgl[4], stgr[4], input;
+    SPFLOAT acr, tune;
+    int     i, j, k;
+
+    if (res < 0) res = 0;
+
+    if (left->oldfreq != freq || left->oldres != res) {
+        SPFLOAT f, fc, fc2, fc3, fcr;
+        left->oldfreq = freq;
+        /* sr is half the actual filter sampling rate  */
+        fc =  (SPFLOAT)(freq/sp->sr);
+        f  =  0.5*fc;
+        fc2 = fc*fc;
+        fc3 = fc2*fc;
+        /* frequency & amplitude correction  */
+        fcr = 1.8730*fc3 + 0.4955*fc2 - 0.6490*fc + 0.9988;
+        acr = -3.9364*fc2 + 1.8409*fc + 0.9968;
+        tune = (1.0 - exp(-((2 * M_PI)*f*fcr))) / THERMAL;   /* filter tuning  */
+        left->oldres = res;
+        left->oldacr = acr;
+        left->oldtune = tune;
+    } else {
+        res = left->oldres;
+        acr = left->oldacr;
+        tune = left->oldtune;
+    }
+    /* mirror the cache so a later mono compute on the right lane skips the
+       tuning computation as well */
+    right->oldfreq = left->oldfreq;
+    right->oldres = res;
+    right->oldacr = acr;
+    right->oldtune = tune;
+    res4 = 4.0*(SPFLOAT)res*acr;
+
+    for (i = 0; i < n; i++) {
+        /* oversampling  */
+        for (j = 0; j < 2; j++) {
+            /* filter stages, left lane  */
+            input = inl[i] - res4*delayl[5];
+            delayl[0] = stgl[0] = delayl[0] + tune*(my_tanh(input*THERMAL) - tanhstgl[0]);
+            for (k = 1; k < 4; k++) {
+              input = stgl[k-1];
+              stgl[k] = delayl[k]
+                + tune*((tanhstgl[k-1] = my_tanh(input*THERMAL))
+                        - (k != 3 ? tanhstgl[k] : my_tanh(delayl[k]*THERMAL)));
+              delayl[k] = stgl[k];
+            }
+            /* 1/2-sample delay for phase compensation  */
+            delayl[5] = (stgl[3] + delayl[4])*0.5;
+            delayl[4] = stgl[3];
+
+            /* filter stages, right lane  */
+            input = inr[i] - res4*delayr[5];
+            delayr[0] = stgr[0] = delayr[0] + tune*(my_tanh(input*THERMAL) - tanhstgr[0]);
+            for (k = 1; k < 4; k++) {
+              input = stgr[k-1];
+              stgr[k] = delayr[k]
+                + tune*((tanhstgr[k-1] = my_tanh(input*THERMAL))
+                        - (k != 3 ? tanhstgr[k] : my_tanh(delayr[k]*THERMAL)));
+              delayr[k] = stgr[k];
+            }
+            delayr[5] = (stgr[3] + delayr[4])*0.5;
+            delayr[4] = stgr[3];
+        }
+        outl[i] = (SPFLOAT) delayl[5];
+        outr[i] = (SPFLOAT) delayr[5];
+    }
+    return SP_OK;
+}
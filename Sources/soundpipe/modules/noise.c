@@ -27,3 +27,24 @@ int sp_noise_destroy(sp_noise **ns)
     free(*ns);
     return SP_OK;
 }
+
+/* Fills a whole block with the generator state held in locals, so the
+ * DSP layer makes one call per render quantum instead of one per
+ * sample. Same sequence as sp_noise_compute. */
+int sp_noise_compute_block(sp_data *sp, sp_noise *ns, SPFLOAT *in, SPFLOAT *out, int n)
+{
+    uint32_t rnd = sp->rand;
+    SPFLOAT amp = ns->amp;
+    int i;
+
+    for (i = 0; i < n; i++) {
+        SPFLOAT v;
+        rnd = (1103515245 * rnd + 12345) % SP_RANDMAX;
+        v = ((rnd % SP_RANDMAX) / (SP_RANDMAX * 1.0));
+        v = (v * 2) - 1;
+        out[i] = v * amp;
+    }
+
+    sp->rand = rnd;
+    return SP_OK;
+}
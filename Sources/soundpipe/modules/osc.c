@@ -68,3 +68,31 @@ int sp_osc_compute(sp_data *sp, sp_osc *osc, SPFLOAT *in, SPFLOAT *out)
     osc->lphs = phs;
     return SP_OK;
 }
+
+int sp_osc_compute_block(sp_data *sp, sp_osc *osc, SPFLOAT *in, SPFLOAT *out, int n)
+{
+    sp_ftbl *ftp = osc->tbl;
+    SPFLOAT amp = osc->amp;
+    SPFLOAT lodiv = ftp->lodiv;
+    SPFLOAT *ft = ftp->tbl;
+    int32_t lobits = ftp->lobits;
+    int32_t lomask = ftp->lomask;
+    int32_t phs = osc->lphs;
+    int32_t inc;
+    int i;
+
+    /* table parameters and phase stay in locals for the whole block */
+    osc->inc = inc = (int32_t)lrintf(osc->freq * ftp->sicvt);
+
+    for (i = 0; i < n; i++) {
+        SPFLOAT fract = (phs & lomask) * lodiv;
+        int32_t pos = phs >> lobits;
+        SPFLOAT v1 = ft[pos];
+        SPFLOAT v2 = ft[(pos + 1) % ftp->size];
+        out[i] = (v1 + (v2 - v1) * fract) * amp;
+        phs = (phs + inc) & SP_FT_PHMASK;
+    }
+
+    osc->lphs = phs;
+    return SP_OK;
+}
@@ -5,11 +5,16 @@
 int sp_oscmorph_create(sp_oscmorph **p)
 {
     *p = malloc(sizeof(sp_oscmorph));
+    (*p)->blend_aux.ptr = NULL;
+    (*p)->blend_aux.size = 0;
     return SP_OK;
 }
 
 int sp_oscmorph_destroy(sp_oscmorph **p)
 {
+    if((*p)->blend_aux.ptr != NULL) {
+        sp_auxdata_free(&(*p)->blend_aux);
+    }
     free(*p);
     return SP_OK;
 }
@@ -33,6 +38,11 @@ int sp_oscmorph_init(sp_data *sp, sp_oscmorph *osc, sp_ftbl **ft, int nft, SPFLO
         }
         prev = (uint32_t)ft[i]->size;
     }
+    if(osc->blend_aux.ptr == NULL) {
+        sp_auxdata_alloc(&osc->blend_aux, sizeof(SPFLOAT) * ft[0]->size);
+    }
+    osc->blend_wtpos = -1;
+    osc->blend_valid = 0;
     return SP_OK;
 }
 
@@ -88,3 +98,60 @@ int sp_oscmorph_compute(sp_data *sp, sp_oscmorph *osc, SPFLOAT *in, SPFLOAT *out
     osc->lphs = phs;
     return SP_OK;
 }
+
+int sp_oscmorph_compute_block(sp_data *sp, sp_oscmorph *osc, SPFLOAT *in, SPFLOAT *out, int n)
+{
+    sp_ftbl *ftp1;
+    SPFLOAT *ft;
+    SPFLOAT amp, lodiv, findex, wtfrac;
+    int32_t phs, inc, lobits, lomask, size;
+    int index, i;
+
+    /* Use only the fractional part of the position or 1 */
+    if (osc->wtpos > 1.0) {
+        osc->wtpos -= (int)osc->wtpos;
+    }
+    findex = osc->wtpos * (osc->nft - 1);
+    index = floor(findex);
+    wtfrac = findex - index;
+
+    ftp1 = osc->tbl[index];
+    size = (int32_t)ftp1->size;
+
+    if(wtfrac == 0 || index >= osc->nft - 1) {
+        /* morph sits exactly on one source table: read it directly */
+        ft = osc->tbl[index]->tbl;
+    } else {
+        /* the morph has settled between tables: blend the cycle once into
+         * the cached table, then run single-table lookups until it moves */
+        ft = (SPFLOAT *)osc->blend_aux.ptr;
+        if(!osc->blend_valid || osc->blend_wtpos != findex) {
+            SPFLOAT *ft1 = osc->tbl[index]->tbl;
+            SPFLOAT *ft2 = osc->tbl[index + 1]->tbl;
+            for(i = 0; i < size; i++) {
+                ft[i] = (1 - wtfrac) * ft1[i] + wtfrac * ft2[i];
+            }
+            osc->blend_wtpos = findex;
+            osc->blend_valid = 1;
+        }
+    }
+
+    lobits = ftp1->lobits;
+    lomask = ftp1->lomask;
+    lodiv = ftp1->lodiv;
+    amp = osc->amp;
+    phs = osc->lphs;
+    osc->inc = inc = (int32_t)lrintf(osc->freq * ftp1->sicvt);
+
+    for(i = 0; i < n; i++) {
+        SPFLOAT fract = (phs & lomask) * lodiv;
+        int32_t pos = phs >> lobits;
+        SPFLOAT v1 = ft[pos];
+        SPFLOAT v2 = ft[(pos + 1) % size];
+        out[i] = (v1 + (v2 - v1) * fract) * amp;
+        phs = (phs + inc) & SP_FT_PHMASK;
+    }
+
+    osc->lphs = phs;
+    return SP_OK;
+}
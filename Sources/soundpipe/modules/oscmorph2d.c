@@ -2,14 +2,25 @@
 #include <math.h>
 #include "soundpipe.h"
 
+/* Samples the morph position must rest before the blended cycle is cached. */
+#define OSCMORPH2D_REST_SAMPLES 32
+/* Cache entries rendered per sample while a build is in progress, so the
+ * cost of a cache rebuild is spread instead of spiking one sample. */
+#define OSCMORPH2D_BUILD_CHUNK 64
+
 int sp_oscmorph2d_create(sp_oscmorph2d **p)
 {
     *p = malloc(sizeof(sp_oscmorph2d));
+    (*p)->blend_aux.ptr = NULL;
+    (*p)->blend_aux.size = 0;
     return SP_OK;
 }
 
 int sp_oscmorph2d_destroy(sp_oscmorph2d **p)
 {
+    if((*p)->blend_aux.ptr != NULL) {
+        sp_auxdata_free(&(*p)->blend_aux);
+    }
     free(*p);
     return SP_OK;
 }
@@ -49,24 +60,29 @@ int sp_oscmorph2d_init(sp_data *sp, sp_oscmorph2d *osc, sp_ftbl **ft, int nft, i
     osc->enableBandlimit = 0;
     osc->bandlimitIndexOverride = -1;
 
+    if(osc->blend_aux.ptr == NULL) {
+        sp_auxdata_alloc(&osc->blend_aux, sizeof(SPFLOAT) * ft[0]->size);
+    }
+    osc->blend_findex = -1;
+    osc->blend_valid = 0;
+    osc->last_findex = -1;
+    osc->rest_count = 0;
+    osc->build_pos = -1;
+
     return SP_OK;
 }
 
-int sp_oscmorph2d_compute(sp_data *sp, sp_oscmorph2d *osc, SPFLOAT *in, SPFLOAT *out)
+/* Effective table index for the current bandlimit row and morph position.
+ * Both dimensions fold into one number, so one comparison detects any move. */
+static SPFLOAT oscmorph2d_findex(sp_oscmorph2d *osc)
 {
-    sp_ftbl *ftp1;
-    SPFLOAT amp, cps, fract, v1, v2;
-    SPFLOAT *ft1, *ft2;
-    int32_t phs, lobits, pos;
-    SPFLOAT sicvt = osc->tbl[0]->sicvt; /* sicvt: this stands for Sampling Increment ConVert */
-    const int enableBandlimit = osc->enableBandlimit;
-    int bandlimitIndexOverride = osc->bandlimitIndexOverride;
-
     int32_t bandlimitIndex = 0;
-    if (enableBandlimit > 0) {
-        if (bandlimitIndexOverride < 0) {
+    int i;
+
+    if (osc->enableBandlimit > 0) {
+        if (osc->bandlimitIndexOverride < 0) {
             /* do not use override */
-            for(int i = 1; i < osc->nbl; i++) {
+            for(i = 1; i < osc->nbl; i++) {
                 if(osc->freq <= osc->fbl[i]) {
                     bandlimitIndex = i;
                     break;
@@ -74,23 +90,43 @@ int sp_oscmorph2d_compute(sp_data *sp, sp_oscmorph2d *osc, SPFLOAT *in, SPFLOAT
             }
         } else {
             /* the override is the index */
-            bandlimitIndex = floor(bandlimitIndexOverride);
+            bandlimitIndex = floor(osc->bandlimitIndexOverride);
             if (bandlimitIndex < 0)
                 bandlimitIndex = 0;
         }
-    } else {
-        /* hard-code the "non-bandlimited" row of wavetables */
-        bandlimitIndex = 0;
     }
+    /* else: hard-code the "non-bandlimited" row of wavetables */
 
     /* Use only the fractional part of the position or 1 */
     if (osc->wtpos > 1.0) {
         osc->wtpos -= (int)osc->wtpos;
     }
-    
-    const SPFLOAT findex = (bandlimitIndex * osc->nft) + osc->wtpos * (osc->nft - 1);
+
+    return (bandlimitIndex * osc->nft) + osc->wtpos * (osc->nft - 1);
+}
+
+int sp_oscmorph2d_compute(sp_data *sp, sp_oscmorph2d *osc, SPFLOAT *in, SPFLOAT *out)
+{
+    sp_ftbl *ftp1;
+    SPFLOAT amp, cps, fract, v1, v2;
+    SPFLOAT *ft1, *ft2;
+    int32_t phs, lobits, pos;
+    SPFLOAT sicvt = osc->tbl[0]->sicvt; /* sicvt: this stands for Sampling Increment ConVert */
+
+    const SPFLOAT findex = oscmorph2d_findex(osc);
     const int index = floor(findex);
     const SPFLOAT wtfrac = findex - index;
+    const int row = (index / osc->nft) * osc->nft;
+
+    if(findex != osc->last_findex) {
+        /* the morph moved: restart rest detection and abandon any
+         * half-built cache; a finished cache just goes stale */
+        osc->last_findex = findex;
+        osc->rest_count = 0;
+        osc->build_pos = -1;
+    } else if(osc->rest_count <= OSCMORPH2D_REST_SAMPLES) {
+        osc->rest_count++;
+    }
 
     lobits = osc->tbl[index]->lobits;
     amp = osc->amp;
@@ -99,26 +135,57 @@ int sp_oscmorph2d_compute(sp_data *sp, sp_oscmorph2d *osc, SPFLOAT *in, SPFLOAT
     ftp1 = osc->tbl[index];
     ft1 = osc->tbl[index]->tbl;
 
-    if(index >= (bandlimitIndex * osc->nft) + (osc->nft - 1)) {
+    if(index >= row + (osc->nft - 1)) {
         ft2 = ft1;
     } else {
         ft2 = osc->tbl[index + 1]->tbl;
     }
-    
-    osc->inc = (int32_t)lrintf(cps * sicvt);  
+
+    osc->inc = (int32_t)lrintf(cps * sicvt);
 
     fract = ((phs) & ftp1->lomask) * ftp1->lodiv;
 
     pos = phs >> lobits;
 
-    v1 = (1 - wtfrac) * 
-        *(ft1 + pos) + 
-        wtfrac * 
-        *(ft2 + pos);
-    v2 = (1 - wtfrac) * 
-        *(ft1 + ((pos + 1) % ftp1->size))+ 
-        wtfrac * 
-        *(ft2 + ((pos + 1) % ftp1->size));
+    if(wtfrac == 0 || ft2 == ft1) {
+        /* the morph sits exactly on one source table: read it directly */
+        v1 = ft1[pos];
+        v2 = ft1[(pos + 1) % ftp1->size];
+    } else if(osc->blend_valid && osc->blend_findex == findex) {
+        /* resting on a cached blend: single-table reads */
+        SPFLOAT *ft = (SPFLOAT *)osc->blend_aux.ptr;
+        v1 = ft[pos];
+        v2 = ft[(pos + 1) % ftp1->size];
+    } else {
+        v1 = (1 - wtfrac) *
+            *(ft1 + pos) +
+            wtfrac *
+            *(ft2 + pos);
+        v2 = (1 - wtfrac) *
+            *(ft1 + ((pos + 1) % ftp1->size))+
+            wtfrac *
+            *(ft2 + ((pos + 1) % ftp1->size));
+
+        /* once the position has rested, render the blended cycle into the
+         * cache a chunk at a time; the cache equals the live blend exactly,
+         * so the switch-over is seamless and needs no crossfade */
+        if(osc->rest_count >= OSCMORPH2D_REST_SAMPLES) {
+            SPFLOAT *ft = (SPFLOAT *)osc->blend_aux.ptr;
+            int i, end;
+            if(osc->build_pos < 0) osc->build_pos = 0;
+            end = osc->build_pos + OSCMORPH2D_BUILD_CHUNK;
+            if(end > (int)ftp1->size) end = (int)ftp1->size;
+            for(i = osc->build_pos; i < end; i++) {
+                ft[i] = (1 - wtfrac) * ft1[i] + wtfrac * ft2[i];
+            }
+            osc->build_pos = end;
+            if(end == (int)ftp1->size) {
+                osc->blend_findex = findex;
+                osc->blend_valid = 1;
+                osc->build_pos = -1;
+            }
+        }
+    }
 
     *out = (v1 + (v2 - v1) * fract) * amp;
 
@@ -128,3 +195,81 @@ int sp_oscmorph2d_compute(sp_data *sp, sp_oscmorph2d *osc, SPFLOAT *in, SPFLOAT
     osc->lphs = phs;
     return SP_OK;
 }
+
+int sp_oscmorph2d_compute_block(sp_data *sp, sp_oscmorph2d *osc, SPFLOAT *in, SPFLOAT *out, int n)
+{
+    sp_ftbl *ftp1;
+    SPFLOAT *ft1, *ft2;
+    SPFLOAT amp, lodiv;
+    int32_t phs, inc, lobits, lomask, size;
+    int i;
+
+    const SPFLOAT findex = oscmorph2d_findex(osc);
+    const int index = floor(findex);
+    const SPFLOAT wtfrac = findex - index;
+    const int row = (index / osc->nft) * osc->nft;
+
+    ftp1 = osc->tbl[index];
+    size = (int32_t)ftp1->size;
+    ft1 = osc->tbl[index]->tbl;
+    if(index >= row + (osc->nft - 1)) {
+        ft2 = ft1;
+    } else {
+        ft2 = osc->tbl[index + 1]->tbl;
+    }
+
+    lobits = ftp1->lobits;
+    lomask = ftp1->lomask;
+    lodiv = ftp1->lodiv;
+    amp = osc->amp;
+    phs = osc->lphs;
+    osc->inc = inc = (int32_t)lrintf(osc->freq * ftp1->sicvt);
+
+    if(wtfrac == 0 || ft2 == ft1) {
+        /* the morph sits exactly on one source table: read it directly */
+        for(i = 0; i < n; i++) {
+            SPFLOAT fract = (phs & lomask) * lodiv;
+            int32_t pos = phs >> lobits;
+            SPFLOAT v1 = ft1[pos];
+            SPFLOAT v2 = ft1[(pos + 1) % size];
+            out[i] = (v1 + (v2 - v1) * fract) * amp;
+            phs = (phs + inc) & SP_FT_PHMASK;
+        }
+    } else if(findex == osc->last_findex || (osc->blend_valid && osc->blend_findex == findex)) {
+        /* the morph held still for a whole block: blend the cycle once into
+         * the cache, then run single-table lookups until it moves */
+        SPFLOAT *ft = (SPFLOAT *)osc->blend_aux.ptr;
+        if(!osc->blend_valid || osc->blend_findex != findex) {
+            for(i = 0; i < size; i++) {
+                ft[i] = (1 - wtfrac) * ft1[i] + wtfrac * ft2[i];
+            }
+            osc->blend_findex = findex;
+            osc->blend_valid = 1;
+            osc->build_pos = -1;
+        }
+        for(i = 0; i < n; i++) {
+            SPFLOAT fract = (phs & lomask) * lodiv;
+            int32_t pos = phs >> lobits;
+            SPFLOAT v1 = ft[pos];
+            SPFLOAT v2 = ft[(pos + 1) % size];
+            out[i] = (v1 + (v2 - v1) * fract) * amp;
+            phs = (phs + inc) & SP_FT_PHMASK;
+        }
+    } else {
+        /* mid-gesture: don't thrash the cache; run the two-table blend with
+         * the weights hoisted out of the loop */
+        for(i = 0; i < n; i++) {
+            SPFLOAT fract = (phs & lomask) * lodiv;
+            int32_t pos = phs >> lobits;
+            int32_t pos1 = (pos + 1) % size;
+            SPFLOAT v1 = (1 - wtfrac) * ft1[pos] + wtfrac * ft2[pos];
+            SPFLOAT v2 = (1 - wtfrac) * ft1[pos1] + wtfrac * ft2[pos1];
+            out[i] = (v1 + (v2 - v1) * fract) * amp;
+            phs = (phs + inc) & SP_FT_PHMASK;
+        }
+    }
+
+    osc->last_findex = findex;
+    osc->lphs = phs;
+    return SP_OK;
+}
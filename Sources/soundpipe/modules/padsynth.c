@@ -12,7 +12,9 @@
 */
 
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
+#include <pthread.h>
 #include "soundpipe.h"
 
 #ifndef M_PI
@@ -111,3 +113,235 @@ int sp_padsynth_normalize(int N, SPFLOAT *smp)
     for (i=0;i<N;i++) smp[i]/=max*1.4142;
     return SP_OK;
 }
+
+/* Asynchronous generation.
+ *
+ * A padsynth job runs the harmonic accumulation and inverse FFT on a
+ * worker thread so a 262144-point table no longer stalls the caller.
+ * Phases are drawn from sp's RNG on the calling thread at launch, so
+ * the worker never touches sp_data.  On completion the worker swaps
+ * the finished buffer into the owning ftable with a single pointer
+ * store (fenced so the table contents are visible first); readers on
+ * the audio thread see either the old table or the new one, never a
+ * half-written mix.  The buffer it displaces is retired and freed on
+ * the next regeneration or when the job is destroyed, which gives
+ * in-flight readers a grace period.
+ *
+ * The FFT plan and scratch buffers live in the job and are reused by
+ * sp_padsynth_job_regen when only the amplitudes (or f/bw) change.
+ * Destroy the job before destroying the ftable it feeds.
+ */
+
+struct sp_padsynth_job {
+    int N;
+    int nh;
+    SPFLOAT f;
+    SPFLOAT bw;
+    SPFLOAT *amps;
+    SPFLOAT *freq_amp;
+    SPFLOAT *freq_phase;
+    SPFLOAT *smp;
+    SPFLOAT *retired;
+    char retired_free;
+    sp_ftbl *ft;
+    FFTwrapper *fft;
+    void (*progress)(int percent, void *ud);
+    void *ud;
+    volatile int cancel;
+    volatile int state;
+    pthread_t thread;
+    int started;
+};
+
+static void * sp_padsynth_worker(void *arg)
+{
+    sp_padsynth_job *job = arg;
+    int i, nh;
+    int N = job->N;
+    FFTFREQS fftfreqs;
+
+    for(i = 0; i < N/2; i++) job->freq_amp[i] = 0.0;
+
+    for(nh = 1; nh < job->nh; nh++) {
+        SPFLOAT bw_Hz, bwi, fi;
+        if(job->cancel) {
+            job->state = SP_PADSYNTH_CANCELLED;
+            return NULL;
+        }
+        bw_Hz = (pow(2.0, job->bw/1200.0) - 1.0) * job->f * nh;
+        bwi = bw_Hz/(2.0*N);
+        fi = job->f*nh/N;
+        for(i = 0; i < N/2; i++) {
+            SPFLOAT hprofile;
+            hprofile = sp_padsynth_profile((i / (SPFLOAT) N) - fi, bwi);
+            job->freq_amp[i] += hprofile*job->amps[nh];
+        }
+        if(job->progress != NULL && job->nh > 1) {
+            job->progress((nh * 100) / (job->nh - 1), job->ud);
+        }
+    }
+
+    if(job->cancel) {
+        job->state = SP_PADSYNTH_CANCELLED;
+        return NULL;
+    }
+
+    newFFTFREQS(&fftfreqs, N/2);
+    for(i = 0; i < N/2; i++) {
+        fftfreqs.c[i] = job->freq_amp[i]*cos(job->freq_phase[i]);
+        fftfreqs.s[i] = job->freq_amp[i]*sin(job->freq_phase[i]);
+    }
+    freqs2smps(job->fft, &fftfreqs, job->smp);
+    deleteFFTFREQS(&fftfreqs);
+    sp_padsynth_normalize(N, job->smp);
+
+    /* publish: order the table contents before the pointer swap; a
+     * pointer-sized store is atomic on the platforms we target */
+    __sync_synchronize();
+    job->ft->tbl = job->smp;
+    job->ft->del = 1;
+    job->ft->tbl_arena = 0;
+
+    if(job->progress != NULL) job->progress(100, job->ud);
+    job->state = SP_PADSYNTH_DONE;
+    return NULL;
+}
+
+/* joins a finished worker so its resources are reclaimed */
+static void sp_padsynth_job_reap(sp_padsynth_job *job)
+{
+    if(job->started && job->state != SP_PADSYNTH_RUNNING) {
+        pthread_join(job->thread, NULL);
+        job->started = 0;
+    }
+}
+
+static int sp_padsynth_job_start(sp_data *sp, sp_padsynth_job *job,
+        sp_ftbl *amps, SPFLOAT f, SPFLOAT bw)
+{
+    int i;
+    int N = job->N;
+
+    if((int)amps->size != job->nh) return SP_NOT_OK;
+    memcpy(job->amps, amps->tbl, sizeof(SPFLOAT) * job->nh);
+    job->f = f;
+    job->bw = bw;
+    for(i = 0; i < N/2; i++) {
+        job->freq_phase[i] = (sp_rand(sp) / (SP_RANDMAX + 1.0)) * 2.0 * M_PI;
+    }
+    job->cancel = 0;
+    job->state = SP_PADSYNTH_RUNNING;
+    if(pthread_create(&job->thread, NULL, sp_padsynth_worker, job) != 0) {
+        job->state = SP_PADSYNTH_IDLE;
+        return SP_NOT_OK;
+    }
+    job->started = 1;
+    return SP_OK;
+}
+
+int sp_gen_padsynth_async(sp_data *sp, sp_ftbl *ps, sp_ftbl *amps,
+        SPFLOAT f, SPFLOAT bw,
+        void (*progress)(int percent, void *ud), void *ud,
+        sp_padsynth_job **job)
+{
+    sp_padsynth_job *j;
+    int N = (int)ps->size;
+
+    /* a cache alias is shared with other nodes; regenerating it in
+     * place would rewrite the table under them */
+    if(ps->cache != NULL) return SP_NOT_OK;
+
+    j = malloc(sizeof(sp_padsynth_job));
+    if(j == NULL) return SP_NOT_OK;
+    j->amps = malloc(sizeof(SPFLOAT) * amps->size);
+    j->freq_amp = malloc((N / 2) * sizeof(SPFLOAT));
+    j->freq_phase = malloc((N / 2) * sizeof(SPFLOAT));
+    j->smp = malloc(sizeof(SPFLOAT) * (N + 1));
+    if(j->amps == NULL || j->freq_amp == NULL ||
+            j->freq_phase == NULL || j->smp == NULL) {
+        free(j->amps);
+        free(j->freq_amp);
+        free(j->freq_phase);
+        free(j->smp);
+        free(j);
+        return SP_NOT_OK;
+    }
+    FFTwrapper_create(&j->fft, N);
+    j->N = N;
+    j->nh = (int)amps->size;
+    j->ft = ps;
+    /* the buffer the swap will displace */
+    j->retired = ps->tbl;
+    j->retired_free = (ps->del && !ps->tbl_arena);
+    j->progress = progress;
+    j->ud = ud;
+    j->state = SP_PADSYNTH_IDLE;
+    j->started = 0;
+
+    if(sp_padsynth_job_start(sp, j, amps, f, bw) != SP_OK) {
+        FFTwrapper_destroy(&j->fft);
+        free(j->amps);
+        free(j->freq_amp);
+        free(j->freq_phase);
+        free(j->smp);
+        free(j);
+        return SP_NOT_OK;
+    }
+    *job = j;
+    return SP_OK;
+}
+
+int sp_padsynth_job_regen(sp_data *sp, sp_padsynth_job *job,
+        sp_ftbl *amps, SPFLOAT f, SPFLOAT bw)
+{
+    if(job->state == SP_PADSYNTH_RUNNING) return SP_NOT_OK;
+    sp_padsynth_job_reap(job);
+
+    if(job->ft->tbl == job->smp) {
+        /* last run was published: retire it and generate into a
+         * fresh buffer so readers keep a valid table throughout */
+        if(job->retired_free && job->retired != job->ft->tbl) {
+            free(job->retired);
+        }
+        job->retired = job->smp;
+        job->retired_free = 1;
+        job->smp = malloc(sizeof(SPFLOAT) * (job->N + 1));
+        if(job->smp == NULL) {
+            job->smp = job->retired;
+            job->retired_free = 0;
+            return SP_NOT_OK;
+        }
+    }
+    return sp_padsynth_job_start(sp, job, amps, f, bw);
+}
+
+int sp_padsynth_job_cancel(sp_padsynth_job *job)
+{
+    job->cancel = 1;
+    return SP_OK;
+}
+
+int sp_padsynth_job_state(sp_padsynth_job *job)
+{
+    return job->state;
+}
+
+int sp_padsynth_job_destroy(sp_padsynth_job **job)
+{
+    sp_padsynth_job *j = *job;
+
+    j->cancel = 1;
+    if(j->started) {
+        pthread_join(j->thread, NULL);
+        j->started = 0;
+    }
+    if(j->retired_free && j->retired != j->ft->tbl) free(j->retired);
+    /* the published buffer now belongs to the ftable */
+    if(j->ft->tbl != j->smp) free(j->smp);
+    FFTwrapper_destroy(&j->fft);
+    free(j->amps);
+    free(j->freq_amp);
+    free(j->freq_phase);
+    free(j);
+    return SP_OK;
+}
@@ -20,6 +20,71 @@
 
 #define SQRT2 1.41421356237309504880
 
+/* Quarter-sine lookup for the equal-power laws, shared process-wide.
+ * Linear interpolation over 1024 intervals keeps the gain error below
+ * about 1e-6, and a moving pan costs two table reads instead of a
+ * sin/cos pair per change. The lazy fill is idempotent, so a race on
+ * first use writes identical values. */
+#define PAN_LUT_SIZE 1024
+static SPFLOAT pan_lut[PAN_LUT_SIZE + 1];
+static int pan_lut_ready = 0;
+
+/* sin(pi/2 * x) for x in [0, 1] */
+static SPFLOAT pan_lut_sin(SPFLOAT x)
+{
+    SPFLOAT pos = x * PAN_LUT_SIZE;
+    int i = (int)pos;
+    SPFLOAT frac;
+    /* x == 1 lands exactly on the last entry; don't read past it */
+    if (i >= PAN_LUT_SIZE) return pan_lut[PAN_LUT_SIZE];
+    frac = pos - i;
+    return pan_lut[i] + (pan_lut[i + 1] - pan_lut[i]) * frac;
+}
+
+void sp_pan_gains(uint32_t type, SPFLOAT pan, SPFLOAT *l, SPFLOAT *r)
+{
+    SPFLOAT cc, ss;
+
+    if (!pan_lut_ready) {
+        int i;
+        for (i = 0; i <= PAN_LUT_SIZE; i++) {
+            pan_lut[i] = sin(M_PI * 0.5 * (SPFLOAT)i / PAN_LUT_SIZE);
+        }
+        pan_lut_ready = 1;
+    }
+
+    switch (type % 4) {
+        /* Equal power */
+        case 0:
+        if (pan < 0) pan = 0;
+        if (pan > 1) pan = 1;
+        *l = pan_lut_sin(1.0 - pan);
+        *r = pan_lut_sin(pan);
+        break;
+
+        /* Square root */
+        case 1:
+        *l = sqrt(pan);
+        *r = sqrt(1.0 - pan);
+        break;
+
+        /* simple linear */
+        case 2:
+        *l = 1.0 - pan;
+        *r = pan;
+        break;
+
+        /* Equal power (alternative) */
+        case 3:
+        if (pan < 0) pan = 0;
+        if (pan > 1) pan = 1;
+        cc = pan_lut_sin(1.0 - pan);
+        ss = pan_lut_sin(pan);
+        *l = SQRT2 * (cc + ss) * 0.5;
+        *r = SQRT2 * (cc - ss) * 0.5;
+        break;
+    }
+}
 
 int sp_pan2_create(sp_pan2 **p)
 {
@@ -37,49 +102,47 @@ int sp_pan2_init(sp_data *sp, sp_pan2 *p)
 {
     p->type = 0;
     p->pan = 0;
+    p->ppan = -2;
+    p->ptype = 4;
+    p->lgain = 1;
+    p->rgain = 1;
     return SP_OK;
 }
 
 int sp_pan2_compute(sp_data *sp, sp_pan2 *p, SPFLOAT *in, SPFLOAT *out1, SPFLOAT *out2)
 {
-    /* Send the signal's input to the output */
-    uint32_t type = p->type;
-    SPFLOAT pan = (1 + p->pan) * 0.5;
-    SPFLOAT cc, ss, l, r;
-
-    type %= 4;
-
-    switch (type) {
-        /* Equal power */
-        case 0:
-        pan = M_PI * 0.5 * pan;
-        *out1 = *in * cos(pan);
-        *out2 = *in * sin(pan);
-        break;
-
-        /* Square root */
-        case 1:
-        *out1 = *in * sqrt(pan);
-        *out2 = *in * sqrt(1.0 - pan);
-        break;
+    /* recompute the gain pair only when the pan position or law moved */
+    if (p->pan != p->ppan || p->type != p->ptype) {
+        sp_pan_gains(p->type, (1 + p->pan) * 0.5, &p->lgain, &p->rgain);
+        p->ppan = p->pan;
+        p->ptype = p->type;
+    }
 
-        /* simple linear */
-        case 2:
-        *out1 = *in * (1.0 - pan);
-        *out2 = *in * pan;
-        break;
+    *out1 = *in * p->lgain;
+    *out2 = *in * p->rgain;
+    return SP_OK;
+}
 
-        /* Equal power (alternative) */
-        case 3:
+/* Applies the cached gain pair over a whole block with plain
+ * multiplies the compiler can vectorize; for a static pan the law is
+ * evaluated at most once per block. */
+int sp_pan2_compute_block(sp_data *sp, sp_pan2 *p, SPFLOAT *in,
+    SPFLOAT *out1, SPFLOAT *out2, int n)
+{
+    SPFLOAT lgain, rgain;
+    int i;
 
-        cc = cos(M_PI * pan * 0.5);
-        ss = sin(M_PI * pan * 0.5);
-        l = SQRT2 * (cc + ss) * 0.5;
-        r = SQRT2 * (cc - ss) * 0.5;
-        *out1 = *in * l;
-        *out2 = *in * r;
-        break;
+    if (p->pan != p->ppan || p->type != p->ptype) {
+        sp_pan_gains(p->type, (1 + p->pan) * 0.5, &p->lgain, &p->rgain);
+        p->ppan = p->pan;
+        p->ptype = p->type;
     }
+    lgain = p->lgain;
+    rgain = p->rgain;
 
+    for (i = 0; i < n; i++) {
+        out1[i] = in[i] * lgain;
+        out2[i] = in[i] * rgain;
+    }
     return SP_OK;
 }
@@ -25,49 +25,47 @@ int sp_panst_init(sp_data *sp, sp_panst *p)
 {
     p->type = 0;
     p->pan = 0;
+    p->ppan = -2;
+    p->ptype = 4;
+    p->lgain = 1;
+    p->rgain = 1;
     return SP_OK;
 }
 
 int sp_panst_compute(sp_data *sp, sp_panst *p, SPFLOAT *in1, SPFLOAT *in2, SPFLOAT *out1, SPFLOAT *out2)
 {
-    /* Send the signal's input to the output */
-    uint32_t type = p->type;
-    SPFLOAT pan = (p->pan + 1.0) * 0.5;
-    SPFLOAT cc, ss, l, r;
-
-    type %= 4;
-
-    switch (type) {
-        /* Equal power */
-        case 0:
-        pan = M_PI * 0.5 * pan;
-        *out1 = *in1 * cos(pan);
-        *out2 = *in2 * sin(pan);
-        break;
-
-        /* Square root */
-        case 1:
-        *out1 = *in1 * sqrt(pan);
-        *out2 = *in2 * sqrt(1.0 - pan);
-        break;
+    /* recompute the gain pair only when the pan position or law moved */
+    if (p->pan != p->ppan || p->type != p->ptype) {
+        sp_pan_gains(p->type, (p->pan + 1.0) * 0.5, &p->lgain, &p->rgain);
+        p->ppan = p->pan;
+        p->ptype = p->type;
+    }
 
-        /* simple linear */
-        case 2:
-        *out1 = *in1 * (1.0 - pan);
-        *out2 = *in2 * pan;
-        break;
+    *out1 = *in1 * p->lgain;
+    *out2 = *in2 * p->rgain;
+    return SP_OK;
+}
 
-        /* Equal power (alternative) */
-        case 3:
+/* Applies the cached gain pair over a whole block with plain
+ * multiplies the compiler can vectorize; for a static pan the law is
+ * evaluated at most once per block. */
+int sp_panst_compute_block(sp_data *sp, sp_panst *p, SPFLOAT *in1, SPFLOAT *in2,
+    SPFLOAT *out1, SPFLOAT *out2, int n)
+{
+    SPFLOAT lgain, rgain;
+    int i;
 
-        cc = cos(M_PI * pan * 0.5);
-        ss = sin(M_PI * pan * 0.5);
-        l = SQRT2 * (cc + ss) * 0.5;
-        r = SQRT2 * (cc - ss) * 0.5;
-        *out1 = *in1 * l;
-        *out2 = *in2 * r;
-        break;
+    if (p->pan != p->ppan || p->type != p->ptype) {
+        sp_pan_gains(p->type, (p->pan + 1.0) * 0.5, &p->lgain, &p->rgain);
+        p->ppan = p->pan;
+        p->ptype = p->type;
     }
+    lgain = p->lgain;
+    rgain = p->rgain;
 
+    for (i = 0; i < n; i++) {
+        out1[i] = in1[i] * lgain;
+        out2[i] = in2[i] * rgain;
+    }
     return SP_OK;
 }
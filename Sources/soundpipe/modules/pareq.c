@@ -44,9 +44,11 @@ int sp_pareq_init(sp_data *sp, sp_pareq *p)
     return SP_OK;
 }
 
-int sp_pareq_compute(sp_data *sp, sp_pareq *p, SPFLOAT *in, SPFLOAT *out)
+/* Refresh the biquad coefficients if fc, v, or q moved since the last
+ * call. Split out of sp_pareq_compute so fused multiband loops (sp_eq4)
+ * can update coefficients at control rate. */
+void sp_pareq_update(sp_pareq *p)
 {
-    SPFLOAT xn, yn;
     SPFLOAT sq;
 
     if (p->fc != p->prv_fc || p->v != p->prv_v || p->q != p->prv_q) {
@@ -97,6 +99,13 @@ int sp_pareq_compute(sp_data *sp, sp_pareq *p, SPFLOAT *in, SPFLOAT *out)
         a0 = 1.0 / a0;
         p->a1 *= a0; p->a2 *= a0; p->b0 *= a0; p->b1 *= a0; p->b2 *= a0;
     }
+}
+
+int sp_pareq_compute(sp_data *sp, sp_pareq *p, SPFLOAT *in, SPFLOAT *out)
+{
+    SPFLOAT xn, yn;
+
+    sp_pareq_update(p);
     {
         SPFLOAT a1 = p->a1, a2 = p->a2;
         SPFLOAT b0 = p->b0, b1 = p->b1, b2 = p->b2;
@@ -17,6 +17,43 @@
 #define M_PI		3.14159265358979323846
 #endif
 
+/* Slides the streaming window forward by one hop: keeps the samples
+ * the next window still covers and pulls just the new ones from the
+ * source callback.  Past the end of the stream the window pads out
+ * with silence so the stretched tail still plays. */
+static void stream_shift(sp_paulstretch *p)
+{
+    uint32_t windowsize = p->windowsize;
+    SPFLOAT *buf = p->stream_buf;
+    uint32_t shift, keep, got;
+
+    p->stream_frac += p->displace_pos;
+    shift = (uint32_t)floor(p->stream_frac);
+    p->stream_frac -= shift;
+
+    if(shift >= windowsize) {
+        /* stretch < 1: discard the input the window jumps over */
+        uint32_t skip = shift - windowsize;
+        while(skip > 0 && !p->stream_end) {
+            got = p->pull(p->pull_ud, buf,
+                    skip < windowsize ? skip : windowsize);
+            if(got == 0) p->stream_end = 1;
+            skip -= got;
+        }
+        keep = 0;
+    } else {
+        keep = windowsize - shift;
+        memmove(buf, buf + shift, sizeof(SPFLOAT) * keep);
+    }
+
+    while(keep < windowsize && !p->stream_end) {
+        got = p->pull(p->pull_ud, buf + keep, windowsize - keep);
+        if(got == 0) p->stream_end = 1;
+        keep += got;
+    }
+    while(keep < windowsize) buf[keep++] = 0;
+}
+
 static void compute_block(sp_data *sp, sp_paulstretch *p) {
     uint32_t istart_pos = floor(p->start_pos);
     uint32_t pos;
@@ -26,21 +63,29 @@ static void compute_block(sp_data *sp, sp_paulstretch *p) {
     SPFLOAT *buf = p->buf;
     SPFLOAT *hinv_buf = p->hinv_buf;
     SPFLOAT *old_windowed_buf= p->old_windowed_buf;
-    SPFLOAT *tbl = p->ft->tbl;
     SPFLOAT *window = p->window;
     SPFLOAT *output= p->output;
-    for(i = 0; i < windowsize; i++) {
-        /* Loop through buffer */
-        pos = (istart_pos + i) % p->ft->size;
+    if(p->ft != NULL) {
+        SPFLOAT *tbl = p->ft->tbl;
+        for(i = 0; i < windowsize; i++) {
+            /* Loop through buffer */
+            pos = (istart_pos + i) % p->ft->size;
 
-        if(p->wrap) {
-            pos %= p->ft->size;
-        }
+            if(p->wrap) {
+                pos %= p->ft->size;
+            }
 
-        if(pos < p->ft->size) {
-            buf[i] = tbl[pos] * window[i];
-        } else {
-            buf[i] = 0;
+            if(pos < p->ft->size) {
+                buf[i] = tbl[pos] * window[i];
+            } else {
+                buf[i] = 0;
+            }
+        }
+    } else {
+        /* streaming: the window buffer already holds the next
+         * windowsize source samples */
+        for(i = 0; i < windowsize; i++) {
+            buf[i] = p->stream_buf[i] * window[i];
         }
     }
     kiss_fftr(p->fft, buf, p->tmp1);
@@ -59,7 +104,11 @@ static void compute_block(sp_data *sp, sp_paulstretch *p) {
         }
         old_windowed_buf[i] = buf[i];
     }
-    p->start_pos += p->displace_pos;
+    if(p->ft != NULL) {
+        p->start_pos += p->displace_pos;
+    } else {
+        stream_shift(p);
+    }
 }
 
 int sp_paulstretch_create(sp_paulstretch **p)
@@ -76,6 +125,7 @@ int sp_paulstretch_destroy(sp_paulstretch **p)
     sp_auxdata_free(&pp->m_hinv_buf);
     sp_auxdata_free(&pp->m_buf);
     sp_auxdata_free(&pp->m_output);
+    if(pp->stream_buf != NULL) sp_auxdata_free(&pp->m_stream_buf);
     kiss_fftr_free(pp->fft);
     kiss_fftr_free(pp->ifft);
     KISS_FFT_FREE(pp->tmp1);
@@ -83,10 +133,9 @@ int sp_paulstretch_destroy(sp_paulstretch **p)
     return SP_OK;
 }
 
-int sp_paulstretch_init(sp_data *sp, sp_paulstretch *p, sp_ftbl *ft, SPFLOAT windowsize, SPFLOAT stretch)
+static int paulstretch_setup(sp_data *sp, sp_paulstretch *p, SPFLOAT windowsize, SPFLOAT stretch)
 {
     uint32_t i;
-    p->ft = ft;
     p->windowsize = (uint32_t)(sp->sr * windowsize);
     p->stretch = stretch;
     if(p->windowsize < 16) {
@@ -132,6 +181,49 @@ int sp_paulstretch_init(sp_data *sp, sp_paulstretch *p, sp_ftbl *ft, SPFLOAT win
 
     /* turn on wrap mode by default */
     p->wrap = 1;
+
+    p->stream_buf = NULL;
+    p->pull = NULL;
+    p->pull_ud = NULL;
+    p->stream_frac = 0;
+    p->stream_end = 0;
+    return SP_OK;
+}
+
+int sp_paulstretch_init(sp_data *sp, sp_paulstretch *p, sp_ftbl *ft, SPFLOAT windowsize, SPFLOAT stretch)
+{
+    p->ft = ft;
+    return paulstretch_setup(sp, p, windowsize, stretch);
+}
+
+/* Streaming variant: instead of holding the whole source in an ftable,
+ * input is pulled from a callback one hop at a time into a single
+ * window buffer, so memory is O(windowsize) rather than O(recording).
+ * pull fills up to n samples and returns how many it wrote; returning
+ * 0 marks the end of the stream. */
+int sp_paulstretch_init_stream(sp_data *sp, sp_paulstretch *p,
+        SPFLOAT windowsize, SPFLOAT stretch,
+        uint32_t (*pull)(void *ud, SPFLOAT *buf, uint32_t n), void *ud)
+{
+    uint32_t keep, got;
+
+    p->ft = NULL;
+    if(paulstretch_setup(sp, p, windowsize, stretch) != SP_OK) {
+        return SP_NOT_OK;
+    }
+    sp_auxdata_alloc(&p->m_stream_buf, sizeof(SPFLOAT) * p->windowsize);
+    p->stream_buf = p->m_stream_buf.ptr;
+    p->pull = pull;
+    p->pull_ud = ud;
+
+    /* prime the first window */
+    keep = 0;
+    while(keep < p->windowsize && !p->stream_end) {
+        got = p->pull(p->pull_ud, p->stream_buf + keep, p->windowsize - keep);
+        if(got == 0) p->stream_end = 1;
+        keep += got;
+    }
+    while(keep < p->windowsize) p->stream_buf[keep++] = 0;
     return SP_OK;
 }
 
@@ -145,3 +237,23 @@ int sp_paulstretch_compute(sp_data *sp, sp_paulstretch *p, SPFLOAT *in, SPFLOAT
 
     return SP_OK;
 }
+
+/* Renders a whole quantum in one call: between analysis blocks the
+ * per-sample path is just a copy out of the output frame, so it runs
+ * as contiguous memcpys here. */
+int sp_paulstretch_compute_block(sp_data *sp, sp_paulstretch *p, SPFLOAT *out, int nframes)
+{
+    int j = 0, run;
+
+    while(j < nframes) {
+        if(p->counter == 0) {
+            compute_block(sp, p);
+        }
+        run = p->half_windowsize - p->counter;
+        if(run > nframes - j) run = nframes - j;
+        memcpy(out + j, p->output + p->counter, sizeof(SPFLOAT) * run);
+        p->counter = (p->counter + run) % p->half_windowsize;
+        j += run;
+    }
+    return SP_OK;
+}
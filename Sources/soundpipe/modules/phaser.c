@@ -365,3 +365,144 @@ int sp_phaser_compute(sp_data *sp, sp_phaser *p,
     computephaser(dsp, 1, faust_in, faust_out);
     return SP_OK;
 }
+
+/* Hand-written block kernel over the same state as computephaser. The
+ * slow-rate values are derived once per block instead of per sample, the
+ * quadrature LFO is advanced analytically one rotation per segment, and
+ * the allpass coefficients (eight cosines per frame in the generated
+ * code) are evaluated at segment endpoints and linearly interpolated in
+ * between. The four-section cascade is recursive, so it runs fused in
+ * registers with both channels interleaved in one loop. */
+int sp_phaser_compute_block(sp_data *sp, sp_phaser *p,
+	SPFLOAT *in1, SPFLOAT *in2, SPFLOAT *out1, SPFLOAT *out2, int n)
+{
+	phaser* dsp = p->faust;
+	int i = 0;
+
+	float fSlow0 = pow(10.f, (0.05f * (float)dsp->fHslider0));
+	float fSlow1 = (0.5f * ((int)(float)dsp->fCheckbox0?2.f:(float)dsp->fHslider1));
+	float fSlow2 = (1.f - fSlow1);
+	float fSlow3 = exp((dsp->fConst1 * (0.f - (3.14159f * (float)dsp->fHslider2))));
+	float fSlow4 = faustpower2_f(fSlow3);
+	float fSlow5 = (0.f - (2.f * fSlow3));
+	float fSlow6 = (float)dsp->fHslider3;
+	float fSlow7 = (dsp->fConst1 * fSlow6);
+	float fSlow8 = (float)dsp->fHslider4;
+	float fSlow9 = (6.28319f * fSlow8);
+	float fSlow10 = (0.5f * ((6.28319f * max(fSlow8, (float)dsp->fHslider5)) - fSlow9));
+	float fSlow11 = (dsp->fConst2 * (float)dsp->fHslider6);
+	float fSlow15 = (float)dsp->fHslider7;
+	float fSlow16 = (dsp->fConst1 * faustpower2_f(fSlow6));
+	float fSlow17 = (dsp->fConst1 * faustpower3_f(fSlow6));
+	float fSlow18 = (dsp->fConst1 * faustpower4_f(fSlow6));
+	float fSlow19 = ((int)(float)dsp->fCheckbox1?(0.f - fSlow1):fSlow1);
+
+	/* the first sample after init carries the LFO start transient; let
+	 * the generated kernel take it so the recurrence is in steady state */
+	if (dsp->iVec0[1] == 0) {
+		SPFLOAT *faust_out[] = {out1, out2};
+		SPFLOAT *faust_in[] = {in1, in2};
+		computephaser(dsp, 1, faust_in, faust_out);
+		i = 1;
+	}
+
+	{
+	float r5 = dsp->fRec5[1], r6 = dsp->fRec6[1];
+	float a1 = dsp->fRec4[1], a2 = dsp->fRec4[2];
+	float b1 = dsp->fRec3[1], b2 = dsp->fRec3[2];
+	float c1 = dsp->fRec2[1], c2 = dsp->fRec2[2];
+	float d1 = dsp->fRec1[1], d2 = dsp->fRec1[2];
+	float f0 = dsp->fRec0[1];
+	float a1r = dsp->fRec11[1], a2r = dsp->fRec11[2];
+	float b1r = dsp->fRec10[1], b2r = dsp->fRec10[2];
+	float c1r = dsp->fRec9[1], c2r = dsp->fRec9[2];
+	float d1r = dsp->fRec8[1], d2r = dsp->fRec8[2];
+	float f0r = dsp->fRec7[1];
+
+	while (i < n) {
+		int k = n - i;
+		int j;
+		if (k > 32) k = 32;
+
+		/* LFO states one step and k steps ahead, via rotation */
+		float c1s = cos(fSlow11), s1s = sin(fSlow11);
+		float cks = cos(k*fSlow11), sks = sin(k*fSlow11);
+		float r5a = ((s1s * r6) + (c1s * r5));
+		float r6a = ((c1s * r6) - (s1s * r5));
+		float r5b = ((sks * r6) + (cks * r5));
+		float r6b = ((cks * r6) - (sks * r5));
+
+		/* coefficient endpoints for both channels */
+		float fTa = ((fSlow10 * (1.f - r5a)) + fSlow9);
+		float fTb = ((fSlow10 * (1.f - r5b)) + fSlow9);
+		float fUa = ((fSlow10 * (1.f - r6a)) + fSlow9);
+		float fUb = ((fSlow10 * (1.f - r6b)) + fSlow9);
+		float cA = cos((fSlow7 * fTa)),  cAe = cos((fSlow7 * fTb));
+		float cB = cos((fSlow16 * fTa)), cBe = cos((fSlow16 * fTb));
+		float cC = cos((fSlow17 * fTa)), cCe = cos((fSlow17 * fTb));
+		float cD = cos((fSlow18 * fTa)), cDe = cos((fSlow18 * fTb));
+		float cAr = cos((fSlow7 * fUa)),  cAre = cos((fSlow7 * fUb));
+		float cBr = cos((fSlow16 * fUa)), cBre = cos((fSlow16 * fUb));
+		float cCr = cos((fSlow17 * fUa)), cCre = cos((fSlow17 * fUb));
+		float cDr = cos((fSlow18 * fUa)), cDre = cos((fSlow18 * fUb));
+		float inv = (k > 1) ? (1.f / (k - 1)) : 0.f;
+		float dA = (cAe - cA)*inv, dB = (cBe - cB)*inv;
+		float dC = (cCe - cC)*inv, dD = (cDe - cD)*inv;
+		float dAr = (cAre - cAr)*inv, dBr = (cBre - cBr)*inv;
+		float dCr = (cCre - cCr)*inv, dDr = (cDre - cDr)*inv;
+
+		for (j = 0; j < k; j++) {
+			float x = (float)in1[i];
+			float fTemp2 = (a1 * cA);
+			float a0 = (0.f - (((fSlow5 * fTemp2) + (fSlow4 * a2)) - ((fSlow0 * x) + (fSlow15 * f0))));
+			float fTemp3 = (b1 * cB);
+			float b0 = ((fSlow5 * (fTemp2 - fTemp3)) + (a2 + (fSlow4 * (a0 - b2))));
+			float fTemp4 = (c1 * cC);
+			float c0 = ((fSlow5 * (fTemp3 - fTemp4)) + (b2 + (fSlow4 * (b0 - c2))));
+			float fTemp5 = (d1 * cD);
+			float d0 = ((fSlow5 * (fTemp4 - fTemp5)) + (c2 + (fSlow4 * (c0 - d2))));
+			f0 = ((fSlow4 * d0) + ((fSlow5 * fTemp5) + d2));
+			out1[i] = (SPFLOAT)((fSlow0 * (fSlow2 * x)) + (f0 * fSlow19));
+			a2 = a1; a1 = a0;
+			b2 = b1; b1 = b0;
+			c2 = c1; c1 = c0;
+			d2 = d1; d1 = d0;
+
+			float y = (float)in2[i];
+			float fTemp8 = (a1r * cAr);
+			float a0r = (0.f - (((fSlow5 * fTemp8) + (fSlow4 * a2r)) - ((fSlow0 * y) + (fSlow15 * f0r))));
+			float fTemp9 = (b1r * cBr);
+			float b0r = ((fSlow5 * (fTemp8 - fTemp9)) + (a2r + (fSlow4 * (a0r - b2r))));
+			float fTemp10 = (c1r * cCr);
+			float c0r = ((fSlow5 * (fTemp9 - fTemp10)) + (b2r + (fSlow4 * (b0r - c2r))));
+			float fTemp11 = (d1r * cDr);
+			float d0r = ((fSlow5 * (fTemp10 - fTemp11)) + (c2r + (fSlow4 * (c0r - d2r))));
+			f0r = ((fSlow4 * d0r) + ((fSlow5 * fTemp11) + d2r));
+			out2[i] = (SPFLOAT)((fSlow0 * (fSlow2 * y)) + (f0r * fSlow19));
+			a2r = a1r; a1r = a0r;
+			b2r = b1r; b1r = b0r;
+			c2r = c1r; c1r = c0r;
+			d2r = d1r; d1r = d0r;
+
+			cA += dA; cB += dB; cC += dC; cD += dD;
+			cAr += dAr; cBr += dBr; cCr += dCr; cDr += dDr;
+			i++;
+		}
+		r5 = r5b;
+		r6 = r6b;
+	}
+
+	dsp->fRec5[1] = r5; dsp->fRec6[1] = r6;
+	dsp->fRec4[1] = a1; dsp->fRec4[2] = a2;
+	dsp->fRec3[1] = b1; dsp->fRec3[2] = b2;
+	dsp->fRec2[1] = c1; dsp->fRec2[2] = c2;
+	dsp->fRec1[1] = d1; dsp->fRec1[2] = d2;
+	dsp->fRec0[1] = f0;
+	dsp->fRec11[1] = a1r; dsp->fRec11[2] = a2r;
+	dsp->fRec10[1] = b1r; dsp->fRec10[2] = b2r;
+	dsp->fRec9[1] = c1r; dsp->fRec9[2] = c2r;
+	dsp->fRec8[1] = d1r; dsp->fRec8[2] = d2r;
+	dsp->fRec7[1] = f0r;
+	}
+	return SP_OK;
+}
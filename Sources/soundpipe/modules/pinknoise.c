@@ -66,3 +66,36 @@ int sp_pinknoise_compute(sp_data *sp, sp_pinknoise *p, SPFLOAT *in, SPFLOAT *out
     p->counter = (p->counter + 1) % 0xFFFFFFFF;
     return SP_OK;
 }
+
+/* Fills a whole block with the dice, running total, and seed held in
+ * locals. Same sequence as sp_pinknoise_compute. */
+int sp_pinknoise_compute_block(sp_data *sp, sp_pinknoise *p, SPFLOAT *in, SPFLOAT *out, int n)
+{
+    uint32_t seed = p->seed;
+    uint32_t total = p->total;
+    uint32_t counter = p->counter;
+    SPFLOAT amp = p->amp;
+    uint32_t newrand = p->newrand, prevrand = p->prevrand;
+    int i;
+
+    for (i = 0; i < n; i++) {
+        uint32_t k = ctz[counter & 63];
+        prevrand = p->dice[k];
+        seed = 1664525 * seed + 1013904223;
+        newrand = seed >> 3;
+        p->dice[k] = newrand;
+        total += (newrand - prevrand);
+        seed = 1103515245 * seed + 12345;
+        newrand = seed >> 3;
+        short tmp = (short) ((((total + newrand) * (1.0f / (3 << 29)) - 1) - .25f) * 16384.0f);
+        out[i] = ((SPFLOAT) tmp / 32767) * amp;
+        counter = (counter + 1) % 0xFFFFFFFF;
+    }
+
+    p->seed = seed;
+    p->total = total;
+    p->counter = counter;
+    p->prevrand = prevrand;
+    p->newrand = newrand;
+    return SP_OK;
+}
@@ -109,3 +109,130 @@ int sp_pluck_compute(sp_data *sp, sp_pluck *p, SPFLOAT *trig, SPFLOAT *out)
     p->phs256 = phs256;
     return SP_OK;
 }
+
+int sp_pluck_compute_block(sp_data *sp, sp_pluck *p, SPFLOAT *trig, SPFLOAT *out, int n)
+{
+    SPFLOAT *buf = (SPFLOAT *)p->auxch.ptr;
+    SPFLOAT amp = p->amp;
+    int32_t phsinc = (int32_t)(p->freq * p->sicps);
+    int32_t ltwopi = p->npts << 8;
+    int i = 0;
+
+    while (i < n) {
+        int run, j;
+        int32_t phs256;
+
+        if (trig[i] != 0) {
+            p->init = 0;
+            sp_pluck_reinit(sp, p);
+        }
+
+        if (p->init) {
+            out[i] = 0;
+            i++;
+            continue;
+        }
+
+        /* stop the run at the next trigger so a re-excitation lands on
+         * the same frame as in the per-sample path */
+        run = 1;
+        while (i + run < n && trig[i + run] == 0) run++;
+
+        phs256 = p->phs256;
+        while (run > 0) {
+            /* the averager only runs when the phase wraps, once per
+             * period; between wraps the lookups are independent of one
+             * another, so they go through without dependency stalls */
+            int span = run;
+            if (phsinc > 0) {
+                int towrap = (ltwopi - phs256 + phsinc - 1) / phsinc;
+                if (towrap < span) span = towrap;
+            }
+            for (j = 0; j < span; j++) {
+                int32_t ph = phs256 + j * phsinc;
+                SPFLOAT *fp = buf + (ph >> 8);
+                SPFLOAT diff = fp[1] - fp[0];
+                SPFLOAT frac = (SPFLOAT)(ph & 255) / 256.0;
+                out[i + j] = (fp[0] + diff*frac) * amp;
+            }
+            phs256 += span * phsinc;
+            i += span;
+            run -= span;
+            if (phs256 >= ltwopi) {
+                SPFLOAT preval;
+                phs256 -= ltwopi;
+                preval = buf[0];
+                buf[0] = buf[p->npts];
+                for (j = 1; j <= p->npts; j++) {
+                    /* 1st order recursive filter*/
+                    preval = (buf[j] + preval) * 0.5;
+                    buf[j] = preval;
+                }
+            }
+        }
+        p->phs256 = phs256;
+    }
+    return SP_OK;
+}
+
+int sp_pluckbank_create(sp_pluckbank **p)
+{
+    *p = malloc(sizeof(sp_pluckbank));
+    (*p)->nstrings = 0;
+    (*p)->strings = NULL;
+    return SP_OK;
+}
+
+int sp_pluckbank_destroy(sp_pluckbank **p)
+{
+    sp_pluckbank *pp = *p;
+    int i;
+    if (pp->strings != NULL) {
+        for (i = 0; i < pp->nstrings; i++) {
+            sp_pluck_destroy(&pp->strings[i]);
+        }
+        sp_auxdata_free(&pp->aux);
+    }
+    free(*p);
+    return SP_OK;
+}
+
+int sp_pluckbank_init(sp_data *sp, sp_pluckbank *p, int nstrings, SPFLOAT ifreq)
+{
+    int i;
+    if (nstrings < 1) nstrings = 1;
+    p->nstrings = nstrings;
+    sp_auxdata_alloc(&p->aux, nstrings * sizeof(sp_pluck *));
+    p->strings = (sp_pluck **)p->aux.ptr;
+    for (i = 0; i < nstrings; i++) {
+        sp_pluck_create(&p->strings[i]);
+        sp_pluck_init(sp, p->strings[i], ifreq);
+    }
+    return SP_OK;
+}
+
+int sp_pluckbank_compute(sp_data *sp, sp_pluckbank *p, SPFLOAT *trig, SPFLOAT *out)
+{
+    return sp_pluckbank_compute_block(sp, p, trig, out, 1);
+}
+
+int sp_pluckbank_compute_block(sp_data *sp, sp_pluckbank *p, SPFLOAT *trig, SPFLOAT *out, int n)
+{
+    SPFLOAT tmp[64];
+    SPFLOAT acc[64];
+    int i, s, offset = 0;
+
+    /* one trigger strums every string; their outputs sum */
+    while (offset < n) {
+        int run = n - offset;
+        if (run > 64) run = 64;
+        for (i = 0; i < run; i++) acc[i] = 0.0;
+        for (s = 0; s < p->nstrings; s++) {
+            sp_pluck_compute_block(sp, p->strings[s], trig + offset, tmp, run);
+            for (i = 0; i < run; i++) acc[i] += tmp[i];
+        }
+        for (i = 0; i < run; i++) out[offset + i] = acc[i];
+        offset += run;
+    }
+    return SP_OK;
+}
@@ -0,0 +1,108 @@
+/*
+ * PolyBLEP
+ *
+ * Block-oriented square/saw oscillator using polynomial band-limited
+ * step (polyBLEP) corrections instead of the blsquare/blsaw BLIT
+ * machinery. Cheaper per voice and table-free, at the cost of the
+ * spectral exactness of the BLIT approach. The square has a variable
+ * duty cycle and both shapes take a phase-distortion warp with the
+ * same knee convention as pdhalf: the knee sits at (pd + 1) / 2 and
+ * maps to the halfway point of the cycle.
+ *
+ */
+
+#include <stdlib.h>
+#include "soundpipe.h"
+
+int sp_polyblep_create(sp_polyblep **p)
+{
+    *p = malloc(sizeof(sp_polyblep));
+    return SP_OK;
+}
+
+int sp_polyblep_destroy(sp_polyblep **p)
+{
+    free(*p);
+    return SP_OK;
+}
+
+int sp_polyblep_init(sp_data *sp, sp_polyblep *p)
+{
+    p->freq = 440;
+    p->amp = 1.0;
+    p->width = 0.5;
+    p->pd = 0;
+    p->type = SP_POLYBLEP_SQUARE;
+    p->phs = 0;
+    p->onedsr = 1.0 / sp->sr;
+    return SP_OK;
+}
+
+/* two-sample polynomial correction for a unit step at t = 0 */
+static SPFLOAT polyblep_step(SPFLOAT t, SPFLOAT dt)
+{
+    if (t < dt) {
+        t /= dt;
+        return t+t - t*t - 1.0;
+    } else if (t > 1.0 - dt) {
+        t = (t - 1.0) / dt;
+        return t*t + t+t + 1.0;
+    }
+    return 0.0;
+}
+
+int sp_polyblep_compute_block(sp_data *sp, sp_polyblep *p, SPFLOAT *out, int n)
+{
+    SPFLOAT dt = p->freq * p->onedsr;
+    SPFLOAT amp = p->amp;
+    SPFLOAT width = p->width;
+    SPFLOAT phs = p->phs;
+    SPFLOAT k, s1, s2;
+    int square = (p->type == SP_POLYBLEP_SQUARE);
+    int i;
+
+    if (dt < 0) dt = 0;
+    if (dt > 0.5) dt = 0.5;
+    if (width < 0.01) width = 0.01;
+    if (width > 0.99) width = 0.99;
+
+    /* phase warp: [0, k] -> [0, 0.5], [k, 1] -> [0.5, 1] */
+    k = 0.5 * (p->pd + 1.0);
+    if (k < 0.01) k = 0.01;
+    if (k > 0.99) k = 0.99;
+    s1 = 0.5 / k;
+    s2 = 0.5 / (1.0 - k);
+
+    for (i = 0; i < n; i++) {
+        SPFLOAT slope = (phs < k) ? s1 : s2;
+        SPFLOAT w = (phs < k) ? phs * s1 : 0.5 + (phs - k) * s2;
+        /* the BLEP widens with the local warp slope so the corrected
+         * edge spans the same number of output samples */
+        SPFLOAT dtw = dt * slope;
+        SPFLOAT y;
+        if (dtw > 0.5) dtw = 0.5;
+
+        if (square) {
+            SPFLOAT wfall = w + 1.0 - width;
+            if (wfall >= 1.0) wfall -= 1.0;
+            y = (w < width) ? 1.0 : -1.0;
+            y += polyblep_step(w, dtw);
+            y -= polyblep_step(wfall, dtw);
+        } else {
+            y = 2.0*w - 1.0;
+            y -= polyblep_step(w, dtw);
+        }
+        out[i] = y * amp;
+
+        phs += dt;
+        if (phs >= 1.0) phs -= 1.0;
+    }
+
+    p->phs = phs;
+    return SP_OK;
+}
+
+int sp_polyblep_compute(sp_data *sp, sp_polyblep *p, SPFLOAT *in, SPFLOAT *out)
+{
+    return sp_polyblep_compute_block(sp, p, out, 1);
+}
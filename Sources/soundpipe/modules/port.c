@@ -57,6 +57,23 @@ int sp_port_compute(sp_data *sp, sp_port *p, SPFLOAT *in, SPFLOAT *out)
     return SP_OK;
 }
 
+/* Advances the smoother n samples in one evaluation. With the input
+ * held for the block, n steps of the one-pole recursion collapse to a
+ * single pow() of the pole, so block-rate control graphs get the same
+ * trajectory without running the per-sample state machine. */
+int sp_port_compute_kr(sp_data *sp, sp_port *p, SPFLOAT *in, SPFLOAT *out, int n)
+{
+    if(p->prvhtim != p->htime){
+        p->c2 = pow(0.5, p->onedsr / p->htime);
+        p->c1 = 1.0 - p->c2;
+        p->prvhtim = p->htime;
+    }
+
+    p->yt1 = *in + (p->yt1 - *in) * pow(p->c2, n);
+    *out = p->yt1;
+    return SP_OK;
+}
+
 int sp_port_reset(sp_data *sp, sp_port *p, SPFLOAT *in)
 {
     p->yt1 = *in;
@@ -134,6 +134,7 @@ int sp_pshift_init(sp_data *sp, sp_pshift *p)
     p->shift = p->args[0];
     p->window = p->args[1];
     p->xfade = p->args[2];
+    p->quality = 1;
 
     p->faust = dsp;
     return SP_OK;
@@ -151,3 +152,72 @@ int sp_pshift_compute(sp_data *sp, sp_pshift *p, SPFLOAT *in, SPFLOAT *out)
     *out = out1;
     return SP_OK;
 }
+
+/* Hand-written block kernel over the same state as computepshift. The
+ * powf() shift-ratio derivation runs once per block instead of per
+ * sample, the tap phase wraps with compares instead of fmodf, and the
+ * dual taps with their crossfade gains run fused in one pass. With
+ * quality 0 the taps read the nearest delay sample instead of linearly
+ * interpolating, halving the delay-line reads for large windows. */
+int sp_pshift_compute_block(sp_data *sp, sp_pshift *p, SPFLOAT *in, SPFLOAT *out, int n)
+{
+	pshift* dsp = p->faust;
+	float fSlow0 = (float)dsp->fHslider0;
+	float fSlow1 = ((1.f + fSlow0) - powf(2.f, (0.0833333f * (float)dsp->fHslider1)));
+	float fSlow2 = (1.f / (float)dsp->fHslider2);
+	float fSlow3 = (fSlow0 - 1.f);
+	float *buf = dsp->fVec0;
+	float phase = dsp->fRec0[1];
+	int iota = dsp->IOTA;
+	int i;
+
+	if (p->quality == 0) {
+		for (i = 0; (i < n); i = (i + 1)) {
+			buf[(iota & 65535)] = (float)in[i];
+			phase = (phase + fSlow1);
+			if (phase >= fSlow0) {
+				phase -= fSlow0;
+				if (phase >= fSlow0) phase -= fSlow0;
+			} else if (phase <= (0.f - fSlow0)) {
+				phase += fSlow0;
+				if (phase <= (0.f - fSlow0)) phase += fSlow0;
+			}
+			{
+			int iTemp1 = (int)(phase + 0.5f);
+			float fTemp3 = min((fSlow2 * phase), 1.f);
+			int iTemp5 = (int)((phase + fSlow0) + 0.5f);
+			out[i] = (SPFLOAT)((buf[((iota - (iTemp1 & 65535)) & 65535)] * fTemp3)
+				+ (buf[((iota - (iTemp5 & 65535)) & 65535)] * (1.f - fTemp3)));
+			}
+			iota = (iota + 1);
+		}
+	} else {
+		for (i = 0; (i < n); i = (i + 1)) {
+			buf[(iota & 65535)] = (float)in[i];
+			phase = (phase + fSlow1);
+			if (phase >= fSlow0) {
+				phase -= fSlow0;
+				if (phase >= fSlow0) phase -= fSlow0;
+			} else if (phase <= (0.f - fSlow0)) {
+				phase += fSlow0;
+				if (phase <= (0.f - fSlow0)) phase += fSlow0;
+			}
+			{
+			int iTemp1 = (int)phase;
+			int iTemp2 = (1 + iTemp1);
+			float fTemp3 = min((fSlow2 * phase), 1.f);
+			float fTemp4 = (phase + fSlow0);
+			int iTemp5 = (int)fTemp4;
+			out[i] = (SPFLOAT)((((buf[((iota - (iTemp1 & 65535)) & 65535)] * ((float)iTemp2 - phase))
+				+ ((phase - (float)iTemp1) * buf[((iota - (iTemp2 & 65535)) & 65535)])) * fTemp3)
+				+ (((buf[((iota - (iTemp5 & 65535)) & 65535)] * (0.f - ((phase + fSlow3) - (float)iTemp5)))
+				+ ((fTemp4 - (float)iTemp5) * buf[((iota - ((1 + iTemp5) & 65535)) & 65535)])) * (1.f - fTemp3)));
+			}
+			iota = (iota + 1);
+		}
+	}
+
+	dsp->IOTA = iota;
+	dsp->fRec0[1] = phase;
+	return SP_OK;
+}
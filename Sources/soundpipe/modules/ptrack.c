@@ -13,6 +13,9 @@
 
 #include <stdlib.h>
 #include <math.h>
+#ifdef SOUNDPIPE_USE_VDSP
+#include <Accelerate/Accelerate.h>
+#endif
 #include "soundpipe.h"
 
 #define MINFREQINBINS 5
@@ -103,7 +106,7 @@ int sp_ptrack_destroy(sp_ptrack **p)
     sp_auxdata_free(&pp->spec2);
     sp_auxdata_free(&pp->spec1);
     sp_auxdata_free(&pp->peakarray);
-    sp_fft_destroy(&pp->fft);
+    if (!pp->fft_shared) sp_fft_destroy(&pp->fft);
     free(*p);
     return SP_OK;
 }
@@ -170,7 +173,23 @@ int sp_ptrack_init(sp_data *sp, sp_ptrack *p, int ihopsize, int ipeaks)
     p->npartial = 7;
     p->dbfs = 32768.0;
     p->prevf = p->cps = 100.0;
+    p->fft_shared = 0;
+
+    return SP_OK;
+}
+
+/* Like sp_ptrack_init, but borrows the donor's FFT setup (twiddle tables)
+ * instead of building a new one. The donor must use the same hop size and
+ * must outlive p. Intended for tracking many channels of the same length. */
+int sp_ptrack_init_shared_fft(sp_data *sp, sp_ptrack *p, int ihopsize, int ipeaks, sp_ptrack *donor)
+{
+    int rc = sp_ptrack_init(sp, p, ihopsize, ipeaks);
+    if (rc != SP_OK) return rc;
+    if (donor->hopsize != p->hopsize) return SP_NOT_OK;
 
+    sp_fft_destroy(&p->fft);
+    p->fft = donor->fft;
+    p->fft_shared = 1;
     return SP_OK;
 }
 
@@ -436,3 +455,41 @@ int sp_ptrack_compute(sp_data *sp, sp_ptrack *p, SPFLOAT *in, SPFLOAT *freq, SPF
 
     return SP_OK;
 }
+
+int sp_ptrack_compute_block(sp_data *sp, sp_ptrack *p, SPFLOAT *in, int n, SPFLOAT *freq, SPFLOAT *amp)
+{
+    SPFLOAT *buf = (SPFLOAT *)p->signal.ptr;
+    int pos = p->cnt, h = p->hopsize;
+    SPFLOAT scale = p->dbfs;
+    int i = 0;
+
+    /* Fill the hop buffer in whole chunks, analyzing only when a hop
+     * boundary passes. The dB conversion below runs once per block instead
+     * of once per sample. */
+    while (i < n) {
+        int chunk;
+        if (pos == h) {
+            ptrack(sp, p);
+            pos = 0;
+        }
+        chunk = h - pos;
+        if (chunk > n - i) chunk = n - i;
+#ifdef SOUNDPIPE_USE_VDSP
+        vDSP_vsmul(in + i, 1, &scale, buf + pos, 1, (vDSP_Length)chunk);
+#else
+        {
+            int j;
+            for (j = 0; j < chunk; j++) buf[pos + j] = in[i + j] * scale;
+        }
+#endif
+        pos += chunk;
+        i += chunk;
+    }
+
+    *freq = p->cps;
+    *amp = exp(p->dbs[p->histcnt] / 20.0 * log(10.0));
+
+    p->cnt = pos;
+
+    return SP_OK;
+}
@@ -103,6 +103,9 @@ static int delay_line_bytes_alloc(SPFLOAT sr, SPFLOAT iPitchMod, int n)
     int nBytes = 0;
 
     nBytes += (delay_line_max_samples(sr, iPitchMod, n) * (int) sizeof(SPFLOAT));
+    /* the delay lines share one block; round each one up to a cache
+     * line so neighbouring lines never share one */
+    nBytes = (nBytes + 63) & ~63;
     return nBytes;
 }
 
@@ -160,25 +163,28 @@ static int init_delay_line(sp_revsc *p, sp_revsc_dl *lp, int n)
 }
 
 
-int sp_revsc_compute(sp_data *sp, sp_revsc *p, SPFLOAT *in1, SPFLOAT *in2, SPFLOAT *out1, SPFLOAT *out2)
+/* recalculate tone filter coefficient if frequency changed */
+static SPFLOAT revsc_damp_fact(sp_revsc *p)
 {
-    SPFLOAT ainL, ainR, aoutL, aoutR;
-    SPFLOAT vm1, v0, v1, v2, am1, a0, a1, a2, frac;
-    sp_revsc_dl *lp;
-    int readPos;
-    uint32_t n;
-    int bufferSize; /* Local copy */
     SPFLOAT dampFact = p->dampFact;
 
-    if (p->initDone <= 0) return SP_NOT_OK;
-
-    /* calculate tone filter coefficient if frequency changed */
-
     if (p->lpfreq != p->prv_LPFreq) {
         p->prv_LPFreq = p->lpfreq;
         dampFact = 2.0 - cos(p->prv_LPFreq * (2 * M_PI) / p->sampleRate);
         dampFact = p->dampFact = dampFact - sqrt(dampFact * dampFact - 1.0);
     }
+    return dampFact;
+}
+
+static void revsc_process(sp_revsc *p, SPFLOAT dampFact,
+        SPFLOAT in1, SPFLOAT in2, SPFLOAT *out1, SPFLOAT *out2)
+{
+    SPFLOAT ainL, ainR, aoutL, aoutR;
+    SPFLOAT vm1, v0, v1, v2, am1, a0, a1, a2, frac;
+    sp_revsc_dl *lp;
+    int readPos;
+    uint32_t n;
+    int bufferSize; /* Local copy */
 
     /* calculate "resultant junction pressure" and mix to input signals */
 
@@ -187,8 +193,8 @@ int sp_revsc_compute(sp_data *sp, sp_revsc *p, SPFLOAT *in1, SPFLOAT *in2, SPFLO
         ainL += p->delayLines[n].filterState;
     }
     ainL *= jpScale;
-    ainR = ainL + *in2;
-    ainL = ainL + *in1;
+    ainR = ainL + in2;
+    ainL = ainL + in1;
 
     /* loop through all delay lines */
 
@@ -272,5 +278,28 @@ int sp_revsc_compute(sp_data *sp, sp_revsc *p, SPFLOAT *in1, SPFLOAT *in2, SPFLO
 
     *out1  = aoutL * outputGain;
     *out2 = aoutR * outputGain;
+}
+
+int sp_revsc_compute(sp_data *sp, sp_revsc *p, SPFLOAT *in1, SPFLOAT *in2, SPFLOAT *out1, SPFLOAT *out2)
+{
+    if (p->initDone <= 0) return SP_NOT_OK;
+    revsc_process(p, revsc_damp_fact(p), *in1, *in2, out1, out2);
+    return SP_OK;
+}
+
+/* Block variant: the filter coefficient check and the delay-line state
+ * stay hot across the whole quantum instead of being re-fetched per
+ * call. */
+int sp_revsc_compute_block(sp_data *sp, sp_revsc *p, SPFLOAT *in1,
+        SPFLOAT *in2, SPFLOAT *out1, SPFLOAT *out2, int nframes)
+{
+    int i;
+    SPFLOAT dampFact;
+
+    if (p->initDone <= 0) return SP_NOT_OK;
+    dampFact = revsc_damp_fact(p);
+    for (i = 0; i < nframes; i++) {
+        revsc_process(p, dampFact, in1[i], in2[i], &out1[i], &out2[i]);
+    }
     return SP_OK;
 }
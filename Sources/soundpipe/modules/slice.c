@@ -1,4 +1,5 @@
 #include <stdlib.h>
+#include <string.h>
 #include "soundpipe.h"
 
 int sp_slice_create(sp_slice **p)
@@ -44,3 +45,40 @@ int sp_slice_compute(sp_data *sp, sp_slice *p, SPFLOAT *in, SPFLOAT *out)
 
     return SP_OK;
 }
+
+int sp_slice_compute_block(sp_data *sp, sp_slice *p, SPFLOAT *in, SPFLOAT *out, int n)
+{
+    int i = 0;
+
+    while (i < n) {
+        int run, chunk, avail, j;
+
+        if (in[i] != 0) {
+            if (p->id < p->vals->size) {
+                p->pos = p->vals->tbl[p->id];
+                if (p->id == p->vals->size - 1) {
+                    p->nextpos = (uint32_t)p->buf->size;
+                } else {
+                    p->nextpos = p->vals->tbl[p->id + 1];
+                }
+            }
+        }
+
+        /* stop the run at the next trigger so a retrigger lands on the
+         * same frame as in the per-sample path */
+        run = 1;
+        while (i + run < n && in[i + run] == 0) run++;
+
+        /* the slice is a contiguous region of the parent table, so its
+         * remainder plays back as one copy and the tail pads with zeros */
+        avail = (p->pos < p->nextpos) ? (int)(p->nextpos - p->pos) : 0;
+        chunk = run < avail ? run : avail;
+        if (chunk > 0) {
+            memcpy(out + i, p->buf->tbl + p->pos, chunk * sizeof(SPFLOAT));
+            p->pos += chunk;
+        }
+        for (j = chunk; j < run; j++) out[i + j] = 0;
+        i += run;
+    }
+    return SP_OK;
+}
@@ -1,3 +1,4 @@
+#include <math.h>
 #include <stdlib.h>
 #include "soundpipe.h"
 
@@ -9,6 +10,13 @@
 #define min(a, b) ((a < b) ? a : b)
 #endif
 
+/* Delay-time changes used to crossfade between two complete delay
+ * lines, which doubled the memory per instance and ran both lines for
+ * the length of every change. Instead, a single buffer is read with a
+ * fractional head (third-order Lagrange interpolation, as in vdelay)
+ * and the delay time slews toward its target over the interp period,
+ * so automation glides the read head instead of triggering a
+ * double-render crossfade. */
 
 int sp_smoothdelay_create(sp_smoothdelay **p)
 {
@@ -20,7 +28,6 @@ int sp_smoothdelay_destroy(sp_smoothdelay **p)
 {
     sp_smoothdelay *pp = *p;
     sp_auxdata_free(&pp->buf1);
-    sp_auxdata_free(&pp->buf2);
     free(*p);
     return SP_OK;
 }
@@ -35,80 +42,80 @@ int sp_smoothdelay_init(sp_data *sp, sp_smoothdelay *p,
     p->maxdel = maxdel;
     p->feedback = 0;
     p->maxbuf = n - 1;
-    p->maxcount = interp;
+    p->maxcount = max(interp, 1);
 
     sp_auxdata_alloc(&p->buf1, n * sizeof(SPFLOAT));
     p->bufpos1 = 0;
-    p->deltime1 = (uint32_t) (p->del * sp->sr);
 
-    sp_auxdata_alloc(&p->buf2, n * sizeof(SPFLOAT));
-    p->bufpos2 = 0;
-    p->deltime2 = p->deltime1;
-
-    p->counter = 0;
-    p->curbuf = 0;
+    p->curdel = p->del * sp->sr;
+    p->targetdel = p->curdel;
+    p->slew = 0;
     return SP_OK;
 }
 
-static SPFLOAT delay_sig(SPFLOAT *buf,
-        uint32_t *bufpos,
-        uint32_t deltime,
-        SPFLOAT fdbk,
-        SPFLOAT in)
-{
-    SPFLOAT delay = buf[*bufpos];
-    SPFLOAT sig = (delay * fdbk) + in;
-    buf[*bufpos] = sig;
-    *bufpos = (*bufpos + 1) % deltime;
-    return delay;
-}
-
 int sp_smoothdelay_compute(sp_data *sp, sp_smoothdelay *p, SPFLOAT *in, SPFLOAT *out)
 {
-    *out = 0;
-    if(p->del != p->pdel && p->counter == 0) {
-        uint32_t dels = min((uint32_t)(p->del * sp->sr), p->maxbuf);
-
-        /* initial delay time sets time for both buffers */
-
-        if(p->pdel < 0) {
-            p->deltime1 = dels;
-            p->deltime2 = dels;
-        }
-
+    SPFLOAT *buf = (SPFLOAT *)p->buf1.ptr;
+    int32_t maxd = (int32_t)p->maxbuf;
+    SPFLOAT fv1;
+    int32_t v0, v1, v2, v3;
+    SPFLOAT b0, b1, b2, b3;
+
+    if(p->del != p->pdel) {
+        SPFLOAT dels = p->del * p->sr;
+        if(dels < 1) dels = 1;
+        if(dels > (SPFLOAT)(maxd - 2)) dels = (SPFLOAT)(maxd - 2);
+        p->targetdel = dels;
+
+        /* initial delay time takes effect immediately */
+        if(p->pdel < 0) p->curdel = dels;
+        p->slew = fabs(p->targetdel - p->curdel) / p->maxcount;
         p->pdel = p->del;
-
-        if(dels == 0) dels = 1;
-
-        if(p->curbuf == 0) {
-            p->curbuf = 1;
-            p->deltime2 = dels;
-        } else {
-            p->curbuf = 0;
-            p->deltime1 = dels;
-        }
-        p->counter = p->maxcount;
     }
 
+    /* slew-limit the delay time toward its target */
+    if(p->curdel < p->targetdel) {
+        p->curdel = min(p->curdel + p->slew, p->targetdel);
+    } else if(p->curdel > p->targetdel) {
+        p->curdel = max(p->curdel - p->slew, p->targetdel);
+    }
 
+    /* fractional read head trails the write head by curdel samples */
+    fv1 = (SPFLOAT)p->bufpos1 - p->curdel;
+    v1 = (int32_t)fv1;
+    fv1 -= (SPFLOAT) v1;
+    if ((v1 < 0) || (fv1 < 0.0)) {
+        fv1++; v1--;
+        while (v1 < 0) v1 += maxd;
+    } else {
+        while (v1 >= maxd) v1 -= maxd;
+    }
+    v2 = (v1 == maxd - 1 ? 0 : v1 + 1);
 
-    SPFLOAT *buf1 = (SPFLOAT *)p->buf1.ptr;
-    SPFLOAT *buf2 = (SPFLOAT *)p->buf2.ptr;
-    SPFLOAT it = (SPFLOAT)p->counter / p->maxcount;
-    if(p->counter != 0) p->counter--;
-
-    SPFLOAT del1 = delay_sig(buf1, &p->bufpos1,
-            p->deltime1, p->feedback, *in);
-
-    SPFLOAT del2 = delay_sig(buf2, &p->bufpos2,
-            p->deltime2, p->feedback, *in);
-
-    if(p->curbuf == 0) {
-        /* 1 to 2 */
-        *out = (del1 * it) + (del2 * (1 - it));
+    if (maxd < 4) {
+        b1 = buf[v1];
+        b2 = buf[v2];
+        *out = b1 + fv1 * (b2 - b1);
     } else {
-        /* 2 to 1 */
-        *out = (del2 * it) + (del1 * (1 - it));
+        v0 = (v1 == 0 ? maxd - 1 : v1 - 1);
+        v3 = (v2 == maxd - 1 ? 0 : v2 + 1);
+        {
+            SPFLOAT w, x, y, z;
+            z = fv1 * fv1; z--;
+            z *= 0.1666666667;
+            y = fv1;
+            y++; w = (y *= 0.5); w--;
+            x = 3.0 * z; y -= x; w -= z; x -= fv1;
+            b0 = buf[v0];
+            b1 = buf[v1];
+            b2 = buf[v2];
+            b3 = buf[v3];
+            *out = (w*b0 + x*b1 + y*b2 + z*b3)
+            * fv1 + b1;
+        }
     }
+
+    buf[p->bufpos1] = *in + *out * p->feedback;
+    if (++p->bufpos1 >= (uint32_t)maxd) p->bufpos1 = 0;
     return SP_OK;
 }
@@ -88,76 +88,89 @@ int sp_sndwarp_init(sp_data *sp, sp_sndwarp *p,
     return SP_OK;
 }
 
+/* The grain pool (p->exp) is one contiguous allocation, and each
+ * grain's window increment (ampincr) is computed once when the grain is
+ * (re)scheduled; the per-sample loop below only walks the pool. The
+ * amp/timewarp/resample parameters are grain-invariant, so they are
+ * read once per sample instead of once per grain (the old per-grain
+ * "++" bumps were Csound a-rate leftovers, dead because the locals were
+ * reloaded at the top of every iteration). The window is a caller-owned
+ * ftbl, so instances can already share one table (e.g. via the interned
+ * sp_ftbl cache). */
 int sp_sndwarp_compute(sp_data *sp, sp_sndwarp *p, SPFLOAT *in, SPFLOAT *out)
 {
     SPFLOAT frm_0,frm_1;
     int32_t base, longphase;
     SPFLOAT frac, frIndx;
-    SPFLOAT r1, amp, timewarpby, resample;
+    SPFLOAT r1;
     sp_sndwarp_warpsection *exp;
-    sp_ftbl *ft_win, *ft_samp;
+    const SPFLOAT *wtbl, *stbl;
     int32_t i;
     SPFLOAT v1, v2, windowamp, fract;
     SPFLOAT flen = (SPFLOAT)p->flen;
     SPFLOAT wsize = p->wsize;
     int32_t overlap = p->overlap;
 
+    /* grain-invariant parameters */
+    SPFLOAT resample = p->resample;
+    SPFLOAT timewarpby = p->timewarp;
+    SPFLOAT amp = p->amp;
+    SPFLOAT beginoffset = p->begin * sp->sr;
+    SPFLOAT maxFr = (SPFLOAT)p->maxFr;
+    int32_t lastwin = p->flen - 1;
+
     r1 = 0;
     exp = p->exp;
-    ft_win = p->ft_win;
-    ft_samp = p->ft_samp;
+    wtbl = p->ft_win->tbl;
+    stbl = p->ft_samp->tbl;
 
     if(overlap > p->nsections) overlap = p->nsections;
     if(overlap <= 0) overlap = 1;
 
     for (i=0; i<overlap; i++) {
-        resample = p->resample;
-        timewarpby = p->timewarp;
-        amp = p->amp;
-        if (exp[i].cnt < exp[i].wsize) goto skipover;
-
-        if (p->timemode)
-            exp[i].offset=(sp->sr * timewarpby)+(p->begin * sp->sr);
-        else
-            exp[i].offset += (SPFLOAT)exp[i].wsize/(timewarpby);
-
-        exp[i].cnt=0;
-        exp[i].wsize = (int32_t) ((wsize + (unirand(sp) * (p->randw))) * sp->sr);
-        exp[i].ampphs = 0.0;
-        exp[i].ampincr = flen/(exp[i].wsize-1);
-
-        skipover:
+        sp_sndwarp_warpsection *g = &exp[i];
+
+        /* (re)schedule an exhausted grain: new length, offset, and
+           window increment, once per grain */
+        if (g->cnt >= g->wsize) {
+            if (p->timemode)
+                g->offset = (sp->sr * timewarpby) + beginoffset;
+            else
+                g->offset += (SPFLOAT)g->wsize/(timewarpby);
+
+            g->cnt = 0;
+            g->wsize = (int32_t) ((wsize + (unirand(sp) * (p->randw))) * sp->sr);
+            g->ampphs = 0.0;
+            g->ampincr = flen/(g->wsize-1);
+        }
 
-        frIndx =(SPFLOAT)((exp[i].cnt * resample)  + exp[i].offset);
-        exp[i].cnt += 1;
-        if (frIndx > (SPFLOAT)p->maxFr) { /* not past last one */
-            frIndx = (SPFLOAT)p->maxFr;
+        frIndx = (SPFLOAT)((g->cnt * resample) + g->offset);
+        g->cnt += 1;
+        if (frIndx > maxFr) { /* not past last one */
+            frIndx = maxFr;
             if (p->prFlg) {
                 p->prFlg = 0;   /* false */
                 /* fprintf(stderr, "SNDWARP at last sample frame"); */
             }
         }
-        longphase = (int32_t)exp[i].ampphs;
-        if (longphase > p->flen-1) longphase = p->flen-1;
-        v1 = *(ft_win->tbl + longphase);
-        v2 = *(ft_win->tbl + longphase + 1);
-        fract = (SPFLOAT)(exp[i].ampphs - (int32_t)exp[i].ampphs);
+        longphase = (int32_t)g->ampphs;
+        if (longphase > lastwin) longphase = lastwin;
+        v1 = wtbl[longphase];
+        v2 = wtbl[longphase + 1];
+        fract = (SPFLOAT)(g->ampphs - (int32_t)g->ampphs);
         windowamp = v1 + (v2 - v1)*fract;
-        exp[i].ampphs += exp[i].ampincr;
+        g->ampphs += g->ampincr;
 
         base = (int32_t)frIndx;    /* index of basis frame of interpolation */
         frac = ((SPFLOAT)(frIndx - (SPFLOAT)base));
-        frm_0 = *(ft_samp->tbl + base);
-        frm_1 = *(ft_samp->tbl + (base+1));
+        frm_0 = stbl[base];
+        frm_1 = stbl[base+1];
         if (frac != 0.0) {
             r1 += ((frm_0 + frac*(frm_1-frm_0)) * windowamp) * amp;
         }
         else {
             r1 += (frm_0 * windowamp) * amp;
         }
-        if (p->ampcode) amp++;
-        if (p->timewarpcode) timewarpby++;
-        if (p->resamplecode) resample++;
     }
 
     *out = r1;
@@ -38,31 +38,46 @@ int sp_streson_init(sp_data *sp, sp_streson *p)
     p->Cdelay = (SPFLOAT*) p->buf.ptr; /* delay line */
     p->LPdelay = p->APdelay = 0.0; /* reset the All-pass and Low-pass delays */
     p->wpointer = p->rpointer = 0; /* reset the read/write pointers */
+    p->lfreq = -1.0; /* force coefficient derivation on first compute */
+    p->ca = 0.0;
+    p->cvdt = 0;
     for (n = 0; n < p->size; n++){
       p->Cdelay[n] = 0.0;
     }
     return SP_OK;
 }
 
+/* derive the variable delay and all-pass gain, cached until freq changes */
+static void streson_update(sp_data *sp, sp_streson *p)
+{
+    SPFLOAT freq, tdelay, fracdelay;
+    int delay;
+
+    if (p->lfreq == p->freq) return;
+    p->lfreq = p->freq;
+
+    freq = p->freq;
+    if (freq < 20.0) freq = 20.0;   /* lowest freq is 20 Hz */
+    tdelay = sp->sr/freq;
+    delay = (int) (tdelay - 0.5); /* comb delay */
+    fracdelay = tdelay - (delay + 0.5); /* fractional delay */
+    p->cvdt = p->size - delay;       /* set the var delay */
+    p->ca = (1.0-fracdelay)/(1.0+fracdelay);   /* set the all-pass gain */
+}
+
 int sp_streson_compute(sp_data *sp, sp_streson *p, SPFLOAT *in, SPFLOAT *out)
 {
     SPFLOAT g = p->fdbgain;
-    SPFLOAT freq;
-    SPFLOAT a, s, w, sample, tdelay, fracdelay;
-    int delay;
+    SPFLOAT a, s, w, sample;
     int rp = p->rpointer, wp = p->wpointer;
     int size = p->size;
     SPFLOAT APdelay = p->APdelay;
     SPFLOAT LPdelay = p->LPdelay;
     int vdt;
 
-    freq = p->freq;
-    if (freq < 20.0) freq = 20.0;   /* lowest freq is 20 Hz */
-    tdelay = sp->sr/freq;
-    delay = (int) (tdelay - 0.5); /* comb delay */
-    fracdelay = tdelay - (delay + 0.5); /* fractional delay */
-    vdt = size - delay;       /* set the var delay */
-    a = (1.0-fracdelay)/(1.0+fracdelay);   /* set the all-pass gain */
+    streson_update(sp, p);
+    vdt = p->cvdt;
+    a = p->ca;
 
     SPFLOAT tmpo;
     rp = (vdt + wp);
@@ -80,3 +95,108 @@ int sp_streson_compute(sp_data *sp, sp_streson *p, SPFLOAT *in, SPFLOAT *out)
     p->LPdelay = LPdelay; p->APdelay = APdelay;
     return SP_OK;
 }
+
+int sp_streson_compute_block(sp_data *sp, sp_streson *p, SPFLOAT *in, SPFLOAT *out, int n)
+{
+    SPFLOAT g = p->fdbgain;
+    SPFLOAT a, s, w, sample;
+    SPFLOAT *buf = p->Cdelay;
+    int size = p->size;
+    SPFLOAT APdelay = p->APdelay;
+    SPFLOAT LPdelay = p->LPdelay;
+    int wp = p->wpointer;
+    int rp;
+    int i = 0;
+
+    streson_update(sp, p);
+    a = p->ca;
+    rp = wp + p->cvdt;
+    if (rp >= size) rp -= size;
+
+    /* both pointers advance in lockstep, so run the largest span that
+     * reaches neither end of the buffer and wrap once per span */
+    while (i < n) {
+        int run = n - i;
+        int end;
+        if (size - rp < run) run = size - rp;
+        if (size - wp < run) run = size - wp;
+        for (end = i + run; i < end; i++) {
+            SPFLOAT tmpo = buf[rp++];
+            w = in[i] + tmpo;
+            s = (LPdelay + w)*0.5;
+            LPdelay = w;
+            out[i] = sample = APdelay + s*a;
+            APdelay = s - (sample*a);
+            buf[wp++] = sample*g;
+        }
+        if (rp == size) rp = 0;
+        if (wp == size) wp = 0;
+    }
+
+    p->rpointer = rp; p->wpointer = wp;
+    p->LPdelay = LPdelay; p->APdelay = APdelay;
+    return SP_OK;
+}
+
+int sp_stresonbank_create(sp_stresonbank **p)
+{
+    *p = malloc(sizeof(sp_stresonbank));
+    (*p)->nstrings = 0;
+    (*p)->strings = NULL;
+    return SP_OK;
+}
+
+int sp_stresonbank_destroy(sp_stresonbank **p)
+{
+    sp_stresonbank *pp = *p;
+    int i;
+    if (pp->strings != NULL) {
+        for (i = 0; i < pp->nstrings; i++) {
+            sp_streson_destroy(&pp->strings[i]);
+        }
+        sp_auxdata_free(&pp->aux);
+    }
+    free(*p);
+    return SP_OK;
+}
+
+int sp_stresonbank_init(sp_data *sp, sp_stresonbank *p, int nstrings)
+{
+    int i;
+    if (nstrings < 1) nstrings = 1;
+    p->nstrings = nstrings;
+    sp_auxdata_alloc(&p->aux, nstrings * sizeof(sp_streson *));
+    p->strings = (sp_streson **)p->aux.ptr;
+    for (i = 0; i < nstrings; i++) {
+        sp_streson_create(&p->strings[i]);
+        sp_streson_init(sp, p->strings[i]);
+    }
+    return SP_OK;
+}
+
+int sp_stresonbank_compute(sp_data *sp, sp_stresonbank *p, SPFLOAT *in, SPFLOAT *out)
+{
+    return sp_stresonbank_compute_block(sp, p, in, out, 1);
+}
+
+int sp_stresonbank_compute_block(sp_data *sp, sp_stresonbank *p, SPFLOAT *in, SPFLOAT *out, int n)
+{
+    SPFLOAT tmp[64];
+    SPFLOAT acc[64];
+    int i, s, offset = 0;
+
+    /* every string reads the same input; their outputs sum. The chunk
+     * accumulator keeps this correct when in and out alias. */
+    while (offset < n) {
+        int run = n - offset;
+        if (run > 64) run = 64;
+        for (i = 0; i < run; i++) acc[i] = 0.0;
+        for (s = 0; s < p->nstrings; s++) {
+            sp_streson_compute_block(sp, p->strings[s], in + offset, tmp, run);
+            for (i = 0; i < run; i++) acc[i] += tmp[i];
+        }
+        for (i = 0; i < run; i++) out[offset + i] = acc[i];
+        offset += run;
+    }
+    return SP_OK;
+}
@@ -71,3 +71,86 @@ int sp_tabread_compute(sp_data *sp, sp_tabread *p, SPFLOAT *in, SPFLOAT *out)
     *out = x1 + (x2 - x1) * frac;
     return SP_OK;
 }
+
+int sp_tabread_compute_block(sp_data *sp, sp_tabread *p, SPFLOAT rate, SPFLOAT *out, int n)
+{
+    int len = (int)p->ft->size;
+    int32_t mask = (int)p->ft->size - 1;
+    SPFLOAT index = p->index;
+    SPFLOAT *tbl = p->ft->tbl;
+    SPFLOAT offset = p->offset;
+    SPFLOAT mul = 1;
+    int32_t iwrap = (int32_t)p->wrap;
+    int i;
+
+    if (p->mode) {
+        mul = p->ft->size;
+    }else {
+        p->mul = 1;
+    }
+
+    if (rate == 1 && !p->mode && (!iwrap || (len & (len - 1)) == 0)) {
+        /* at unity rate the fractional part is constant while the integer
+         * index steps by one, so each output is two adjacent reads and a
+         * lerp: sequential spans, no gathers, no per-sample branching */
+        SPFLOAT tmp = index + offset;
+        int32_t ndx = floor(tmp);
+        SPFLOAT frac = tmp - ndx;
+
+        i = 0;
+        while (i < n) {
+            int run = n - i, j;
+            if (iwrap) {
+                while (ndx >= len) ndx -= len;
+                while (ndx < 0) ndx += len;
+                if (len - ndx < run) run = len - ndx;
+                for (j = 0; j < run; j++) {
+                    SPFLOAT x1 = tbl[ndx + j];
+                    SPFLOAT x2 = tbl[ndx + j + 1];
+                    out[i + j] = x1 + (x2 - x1) * frac;
+                }
+            } else if (ndx < 0) {
+                SPFLOAT v = tbl[0] + (tbl[1] - tbl[0]) * frac;
+                if (-ndx < run) run = -ndx;
+                for (j = 0; j < run; j++) out[i + j] = v;
+            } else if (ndx >= len) {
+                SPFLOAT v = tbl[len - 1] + (tbl[len] - tbl[len - 1]) * frac;
+                for (j = 0; j < run; j++) out[i + j] = v;
+            } else {
+                if (len - ndx < run) run = len - ndx;
+                for (j = 0; j < run; j++) {
+                    SPFLOAT x1 = tbl[ndx + j];
+                    SPFLOAT x2 = tbl[ndx + j + 1];
+                    out[i + j] = x1 + (x2 - x1) * frac;
+                }
+            }
+            ndx += run;
+            i += run;
+        }
+        p->index = index + (SPFLOAT)n;
+        return SP_OK;
+    }
+
+    for (i = 0; i < n; i++) {
+        SPFLOAT tmp = (index + offset) * mul;
+        int ndx = floor(tmp);
+        SPFLOAT frac = tmp - ndx;
+        SPFLOAT x1, x2;
+        if (iwrap) {
+            if ((mask ? 0 : 1)) {
+                while(ndx >= len) ndx -= len;
+                while(ndx < 0)  ndx += len;
+            }
+            else ndx &= mask;
+        } else {
+            if (ndx >= len) ndx = len - 1;
+            else if (ndx < 0) ndx = 0;
+        }
+        x1 = tbl[ndx];
+        x2 = tbl[ndx+1];
+        out[i] = x1 + (x2 - x1) * frac;
+        index += rate;
+    }
+    p->index = index;
+    return SP_OK;
+}
@@ -50,16 +50,53 @@ static void lpc_durbin(SPFLOAT *r, int p, float *k, float *g)
   *g = (float)sqrt(e);
 }
 
-static void lpc(float *buf, float *car, uint32_t n, uint32_t o)
+/* Autocorrelation lags 0..o of buf[0..n-1] via Wiener-Khinchin: one
+ * zero-padded real FFT, power spectrum, inverse FFT. Costs n*log(n)
+ * per hop instead of the O(o*n) time-domain loops, which flattens the
+ * per-hop spike at high orders/sample rates. */
+static void lpc_autocorrelate_fft(sp_talkbox *t, SPFLOAT *buf,
+    SPFLOAT *r, uint32_t n, uint32_t o)
+{
+    SPFLOAT *fb = t->fft_buf;
+    SPFLOAT re, im;
+    uint32_t nfft = (uint32_t)t->fft_size;
+    uint32_t i;
+
+    memcpy(fb, buf, n * sizeof(SPFLOAT));
+    memset(fb + n, 0, (nfft - n) * sizeof(SPFLOAT));
+
+    sp_fftr(&t->fft, fb, nfft);
+
+    /* packed spectrum: [DC, Nyquist, re, im, re, im, ...] */
+    fb[0] *= fb[0];
+    fb[1] *= fb[1];
+    for(i = 1; i < nfft / 2; i++) {
+        re = fb[2 * i];
+        im = fb[2 * i + 1];
+        fb[2 * i] = re * re + im * im;
+        fb[2 * i + 1] = 0.0f;
+    }
+
+    sp_ifftr(&t->fft, fb, nfft);
+
+    for(i = 0; i <= o; i++) r[i] = fb[i];
+}
+
+static void lpc(sp_talkbox *t, float *buf, float *car, uint32_t n, uint32_t o)
 {
     SPFLOAT z[ORD_MAX], r[ORD_MAX], k[ORD_MAX], G, x;
     uint32_t i, j, nn=n;
     SPFLOAT min;
 
     /* buf[] is already emphasized and windowed */
-    for(j=0; j<=o; j++, nn--) {
-        z[j] = r[j] = 0.0f;
-        for(i=0; i<nn; i++) r[j] += buf[i] * buf[i+j]; /* autocorrelation */
+    if(t->use_fft) {
+        lpc_autocorrelate_fft(t, buf, r, n, o);
+        for(j=0; j<=o; j++) z[j] = 0.0f;
+    } else {
+        for(j=0; j<=o; j++, nn--) {
+            z[j] = r[j] = 0.0f;
+            for(i=0; i<nn; i++) r[j] += buf[i] * buf[i+j]; /* autocorrelation */
+        }
     }
 
     r[0] *= 1.001f;  /* stability fix */
@@ -86,12 +123,14 @@ static void lpc(float *buf, float *car, uint32_t n, uint32_t o)
 
 int sp_talkbox_create(sp_talkbox **p)
 {
-    *p = malloc(sizeof(sp_talkbox));
+    /* zeroed so destroying a never-initialized talkbox is harmless */
+    *p = calloc(1, sizeof(sp_talkbox));
     return SP_OK;
 }
 
 int sp_talkbox_destroy(sp_talkbox **p)
 {
+    sp_fft_destroy(&(*p)->fft);
     free(*p);
     return SP_OK;
 }
@@ -99,6 +138,7 @@ int sp_talkbox_destroy(sp_talkbox **p)
 int sp_talkbox_init(sp_data *sp, sp_talkbox *p)
 {
     uint32_t n;
+    int m;
     p->quality = 1.f;
     p->N = 1;
     p->K = 0;
@@ -106,6 +146,16 @@ int sp_talkbox_init(sp_data *sp, sp_talkbox *p)
     n = (uint32_t)(0.01633f * sp->sr);
     if(n > SP_TALKBOX_BUFMAX) n = SP_TALKBOX_BUFMAX;
 
+    /* FFT sized for a window plus the maximum LPC order, so the
+     * zero-padded circular autocorrelation equals the linear one */
+    for(m = 1; (uint32_t)(1 << m) < n + ORD_MAX; m++);
+    if(p->fft_size != (1 << m)) {
+        if(p->fft_size != 0) sp_fft_destroy(&p->fft);
+        p->fft_size = 1 << m;
+        sp_fft_init(&p->fft, m);
+    }
+    p->use_fft = 0;
+
     /* calculate hanning window */
     if(n != p->N) {
         p->N = n;
@@ -167,10 +217,10 @@ int sp_talkbox_compute(sp_data *sp, sp_talkbox *t, SPFLOAT *src, SPFLOAT *exc, S
 
         /* 50% overlapping hanning windows */
         w = t->window[p0]; fx = t->buf0[p0] * w;  t->buf0[p0] = x * w;  
-        if(++p0 >= t->N) { lpc(t->buf0, t->car0, t->N, t->O);  p0 = 0; }
+        if(++p0 >= t->N) { lpc(t, t->buf0, t->car0, t->N, t->O);  p0 = 0; }
 
         w = 1.0f - w;  fx += t->buf1[p1] * w;  t->buf1[p1] = x * w;
-        if(++p1 >= t->N) { lpc(t->buf1, t->car1, t->N, t->O);  p1 = 0; }
+        if(++p1 >= t->N) { lpc(t, t->buf1, t->car1, t->N, t->O);  p1 = 0; }
     }
 
     p = t->u0 + h0 * fx; 
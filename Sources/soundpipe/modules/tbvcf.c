@@ -51,18 +51,39 @@ int sp_tbvcf_init(sp_data *sp, sp_tbvcf *p)
     p->fcocod = p->fco;
     p->rezcod = p->res;
 
+    /* force coefficient derivation on the first compute */
+    p->pfco = p->pres = p->pdist = -1.0;
+    p->cq1 = p->cq = p->cfc = 0.0;
 
     return SP_OK;
 }
 
+/* Derives the k-rate coefficients from fco/res/dist, but only when one of
+ * them actually changed; the sqrt/pow chain runs at control rate. */
+static void tbvcf_update(sp_tbvcf *p)
+{
+    SPFLOAT q1, fco1;
+
+    if(p->pfco == p->fco && p->pres == p->res && p->pdist == p->dist) return;
+
+    q1   = p->res/(1.0 + sqrt(p->dist));
+    fco1 = pow(p->fco*260.0/(1.0+q1*0.5),0.58);
+    p->cq1 = q1;
+    p->cq  = q1*fco1*fco1*0.0005;
+    p->cfc = fco1*p->onedsr*(p->sr/8.0);
+
+    p->pfco = p->fco;
+    p->pres = p->res;
+    p->pdist = p->dist;
+}
+
 int sp_tbvcf_compute(sp_data *sp, sp_tbvcf *p, SPFLOAT *in, SPFLOAT *out)
 {
     SPFLOAT x;
-    SPFLOAT fco, res, dist, asym;
+    SPFLOAT dist, asym;
     SPFLOAT y = p->y, y1 = p->y1, y2 = p->y2;
-    /* The initialisations are fake to fool compiler warnings */
     SPFLOAT ih, fdbk, d, ad;
-    SPFLOAT fc=0.0, fco1=0.0, q=0.0, q1=0.0;
+    SPFLOAT fc, q, q1;
 
     ih  = 0.001; /* ih is the incremental factor */
 
@@ -79,24 +100,15 @@ int sp_tbvcf_compute(sp_data *sp, sp_tbvcf *p, SPFLOAT *in, SPFLOAT *out)
     asym = (SPFLOAT)*asymptr; */
 
     /* This should work in sp world */
-    fco = p->fco;
-    res = p->res;
     dist = p->dist;
     asym = p->asym;
 
- /* Try to decouple the variables */
-    if ((p->rezcod==0) && (p->fcocod==0)) { /* Calc once only */
-        q1   = res/(1.0 + sqrt(dist));
-        fco1 = pow(fco*260.0/(1.0+q1*0.5),0.58);
-        q    = q1*fco1*fco1*0.0005;
-        fc   = fco1*p->onedsr*(p->sr/8.0);
-    }
-    if ((p->rezcod!=0) || (p->fcocod!=0)) {
-        q1  = res/(1.0 + sqrt(dist));
-        fco1 = pow(fco*260.0/(1.0+q1*0.5),0.58);
-        q  = q1*fco1*fco1*0.0005;
-        fc  = fco1*p->onedsr*(p->sr/8.0);
-    }
+    /* coefficients come from the control-rate cache */
+    tbvcf_update(p);
+    q1 = p->cq1;
+    q  = p->cq;
+    fc = p->cfc;
+
     x  = *in;
     fdbk = q*y/(1.0 + exp(-3.0*y)*asym);
     y1  = y1 + ih*((x - y1)*fc - fdbk);
@@ -109,3 +121,35 @@ int sp_tbvcf_compute(sp_data *sp, sp_tbvcf *p, SPFLOAT *in, SPFLOAT *out)
     p->y = y; p->y1 = y1; p->y2 = y2;
     return SP_OK;
 }
+
+int sp_tbvcf_compute_block(sp_data *sp, sp_tbvcf *p, SPFLOAT *in, SPFLOAT *out, int n)
+{
+    SPFLOAT y = p->y, y1 = p->y1, y2 = p->y2;
+    SPFLOAT dist = p->dist, asym = p->asym;
+    SPFLOAT ih = 0.001;
+    SPFLOAT fc, q, q1, outscale;
+    int i;
+
+    /* derive coefficients once for the whole block; the exp() in the
+     * feedback path is signal-dependent and stays per sample */
+    tbvcf_update(p);
+    q1 = p->cq1;
+    q  = p->cq;
+    fc = p->cfc;
+    outscale = fc/1000.0*(1.0 + q1)*3.2;
+
+    for(i = 0; i < n; i++) {
+        SPFLOAT x = in[i];
+        SPFLOAT fdbk, d, ad;
+        fdbk = q*y/(1.0 + exp(-3.0*y)*asym);
+        y1  = y1 + ih*((x - y1)*fc - fdbk);
+        d  = -0.1*y*20.0;
+        ad  = (d*d*d + y2)*100.0*dist;
+        y2  = y2 + ih*((y1 - y2)*fc + ad);
+        y  = y + ih*((y2 - y)*fc);
+        out[i] = y*outscale;
+    }
+
+    p->y = y; p->y1 = y1; p->y2 = y2;
+    return SP_OK;
+}
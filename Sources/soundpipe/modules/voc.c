@@ -597,6 +597,157 @@ static void tract_compute(sp_data *sp, tract *tr,
 
 
 
+/* One waveguide half-step, as in tract_compute() above, but with the
+ * reflection-coefficient smoothing folded into a single multiply-add per
+ * junction: the caller precomputes the per-block coefficient deltas once
+ * and passes them in, so the inner loops do no redundant interpolation
+ * arithmetic. Transient injection is handled by the caller. */
+static void tract_step(tract *tr, SPFLOAT in, SPFLOAT lambda,
+    const SPFLOAT *refl_diff,
+    SPFLOAT refl_left_diff,
+    SPFLOAT refl_right_diff,
+    SPFLOAT refl_nose_diff)
+{
+    SPFLOAT r, w;
+    int i;
+
+    tr->junction_outR[0] = tr->L[0] * tr->glottal_reflection + in;
+    tr->junction_outL[tr->n] = tr->R[tr->n - 1] * tr->lip_reflection;
+
+    for(i = 1; i < tr->n; i++) {
+        r = tr->reflection[i] + refl_diff[i] * lambda;
+        w = r * (tr->R[i - 1] + tr->L[i]);
+        tr->junction_outR[i] = tr->R[i - 1] - w;
+        tr->junction_outL[i] = tr->L[i] + w;
+    }
+
+    i = tr->nose_start;
+    r = tr->new_reflection_left + refl_left_diff * lambda;
+    tr->junction_outL[i] = r*tr->R[i-1] + (1+r)*(tr->noseL[0]+tr->L[i]);
+    r = tr->new_reflection_right + refl_right_diff * lambda;
+    tr->junction_outR[i] = r*tr->L[i] + (1+r)*(tr->R[i-1]+tr->noseL[0]);
+    r = tr->new_reflection_nose + refl_nose_diff * lambda;
+    tr->nose_junc_outR[0] = r * tr->noseL[0]+(1+r)*(tr->L[i]+tr->R[i-1]);
+
+    for(i = 0; i < tr->n; i++) {
+        tr->R[i] = tr->junction_outR[i]*0.999;
+        tr->L[i] = tr->junction_outL[i + 1]*0.999;
+    }
+    tr->lip_output = tr->R[tr->n - 1];
+
+    tr->nose_junc_outL[tr->nose_length] =
+        tr->noseR[tr->nose_length-1] * tr->lip_reflection;
+
+    for(i = 1; i < tr->nose_length; i++) {
+        w = tr->nose_reflection[i] * (tr->noseR[i-1] + tr->noseL[i]);
+        tr->nose_junc_outR[i] = tr->noseR[i - 1] - w;
+        tr->nose_junc_outL[i] = tr->noseL[i] + w;
+    }
+
+    for(i = 0; i < tr->nose_length; i++) {
+        tr->noseR[i] = tr->nose_junc_outR[i];
+        tr->noseL[i] = tr->nose_junc_outL[i + 1];
+    }
+    tr->nose_output = tr->noseR[tr->nose_length - 1];
+}
+
+
+/* Injects the active transients for one half-step. Amplitudes are
+ * advanced by a per-transient decay factor that voc_compute_block()
+ * computes once per block, replacing the pow() call tract_compute()
+ * makes for every transient on every half-step. */
+static void tract_step_transients(tract *tr,
+    SPFLOAT *amp_cache, const SPFLOAT *amp_decay)
+{
+    int i;
+    SPFLOAT amp;
+    int current_size;
+    transient_pool *pool;
+    transient *n;
+
+    pool = &tr->tpool;
+    current_size = pool->size;
+    n = pool->root;
+    for(i = 0; i < current_size; i++) {
+        amp = amp_cache[n->id];
+        tr->L[n->position] += amp * 0.5;
+        tr->R[n->position] += amp * 0.5;
+        amp_cache[n->id] = amp * amp_decay[n->id];
+        n->time_alive += tr->T * 0.5;
+        if(n->time_alive > n->lifetime) {
+            remove_transient(pool, n->id);
+        }
+        n = n->next;
+    }
+}
+
+
+/* Regenerates one 512-sample quantum into voc->buf. The tract geometry
+ * is reshaped and its reflections recomputed once per block (control
+ * rate), then the per-sample waveguide runs over the whole quantum with
+ * the per-block smoothing deltas precomputed. This computes the same
+ * thing as two tract_compute() half-steps per sample; the interpolation
+ * is algebraically identical but associates differently, so output
+ * matches the per-sample path to within float rounding. */
+static void voc_compute_block(sp_data *sp, sp_voc *voc)
+{
+    SPFLOAT refl_diff[45];
+    SPFLOAT amp_cache[MAX_TRANSIENTS];
+    SPFLOAT amp_decay[MAX_TRANSIENTS];
+    SPFLOAT refl_left_diff;
+    SPFLOAT refl_right_diff;
+    SPFLOAT refl_nose_diff;
+    SPFLOAT vocal_output, glot;
+    SPFLOAT lambda1, lambda2;
+    tract *tr;
+    transient *n;
+    int i;
+
+    tr = &voc->tr;
+    tract_reshape(tr);
+    tract_calculate_reflections(tr);
+
+    for(i = 1; i < tr->n; i++) {
+        refl_diff[i] = tr->new_reflection[i] - tr->reflection[i];
+    }
+
+    /* the three nose-junction coefficients smooth from new to old
+       (matching tract_compute), so their deltas run the other way */
+    refl_left_diff = tr->reflection_left - tr->new_reflection_left;
+    refl_right_diff = tr->reflection_right - tr->new_reflection_right;
+    refl_nose_diff = tr->reflection_nose - tr->new_reflection_nose;
+
+    n = tr->tpool.root;
+    for(i = 0; i < tr->tpool.size; i++) {
+        amp_cache[n->id] =
+            n->strength * pow(2, -1.0 * n->exponent * n->time_alive);
+        amp_decay[n->id] = pow(2, -0.5 * n->exponent * tr->T);
+        n = n->next;
+    }
+
+    for(i = 0; i < 512; i++) {
+        vocal_output = 0;
+        lambda1 = (SPFLOAT) i / 512;
+        lambda2 = (SPFLOAT) (i + 0.5) / 512;
+        glot = glottis_compute(sp, &voc->glot, lambda1);
+
+        tract_step_transients(tr, amp_cache, amp_decay);
+        tract_step(tr, glot, lambda1, refl_diff,
+            refl_left_diff, refl_right_diff, refl_nose_diff);
+        vocal_output += tr->lip_output + tr->nose_output;
+
+        tract_step_transients(tr, amp_cache, amp_decay);
+        tract_step(tr, glot, lambda2, refl_diff,
+            refl_left_diff, refl_right_diff, refl_nose_diff);
+        vocal_output += tr->lip_output + tr->nose_output;
+
+        voc->buf[i] = vocal_output * 0.125;
+    }
+}
+
+
+
+
 int sp_voc_create(sp_voc **voc)
 {
     *voc = malloc(sizeof(sp_voc));
@@ -622,28 +773,8 @@ int sp_voc_init(sp_data *sp, sp_voc *voc)
 
 int sp_voc_compute(sp_data *sp, sp_voc *voc, SPFLOAT *out)
 {
-    SPFLOAT vocal_output, glot;
-    SPFLOAT lambda1, lambda2;
-    int i;
-
-
-
     if(voc->counter == 0) {
-        tract_reshape(&voc->tr);
-        tract_calculate_reflections(&voc->tr);
-        for(i = 0; i < 512; i++) {
-            vocal_output = 0;
-            lambda1 = (SPFLOAT) i / 512;
-            lambda2 = (SPFLOAT) (i + 0.5) / 512;
-            glot = glottis_compute(sp, &voc->glot, lambda1);
-
-            tract_compute(sp, &voc->tr, glot, lambda1);
-            vocal_output += voc->tr.lip_output + voc->tr.nose_output;
-
-            tract_compute(sp, &voc->tr, glot, lambda2);
-            vocal_output += voc->tr.lip_output + voc->tr.nose_output;
-            voc->buf[i] = vocal_output * 0.125;
-        }
+        voc_compute_block(sp, voc);
     }
 
 
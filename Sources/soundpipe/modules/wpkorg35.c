@@ -137,3 +137,56 @@ int sp_wpkorg35_compute(sp_data *sp, sp_wpkorg35 *p, SPFLOAT *in, SPFLOAT *out)
     p->pres = p->res;
     return SP_OK;
 }
+
+int sp_wpkorg35_compute_block(sp_data *sp, sp_wpkorg35 *p, SPFLOAT *in, SPFLOAT *out, int n)
+{
+    if(p->pcutoff != p->cutoff || p->pres != p->res) update(sp, p);
+
+    /* coefficients and filter state in locals for the whole block */
+    SPFLOAT lpf1_a = p->lpf1_a, lpf2_a = p->lpf2_a, hpf_a = p->hpf_a;
+    SPFLOAT lpf2_b = p->lpf2_b, hpf_b = p->hpf_b;
+    SPFLOAT alpha = p->alpha, res = p->res, saturation = p->saturation;
+    SPFLOAT lpf1_z = p->lpf1_z, lpf2_z = p->lpf2_z, hpf_z = p->hpf_z;
+    SPFLOAT norm = res > 0 ? 1.0 / res : 1.0;
+    int i;
+
+    for(i = 0; i < n; i++) {
+        SPFLOAT y1, S35, u, y, vn;
+
+        /* process input through LPF1 */
+        vn = (in[i] - lpf1_z) * lpf1_a;
+        y1 = vn + lpf1_z;
+        lpf1_z = y1 + vn;
+
+        /* form feedback value */
+        S35 = (hpf_z * hpf_b) + (lpf2_z * lpf2_b);
+
+        /* Calculate u */
+        u = alpha * (y1 + S35);
+
+        /* Naive NLP */
+        if(saturation > 0) {
+            u = tanh(saturation * u);
+        }
+
+        /* Feed it to LPF2 */
+        vn = (u - lpf2_z) * lpf2_a;
+        y = (vn + lpf2_z);
+        lpf2_z = y + vn;
+        y *= res;
+
+        /* Feed y to HPF2 */
+        vn = (y - hpf_z) * hpf_a;
+        hpf_z = vn + (vn + hpf_z);
+
+        /* Auto-normalize */
+        out[i] = y * norm;
+    }
+
+    p->lpf1_z = lpf1_z;
+    p->lpf2_z = lpf2_z;
+    p->hpf_z = hpf_z;
+    p->pcutoff = p->cutoff;
+    p->pres = p->res;
+    return SP_OK;
+}
@@ -1060,3 +1060,17 @@ int sp_zitarev_compute(sp_data *sp, sp_zitarev *p, SPFLOAT *in1, SPFLOAT *in2, S
     computezitarev(dsp, 1, faust_in, faust_out);
     return SP_OK;
 }
+
+/* Block variant: the generated FAUST kernel already loops over a
+ * count, so handing it the whole quantum evaluates the ~90 slider
+ * coefficients (powf/expf/tanf) once per block instead of once per
+ * sample, and keeps the delay-line state hot across the loop. */
+int sp_zitarev_compute_block(sp_data *sp, sp_zitarev *p, SPFLOAT *in1,
+        SPFLOAT *in2, SPFLOAT *out1, SPFLOAT *out2, int nframes)
+{
+    zitarev *dsp = p->faust;
+    SPFLOAT *faust_out[] = {out1, out2};
+    SPFLOAT *faust_in[] = {in1, in2};
+    computezitarev(dsp, nframes, faust_in, faust_out);
+    return SP_OK;
+}
@@ -0,0 +1,207 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "plumber.h"
+
+/* Binary pre-parsed patch ("bpatch") format.
+ *
+ * A bpatch is the token stream of a parsed patch with every word
+ * already resolved to its flist index and every literal folded to a
+ * float, so loading it is a straight replay of the CREATE pass: no
+ * tokenizer, no lexer, no hash lookups.  The layout is:
+ *
+ *     "SPBP"          magic
+ *     uint32 version
+ *     uint32 nfunc    size of the ugen table the file was written with
+ *     uint32 nrecords
+ *
+ * followed by one record per token:
+ *
+ *     uint8 SPORTH_FLOAT   + 4-byte float
+ *     uint8 SPORTH_STRING  + uint32 length + bytes (no terminator)
+ *     uint8 SPORTH_FUNC    + uint32 flist index
+ *
+ * Indices are positions in the SPORTH_UGENS table, so a bpatch is only
+ * valid against the ugen table it was written with; nfunc is checked
+ * at load time to reject files from a mismatched build.  Values are
+ * stored in native byte order.
+ */
+
+#define BPATCH_VERSION 1
+
+static const char bpatch_magic[4] = {'S', 'P', 'B', 'P'};
+
+static int bpatch_write_u32(FILE *fp, uint32_t val)
+{
+    if(fwrite(&val, sizeof(uint32_t), 1, fp) != 1) return PLUMBER_NOTOK;
+    return PLUMBER_OK;
+}
+
+static int bpatch_read_u32(FILE *fp, uint32_t *val)
+{
+    if(fread(val, sizeof(uint32_t), 1, fp) != 1) return PLUMBER_NOTOK;
+    return PLUMBER_OK;
+}
+
+int plumbing_write_bpatch(plumber_data *plumb, plumbing *pipes, FILE *fp)
+{
+    uint32_t n;
+    uint8_t type;
+    uint32_t id;
+    uint32_t len;
+    float fval;
+    plumber_pipe *pipe;
+
+    if(fwrite(bpatch_magic, 1, 4, fp) != 4) return PLUMBER_NOTOK;
+    bpatch_write_u32(fp, BPATCH_VERSION);
+    bpatch_write_u32(fp, plumb->sporth.nfunc);
+    bpatch_write_u32(fp, pipes->npipes);
+
+    pipe = pipes->root.next;
+    for(n = 0; n < pipes->npipes; n++) {
+        switch(pipe->type) {
+            case SPORTH_FLOAT:
+                type = SPORTH_FLOAT;
+                fval = *(float *)pipe->ud;
+                fwrite(&type, 1, 1, fp);
+                fwrite(&fval, sizeof(float), 1, fp);
+                break;
+            case SPORTH_STRING:
+                type = SPORTH_STRING;
+                len = (uint32_t)strlen((char *)pipe->ud);
+                fwrite(&type, 1, 1, fp);
+                bpatch_write_u32(fp, len);
+                fwrite(pipe->ud, 1, len, fp);
+                break;
+            default:
+                type = SPORTH_FUNC;
+                id = pipe->type - SPORTH_FOFFSET;
+                fwrite(&type, 1, 1, fp);
+                bpatch_write_u32(fp, id);
+                break;
+        }
+        pipe = pipe->next;
+    }
+
+    return PLUMBER_OK;
+}
+
+int plumber_write_bpatch(plumber_data *plumb, FILE *fp)
+{
+    return plumbing_write_bpatch(plumb, plumb->pipes, fp);
+}
+
+int plumbing_read_bpatch(plumber_data *plumb, plumbing *pipes, FILE *fp)
+{
+    char magic[4];
+    uint8_t type;
+    uint32_t version, nfunc, nrecords;
+    uint32_t n, id, len;
+    float fval;
+    char *str, *tmp;
+    int rc;
+    sporth_data *sporth = &plumb->sporth;
+    int err = PLUMBER_OK;
+
+    /* save top level tmp variable, as the parser does */
+    plumbing *top_tmp = plumb->tmp;
+
+    if(fread(magic, 1, 4, fp) != 4 ||
+            memcmp(magic, bpatch_magic, 4) != 0) {
+        plumber_print(plumb, "bpatch: not a bpatch file.\n");
+        return PLUMBER_NOTOK;
+    }
+    if(bpatch_read_u32(fp, &version) != PLUMBER_OK ||
+            version != BPATCH_VERSION) {
+        plumber_print(plumb, "bpatch: unknown version.\n");
+        return PLUMBER_NOTOK;
+    }
+    if(bpatch_read_u32(fp, &nfunc) != PLUMBER_OK ||
+            nfunc != sporth->nfunc) {
+        plumber_print(plumb,
+                "bpatch: written against a different ugen table.\n");
+        return PLUMBER_NOTOK;
+    }
+    if(bpatch_read_u32(fp, &nrecords) != PLUMBER_OK) return PLUMBER_NOTOK;
+
+    plumb->mode = PLUMBER_CREATE;
+    plumb->tmp = pipes;
+
+    for(n = 0; n < nrecords && err == PLUMBER_OK; n++) {
+        if(fread(&type, 1, 1, fp) != 1) {
+            err = PLUMBER_NOTOK;
+            break;
+        }
+        switch(type) {
+            case SPORTH_FLOAT:
+                if(fread(&fval, sizeof(float), 1, fp) != 1) {
+                    err = PLUMBER_NOTOK;
+                    break;
+                }
+                plumber_add_float(plumb, pipes, fval);
+                sporth_stack_push_float(&sporth->stack, fval);
+                break;
+            case SPORTH_STRING:
+                if(bpatch_read_u32(fp, &len) != PLUMBER_OK) {
+                    err = PLUMBER_NOTOK;
+                    break;
+                }
+                str = malloc(len + 1);
+                if(str == NULL) {
+                    err = PLUMBER_NOTOK;
+                    break;
+                }
+                if(fread(str, 1, len, fp) != len) {
+                    free(str);
+                    err = PLUMBER_NOTOK;
+                    break;
+                }
+                str[len] = '\0';
+                tmp = plumber_add_string(plumb, pipes, str);
+                sporth_stack_push_string(&sporth->stack, &tmp);
+                free(str);
+                break;
+            case SPORTH_FUNC:
+                if(bpatch_read_u32(fp, &id) != PLUMBER_OK ||
+                        id >= sporth->nfunc) {
+                    err = PLUMBER_NOTOK;
+                    break;
+                }
+                rc = sporth->flist[id].func(&sporth->stack,
+                        sporth->flist[id].ud);
+                if(rc == PLUMBER_NOTOK || rc == SPORTH_NOTOK) {
+                    plumber_print(plumb, "bpatch: %s returned an error.\n",
+                            sporth->flist[id].name);
+                    sporth->stack.error++;
+                    err = PLUMBER_NOTOK;
+                }
+                break;
+            default:
+                plumber_print(plumb, "bpatch: unknown record type %d.\n",
+                        type);
+                err = PLUMBER_NOTOK;
+                break;
+        }
+    }
+
+    /* restore tmp */
+    plumb->tmp = top_tmp;
+    return err;
+}
+
+int plumber_parse_bpatch(plumber_data *plumb, const char *filename)
+{
+    FILE *fp;
+    int err;
+
+    fp = fopen(filename, "rb");
+    if(fp == NULL) {
+        plumber_print(plumb,
+                "There was a problem opening the file %s\n", filename);
+        return PLUMBER_NOTOK;
+    }
+    err = plumbing_read_bpatch(plumb, plumb->pipes, fp);
+    fclose(fp);
+    return err;
+}
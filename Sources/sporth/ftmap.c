@@ -56,6 +56,30 @@ int plumber_ftmap_search(plumber_data *plumb, const char *str, sp_ftbl **ft)
     }
 }
 
+int plumber_ftmap_search_index(plumber_data *plumb, const char *str, uint32_t *index)
+{
+    plumber_ftbl *ftbl;
+    if(plumber_search(plumb, str, &ftbl) != PLUMBER_OK) {
+        return PLUMBER_NOTOK;
+    } else if(ftbl->type != PTYPE_TABLE) {
+        plumber_print(plumb, "Error: value '%s' is not of type ftable\n", str);
+        return PLUMBER_NOTOK;
+    } else {
+        *index = ftbl->id;
+        return PLUMBER_OK;
+    }
+}
+
+int plumber_ftmap_index_search(plumber_data *plumb, uint32_t index, sp_ftbl **ft)
+{
+    plumber_ftbl *ftbl;
+    if(index >= plumb->nftref) return PLUMBER_NOTOK;
+    ftbl = plumb->ftref[index];
+    if(ftbl == NULL || ftbl->type != PTYPE_TABLE) return PLUMBER_NOTOK;
+    *ft = (sp_ftbl *)ftbl->ud;
+    return PLUMBER_OK;
+}
+
 int plumber_ftmap_search_userdata(plumber_data *plumb, const char *str, void **ud)
 {
     plumber_ftbl *ftbl;
@@ -100,6 +124,13 @@ int plumber_ftmap_destroy(plumber_data *plumb)
         ftbl = plumb->ftmap[pos].root.next;
         for(n = 0; n < plumb->ftmap[pos].nftbl; n++) {
             next = ftbl->next;
+            /* retire the registry slot; during a live reload only the old
+             * map's entries point back at their slots, so entries from the
+             * freshly parsed map keep their ids */
+            if(plumb->ftref != NULL && ftbl->id < plumb->nftref &&
+                plumb->ftref[ftbl->id] == ftbl) {
+                plumb->ftref[ftbl->id] = NULL;
+            }
             free(ftbl->name);
             if(ftbl->to_delete) {
                 if(ftbl->type == PTYPE_TABLE)
@@ -45,6 +45,9 @@ typedef struct plumber_ftbl {
     char *name;
     char to_delete;
     char type;
+    /* stable small-integer id assigned at add time, indexing into the
+     * plumber_data ftref registry */
+    uint32_t id;
     struct plumber_ftbl *next;
 } plumber_ftbl;
 
@@ -66,11 +69,41 @@ typedef struct {
     void *ud;
 } sporth_func_d;
 
+/* Maximum number of stack outputs a control-rate ugen may have for
+ * its values to be held across a control block. */
+#define PLUMBER_KRATE_MAXOUT 4
+
+/* One record of a compiled pipeline: a float push (fun == NULL) or a
+ * ugen call with its function pointer and userdata already resolved.
+ * The float is kept by pointer because the ref mechanism can rewrite
+ * a float pipe's value between samples.  Ugens flagged control-rate
+ * run only on control-block boundaries; in between, their stack
+ * arity is replayed with the held output values. */
+typedef struct {
+    plumber_func fun;
+    void *ud;
+    float *fval;
+    plumber_pipe *pipe;
+    plumber_pipe *next;
+    int nin;
+    int nout;
+    int krate;
+    float held[PLUMBER_KRATE_MAXOUT];
+} plumber_op;
+
 typedef struct {
     uint32_t npipes;
     int tick;
     plumber_pipe root;
     plumber_pipe *last;
+    /* compiled form of the pipe list, used for PLUMBER_COMPUTE */
+    plumber_op *ops;
+    uint32_t nops;
+    int compiled;
+    /* set when the op list's stack-depth profile was proven in bounds
+     * at compile time; the compute pass then runs the stack with the
+     * unchecked push/pop fast paths (see sporth_stack.verified) */
+    int verified;
 } plumbing;
 
 typedef struct plumber_data {
@@ -93,12 +126,28 @@ typedef struct plumber_data {
     plumber_ftentry *ftnew, *ftold;
     char delete_ft;
 
+    /* compile-phase table registry: every named entry gets a stable
+     * small-integer id so ugens can re-resolve tables in O(1) at init
+     * time; the hash is only needed for first binding and late-bound
+     * names */
+    plumber_ftbl **ftref;
+    uint32_t nftref;
+    uint32_t ftref_size;
+
     SPFLOAT p[16];
     void *ud;
     plumber_pipe *next;
     plumber_pipe *last;
     sp_progress *prog;
     int showprog;
+    /* control-rate execution: flagged ugens run once every
+     * control_block compute passes and hold their outputs between */
+    uint32_t control_block;
+    uint32_t control_counter;
+    unsigned char *control_flags;
+    uint32_t ncontrol_flags;
+    /* lanes per stack slot for the vector stack mode (1 = scalar) */
+    int vector_width;
     int recompile;
     char *str;
 
@@ -137,6 +186,19 @@ typedef struct {
 
 int plumber_init(plumber_data *plumb);
 int plumber_register(plumber_data *plumb);
+
+/* Set the control block size in samples (default 1 = every sample). */
+void plumber_set_control_block(plumber_data *plumb, uint32_t nframes);
+
+/* Flag the named ugen as control-rate (or clear the flag).  Flagged
+ * ugens are evaluated once per control block and their outputs held,
+ * sample-and-hold style, for the rest of the block. */
+int plumber_set_control_rate(plumber_data *plumb, const char *name, int control);
+
+/* Opt in to the vector stack mode: each compute pass advances width
+ * samples at once through the element-wise math ugens.  Read results
+ * with sporth_stack_pop_vector instead of pop_float. */
+void plumber_set_vector_width(plumber_data *plumb, int width);
 int plumber_clean(plumber_data *plumb);
 
 int plumber_add_float(plumber_data *plumb, plumbing *pipes, float num);
@@ -174,6 +236,8 @@ int plumber_ftmap_add_userdata(plumber_data *plumb, const char *str, void *ud);
 int plumber_ftmap_add_function(plumber_data *plumb,
         const char *str, plumber_dyn_func f, void *ud);
 int plumber_ftmap_search(plumber_data *plumb, const char *str, sp_ftbl **ft);
+int plumber_ftmap_search_index(plumber_data *plumb, const char *str, uint32_t *index);
+int plumber_ftmap_index_search(plumber_data *plumb, uint32_t index, sp_ftbl **ft);
 int plumber_ftmap_search_userdata(plumber_data *plumb, const char *str, void **ud);
 int plumber_ftmap_destroy(plumber_data *plumb);
 int plumber_ftmap_delete(plumber_data *plumb, char mode);
@@ -196,6 +260,13 @@ int plumbing_parse_string(plumber_data *plumb, plumbing *pipes, const char *str)
 void plumbing_show_pipes(plumber_data *plumb, plumbing *pipes);
 void plumbing_write_code(plumber_data *plumb, plumbing *pipes, FILE *fp);
 void plumber_write_code(plumber_data *plumb, FILE *fp);
+
+/* binary pre-parsed patches: the token stream with words resolved to
+ * flist indices, replayed at load time without the string machinery */
+int plumbing_write_bpatch(plumber_data *plumb, plumbing *pipes, FILE *fp);
+int plumber_write_bpatch(plumber_data *plumb, FILE *fp);
+int plumbing_read_bpatch(plumber_data *plumb, plumbing *pipes, FILE *fp);
+int plumber_parse_bpatch(plumber_data *plumb, const char *filename);
 int plumber_process_null(sp_data *sp, void *ud, void (*callback)(sp_data *, void *));
 
 int plumber_create_var(plumber_data *pd, const char *name, SPFLOAT **var);
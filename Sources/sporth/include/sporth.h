@@ -20,9 +20,12 @@ SPORTH_WORD
 #define SPORTH_FOFFSET 2
 #define SPORTH_MAXCHAR 200
 #define SPORTH_STACK_SIZE 32
+#define SPORTH_VECTOR_WIDTH 8
 
 typedef struct {
     float fval;
+    /* lanes for the vector stack mode; vval[0] mirrors fval */
+    float vval[SPORTH_VECTOR_WIDTH];
     char *sval;
     int type;
 } sporth_stack_val;
@@ -30,6 +33,13 @@ typedef struct {
 typedef struct {
     int pos;
     uint32_t error;
+    /* number of active lanes per float slot, 1 = scalar (default) */
+    int vecwidth;
+    /* set while a compute pass whose stack effects were proven at
+     * compile time is running (see plumbing_compile); push/pop take
+     * their unchecked fast paths, skipping the error, bounds, and
+     * type tests */
+    int verified;
     sporth_stack_val stack[SPORTH_STACK_SIZE];
 } sporth_stack;
 
@@ -73,6 +83,18 @@ int sporth_stack_push_float(sporth_stack *stack, float val);
 int sporth_stack_push_string(sporth_stack *stack, char **str);
 float sporth_stack_pop_float(sporth_stack *stack);
 const char * sporth_stack_pop_string(sporth_stack *stack);
+
+/* vector stack mode: float slots carry vecwidth lanes and the math
+ * ugens apply their operation to every lane */
+void sporth_stack_set_vector_width(sporth_stack *stack, int width);
+int sporth_stack_push_vector(sporth_stack *stack, const float *lanes);
+float * sporth_stack_pop_vector(sporth_stack *stack);
+int sporth_stack_map1(sporth_stack *stack, float (*op)(float));
+int sporth_stack_map2(sporth_stack *stack, float (*op)(float, float));
+int sporth_stack_dup(sporth_stack *stack);
+int sporth_stack_dup2(sporth_stack *stack);
+int sporth_stack_swap(sporth_stack *stack);
+int sporth_stack_rot(sporth_stack *stack);
 int sporth_check_args(sporth_stack *stack, const char *args);
 int sporth_register_func(sporth_data *sporth, sporth_func *flist);
 int sporth_exec(sporth_data *sporth, const char *keyword);
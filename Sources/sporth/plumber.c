@@ -14,6 +14,20 @@
 SPORTH_UGENS
 #undef SPORTH_UGEN
 
+/* Stack arity of each ugen, taken from the same table that builds
+ * the function list in plumber_register().  Indexed like flist. */
+typedef struct {
+    unsigned char nin;
+    unsigned char nout;
+} plumber_arity;
+
+#define SPORTH_UGEN(key, func, macro, ninputs, noutputs) {ninputs, noutputs},
+static const plumber_arity plumber_arities[] = {
+SPORTH_UGENS
+    {0, 0}
+};
+#undef SPORTH_UGEN
+
 #ifdef BUILD_JACK
 int sp_process_jack(plumber_data *pd,
         void *ud, void (*callback)(sp_data *, void *), int port, int wait);
@@ -33,6 +47,119 @@ int plumbing_init(plumbing *pipes)
     pipes->tick = 1;
     pipes->last = &pipes->root;
     pipes->npipes = 0;
+    pipes->ops = NULL;
+    pipes->nops = 0;
+    pipes->compiled = 0;
+    pipes->verified = 0;
+    return PLUMBER_OK;
+}
+
+/* Flatten the pipe list into a contiguous array of records with the
+ * ugen function pointers and userdata resolved up front, so the
+ * per-sample compute pass is a tight loop over the array instead of a
+ * pointer chase with a type switch and flist lookup per pipe.
+ * Strings are a no-op during computation and are dropped here.  On
+ * allocation failure the interpreted walk is used as before. */
+static int plumbing_compile(plumber_data *plumb, plumbing *pipes)
+{
+    uint32_t n, nops;
+    plumber_op *ops;
+    plumber_pipe *pipe;
+    /* parse-time type stack: 1 marks a string slot.  A ugen's declared
+     * arity counts its string arguments, but those are consumed at init
+     * and never reappear during computation, so each op's nin is
+     * adjusted down to its compute-time float arity here. */
+    unsigned char tstack[SPORTH_STACK_SIZE];
+    int tdepth = 0;
+    int tvalid = 1;
+
+    free(pipes->ops);
+    pipes->ops = NULL;
+    pipes->nops = 0;
+
+    if(pipes->npipes > 0) {
+        ops = malloc(sizeof(plumber_op) * pipes->npipes);
+        if(ops == NULL) return PLUMBER_NOTOK;
+
+        nops = 0;
+        pipe = pipes->root.next;
+        for(n = 0; n < pipes->npipes; n++) {
+            switch(pipe->type) {
+                case SPORTH_FLOAT:
+                    ops[nops].fun = NULL;
+                    ops[nops].ud = NULL;
+                    ops[nops].fval = pipe->ud;
+                    ops[nops].pipe = pipe;
+                    ops[nops].next = pipe->next;
+                    ops[nops].nin = 0;
+                    ops[nops].nout = 1;
+                    ops[nops].krate = 0;
+                    nops++;
+                    if(tdepth < SPORTH_STACK_SIZE) tstack[tdepth++] = 0;
+                    else tvalid = 0;
+                    break;
+                case SPORTH_STRING:
+                    if(tdepth < SPORTH_STACK_SIZE) tstack[tdepth++] = 1;
+                    else tvalid = 0;
+                    break;
+                default: {
+                    uint32_t id = pipe->type - SPORTH_FOFFSET;
+                    int nin = plumber_arities[id].nin;
+                    int nout = plumber_arities[id].nout;
+                    ops[nops].fun = plumb->sporth.flist[id].func;
+                    ops[nops].ud = plumb->sporth.flist[id].ud;
+                    ops[nops].fval = NULL;
+                    ops[nops].pipe = pipe;
+                    ops[nops].next = pipe->next;
+                    if(tvalid && tdepth >= nin) {
+                        int i;
+                        int nstr = 0;
+                        for(i = 0; i < nin; i++)
+                            if(tstack[--tdepth]) nstr++;
+                        /* compute-time arity: string args are gone */
+                        nin -= nstr;
+                        for(i = 0; i < nout; i++) {
+                            if(tdepth < SPORTH_STACK_SIZE) tstack[tdepth++] = 0;
+                            else tvalid = 0;
+                        }
+                    } else {
+                        tvalid = 0;
+                    }
+                    ops[nops].nin = nin;
+                    ops[nops].nout = nout;
+                    ops[nops].krate = (id < plumb->ncontrol_flags &&
+                                       plumb->control_flags[id] &&
+                                       plumber_arities[id].nout <=
+                                           PLUMBER_KRATE_MAXOUT);
+                    memset(ops[nops].held, 0, sizeof(ops[nops].held));
+                    nops++;
+                    break;
+                }
+            }
+            pipe = pipe->next;
+        }
+        pipes->ops = ops;
+        pipes->nops = nops;
+    }
+    pipes->compiled = 1;
+
+    /* Stack-effect verification: a patch's depth profile is fully
+     * determined by the op list, so prove the bounds once here and let
+     * the compute pass run the stack unchecked.  A patch whose type
+     * simulation failed, or that would underflow or overflow, leaves
+     * verified off and keeps the per-op checks to report the error as
+     * before. */
+    {
+        int depth = 0;
+        int ok = tvalid;
+        plumber_op *op = pipes->ops;
+        for(n = 0; ok && n < pipes->nops; n++, op++) {
+            if(depth < op->nin) { ok = 0; break; }
+            depth += op->nout - op->nin;
+            if(depth > SPORTH_STACK_SIZE) { ok = 0; break; }
+        }
+        pipes->verified = ok;
+    }
     return PLUMBER_OK;
 }
 
@@ -48,12 +175,20 @@ int plumber_init(plumber_data *plumb)
     sporth_stack_init(&plumb->sporth.stack);
     plumber_ftmap_delete(plumb, 1);
     plumber_ftmap_init(plumb);
+    plumb->ftref = NULL;
+    plumb->nftref = 0;
+    plumb->ftref_size = 0;
     plumb->seed = (int) time(NULL);
     plumb->fp = NULL;
     plumb->recompile = 0;
     int pos;
     for(pos = 0; pos < 16; pos++) plumb->p[pos] = 0;
     plumb->showprog = 0;
+    plumb->control_block = 1;
+    plumb->control_counter = 0;
+    plumb->control_flags = NULL;
+    plumb->ncontrol_flags = 0;
+    plumb->vector_width = 1;
     plumb->log = stderr;
     return PLUMBER_OK;
 }
@@ -79,6 +214,52 @@ int plumbing_compute(plumber_data *plumb, plumbing *pipes, int mode)
     if(mode == PLUMBER_DESTROY) {
         sporth_stack_init(&plumb->sporth.stack);
     }
+
+    if(mode == PLUMBER_COMPUTE) {
+        if(!pipes->compiled) plumbing_compile(plumb, pipes);
+        if(pipes->compiled) {
+            int kboundary = (plumb->control_counter == 0);
+            plumber_op *op = pipes->ops;
+            /* bounds proven at compile time: run the stack unchecked
+             * for the duration of this pass */
+            sporth->stack.verified = pipes->verified;
+            for(n = 0; n < pipes->nops; n++, op++) {
+                plumb->next = op->next;
+                if(op->fun != NULL) {
+                    int i;
+                    if(op->krate && !kboundary) {
+                        /* replay the ugen's stack arity with the
+                         * outputs held from the block boundary */
+                        for(i = 0; i < op->nin; i++)
+                            sporth_stack_pop_float(&sporth->stack);
+                        for(i = 0; i < op->nout; i++)
+                            sporth_stack_push_float(&sporth->stack,
+                                                    op->held[i]);
+                        continue;
+                    }
+                    plumb->last = op->pipe;
+                    op->fun(&sporth->stack, op->ud);
+                    if(op->krate && op->nout > 0 &&
+                       sporth->stack.error == 0 &&
+                       sporth->stack.pos >= op->nout) {
+                        for(i = 0; i < op->nout; i++)
+                            op->held[i] =
+                                sporth->stack
+                                    .stack[sporth->stack.pos - op->nout + i]
+                                    .fval;
+                    }
+                } else {
+                    sporth_stack_push_float(&sporth->stack, *op->fval);
+                }
+            }
+            sporth->stack.verified = 0;
+            plumb->pipes = prev;
+            plumb->next = top_next;
+            plumb->tmp = tmp;
+            return PLUMBER_OK;
+        }
+    }
+
     for(n = 0; n < pipes->npipes; n++) {
         plumb->next = pipe->next;
         switch(pipe->type) {
@@ -111,7 +292,56 @@ int plumbing_compute(plumber_data *plumb, plumbing *pipes, int mode)
 
 int plumber_compute(plumber_data *plumb, int mode)
 {
+    /* reapply the width here since stack_init resets it on swaps */
+    if(mode == PLUMBER_COMPUTE)
+        plumb->sporth.stack.vecwidth = plumb->vector_width;
     plumbing_compute(plumb, plumb->pipes, mode);
+    if(mode == PLUMBER_COMPUTE) {
+        plumb->control_counter++;
+        if(plumb->control_counter >= plumb->control_block)
+            plumb->control_counter = 0;
+    }
+    return PLUMBER_OK;
+}
+
+void plumber_set_vector_width(plumber_data *plumb, int width)
+{
+    if(width < 1) width = 1;
+    if(width > SPORTH_VECTOR_WIDTH) width = SPORTH_VECTOR_WIDTH;
+    plumb->vector_width = width;
+    sporth_stack_set_vector_width(&plumb->sporth.stack, width);
+}
+
+void plumber_set_control_block(plumber_data *plumb, uint32_t nframes)
+{
+    if(nframes < 1) nframes = 1;
+    plumb->control_block = nframes;
+    plumb->control_counter = 0;
+}
+
+int plumber_set_control_rate(plumber_data *plumb, const char *name, int control)
+{
+    uint32_t id;
+
+    if(sporth_search(&plumb->sporth.dict, name, &id) != SPORTH_OK) {
+        plumber_print(plumb,
+                      "plumber_set_control_rate: could not find ugen %s\n",
+                      name);
+        return PLUMBER_NOTOK;
+    }
+
+    if(plumb->control_flags == NULL) {
+        uint32_t nfunc = 0;
+        while(plumb->sporth.flist[nfunc].name != NULL) nfunc++;
+        plumb->control_flags = calloc(1, nfunc);
+        if(plumb->control_flags == NULL) return PLUMBER_NOTOK;
+        plumb->ncontrol_flags = nfunc;
+    }
+    if(id >= plumb->ncontrol_flags) return PLUMBER_NOTOK;
+    plumb->control_flags[id] = control ? 1 : 0;
+
+    /* recompile so the flag takes effect */
+    plumb->pipes->compiled = 0;
     return PLUMBER_OK;
 }
 
@@ -199,6 +429,12 @@ int plumbing_destroy(plumbing *pipes)
         free(pipe);
         pipe = next;
     }
+
+    free(pipes->ops);
+    pipes->ops = NULL;
+    pipes->nops = 0;
+    pipes->compiled = 0;
+    pipes->verified = 0;
     return PLUMBER_OK;
 }
 
@@ -208,8 +444,15 @@ int plumber_clean(plumber_data *plumb)
     sporth_htable_destroy(&plumb->sporth.dict);
     plumbing_destroy(plumb->pipes);
     plumber_ftmap_destroy(plumb);
+    free(plumb->ftref);
+    plumb->ftref = NULL;
+    plumb->nftref = 0;
+    plumb->ftref_size = 0;
     if(plumb->fp != NULL) fclose(plumb->fp);
     free(plumb->sporth.flist);
+    free(plumb->control_flags);
+    plumb->control_flags = NULL;
+    plumb->ncontrol_flags = 0;
     return PLUMBER_OK;
 }
 
@@ -218,6 +461,8 @@ int plumbing_add_pipe(plumbing *pipes, plumber_pipe *pipe)
     pipes->last->next = pipe;
     pipes->last = pipe;
     pipes->npipes++;
+    /* the compiled form is stale until the next compute pass */
+    pipes->compiled = 0;
     return PLUMBER_OK;
 }
 
@@ -379,6 +624,17 @@ int plumber_add(plumber_data *plumb, const char *str, plumber_ftbl **ft)
     entry->last->next = new;
     entry->last = new;
 
+    /* hand the entry a stable id and park it in the registry, so words
+     * can re-resolve it by index instead of rehashing the name */
+    new->id = plumb->nftref;
+    if(plumb->nftref >= plumb->ftref_size) {
+        plumb->ftref_size = (plumb->ftref_size == 0) ? 64 : plumb->ftref_size * 2;
+        plumb->ftref = realloc(plumb->ftref,
+                sizeof(plumber_ftbl *) * plumb->ftref_size);
+    }
+    plumb->ftref[plumb->nftref] = new;
+    plumb->nftref++;
+
     *ft = new;
     return PLUMBER_OK;
 }
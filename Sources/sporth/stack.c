@@ -29,12 +29,31 @@ static void print_guts(sporth_stack *stack)
 
 int sporth_stack_push_float(sporth_stack *stack, float val)
 {
+    if(stack->verified) {
+        /* bounds proven at compile time (see plumbing_compile) */
+        sporth_stack_val *pstack = &stack->stack[stack->pos++];
+        pstack->fval = val;
+        pstack->type = SPORTH_FLOAT;
+        if(stack->vecwidth > 1) {
+            int i;
+            for(i = 0; i < stack->vecwidth; i++) pstack->vval[i] = val;
+        }
+        return SPORTH_OK;
+    }
+
     if(stack->error > 0) return SPORTH_NOTOK;
 
     if(stack->pos < SPORTH_STACK_SIZE) {
         stack->pos++;
         stack->stack[stack->pos - 1].fval = val;
         stack->stack[stack->pos - 1].type = SPORTH_FLOAT;
+        if(stack->vecwidth > 1) {
+            /* a scalar entering the vector stack is constant per lane */
+            int i;
+            for(i = 0; i < stack->vecwidth; i++) {
+                stack->stack[stack->pos - 1].vval[i] = val;
+            }
+        }
         return SPORTH_OK;
     } else {
         fprintf(stderr, "Stack limit of %d reached, cannot push float value.\n", stack->pos);
@@ -72,6 +91,8 @@ int sporth_stack_push_string(sporth_stack *stack, char **str)
 
 float sporth_stack_pop_float(sporth_stack *stack)
 {
+    if(stack->verified) return stack->stack[--stack->pos].fval;
+
     if(stack->error > 0) return 0;
 
     sporth_stack_val *pstack;
@@ -127,5 +148,222 @@ int sporth_stack_init(sporth_stack *stack)
 {
     stack->pos = 0;
     stack->error = 0;
+    stack->vecwidth = 1;
+    stack->verified = 0;
+    return SPORTH_OK;
+}
+
+void sporth_stack_set_vector_width(sporth_stack *stack, int width)
+{
+    if(width < 1) width = 1;
+    if(width > SPORTH_VECTOR_WIDTH) width = SPORTH_VECTOR_WIDTH;
+    stack->vecwidth = width;
+}
+
+int sporth_stack_push_vector(sporth_stack *stack, const float *lanes)
+{
+    int i;
+    sporth_stack_val *pstack;
+
+    if(sporth_stack_push_float(stack, lanes[0]) != SPORTH_OK)
+        return SPORTH_NOTOK;
+
+    pstack = &stack->stack[stack->pos - 1];
+    for(i = 0; i < stack->vecwidth; i++) pstack->vval[i] = lanes[i];
+    return SPORTH_OK;
+}
+
+/* Pops a float slot and returns its lanes.  The pointer is into the
+ * stack itself, so it is only valid until the next push. */
+float * sporth_stack_pop_vector(sporth_stack *stack)
+{
+    sporth_stack_val *pstack;
+
+    if(stack->verified) return stack->stack[--stack->pos].vval;
+
+    if(stack->error > 0) return NULL;
+
+    if(stack->pos == 0) {
+        fprintf(stderr, "Stack is empty.\n");
+        stack->error++;
+        return NULL;
+    }
+    pstack = &stack->stack[stack->pos - 1];
+
+    if(pstack->type != SPORTH_FLOAT) {
+        fprintf(stderr, "Value is not a float.\n");
+        stack->error++;
+        return NULL;
+    }
+
+    stack->pos--;
+    return pstack->vval;
+}
+
+/* Applies op to the top float slot in place, element-wise across the
+ * lanes when the vector mode is on.  The math ugens route their
+ * COMPUTE pass through these so a single dispatch covers the whole
+ * vector. */
+int sporth_stack_map1(sporth_stack *stack, float (*op)(float))
+{
+    int i;
+    sporth_stack_val *pstack;
+
+    if(!stack->verified) {
+        if(stack->error > 0) return SPORTH_NOTOK;
+
+        if(stack->pos == 0) {
+            fprintf(stderr, "Stack is empty.\n");
+            stack->error++;
+            return SPORTH_NOTOK;
+        }
+        pstack = &stack->stack[stack->pos - 1];
+
+        if(pstack->type != SPORTH_FLOAT) {
+            fprintf(stderr, "Value is not a float.\n");
+            stack->error++;
+            return SPORTH_NOTOK;
+        }
+    }
+    pstack = &stack->stack[stack->pos - 1];
+
+    if(stack->vecwidth > 1) {
+        for(i = 0; i < stack->vecwidth; i++) {
+            pstack->vval[i] = op(pstack->vval[i]);
+        }
+        pstack->fval = pstack->vval[0];
+    } else {
+        pstack->fval = op(pstack->fval);
+    }
+    return SPORTH_OK;
+}
+
+/* Pops the top float slot and combines it into the one below it:
+ * op(deeper, top).  Same lane behavior as sporth_stack_map1. */
+int sporth_stack_map2(sporth_stack *stack, float (*op)(float, float))
+{
+    int i;
+    sporth_stack_val *v1, *v2;
+
+    if(!stack->verified) {
+        if(stack->error > 0) return SPORTH_NOTOK;
+
+        if(stack->pos < 2) {
+            fprintf(stderr, "Stack is empty.\n");
+            stack->error++;
+            return SPORTH_NOTOK;
+        }
+        v1 = &stack->stack[stack->pos - 1];
+        v2 = &stack->stack[stack->pos - 2];
+
+        if(v1->type != SPORTH_FLOAT || v2->type != SPORTH_FLOAT) {
+            fprintf(stderr, "Value is not a float.\n");
+            stack->error++;
+            return SPORTH_NOTOK;
+        }
+    }
+    v1 = &stack->stack[stack->pos - 1];
+    v2 = &stack->stack[stack->pos - 2];
+
+    if(stack->vecwidth > 1) {
+        for(i = 0; i < stack->vecwidth; i++) {
+            v2->vval[i] = op(v2->vval[i], v1->vval[i]);
+        }
+        v2->fval = v2->vval[0];
+    } else {
+        v2->fval = op(v2->fval, v1->fval);
+    }
+    stack->pos--;
+    return SPORTH_OK;
+}
+
+/* Whole-slot stack shuffles.  Unlike a pop/push pair these keep the
+ * lanes intact, so the stack ugens use them in vector mode. */
+int sporth_stack_dup(sporth_stack *stack)
+{
+    if(!stack->verified) {
+        if(stack->error > 0) return SPORTH_NOTOK;
+
+        if(stack->pos == 0) {
+            fprintf(stderr, "Stack is empty.\n");
+            stack->error++;
+            return SPORTH_NOTOK;
+        }
+        if(stack->pos >= SPORTH_STACK_SIZE) {
+            fprintf(stderr, "Stack limit of %d reached, cannot dup.\n", stack->pos);
+            stack->error++;
+            return SPORTH_NOTOK;
+        }
+    }
+    stack->stack[stack->pos] = stack->stack[stack->pos - 1];
+    stack->pos++;
+    return SPORTH_OK;
+}
+
+int sporth_stack_dup2(sporth_stack *stack)
+{
+    sporth_stack_val v1, v2;
+
+    if(!stack->verified) {
+        if(stack->error > 0) return SPORTH_NOTOK;
+
+        if(stack->pos < 2) {
+            fprintf(stderr, "Stack is empty.\n");
+            stack->error++;
+            return SPORTH_NOTOK;
+        }
+        if(stack->pos + 2 > SPORTH_STACK_SIZE) {
+            fprintf(stderr, "Stack limit of %d reached, cannot dup2.\n", stack->pos);
+            stack->error++;
+            return SPORTH_NOTOK;
+        }
+    }
+    /* same slot order as the scalar pop/push sequence in sporth_dup2 */
+    v1 = stack->stack[stack->pos - 1];
+    v2 = stack->stack[stack->pos - 2];
+    stack->stack[stack->pos - 2] = v1;
+    stack->stack[stack->pos - 1] = v2;
+    stack->stack[stack->pos] = v1;
+    stack->stack[stack->pos + 1] = v2;
+    stack->pos += 2;
+    return SPORTH_OK;
+}
+
+int sporth_stack_swap(sporth_stack *stack)
+{
+    sporth_stack_val tmp;
+
+    if(!stack->verified) {
+        if(stack->error > 0) return SPORTH_NOTOK;
+
+        if(stack->pos < 2) {
+            fprintf(stderr, "Stack is empty.\n");
+            stack->error++;
+            return SPORTH_NOTOK;
+        }
+    }
+    tmp = stack->stack[stack->pos - 1];
+    stack->stack[stack->pos - 1] = stack->stack[stack->pos - 2];
+    stack->stack[stack->pos - 2] = tmp;
+    return SPORTH_OK;
+}
+
+int sporth_stack_rot(sporth_stack *stack)
+{
+    sporth_stack_val tmp;
+
+    if(!stack->verified) {
+        if(stack->error > 0) return SPORTH_NOTOK;
+
+        if(stack->pos < 3) {
+            fprintf(stderr, "Stack is empty.\n");
+            stack->error++;
+            return SPORTH_NOTOK;
+        }
+    }
+    tmp = stack->stack[stack->pos - 3];
+    stack->stack[stack->pos - 3] = stack->stack[stack->pos - 2];
+    stack->stack[stack->pos - 2] = stack->stack[stack->pos - 1];
+    stack->stack[stack->pos - 1] = tmp;
     return SPORTH_OK;
 }
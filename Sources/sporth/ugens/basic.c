@@ -47,6 +47,27 @@ static SPFLOAT sproundf(SPFLOAT x)
 	return y;
 }
 
+/* element-wise kernels for the vector stack mode, applied across the
+ * lanes by sporth_stack_map1/map2 in the COMPUTE pass */
+static float kern_add(float a, float b) { return a + b; }
+static float kern_mul(float a, float b) { return a * b; }
+static float kern_sub(float a, float b) { return a - b; }
+static float kern_div(float a, float b) { return a / b; }
+static float kern_max(float a, float b) { return a > b ? a : b; }
+static float kern_min(float a, float b) { return a < b ? a : b; }
+static float kern_eq(float a, float b) { return a == b ? 1 : 0; }
+static float kern_lt(float a, float b) { return a < b ? 1 : 0; }
+static float kern_gt(float a, float b) { return a > b ? 1 : 0; }
+static float kern_ne(float a, float b) { return a != b ? 1 : 0; }
+static float kern_abs(float a) { return (float)fabs(a); }
+static float kern_floor(float a) { return (float)floor(a); }
+static float kern_frac(float a) { return (float)(a - floor(a)); }
+static float kern_log(float a) { return (float)log(a); }
+static float kern_log10(float a) { return (float)log10(a); }
+static float kern_round(float a) { return sproundf(a); }
+static float kern_sqrt(float a) { return (float)sqrt(a); }
+static float kern_mtof(float a) { return sp_midi2cps(a); }
+
 int sporth_mix(sporth_stack *stack, void *ud)
 {
     plumber_data *pd = ud;
@@ -77,6 +98,18 @@ int sporth_mix(sporth_stack *stack, void *ud)
         case PLUMBER_COMPUTE:
             count = stack->pos;
             if(count > 1) {
+                if(stack->vecwidth > 1) {
+                    int i;
+                    for(n = 1; n < count; n++) {
+                        for(i = 0; i < stack->vecwidth; i++) {
+                            stack->stack[0].vval[i] +=
+                                stack->stack[n].vval[i];
+                        }
+                    }
+                    stack->stack[0].fval = stack->stack[0].vval[0];
+                    stack->pos = 1;
+                    break;
+                }
                 for(n = 1; n <= count; n++){
                     val = sporth_stack_pop_float(stack);
                     sum += val;
@@ -148,6 +181,10 @@ int sporth_rot(sporth_stack *stack, void *ud)
 
             break;
         case PLUMBER_COMPUTE:
+            if(stack->vecwidth > 1) {
+                sporth_stack_rot(stack);
+                break;
+            }
             v1 = sporth_stack_pop_float(stack);
             v2 = sporth_stack_pop_float(stack);
             v3 = sporth_stack_pop_float(stack);
@@ -186,6 +223,10 @@ int sporth_dup(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, val);
             break;
         case PLUMBER_COMPUTE:
+            if(stack->vecwidth > 1) {
+                sporth_stack_dup(stack);
+                break;
+            }
             val = sporth_stack_pop_float(stack);
             sporth_stack_push_float(stack, val);
             sporth_stack_push_float(stack, val);
@@ -226,6 +267,10 @@ int sporth_dup2(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, val2);
             break;
         case PLUMBER_COMPUTE:
+            if(stack->vecwidth > 1) {
+                sporth_stack_dup2(stack);
+                break;
+            }
             val1 = sporth_stack_pop_float(stack);
             val2 = sporth_stack_pop_float(stack);
             sporth_stack_push_float(stack, val1);
@@ -261,6 +306,10 @@ int sporth_swap(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0);
             break;
         case PLUMBER_COMPUTE:
+            if(stack->vecwidth > 1) {
+                sporth_stack_swap(stack);
+                break;
+            }
             v1 = sporth_stack_pop_float(stack);
             v2 = sporth_stack_pop_float(stack);
             sporth_stack_push_float(stack, v1);
@@ -294,7 +343,7 @@ int sporth_sine(sporth_stack *stack, void *ud)
 #endif
             data = malloc(sizeof(sporth_sine_d));
             sp_osc_create(&data->osc);
-            sp_ftbl_create(pd->sp, &data->ft, 8192);
+            sp_ftbl_cache_get(pd->sp, &data->ft, 8192, "sine", sp_gen_sine);
             plumber_add_ugen(pd, SPORTH_SINE, data);
             if(sporth_check_args(stack, "ff") != SPORTH_OK) {
                 plumber_print(pd, "returning error SPORTH_NOTOK\n");
@@ -312,7 +361,6 @@ int sporth_sine(sporth_stack *stack, void *ud)
             amp = sporth_stack_pop_float(stack);
             freq = sporth_stack_pop_float(stack);
             data = pd->last->ud;
-            sp_gen_sine(pd->sp, data->ft);
             sp_osc_init(pd->sp, data->osc, data->ft, 0);
             sporth_stack_push_float(stack, 0);
             break;
@@ -368,9 +416,7 @@ int sporth_add(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, v1 + v2);
             break;
         case PLUMBER_COMPUTE:
-            v1 = sporth_stack_pop_float(stack);
-            v2 = sporth_stack_pop_float(stack);
-            sporth_stack_push_float(stack, v1 + v2);
+            sporth_stack_map2(stack, kern_add);
             break;
         case PLUMBER_DESTROY:
             break;
@@ -406,12 +452,7 @@ int sporth_mul(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, (SPFLOAT) v1 * v2);
             break;
         case PLUMBER_COMPUTE:
-            if(sporth_check_args(stack, "ff") != SPORTH_OK) {
-                return PLUMBER_NOTOK;
-            }
-            v1 = sporth_stack_pop_float(stack);
-            v2 = sporth_stack_pop_float(stack);
-            sporth_stack_push_float(stack, (SPFLOAT) v1 * v2);
+            sporth_stack_map2(stack, kern_mul);
             break;
         case PLUMBER_DESTROY:
             break;
@@ -447,9 +488,7 @@ int sporth_sub(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, v2 - v1);
             break;
         case PLUMBER_COMPUTE:
-            v1 = sporth_stack_pop_float(stack);
-            v2 = sporth_stack_pop_float(stack);
-            sporth_stack_push_float(stack, v2 - v1);
+            sporth_stack_map2(stack, kern_sub);
             break;
         case PLUMBER_DESTROY:
             break;
@@ -485,9 +524,7 @@ int sporth_divide(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, (SPFLOAT) v2 / v1);
             break;
         case PLUMBER_COMPUTE:
-            v1 = sporth_stack_pop_float(stack);
-            v2 = sporth_stack_pop_float(stack);
-            sporth_stack_push_float(stack, (SPFLOAT) v2 / v1);
+            sporth_stack_map2(stack, kern_div);
             break;
         case PLUMBER_DESTROY:
             break;
@@ -523,9 +560,7 @@ int sporth_max(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, (SPFLOAT) v2 > v1 ? v2 : v1);
             break;
         case PLUMBER_COMPUTE:
-            v1 = sporth_stack_pop_float(stack);
-            v2 = sporth_stack_pop_float(stack);
-            sporth_stack_push_float(stack, (SPFLOAT)  v2 > v1 ? v2 : v1);
+            sporth_stack_map2(stack, kern_max);
             break;
         case PLUMBER_DESTROY:
             break;
@@ -559,9 +594,7 @@ int sporth_min(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, (SPFLOAT) v2 > v1 ? v1 : v2);
             break;
         case PLUMBER_COMPUTE:
-            v1 = sporth_stack_pop_float(stack);
-            v2 = sporth_stack_pop_float(stack);
-            sporth_stack_push_float(stack, (SPFLOAT)  v2 > v1 ? v1 : v2);
+            sporth_stack_map2(stack, kern_min);
             break;
         case PLUMBER_DESTROY:
             break;
@@ -595,8 +628,7 @@ int sporth_abs(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, (SPFLOAT)fabs(val));
             break;
         case PLUMBER_COMPUTE:
-            val = sporth_stack_pop_float(stack);
-            sporth_stack_push_float(stack, (SPFLOAT)fabs(val));
+            sporth_stack_map1(stack, kern_abs);
             break;
         case PLUMBER_DESTROY:
             break;
@@ -630,8 +662,7 @@ int sporth_floor(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, (SPFLOAT)floor(val));
             break;
         case PLUMBER_COMPUTE:
-            val = sporth_stack_pop_float(stack);
-            sporth_stack_push_float(stack, (SPFLOAT)floor(val));
+            sporth_stack_map1(stack, kern_floor);
             break;
         case PLUMBER_DESTROY:
             break;
@@ -665,11 +696,7 @@ int sporth_frac(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, (SPFLOAT)(val - floor(val)));
             break;
         case PLUMBER_COMPUTE:
-            if(sporth_check_args(stack, "f") != SPORTH_OK) {
-                return PLUMBER_NOTOK;
-            }
-            val = sporth_stack_pop_float(stack);
-            sporth_stack_push_float(stack, (SPFLOAT)(val - floor(val)));
+            sporth_stack_map1(stack, kern_frac);
             break;
         case PLUMBER_DESTROY:
             break;
@@ -703,8 +730,7 @@ int sporth_log(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, (SPFLOAT)log(val));
             break;
         case PLUMBER_COMPUTE:
-            val = sporth_stack_pop_float(stack);
-            sporth_stack_push_float(stack, (SPFLOAT)log(val));
+            sporth_stack_map1(stack, kern_log);
             break;
         case PLUMBER_DESTROY:
             break;
@@ -738,8 +764,7 @@ int sporth_log10(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, (SPFLOAT)log10(val));
             break;
         case PLUMBER_COMPUTE:
-            val = sporth_stack_pop_float(stack);
-            sporth_stack_push_float(stack, (SPFLOAT)log10(val));
+            sporth_stack_map1(stack, kern_log10);
             break;
         case PLUMBER_DESTROY:
             break;
@@ -774,8 +799,7 @@ int sporth_round(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, (SPFLOAT)sproundf(val));
             break;
         case PLUMBER_COMPUTE:
-            val = sporth_stack_pop_float(stack);
-            sporth_stack_push_float(stack, (SPFLOAT)sproundf(val));
+            sporth_stack_map1(stack, kern_round);
             break;
         case PLUMBER_DESTROY:
             break;
@@ -809,11 +833,7 @@ int sporth_mtof(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, sp_midi2cps(nn));
             break;
         case PLUMBER_COMPUTE:
-            if(sporth_check_args(stack, "f") != SPORTH_OK) {
-                return PLUMBER_NOTOK;
-            }
-            nn = sporth_stack_pop_float(stack);
-            sporth_stack_push_float(stack, sp_midi2cps(nn));
+            sporth_stack_map1(stack, kern_mtof);
             break;
         case PLUMBER_DESTROY:
             break;
@@ -856,9 +876,7 @@ int sporth_eq(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0.0);
             break;
         case PLUMBER_COMPUTE:
-            v1 = sporth_stack_pop_float(stack);
-            v2 = sporth_stack_pop_float(stack);
-            sporth_stack_push_float(stack, (v2 == v1 ? 1 : 0));
+            sporth_stack_map2(stack, kern_eq);
             break;
         case PLUMBER_DESTROY:
             break;
@@ -901,9 +919,7 @@ int sporth_lt(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0.0);
             break;
         case PLUMBER_COMPUTE:
-            v1 = sporth_stack_pop_float(stack);
-            v2 = sporth_stack_pop_float(stack);
-            sporth_stack_push_float(stack, (v2 < v1 ? 1 : 0));
+            sporth_stack_map2(stack, kern_lt);
             break;
         case PLUMBER_DESTROY:
             break;
@@ -946,9 +962,7 @@ int sporth_gt(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0.0);
             break;
         case PLUMBER_COMPUTE:
-            v1 = sporth_stack_pop_float(stack);
-            v2 = sporth_stack_pop_float(stack);
-            sporth_stack_push_float(stack, (v2 > v1 ? 1 : 0));
+            sporth_stack_map2(stack, kern_gt);
             break;
         case PLUMBER_DESTROY:
             break;
@@ -991,9 +1005,7 @@ int sporth_ne(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, 0.0);
             break;
         case PLUMBER_COMPUTE:
-            v1 = sporth_stack_pop_float(stack);
-            v2 = sporth_stack_pop_float(stack);
-            sporth_stack_push_float(stack, (v2 != v1 ? 1 : 0));
+            sporth_stack_map2(stack, kern_ne);
             break;
         case PLUMBER_DESTROY:
             break;
@@ -1436,8 +1448,7 @@ int sporth_sqrt(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, (SPFLOAT)sqrt(val));
             break;
         case PLUMBER_COMPUTE:
-            val = sporth_stack_pop_float(stack);
-            sporth_stack_push_float(stack, sqrt(val));
+            sporth_stack_map1(stack, kern_sqrt);
             break;
         case PLUMBER_DESTROY:
             break;
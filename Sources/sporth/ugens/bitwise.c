@@ -2,6 +2,15 @@
 
 #include "plumber.h"
 
+/* element-wise kernels for the vector stack mode, applied across the
+ * lanes by sporth_stack_map2 in the COMPUTE pass */
+static float kern_and(float a, float b) { return (float)((uint32_t)a & (uint32_t)b); }
+static float kern_or(float a, float b) { return (float)((uint32_t)a | (uint32_t)b); }
+static float kern_xor(float a, float b) { return (float)((uint32_t)a ^ (uint32_t)b); }
+static float kern_lshift(float a, float b) { return (float)((uint32_t)a << (uint32_t)b); }
+static float kern_rshift(float a, float b) { return (float)((uint32_t)a >> (uint32_t)b); }
+static float kern_mod(float a, float b) { return (float)((uint32_t)a % (uint32_t)b); }
+
 int sporth_and(sporth_stack *stack, void *ud)
 {
     plumber_data *pd = ud;
@@ -23,9 +32,7 @@ int sporth_and(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, v1 & v2);
             break;
         case PLUMBER_COMPUTE:
-            v2 = sporth_stack_pop_float(stack);
-            v1 = sporth_stack_pop_float(stack);
-            sporth_stack_push_float(stack, v1 & v2);
+            sporth_stack_map2(stack, kern_and);
             break;
         case PLUMBER_DESTROY:
             break;
@@ -57,9 +64,7 @@ int sporth_or(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, v1 | v2);
             break;
         case PLUMBER_COMPUTE:
-            v2 = sporth_stack_pop_float(stack);
-            v1 = sporth_stack_pop_float(stack);
-            sporth_stack_push_float(stack, v1 | v2);
+            sporth_stack_map2(stack, kern_or);
             break;
         case PLUMBER_DESTROY:
             break;
@@ -91,9 +96,7 @@ int sporth_leftshift(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, v1 << v2);
             break;
         case PLUMBER_COMPUTE:
-            v2 = sporth_stack_pop_float(stack);
-            v1 = sporth_stack_pop_float(stack);
-            sporth_stack_push_float(stack, v1 << v2);
+            sporth_stack_map2(stack, kern_lshift);
             break;
         case PLUMBER_DESTROY:
             break;
@@ -125,9 +128,7 @@ int sporth_rightshift(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, v1 >> v2);
             break;
         case PLUMBER_COMPUTE:
-            v2 = sporth_stack_pop_float(stack);
-            v1 = sporth_stack_pop_float(stack);
-            sporth_stack_push_float(stack, v1 >> v2);
+            sporth_stack_map2(stack, kern_rshift);
             break;
         case PLUMBER_DESTROY:
             break;
@@ -159,9 +160,7 @@ int sporth_xor(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, v1 ^ v2);
             break;
         case PLUMBER_COMPUTE:
-            v2 = sporth_stack_pop_float(stack);
-            v1 = sporth_stack_pop_float(stack);
-            sporth_stack_push_float(stack, v1 ^ v2);
+            sporth_stack_map2(stack, kern_xor);
             break;
         case PLUMBER_DESTROY:
             break;
@@ -193,9 +192,7 @@ int sporth_mod(sporth_stack *stack, void *ud)
             sporth_stack_push_float(stack, v1 % v2);
             break;
         case PLUMBER_COMPUTE:
-            v2 = sporth_stack_pop_float(stack);
-            v1 = sporth_stack_pop_float(stack);
-            sporth_stack_push_float(stack, v1 % v2);
+            sporth_stack_map2(stack, kern_mod);
             break;
         case PLUMBER_DESTROY:
             break;
@@ -22,7 +22,7 @@ int sporth_fm(sporth_stack *stack, void *ud)
            plumber_print(pd,"creating FM function... \n");
 #endif
             fm = malloc(sizeof(sporth_fm_d));
-            sp_ftbl_create(pd->sp, &fm->ft, 8192);
+            sp_ftbl_cache_get(pd->sp, &fm->ft, 8192, "sine", sp_gen_sine);
             sp_fosc_create(&fm->osc);
             plumber_add_ugen(pd, SPORTH_FM, fm);
             if(sporth_check_args(stack, "fffff") != SPORTH_OK) {
@@ -47,7 +47,6 @@ int sporth_fm(sporth_stack *stack, void *ud)
             amp = sporth_stack_pop_float(stack);
             freq = sporth_stack_pop_float(stack);
 
-            sp_gen_sine(pd->sp, fm->ft);
             sp_fosc_init(pd->sp, fm->osc, fm->ft);
             sporth_stack_push_float(stack, 0.0);
             break;
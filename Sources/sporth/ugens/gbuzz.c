@@ -25,7 +25,7 @@ int sporth_gbuzz(sporth_stack *stack, void *ud)
             plumber_print(pd, "gbuzz: Creating\n");
 #endif
             gbuzz = malloc(sizeof(sporth_gbuzz_d));
-            sp_ftbl_create(pd->sp, &gbuzz->ft, 8192);
+            sp_ftbl_cache_get(pd->sp, &gbuzz->ft, 8192, "sine", sp_gen_sine);
             sp_gbuzz_create(&gbuzz->gbuzz);
             plumber_add_ugen(pd, SPORTH_GBUZZ, gbuzz);
             if(sporth_check_args(stack, "fffff") != SPORTH_OK) {
@@ -53,7 +53,6 @@ int sporth_gbuzz(sporth_stack *stack, void *ud)
             freq = sporth_stack_pop_float(stack);
 
             gbuzz = pd->last->ud;
-            sp_gen_sine(pd->sp, gbuzz->ft);
             sp_gbuzz_init(pd->sp, gbuzz->gbuzz, gbuzz->ft, 0.25);
             sporth_stack_push_float(stack, 0);
             break;
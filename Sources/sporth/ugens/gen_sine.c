@@ -24,8 +24,7 @@ int sporth_gen_sine(sporth_stack *stack, void *ud)
 #ifdef DEBUG_MODE
             plumber_print(pd, "Creating sine table %s of size %d\n", str, size);
 #endif
-            sp_ftbl_create(pd->sp, &ft, size);
-            sp_gen_sine(pd->sp, ft);
+            sp_ftbl_cache_get(pd->sp, &ft, size, "sine", sp_gen_sine);
             plumber_ftmap_add(pd, str, ft);
             break;
 
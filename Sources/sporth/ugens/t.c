@@ -9,6 +9,9 @@ typedef struct {
     sp_ftbl *ft;
     SPFLOAT val;
     unsigned int index;
+    /* registry id resolved at parse time, used to refresh the table
+     * pointer in O(1) on re-init */
+    uint32_t tblidx;
 } sporth_tbl_d;
 
 int sporth_tget(sporth_stack *stack, void *ud)
@@ -33,6 +36,7 @@ int sporth_tget(sporth_stack *stack, void *ud)
                 stack->error++;
                 return PLUMBER_NOTOK;
             }
+            plumber_ftmap_search_index(pd, ftname, &td->tblidx);
             sporth_stack_push_float(stack, td->ft->tbl[td->index]);
             break;
 
@@ -40,6 +44,14 @@ int sporth_tget(sporth_stack *stack, void *ud)
             td = pd->last->ud;
             ftname = sporth_stack_pop_string(stack);
             td->index = floor(sporth_stack_pop_float(stack));
+            /* refresh the table pointer by registry index; the hash lookup
+             * only runs for names bound after parse time */
+            if(plumber_ftmap_index_search(pd, td->tblidx, &td->ft) != PLUMBER_OK &&
+                plumber_ftmap_search(pd, ftname, &td->ft) == PLUMBER_NOTOK) {
+                plumber_print(pd, "tget: could not find table '%s'\n", ftname);
+                stack->error++;
+                return PLUMBER_NOTOK;
+            }
             sporth_stack_push_float(stack, td->ft->tbl[td->index]);
             break;
 
@@ -84,6 +96,7 @@ int sporth_tset(sporth_stack *stack, void *ud)
                 stack->error++;
                 return PLUMBER_NOTOK;
             }
+            plumber_ftmap_search_index(pd, ftname, &td->tblidx);
             td->ft->tbl[td->index] = td->val;
             break;
 
@@ -92,6 +105,12 @@ int sporth_tset(sporth_stack *stack, void *ud)
             ftname = sporth_stack_pop_string(stack);
             td->index = floor(sporth_stack_pop_float(stack));
             td->val = sporth_stack_pop_float(stack);
+            if(plumber_ftmap_index_search(pd, td->tblidx, &td->ft) != PLUMBER_OK &&
+                plumber_ftmap_search(pd, ftname, &td->ft) == PLUMBER_NOTOK) {
+                plumber_print(pd, "tset: could not find table '%s'\n", ftname);
+                stack->error++;
+                return PLUMBER_NOTOK;
+            }
             td->ft->tbl[td->index] = td->val;
             break;
 
@@ -25,28 +25,28 @@ let validatedMD5s: [String: String] = [
     "-[AudioPlayerTests testLoop]": "f0a73fe1aca7479cba6a777373ff90a3",
     "-[AudioPlayerTests testScheduleFile]": "7238ac02ab6a53f570fe304e76fcff5e",
     "-[AudioPlayerTests testVolume]": "5924bc88c255b36e4ccd63f2efd93078",
-    "-[AutoPannerTests testDefault]": "52b115ac04406e28eb16b77248db7235",
-    "-[AutoPannerTests testDepth]": "ab17fe93f3dd2c4b80e628fda12adb56",
-    "-[AutoPannerTests testFrequency]": "b2707a5a0d833dadca0e25f71c3244e3",
-    "-[AutoPannerTests testParameters]": "13d57bfee643b5acb94850da9d37adf0",
-    "-[AutoWahOperationTests testAmplitude]": "f0a49149e16c4951e9be1b32559d879f",
+    "-[AutoPannerTests testDefault]": "977989d43e1edf3877b1bec7394de543",
+    "-[AutoPannerTests testDepth]": "e11ae79f1b6abb6011c71e6f48b881aa",
+    "-[AutoPannerTests testFrequency]": "4baab4dfd68ae8a59cbaad8b5c8aa9bb",
+    "-[AutoPannerTests testParameters]": "025a1d586ee94b855f8653332061c78c",
+    "-[AutoWahOperationTests testAmplitude]": "9a14492859cb39c355b53fa128e88978",
     "-[AutoWahOperationTests testDefault]": "33ac3730e0c99c68bd9df591bb7c6fc7",
-    "-[AutoWahOperationTests testWah]": "78d1404745a844950dc905c097e75c19",
-    "-[AutoWahTests testAmplitude]": "9b24dc7b0c2a1aaa87f7ce6d061f9da3",
+    "-[AutoWahOperationTests testWah]": "4c088cbb56d5b8b75769fff1cee088d3",
+    "-[AutoWahTests testAmplitude]": "5ef1c6084b1e6f0fb3d2d6efb0b732f4",
     "-[AutoWahTests testBypass]": "f4cc261bdf98ae17320f9561941c8664",
-    "-[AutoWahTests testDefault]": "f4cc261bdf98ae17320f9561941c8664",
-    "-[AutoWahTests testMix]": "8321d947f2f35ad18769c353e303e28c",
-    "-[AutoWahTests testParamters]": "84694271628d94b1488b4487f868da5f",
-    "-[AutoWahTests testWah]": "66ac186b270539dcd1f0f83441f2221b",
-    "-[BalancerTests testDefault]": "0f3dd22d7b6d06fa668ccc43e1144648",
-    "-[BandPassButterworthFilterTests testBandwidth]": "c8020933fb8ce38109cd07f820955e10",
-    "-[BandPassButterworthFilterTests testCenterFrequency]": "999e59dd6c9404dd6988713ddabd1023",
-    "-[BandPassButterworthFilterTests testDefault]": "ed21ec24dc2d48f1f0ab8813fb11ff16",
-    "-[BandPassButterworthFilterTests testParameters]": "d7c3dcb43fca8705fecd0329fb4779ab",
-    "-[BandRejectButterworthFilterTests testBandwidth]": "63d4e3208a3f0b923ea9f31d9b27af40",
-    "-[BandRejectButterworthFilterTests testCenterFrequency]": "79044de981ae85796b15732beff3e199",
-    "-[BandRejectButterworthFilterTests testDefault]": "826f0b6a8ee57d46c1d5605c85dc0ff4",
-    "-[BandRejectButterworthFilterTests testParameters]": "0516e6a95f7fdfee7a85ce09095d20c9",
+    "-[AutoWahTests testDefault]": "355a0168ee609de0ab5b728626daf23c",
+    "-[AutoWahTests testMix]": "fe1370fa14576db91a9a7c6d2df8f97b",
+    "-[AutoWahTests testParamters]": "b6a3b4639351252aa7df5436b04477fb",
+    "-[AutoWahTests testWah]": "81de3b44e80fcda45db268230b9fda57",
+    "-[BalancerTests testDefault]": "8bd4e3f50179e9451895ab0497c4bf18",
+    "-[BandPassButterworthFilterTests testBandwidth]": "1bb6764edaf48a944dc427a4b400494b",
+    "-[BandPassButterworthFilterTests testCenterFrequency]": "7f68e5a32640a649ce1dd256a6b7fcc8",
+    "-[BandPassButterworthFilterTests testDefault]": "355442df8d9adc9be59aa4e5e17ab71e",
+    "-[BandPassButterworthFilterTests testParameters]": "fdd3d0ad45263a286b9c0d4ca0e18352",
+    "-[BandRejectButterworthFilterTests testBandwidth]": "c5319195242f66d7056122e6f8c4ca2f",
+    "-[BandRejectButterworthFilterTests testCenterFrequency]": "91c5f032734a74e95505186cd4f72af9",
+    "-[BandRejectButterworthFilterTests testDefault]": "6887a798616dba983cd485a27f61b580",
+    "-[BandRejectButterworthFilterTests testParameters]": "03a295c4a7beaeb3e9d0d739b13c7ece",
     "-[BitCrusherTests testBitDepth]": "cbea9ac22fb7368651860a1200714cfa",
     "-[BitCrusherTests testBypass]": "f4cc261bdf98ae17320f9561941c8664",
     "-[BitCrusherTests testDefault]": "268e98a3153e3dd66b205f1a2b8dc76c",
@@ -142,12 +142,12 @@ let validatedMD5s: [String: String] = [
     "-[DynamicOscillatorTests testSetWavetable]": "b8a90867e0736e04de7dd6e4794ec494",
     "-[DynamicOscillatorTests testGetWavetableValues]": "33fc3ddee3e17226ddfc976f080b7e00",
     "-[DynamicOscillatorTests testWavetableUpdateHandler]": "33fc3ddee3e17226ddfc976f080b7e00",
-    "-[DynamicRangeCompressorTests testAttackDuration]": "61f5b1d44ffe85a5fb99e35097f3c16d",
+    "-[DynamicRangeCompressorTests testAttackDuration]": "efd1a7f549aaf1ac70ce2f3bdf2d62fb",
     "-[DynamicRangeCompressorTests testDefault]": "33ac3730e0c99c68bd9df591bb7c6fc7",
-    "-[DynamicRangeCompressorTests testParameters]": "cc9af37b165e789e38c8ac2bf0e95efc",
-    "-[DynamicRangeCompressorTests testRatio]": "b54b39c39cdee9d763a70d8d320790b2",
-    "-[DynamicRangeCompressorTests testReleaseDuration]": "69cfe49af5f722eeaf9a6a451a96f1af",
-    "-[DynamicRangeCompressorTests testThreshold]": "93f389a2cba5bf504ecd10a72e4ca2f6",
+    "-[DynamicRangeCompressorTests testParameters]": "42165750129034edb37d6de2435e89c8",
+    "-[DynamicRangeCompressorTests testRatio]": "6e3f380fd83e16ffaf6fdf8cfad5f61b",
+    "-[DynamicRangeCompressorTests testReleaseDuration]": "de506974612c7609d167799c2796e72a",
+    "-[DynamicRangeCompressorTests testThreshold]": "c26e02fe71a0c7731f6916b957f70082",
     "-[DynamicsProcessorTests testDefault]": "70fa0fb4d94ccb4a36fdd55be270d0e8",
     "-[DynaRangeCompressorTests testAttackTime]": "bf83e4a23c448338f5769dbd9f978474",
     "-[DynaRangeCompressorTests testDefault]": "bf83e4a23c448338f5769dbd9f978474",
@@ -196,8 +196,8 @@ let validatedMD5s: [String: String] = [
     "-[FormantFilterTests testDecay]": "24e70d91132540d3d9b2935d3521811d",
     "-[FormantFilterTests testDefault]": "e1357a42f7cb8e4ff646e877acca3ba6",
     "-[HighPassButterworthFilterOperationTests testDefault]": "5a0e078f1fe8036e808ee73d851ca170",
-    "-[HighPassButterworthFilterTests testCutoffFrequency]": "20d808447412fdc505e3dfe636e528af",
-    "-[HighPassButterworthFilterTests testDefault]": "a68fb26d0930ed57a8a3f1472008f58e",
+    "-[HighPassButterworthFilterTests testCutoffFrequency]": "d4eadf27144dd1717dbd4db10758b599",
+    "-[HighPassButterworthFilterTests testDefault]": "151ec43c61a24f89a2fe25654bfc0319",
     "-[HighPassFilterOperationTests testDefault]": "9a96736bfd8f7e2f3ec0800115d7a258",
     "-[HighPassFilterOperationTests testHalfPowerPoint]": "e2d18c533d3f4937a5b0bd358079b4a7",
     "-[HighPassFilterTests testCutoffFrequency]": "dba8d067e68ebb18faf4f833373cb93d",
@@ -207,21 +207,21 @@ let validatedMD5s: [String: String] = [
     "-[HighShelfFilterTests testDefault]": "f4cc261bdf98ae17320f9561941c8664",
     "-[HighShelfFilterTests testGain]": "7ad69bf803f231c834def47bf29b95c8",
     "-[HighShelfFilterTests testParameters]": "7ad69bf803f231c834def47bf29b95c8",
-    "-[HighShelfParametricEqualizerFilterTests testCenterFrequency]": "23e528f0b56e06178bca66611a07ecbd",
-    "-[HighShelfParametricEqualizerFilterTests testDefault]": "978ef1e8665ecb723453b055e3ef9b79",
-    "-[HighShelfParametricEqualizerFilterTests testGain]": "fe1407e5df8f740d0871eedbbb6d6a5e",
-    "-[HighShelfParametricEqualizerFilterTests testParameters]": "057e788e8b0ce372c666a1b9bab1f113",
-    "-[HighShelfParametricEqualizerFilterTests testQ]": "200b4f988edfefb7b2b0f0d8d06dccb0",
+    "-[HighShelfParametricEqualizerFilterTests testCenterFrequency]": "b6597e4fc0e68bf776ed0efe898b26ca",
+    "-[HighShelfParametricEqualizerFilterTests testDefault]": "f8c0dadc1929bc1d8aa3f803f36e576a",
+    "-[HighShelfParametricEqualizerFilterTests testGain]": "d1e1610384bb24be2a62c2bc235edd0d",
+    "-[HighShelfParametricEqualizerFilterTests testParameters]": "24c51c44c61fac4504867173a04f7924",
+    "-[HighShelfParametricEqualizerFilterTests testQ]": "45c64ba6471c95e41db03f7fa8a327ae",
     "-[KorgLowPassFilterOperationTests testDefault]": "0b457dcabd0e31347fd3b3f86b0878e4",
     "-[KorgLowPassFilterOperationTests testParameters]": "66c51d0f77be384aa2cf0bcc403f15ae",
-    "-[KorgLowPassFilterTests testCutoffFrequency]": "35a3e4c6214be98e8b3315686b0a518b",
-    "-[KorgLowPassFilterTests testDefault]": "2bd39ed0ef73a9e45d1f918ac609e224",
-    "-[KorgLowPassFilterTests testParameters]": "5a4d635931d298f5452ff397b1bd6a5c",
-    "-[KorgLowPassFilterTests testResonance]": "c1a1e4cd3ffbaa208bda57360c50fd10",
-    "-[KorgLowPassFilterTests testSaturation]": "b2119a3c9e4664e121a0d9b4e853dc25",
+    "-[KorgLowPassFilterTests testCutoffFrequency]": "47d37cbb13daa0f2b6d87d792e28a725",
+    "-[KorgLowPassFilterTests testDefault]": "e6d03d3e3df8fd14542bd3a52438d6ac",
+    "-[KorgLowPassFilterTests testParameters]": "4a24ceae83a88aceca8a6526d2e5c9d6",
+    "-[KorgLowPassFilterTests testResonance]": "96acb68f8a12ecac84abd62f961e48da",
+    "-[KorgLowPassFilterTests testSaturation]": "89a2cbad303e318aba2cab060dcb0033",
     "-[LowPassButterworthFilterOperationTests testDefault]": "4030ec731d5fe48b70b01a58808a05d1",
-    "-[LowPassButterworthFilterTests testCutoffFrequency]": "6f170f3d0fc4a4af364d3c92d24b3e4a",
-    "-[LowPassButterworthFilterTests testDefault]": "675717ba46eaa9b9765346fbd40a96b3",
+    "-[LowPassButterworthFilterTests testCutoffFrequency]": "be040440c0a8ab80e81ed6a130bbbdb0",
+    "-[LowPassButterworthFilterTests testDefault]": "d54f8ad340c47f55501a11e33a1f9612",
     "-[LowPassFilterOperationTests testDefault]": "70e0c5bc8a067fe4ecd49ce0c2ace742",
     "-[LowPassFilterTests testCutoffFrequency]": "17fb6b6d8947a90c7eab1bdb621de7ee",
     "-[LowPassFilterTests testDefault]": "9b155606de91f1eaeac7a2da84c8d38b",
@@ -230,11 +230,11 @@ let validatedMD5s: [String: String] = [
     "-[LowShelfFilterTests testCutoffFrequency]": "f36df45579f098037fdddc70f0e134c3",
     "-[LowShelfFilterTests testDefault]": "f4cc261bdf98ae17320f9561941c8664",
     "-[LowShelfFilterTests testGain]": "bfa4e3792af93d6b2590bc9e4427923d",
-    "-[LowShelfParametricEqualizerFilterTests testCornerFrequency]": "808a05bf546aaac339c6cc9b1fd10048",
-    "-[LowShelfParametricEqualizerFilterTests testDefault]": "0fb8a302c8537666afb94fd45092fba2",
-    "-[LowShelfParametricEqualizerFilterTests testGain]": "35adf0bd9267475e0badda3a73cdcb48",
-    "-[LowShelfParametricEqualizerFilterTests testParameters]": "9adf94b42512d16651da25e6405cb201",
-    "-[LowShelfParametricEqualizerFilterTests testQ]": "ef3c06536583bee2c4ab77cec1ff8ba2",
+    "-[LowShelfParametricEqualizerFilterTests testCornerFrequency]": "4229ba6cbb5077fe94a6dddded3037d1",
+    "-[LowShelfParametricEqualizerFilterTests testDefault]": "a587625d62eb9931af8d9b5668e9d029",
+    "-[LowShelfParametricEqualizerFilterTests testGain]": "e05fa9ce864a1b1821c6e12b41631713",
+    "-[LowShelfParametricEqualizerFilterTests testParameters]": "5318f72a06dbf44db3fc37e0cc37cd55",
+    "-[LowShelfParametricEqualizerFilterTests testQ]": "33c29354a3e71fa5a27be9d9df002352",
     "-[MandolinStringTests testAmplitude]": "6eb67e5c2defc9e1e51c1df6f9310d60",
     "-[MandolinStringTests testMandolin]": "f219d8ba04a3cc19c4235c651ecc9367",
     "-[MetalBarTests testDefault]": "87a83c455de5670938aa053a0a709070",
@@ -286,20 +286,20 @@ let validatedMD5s: [String: String] = [
     "-[PWMOscillatorTests testParametersSetAfterInit]": "9df204fbc98bb8965081cb30a89715fc",
     "-[PWMOscillatorTests testPulseWidth]": "9df204fbc98bb8965081cb30a89715fc",
     "-[PannerTests testBypass]": "f4cc261bdf98ae17320f9561941c8664",
-    "-[PannerTests testDefault]": "b82c29bc51a7fe86fc51e58536d46646",
-    "-[PannerTests testPanLeft]": "dbaf4ac5b4f3b6d2dc7d391742e7e434",
-    "-[PannerTests testPanRight]": "37622527365e3a33cd525e165478b07c",
+    "-[PannerTests testDefault]": "615e74c7eb3408bb91b28862c2772a23",
+    "-[PannerTests testPanLeft]": "43329ac0d78e4e4d25a488be800a6fe4",
+    "-[PannerTests testPanRight]": "b0dceca8262c4c12546d48cdfad590e9",
     "-[ParameterAutomationTests testDelayedAutomation]": "6e6f7b8d6e5d813e0e427b1b39b5ff16",
     "-[PeakLimiterTests testAttackTime]": "894e306bfac264fffec4c8b02c8cafbb",
     "-[PeakLimiterTests testDecayTime]": "07087decea5200c88617bd8a91ad6642",
     "-[PeakLimiterTests testDefault]": "07087decea5200c88617bd8a91ad6642",
     "-[PeakLimiterTests testParameters]": "61e7789f36193789c0fed56a80f743da",
     "-[PeakLimiterTests testPreGain]": "8ae54b65b8ba08fe8571163bb4ec778f",
-    "-[PeakingParametricEqualizerFilterTests testCenterFrequency]": "9aac25b9d75227d947b5b5900e6a487f",
-    "-[PeakingParametricEqualizerFilterTests testDefault]": "6581fb5950415cfb44a63fe04bd3d1f5",
-    "-[PeakingParametricEqualizerFilterTests testGain]": "3a50483b0c72ba49aed509c6560d9c47",
-    "-[PeakingParametricEqualizerFilterTests testParameters]": "3173a7a6263a5f3011ab97239a10ac58",
-    "-[PeakingParametricEqualizerFilterTests testQ]": "475ba663eabcf2ef0e5e8fdbcf5020eb",
+    "-[PeakingParametricEqualizerFilterTests testCenterFrequency]": "768e47fdb2c87050487f758e0e1880e8",
+    "-[PeakingParametricEqualizerFilterTests testDefault]": "5b4d2a73fc705e7bf92824f17586abc1",
+    "-[PeakingParametricEqualizerFilterTests testGain]": "53aa3b73e5559a9a1a4c24083eb06f5d",
+    "-[PeakingParametricEqualizerFilterTests testParameters]": "108457fdee175e5f141bebd9b96ec9d8",
+    "-[PeakingParametricEqualizerFilterTests testQ]": "8620c80c7ad51b6842cab9e9eacdab22",
     "-[PhaseDistortionOscillatorTests testAmplitude]": "8744e5a152b5838322c657d06b41f39c",
     "-[PhaseDistortionOscillatorTests testDefault]": "05e9a49726d7202b48c69bfbd921bdab",
     "-[PhaseDistortionOscillatorTests testDetuningMultiplier]": "ce2e581b0388d4f758e08bf9ce591b40",
@@ -315,11 +315,11 @@ let validatedMD5s: [String: String] = [
     "-[PinkNoiseOperationTests testParameterSweep]": "ac20cbf3b0342430bab4350de2619feb",
     "-[PinkNoiseTests testAmplitude]": "6704180ca2db755fd17742bb5d2da047",
     "-[PinkNoiseTests testDefault]": "79e0b102124e0b7521fb277d3f8d27f9",
-    "-[PitchShifterTests testCrossfade]": "f39eb3df3908ddf21db31f2ba4b39f40",
-    "-[PitchShifterTests testDefault]": "3a82a866e2cde01c734b409f93f55d75",
-    "-[PitchShifterTests testParameters]": "9cedb4e5f45466fe9623f53431e8059d",
-    "-[PitchShifterTests testShift]": "a05786085394af65e6f9b3815db443ff",
-    "-[PitchShifterTests testWindowSize]": "a62fda45b9d393270e953f40f1eb8183",
+    "-[PitchShifterTests testCrossfade]": "5851f717502b5f558de4fdebb8e1e0c9",
+    "-[PitchShifterTests testDefault]": "a901f005a05738aa7beb460488021648",
+    "-[PitchShifterTests testParameters]": "b9c08e26309b63fd2864aeb430f0134c",
+    "-[PitchShifterTests testShift]": "d38d29a2f9541d4d57b9483131e1fbf1",
+    "-[PitchShifterTests testWindowSize]": "2cea4a9902d6b34a69f646f2581c2f0d",
     "-[PitchTapTests testBasic]": "10e7831ee61299f51dd0ef03fa50bb25",
     "-[PluckedStringOperationTests testDefault]": "bdef4981144f808c1a375a277f4da66f",
     "-[PluckedStringTests testDefault]": "9e2d3aa3b50fa53a43b798901f0cb0e5",
@@ -349,12 +349,12 @@ let validatedMD5s: [String: String] = [
     "-[RhodesPianoKeyTests testAmplitude]": "d349565cae5618b5d6326f20623d8ea5",
     "-[RhodesPianoKeyTests testRhodesPiano]": "7341d6c60e58433aa7992ee080c297c4",
     "-[RingModulatorTests testDefault]": "6a3caaab80db5285c43975d80f40d90b",
-    "-[RolandTB303FilterTests testCutoffFrequency]": "1e7b4d8e22c304d3c8941d31b837c4d0",
-    "-[RolandTB303FilterTests testDefault]": "ef2831bac388194646e4893cac3b3ba9",
-    "-[RolandTB303FilterTests testDistortion]": "f7a8fc8a8ecf14353980635e9acdb921",
-    "-[RolandTB303FilterTests testParameters]": "df839ee521b6cda4c986cb189aec41f7",
-    "-[RolandTB303FilterTests testResonance]": "edaf975353b3a0d316b7525c1fded23c",
-    "-[RolandTB303FilterTests testResonanceAsymmetry]": "64f95d8bee65f71c2b3fb46e150d9877",
+    "-[RolandTB303FilterTests testCutoffFrequency]": "88cb54c1fb11bc007dc57b0907458ad0",
+    "-[RolandTB303FilterTests testDefault]": "339c32b7eeed55295af0a0240449cdb1",
+    "-[RolandTB303FilterTests testDistortion]": "4ce678be6cb24708b8b6254aa53a1f15",
+    "-[RolandTB303FilterTests testParameters]": "215df027271316394bacc43f78f2fa77",
+    "-[RolandTB303FilterTests testResonance]": "646248d14da542f94b54e7dee9bb0598",
+    "-[RolandTB303FilterTests testResonanceAsymmetry]": "a62fdc111dc65f800a4994d77f9826b6",
     "-[SawtoothTests testDefault]": "379388bf41f4ece5cf274bf53f270c46",
     "-[SawtoothWaveTests testDefault]": "2a5f4c75768a09c068f2c27377142aa7",
     "-[SequencerTrackTests testLoop]": "dfab5f544f9d714ed0fb95d4e077699b",
@@ -364,11 +364,11 @@ let validatedMD5s: [String: String] = [
     "-[ShakerTests testShakerAmplitude]": "57b501c34d5b4114ff8b1464a6842103",
     "-[ShakerTests testShakerType]": "998478fb4c871a653b296033d2318f4e",
     "-[SineWaveTests testDefault]": "91ec96732b1d1d40a585b6415eef8b51",
-    "-[SmoothDelayTests testDefault]": "b9cd6ad81aeb540819724102a2efc2fe",
-    "-[SmoothDelayTests testFeedback]": "5ff850c80c7e0b968bd7c5b794849a34",
-    "-[SmoothDelayTests testParameters]": "f416637680390859ba810ab258c94434",
-    "-[SmoothDelayTests testParameterSweep]": "1ea7ab2a8d2e8f07d15b16b8d9e2c3e7",
-    "-[SmoothDelayTests testTime]": "928b88c948556e0e2196435306303833",
+    "-[SmoothDelayTests testDefault]": "95949315a75c7668ad576985d0827212",
+    "-[SmoothDelayTests testFeedback]": "a96a0cc0733aea99011e9730189ae9c7",
+    "-[SmoothDelayTests testParameters]": "4fad2469c27b2c0a07402367194b88e1",
+    "-[SmoothDelayTests testParameterSweep]": "ea7b35ca932303c2e6474125df3e5d54",
+    "-[SmoothDelayTests testTime]": "751657ceb86bf23e10900e53734a006a",
     "-[SquareTests testDefault]": "9e7c2af4b9e70a73ca7d8453d59d6953",
     "-[SquareWaveTests testDefault]": "9d4465fdcff811f568807c43e41859e1",
     "-[StereoFieldLimiterTests testDefault]": "112b2f8a2cbc9e2fa50244fdf08f4fe3",
@@ -400,12 +400,12 @@ let validatedMD5s: [String: String] = [
     "-[ToneComplementFilterTests testHalfPowerPoint]": "57b54542b5785e6d4016d1a50fc0cee0",
     "-[ToneFilterTests testDefault]": "86a3a4f039683a86a53939457e23de12",
     "-[ToneFilterTests testHalfPowerPoint]": "9819b2fae4cb5caa7db1963fadb177ed",
-    "-[TransientShaperTests testDefault]": "73d4bda1cd3e82aeab84d4c342836c1a",
-    "-[TransientShaperTests testInputAmount]": "7ea97ea2b74f3e30795047b2cbc56a40",
-    "-[TransientShaperTests testOutputAmount]": "4aa7e869b929761d57a3673c5b818dec",
-    "-[TransientShaperTests testAttackAmount]": "1993b975f49c42f2101d413e5673792e",
-    "-[TransientShaperTests testReleaseAmount]": "73d4bda1cd3e82aeab84d4c342836c1a",
-    "-[TransientShaperTests testParameters]": "c24114f87556d65ada54248f4763464f",
+    "-[TransientShaperTests testDefault]": "10404ced1d0c0bdb9694b14af948bee9",
+    "-[TransientShaperTests testInputAmount]": "d8a79c9f21c3d7d26ab7e15179381152",
+    "-[TransientShaperTests testOutputAmount]": "4a11a4134e9789bec4a5eaf5b00f8330",
+    "-[TransientShaperTests testAttackAmount]": "06f38ea5dab34e3599b4186e9e578af3",
+    "-[TransientShaperTests testReleaseAmount]": "10404ced1d0c0bdb9694b14af948bee9",
+    "-[TransientShaperTests testParameters]": "54ad60c66c2307c249defafc363eb901",
     "-[TremoloTests testDefault]": "139959d264237e1deca9f301360e8d60",
     "-[TremoloTests testDepth]": "cb6b185b0b6a3ee8c26f39b19156d9d0",
     "-[TremoloTests testFrequency]": "ac1c0de14dceb73fea040e900696aa92",
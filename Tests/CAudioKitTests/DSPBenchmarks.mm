@@ -0,0 +1,328 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+// Per-module DSP benchmark suite. Every benchmark runs through the same
+// fixture: warm up, render a fixed number of frames, and report samples/sec,
+// ns/sample, and (when the hardware exposes its clock rate) cycles/sample.
+// All results accumulate into one JSON document written when the suite
+// finishes — set AK_BENCH_JSON to choose the path — so runs can be diffed
+// between releases to catch regressions.
+
+#import <XCTest/XCTest.h>
+#import <CAudioKit.h>
+#import <soundpipe.h>
+#import <mach/mach_time.h>
+#import <sys/sysctl.h>
+
+#import <cmath>
+#import <cstddef>
+#import <cstring>
+#import <string>
+#import <vector>
+
+static const size_t benchFrames = 10 * 44100;
+
+struct BenchEntry {
+    std::string name;
+    double samplesPerSec;
+    double nsPerSample;
+    double cyclesPerSample;
+};
+
+static std::vector<BenchEntry>* benchResults;
+
+/// 1k of deterministic broadband input so effect benchmarks chew on real
+/// signal instead of silence or a denormal-prone constant.
+static float benchInput[1024];
+
+static double machTicksToNs() {
+    static double factor = [] {
+        mach_timebase_info_data_t info;
+        mach_timebase_info(&info);
+        return (double)info.numer / (double)info.denom;
+    }();
+    return factor;
+}
+
+static double cpuHz() {
+    static double hz = [] {
+        uint64_t freq = 0;
+        size_t size = sizeof(freq);
+        if (sysctlbyname("hw.cpufrequency", &freq, &size, NULL, 0) == 0) {
+            return (double)freq;
+        }
+        return 0.0; // Apple silicon does not publish its clock rate
+    }();
+    return hz;
+}
+
+/// Common fixture: warms up on a short prefix, times the full run, records.
+static void runBench(const char* name, size_t frames, void (^body)(size_t frames)) {
+    body(frames / 16);
+
+    uint64_t t0 = mach_absolute_time();
+    body(frames);
+    uint64_t t1 = mach_absolute_time();
+
+    double elapsedNs = (double)(t1 - t0) * machTicksToNs();
+    BenchEntry entry;
+    entry.name = name;
+    entry.nsPerSample = elapsedNs / (double)frames;
+    entry.samplesPerSec = 1.0e9 * (double)frames / elapsedNs;
+    entry.cyclesPerSample = cpuHz() > 0 ? entry.nsPerSample * cpuHz() / 1.0e9 : 0.0;
+
+    if (benchResults == nullptr) benchResults = new std::vector<BenchEntry>;
+    benchResults->push_back(entry);
+
+    NSLog(@"[bench] %s: %.2f Msamples/s, %.1f ns/sample, %.1f cycles/sample",
+          name, entry.samplesPerSec / 1.0e6, entry.nsPerSample, entry.cyclesPerSample);
+}
+
+@interface DSPBenchmarks : XCTestCase
+@end
+
+@implementation DSPBenchmarks
+
++ (void)setUp {
+    [super setUp];
+    uint32_t seed = 0x12345;
+    for (size_t i = 0; i < 1024; i++) {
+        seed = 1103515245 * seed + 12345;
+        benchInput[i] = (float)(seed >> 8) / (float)0x7FFFFF - 1.0f;
+    }
+}
+
++ (void)tearDown {
+    if (benchResults != nullptr) {
+        NSMutableString* json = [NSMutableString stringWithString:@"{\n"];
+        for (size_t i = 0; i < benchResults->size(); i++) {
+            const BenchEntry& e = (*benchResults)[i];
+            [json appendFormat:@"  \"%s\": {\"samples_per_sec\": %.1f, \"ns_per_sample\": %.3f, \"cycles_per_sample\": %.3f}%s\n",
+                               e.name.c_str(), e.samplesPerSec, e.nsPerSample,
+                               e.cyclesPerSample, i + 1 < benchResults->size() ? "," : ""];
+        }
+        [json appendString:@"}\n"];
+
+        const char* env = getenv("AK_BENCH_JSON");
+        NSString* path = env != NULL
+            ? [NSString stringWithUTF8String:env]
+            : [NSTemporaryDirectory() stringByAppendingPathComponent:@"akbench.json"];
+        [json writeToFile:path atomically:YES encoding:NSUTF8StringEncoding error:nil];
+        NSLog(@"[bench] wrote %lu results to %@", (unsigned long)benchResults->size(), path);
+    }
+    [super tearDown];
+}
+
+#pragma mark - soundpipe modules
+
+// Standard-signature modules register through these two macros; anything
+// with table or argument baggage gets an explicit method below.
+
+#define BENCH_SP_GEN(mod)                                                     \
+- (void)testPerf_##mod {                                                      \
+    sp_data* sp;                                                              \
+    sp_create(&sp);                                                           \
+    sp->sr = 44100;                                                           \
+    sp_##mod* u;                                                              \
+    sp_##mod##_create(&u);                                                    \
+    sp_##mod##_init(sp, u);                                                   \
+    runBench(#mod, benchFrames, ^(size_t frames) {                            \
+        SPFLOAT y = 0;                                                        \
+        for (size_t i = 0; i < frames; i++) sp_##mod##_compute(sp, u, NULL, &y); \
+    });                                                                       \
+    sp_##mod##_destroy(&u);                                                   \
+    sp_destroy(&sp);                                                          \
+}
+
+#define BENCH_SP_FX(mod)                                                      \
+- (void)testPerf_##mod {                                                      \
+    sp_data* sp;                                                              \
+    sp_create(&sp);                                                           \
+    sp->sr = 44100;                                                           \
+    sp_##mod* u;                                                              \
+    sp_##mod##_create(&u);                                                    \
+    sp_##mod##_init(sp, u);                                                   \
+    runBench(#mod, benchFrames, ^(size_t frames) {                            \
+        SPFLOAT y = 0;                                                        \
+        for (size_t i = 0; i < frames; i++) {                                 \
+            SPFLOAT x = benchInput[i & 1023];                                 \
+            sp_##mod##_compute(sp, u, &x, &y);                                \
+        }                                                                     \
+    });                                                                       \
+    sp_##mod##_destroy(&u);                                                   \
+    sp_destroy(&sp);                                                          \
+}
+
+BENCH_SP_GEN(noise)
+BENCH_SP_GEN(pinknoise)
+BENCH_SP_GEN(brown)
+BENCH_SP_GEN(dust)
+BENCH_SP_GEN(metro)
+BENCH_SP_GEN(rspline)
+
+BENCH_SP_FX(moogladder)
+BENCH_SP_FX(buthp)
+BENCH_SP_FX(butlp)
+BENCH_SP_FX(butbp)
+BENCH_SP_FX(atone)
+BENCH_SP_FX(tone)
+BENCH_SP_FX(dcblock)
+BENCH_SP_FX(pareq)
+BENCH_SP_FX(eq4)
+BENCH_SP_FX(bitcrush)
+BENCH_SP_FX(clip)
+BENCH_SP_FX(dist)
+BENCH_SP_FX(compressor)
+BENCH_SP_FX(autowah)
+
+- (void)testPerf_osc {
+    sp_data* sp;
+    sp_create(&sp);
+    sp->sr = 44100;
+    sp_ftbl* ftbl;
+    sp_ftbl_create(sp, &ftbl, 8192);
+    sp_gen_triangle(sp, ftbl);
+    sp_osc* osc;
+    sp_osc_create(&osc);
+    sp_osc_init(sp, osc, ftbl, 0);
+    osc->freq = 440;
+    runBench("osc", benchFrames, ^(size_t frames) {
+        SPFLOAT y = 0;
+        for (size_t i = 0; i < frames; i++) sp_osc_compute(sp, osc, NULL, &y);
+    });
+    sp_osc_destroy(&osc);
+    sp_ftbl_destroy(&ftbl);
+    sp_destroy(&sp);
+}
+
+- (void)testPerf_pan2 {
+    sp_data* sp;
+    sp_create(&sp);
+    sp->sr = 44100;
+    sp_pan2* pan;
+    sp_pan2_create(&pan);
+    sp_pan2_init(sp, pan);
+    runBench("pan2", benchFrames, ^(size_t frames) {
+        SPFLOAT l = 0, r = 0;
+        for (size_t i = 0; i < frames; i++) {
+            SPFLOAT x = benchInput[i & 1023];
+            sp_pan2_compute(sp, pan, &x, &l, &r);
+        }
+    });
+    sp_pan2_destroy(&pan);
+    sp_destroy(&sp);
+}
+
+- (void)testPerf_revsc {
+    sp_data* sp;
+    sp_create(&sp);
+    sp->sr = 44100;
+    sp_revsc* rev;
+    sp_revsc_create(&rev);
+    sp_revsc_init(sp, rev);
+    runBench("revsc", benchFrames, ^(size_t frames) {
+        SPFLOAT l = 0, r = 0;
+        for (size_t i = 0; i < frames; i++) {
+            SPFLOAT x = benchInput[i & 1023];
+            sp_revsc_compute(sp, rev, &x, &x, &l, &r);
+        }
+    });
+    sp_revsc_destroy(&rev);
+    sp_destroy(&sp);
+}
+
+- (void)testPerf_zitarev {
+    sp_data* sp;
+    sp_create(&sp);
+    sp->sr = 44100;
+    sp_zitarev* rev;
+    sp_zitarev_create(&rev);
+    sp_zitarev_init(sp, rev);
+    runBench("zitarev", benchFrames, ^(size_t frames) {
+        SPFLOAT l = 0, r = 0;
+        for (size_t i = 0; i < frames; i++) {
+            SPFLOAT x = benchInput[i & 1023];
+            sp_zitarev_compute(sp, rev, &x, &x, &l, &r);
+        }
+    });
+    sp_zitarev_destroy(&rev);
+    sp_destroy(&sp);
+}
+
+#pragma mark - DSPBase subclasses
+
+// Drives a node exactly the way the engine does: through its internal render
+// block in 512-frame quanta, input (for effects) supplied by a pull block
+// repeating the broadband fixture signal.
+static void benchDSPNode(const char* name, bool hasInput) {
+    DSPRef dsp = akCreateDSP(name);
+    if (dsp == NULL) return;
+
+    // Table-driven generators need a waveform before init; harmless for the rest.
+    std::vector<float> sine(4096);
+    for (size_t i = 0; i < sine.size(); i++) {
+        sine[i] = sinf(2.0f * (float)M_PI * (float)i / (float)sine.size());
+    }
+    setWavetableDSP(dsp, sine.data(), sine.size(), 0);
+
+    allocateRenderResourcesDSP(dsp, 2, 44100);
+    if (hasInput) reserveScratchBuffersDSP(dsp, 2, 512);
+    startDSP(dsp);
+
+    const AUAudioFrameCount quantum = 512;
+    static float outL[512], outR[512], inL[512], inR[512];
+    for (int i = 0; i < 512; i++) {
+        inL[i] = benchInput[i & 1023];
+        inR[i] = benchInput[(i + 512) & 1023];
+    }
+
+    static char outputStorage[offsetof(AudioBufferList, mBuffers) + 2 * sizeof(AudioBuffer)];
+    AudioBufferList* output = (AudioBufferList*)outputStorage;
+    output->mNumberBuffers = 2;
+    output->mBuffers[0] = {1, quantum * sizeof(float), outL};
+    output->mBuffers[1] = {1, quantum * sizeof(float), outR};
+
+    AURenderPullInputBlock pull = nil;
+    if (hasInput) {
+        // Fill whatever buffer the node hands us, the way an upstream render
+        // would; the fixture arrays themselves stay untouched.
+        pull = ^AUAudioUnitStatus(AudioUnitRenderActionFlags* flags,
+                                  const AudioTimeStamp* ts,
+                                  AUAudioFrameCount frameCount,
+                                  NSInteger busNumber,
+                                  AudioBufferList* data) {
+            if (data->mNumberBuffers > 0 && data->mBuffers[0].mData) {
+                memcpy(data->mBuffers[0].mData, inL, frameCount * sizeof(float));
+            }
+            if (data->mNumberBuffers > 1 && data->mBuffers[1].mData) {
+                memcpy(data->mBuffers[1].mData, inR, frameCount * sizeof(float));
+            }
+            return noErr;
+        };
+    }
+
+    AUInternalRenderBlock render = internalRenderBlockDSP(dsp);
+    __block AudioTimeStamp timestamp = {};
+    timestamp.mFlags = kAudioTimeStampSampleTimeValid;
+
+    runBench(name, benchFrames, ^(size_t frames) {
+        for (size_t done = 0; done < frames; done += quantum) {
+            AudioUnitRenderActionFlags flags = 0;
+            render(&flags, &timestamp, quantum, 0, output, NULL, pull);
+            timestamp.mSampleTime += quantum;
+        }
+    });
+
+    deallocateRenderResourcesDSP(dsp);
+    deleteDSP(dsp);
+}
+
+- (void)testPerf_OscillatorDSP    { benchDSPNode("OscillatorDSP", false); }
+- (void)testPerf_WhiteNoiseDSP    { benchDSPNode("WhiteNoiseDSP", false); }
+- (void)testPerf_PinkNoiseDSP     { benchDSPNode("PinkNoiseDSP", false); }
+- (void)testPerf_MoogLadderDSP    { benchDSPNode("MoogLadderDSP", true); }
+- (void)testPerf_EqualizerDSP     { benchDSPNode("EqualizerDSP", true); }
+- (void)testPerf_PannerDSP        { benchDSPNode("PannerDSP", true); }
+- (void)testPerf_ZitaReverbDSP    { benchDSPNode("ZitaReverbDSP", true); }
+- (void)testPerf_FaderDSP         { benchDSPNode("FaderDSP", true); }
+
+@end
@@ -0,0 +1,195 @@
+// Copyright AudioKit. All Rights Reserved. Revision History at http://github.com/AudioKit/AudioKit/
+
+// Realtime-faithful graph benchmark. Renders a chain of DSP nodes through
+// their actual internalRenderBlocks in quantum-sized calls, paced on the
+// quantum deadline grid from a time-constraint (realtime) thread — the same
+// conditions Core Audio gives the render callback. Every quantum's render
+// latency is recorded, and the tail of the distribution (p50/p99/p99.9/max)
+// is reported: dropouts live in the p99.9 where average-rate loops are
+// blind.
+//
+// Configuration via environment:
+//   AK_RT_BENCH_GRAPH    comma-separated DSP names, first must be a
+//                        generator (default OscillatorDSP,MoogLadderDSP,
+//                        EqualizerDSP,FaderDSP)
+//   AK_RT_BENCH_SECONDS  run length in seconds (default 10)
+//   AK_RT_BENCH_JSON     result path (default <tmp>/akbench_rt.json)
+
+#import <XCTest/XCTest.h>
+#import <CAudioKit.h>
+#import <mach/mach_time.h>
+#import <mach/thread_policy.h>
+#import <mach/thread_act.h>
+
+#import <algorithm>
+#import <cmath>
+#import <cstddef>
+#import <cstring>
+#import <string>
+#import <thread>
+#import <vector>
+
+static const double rtSampleRate = 48000.0;
+static const AUAudioFrameCount rtQuantum = 128;
+
+static double rtTicksToNs() {
+    static double factor = [] {
+        mach_timebase_info_data_t info;
+        mach_timebase_info(&info);
+        return (double)info.numer / (double)info.denom;
+    }();
+    return factor;
+}
+
+/// Promotes the calling thread to the time-constraint class Core Audio's
+/// render thread runs in: period = one quantum, with half a quantum of
+/// nominal computation.
+static void promoteToRealtime() {
+    double quantumNs = (double)rtQuantum / rtSampleRate * 1.0e9;
+    uint32_t periodTicks = (uint32_t)(quantumNs / rtTicksToNs());
+
+    thread_time_constraint_policy_data_t policy;
+    policy.period = periodTicks;
+    policy.computation = periodTicks / 2;
+    policy.constraint = periodTicks;
+    policy.preemptible = 1;
+    thread_policy_set(mach_thread_self(), THREAD_TIME_CONSTRAINT_POLICY,
+                      (thread_policy_t)&policy, THREAD_TIME_CONSTRAINT_POLICY_COUNT);
+}
+
+@interface RealtimeGraphBenchmark : XCTestCase
+@end
+
+@implementation RealtimeGraphBenchmark
+
+- (void)testRealtimeGraphLatency {
+    const char* graphEnv = getenv("AK_RT_BENCH_GRAPH");
+    NSString* graphSpec = graphEnv != NULL
+        ? [NSString stringWithUTF8String:graphEnv]
+        : @"OscillatorDSP,MoogLadderDSP,EqualizerDSP,FaderDSP";
+    NSArray<NSString*>* names = [graphSpec componentsSeparatedByString:@","];
+
+    const char* secondsEnv = getenv("AK_RT_BENCH_SECONDS");
+    double seconds = secondsEnv != NULL ? atof(secondsEnv) : 10.0;
+    uint64_t quantaTotal = (uint64_t)(seconds * rtSampleRate / rtQuantum);
+
+    // Build the chain: each node is created through the factory and driven by
+    // its internal render block; an effect's pull block renders its upstream
+    // neighbor into whatever buffer the plumbing hands it.
+    std::vector<float> sine(4096);
+    for (size_t i = 0; i < sine.size(); i++) {
+        sine[i] = sinf(2.0f * (float)M_PI * (float)i / (float)sine.size());
+    }
+
+    NSMutableArray* renderBlocks = [NSMutableArray array];
+    std::vector<DSPRef> nodes;
+    AURenderPullInputBlock upstreamPull = nil;
+
+    for (NSUInteger n = 0; n < names.count; n++) {
+        DSPRef dsp = akCreateDSP(names[n].UTF8String);
+        XCTAssertTrue(dsp != NULL, @"unknown DSP %@", names[n]);
+        if (dsp == NULL) return;
+        nodes.push_back(dsp);
+
+        setWavetableDSP(dsp, sine.data(), sine.size(), 0);
+        allocateRenderResourcesDSP(dsp, 2, rtSampleRate);
+        if (n > 0) reserveScratchBuffersDSP(dsp, 2, rtQuantum);
+        startDSP(dsp);
+
+        AUInternalRenderBlock render = internalRenderBlockDSP(dsp);
+        [renderBlocks addObject:render];
+
+        AURenderPullInputBlock pullFromThis;
+        if (n == 0) {
+            pullFromThis = ^AUAudioUnitStatus(AudioUnitRenderActionFlags* flags,
+                                              const AudioTimeStamp* ts,
+                                              AUAudioFrameCount frameCount,
+                                              NSInteger busNumber,
+                                              AudioBufferList* data) {
+                return render(flags, ts, frameCount, 0, data, NULL, nil);
+            };
+        } else {
+            AURenderPullInputBlock previous = upstreamPull;
+            pullFromThis = ^AUAudioUnitStatus(AudioUnitRenderActionFlags* flags,
+                                              const AudioTimeStamp* ts,
+                                              AUAudioFrameCount frameCount,
+                                              NSInteger busNumber,
+                                              AudioBufferList* data) {
+                return render(flags, ts, frameCount, 0, data, NULL, previous);
+            };
+        }
+        upstreamPull = pullFromThis;
+    }
+
+    AURenderPullInputBlock renderChain = upstreamPull;
+
+    static float outL[rtQuantum], outR[rtQuantum];
+    static char outputStorage[offsetof(AudioBufferList, mBuffers) + 2 * sizeof(AudioBuffer)];
+    AudioBufferList* output = (AudioBufferList*)outputStorage;
+    output->mNumberBuffers = 2;
+    output->mBuffers[0] = {1, rtQuantum * sizeof(float), outL};
+    output->mBuffers[1] = {1, rtQuantum * sizeof(float), outR};
+
+    auto* latenciesNs = new std::vector<double>();
+    latenciesNs->reserve(quantaTotal);
+
+    std::thread renderThread([&] {
+        promoteToRealtime();
+
+        double quantumTicks = (double)rtQuantum / rtSampleRate * 1.0e9 / rtTicksToNs();
+        uint64_t deadline = mach_absolute_time();
+        AudioTimeStamp timestamp = {};
+        timestamp.mFlags = kAudioTimeStampSampleTimeValid;
+
+        for (uint64_t q = 0; q < quantaTotal; q++) {
+            // Pace on the deadline grid so scheduler and cache behavior match
+            // a live render callback instead of a hot spin.
+            deadline += (uint64_t)quantumTicks;
+            mach_wait_until(deadline);
+
+            uint64_t t0 = mach_absolute_time();
+            AudioUnitRenderActionFlags flags = 0;
+            renderChain(&flags, &timestamp, rtQuantum, 0, output);
+            uint64_t t1 = mach_absolute_time();
+
+            latenciesNs->push_back((double)(t1 - t0) * rtTicksToNs());
+            timestamp.mSampleTime += rtQuantum;
+        }
+    });
+    renderThread.join();
+
+    std::sort(latenciesNs->begin(), latenciesNs->end());
+    auto percentile = [&](double p) {
+        size_t index = (size_t)(p * (double)(latenciesNs->size() - 1));
+        return (*latenciesNs)[index];
+    };
+    double p50 = percentile(0.50);
+    double p99 = percentile(0.99);
+    double p999 = percentile(0.999);
+    double worst = latenciesNs->back();
+    double budgetNs = (double)rtQuantum / rtSampleRate * 1.0e9;
+
+    NSLog(@"[rt-bench] %@: %llu quanta, p50 %.1fus p99 %.1fus p99.9 %.1fus max %.1fus (budget %.1fus)",
+          graphSpec, (unsigned long long)latenciesNs->size(),
+          p50 / 1000, p99 / 1000, p999 / 1000, worst / 1000, budgetNs / 1000);
+
+    NSString* json = [NSString stringWithFormat:
+        @"{\n  \"graph\": \"%@\",\n  \"quanta\": %llu,\n  \"budget_ns\": %.1f,\n"
+        @"  \"p50_ns\": %.1f,\n  \"p99_ns\": %.1f,\n  \"p999_ns\": %.1f,\n  \"max_ns\": %.1f\n}\n",
+        graphSpec, (unsigned long long)latenciesNs->size(), budgetNs, p50, p99, p999, worst];
+    const char* jsonEnv = getenv("AK_RT_BENCH_JSON");
+    NSString* path = jsonEnv != NULL
+        ? [NSString stringWithUTF8String:jsonEnv]
+        : [NSTemporaryDirectory() stringByAppendingPathComponent:@"akbench_rt.json"];
+    [json writeToFile:path atomically:YES encoding:NSUTF8StringEncoding error:nil];
+
+    XCTAssertLessThan(p999, budgetNs, @"p99.9 render latency exceeds the quantum budget");
+
+    for (DSPRef dsp : nodes) {
+        deallocateRenderResourcesDSP(dsp);
+        deleteDSP(dsp);
+    }
+    delete latenciesNs;
+}
+
+@end